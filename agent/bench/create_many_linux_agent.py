@@ -38,6 +38,8 @@ parser.add_argument('--start', action='store_true', help='start agents.')
 parser.add_argument('--kill', action='store_true', help='kill agents.')
 parser.add_argument('--reverse', action='store_true', help='engine connect to agents.')
 parser.add_argument('--nb_cpu_service', type=int,  default=20, help='nb cpu chek per agent.')
+parser.add_argument('--max_batch_size', type=int, default=0, help='size in bytes from which agents send check results (0: agent default).')
+parser.add_argument('--max_batch_delay', type=int, default=0, help='longest wait of a check result on agent side in ms (0: export_period).')
 
 args = parser.parse_args()
 
@@ -118,7 +120,9 @@ def create_engine_otl_server_json():
     "centreon_agent": {
         "max_concurrent_checks": 100000,
 	    "check_interval": 60,
-        "export_period": 15""")
+        "export_period": 15,
+        "max_batch_size": """ + str(args.max_batch_size) + """,
+        "max_batch_delay": """ + str(args.max_batch_delay))
         if args.reverse:
             ff.write(""",
         "reverse_connections":[        
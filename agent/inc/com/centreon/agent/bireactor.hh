@@ -67,9 +67,17 @@ class bireactor
 
   void start_read();
 
+  /**
+   * @brief messages smaller than this are not compressed, compression of small
+   * messages costs cpu without saving bandwidth
+   */
+  static constexpr size_t min_compressed_size = 1024;
+
   void start_write();
   void write(const std::shared_ptr<MessageFromAgent>& request);
 
+  size_t get_write_queue_size() const;
+
   // bireactor part
   void OnReadDone(bool ok) override;
 
@@ -35,6 +35,8 @@ class scheduler : public std::enable_shared_from_this<scheduler> {
  public:
   using metric_sender =
       std::function<void(const std::shared_ptr<MessageFromAgent>&)>;
+  // returns true if previous requests are not yet sent to engine
+  using congestion_probe = std::function<bool()>;
   using check_builder = std::function<std::shared_ptr<check>(
       const std::shared_ptr<asio::io_context>&,
       const std::shared_ptr<spdlog::logger>& /*logger*/,
@@ -49,6 +51,13 @@ class scheduler : public std::enable_shared_from_this<scheduler> {
       const std::shared_ptr<common::crypto::aes256> /*credentials_decrypt*/
       )>;
 
+  // default size in bytes from which a request is sent without waiting
+  static constexpr unsigned default_max_batch_size = 2 * 1024 * 1024;
+
+  // if engine doesn't read fast enough, the oldest requests waiting to be
+  // sent are dropped beyond this number
+  static constexpr size_t max_waiting_requests = 64;
+
  private:
   /**
    * @brief we split time in slots, length of a time slot is given by
@@ -67,6 +76,14 @@ class scheduler : public std::enable_shared_from_this<scheduler> {
 
   // request that will be sent to engine
   std::shared_ptr<MessageFromAgent> _current_request;
+  // incremented on each new _current_request, so that a batch timer handler
+  // already queued doesn't send the next request
+  uint64_t _request_generation = 0;
+  // requests ready to be sent, they wait here while engine is congested
+  std::deque<std::shared_ptr<MessageFromAgent>> _waiting_requests;
+  // check results dropped because engine was congested for too long, sent
+  // to engine in each request
+  uint64_t _dropped_results = 0;
 
   // pointers in this struct point to _current_request
   struct scope_metric_request {
@@ -84,7 +101,10 @@ class scheduler : public std::enable_shared_from_this<scheduler> {
   // host declared in engine config
   std::string _supervised_host;
   metric_sender _metric_sender;
+  congestion_probe _is_congested;
   asio::system_timer _send_timer;
+  // started on the first check result of a request if max_batch_delay is set
+  asio::system_timer _batch_timer;
   asio::system_timer _check_timer;
   time_step
       _check_time_step;  // time point used when too many checks are running
@@ -106,6 +126,12 @@ class scheduler : public std::enable_shared_from_this<scheduler> {
   void _start();
   void _start_send_timer();
   void _send_timer_handler(const boost::system::error_code& err);
+  void _start_batch_timer();
+  void _batch_timer_handler(const boost::system::error_code& err,
+                            uint64_t request_generation);
+  void _send_request();
+  void _send_waiting_requests();
+  unsigned _get_max_batch_size() const;
   void _start_check_timer();
   void _check_timer_handler(const boost::system::error_code& err);
 
@@ -129,6 +155,8 @@ class scheduler : public std::enable_shared_from_this<scheduler> {
 
   scope_metric_request& _get_scope_metrics(const std::string& service);
 
+  static unsigned _nb_check_results(const MessageFromAgent& request);
+
   ::opentelemetry::proto::metrics::v1::Metric* _get_metric(
       scope_metric_request& scope_metric,
       const std::string& metric_name);
@@ -178,6 +206,10 @@ class scheduler : public std::enable_shared_from_this<scheduler> {
 
   void stop();
 
+  void set_congestion_probe(congestion_probe&& probe) {
+    _is_congested = std::move(probe);
+  }
+
   static std::shared_ptr<check> default_check_builder(
       const std::shared_ptr<asio::io_context>& io_context,
       const std::shared_ptr<spdlog::logger>& logger,
@@ -217,6 +249,7 @@ scheduler::scheduler(
       _supervised_host(supervised_host),
       _metric_sender(met_sender),
       _send_timer(*io_context),
+      _batch_timer(*io_context),
       _check_timer(*io_context),
       _check_builder(builder),
       _conf(config),
@@ -84,6 +84,8 @@ class streaming_client : public common::grpc::grpc_client_base,
 
   void _send(const std::shared_ptr<MessageFromAgent>& request);
 
+  bool _is_congested();
+
  public:
   streaming_client(const std::shared_ptr<boost::asio::io_context>& io_context,
                    const std::shared_ptr<spdlog::logger>& logger,
@@ -0,0 +1,65 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CENTREON_AGENT_CHECK_LOAD_HH
+#define CENTREON_AGENT_CHECK_LOAD_HH
+
+#include "check.hh"
+
+namespace com::centreon::agent {
+
+/**
+ * @brief check load average read in /proc/loadavg
+ * load can be divided by the number of cpus (per-cpu param)
+ *
+ */
+class check_load : public check {
+ public:
+  using load_array = std::array<double, 3>;
+
+ private:
+  load_array _warning_thresholds;
+  load_array _critical_thresholds;
+  bool _per_cpu = false;
+
+ public:
+  check_load(const std::shared_ptr<asio::io_context>& io_context,
+             const std::shared_ptr<spdlog::logger>& logger,
+             time_point first_start_expected,
+             duration check_interval,
+             const std::string& serv,
+             const std::string& cmd_name,
+             const std::string& cmd_line,
+             const rapidjson::Value& args,
+             const engine_to_agent_request_ptr& cnf,
+             check::completion_handler&& handler,
+             const checks_statistics::pointer& stat);
+
+  static void help(std::ostream& help_stream);
+
+  static load_array read_loadavg(const char* proc_file = "/proc/loadavg");
+
+  void start_check(const duration& timeout) override;
+
+  e_status compute(const load_array& loads,
+                   unsigned nb_cpu,
+                   std::string* output,
+                   std::list<common::perfdata>* perfs);
+};
+}  // namespace com::centreon::agent
+#endif
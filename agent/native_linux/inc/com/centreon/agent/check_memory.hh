@@ -0,0 +1,123 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CENTREON_AGENT_NATIVE_CHECK_MEMORY_HH
+#define CENTREON_AGENT_NATIVE_CHECK_MEMORY_HH
+
+#include "native_check_base.hh"
+
+namespace com::centreon::agent {
+namespace native_check_detail {
+
+enum e_memory_metric : unsigned {
+  phys_total,
+  phys_free,
+  phys_used,
+  swap_total,
+  swap_free,
+  swap_used,
+  virtual_total,
+  virtual_free,
+  virtual_used,
+  nb_metric
+};
+
+/**
+ * @brief the fields of /proc/meminfo used by check_memory, in bytes
+ * This object is shared by all memory checks of a period.
+ *
+ */
+class meminfo {
+ public:
+  enum e_field : unsigned {
+    mem_total,
+    mem_free,
+    mem_available,
+    buffers,
+    cached,
+    swap_total,
+    swap_free,
+    commit_limit,
+    committed_as,
+    nb_field
+  };
+
+ private:
+  std::array<uint64_t, nb_field> _fields;
+
+ public:
+  meminfo(const char* proc_file = "/proc/meminfo");
+
+  uint64_t get_field(e_field field) const { return _fields[field]; }
+};
+
+/**
+ * @brief this class compute memory metrics from a meminfo and store them in
+ * _metrics member
+ * virtual memory is the commit charge: Committed_AS compared to CommitLimit
+ *
+ */
+class l_memory_info
+    : public snapshot<native_check_detail::e_memory_metric::nb_metric> {
+  unsigned _output_flags = 0;
+
+ public:
+  enum output_flags : unsigned { dump_swap = 1, dump_virtual };
+
+  l_memory_info(const meminfo& info, unsigned flags = 0);
+
+  void dump_to_output(std::string* output) const override;
+};
+
+}  // namespace native_check_detail
+
+/**
+ * @brief native final check object
+ *
+ */
+class check_memory : public native_check_base<
+                         native_check_detail::e_memory_metric::nb_metric> {
+ protected:
+  unsigned _output_flags = 0;
+
+ public:
+  check_memory(const std::shared_ptr<asio::io_context>& io_context,
+               const std::shared_ptr<spdlog::logger>& logger,
+               time_point first_start_expected,
+               duration check_interval,
+               const std::string& serv,
+               const std::string& cmd_name,
+               const std::string& cmd_line,
+               const rapidjson::Value& args,
+               const engine_to_agent_request_ptr& cnf,
+               check::completion_handler&& handler,
+               const checks_statistics::pointer& stat);
+
+  std::shared_ptr<native_check_detail::snapshot<
+      native_check_detail::e_memory_metric::nb_metric>>
+  measure() override;
+
+  static void help(std::ostream& help_stream);
+
+  const std::vector<native_check_detail::metric_definition>&
+  get_metric_definitions() const override;
+};
+
+}  // namespace com::centreon::agent
+
+#endif
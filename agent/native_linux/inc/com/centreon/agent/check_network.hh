@@ -0,0 +1,78 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CENTREON_AGENT_NATIVE_CHECK_NETWORK_HH
+#define CENTREON_AGENT_NATIVE_CHECK_NETWORK_HH
+
+#include "native_check_rate_base.hh"
+
+namespace com::centreon::agent {
+namespace native_check_detail {
+
+enum e_network_counter : unsigned {
+  in_bytes,
+  in_packets,
+  in_errors,
+  in_drops,
+  out_bytes,
+  out_packets,
+  out_errors,
+  out_drops,
+  nb_network_counter
+};
+
+std::shared_ptr<counter_snapshot<nb_network_counter>> read_net_dev(
+    const char* proc_file = "/proc/net/dev");
+
+}  // namespace native_check_detail
+
+/**
+ * @brief network traffic rates by interface
+ *
+ */
+class check_network : public native_check_rate_base<
+                          native_check_detail::e_network_counter::
+                              nb_network_counter> {
+ public:
+  check_network(const std::shared_ptr<asio::io_context>& io_context,
+                const std::shared_ptr<spdlog::logger>& logger,
+                time_point first_start_expected,
+                duration check_interval,
+                const std::string& serv,
+                const std::string& cmd_name,
+                const std::string& cmd_line,
+                const rapidjson::Value& args,
+                const engine_to_agent_request_ptr& cnf,
+                check::completion_handler&& handler,
+                const checks_statistics::pointer& stat);
+
+  snapshot_ptr measure() override;
+
+  const std::vector<native_check_detail::rate_definition>&
+  get_rate_definitions() const override;
+
+  void dump_device(const std::string& device,
+                   const std::vector<double>& rates,
+                   std::string* output) const override;
+
+  static void help(std::ostream& help_stream);
+};
+
+}  // namespace com::centreon::agent
+
+#endif
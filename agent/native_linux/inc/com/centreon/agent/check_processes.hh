@@ -0,0 +1,116 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CENTREON_AGENT_NATIVE_CHECK_PROCESSES_HH
+#define CENTREON_AGENT_NATIVE_CHECK_PROCESSES_HH
+
+#include "native_check_base.hh"
+
+namespace com::centreon::agent {
+namespace native_check_detail {
+
+enum e_processes_metric : unsigned {
+  proc_total,
+  proc_running,
+  proc_sleeping,
+  proc_uninterruptible,
+  proc_zombie,
+  proc_stopped,
+  proc_threads,
+  nb_processes_metric
+};
+
+/**
+ * @brief processes read from /proc/<pid>/stat
+ * This object is shared by all processes checks of a period, each check
+ * applies its own filter.
+ *
+ */
+class process_list {
+ public:
+  struct process {
+    std::string comm;
+    char state;
+    unsigned nb_threads;
+  };
+
+ private:
+  std::vector<process> _processes;
+
+ public:
+  process_list(const char* proc_dir = "/proc");
+
+  static bool parse_stat(std::string_view stat_content, process* proc);
+
+  const std::vector<process>& get_processes() const { return _processes; }
+};
+
+/**
+ * @brief processes counted by state, only processes whose name matches filter
+ * and don't match exclude are counted
+ *
+ */
+class l_processes_count
+    : public snapshot<native_check_detail::e_processes_metric::
+                          nb_processes_metric> {
+ public:
+  l_processes_count(const process_list& processes,
+                    const RE2* filter,
+                    const RE2* exclude);
+
+  void dump_to_output(std::string* output) const override;
+};
+
+}  // namespace native_check_detail
+
+/**
+ * @brief native final check object
+ *
+ */
+class check_processes
+    : public native_check_base<
+          native_check_detail::e_processes_metric::nb_processes_metric> {
+  std::unique_ptr<RE2> _filter;
+  std::unique_ptr<RE2> _exclude;
+
+ public:
+  check_processes(const std::shared_ptr<asio::io_context>& io_context,
+                  const std::shared_ptr<spdlog::logger>& logger,
+                  time_point first_start_expected,
+                  duration check_interval,
+                  const std::string& serv,
+                  const std::string& cmd_name,
+                  const std::string& cmd_line,
+                  const rapidjson::Value& args,
+                  const engine_to_agent_request_ptr& cnf,
+                  check::completion_handler&& handler,
+                  const checks_statistics::pointer& stat);
+
+  std::shared_ptr<native_check_detail::snapshot<
+      native_check_detail::e_processes_metric::nb_processes_metric>>
+  measure() override;
+
+  static void help(std::ostream& help_stream);
+
+  const std::vector<native_check_detail::metric_definition>&
+  get_metric_definitions() const override;
+};
+
+}  // namespace com::centreon::agent
+
+#endif
@@ -0,0 +1,138 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CENTREON_AGENT_NATIVE_CHECK_RATE_BASE_HH
+#define CENTREON_AGENT_NATIVE_CHECK_RATE_BASE_HH
+
+#include "check.hh"
+
+namespace com::centreon::agent {
+
+namespace native_check_detail {
+
+/**
+ * @brief counters of all devices (disks, interfaces...) read at a given time
+ *
+ * @tparam nb_counter
+ */
+template <unsigned nb_counter>
+struct counter_snapshot {
+  using counter_array = std::array<uint64_t, nb_counter>;
+
+  std::chrono::steady_clock::time_point time;
+  absl::btree_map<std::string, counter_array> devices;
+  // devices that are part of another one (partitions), ignored unless asked
+  absl::flat_hash_set<std::string> sub_devices;
+};
+
+/**
+ * @brief a rate computed from a counter
+ * rate = counter delta * multiplier / elapsed seconds
+ *
+ */
+struct rate_definition {
+  // used in thresholds param names: warning-<label>
+  std::string_view label;
+  // perfdata name is <device>#<metric_name>
+  std::string_view metric_name;
+  unsigned counter_index;
+  double multiplier;
+  const char* unit;
+  // 0 if no max
+  double max;
+};
+
+}  // namespace native_check_detail
+
+/**
+ * @brief base of the checks that compute rates from two measures of /proc
+ * counters
+ * The previous measure is kept from one check to the next, so rates are
+ * averages over the check interval. The first time, two measures are done
+ * with first_measure_delay between them.
+ *
+ * @tparam nb_counter
+ */
+template <unsigned nb_counter>
+class native_check_rate_base : public check {
+ public:
+  using snapshot_type = native_check_detail::counter_snapshot<nb_counter>;
+  using snapshot_ptr = std::shared_ptr<const snapshot_type>;
+
+  static constexpr std::chrono::seconds first_measure_delay{1};
+
+ protected:
+  snapshot_ptr _previous;
+  asio::steady_timer _first_measure_timer;
+
+  std::string_view _device_label;
+  std::unique_ptr<RE2> _filter;
+  std::unique_ptr<RE2> _exclude;
+  bool _with_sub_devices = false;
+
+  // thresholds by rate index, NaN if not set, sized by the constructor
+  std::vector<double> _warning;
+  std::vector<double> _critical;
+
+  bool _parse_common_arg(const std::string& cmd_name,
+                         const std::string& key,
+                         const rapidjson::Value& value);
+
+  void _compute_and_complete(unsigned start_check_index,
+                             const snapshot_ptr& previous,
+                             const snapshot_ptr& current);
+
+ public:
+  native_check_rate_base(const std::shared_ptr<asio::io_context>& io_context,
+                         const std::shared_ptr<spdlog::logger>& logger,
+                         time_point first_start_expected,
+                         duration check_interval,
+                         const std::string& serv,
+                         const std::string& cmd_name,
+                         const std::string& cmd_line,
+                         const engine_to_agent_request_ptr& cnf,
+                         check::completion_handler&& handler,
+                         const checks_statistics::pointer& stat,
+                         std::string_view device_label,
+                         size_t nb_rate);
+
+  std::shared_ptr<native_check_rate_base<nb_counter>> shared_from_this() {
+    return std::static_pointer_cast<native_check_rate_base<nb_counter>>(
+        check::shared_from_this());
+  }
+
+  void start_check(const duration& timeout) override;
+
+  virtual snapshot_ptr measure() = 0;
+
+  virtual const std::vector<native_check_detail::rate_definition>&
+  get_rate_definitions() const = 0;
+
+  virtual void dump_device(const std::string& device,
+                           const std::vector<double>& rates,
+                           std::string* output) const = 0;
+
+  e_status compute(const snapshot_type& previous,
+                   const snapshot_type& current,
+                   std::string* output,
+                   std::list<common::perfdata>* perfs) const;
+};
+
+}  // namespace com::centreon::agent
+
+#endif
@@ -0,0 +1,67 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CENTREON_AGENT_PROC_FILE_HH
+#define CENTREON_AGENT_PROC_FILE_HH
+
+namespace com::centreon::agent {
+
+void read_proc_file(const char* path, std::string* buffer);
+
+/**
+ * @brief last measure of a kind (/proc/meminfo, /proc/diskstats...) shared by
+ * all the checks.
+ * The scheduler starts the checks of a period together, so a measure younger
+ * than max_age is given to the next checks instead of parsing the same file
+ * again.
+ *
+ * @tparam snapshot_type measure built by the builder passed to get()
+ */
+template <class snapshot_type>
+class shared_snapshot {
+  absl::Mutex _protect;
+  std::shared_ptr<const snapshot_type> _last ABSL_GUARDED_BY(_protect);
+  std::chrono::steady_clock::time_point _last_time ABSL_GUARDED_BY(_protect);
+
+ public:
+  static constexpr std::chrono::milliseconds max_age{500};
+
+  /**
+   * @brief get the last measure or a new one if it's too old
+   *
+   * @tparam builder_type callable that returns a
+   * std::shared_ptr<const snapshot_type>
+   * @param builder called if a new measure is needed
+   * @return std::shared_ptr<const snapshot_type>
+   */
+  template <class builder_type>
+  std::shared_ptr<const snapshot_type> get(builder_type&& builder) {
+    std::chrono::steady_clock::time_point now =
+        std::chrono::steady_clock::now();
+    absl::MutexLock l(&_protect);
+    if (!_last || now - _last_time >= max_age) {
+      _last = builder();
+      _last_time = now;
+    }
+    return _last;
+  }
+};
+
+}  // namespace com::centreon::agent
+
+#endif
@@ -0,0 +1,214 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include <unistd.h>
+
+#include "check_disk_io.hh"
+#include "native_check_rate_base.cc"
+#include "proc_file.hh"
+
+using namespace com::centreon::agent;
+using namespace com::centreon::agent::native_check_detail;
+
+using disk_snapshot = counter_snapshot<e_disk_io_counter::nb_disk_io_counter>;
+
+/**
+ * @brief parse /proc/diskstats, lines are like
+ *  8       0 sda 1190 353 85914 1019 2102 1536 101234 2791 0 3348 4271 ...
+ * fields after device name are reads completed, reads merged, sectors read,
+ * ms reading, writes completed, writes merged, sectors written, ms writing,
+ * I/Os in progress, ms doing I/Os...
+ * Devices that are not in sys_block_dir are partitions
+ *
+ * @param proc_file usually /proc/diskstats
+ * @param sys_block_dir usually /sys/block, nullptr: no partition detection
+ * @return std::shared_ptr<disk_snapshot>
+ */
+std::shared_ptr<disk_snapshot> native_check_detail::read_diskstats(
+    const char* proc_file,
+    const char* sys_block_dir) {
+  // index of counters in fields after device name
+  static constexpr std::array<unsigned, e_disk_io_counter::nb_disk_io_counter>
+      field_index = {0, 2, 4, 6, 9};
+
+  thread_local std::string buffer;
+  read_proc_file(proc_file, &buffer);
+
+  auto ret = std::make_shared<disk_snapshot>();
+  ret->time = std::chrono::steady_clock::now();
+  std::string sys_path;
+  for (std::string_view line :
+       absl::StrSplit(buffer, '\n', absl::SkipEmpty())) {
+    std::vector<std::string_view> fields =
+        absl::StrSplit(line, ' ', absl::SkipEmpty());
+    if (fields.size() < 3 + field_index.back() + 1) {
+      continue;
+    }
+    disk_snapshot::counter_array counters;
+    bool parse_ok = true;
+    for (unsigned counter = 0; counter < counters.size() && parse_ok;
+         ++counter) {
+      parse_ok = absl::SimpleAtoi(fields[3 + field_index[counter]],
+                                  &counters[counter]);
+    }
+    if (!parse_ok) {
+      continue;
+    }
+    std::string device(fields[2]);
+    if (sys_block_dir) {
+      // cciss/c0d0 is cciss!c0d0 in /sys/block
+      sys_path = absl::StrCat(sys_block_dir, "/", device);
+      std::replace(sys_path.begin() + strlen(sys_block_dir) + 1,
+                   sys_path.end(), '/', '!');
+      if (access(sys_path.c_str(), F_OK)) {
+        ret->sub_devices.insert(device);
+      }
+    }
+    ret->devices.emplace(std::move(device), counters);
+  }
+  return ret;
+}
+
+/**
+ * @brief rate defines, a sector is 512 bytes whatever the disk and
+ * utilization is the ms spent doing I/Os per second / 10
+ *
+ */
+static const std::vector<rate_definition> _rate_definitions = {
+    {"read-bytes", "disk.read.bytespersecond", e_disk_io_counter::read_sectors,
+     512, "B/s", 0},
+    {"write-bytes", "disk.write.bytespersecond",
+     e_disk_io_counter::write_sectors, 512, "B/s", 0},
+    {"read-iops", "disk.read.iops", e_disk_io_counter::read_ios, 1, nullptr,
+     0},
+    {"write-iops", "disk.write.iops", e_disk_io_counter::write_ios, 1,
+     nullptr, 0},
+    {"utilization", "disk.utilization.percentage", e_disk_io_counter::io_ms,
+     0.1, "%", 100}};
+
+/**
+ * @brief Construct a new check disk io::check disk io object
+ *
+ * @param io_context
+ * @param logger
+ * @param first_start_expected
+ * @param check_interval
+ * @param serv
+ * @param cmd_name
+ * @param cmd_line
+ * @param args
+ * @param cnf
+ * @param handler
+ */
+check_disk_io::check_disk_io(
+    const std::shared_ptr<asio::io_context>& io_context,
+    const std::shared_ptr<spdlog::logger>& logger,
+    time_point first_start_expected,
+    duration check_interval,
+    const std::string& serv,
+    const std::string& cmd_name,
+    const std::string& cmd_line,
+    const rapidjson::Value& args,
+    const engine_to_agent_request_ptr& cnf,
+    check::completion_handler&& handler,
+    const checks_statistics::pointer& stat)
+    : native_check_rate_base(io_context,
+                             logger,
+                             first_start_expected,
+                             check_interval,
+                             serv,
+                             cmd_name,
+                             cmd_line,
+                             cnf,
+                             std::move(handler),
+                             stat,
+                             "disk",
+                             _rate_definitions.size()) {
+  // loop and ram devices are not real disks
+  _exclude = std::make_unique<re2::RE2>("(loop|ram)\\d+");
+  if (!args.IsObject()) {
+    return;
+  }
+  for (auto member_iter = args.MemberBegin(); member_iter != args.MemberEnd();
+       ++member_iter) {
+    std::string key = absl::AsciiStrToLower(member_iter->name.GetString());
+    if (key == "partitions") {
+      std::optional<bool> val = get_bool(
+          cmd_name, member_iter->name.GetString(), member_iter->value);
+      if (val) {
+        _with_sub_devices = *val;
+      }
+    } else if (!_parse_common_arg(cmd_name, key, member_iter->value)) {
+      SPDLOG_LOGGER_ERROR(logger, "command: {}, unknown parameter {}",
+                          cmd_name, member_iter->name);
+    }
+  }
+}
+
+static shared_snapshot<disk_snapshot> _shared_diskstats;
+
+check_disk_io::snapshot_ptr check_disk_io::measure() {
+  return _shared_diskstats.get([] { return read_diskstats(); });
+}
+
+const std::vector<rate_definition>& check_disk_io::get_rate_definitions()
+    const {
+  return _rate_definitions;
+}
+
+void check_disk_io::dump_device(const std::string& device,
+                                const std::vector<double>& rates,
+                                std::string* output) const {
+  fmt::format_to(std::back_inserter(*output),
+                 "{} read: {:.0f} B/s ({:.1f} iops), write: {:.0f} B/s "
+                 "({:.1f} iops), utilization: {:.2f}%",
+                 device, rates[0], rates[2], rates[1], rates[3], rates[4]);
+}
+
+void check_disk_io::help(std::ostream& help_stream) {
+  help_stream << R"(
+- disk_io params:
+    filter-disk: regex, only disks whose name matches it are checked
+    exclude-disk (default "(loop|ram)\d+"): regex, disks whose name matches it are not checked
+    partitions (default false): true: partitions are also checked
+    warning-read-bytes, critical-read-bytes: thresholds on read bytes per second
+    warning-write-bytes, critical-write-bytes: thresholds on written bytes per second
+    warning-read-iops, critical-read-iops: thresholds on read operations per second
+    warning-write-iops, critical-write-iops: thresholds on write operations per second
+    warning-utilization, critical-utilization: thresholds on the percentage of time the disk is busy
+  The first time, rates are measured over one second, then over the check interval.
+  An example of configuration:
+  {
+    "check": "disk_io",
+    "args": {
+      "filter-disk": "sd.*",
+      "warning-utilization": 80,
+      "critical-utilization": 95
+    }
+  }
+  Examples of output:
+    OK: All disks are ok
+    WARNING: sda read: 1048576 B/s (12.0 iops), write: 0 B/s (0.0 iops), utilization: 85.20%
+  Metrics:
+    <disk>#disk.read.bytespersecond
+    <disk>#disk.write.bytespersecond
+    <disk>#disk.read.iops
+    <disk>#disk.write.iops
+    <disk>#disk.utilization.percentage
+)";
+}
@@ -0,0 +1,229 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include <unistd.h>
+
+#include "check_load.hh"
+#include "com/centreon/common/rapidjson_helper.hh"
+#include "proc_file.hh"
+
+using namespace com::centreon::agent;
+
+namespace {
+constexpr std::array<std::string_view, 3> _load_labels = {"load1", "load5",
+                                                          "load15"};
+}
+
+/**
+ * @brief Construct a new check load::check load object
+ *
+ * @param io_context
+ * @param logger
+ * @param first_start_expected
+ * @param check_interval
+ * @param serv
+ * @param cmd_name
+ * @param cmd_line
+ * @param args
+ * @param cnf
+ * @param handler
+ */
+check_load::check_load(const std::shared_ptr<asio::io_context>& io_context,
+                       const std::shared_ptr<spdlog::logger>& logger,
+                       time_point first_start_expected,
+                       duration check_interval,
+                       const std::string& serv,
+                       const std::string& cmd_name,
+                       const std::string& cmd_line,
+                       const rapidjson::Value& args,
+                       const engine_to_agent_request_ptr& cnf,
+                       check::completion_handler&& handler,
+                       const checks_statistics::pointer& stat)
+    : check(io_context,
+            logger,
+            first_start_expected,
+            check_interval,
+            serv,
+            cmd_name,
+            cmd_line,
+            cnf,
+            std::move(handler),
+            stat) {
+  _warning_thresholds.fill(std::numeric_limits<double>::quiet_NaN());
+  _critical_thresholds.fill(std::numeric_limits<double>::quiet_NaN());
+  if (!args.IsObject()) {
+    return;
+  }
+  for (auto member_iter = args.MemberBegin(); member_iter != args.MemberEnd();
+       ++member_iter) {
+    std::string key = absl::AsciiStrToLower(member_iter->name.GetString());
+    if (key == "per-cpu") {
+      std::optional<bool> val =
+          get_bool(cmd_name, member_iter->name.GetString(), member_iter->value);
+      if (val) {
+        _per_cpu = *val;
+      }
+      continue;
+    }
+    load_array* thresholds = nullptr;
+    std::string_view label;
+    if (absl::StartsWith(key, "warning-")) {
+      thresholds = &_warning_thresholds;
+      label = std::string_view(key).substr(8);
+    } else if (absl::StartsWith(key, "critical-")) {
+      thresholds = &_critical_thresholds;
+      label = std::string_view(key).substr(9);
+    }
+    auto label_iter =
+        std::find(_load_labels.begin(), _load_labels.end(), label);
+    if (!thresholds || label_iter == _load_labels.end()) {
+      SPDLOG_LOGGER_ERROR(logger, "command: {}, unknown parameter {}",
+                          cmd_name, member_iter->name);
+      continue;
+    }
+    std::optional<double> val = get_double(
+        cmd_name, member_iter->name.GetString(), member_iter->value, true);
+    if (val) {
+      (*thresholds)[label_iter - _load_labels.begin()] = *val;
+    }
+  }
+}
+
+/**
+ * @brief parse /proc/loadavg, content is like
+ * 0.52 0.48 0.40 2/1208 265113
+ *
+ * @param proc_file path of the file, other than /proc/loadavg in unit tests
+ * @return load_array load1, load5 and load15
+ */
+check_load::load_array check_load::read_loadavg(const char* proc_file) {
+  thread_local std::string buffer;
+  read_proc_file(proc_file, &buffer);
+  load_array ret;
+  auto field_iter = absl::StrSplit(buffer, ' ').begin();
+  for (double& load : ret) {
+    if (!absl::SimpleAtod(*field_iter, &load)) {
+      throw exceptions::msg_fmt("bad {} content: {}", proc_file, buffer);
+    }
+    ++field_iter;
+  }
+  return ret;
+}
+
+/**
+ * @brief read /proc/loadavg and compute status
+ *
+ * @param timeout unused
+ */
+void check_load::start_check([[maybe_unused]] const duration& timeout) {
+  if (!_start_check(timeout)) {
+    return;
+  }
+  std::string output;
+  std::list<common::perfdata> perfs;
+  e_status status;
+  try {
+    long nb_cpu = _per_cpu ? sysconf(_SC_NPROCESSORS_ONLN) : 1;
+    status = compute(read_loadavg(), nb_cpu > 0 ? nb_cpu : 1, &output, &perfs);
+  } catch (const std::exception& e) {
+    SPDLOG_LOGGER_ERROR(_logger, "{} fail to get load average: {}",
+                        get_command_name(), e.what());
+    status = e_status::unknown;
+    output = fmt::format("UNKNOWN: {}", e.what());
+  }
+
+  asio::post(*_io_context, [me = shared_from_this(), this,
+                            out = std::move(output), status,
+                            performances = std::move(perfs)]() {
+    on_completion(_get_running_check_index(), status, performances, {out});
+  });
+}
+
+/**
+ * @brief calculate status, output and perfdata from load average
+ *
+ * @param loads load1, load5 and load15 as read in /proc/loadavg
+ * @param nb_cpu loads are divided by this number
+ * @param output
+ * @param perfs
+ * @return e_status
+ */
+e_status check_load::compute(const load_array& loads,
+                             unsigned nb_cpu,
+                             std::string* output,
+                             std::list<common::perfdata>* perfs) {
+  e_status status = e_status::ok;
+  for (size_t load_index = 0; load_index < loads.size(); ++load_index) {
+    double load = loads[load_index] / nb_cpu;
+    // comparisons with NaN (no threshold) are always false
+    if (load >= _critical_thresholds[load_index]) {
+      status = e_status::critical;
+    } else if (load >= _warning_thresholds[load_index] &&
+               status == e_status::ok) {
+      status = e_status::warning;
+    }
+
+    common::perfdata& perf = perfs->emplace_back();
+    perf.name(_load_labels[load_index]);
+    perf.value(load);
+    perf.min(0);
+    if (!std::isnan(_warning_thresholds[load_index])) {
+      perf.warning_low(0);
+      perf.warning(_warning_thresholds[load_index]);
+    }
+    if (!std::isnan(_critical_thresholds[load_index])) {
+      perf.critical_low(0);
+      perf.critical(_critical_thresholds[load_index]);
+    }
+  }
+
+  *output = fmt::format("{}: Load average{}: {:.2f}, {:.2f}, {:.2f}",
+                        status_label[status], _per_cpu ? " per cpu" : "",
+                        loads[0] / nb_cpu, loads[1] / nb_cpu,
+                        loads[2] / nb_cpu);
+  return status;
+}
+
+void check_load::help(std::ostream& help_stream) {
+  help_stream <<
+      R"(
+- load params:
+    per-cpu (default false): true: load average is divided by the number of cpus
+    warning-load1: warning threshold on the 1 minute load average
+    critical-load1: critical threshold on the 1 minute load average
+    warning-load5: warning threshold on the 5 minutes load average
+    critical-load5: critical threshold on the 5 minutes load average
+    warning-load15: warning threshold on the 15 minutes load average
+    critical-load15: critical threshold on the 15 minutes load average
+  An example of configuration:
+  {
+    "check": "load",
+    "args": {
+      "per-cpu": true,
+      "warning-load5": 0.8,
+      "critical-load5": 1.5
+    }
+  }
+  Examples of output:
+    OK: Load average per cpu: 0.13, 0.12, 0.10
+  Metrics:
+    load1
+    load5
+    load15
+)";
+}
@@ -0,0 +1,475 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "check_memory.hh"
+#include "native_check_base.cc"
+#include "proc_file.hh"
+
+using namespace com::centreon::agent;
+using namespace com::centreon::agent::native_check_detail;
+
+namespace com::centreon::agent::native_check_detail {
+/**
+ * @brief little struct used to format memory output (B, KB, MB or GB)
+ *
+ */
+struct byte_memory_metric {
+  uint64_t byte_value;
+};
+}  // namespace com::centreon::agent::native_check_detail
+
+namespace fmt {
+
+/**
+ * @brief formatter of byte_memory_metric
+ *
+ * @tparam
+ */
+template <>
+struct formatter<
+    com::centreon::agent::native_check_detail::byte_memory_metric> {
+  constexpr auto parse(format_parse_context& ctx)
+      -> format_parse_context::iterator {
+    return ctx.begin();
+  }
+  auto format(
+      const com::centreon::agent::native_check_detail::byte_memory_metric& v,
+      format_context& ctx) const -> format_context::iterator {
+    if (v.byte_value < 1024) {
+      return fmt::format_to(ctx.out(), "{} B", v.byte_value);
+    }
+    if (v.byte_value < 1024 * 1024) {
+      return fmt::format_to(
+          ctx.out(), "{} KB",
+          static_cast<double>(v.byte_value * 100 / 1024) / 100);
+    }
+
+    if (v.byte_value < 1024 * 1024 * 1024) {
+      return fmt::format_to(
+          ctx.out(), "{} MB",
+          static_cast<double>(v.byte_value * 100 / 1024 / 1024) / 100);
+    }
+    if (v.byte_value < 1024ull * 1024 * 1024 * 1024) {
+      return fmt::format_to(
+          ctx.out(), "{} GB",
+          static_cast<double>(v.byte_value * 100 / 1024ull / 1024 / 1024) /
+              100);
+    }
+    return fmt::format_to(
+        ctx.out(), "{} TB",
+        static_cast<double>(v.byte_value * 100 / 1024ull / 1024 / 1024 / 1024) /
+            100);
+  }
+};
+}  // namespace fmt
+
+namespace com::centreon::agent::native_check_detail {
+
+/**
+ * @brief labels of /proc/meminfo lines in e_field order
+ *
+ */
+constexpr std::array<std::string_view, meminfo::e_field::nb_field>
+    _meminfo_labels = {"MemTotal",  "MemFree",     "MemAvailable",
+                       "Buffers",   "Cached",      "SwapTotal",
+                       "SwapFree",  "CommitLimit", "Committed_AS"};
+
+/**
+ * @brief parse /proc/meminfo, lines are like
+ * MemTotal:       16318480 kB
+ *
+ * @param proc_file path of the proc file usually: /proc/meminfo, other for
+ * unit tests
+ */
+meminfo::meminfo(const char* proc_file) {
+  _fields.fill(0);
+  thread_local std::string buffer;
+  read_proc_file(proc_file, &buffer);
+
+  bool mem_available_found = false;
+  for (std::string_view line :
+       absl::StrSplit(buffer, '\n', absl::SkipEmpty())) {
+    size_t colon = line.find(':');
+    if (colon == std::string_view::npos) {
+      continue;
+    }
+    auto label =
+        std::find(_meminfo_labels.begin(), _meminfo_labels.end(),
+                  line.substr(0, colon));
+    if (label == _meminfo_labels.end()) {
+      continue;
+    }
+    std::string_view value =
+        absl::StripLeadingAsciiWhitespace(line.substr(colon + 1));
+    value = value.substr(0, value.find(' '));
+    uint64_t kb;
+    if (absl::SimpleAtoi(value, &kb)) {
+      _fields[label - _meminfo_labels.begin()] = kb * 1024;
+      if (label - _meminfo_labels.begin() == e_field::mem_available) {
+        mem_available_found = true;
+      }
+    }
+  }
+  // old kernels don't give MemAvailable
+  if (!mem_available_found) {
+    _fields[e_field::mem_available] = _fields[e_field::mem_free] +
+                                      _fields[e_field::buffers] +
+                                      _fields[e_field::cached];
+  }
+}
+
+/**
+ * @brief fills _metrics
+ *
+ * @param info /proc/meminfo content
+ * @param flags output_flags to add swap or virtual memory to output
+ */
+l_memory_info::l_memory_info(const meminfo& info, unsigned flags)
+    : _output_flags(flags) {
+  _metrics[e_memory_metric::phys_total] =
+      info.get_field(meminfo::e_field::mem_total);
+  _metrics[e_memory_metric::phys_free] =
+      std::min(info.get_field(meminfo::e_field::mem_available),
+               _metrics[e_memory_metric::phys_total]);
+  _metrics[e_memory_metric::phys_used] =
+      _metrics[e_memory_metric::phys_total] -
+      _metrics[e_memory_metric::phys_free];
+  _metrics[e_memory_metric::swap_total] =
+      info.get_field(meminfo::e_field::swap_total);
+  _metrics[e_memory_metric::swap_free] =
+      std::min(info.get_field(meminfo::e_field::swap_free),
+               _metrics[e_memory_metric::swap_total]);
+  _metrics[e_memory_metric::swap_used] = _metrics[e_memory_metric::swap_total] -
+                                         _metrics[e_memory_metric::swap_free];
+  // commit charge can be greater than the limit if overcommit is allowed
+  _metrics[e_memory_metric::virtual_total] =
+      info.get_field(meminfo::e_field::commit_limit);
+  _metrics[e_memory_metric::virtual_used] =
+      info.get_field(meminfo::e_field::committed_as);
+  _metrics[e_memory_metric::virtual_free] =
+      _metrics[e_memory_metric::virtual_used] <
+              _metrics[e_memory_metric::virtual_total]
+          ? _metrics[e_memory_metric::virtual_total] -
+                _metrics[e_memory_metric::virtual_used]
+          : 0;
+}
+
+/**
+ * @brief plugins output
+ *
+ * @param output
+ */
+void l_memory_info::dump_to_output(std::string* output) const {
+  fmt::format_to(std::back_inserter(*output),
+                 "Ram total: {}, used (-buffers/cache): {} ({:.2f}%), "
+                 "free: {} ({:.2f}%)",
+                 byte_memory_metric{_metrics[e_memory_metric::phys_total]},
+                 byte_memory_metric{_metrics[e_memory_metric::phys_used]},
+                 get_proportional_value(e_memory_metric::phys_used,
+                                        e_memory_metric::phys_total) *
+                     100,
+                 byte_memory_metric{_metrics[e_memory_metric::phys_free]},
+                 get_proportional_value(e_memory_metric::phys_free,
+                                        e_memory_metric::phys_total) *
+                     100);
+
+  if (_output_flags & output_flags::dump_swap) {
+    fmt::format_to(std::back_inserter(*output),
+                   " Swap total: {}, used: {} ({:.2f}%), free: {} ({:.2f}%)",
+                   byte_memory_metric{_metrics[e_memory_metric::swap_total]},
+                   byte_memory_metric{_metrics[e_memory_metric::swap_used]},
+                   get_proportional_value(e_memory_metric::swap_used,
+                                          e_memory_metric::swap_total) *
+                       100,
+                   byte_memory_metric{_metrics[e_memory_metric::swap_free]},
+                   get_proportional_value(e_memory_metric::swap_free,
+                                          e_memory_metric::swap_total) *
+                       100);
+  }
+
+  if (_output_flags & output_flags::dump_virtual) {
+    fmt::format_to(std::back_inserter(*output),
+                   " Virtual total: {}, used: {} ({:.2f}%), free: {} ({:.2f}%)",
+                   byte_memory_metric{_metrics[e_memory_metric::virtual_total]},
+                   byte_memory_metric{_metrics[e_memory_metric::virtual_used]},
+                   get_proportional_value(e_memory_metric::virtual_used,
+                                          e_memory_metric::virtual_total) *
+                       100,
+                   byte_memory_metric{_metrics[e_memory_metric::virtual_free]},
+                   get_proportional_value(e_memory_metric::virtual_free,
+                                          e_memory_metric::virtual_total) *
+                       100);
+  }
+}
+
+}  // namespace com::centreon::agent::native_check_detail
+
+using linux_mem_to_status = measure_to_status<e_memory_metric::nb_metric>;
+
+using mem_to_status_constructor =
+    std::function<std::unique_ptr<linux_mem_to_status>(double /*threshold*/)>;
+
+/**
+ * @brief the eight thresholds of a kind of memory: on used or free memory, in
+ * bytes or in percentage
+ *
+ */
+#define MEMORY_TO_STATUS(LABEL, USED, FREE, TOTAL)                            \
+  {"critical-" LABEL,                                                         \
+   [](double threshold) {                                                     \
+     return std::make_unique<linux_mem_to_status>(                            \
+         e_status::critical, USED, threshold, TOTAL, false, false);           \
+   }},                                                                        \
+      {"warning-" LABEL,                                                      \
+       [](double threshold) {                                                 \
+         return std::make_unique<linux_mem_to_status>(                        \
+             e_status::warning, USED, threshold, TOTAL, false, false);        \
+       }},                                                                    \
+      {"critical-" LABEL "-free",                                             \
+       [](double threshold) {                                                 \
+         return std::make_unique<linux_mem_to_status>(                        \
+             e_status::critical, FREE, threshold, TOTAL, false, true);        \
+       }},                                                                    \
+      {"warning-" LABEL "-free",                                              \
+       [](double threshold) {                                                 \
+         return std::make_unique<linux_mem_to_status>(                        \
+             e_status::warning, FREE, threshold, TOTAL, false, true);         \
+       }},                                                                    \
+      {"critical-" LABEL "-prct",                                             \
+       [](double threshold) {                                                 \
+         return std::make_unique<linux_mem_to_status>(                        \
+             e_status::critical, USED, threshold / 100, TOTAL, true, false);  \
+       }},                                                                    \
+      {"warning-" LABEL "-prct",                                              \
+       [](double threshold) {                                                 \
+         return std::make_unique<linux_mem_to_status>(                        \
+             e_status::warning, USED, threshold / 100, TOTAL, true, false);   \
+       }},                                                                    \
+      {"critical-" LABEL "-free-prct",                                        \
+       [](double threshold) {                                                 \
+         return std::make_unique<linux_mem_to_status>(                        \
+             e_status::critical, FREE, threshold / 100, TOTAL, true, true);   \
+       }},                                                                    \
+  {                                                                           \
+    "warning-" LABEL "-free-prct", [](double threshold) {                     \
+      return std::make_unique<linux_mem_to_status>(                           \
+          e_status::warning, FREE, threshold / 100, TOTAL, true, true);       \
+    }                                                                         \
+  }
+
+/**
+ * @brief status threshold defines, same labels as windows check_memory
+ *
+ */
+static const absl::flat_hash_map<std::string_view, mem_to_status_constructor>
+    _label_to_mem_to_status = {
+        MEMORY_TO_STATUS("usage",
+                         e_memory_metric::phys_used,
+                         e_memory_metric::phys_free,
+                         e_memory_metric::phys_total),
+        MEMORY_TO_STATUS("swap",
+                         e_memory_metric::swap_used,
+                         e_memory_metric::swap_free,
+                         e_memory_metric::swap_total),
+        MEMORY_TO_STATUS("virtual",
+                         e_memory_metric::virtual_used,
+                         e_memory_metric::virtual_free,
+                         e_memory_metric::virtual_total)};
+
+/**
+ * @brief Construct a new check memory::check memory object
+ *
+ * @param io_context
+ * @param logger
+ * @param first_start_expected
+ * @param check_interval
+ * @param serv
+ * @param cmd_name
+ * @param cmd_line
+ * @param args
+ * @param cnf
+ * @param handler
+ */
+check_memory::check_memory(const std::shared_ptr<asio::io_context>& io_context,
+                           const std::shared_ptr<spdlog::logger>& logger,
+                           time_point first_start_expected,
+                           duration check_interval,
+                           const std::string& serv,
+                           const std::string& cmd_name,
+                           const std::string& cmd_line,
+                           const rapidjson::Value& args,
+                           const engine_to_agent_request_ptr& cnf,
+                           check::completion_handler&& handler,
+                           const checks_statistics::pointer& stat)
+    : native_check_base(io_context,
+                        logger,
+                        first_start_expected,
+                        check_interval,
+                        serv,
+                        cmd_name,
+                        cmd_line,
+                        args,
+                        cnf,
+                        std::move(handler),
+                        stat) {
+  _no_percent_unit = "B";
+  if (args.IsObject()) {
+    for (auto member_iter = args.MemberBegin(); member_iter != args.MemberEnd();
+         ++member_iter) {
+      std::string key = absl::AsciiStrToLower(member_iter->name.GetString());
+      if (key == "swap") {
+        std::optional<bool> val = get_bool(
+            cmd_name, member_iter->name.GetString(), member_iter->value);
+        if (val && *val) {
+          _output_flags |= l_memory_info::output_flags::dump_swap;
+        }
+        continue;
+      }
+      if (key == "virtual") {
+        std::optional<bool> val = get_bool(
+            cmd_name, member_iter->name.GetString(), member_iter->value);
+        if (val && *val) {
+          _output_flags |= l_memory_info::output_flags::dump_virtual;
+        }
+        continue;
+      }
+
+      auto mem_to_status_search = _label_to_mem_to_status.find(key);
+      if (mem_to_status_search != _label_to_mem_to_status.end()) {
+        std::optional<double> val = get_double(
+            cmd_name, member_iter->name.GetString(), member_iter->value, true);
+        if (val) {
+          std::unique_ptr<linux_mem_to_status> mem_checker =
+              mem_to_status_search->second(*val);
+          _measure_to_status.emplace(
+              std::make_tuple(mem_checker->get_data_index(),
+                              mem_checker->get_total_data_index(),
+                              mem_checker->get_status()),
+              std::move(mem_checker));
+        }
+      } else {
+        SPDLOG_LOGGER_ERROR(logger, "command: {}, unknown parameter {}",
+                            cmd_name, member_iter->name);
+      }
+    }
+  }
+}
+
+static shared_snapshot<meminfo> _shared_meminfo;
+
+/**
+ * @brief create a l_memory_info from the last /proc/meminfo read
+ *
+ * @return std::shared_ptr<
+ * native_check_detail::snapshot<native_check_detail::e_memory_metric::nb_metric>>
+ */
+std::shared_ptr<native_check_detail::snapshot<
+    native_check_detail::e_memory_metric::nb_metric>>
+check_memory::measure() {
+  std::shared_ptr<const meminfo> info =
+      _shared_meminfo.get([] { return std::make_shared<const meminfo>(); });
+  return std::make_shared<native_check_detail::l_memory_info>(*info,
+                                                              _output_flags);
+}
+
+/**
+ * @brief metric defines
+ *
+ */
+static const std::vector<native_check_detail::metric_definition>
+    metric_definitions = {
+        {"memory.usage.bytes", e_memory_metric::phys_used,
+         e_memory_metric::phys_total, false},
+        {"memory.free.bytes", e_memory_metric::phys_free,
+         e_memory_metric::phys_total, false},
+        {"memory.usage.percentage", e_memory_metric::phys_used,
+         e_memory_metric::phys_total, true},
+
+        {"swap.usage.bytes", e_memory_metric::swap_used,
+         e_memory_metric::swap_total, false},
+        {"swap.free.bytes", e_memory_metric::swap_free,
+         e_memory_metric::swap_total, false},
+        {"swap.usage.percentage", e_memory_metric::swap_used,
+         e_memory_metric::swap_total, true},
+
+        {"virtual-memory.usage.bytes", e_memory_metric::virtual_used,
+         e_memory_metric::virtual_total, false},
+        {"virtual-memory.free.bytes", e_memory_metric::virtual_free,
+         e_memory_metric::virtual_total, false},
+        {"virtual-memory.usage.percentage", e_memory_metric::virtual_used,
+         e_memory_metric::virtual_total, true},
+};
+
+const std::vector<native_check_detail::metric_definition>&
+check_memory::get_metric_definitions() const {
+  return metric_definitions;
+}
+
+void check_memory::help(std::ostream& help_stream) {
+  help_stream << R"(
+- memory params:
+    swap (default false): true: add swap to output
+    virtual (default false): true: add virtual memory (commit charge) to output
+    critical-usage: threshold for critical status on physical memory usage in bytes
+    warning-usage: threshold for warning status on physical memory usage in bytes
+    critical-usage-free: threshold for critical status on free physical memory in bytes, if free memory is lower than threshold, service is critical
+    warning-usage-free: threshold for warning status on free physical memory in bytes
+    critical-usage-prct: threshold for critical status on memory usage in percentage
+    warning-usage-prct: threshold for warning status on memory usage in percentage
+    critical-usage-free-prct: threshold for critical status on free memory in percentage
+    warning-usage-free-prct: threshold for warning status on free memory in percentage
+    critical-swap: threshold for critical status on swap usage in bytes
+    warning-swap: threshold for warning status on swap usage in bytes
+    critical-swap-free: threshold for critical status on free swap in bytes
+    warning-swap-free: threshold for warning status on free swap in bytes
+    critical-swap-prct: threshold for critical status on swap usage in percentage
+    warning-swap-prct: threshold for warning status on swap usage in percentage
+    critical-swap-free-prct: threshold for critical status on free swap in percentage
+    warning-swap-free-prct: threshold for warning status on free swap in percentage
+    critical-virtual: threshold for critical status on committed memory in bytes
+    warning-virtual: threshold for warning status on committed memory in bytes
+    critical-virtual-free: threshold for critical status on free commit limit in bytes
+    warning-virtual-free: threshold for warning status on free commit limit in bytes
+    critical-virtual-prct: threshold for critical status on committed memory in percentage of commit limit
+    warning-virtual-prct: threshold for warning status on committed memory in percentage of commit limit
+    critical-virtual-free-prct: threshold for critical status on free commit limit in percentage
+    warning-virtual-free-prct: threshold for warning status on free commit limit in percentage
+  used memory is total memory minus available memory (free, buffers and page cache)
+  An example of configuration:
+  {
+    "check": "memory",
+    "args": {
+      "swap": true,
+      "warning-usage-prct": 80,
+      "critical-usage-prct": 90
+    }
+  }
+  Examples of output:
+    OK: Ram total: 15.56 GB, used (-buffers/cache): 6.20 GB (39.84%), free: 9.36 GB (60.16%) Swap total: 2 GB, used: 0 B (0.00%), free: 2 GB (100.00%)
+  Metrics:
+    memory.usage.bytes
+    memory.free.bytes
+    memory.usage.percentage
+    swap.usage.bytes
+    swap.free.bytes
+    swap.usage.percentage
+    virtual-memory.usage.bytes
+    virtual-memory.free.bytes
+    virtual-memory.usage.percentage
+)";
+}
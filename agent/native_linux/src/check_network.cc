@@ -0,0 +1,208 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "check_network.hh"
+#include "native_check_rate_base.cc"
+#include "proc_file.hh"
+
+using namespace com::centreon::agent;
+using namespace com::centreon::agent::native_check_detail;
+
+using network_snapshot =
+    counter_snapshot<e_network_counter::nb_network_counter>;
+
+/**
+ * @brief parse /proc/net/dev, after two header lines, lines are like
+ *   eth0: 1234 12 0 0 0 0 0 0 5678 34 0 0 0 0 0 0
+ * receive fields are bytes packets errs drop fifo frame compressed multicast
+ * then transmit fields are bytes packets errs drop fifo colls carrier
+ * compressed
+ *
+ * @param proc_file usually /proc/net/dev
+ * @return std::shared_ptr<network_snapshot>
+ */
+std::shared_ptr<network_snapshot> native_check_detail::read_net_dev(
+    const char* proc_file) {
+  // index of counters in fields after interface name
+  static constexpr std::array<unsigned, e_network_counter::nb_network_counter>
+      field_index = {0, 1, 2, 3, 8, 9, 10, 11};
+
+  thread_local std::string buffer;
+  read_proc_file(proc_file, &buffer);
+
+  auto ret = std::make_shared<network_snapshot>();
+  ret->time = std::chrono::steady_clock::now();
+  for (std::string_view line :
+       absl::StrSplit(buffer, '\n', absl::SkipEmpty())) {
+    size_t colon = line.find(':');
+    // header lines have no colon
+    if (colon == std::string_view::npos) {
+      continue;
+    }
+    std::vector<std::string_view> fields =
+        absl::StrSplit(line.substr(colon + 1), ' ', absl::SkipEmpty());
+    if (fields.size() <= field_index.back()) {
+      continue;
+    }
+    network_snapshot::counter_array counters;
+    bool parse_ok = true;
+    for (unsigned counter = 0; counter < counters.size() && parse_ok;
+         ++counter) {
+      parse_ok =
+          absl::SimpleAtoi(fields[field_index[counter]], &counters[counter]);
+    }
+    if (parse_ok) {
+      ret->devices.emplace(
+          absl::StripAsciiWhitespace(line.substr(0, colon)), counters);
+    }
+  }
+  return ret;
+}
+
+/**
+ * @brief rate defines, traffic is in bits per second
+ *
+ */
+static const std::vector<rate_definition> _rate_definitions = {
+    {"in-bits", "network.in.bitspersecond", e_network_counter::in_bytes, 8,
+     "b/s", 0},
+    {"out-bits", "network.out.bitspersecond", e_network_counter::out_bytes, 8,
+     "b/s", 0},
+    {"in-packets", "network.in.packetspersecond",
+     e_network_counter::in_packets, 1, nullptr, 0},
+    {"out-packets", "network.out.packetspersecond",
+     e_network_counter::out_packets, 1, nullptr, 0},
+    {"in-errors", "network.in.errorspersecond", e_network_counter::in_errors,
+     1, nullptr, 0},
+    {"out-errors", "network.out.errorspersecond",
+     e_network_counter::out_errors, 1, nullptr, 0},
+    {"in-drops", "network.in.dropspersecond", e_network_counter::in_drops, 1,
+     nullptr, 0},
+    {"out-drops", "network.out.dropspersecond", e_network_counter::out_drops,
+     1, nullptr, 0}};
+
+/**
+ * @brief Construct a new check network::check network object
+ *
+ * @param io_context
+ * @param logger
+ * @param first_start_expected
+ * @param check_interval
+ * @param serv
+ * @param cmd_name
+ * @param cmd_line
+ * @param args
+ * @param cnf
+ * @param handler
+ */
+check_network::check_network(
+    const std::shared_ptr<asio::io_context>& io_context,
+    const std::shared_ptr<spdlog::logger>& logger,
+    time_point first_start_expected,
+    duration check_interval,
+    const std::string& serv,
+    const std::string& cmd_name,
+    const std::string& cmd_line,
+    const rapidjson::Value& args,
+    const engine_to_agent_request_ptr& cnf,
+    check::completion_handler&& handler,
+    const checks_statistics::pointer& stat)
+    : native_check_rate_base(io_context,
+                             logger,
+                             first_start_expected,
+                             check_interval,
+                             serv,
+                             cmd_name,
+                             cmd_line,
+                             cnf,
+                             std::move(handler),
+                             stat,
+                             "interface",
+                             _rate_definitions.size()) {
+  _exclude = std::make_unique<re2::RE2>("lo");
+  if (!args.IsObject()) {
+    return;
+  }
+  for (auto member_iter = args.MemberBegin(); member_iter != args.MemberEnd();
+       ++member_iter) {
+    std::string key = absl::AsciiStrToLower(member_iter->name.GetString());
+    if (!_parse_common_arg(cmd_name, key, member_iter->value)) {
+      SPDLOG_LOGGER_ERROR(logger, "command: {}, unknown parameter {}",
+                          cmd_name, member_iter->name);
+    }
+  }
+}
+
+static shared_snapshot<network_snapshot> _shared_net_dev;
+
+check_network::snapshot_ptr check_network::measure() {
+  return _shared_net_dev.get([] { return read_net_dev(); });
+}
+
+const std::vector<rate_definition>& check_network::get_rate_definitions()
+    const {
+  return _rate_definitions;
+}
+
+void check_network::dump_device(const std::string& device,
+                                const std::vector<double>& rates,
+                                std::string* output) const {
+  fmt::format_to(std::back_inserter(*output),
+                 "{} in: {:.0f} b/s ({:.1f} packets/s, {:.1f} errors/s, "
+                 "{:.1f} drops/s), out: {:.0f} b/s ({:.1f} packets/s, "
+                 "{:.1f} errors/s, {:.1f} drops/s)",
+                 device, rates[0], rates[2], rates[4], rates[6], rates[1],
+                 rates[3], rates[5], rates[7]);
+}
+
+void check_network::help(std::ostream& help_stream) {
+  help_stream << R"(
+- network params:
+    filter-interface: regex, only interfaces whose name matches it are checked
+    exclude-interface (default "lo"): regex, interfaces whose name matches it are not checked
+    warning-in-bits, critical-in-bits: thresholds on received bits per second
+    warning-out-bits, critical-out-bits: thresholds on sent bits per second
+    warning-in-packets, critical-in-packets: thresholds on received packets per second
+    warning-out-packets, critical-out-packets: thresholds on sent packets per second
+    warning-in-errors, critical-in-errors: thresholds on receive errors per second
+    warning-out-errors, critical-out-errors: thresholds on transmit errors per second
+    warning-in-drops, critical-in-drops: thresholds on dropped received packets per second
+    warning-out-drops, critical-out-drops: thresholds on dropped sent packets per second
+  The first time, rates are measured over one second, then over the check interval.
+  An example of configuration:
+  {
+    "check": "network",
+    "args": {
+      "filter-interface": "eth.*",
+      "warning-in-bits": 500000000,
+      "critical-in-errors": 1
+    }
+  }
+  Examples of output:
+    OK: All interfaces are ok
+  Metrics:
+    <interface>#network.in.bitspersecond
+    <interface>#network.out.bitspersecond
+    <interface>#network.in.packetspersecond
+    <interface>#network.out.packetspersecond
+    <interface>#network.in.errorspersecond
+    <interface>#network.out.errorspersecond
+    <interface>#network.in.dropspersecond
+    <interface>#network.out.dropspersecond
+)";
+}
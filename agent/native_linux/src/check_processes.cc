@@ -0,0 +1,340 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include <dirent.h>
+
+#include "check_processes.hh"
+#include "native_check_base.cc"
+#include "proc_file.hh"
+
+using namespace com::centreon::agent;
+using namespace com::centreon::agent::native_check_detail;
+
+/**
+ * @brief read /proc/<pid>/stat of all processes
+ * processes that disappear during the scan are ignored
+ *
+ * @param proc_dir usually /proc, other in unit tests
+ */
+process_list::process_list(const char* proc_dir) {
+  DIR* dir = opendir(proc_dir);
+  if (!dir) {
+    throw exceptions::msg_fmt("fail to open {}: {}", proc_dir,
+                              strerror(errno));
+  }
+  thread_local std::string buffer;
+  std::string stat_path;
+  process proc;
+  for (struct dirent* entry = readdir(dir); entry; entry = readdir(dir)) {
+    if (!absl::ascii_isdigit(entry->d_name[0])) {
+      continue;
+    }
+    stat_path.assign(proc_dir);
+    stat_path.push_back('/');
+    stat_path.append(entry->d_name);
+    stat_path.append("/stat");
+    try {
+      read_proc_file(stat_path.c_str(), &buffer);
+    } catch (const std::exception&) {
+      continue;
+    }
+    if (parse_stat(buffer, &proc)) {
+      _processes.push_back(std::move(proc));
+    }
+  }
+  closedir(dir);
+}
+
+/**
+ * @brief parse content of a /proc/<pid>/stat file, it's like
+ * 1234 (comm) S 1 1234 1234 0 -1 4194560 ... num_threads ...
+ * comm can contain spaces and parenthesis, so it ends at the last ')'
+ *
+ * @param stat_content
+ * @param proc out
+ * @return true parse ok
+ * @return false bad content
+ */
+bool process_list::parse_stat(std::string_view stat_content, process* proc) {
+  size_t comm_begin = stat_content.find('(');
+  size_t comm_end = stat_content.rfind(')');
+  if (comm_begin == std::string_view::npos ||
+      comm_end == std::string_view::npos || comm_end < comm_begin) {
+    return false;
+  }
+  proc->comm.assign(stat_content.data() + comm_begin + 1,
+                    comm_end - comm_begin - 1);
+
+  // fields after comm, field 0 is state (third field of the file) and
+  // num_threads is the twentieth field of the file
+  unsigned field_index = 0;
+  proc->nb_threads = 1;
+  for (std::string_view field : absl::StrSplit(
+           stat_content.substr(comm_end + 1), ' ', absl::SkipEmpty())) {
+    if (field_index == 0) {
+      proc->state = field[0];
+    } else if (field_index == 17) {
+      if (!absl::SimpleAtoi(field, &proc->nb_threads)) {
+        return false;
+      }
+      return true;
+    }
+    ++field_index;
+  }
+  return false;
+}
+
+/**
+ * @brief count processes by state
+ *
+ * @param processes
+ * @param filter if not null, only processes whose name matches it are counted
+ * @param exclude if not null, processes whose name matches it are not counted
+ */
+l_processes_count::l_processes_count(const process_list& processes,
+                                     const RE2* filter,
+                                     const RE2* exclude) {
+  _metrics.fill(0);
+  for (const process_list::process& proc : processes.get_processes()) {
+    if (filter && !RE2::FullMatch(proc.comm, *filter)) {
+      continue;
+    }
+    if (exclude && RE2::FullMatch(proc.comm, *exclude)) {
+      continue;
+    }
+    ++_metrics[e_processes_metric::proc_total];
+    _metrics[e_processes_metric::proc_threads] += proc.nb_threads;
+    switch (proc.state) {
+      case 'R':
+        ++_metrics[e_processes_metric::proc_running];
+        break;
+      case 'S':
+      case 'I':
+        ++_metrics[e_processes_metric::proc_sleeping];
+        break;
+      case 'D':
+        ++_metrics[e_processes_metric::proc_uninterruptible];
+        break;
+      case 'Z':
+        ++_metrics[e_processes_metric::proc_zombie];
+        break;
+      case 'T':
+      case 't':
+        ++_metrics[e_processes_metric::proc_stopped];
+        break;
+    }
+  }
+}
+
+/**
+ * @brief plugins output
+ *
+ * @param output
+ */
+void l_processes_count::dump_to_output(std::string* output) const {
+  fmt::format_to(std::back_inserter(*output),
+                 "Processes total: {}, running: {}, sleeping: {}, "
+                 "uninterruptible: {}, zombie: {}, stopped: {}, threads: {}",
+                 _metrics[e_processes_metric::proc_total],
+                 _metrics[e_processes_metric::proc_running],
+                 _metrics[e_processes_metric::proc_sleeping],
+                 _metrics[e_processes_metric::proc_uninterruptible],
+                 _metrics[e_processes_metric::proc_zombie],
+                 _metrics[e_processes_metric::proc_stopped],
+                 _metrics[e_processes_metric::proc_threads]);
+}
+
+using processes_to_status =
+    measure_to_status<e_processes_metric::nb_processes_metric>;
+
+/**
+ * @brief threshold labels, thresholds are maximums
+ *
+ */
+static const absl::flat_hash_map<std::string_view, e_processes_metric>
+    _label_to_metric = {
+        {"total", e_processes_metric::proc_total},
+        {"running", e_processes_metric::proc_running},
+        {"uninterruptible", e_processes_metric::proc_uninterruptible},
+        {"zombie", e_processes_metric::proc_zombie},
+        {"stopped", e_processes_metric::proc_stopped},
+        {"threads", e_processes_metric::proc_threads}};
+
+/**
+ * @brief Construct a new check processes::check processes object
+ *
+ * @param io_context
+ * @param logger
+ * @param first_start_expected
+ * @param check_interval
+ * @param serv
+ * @param cmd_name
+ * @param cmd_line
+ * @param args
+ * @param cnf
+ * @param handler
+ */
+check_processes::check_processes(
+    const std::shared_ptr<asio::io_context>& io_context,
+    const std::shared_ptr<spdlog::logger>& logger,
+    time_point first_start_expected,
+    duration check_interval,
+    const std::string& serv,
+    const std::string& cmd_name,
+    const std::string& cmd_line,
+    const rapidjson::Value& args,
+    const engine_to_agent_request_ptr& cnf,
+    check::completion_handler&& handler,
+    const checks_statistics::pointer& stat)
+    : native_check_base(io_context,
+                        logger,
+                        first_start_expected,
+                        check_interval,
+                        serv,
+                        cmd_name,
+                        cmd_line,
+                        args,
+                        cnf,
+                        std::move(handler),
+                        stat) {
+  if (!args.IsObject()) {
+    return;
+  }
+  for (auto member_iter = args.MemberBegin(); member_iter != args.MemberEnd();
+       ++member_iter) {
+    std::string key = absl::AsciiStrToLower(member_iter->name.GetString());
+    if (key == "filter-process" || key == "exclude-process") {
+      if (!member_iter->value.IsString() ||
+          !member_iter->value.GetStringLength()) {
+        continue;
+      }
+      auto re = std::make_unique<re2::RE2>(member_iter->value.GetString());
+      if (!re->ok()) {
+        throw exceptions::msg_fmt("invalid regex for {}: {}", key,
+                                  member_iter->value.GetString());
+      }
+      (key == "filter-process" ? _filter : _exclude) = std::move(re);
+      continue;
+    }
+
+    e_status status = e_status::ok;
+    std::string_view label;
+    if (absl::StartsWith(key, "warning-")) {
+      status = e_status::warning;
+      label = std::string_view(key).substr(8);
+    } else if (absl::StartsWith(key, "critical-")) {
+      status = e_status::critical;
+      label = std::string_view(key).substr(9);
+    }
+    auto metric_search = _label_to_metric.find(label);
+    if (status == e_status::ok || metric_search == _label_to_metric.end()) {
+      SPDLOG_LOGGER_ERROR(logger, "command: {}, unknown parameter {}",
+                          cmd_name, member_iter->name);
+      continue;
+    }
+    std::optional<double> val = get_double(
+        cmd_name, member_iter->name.GetString(), member_iter->value, true);
+    if (val) {
+      _measure_to_status.emplace(
+          std::make_tuple(metric_search->second,
+                          e_processes_metric::nb_processes_metric, status),
+          std::make_unique<processes_to_status>(
+              status, metric_search->second, *val,
+              e_processes_metric::nb_processes_metric, false, false));
+    }
+  }
+}
+
+static shared_snapshot<process_list> _shared_process_list;
+
+/**
+ * @brief count processes of the last /proc scan
+ *
+ * @return std::shared_ptr<native_check_detail::snapshot<
+ * native_check_detail::e_processes_metric::nb_processes_metric>>
+ */
+std::shared_ptr<native_check_detail::snapshot<
+    native_check_detail::e_processes_metric::nb_processes_metric>>
+check_processes::measure() {
+  std::shared_ptr<const process_list> processes = _shared_process_list.get(
+      [] { return std::make_shared<const process_list>(); });
+  return std::make_shared<native_check_detail::l_processes_count>(
+      *processes, _filter.get(), _exclude.get());
+}
+
+/**
+ * @brief metric defines
+ *
+ */
+static const std::vector<native_check_detail::metric_definition>
+    metric_definitions = {
+        {"processes.total.count", e_processes_metric::proc_total,
+         e_processes_metric::nb_processes_metric, false},
+        {"processes.running.count", e_processes_metric::proc_running,
+         e_processes_metric::nb_processes_metric, false},
+        {"processes.sleeping.count", e_processes_metric::proc_sleeping,
+         e_processes_metric::nb_processes_metric, false},
+        {"processes.uninterruptible.count",
+         e_processes_metric::proc_uninterruptible,
+         e_processes_metric::nb_processes_metric, false},
+        {"processes.zombie.count", e_processes_metric::proc_zombie,
+         e_processes_metric::nb_processes_metric, false},
+        {"processes.stopped.count", e_processes_metric::proc_stopped,
+         e_processes_metric::nb_processes_metric, false},
+        {"threads.total.count", e_processes_metric::proc_threads,
+         e_processes_metric::nb_processes_metric, false},
+};
+
+const std::vector<native_check_detail::metric_definition>&
+check_processes::get_metric_definitions() const {
+  return metric_definitions;
+}
+
+void check_processes::help(std::ostream& help_stream) {
+  help_stream << R"(
+- processes params:
+    filter-process: regex, only processes whose name matches it are counted
+    exclude-process: regex, processes whose name matches it are not counted
+    warning-total: warning threshold on the number of processes
+    critical-total: critical threshold on the number of processes
+    warning-running, critical-running: thresholds on running processes
+    warning-uninterruptible, critical-uninterruptible: thresholds on processes in uninterruptible sleep (D state)
+    warning-zombie, critical-zombie: thresholds on zombie processes
+    warning-stopped, critical-stopped: thresholds on stopped processes
+    warning-threads, critical-threads: thresholds on the number of threads of counted processes
+  process name is the one of /proc/<pid>/stat (15 characters max)
+  An example of configuration:
+  {
+    "check": "processes",
+    "args": {
+      "warning-zombie": 5,
+      "critical-total": 1000
+    }
+  }
+  Examples of output:
+    OK: Processes total: 251, running: 1, sleeping: 250, uninterruptible: 0, zombie: 0, stopped: 0, threads: 976
+  Metrics:
+    processes.total.count
+    processes.running.count
+    processes.sleeping.count
+    processes.uninterruptible.count
+    processes.zombie.count
+    processes.stopped.count
+    threads.total.count
+)";
+}
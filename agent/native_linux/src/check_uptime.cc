@@ -0,0 +1,59 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "check_uptime.hh"
+#include "proc_file.hh"
+
+using namespace com::centreon::agent;
+
+/**
+ * @brief get uptime from the first field of /proc/uptime (seconds with two
+ * decimals)
+ *
+ * @param timeout unused
+ */
+void check_uptime::start_check([[maybe_unused]] const duration& timeout) {
+  if (!_start_check(timeout)) {
+    return;
+  }
+  std::string output;
+  common::perfdata perf;
+  e_status status;
+  try {
+    thread_local std::string buffer;
+    read_proc_file("/proc/uptime", &buffer);
+    std::string_view first_field(buffer);
+    first_field = first_field.substr(0, first_field.find(' '));
+    double uptime;
+    if (!absl::SimpleAtod(first_field, &uptime)) {
+      throw exceptions::msg_fmt("bad /proc/uptime content: {}", buffer);
+    }
+    status = compute(static_cast<uint64_t>(uptime * 1000), &output, &perf);
+  } catch (const std::exception& e) {
+    SPDLOG_LOGGER_ERROR(_logger, "{} fail to get uptime: {}",
+                        get_command_name(), e.what());
+    status = e_status::unknown;
+    output = fmt::format("UNKNOWN: {}", e.what());
+  }
+
+  asio::post(
+      *_io_context, [me = shared_from_this(), this, out = std::move(output),
+                     status, performance = std::move(perf)]() {
+        on_completion(_get_running_check_index(), status, {performance}, {out});
+      });
+}
@@ -0,0 +1,306 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "native_check_rate_base.hh"
+#include "com/centreon/common/rapidjson_helper.hh"
+
+using namespace com::centreon::agent;
+using namespace com::centreon::agent::native_check_detail;
+
+/**
+ * @brief Construct a new native check rate base object
+ *
+ * @param io_context
+ * @param logger
+ * @param first_start_expected start expected
+ * @param check_interval check interval between two checks
+ * @param serv service
+ * @param cmd_name
+ * @param cmd_line
+ * @param cnf engine configuration received object
+ * @param handler called at measure completion
+ * @param device_label used in output and filter params (disk, interface)
+ * @param nb_rate size of get_rate_definitions(), thresholds are sized with it
+ * as get_rate_definitions can't be called in this constructor
+ */
+template <unsigned nb_counter>
+native_check_rate_base<nb_counter>::native_check_rate_base(
+    const std::shared_ptr<asio::io_context>& io_context,
+    const std::shared_ptr<spdlog::logger>& logger,
+    time_point first_start_expected,
+    duration check_interval,
+    const std::string& serv,
+    const std::string& cmd_name,
+    const std::string& cmd_line,
+    const engine_to_agent_request_ptr& cnf,
+    check::completion_handler&& handler,
+    const checks_statistics::pointer& stat,
+    std::string_view device_label,
+    size_t nb_rate)
+    : check(io_context,
+            logger,
+            first_start_expected,
+            check_interval,
+            serv,
+            cmd_name,
+            cmd_line,
+            cnf,
+            std::move(handler),
+            stat),
+      _first_measure_timer(*io_context),
+      _device_label(device_label),
+      _warning(nb_rate, std::numeric_limits<double>::quiet_NaN()),
+      _critical(nb_rate, std::numeric_limits<double>::quiet_NaN()) {}
+
+/**
+ * @brief parse the params common to all rate checks:
+ * filter-<device_label>, exclude-<device_label>, warning-<rate label> and
+ * critical-<rate label>
+ * Must be called by the constructor of the final class as it uses
+ * get_rate_definitions
+ *
+ * @param cmd_name
+ * @param key lower case param name
+ * @param value
+ * @return true key is known
+ * @return false key is unknown
+ */
+template <unsigned nb_counter>
+bool native_check_rate_base<nb_counter>::_parse_common_arg(
+    const std::string& cmd_name,
+    const std::string& key,
+    const rapidjson::Value& value) {
+  const auto& rate_definitions = get_rate_definitions();
+
+  std::string_view label(key);
+  std::unique_ptr<RE2>* re = nullptr;
+  if (absl::ConsumePrefix(&label, "filter-") && label == _device_label) {
+    re = &_filter;
+  } else if (absl::ConsumePrefix(&label, "exclude-") &&
+             label == _device_label) {
+    re = &_exclude;
+  }
+  if (re) {
+    if (!value.IsString()) {
+      throw exceptions::msg_fmt("{} must be a string", key);
+    }
+    if (!value.GetStringLength()) {
+      re->reset();
+      return true;
+    }
+    *re = std::make_unique<re2::RE2>(value.GetString());
+    if (!(*re)->ok()) {
+      throw exceptions::msg_fmt("invalid regex for {}: {}", key,
+                                value.GetString());
+    }
+    return true;
+  }
+
+  label = key;
+  std::vector<double>* thresholds = nullptr;
+  if (absl::ConsumePrefix(&label, "warning-")) {
+    thresholds = &_warning;
+  } else if (absl::ConsumePrefix(&label, "critical-")) {
+    thresholds = &_critical;
+  } else {
+    return false;
+  }
+  for (size_t rate_index = 0; rate_index < rate_definitions.size();
+       ++rate_index) {
+    if (rate_definitions[rate_index].label == label) {
+      std::optional<double> val =
+          get_double(cmd_name, key.c_str(), value, true);
+      if (val) {
+        (*thresholds)[rate_index] = *val;
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief start a measure, the first time, a second measure is done
+ * first_measure_delay later
+ *
+ * @param timeout
+ */
+template <unsigned nb_counter>
+void native_check_rate_base<nb_counter>::start_check(const duration& timeout) {
+  if (!check::_start_check(timeout)) {
+    return;
+  }
+
+  unsigned start_check_index = _get_running_check_index();
+  try {
+    snapshot_ptr current = measure();
+    if (_previous && current->time > _previous->time) {
+      snapshot_ptr previous = std::move(_previous);
+      _previous = current;
+      asio::post(*_io_context, [me = shared_from_this(), start_check_index,
+                                previous, current]() {
+        me->_compute_and_complete(start_check_index, previous, current);
+      });
+      return;
+    }
+
+    _previous = current;
+    _first_measure_timer.expires_after(first_measure_delay);
+    _first_measure_timer.async_wait(
+        [me = shared_from_this(), start_check_index,
+         previous = current](const boost::system::error_code& err) {
+          if (err) {
+            return;
+          }
+          try {
+            snapshot_ptr current = me->measure();
+            me->_previous = current;
+            me->_compute_and_complete(start_check_index, previous, current);
+          } catch (const std::exception& e) {
+            SPDLOG_LOGGER_ERROR(me->_logger, "{} fail to measure: {}",
+                                me->get_command_name(), e.what());
+            me->on_completion(start_check_index, e_status::unknown, {},
+                              {e.what()});
+          }
+        });
+  } catch (const std::exception& e) {
+    SPDLOG_LOGGER_ERROR(_logger, "{} fail to measure: {}", get_command_name(),
+                        e.what());
+    asio::post(*_io_context, [me = shared_from_this(), start_check_index,
+                              err = std::string(e.what())] {
+      me->on_completion(start_check_index, e_status::unknown, {}, {err});
+    });
+  }
+}
+
+template <unsigned nb_counter>
+void native_check_rate_base<nb_counter>::_compute_and_complete(
+    unsigned start_check_index,
+    const snapshot_ptr& previous,
+    const snapshot_ptr& current) {
+  std::string output;
+  std::list<common::perfdata> perfs;
+  e_status status = compute(*previous, *current, &output, &perfs);
+  on_completion(start_check_index, status, perfs, {output});
+}
+
+/**
+ * @brief compute rates of each device between two measures, status and
+ * perfdatas
+ * Devices in error are dumped in output
+ *
+ * @param previous
+ * @param current
+ * @param output plugins output
+ * @param perfs perfdatas
+ * @return e_status plugins status output
+ */
+template <unsigned nb_counter>
+e_status native_check_rate_base<nb_counter>::compute(
+    const snapshot_type& previous,
+    const snapshot_type& current,
+    std::string* output,
+    std::list<common::perfdata>* perfs) const {
+  const auto& rate_definitions = get_rate_definitions();
+  double elapsed = std::chrono::duration_cast<std::chrono::duration<double>>(
+                       current.time - previous.time)
+                       .count();
+  if (elapsed <= 0) {
+    elapsed = 1;
+  }
+
+  e_status status = e_status::ok;
+  std::vector<double> rates(rate_definitions.size());
+  output->clear();
+  for (const auto& [device, counters] : current.devices) {
+    if (!_with_sub_devices && current.sub_devices.contains(device)) {
+      continue;
+    }
+    if (_filter && !RE2::FullMatch(device, *_filter)) {
+      continue;
+    }
+    if (_exclude && RE2::FullMatch(device, *_exclude)) {
+      continue;
+    }
+    auto previous_counters = previous.devices.find(device);
+    if (previous_counters == previous.devices.end()) {
+      continue;
+    }
+
+    e_status device_status = e_status::ok;
+    for (size_t rate_index = 0; rate_index < rate_definitions.size();
+         ++rate_index) {
+      const rate_definition& def = rate_definitions[rate_index];
+      uint64_t current_value = counters[def.counter_index];
+      uint64_t previous_value = previous_counters->second[def.counter_index];
+      // counter reset (device reinitialized)
+      double& rate = rates[rate_index];
+      rate = current_value >= previous_value
+                 ? (current_value - previous_value) * def.multiplier / elapsed
+                 : 0;
+      // comparisons with NaN (no threshold) are always false
+      if (rate > _critical[rate_index]) {
+        device_status = e_status::critical;
+      } else if (rate > _warning[rate_index] &&
+                 device_status == e_status::ok) {
+        device_status = e_status::warning;
+      }
+
+      common::perfdata& perf = perfs->emplace_back();
+      perf.name(fmt::format("{}#{}", device, def.metric_name));
+      if (def.unit) {
+        perf.unit(def.unit);
+      }
+      perf.min(0);
+      if (def.max) {
+        perf.max(def.max);
+      }
+      perf.value(rate);
+      if (!std::isnan(_warning[rate_index])) {
+        perf.warning_low(0);
+        perf.warning(_warning[rate_index]);
+      }
+      if (!std::isnan(_critical[rate_index])) {
+        perf.critical_low(0);
+        perf.critical(_critical[rate_index]);
+      }
+    }
+
+    if (device_status != e_status::ok) {
+      if (!output->empty()) {
+        output->push_back(' ');
+      }
+      output->append(status_label[device_status]);
+      output->append(": ");
+      dump_device(device, rates, output);
+      if (device_status > status) {
+        status = device_status;
+      }
+    }
+  }
+
+  if (output->empty()) {
+    if (perfs->empty()) {
+      *output = fmt::format("No {} found (filters issue)", _device_label);
+      status = e_status::critical;
+    } else {
+      *output = fmt::format("OK: All {}s are ok", _device_label);
+    }
+  }
+  return status;
+}
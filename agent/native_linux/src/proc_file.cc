@@ -0,0 +1,60 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "proc_file.hh"
+
+using namespace com::centreon::agent;
+
+/**
+ * @brief read a whole /proc or /sys file
+ * Those files have no size, so they are read until end of file. The buffer is
+ * reused by the caller from one read to the next, so once it has grown no
+ * allocation is done.
+ *
+ * @param path
+ * @param buffer out: content of the file
+ */
+void com::centreon::agent::read_proc_file(const char* path,
+                                          std::string* buffer) {
+  int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    throw exceptions::msg_fmt("fail to open {}: {}", path, strerror(errno));
+  }
+  // resize in the capacity doesn't allocate
+  buffer->resize(buffer->capacity());
+  size_t size = 0;
+  ssize_t read_size;
+  do {
+    if (buffer->size() - size < 4096) {
+      buffer->resize(std::max(2 * buffer->size(), size + 4096));
+    }
+    read_size = ::read(fd, buffer->data() + size, buffer->size() - size);
+    if (read_size > 0) {
+      size += read_size;
+    }
+  } while (read_size > 0 || (read_size < 0 && errno == EINTR));
+  int err = errno;
+  ::close(fd);
+  if (read_size < 0) {
+    throw exceptions::msg_fmt("fail to read {}: {}", path, strerror(err));
+  }
+  buffer->resize(size);
+}
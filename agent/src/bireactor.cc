@@ -103,6 +103,13 @@ void bireactor<bireactor_class>::OnReadDone(bool ok) {
   }
 }
 
+/**
+ * @brief push a message in the write queue
+ * The queue is not bounded here, scheduler doesn't pass requests while it's
+ * not empty and drops the oldest ones if engine is too slow
+ *
+ * @param request
+ */
 template <class bireactor_class>
 void bireactor<bireactor_class>::write(
     const std::shared_ptr<MessageFromAgent>& request) {
@@ -127,7 +134,22 @@ void bireactor<bireactor_class>::start_write() {
     to_send = _write_queue.front();
     _write_pending = true;
   }
-  bireactor_class::StartWrite(to_send.get());
+  if (to_send->ByteSizeLong() < min_compressed_size) {
+    bireactor_class::StartWrite(to_send.get(),
+                                ::grpc::WriteOptions().set_no_compression());
+  } else {
+    bireactor_class::StartWrite(to_send.get());
+  }
+}
+
+/**
+ * @brief number of messages not yet written, including the one being written
+ *
+ */
+template <class bireactor_class>
+size_t bireactor<bireactor_class>::get_write_queue_size() const {
+  std::lock_guard l(_protect);
+  return _write_queue.size();
 }
 
 template <class bireactor_class>
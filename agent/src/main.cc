@@ -24,7 +24,13 @@
 
 #include "agent_info.hh"
 #include "check_cpu.hh"
+#include "check_disk_io.hh"
 #include "check_health.hh"
+#include "check_load.hh"
+#include "check_memory.hh"
+#include "check_network.hh"
+#include "check_processes.hh"
+#include "check_uptime.hh"
 
 #include "config.hh"
 #include "drive_size.hh"
@@ -112,6 +118,12 @@ int main(int argc, char* argv[]) {
     std::cout << std::endl << "Native checks options:" << std::endl;
     check_cpu::help(std::cout);
     check_health::help(std::cout);
+    check_memory::help(std::cout);
+    check_uptime::help(std::cout);
+    check_load::help(std::cout);
+    check_processes::help(std::cout);
+    check_disk_io::help(std::cout);
+    check_network::help(std::cout);
     return 1;
   }
 
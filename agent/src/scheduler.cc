@@ -20,16 +20,21 @@
 #include "check.hh"
 #include "check_cpu.hh"
 #include "check_health.hh"
+#include "check_memory.hh"
+#include "check_uptime.hh"
 #include "config.hh"
 #ifdef _WIN32
 #include "check_counter.hh"
 #include "check_event_log.hh"
 #include "check_files.hh"
-#include "check_memory.hh"
 #include "check_process.hh"
 #include "check_sched.hh"
 #include "check_service.hh"
-#include "check_uptime.hh"
+#else
+#include "check_disk_io.hh"
+#include "check_load.hh"
+#include "check_network.hh"
+#include "check_processes.hh"
 #endif
 #include "check_exec.hh"
 #include "com/centreon/common/rapidjson_helper.hh"
@@ -81,6 +86,9 @@ void scheduler::_start_send_timer() {
 
 /**
  * @brief send all check results to engine
+ * If previous requests are not yet sent (engine is slow), we don't add a new
+ * one in the send queue, check results are accumulated in the current request
+ * until it's full
  *
  * @param err
  */
@@ -88,19 +96,122 @@ void scheduler::_send_timer_handler(const boost::system::error_code& err) {
   if (err) {
     return;
   }
-  if (_current_request->mutable_otel_request()->resource_metrics_size() > 0) {
-    _metric_sender(_current_request);
-    _init_export_request();
+  if (_is_congested && _is_congested()) {
+    SPDLOG_LOGGER_DEBUG(_logger,
+                        "previous requests not yet sent, {} services kept "
+                        "in the current request, {} requests waiting",
+                        _serv_to_scope_metrics.size(),
+                        _waiting_requests.size());
+  } else if (!_serv_to_scope_metrics.empty()) {
+    _send_request();
+  } else {
+    _send_waiting_requests();
   }
   _start_send_timer();
 }
 
+/**
+ * @brief when max_batch_delay is set, the first check result of a request
+ * starts this timer, so that no result waits longer than max_batch_delay
+ *
+ */
+void scheduler::_start_batch_timer() {
+  _batch_timer.expires_after(
+      std::chrono::milliseconds(_conf->config().max_batch_delay()));
+  _batch_timer.async_wait(
+      [me = shared_from_this(), generation = _request_generation](
+          const boost::system::error_code& err) {
+        me->_batch_timer_handler(err, generation);
+      });
+}
+
+/**
+ * @brief send current request if engine is ready, otherwise we wait for
+ * another delay
+ * cancel() doesn't remove a handler already queued, so the handler checks
+ * that the request that started the timer is still the current one
+ *
+ * @param err
+ * @param request_generation _request_generation when timer was started
+ */
+void scheduler::_batch_timer_handler(const boost::system::error_code& err,
+                                     uint64_t request_generation) {
+  if (err || !_alive || request_generation != _request_generation ||
+      _serv_to_scope_metrics.empty()) {
+    return;
+  }
+  if (_is_congested && _is_congested()) {
+    _start_batch_timer();
+  } else {
+    _send_request();
+  }
+}
+
+/**
+ * @brief current request is pushed in the waiting queue and a new one is
+ * started. Waiting requests are passed to the sender only if engine is not
+ * congested. If too many requests are waiting, the oldest is dropped.
+ *
+ */
+void scheduler::_send_request() {
+  _batch_timer.cancel();
+  _waiting_requests.push_back(_current_request);
+  _init_export_request();
+  if (_waiting_requests.size() > max_waiting_requests) {
+    unsigned dropped = _nb_check_results(*_waiting_requests.front());
+    _dropped_results += dropped;
+    SPDLOG_LOGGER_ERROR(_logger,
+                        "engine is too slow, {} check results dropped ({} "
+                        "since start)",
+                        dropped, _dropped_results);
+    _waiting_requests.pop_front();
+  }
+  _send_waiting_requests();
+}
+
+/**
+ * @brief pass all waiting requests to the sender if engine is not congested
+ * Each request carries the number of check results dropped since start.
+ *
+ */
+void scheduler::_send_waiting_requests() {
+  if (_waiting_requests.empty() || (_is_congested && _is_congested())) {
+    return;
+  }
+  for (const std::shared_ptr<MessageFromAgent>& to_send : _waiting_requests) {
+    to_send->set_dropped_results(_dropped_results);
+    _metric_sender(to_send);
+  }
+  _waiting_requests.clear();
+}
+
+/**
+ * @brief number of check results of a request, one ScopeMetrics per service
+ * whatever service_scopes value
+ *
+ * @param request
+ * @return unsigned
+ */
+unsigned scheduler::_nb_check_results(const MessageFromAgent& request) {
+  unsigned ret = 0;
+  for (const auto& resource : request.otel_request().resource_metrics()) {
+    ret += resource.scope_metrics_size();
+  }
+  return ret;
+}
+
+unsigned scheduler::_get_max_batch_size() const {
+  unsigned max_batch_size = _conf->config().max_batch_size();
+  return max_batch_size ? max_batch_size : default_max_batch_size;
+}
+
 /**
  * @brief create export request and fill some attributes
  *
  */
 void scheduler::_init_export_request() {
   _current_request = std::make_shared<MessageFromAgent>();
+  ++_request_generation;
   _serv_to_scope_metrics.clear();
 }
 
@@ -390,6 +501,7 @@ void scheduler::stop() {
                         static_cast<const void*>(this));
     _alive = false;
     _send_timer.cancel();
+    _batch_timer.cancel();
     _check_timer.cancel();
   }
 }
@@ -442,12 +554,13 @@ void scheduler::_store_result_in_metrics_and_exemplars(
     unsigned status,
     const std::list<com::centreon::common::perfdata>& perfdata,
     const std::list<std::string>& outputs) {
-  // we don't want to erase existing previous metrics, so we send right now
+  // we don't want to erase existing previous metrics, so this request is
+  // closed, it waits in _waiting_requests while engine is congested
   auto exist = _serv_to_scope_metrics.find(check->get_service());
   if (exist != _serv_to_scope_metrics.end()) {
-    _metric_sender(_current_request);
-    _init_export_request();
+    _send_request();
   }
+  bool first_result = _serv_to_scope_metrics.empty();
 
   auto& scope_metrics = _get_scope_metrics(check->get_service());
   uint64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
@@ -473,42 +586,56 @@ void scheduler::_store_result_in_metrics_and_exemplars(
   for (const com::centreon::common::perfdata& perf : perfdata) {
     _add_metric_to_scope(check_start, now, perf, scope_metrics);
   }
-  if (!_average_metric_length &&
-      _current_request->otel_request().resource_metrics_size() > 10) {
+  if (!_average_metric_length && _serv_to_scope_metrics.size() > 10) {
     _average_metric_length =
-        _current_request->ByteSizeLong() /
-        _current_request->otel_request().resource_metrics_size();
+        _current_request->ByteSizeLong() / _serv_to_scope_metrics.size();
   }
-  if (_current_request->otel_request().resource_metrics_size() *
-          _average_metric_length >
-      2 * 1024 * 1024) {
-    _metric_sender(_current_request);
-    _init_export_request();
+  if (_serv_to_scope_metrics.size() * _average_metric_length >
+      _get_max_batch_size()) {
+    _send_request();
+  } else if (first_result && _conf->config().max_batch_delay()) {
+    _start_batch_timer();
   }
 }
 
 /**
  * @brief metrics are grouped by host service
  * (one resource_metrics by host serv pair)
- * no resource_metrics for this service must exist before calling this function
+ * If engine asks for service_scopes, the request has only one resource_metrics
+ * with host.name attribute and service.name is an attribute of the scope
+ * no scope_metrics for this service must exist before calling this function
  * @param service
  * @return a new scheduler::scope_metric_request&
  */
 scheduler::scope_metric_request& scheduler::_get_scope_metrics(
     const std::string& service) {
-  ::opentelemetry::proto::metrics::v1::ResourceMetrics* new_res =
-      _current_request->mutable_otel_request()->add_resource_metrics();
+  auto* otel_request = _current_request->mutable_otel_request();
+  bool service_scopes = _conf->config().service_scopes();
+  int nb_resources = otel_request->resource_metrics_size();
+  ::opentelemetry::proto::metrics::v1::ResourceMetrics* res;
+  // a resource with only host.name, the last one in case of service_scopes
+  // enabled by a configuration received while this request was filled
+  if (service_scopes && nb_resources > 0 &&
+      otel_request->resource_metrics(nb_resources - 1)
+              .resource()
+              .attributes_size() == 1) {
+    res = otel_request->mutable_resource_metrics(nb_resources - 1);
+  } else {
+    res = otel_request->add_resource_metrics();
+    auto* host_attrib = res->mutable_resource()->add_attributes();
+    host_attrib->set_key("host.name");
+    host_attrib->mutable_value()->set_string_value(_supervised_host);
+  }
+
+  ::opentelemetry::proto::metrics::v1::ScopeMetrics* new_scope =
+      res->add_scope_metrics();
 
-  auto* host_attrib = new_res->mutable_resource()->add_attributes();
-  host_attrib->set_key("host.name");
-  host_attrib->mutable_value()->set_string_value(_supervised_host);
-  auto* serv_attrib = new_res->mutable_resource()->add_attributes();
+  auto* serv_attrib =
+      service_scopes ? new_scope->mutable_scope()->add_attributes()
+                     : res->mutable_resource()->add_attributes();
   serv_attrib->set_key("service.name");
   serv_attrib->mutable_value()->set_string_value(service);
 
-  ::opentelemetry::proto::metrics::v1::ScopeMetrics* new_scope =
-      new_res->add_scope_metrics();
-
   scope_metric_request to_insert;
   to_insert.scope_metric = new_scope;
 
@@ -711,19 +838,19 @@ std::shared_ptr<check> scheduler::default_check_builder(
         return std::make_shared<check_health>(
             io_context, logger, first_start_expected, check_interval, service,
             cmd_name, command_line, *args, conf, std::move(handler), stat);
-#ifdef _WIN32
       } else if (check_type == "uptime"sv) {
         return std::make_shared<check_uptime>(
             io_context, logger, first_start_expected, check_interval, service,
             cmd_name, command_line, *args, conf, std::move(handler), stat);
-      } else if (check_type == "storage"sv) {
-        return std::make_shared<check_drive_size>(
-            io_context, logger, first_start_expected, check_interval, service,
-            cmd_name, command_line, *args, conf, std::move(handler), stat);
       } else if (check_type == "memory"sv) {
         return std::make_shared<check_memory>(
             io_context, logger, first_start_expected, check_interval, service,
             cmd_name, command_line, *args, conf, std::move(handler), stat);
+#ifdef _WIN32
+      } else if (check_type == "storage"sv) {
+        return std::make_shared<check_drive_size>(
+            io_context, logger, first_start_expected, check_interval, service,
+            cmd_name, command_line, *args, conf, std::move(handler), stat);
       } else if (check_type == "service"sv) {
         return std::make_shared<check_service>(
             io_context, logger, first_start_expected, check_interval, service,
@@ -748,6 +875,23 @@ std::shared_ptr<check> scheduler::default_check_builder(
         return std::make_shared<check_process>(
             io_context, logger, first_start_expected, check_interval, service,
             cmd_name, command_line, *args, conf, std::move(handler), stat);
+#else
+      } else if (check_type == "load"sv) {
+        return std::make_shared<check_load>(
+            io_context, logger, first_start_expected, check_interval, service,
+            cmd_name, command_line, *args, conf, std::move(handler), stat);
+      } else if (check_type == "processes"sv) {
+        return std::make_shared<check_processes>(
+            io_context, logger, first_start_expected, check_interval, service,
+            cmd_name, command_line, *args, conf, std::move(handler), stat);
+      } else if (check_type == "disk_io"sv) {
+        return std::make_shared<check_disk_io>(
+            io_context, logger, first_start_expected, check_interval, service,
+            cmd_name, command_line, *args, conf, std::move(handler), stat);
+      } else if (check_type == "network"sv) {
+        return std::make_shared<check_network>(
+            io_context, logger, first_start_expected, check_interval, service,
+            cmd_name, command_line, *args, conf, std::move(handler), stat);
 #endif
       } else {
         throw exceptions::msg_fmt("command {}, unknown native check:{}",
@@ -111,14 +111,17 @@ void streaming_client::_start() {
 
   _sched = scheduler::load(
       _io_context, _logger, _supervised_host, scheduler::default_config(),
-      [sender = std::move(weak_this)](
-          const std::shared_ptr<MessageFromAgent>& request) {
+      [sender = weak_this](const std::shared_ptr<MessageFromAgent>& request) {
         auto parent = sender.lock();
         if (parent) {
           parent->_send(request);
         }
       },
       scheduler::default_check_builder);
+  _sched->set_congestion_probe([client = std::move(weak_this)]() {
+    auto parent = client.lock();
+    return parent && parent->_is_congested();
+  });
   _create_reactor();
 }
 
@@ -178,6 +181,17 @@ void streaming_client::_send(const std::shared_ptr<MessageFromAgent>& request) {
     _reactor->write(request);
 }
 
+/**
+ * @brief used by scheduler to know if previous requests are not yet sent to
+ * engine
+ *
+ * @return true if some requests are waiting in the write queue
+ */
+bool streaming_client::_is_congested() {
+  std::lock_guard l(_protect);
+  return _reactor && _reactor->get_write_queue_size() > 0;
+}
+
 /**
  * @brief
  *
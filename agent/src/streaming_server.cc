@@ -79,8 +79,7 @@ void server_reactor::_start() {
 
   _sched = scheduler::load(
       _io_context, _logger, _supervised_host, scheduler::default_config(),
-      [sender = std::move(weak_this)](
-          const std::shared_ptr<MessageFromAgent>& request) {
+      [sender = weak_this](const std::shared_ptr<MessageFromAgent>& request) {
         auto parent = sender.lock();
         if (parent) {
           parent->write(request);
@@ -88,6 +87,11 @@ void server_reactor::_start() {
       },
       scheduler::default_check_builder);
 
+  _sched->set_congestion_probe([reactor = std::move(weak_this)]() {
+    auto parent = reactor.lock();
+    return parent && parent->get_write_queue_size() > 0;
+  });
+
   // identifies to engine
   std::shared_ptr<MessageFromAgent> who_i_am =
       std::make_shared<MessageFromAgent>();
@@ -0,0 +1,157 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include <gtest/gtest.h>
+
+#include "com/centreon/common/rapidjson_helper.hh"
+
+#include "check_memory.hh"
+
+extern std::shared_ptr<asio::io_context> g_io_context;
+
+using namespace com::centreon::agent;
+using namespace com::centreon::agent::native_check_detail;
+
+using namespace std::string_literals;
+
+const char* meminfo_sample =
+    R"(MemTotal:       16318480 kB
+MemFree:         1227084 kB
+MemAvailable:    9803716 kB
+Buffers:          568664 kB
+Cached:          8127308 kB
+SwapCached:        11812 kB
+Active:          6413676 kB
+Inactive:        7235204 kB
+SwapTotal:       2097148 kB
+SwapFree:        1572860 kB
+Dirty:               624 kB
+CommitLimit:    10256388 kB
+Committed_AS:   12800024 kB
+VmallocTotal:   34359738367 kB
+HugePages_Total:       0
+Hugepagesize:       2048 kB
+)";
+
+constexpr const char* meminfo_test_file_path = "/tmp/proc_meminfo_test";
+
+static void write_meminfo_sample() {
+  ::remove(meminfo_test_file_path);
+  std::ofstream f(meminfo_test_file_path);
+  f.write(meminfo_sample, strlen(meminfo_sample));
+}
+
+class test_check : public check_memory {
+ public:
+  test_check(const rapidjson::Value& args)
+      : check_memory(
+            g_io_context,
+            spdlog::default_logger(),
+            {},
+            {},
+            "serv"s,
+            "cmd_name"s,
+            "cmd_line"s,
+            args,
+            nullptr,
+            []([[maybe_unused]] const std::shared_ptr<check>& caller,
+               [[maybe_unused]] int status,
+               [[maybe_unused]] const std::list<
+                   com::centreon::common::perfdata>& perfdata,
+               [[maybe_unused]] const std::list<std::string>& outputs) {},
+            std::make_shared<checks_statistics>()) {}
+
+  std::shared_ptr<native_check_detail::snapshot<
+      native_check_detail::e_memory_metric::nb_metric>>
+  measure() override {
+    return std::make_shared<native_check_detail::l_memory_info>(
+        meminfo(meminfo_test_file_path), _output_flags);
+  }
+};
+
+TEST(proc_meminfo_test, read_sample) {
+  write_meminfo_sample();
+  meminfo info(meminfo_test_file_path);
+  ASSERT_EQ(info.get_field(meminfo::e_field::mem_total), 16318480ull * 1024);
+  ASSERT_EQ(info.get_field(meminfo::e_field::mem_available),
+            9803716ull * 1024);
+  ASSERT_EQ(info.get_field(meminfo::e_field::swap_free), 1572860ull * 1024);
+  ASSERT_EQ(info.get_field(meminfo::e_field::commit_limit),
+            10256388ull * 1024);
+  ASSERT_EQ(info.get_field(meminfo::e_field::committed_as),
+            12800024ull * 1024);
+
+  l_memory_info mem(info);
+  ASSERT_EQ(mem.get_metric(e_memory_metric::phys_used),
+            (16318480ull - 9803716) * 1024);
+  ASSERT_EQ(mem.get_metric(e_memory_metric::swap_used),
+            (2097148ull - 1572860) * 1024);
+  // overcommit
+  ASSERT_EQ(mem.get_metric(e_memory_metric::virtual_free), 0);
+}
+
+TEST(native_check_memory_linux, output_ok) {
+  write_meminfo_sample();
+  using namespace com::centreon::common::literals;
+  rapidjson::Document check_args = R"({"swap": true})"_json;
+  test_check to_check(check_args);
+  std::string output;
+  std::list<com::centreon::common::perfdata> perfs;
+
+  e_status status = to_check.compute(*to_check.measure(), &output, &perfs);
+  ASSERT_EQ(status, e_status::ok);
+  ASSERT_EQ(output,
+            "OK: Ram total: 15.56 GB, used (-buffers/cache): 6.21 GB "
+            "(39.92%), free: 9.34 GB (60.08%) Swap total: 1.99 GB, used: 512 MB "
+            "(25.00%), free: 1.49 GB (75.00%)");
+  ASSERT_EQ(perfs.size(), 9);
+  for (const auto& perf : perfs) {
+    if (perf.name() == "memory.usage.bytes") {
+      ASSERT_EQ(perf.value(), (16318480ull - 9803716) * 1024);
+      ASSERT_EQ(perf.max(), 16318480ull * 1024);
+      ASSERT_EQ(perf.unit(), "B");
+    } else if (perf.name() == "swap.usage.percentage") {
+      ASSERT_NEAR(perf.value(), 25.0, 0.01);
+      ASSERT_EQ(perf.unit(), "%");
+    }
+  }
+}
+
+TEST(native_check_memory_linux, thresholds) {
+  write_meminfo_sample();
+  using namespace com::centreon::common::literals;
+  rapidjson::Document check_args =
+      R"({"warning-usage-prct": 30, "critical-usage-prct": "50",
+          "critical-swap-free-prct": 10, "warning-virtual-prct": 90})"_json;
+  test_check to_check(check_args);
+  std::string output;
+  std::list<com::centreon::common::perfdata> perfs;
+
+  e_status status = to_check.compute(*to_check.measure(), &output, &perfs);
+  // usage is 39.9% and committed memory is over commit limit
+  ASSERT_EQ(status, e_status::warning);
+  ASSERT_TRUE(output.find("WARNING: Ram total: ") == 0);
+  for (const auto& perf : perfs) {
+    if (perf.name() == "memory.usage.percentage") {
+      ASSERT_EQ(perf.warning(), 30);
+      ASSERT_EQ(perf.critical(), 50);
+    } else if (perf.name() == "virtual-memory.usage.percentage") {
+      ASSERT_EQ(perf.warning(), 90);
+    }
+  }
+}
@@ -0,0 +1,310 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include <gtest/gtest.h>
+#include <filesystem>
+
+#include "com/centreon/common/rapidjson_helper.hh"
+
+#include "check_disk_io.hh"
+#include "check_load.hh"
+#include "check_network.hh"
+#include "check_processes.hh"
+
+extern std::shared_ptr<asio::io_context> g_io_context;
+
+using namespace com::centreon::agent;
+using namespace com::centreon::agent::native_check_detail;
+
+using namespace std::string_literals;
+
+static void write_sample(const char* path, const char* content) {
+  ::remove(path);
+  std::ofstream f(path);
+  f.write(content, strlen(content));
+}
+
+static const auto _no_completion =
+    []([[maybe_unused]] const std::shared_ptr<check>& caller,
+       [[maybe_unused]] int status,
+       [[maybe_unused]] const std::list<com::centreon::common::perfdata>&
+           perfdata,
+       [[maybe_unused]] const std::list<std::string>& outputs) {};
+
+TEST(native_check_load, read_and_compute) {
+  constexpr const char* test_file_path = "/tmp/proc_loadavg_test";
+  write_sample(test_file_path, "0.52 2.48 4.40 2/1208 265113\n");
+
+  check_load::load_array loads = check_load::read_loadavg(test_file_path);
+  ASSERT_DOUBLE_EQ(loads[0], 0.52);
+  ASSERT_DOUBLE_EQ(loads[1], 2.48);
+  ASSERT_DOUBLE_EQ(loads[2], 4.40);
+
+  using namespace com::centreon::common::literals;
+  rapidjson::Document check_args =
+      R"({"per-cpu": true, "warning-load5": 0.5, "critical-load15": "1"})"_json;
+  check_load checker(g_io_context, spdlog::default_logger(), {}, {}, "serv"s,
+                     "cmd_name"s, "cmd_line"s, check_args, nullptr,
+                     _no_completion, std::make_shared<checks_statistics>());
+
+  std::string output;
+  std::list<com::centreon::common::perfdata> perfs;
+  e_status status = checker.compute(loads, 4, &output, &perfs);
+  ASSERT_EQ(status, e_status::critical);
+  ASSERT_EQ(output, "CRITICAL: Load average per cpu: 0.13, 0.62, 1.10");
+  ASSERT_EQ(perfs.size(), 3);
+  ASSERT_EQ(perfs.front().name(), "load1");
+  ASSERT_NEAR(perfs.front().value(), 0.13, 0.001);
+  ASSERT_EQ(std::next(perfs.begin())->warning(), 0.5f);
+  ASSERT_EQ(perfs.back().critical(), 1);
+
+  perfs.clear();
+  status = checker.compute({0.4, 0.4, 0.4}, 4, &output, &perfs);
+  ASSERT_EQ(status, e_status::ok);
+}
+
+TEST(native_check_processes, parse_stat) {
+  process_list::process proc;
+  ASSERT_TRUE(process_list::parse_stat(
+      "1234 (my (strange) proc) S 1 1234 1234 0 -1 4194560 1049 0 0 0 3 1 0 "
+      "0 20 0 7 0 3550 17637376 1427 18446744073709551615 1 1 0 0 0 0 0 "
+      "4096 0 0 0 0 17 2 0 0 0 0 0\n",
+      &proc));
+  ASSERT_EQ(proc.comm, "my (strange) proc");
+  ASSERT_EQ(proc.state, 'S');
+  ASSERT_EQ(proc.nb_threads, 7);
+
+  ASSERT_FALSE(process_list::parse_stat("1234 (truncated) S 1 1234", &proc));
+}
+
+TEST(native_check_processes, count) {
+  const char* proc_dir = "/tmp/proc_processes_test";
+  std::filesystem::remove_all(proc_dir);
+  const std::array<std::pair<const char*, const char*>, 4> processes = {
+      std::make_pair("1", "1 (systemd) S 0 1 1 0 -1 0 0 0 0 0 0 0 0 0 20 0 1 "
+                          "0 1 0 0 0"),
+      std::make_pair("20", "20 (bash) R 1 20 20 0 -1 0 0 0 0 0 0 0 0 0 20 0 1 "
+                           "0 1 0 0 0"),
+      std::make_pair("21", "21 (bash) Z 1 21 21 0 -1 0 0 0 0 0 0 0 0 0 20 0 "
+                           "1 0 1 0 0 0"),
+      std::make_pair("300", "300 (centagent) S 1 300 300 0 -1 0 0 0 0 0 0 0 "
+                            "0 0 20 0 12 0 1 0 0 0")};
+  for (const auto& [pid, stat] : processes) {
+    std::filesystem::create_directories(fmt::format("{}/{}", proc_dir, pid));
+    write_sample(fmt::format("{}/{}/stat", proc_dir, pid).c_str(), stat);
+  }
+  // not a process
+  std::filesystem::create_directories(fmt::format("{}/sys", proc_dir));
+
+  process_list all(proc_dir);
+  ASSERT_EQ(all.get_processes().size(), 4);
+
+  l_processes_count count(all, nullptr, nullptr);
+  ASSERT_EQ(count.get_metric(e_processes_metric::proc_total), 4);
+  ASSERT_EQ(count.get_metric(e_processes_metric::proc_running), 1);
+  ASSERT_EQ(count.get_metric(e_processes_metric::proc_sleeping), 2);
+  ASSERT_EQ(count.get_metric(e_processes_metric::proc_zombie), 1);
+  ASSERT_EQ(count.get_metric(e_processes_metric::proc_threads), 15);
+
+  RE2 filter("bash");
+  l_processes_count bash_count(all, &filter, nullptr);
+  std::string output;
+  bash_count.dump_to_output(&output);
+  ASSERT_EQ(output,
+            "Processes total: 2, running: 1, sleeping: 0, uninterruptible: 0, "
+            "zombie: 1, stopped: 0, threads: 2");
+
+  l_processes_count not_bash_count(all, nullptr, &filter);
+  ASSERT_EQ(not_bash_count.get_metric(e_processes_metric::proc_total), 2);
+}
+
+class test_disk_io : public check_disk_io {
+ public:
+  test_disk_io(const rapidjson::Value& args)
+      : check_disk_io(g_io_context,
+                      spdlog::default_logger(),
+                      {},
+                      {},
+                      "serv"s,
+                      "cmd_name"s,
+                      "cmd_line"s,
+                      args,
+                      nullptr,
+                      _no_completion,
+                      std::make_shared<checks_statistics>()) {}
+};
+
+TEST(native_check_disk_io, rates) {
+  constexpr const char* test_file_path = "/tmp/proc_diskstats_test";
+  write_sample(test_file_path,
+               R"(   7       0 loop0 100 0 200 10 0 0 0 0 0 10 10 0 0 0 0
+   8       0 sda 1000 10 20000 500 2000 20 40000 900 0 1000 1400 0 0 0 0
+   8       1 sda1 900 10 18000 450 1900 20 38000 850 0 950 1300 0 0 0 0
+)");
+  auto previous = read_diskstats(test_file_path, nullptr);
+  ASSERT_EQ(previous->devices.size(), 3);
+  ASSERT_EQ(previous->devices["sda"][e_disk_io_counter::write_sectors], 40000);
+
+  write_sample(test_file_path,
+               R"(   7       0 loop0 100 0 200 10 0 0 0 0 0 10 10 0 0 0 0
+   8       0 sda 1100 10 22048 500 2500 20 41000 900 0 1900 1400 0 0 0 0
+   8       1 sda1 1000 10 20048 450 2400 20 39000 850 0 1850 1300 0 0 0 0
+)");
+  auto current = std::const_pointer_cast<
+      counter_snapshot<e_disk_io_counter::nb_disk_io_counter>>(
+      read_diskstats(test_file_path, nullptr));
+  current->time = previous->time + std::chrono::seconds(2);
+  current->sub_devices.insert("sda1");
+
+  using namespace com::centreon::common::literals;
+  rapidjson::Document check_args = R"({"warning-utilization": 40})"_json;
+  test_disk_io checker(check_args);
+  std::string output;
+  std::list<com::centreon::common::perfdata> perfs;
+  e_status status = checker.compute(*previous, *current, &output, &perfs);
+  ASSERT_EQ(status, e_status::warning);
+  ASSERT_EQ(output,
+            "WARNING: sda read: 524288 B/s (50.0 iops), write: 256000 B/s "
+            "(250.0 iops), utilization: 45.00%");
+  // loop0 is excluded and sda1 is a partition
+  ASSERT_EQ(perfs.size(), 5);
+  ASSERT_EQ(perfs.front().name(), "sda#disk.read.bytespersecond");
+  ASSERT_EQ(perfs.back().name(), "sda#disk.utilization.percentage");
+  ASSERT_EQ(perfs.back().warning(), 40);
+  ASSERT_EQ(perfs.back().max(), 100);
+}
+
+TEST(native_check_disk_io, no_args) {
+  constexpr const char* test_file_path = "/tmp/proc_diskstats_test";
+  write_sample(test_file_path,
+               R"(   8       0 sda 1000 10 20000 500 2000 20 40000 900 0 1000 1400 0 0 0 0
+)");
+  auto previous = read_diskstats(test_file_path, nullptr);
+  write_sample(test_file_path,
+               R"(   8       0 sda 1100 10 22048 500 2500 20 41000 900 0 1900 1400 0 0 0 0
+)");
+  auto current = std::const_pointer_cast<
+      counter_snapshot<e_disk_io_counter::nb_disk_io_counter>>(
+      read_diskstats(test_file_path, nullptr));
+  current->time = previous->time + std::chrono::seconds(2);
+
+  // no threshold given, thresholds must be sized anyway
+  rapidjson::Document check_args;
+  test_disk_io checker(check_args);
+  std::string output;
+  std::list<com::centreon::common::perfdata> perfs;
+  e_status status = checker.compute(*previous, *current, &output, &perfs);
+  ASSERT_EQ(status, e_status::ok);
+  ASSERT_EQ(output, "OK: All disks are ok");
+  ASSERT_EQ(perfs.size(), 5);
+  ASSERT_TRUE(std::isnan(perfs.back().warning()));
+  ASSERT_TRUE(std::isnan(perfs.back().critical()));
+}
+
+class test_network : public check_network {
+ public:
+  test_network(const rapidjson::Value& args)
+      : check_network(g_io_context,
+                      spdlog::default_logger(),
+                      {},
+                      {},
+                      "serv"s,
+                      "cmd_name"s,
+                      "cmd_line"s,
+                      args,
+                      nullptr,
+                      _no_completion,
+                      std::make_shared<checks_statistics>()) {}
+};
+
+TEST(native_check_network, rates) {
+  constexpr const char* test_file_path = "/tmp/proc_net_dev_test";
+  constexpr const char* header =
+      R"(Inter-|   Receive                                                |  Transmit
+ face |bytes    packets errs drop fifo frame compressed multicast|bytes    packets errs drop fifo colls carrier compressed
+)";
+  write_sample(test_file_path,
+               absl::StrCat(header,
+                            "    lo: 5000 50 0 0 0 0 0 0 5000 50 0 0 0 0 0 0\n"
+                            "  eth0: 1000000 1000 0 0 0 0 0 0 2000000 1500 0 "
+                            "0 0 0 0 0\n")
+                   .c_str());
+  auto previous = read_net_dev(test_file_path);
+  ASSERT_EQ(previous->devices.size(), 2);
+
+  write_sample(test_file_path,
+               absl::StrCat(header,
+                            "    lo: 9000 90 0 0 0 0 0 0 9000 90 0 0 0 0 0 0\n"
+                            "  eth0: 1125000 1100 2 0 0 0 0 0 2000000 1500 0 "
+                            "0 0 0 0 0\n")
+                   .c_str());
+  auto current = std::const_pointer_cast<
+      counter_snapshot<e_network_counter::nb_network_counter>>(
+      read_net_dev(test_file_path));
+  current->time = previous->time + std::chrono::seconds(10);
+
+  using namespace com::centreon::common::literals;
+  rapidjson::Document check_args =
+      R"({"critical-in-errors": 0.1, "warning-in-bits": 1000000})"_json;
+  test_network checker(check_args);
+  std::string output;
+  std::list<com::centreon::common::perfdata> perfs;
+  e_status status = checker.compute(*previous, *current, &output, &perfs);
+  ASSERT_EQ(status, e_status::critical);
+  ASSERT_EQ(output,
+            "CRITICAL: eth0 in: 100000 b/s (10.0 packets/s, 0.2 errors/s, 0.0 "
+            "drops/s), out: 0 b/s (0.0 packets/s, 0.0 errors/s, 0.0 drops/s)");
+  // lo is excluded by default
+  ASSERT_EQ(perfs.size(), 8);
+  ASSERT_EQ(perfs.front().name(), "eth0#network.in.bitspersecond");
+  ASSERT_EQ(perfs.front().value(), 100000);
+  ASSERT_EQ(perfs.front().unit(), "b/s");
+}
+
+TEST(native_check_network, no_args) {
+  constexpr const char* test_file_path = "/tmp/proc_net_dev_test";
+  constexpr const char* header =
+      R"(Inter-|   Receive                                                |  Transmit
+ face |bytes    packets errs drop fifo frame compressed multicast|bytes    packets errs drop fifo colls carrier compressed
+)";
+  write_sample(test_file_path,
+               absl::StrCat(header,
+                            "  eth0: 1000000 1000 0 0 0 0 0 0 2000000 1500 0 "
+                            "0 0 0 0 0\n")
+                   .c_str());
+  auto previous = read_net_dev(test_file_path);
+  write_sample(test_file_path,
+               absl::StrCat(header,
+                            "  eth0: 1125000 1100 2 0 0 0 0 0 2000000 1500 0 "
+                            "0 0 0 0 0\n")
+                   .c_str());
+  auto current = std::const_pointer_cast<
+      counter_snapshot<e_network_counter::nb_network_counter>>(
+      read_net_dev(test_file_path));
+  current->time = previous->time + std::chrono::seconds(10);
+
+  // no threshold given, thresholds must be sized anyway
+  rapidjson::Document check_args;
+  test_network checker(check_args);
+  std::string output;
+  std::list<com::centreon::common::perfdata> perfs;
+  e_status status = checker.compute(*previous, *current, &output, &perfs);
+  ASSERT_EQ(status, e_status::ok);
+  ASSERT_EQ(output, "OK: All interfaces are ok");
+  ASSERT_EQ(perfs.size(), 8);
+}
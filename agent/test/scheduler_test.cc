@@ -538,6 +538,190 @@ TEST_F(scheduler_test, correct_output_examplar) {
   scheduler_closer closer(sched);
 }
 
+static std::shared_ptr<check> tempo_check_builder(
+    const std::shared_ptr<asio::io_context>& io_context,
+    const std::shared_ptr<spdlog::logger>& logger,
+    time_point start_expected,
+    duration check_interval,
+    const std::string& service,
+    const std::string& cmd_name,
+    const std::string& cmd_line,
+    const engine_to_agent_request_ptr& engine_to_agent_request,
+    check::completion_handler&& handler,
+    const checks_statistics::pointer& stat,
+    const std::shared_ptr<com::centreon::common::crypto::aes256>&) {
+  return std::make_shared<tempo_check>(
+      io_context, logger, start_expected, check_interval, service, cmd_name,
+      cmd_line, engine_to_agent_request, 0, std::chrono::milliseconds(10),
+      std::move(handler), stat);
+}
+
+/**
+ * @brief export_period is long but max_batch_delay forces scheduler to send
+ * result 500ms after check completion
+ */
+TEST_F(scheduler_test, max_batch_delay) {
+  std::mutex m;
+  std::condition_variable export_cond;
+  std::shared_ptr<MessageFromAgent> exported_request;
+  time_point export_time;
+
+  auto conf = create_conf(1, 60, 60, 1, 1);
+  conf->mutable_config()->set_max_batch_delay(500);
+
+  time_point start = std::chrono::system_clock::now();
+  std::shared_ptr<scheduler> sched = scheduler::load(
+      g_io_context, spdlog::default_logger(), "my_host", conf,
+      [&](const std::shared_ptr<MessageFromAgent>& req) {
+        {
+          std::lock_guard l(m);
+          if (!exported_request) {
+            exported_request = req;
+            export_time = std::chrono::system_clock::now();
+          }
+        }
+        export_cond.notify_all();
+      },
+      tempo_check_builder);
+
+  {
+    std::unique_lock l(m);
+    ASSERT_TRUE(export_cond.wait_for(l, std::chrono::seconds(5), [&] {
+      return exported_request != nullptr;
+    }));
+  }
+
+  // first check starts one second after configuration
+  ASSERT_GE(export_time - start, std::chrono::milliseconds(1400));
+  ASSERT_LE(export_time - start, std::chrono::milliseconds(3000));
+  ASSERT_EQ(exported_request->otel_request().resource_metrics_size(), 1);
+
+  scheduler_closer closer(sched);
+}
+
+/**
+ * @brief while previous requests are not sent, scheduler accumulates results
+ * in the current request
+ */
+TEST_F(scheduler_test, congestion) {
+  std::mutex m;
+  std::vector<std::shared_ptr<MessageFromAgent>> exported;
+  std::atomic_bool congested = true;
+
+  std::shared_ptr<scheduler> sched = scheduler::load(
+      g_io_context, spdlog::default_logger(), "my_host",
+      create_conf(2, 10, 1, 10, 1),
+      [&](const std::shared_ptr<MessageFromAgent>& req) {
+        std::lock_guard l(m);
+        exported.push_back(req);
+      },
+      tempo_check_builder);
+  sched->set_congestion_probe([&congested]() { return congested.load(); });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(4000));
+  {
+    std::lock_guard l(m);
+    ASSERT_TRUE(exported.empty());
+  }
+
+  congested = false;
+  std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+  {
+    std::lock_guard l(m);
+    ASSERT_EQ(exported.size(), 1);
+    ASSERT_EQ(exported[0]->otel_request().resource_metrics_size(), 2);
+  }
+
+  scheduler_closer closer(sched);
+}
+
+/**
+ * @brief with service_scopes, host.name is sent once per request and each
+ * service has its scope
+ */
+TEST_F(scheduler_test, service_scopes) {
+  std::mutex m;
+  std::vector<std::shared_ptr<MessageFromAgent>> exported;
+  std::atomic_bool congested = true;
+
+  auto conf = create_conf(2, 10, 1, 10, 1);
+  conf->mutable_config()->set_service_scopes(true);
+
+  std::shared_ptr<scheduler> sched = scheduler::load(
+      g_io_context, spdlog::default_logger(), "my_host", conf,
+      [&](const std::shared_ptr<MessageFromAgent>& req) {
+        std::lock_guard l(m);
+        exported.push_back(req);
+      },
+      tempo_check_builder);
+  sched->set_congestion_probe([&congested]() { return congested.load(); });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(4000));
+  congested = false;
+  std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+  {
+    std::lock_guard l(m);
+    ASSERT_EQ(exported.size(), 1);
+    const auto& otel_request = exported[0]->otel_request();
+    ASSERT_EQ(otel_request.resource_metrics_size(), 1);
+    const auto& res = otel_request.resource_metrics(0);
+    ASSERT_EQ(res.resource().attributes_size(), 1);
+    ASSERT_EQ(res.resource().attributes(0).key(), "host.name");
+    ASSERT_EQ(res.resource().attributes(0).value().string_value(), "my_host");
+    ASSERT_EQ(res.scope_metrics_size(), 2);
+    std::set<std::string> services;
+    for (const auto& scope : res.scope_metrics()) {
+      ASSERT_EQ(scope.scope().attributes_size(), 1);
+      ASSERT_EQ(scope.scope().attributes(0).key(), "service.name");
+      services.insert(scope.scope().attributes(0).value().string_value());
+    }
+    ASSERT_EQ(services, std::set<std::string>({"serv1", "serv2"}));
+  }
+
+  scheduler_closer closer(sched);
+}
+
+/**
+ * @brief full requests are not sent while engine is congested, the oldest
+ * ones are dropped beyond max_waiting_requests and engine is told how many
+ * check results were dropped
+ */
+TEST_F(scheduler_test, congestion_full_requests) {
+  std::mutex m;
+  std::vector<std::shared_ptr<MessageFromAgent>> exported;
+  std::atomic_bool congested = true;
+
+  auto conf = create_conf(100, 1, 10, 100, 1);
+  conf->mutable_config()->set_max_batch_size(1);
+
+  std::shared_ptr<scheduler> sched = scheduler::load(
+      g_io_context, spdlog::default_logger(), "my_host", conf,
+      [&](const std::shared_ptr<MessageFromAgent>& req) {
+        std::lock_guard l(m);
+        exported.push_back(req);
+      },
+      tempo_check_builder);
+  sched->set_congestion_probe([&congested]() { return congested.load(); });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(4000));
+  {
+    std::lock_guard l(m);
+    ASSERT_TRUE(exported.empty());
+  }
+
+  congested = false;
+  std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+  {
+    std::lock_guard l(m);
+    ASSERT_GE(exported.size(), scheduler::max_waiting_requests);
+    ASSERT_GT(exported[0]->dropped_results(), 0);
+    ASSERT_EQ(exported[0]->dropped_results(),
+              exported[scheduler::max_waiting_requests - 1]->dropped_results());
+  }
+
+  scheduler_closer closer(sched);
+}
+
 /**
  * @brief: this fake check store executed checks and max active checks at a time
  */
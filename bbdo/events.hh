@@ -95,6 +95,7 @@ enum data_element {
   de_pb_ack = 8,
   de_pb_stop = 9,
   de_pb_engine_configuration = 10,
+  de_pb_trace = 11,
 };
 }
 namespace neb {
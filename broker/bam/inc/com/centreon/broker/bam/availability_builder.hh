@@ -45,6 +45,9 @@ namespace com::centreon::broker::bam {
  */
 class availability_builder {
  public:
+  /* The [start, end) ranges where a timeperiod is valid. */
+  using valid_ranges = std::vector<std::pair<time_t, time_t>>;
+
   availability_builder(time_t ending_point, time_t starting_point = 0);
   ~availability_builder();
   availability_builder(const availability_builder&) = delete;
@@ -56,6 +59,16 @@ class availability_builder {
                  bool was_in_downtime,
                  time::timeperiod::ptr const& tp,
                  const std::shared_ptr<spdlog::logger>& logger);
+  void add_event(short status,
+                 time_t start,
+                 time_t end,
+                 bool was_in_downtime,
+                 const valid_ranges& ranges,
+                 const std::shared_ptr<spdlog::logger>& logger);
+
+  static valid_ranges compute_valid_ranges(const time::timeperiod& tp,
+                                           time_t start,
+                                           time_t end);
 
   int get_available() const;
   int get_unavailable() const;
@@ -71,6 +84,12 @@ class availability_builder {
   bool get_timeperiod_is_default() const;
 
  private:
+  bool _clamp(time_t& start, time_t& end, bool& opened_today) const;
+  void _add_duration(short status,
+                     bool was_in_downtime,
+                     bool opened_today,
+                     uint32_t sla_duration);
+
   time_t _start;
   time_t _end;
   int _available;
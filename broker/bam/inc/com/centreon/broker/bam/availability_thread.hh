@@ -37,9 +37,59 @@ namespace bam {
  * "com/centreon/broker/bam/availability_thread.hh"
  *  @brief Availability thread
  *
+ *  Each night, or when a rebuild is asked, this thread computes the daily
+ *  availabilities of the BAs from their events. The events of the whole
+ *  period are read at once, then the BAs are computed in parallel by
+ *  dedicated threads. The daily rows are the rollups: a rebuild only
+ *  recomputes the days covered by the events whose durations changed, and
+ *  only the rows that changed are written.
  */
 class availability_thread final {
  public:
+  /* An event of a BA seen through one of its timeperiods. end is 0 while the
+   * event is still opened. */
+  struct ba_event {
+    short status;
+    time_t start;
+    time_t end;
+    bool in_downtime;
+    time::timeperiod::ptr tp;
+    bool tp_is_default;
+  };
+
+  /* A row of the mod_bam_reporting_ba_availabilities table. */
+  struct availability {
+    uint32_t ba_id;
+    time_t time_id;
+    uint32_t timeperiod_id;
+    bool timeperiod_is_default;
+    int available;
+    int unavailable;
+    int degraded;
+    int unknown;
+    int downtime;
+    int alert_unavailable_opened;
+    int alert_degraded_opened;
+    int alert_unknown_opened;
+    int nb_downtime;
+
+    bool operator==(const availability& other) const;
+    bool operator!=(const availability& other) const {
+      return !(*this == other);
+    }
+  };
+
+  /* The events of each BA, indexed by BA id. */
+  using ba_events = absl::flat_hash_map<uint32_t, std::vector<ba_event>>;
+  /* For each BA, the [start, end] intervals of its events whose durations
+   * changed. end is 0 for an interval lasting until now. */
+  using affected_periods =
+      absl::flat_hash_map<uint32_t, std::vector<std::pair<time_t, time_t>>>;
+  /* Availabilities indexed by (ba_id, time_id, timeperiod_id). */
+  using availability_map =
+      absl::flat_hash_map<std::tuple<uint32_t, time_t, uint32_t>,
+                          availability>;
+
   availability_thread(database_config const& db_cfg,
                       timeperiod_map& shared_map,
                       const std::shared_ptr<spdlog::logger>& logger);
@@ -54,20 +104,48 @@ class availability_thread final {
   void lock();
   void unlock();
 
-  void rebuild_availabilities(std::string const& bas_to_rebuild);
+  void rebuild_availabilities(const affected_periods& affected);
   void wait();
 
+  static std::vector<availability> compute_availabilities(
+      const ba_events& events,
+      const std::vector<time_t>& days,
+      const std::shared_ptr<spdlog::logger>& logger,
+      const affected_periods* affected = nullptr);
+
  private:
-  void _delete_all_availabilities();
+  /* The valid ranges of each timeperiod, indexed by (timeperiod_id, day
+   * index). */
+  using day_ranges =
+      absl::flat_hash_map<std::pair<uint32_t, size_t>,
+                          availability_builder::valid_ranges>;
+
+  static day_ranges _compute_day_ranges(const ba_events& events,
+                                        const std::vector<time_t>& days);
+  static void _compute_ba_availabilities(
+      uint32_t ba_id,
+      const std::vector<ba_event>& events,
+      const std::vector<time_t>& days,
+      const day_ranges& ranges,
+      const std::vector<std::pair<time_t, time_t>>* affected,
+      std::vector<availability>& result,
+      const std::shared_ptr<spdlog::logger>& logger);
+  static bool _day_is_affected(
+      const std::vector<std::pair<time_t, time_t>>& affected,
+      time_t day_start,
+      time_t day_end);
   void _build_availabilities(time_t midnight);
-  void _build_daily_availabilities(int thread_id,
-                                   time_t day_start,
-                                   time_t day_end);
-  void _write_availability(int thread_id,
-                           availability_builder const& builder,
-                           uint32_t ba_id,
-                           time_t day_start,
-                           uint32_t timeperiod_id);
+  void _load_events(int thread_id,
+                    time_t first_day,
+                    time_t last_day,
+                    ba_events& events);
+  void _load_availabilities(int thread_id,
+                            time_t first_day,
+                            time_t last_day,
+                            availability_map& existing);
+  void _write_availabilities(int thread_id,
+                             const std::vector<availability>& computed,
+                             availability_map& existing);
 
   time_t _compute_next_midnight();
   void _open_database();
@@ -86,6 +164,7 @@ class availability_thread final {
   bool _should_exit;
   bool _should_rebuild_all;
   std::string _bas_to_rebuild;
+  affected_periods _affected;
   std::condition_variable _wait;
 
   /* Logger */
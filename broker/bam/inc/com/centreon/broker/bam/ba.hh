@@ -53,6 +53,10 @@ class ba : public computable, public service_listener {
                        com::centreon::broker::bam::state service_hard_state);
   void _compute_inherited_downtime(io::stream* visitor);
   void _commit_initial_events(io::stream* visitor);
+  bool _apply_child_changes(kpi* kpi_child, bool compute);
+  void _commit_changes(bool changed,
+                       bool previous_in_downtime,
+                       io::stream* visitor);
 
  protected:
   int32_t _acknowledgement_count{0};
@@ -102,6 +106,8 @@ class ba : public computable, public service_listener {
                               bool in_downtime) = 0;
   virtual std::shared_ptr<pb_ba_status> _generate_ba_status(
       bool state_changed) const = 0;
+  /* True if _apply_changes() computes the BA from all its impacts. */
+  virtual bool _full_recompute() const { return false; }
   std::shared_ptr<io::data> _generate_virtual_service_status() const;
 
  public:
@@ -147,6 +153,8 @@ class ba : public computable, public service_listener {
   void set_level_critical(double level);
   void set_level_warning(double level);
   void update_from(computable* child, io::stream* visitor) override;
+  void update_from_children(const std::vector<computable*>& children,
+                            io::stream* visitor) override;
   std::string object_info() const override;
   void dump(const std::string& filename) const;
   void dump(std::ofstream& output) const override;
@@ -52,6 +52,7 @@ class ba_best : public ba {
                       bool in_downtime) override;
   std::shared_ptr<pb_ba_status> _generate_ba_status(
       bool state_changed) const override;
+  bool _full_recompute() const override { return true; }
 
  public:
   ba_best(uint32_t id,
@@ -0,0 +1,116 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCB_BAM_BOOL_PROGRAM_HH
+#define CCB_BAM_BOOL_PROGRAM_HH
+
+#include "com/centreon/broker/bam/bool_value.hh"
+
+namespace com::centreon::broker::bam {
+/**
+ *  @class bool_program bool_program.hh
+ * "com/centreon/broker/bam/bool_program.hh"
+ *  @brief Compiled boolean expression.
+ *
+ *  The operators of the expression are stored in a flat array, in postfix
+ *  order, each one with the cached state of its operands. Only the operands
+ *  (services, calls) are computables, the program being their only parent.
+ *
+ *  When an operand changes, only the operators on the path from it to the
+ *  root are computed, and the walk stops as soon as an operator does not see
+ *  any change.
+ */
+class bool_program : public bool_value {
+ public:
+  enum opcode : uint8_t {
+    op_operand,
+    op_constant,
+    op_not,
+    op_and,
+    op_or,
+    op_xor,
+    op_equal,
+    op_not_equal,
+    op_more_than,
+    op_more_equal,
+    op_less_than,
+    op_less_equal,
+    op_addition,
+    op_substraction,
+    op_multiplication,
+    op_division,
+    op_modulo,
+  };
+
+  static constexpr uint32_t npos = static_cast<uint32_t>(-1);
+
+ private:
+  /* For a binary operator, left and right are the slots of the operands and
+   * left_hard/right_hard their last known values. For op_operand, left is the
+   * index in _operands, for op_constant, left_hard is the value. */
+  struct instruction {
+    opcode op;
+    bool known = false;
+    bool downtime = false;
+    bool boolean = false;
+    uint32_t left = npos;
+    uint32_t right = npos;
+    uint32_t parent = npos;
+    double left_hard = 0;
+    double right_hard = 0;
+  };
+
+  std::vector<instruction> _code;
+  std::vector<bool_value::ptr> _operands;
+  /* The slots where each operand is used. */
+  absl::flat_hash_map<const computable*, std::vector<uint32_t>> _slots;
+  uint32_t _root = npos;
+
+  uint32_t _push(instruction&& ins);
+  void _update(uint32_t slot);
+  bool _propagate(uint32_t slot);
+  double _value_hard(uint32_t slot) const;
+  bool _boolean_value(uint32_t slot) const;
+  bool _state_known(uint32_t slot) const;
+  bool _in_downtime(uint32_t slot) const;
+
+ public:
+  typedef std::shared_ptr<bool_program> ptr;
+
+  bool_program(const std::shared_ptr<spdlog::logger>& logger)
+      : bool_value(logger) {}
+  ~bool_program() noexcept override = default;
+  bool_program(const bool_program&) = delete;
+  bool_program& operator=(const bool_program&) = delete;
+  uint32_t push_operand(const bool_value::ptr& operand);
+  uint32_t push_constant(double value);
+  uint32_t push_not(uint32_t operand);
+  uint32_t push_binary(opcode op, uint32_t left, uint32_t right);
+  void set_root(uint32_t slot);
+  size_t size() const { return _code.size(); }
+  double value_hard() const override;
+  bool boolean_value() const override;
+  bool state_known() const override;
+  bool in_downtime() const override;
+  void update_from(computable* child, io::stream* visitor) override;
+  std::string object_info() const override;
+  void dump(std::ofstream& output) const override;
+};
+}  // namespace com::centreon::broker::bam
+
+#endif  // !CCB_BAM_BOOL_PROGRAM_HH
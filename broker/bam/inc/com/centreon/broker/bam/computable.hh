@@ -30,6 +30,16 @@ namespace com::centreon::broker::bam {
  *  provides an effective way to compute whole part of the BA/KPI tree.
  */
 class computable {
+ public:
+  class batch;
+
+ private:
+  /* Incremented each time a parent link is added or removed, so that cached
+   * ranks know they have to be computed again. */
+  static std::atomic<uint64_t> _topology_version;
+  mutable uint64_t _rank_version{0};
+  mutable uint32_t _rank{0};
+
  protected:
   std::list<std::weak_ptr<computable>> _parents;
   std::shared_ptr<spdlog::logger> _logger;
@@ -51,6 +61,9 @@ class computable {
    *  @param[in] visitor This is used to manage events
    */
   virtual void update_from(computable* child, io::stream* visitor) = 0;
+  virtual void update_from_children(const std::vector<computable*>& children,
+                                    io::stream* visitor);
+  uint32_t rank() const;
   void remove_parent(const std::shared_ptr<computable>& parent);
   /**
    * @brief This method is used by the dump() method. It gives a summary of this
@@ -68,6 +81,51 @@ class computable {
   virtual void dump(std::ofstream& output) const = 0;
   void dump_parents(std::ofstream& output) const;
 };
+
+/**
+ *  @class computable::batch computable.hh
+ *  "com/centreon/broker/bam/computable.hh"
+ *  @brief Dirty set of computables waiting for an update.
+ *
+ *  While a batch is open, notify_parents_of_change() does not call
+ *  update_from() on the parents, it just marks them dirty with the changed
+ *  child. On commit(), dirty computables are updated by decreasing rank, so
+ *  each one is computed exactly once, after all its dirty children, and
+ *  events are written in dependency order.
+ *
+ *  When no batch is open, notify_parents_of_change() opens one for the
+ *  duration of the call, so the propagation stays synchronous.
+ *
+ *  A batch can be kept across several calls: suspend() stops collecting
+ *  changes, resume() collects them again in the current thread.
+ */
+class computable::batch {
+  struct entry {
+    std::shared_ptr<computable> node;
+    std::vector<computable*> children;
+  };
+  /* Dirty computables sorted by decreasing rank. The pointer is only here to
+   * make the key unique. */
+  using key = std::pair<uint32_t, computable*>;
+  std::map<key, entry, std::greater<key>> _dirty;
+
+  io::stream* const _visitor;
+  batch* const _previous;
+  static thread_local batch* _current;
+
+  friend class computable;
+  void _mark_parents_of(computable* child);
+
+ public:
+  batch(io::stream* visitor);
+  batch(const batch&) = delete;
+  batch& operator=(const batch&) = delete;
+  ~batch() noexcept;
+  size_t size() const { return _dirty.size(); }
+  void suspend() noexcept;
+  void resume() noexcept;
+  void commit();
+};
 }  // namespace com::centreon::broker::bam
 
 #endif  // !CCB_BAM_COMPUTABLE_HH
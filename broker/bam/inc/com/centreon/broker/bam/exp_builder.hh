@@ -20,6 +20,7 @@
 #define CCB_BAM_EXP_BUILDER_HH
 
 #include "com/centreon/broker/bam/bool_call.hh"
+#include "com/centreon/broker/bam/bool_program.hh"
 #include "com/centreon/broker/bam/bool_service.hh"
 #include "com/centreon/broker/bam/exp_parser.hh"
 #include "com/centreon/broker/bam/hst_svc_mapping.hh"
@@ -27,16 +28,18 @@
 namespace com::centreon::broker::bam {
 /**
  *  @class exp_builder exp_builder.hh "com/centreon/broker/bam/exp_builder.hh"
- *  @brief Convert expression to syntax tree.
+ *  @brief Convert expression to a boolean program.
  *
- *  Build a syntax tree from the postfix notation of an expression and
+ *  Compile the postfix notation of an expression into a bool_program and
  *  return hooking elements.
  */
 class exp_builder {
  public:
   using list_call = std::list<bool_call::ptr>;
   using list_service = std::list<bool_service::ptr>;
-  using any_operand = std::pair<bool_value::ptr, std::string>;
+  /* The slot of the operand in the program or bool_program::npos if it is
+   * still a string. */
+  using any_operand = std::pair<uint32_t, std::string>;
 
  private:
   std::shared_ptr<spdlog::logger> _logger;
@@ -44,11 +47,12 @@ class exp_builder {
   list_call _calls;
   list_service _services;
   std::stack<any_operand> _operands;
+  bool_program::ptr _program;
   bool_value::ptr _tree;
 
   void _check_arity(std::string const& func, int expected, int given);
   bool _is_static_function(std::string const& str) const;
-  bool_value::ptr _pop_operand();
+  uint32_t _pop_operand();
   std::string _pop_string();
 
  public:
@@ -21,7 +21,9 @@
 
 #include <absl/hash/hash.h>
 
+#include "com/centreon/broker/bam/computable.hh"
 #include "com/centreon/broker/bam/configuration/applier/state.hh"
+#include "com/centreon/broker/bam/event_cache_visitor.hh"
 #include "com/centreon/broker/io/stream.hh"
 #include "com/centreon/broker/sql/database_config.hh"
 #include "com/centreon/broker/sql/mysql.hh"
@@ -85,6 +87,13 @@ class monitoring_stream : public io::stream {
 
   uint32_t _pending_events;
   unsigned _pending_request;
+
+  /* The changes of the events received since the last flush, each impacted
+   * BA is computed once when the batch is committed. */
+  static constexpr uint32_t max_batched_events = 1000;
+  std::unique_ptr<event_cache_visitor> _ev_cache;
+  std::unique_ptr<computable::batch> _changes;
+  uint32_t _batched_events;
   database_config _storage_db_cfg;
   std::shared_ptr<persistent_cache> _cache;
 
@@ -111,6 +120,8 @@ class monitoring_stream : public io::stream {
   void _read_cache();
   void _write_cache();
   void _execute();
+  void _update_in_batch(const std::function<void(io::stream*)>& update);
+  void _commit_batch();
 
  public:
   monitoring_stream(std::string const& ext_cmd_file,
@@ -138,7 +138,10 @@ class reporting_stream : public io::stream {
       std::shared_ptr<io::data> const& e);
   void _process_rebuild(std::shared_ptr<io::data> const& e);
   void _update_status(std::string const& status);
-  void _compute_event_durations(const BaEvent& ev, io::stream* visitor);
+  void _compute_event_durations(
+      const BaEvent& ev,
+      io::stream* visitor,
+      std::vector<BaDurationEvent>* computed = nullptr);
 };
 }  // namespace bam
 }  // namespace com::centreon::broker
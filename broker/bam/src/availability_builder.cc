@@ -70,27 +70,132 @@ void availability_builder::add_event(
       "availability_builder::add_event (status: {}, start: {}, end: {}, was in "
       "downtime: {}",
       status, start, end, was_in_downtime);
+  bool opened_today;
+  if (!_clamp(start, end, opened_today))
+    return;
+
+  // Compute the sla_duration on the period.
+  uint32_t sla_duration = tp->duration_intersect(start, end);
+  if (sla_duration == (uint32_t)-1)
+    return;
+
+  _add_duration(status, was_in_downtime, opened_today, sla_duration);
+}
+
+/**
+ *  Add an event to the builder, the timeperiod being given by its valid
+ *  ranges on the computed day. Unlike the timeperiod itself, the ranges don't
+ *  need the timezone lock, so builders of several threads can use them at the
+ *  same time.
+ *
+ *  @param[in] status           The status of the event.
+ *  @param[in] start            The start time of the event.
+ *  @param[in] end              The end of the event.
+ *  @param[in] was_in_downtime  Was the event in downtime?
+ *  @param[in] ranges           The valid ranges of the timeperiod, given by
+ *                              compute_valid_ranges() on the computed day.
+ *  @param[in] logger           The logger to use.
+ */
+void availability_builder::add_event(
+    short status,
+    time_t start,
+    time_t end,
+    bool was_in_downtime,
+    const valid_ranges& ranges,
+    const std::shared_ptr<spdlog::logger>& logger) {
+  logger->trace(
+      "availability_builder::add_event (status: {}, start: {}, end: {}, was in "
+      "downtime: {}",
+      status, start, end, was_in_downtime);
+  bool opened_today;
+  if (!_clamp(start, end, opened_today))
+    return;
+
+  // Compute the sla_duration on the period.
+  uint32_t sla_duration = 0;
+  for (auto& r : ranges) {
+    time_t from = std::max(r.first, start);
+    time_t to = std::min(r.second, end);
+    if (from < to)
+      sla_duration += to - from;
+  }
+
+  _add_duration(status, was_in_downtime, opened_today, sla_duration);
+}
+
+/**
+ *  Compute the ranges where a timeperiod is valid between two times. The sum
+ *  of their intersections with an interval of [start, end] is the same as
+ *  timeperiod::duration_intersect() on this interval.
+ *
+ *  @param[in] tp     The timeperiod.
+ *  @param[in] start  The beginning of the period, usually a day.
+ *  @param[in] end    The end of the period.
+ *
+ *  @return  The valid ranges, sorted and clamped to [start, end].
+ */
+availability_builder::valid_ranges availability_builder::compute_valid_ranges(
+    const time::timeperiod& tp,
+    time_t start,
+    time_t end) {
+  valid_ranges retval;
+  time_t current = start;
+  while (current < end) {
+    time_t valid = tp.get_next_valid(current);
+    if (valid == (time_t)-1 || valid >= end)
+      break;
+    time_t invalid = tp.get_next_invalid(valid);
+    if (invalid == (time_t)-1 || invalid > end)
+      invalid = end;
+    if (invalid <= valid)
+      break;
+    retval.emplace_back(valid, invalid);
+    current = invalid;
+  }
+  return retval;
+}
+
+/**
+ *  Restrict an event to the computed day.
+ *
+ *  @param[in,out] start         The start time of the event.
+ *  @param[in,out] end           The end of the event, 0 if not closed.
+ *  @param[out] opened_today     Set if the event started this day.
+ *
+ *  @return  False if the event ended before the day.
+ */
+bool availability_builder::_clamp(time_t& start,
+                                  time_t& end,
+                                  bool& opened_today) const {
   // Check that the event was closed.
   if (end == 0)
     end = _end;
   // Check that the end of the event is not before the starting point of the
   // computing.
   if (end < _start)
-    return;
+    return false;
   // Check if event was opened "today".
-  bool opened_today(start >= _start && start < _end);
+  opened_today = start >= _start && start < _end;
   // Check that the event times are within the computed day.
   if (start < _start)
     start = _start;
   if (_end < end)
     end = _end;
+  return true;
+}
 
-  // Compute the sla_duration on the period.
-  uint32_t sla_duration = tp->duration_intersect(start, end);
-  if (sla_duration == (uint32_t)-1)
-    return;
-
-  // Update the data.
+/**
+ *  Update the counters with the sla duration of an event.
+ *
+ *  @param[in] status           The status of the event.
+ *  @param[in] was_in_downtime  Was the event in downtime?
+ *  @param[in] opened_today     Did the event start this day?
+ *  @param[in] sla_duration     Its duration in the timeperiod.
+ */
+void availability_builder::_add_duration(short status,
+                                         bool was_in_downtime,
+                                         bool opened_today,
+                                         uint32_t sla_duration) {
   if (was_in_downtime) {
     _downtime += sla_duration;
     if (opened_today)
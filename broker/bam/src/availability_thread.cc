@@ -85,6 +85,7 @@ void availability_thread::run() {
       _build_availabilities(misc::start_of_day(::time(nullptr)));
       _should_rebuild_all = false;
       _bas_to_rebuild.clear();
+      _affected.clear();
 
       // Close the database.
       _close_database();
@@ -137,32 +138,50 @@ void availability_thread::unlock() {
 }
 
 /**
- *  Ask the thread to rebuild the availabilities.
+ *  Ask the thread to rebuild the availabilities. Only the days covered by
+ *  the given intervals are recomputed, the other daily rows are kept. The
+ *  intervals are added to those of a rebuild not done yet.
  *
- *  @param[in] bas_to_rebuild  A string containing the bas to rebuild.
+ *  @param[in] affected  For each BA to rebuild, the intervals of its events
+ *                       whose durations changed.
  */
 void availability_thread::rebuild_availabilities(
-    std::string const& bas_to_rebuild) {
+    const affected_periods& affected) {
   std::lock_guard<std::mutex> lock(_mutex);
-  if (bas_to_rebuild.empty())
+  if (affected.empty())
     return;
+  for (auto& p : affected) {
+    auto& intervals = _affected[p.first];
+    intervals.insert(intervals.end(), p.second.begin(), p.second.end());
+  }
+  std::vector<uint32_t> bas;
+  bas.reserve(_affected.size());
+  for (auto& p : _affected)
+    bas.push_back(p.first);
   _should_rebuild_all = true;
-  _bas_to_rebuild = bas_to_rebuild;
+  _bas_to_rebuild = fmt::format("{}", fmt::join(bas, ","));
   _wait.notify_one();
 }
 
 /**
- *  Delete all the availabilities.
+ *  Compare two availabilities.
+ *
+ *  @param[in] other  The other availability.
+ *
+ *  @return  True if both rows are the same.
  */
-void availability_thread::_delete_all_availabilities() {
-  _logger->debug("BAM-BI: availability thread deleting availabilities");
-
-  // Prepare the query.
-  std::string query_str(fmt::format(
-      "DELETE FROM mod_bam_reporting_ba_availabilities WHERE ba_id IN ({})",
-      _bas_to_rebuild));
-
-  _mysql->run_query(query_str, database::mysql_error::delete_availabilities);
+bool availability_thread::availability::operator==(
+    const availability& other) const {
+  return ba_id == other.ba_id && time_id == other.time_id &&
+         timeperiod_id == other.timeperiod_id &&
+         timeperiod_is_default == other.timeperiod_is_default &&
+         available == other.available && unavailable == other.unavailable &&
+         degraded == other.degraded && unknown == other.unknown &&
+         downtime == other.downtime &&
+         alert_unavailable_opened == other.alert_unavailable_opened &&
+         alert_degraded_opened == other.alert_degraded_opened &&
+         alert_unknown_opened == other.alert_unknown_opened &&
+         nb_downtime == other.nb_downtime;
 }
 
 /**
@@ -178,41 +197,32 @@ void availability_thread::_build_availabilities(time_t midnight) {
   std::string query_str;
   int thread_id;
 
-  // Get the first day of rebuilding. If a complete rebuilding was asked,
-  // it's the day of the chronogically first event to rebuild.
+  // Get the first day of rebuilding. On a rebuild, it's the day of the
+  // chronogically first event whose durations changed.
   // If not, it's the day following the chronogically last availability.
   if (_should_rebuild_all) {
-    query_str = fmt::format(
-        "SELECT MIN(start_time), MAX(end_time), MIN(IFNULL(end_time, '0'))"
-        " FROM mod_bam_reporting_ba_events  WHERE ba_id IN ({})",
-        _bas_to_rebuild);
-    try {
-      std::promise<database::mysql_result> promise;
-      std::future<database::mysql_result> future = promise.get_future();
-      thread_id =
-          _mysql->run_query_and_get_result(query_str, std::move(promise));
-      database::mysql_result res(future.get());
-      if (!_mysql->fetch_row(res))
-        throw msg_fmt("no events matching BAs to rebuild");
-      first_day = res.value_as_i32(0);
-      first_day = misc::start_of_day(first_day);
-      // If there is opened events, rebuild until midnight of this day.
-      // If not, rebuild until the last closed events.
-      if (res.value_as_i32(2) != 0)
-        last_day = misc::start_of_day(res.value_as_i32(1));
-
-      _delete_all_availabilities();
-    } catch (const std::exception& e) {
-      _logger->error(
-          "BAM-BI: availability thread could not select the BA durations from "
-          "the reporting database: {}",
-          e.what());
-      throw msg_fmt(
-          "BAM-BI: availability thread could not select the BA durations "
-          "from the reporting database: {}",
-          e.what());
+    time_t first = std::numeric_limits<time_t>::max();
+    time_t last = 0;
+    bool opened = false;
+    for (auto& p : _affected) {
+      for (auto& i : p.second) {
+        first = std::min(first, i.first);
+        if (i.second == 0)
+          opened = true;
+        else
+          last = std::max(last, i.second);
+      }
     }
-
+    if (first == std::numeric_limits<time_t>::max())
+      return;
+    first_day = misc::start_of_day(first);
+    // If there is opened events, rebuild until midnight of this day.
+    // If not, rebuild until the end of the day of the last closed event.
+    if (!opened)
+      last_day =
+          std::min(last_day, time::timeperiod::add_round_days_to_midnight(
+                                 misc::start_of_day(last), 3600 * 24));
+    thread_id = 0;
   } else {
     query_str = "SELECT MAX(time_id) FROM mod_bam_reporting_ba_availabilities";
     try {
@@ -242,32 +252,55 @@ void availability_thread::_build_availabilities(time_t midnight) {
       "BAM-BI: availability thread writing availabilities from: {} to {}",
       first_day, last_day);
 
-  // Write the availabilities day after day.
-  while (first_day < last_day) {
-    time_t next_day =
-        time::timeperiod::add_round_days_to_midnight(first_day, 3600 * 24);
-    _build_daily_availabilities(thread_id, first_day, next_day);
-    first_day = next_day;
-  }
+  // The boundaries of the days to compute, the last one being the end of the
+  // last day.
+  std::vector<time_t> days{first_day};
+  while (days.back() < last_day)
+    days.push_back(
+        time::timeperiod::add_round_days_to_midnight(days.back(), 3600 * 24));
+  if (days.size() < 2)
+    return;
+
+  ba_events events;
+  _load_events(thread_id, first_day, last_day, events);
+
+  // On a rebuild, the current rows of the BAs are compared to the computed
+  // ones, so that only the days that changed are written.
+  availability_map existing;
+  if (_should_rebuild_all)
+    _load_availabilities(thread_id, first_day, last_day, existing);
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<availability> computed = compute_availabilities(
+      events, days, _logger, _should_rebuild_all ? &_affected : nullptr);
+  _logger->info(
+      "BAM-BI: availability thread computed {} availabilities of {} BAs on {} "
+      "days in {}ms",
+      computed.size(), events.size(), days.size() - 1,
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - start)
+          .count());
+
+  _write_availabilities(thread_id, computed, existing);
 }
 
 /**
- *  @brief  Build all the availabilities of a day.
+ *  @brief  Load the events of the BAs between two days. The events durations
+ *  (closed events) are read with their timeperiod, the opened events are
+ *  given all the timeperiods of their BA.
  *
  *  This is called from the context of the availability thread.
  *
- *  @param[in] q         A SQL query object.
- *  @param[in] day_start The start of the day.
- *  @param[in] day_end   The first second of the next day.
+ *  @param[in] thread_id  Index to one connection to the database.
+ *  @param[in] first_day  The start of the first day.
+ *  @param[in] last_day   The end of the last day.
+ *  @param[out] events    The events indexed by BA.
  */
-void availability_thread::_build_daily_availabilities(int thread_id,
-                                                      time_t day_start,
-                                                      time_t day_end) {
-  _logger->info(
-      "BAM-BI: availability thread writing daily availability for day : {}-{}",
-      day_start, day_end);
-
-  // Build the availabilities tied to event durations (event finished)
+void availability_thread::_load_events(int thread_id,
+                                       time_t first_day,
+                                       time_t last_day,
+                                       ba_events& events) {
+  // The events durations (event finished).
   std::string query(fmt::format(
       "SELECT a.ba_event_id, b.ba_id, a.start_time, a.end_time, a.duration, "
       "a.sla_duration, a.timeperiod_id, a.timeperiod_is_default, b.status, "
@@ -275,7 +308,7 @@ void availability_thread::_build_daily_availabilities(int thread_id,
       "JOIN mod_bam_reporting_ba_events AS b ON a.ba_event_id=b.ba_event_id "
       "AND b.end_time IS NOT NULL WHERE a.start_time<{} AND a.end_time>={} "
       "{}",
-      day_end, day_start,
+      last_day, first_day,
       _should_rebuild_all ? fmt::format("AND b.ba_id IN({})", _bas_to_rebuild)
                           : ""));
 
@@ -284,13 +317,10 @@ void availability_thread::_build_daily_availabilities(int thread_id,
   std::future<database::mysql_result> future = promise.get_future();
   _mysql->run_query_and_get_result(query, std::move(promise), thread_id);
 
-  // Create a builder for each ba_id and associated timeperiod_id.
-  std::map<std::pair<uint32_t, uint32_t>, std::unique_ptr<availability_builder>>
-      builders;
+  size_t count = 0;
   try {
     database::mysql_result res(future.get());
     while (_mysql->fetch_row(res)) {
-      uint32_t ba_id = res.value_as_i32(1);
       uint32_t timeperiod_id = res.value_as_i32(6);
       // Find the timeperiod.
       time::timeperiod::ptr tp = _shared_tps.get_timeperiod(timeperiod_id);
@@ -299,41 +329,28 @@ void availability_thread::_build_daily_availabilities(int thread_id,
         _logger->debug("no timeperiod found with id {}", timeperiod_id);
         continue;
       }
-      // Find the builder.
-      auto found = builders.find({ba_id, timeperiod_id});
-      // No builders found, create one.
-      if (found == builders.end()) {
-        _logger->debug("adding new builder for ba id {} and timeperiod id {}",
-                       ba_id, timeperiod_id);
-        found = builders
-                    .insert(std::make_pair(
-                        std::make_pair(ba_id, timeperiod_id),
-                        std::unique_ptr<availability_builder>(
-                            new availability_builder(day_end, day_start))))
-                    .first;
-      }
-      // Add the event to the builder.
-      found->second->add_event(res.value_as_i32(8),   // Status
-                               res.value_as_i32(2),   // Start time
-                               res.value_as_i32(3),   // End time
-                               res.value_as_bool(9),  // Was in downtime
-                               tp, _logger);
-      // Add the timeperiod is default flag.
-      found->second->set_timeperiod_is_default(res.value_as_bool(7));
+      events[res.value_as_i32(1)].push_back(
+          {.status = static_cast<short>(res.value_as_i32(8)),
+           .start = res.value_as_i32(2),
+           .end = res.value_as_i32(3),
+           .in_downtime = res.value_as_bool(9),
+           .tp = std::move(tp),
+           .tp_is_default = res.value_as_bool(7)});
+      ++count;
     }
   } catch (const std::exception& e) {
     throw msg_fmt("BAM-BI: availability thread could not build the data {}",
                   e.what());
   }
 
-  _logger->debug("{} builders of availabilities created", builders.size());
+  _logger->debug("{} events durations loaded", count);
 
-  // Build the availabilities tied to event not finished.
+  // The events not finished.
   query = fmt::format(
       "SELECT ba_event_id,ba_id,start_time,end_time,status,"
       "in_downtime FROM mod_bam_reporting_ba_events WHERE start_time<{} AND "
       "end_time IS NULL {}",
-      day_end,
+      last_day,
       _should_rebuild_all ? fmt::format("AND ba_id IN ({})", _bas_to_rebuild)
                           : "");
   _logger->debug("Query: {}", query);
@@ -342,6 +359,7 @@ void availability_thread::_build_daily_availabilities(int thread_id,
   std::future<database::mysql_result> future_ba = promise_ba.get_future();
   _mysql->run_query_and_get_result(query, std::move(promise_ba), thread_id);
 
+  count = 0;
   try {
     database::mysql_result res(future_ba.get());
     while (_mysql->fetch_row(res)) {
@@ -349,82 +367,395 @@ void availability_thread::_build_daily_availabilities(int thread_id,
       // Get all the timeperiods associated with the ba of this event.
       std::vector<std::pair<time::timeperiod::ptr, bool>> tps =
           _shared_tps.get_timeperiods_by_ba_id(ba_id);
-      int count = 0;
-      for (auto it = tps.begin(), end = tps.end(); it != end; ++it) {
-        uint32_t tp_id = it->first->get_id();
-        // Find the builder.
-        auto found = builders.find(std::make_pair(ba_id, tp_id));
-        // No builders found, create one.
-        if (found == builders.end()) {
-          found = builders
-                      .insert(std::make_pair(
-                          std::make_pair(ba_id, tp_id),
-                          std::unique_ptr<availability_builder>(
-                              new availability_builder(day_end, day_start))))
-                      .first;
-          count++;
-        }
-        // Add the event to the builder.
-        found->second->add_event(res.value_as_i32(4),   // Status
-                                 res.value_as_i32(2),   // Start time
-                                 res.value_as_i32(3),   // End time
-                                 res.value_as_bool(5),  // Was in downtime
-                                 it->first, _logger);
-        // Add the timeperiod is default flag.
-        found->second->set_timeperiod_is_default(it->second);
-      }
-      _logger->debug("{} builder(s) were missing for ba {}", count, ba_id);
+      std::vector<ba_event>& ba_evts = events[ba_id];
+      for (auto& tp : tps)
+        ba_evts.push_back({.status = static_cast<short>(res.value_as_i32(4)),
+                           .start = res.value_as_i32(2),
+                           .end = 0,
+                           .in_downtime = res.value_as_bool(5),
+                           .tp = tp.first,
+                           .tp_is_default = tp.second});
+      ++count;
     }
   } catch (const std::exception& e) {
     throw msg_fmt("BAM-BI: availability thread could not build the data: {}",
                   e.what());
   }
 
-  _logger->debug("{} builder(s) to write availabilities", builders.size());
-  // For each builder, write the availabilities.
-  for (auto it = builders.begin(), end = builders.end(); it != end; ++it)
-    _write_availability(thread_id, *it->second, it->first.first, day_start,
-                        it->first.second);
+  _logger->debug("{} opened events loaded", count);
 }
 
 /**
- *  Write an availability to the database. *One* row is inserted by ba and by
- *  day.
+ *  @brief  Load the availabilities already stored for the days to rebuild.
+ *  The rows of the days not affected by the rebuild are not loaded, so they
+ *  are kept.
  *
- *  @param[in] thread_id              Index to one connection to the database.
- *  @param[in] builder                The builder of an availability.
- *  @param[in] ba_id                  The id of the ba.
- *  @param[in] day_start              The start of the day.
- *  @param[in] timeperiod_id          The id of the timeperiod.
+ *  @param[in] thread_id  Index to one connection to the database.
+ *  @param[in] first_day  The start of the first day.
+ *  @param[in] last_day   The end of the last day.
+ *  @param[out] existing  The availabilities found.
  */
-void availability_thread::_write_availability(
-    int thread_id,
-    availability_builder const& builder,
-    uint32_t ba_id,
+void availability_thread::_load_availabilities(int thread_id,
+                                               time_t first_day,
+                                               time_t last_day,
+                                               availability_map& existing) {
+  std::string query(fmt::format(
+      "SELECT ba_id, time_id, timeperiod_id, timeperiod_is_default,"
+      " available, unavailable, degraded, unknown, downtime,"
+      " alert_unavailable_opened, alert_degraded_opened, alert_unknown_opened,"
+      " nb_downtime FROM mod_bam_reporting_ba_availabilities WHERE ba_id IN "
+      "({}) AND time_id>={} AND time_id<{}",
+      _bas_to_rebuild, first_day, last_day));
+  _logger->debug("Query: {}", query);
+
+  std::promise<database::mysql_result> promise;
+  std::future<database::mysql_result> future = promise.get_future();
+  _mysql->run_query_and_get_result(query, std::move(promise), thread_id);
+
+  try {
+    database::mysql_result res(future.get());
+    while (_mysql->fetch_row(res)) {
+      availability a{
+          .ba_id = static_cast<uint32_t>(res.value_as_i32(0)),
+          .time_id = res.value_as_i32(1),
+          .timeperiod_id = static_cast<uint32_t>(res.value_as_i32(2)),
+          .timeperiod_is_default = res.value_as_bool(3),
+          .available = res.value_as_i32(4),
+          .unavailable = res.value_as_i32(5),
+          .degraded = res.value_as_i32(6),
+          .unknown = res.value_as_i32(7),
+          .downtime = res.value_as_i32(8),
+          .alert_unavailable_opened = res.value_as_i32(9),
+          .alert_degraded_opened = res.value_as_i32(10),
+          .alert_unknown_opened = res.value_as_i32(11),
+          .nb_downtime = res.value_as_i32(12)};
+      auto affected = _affected.find(a.ba_id);
+      if (affected == _affected.end() ||
+          !_day_is_affected(affected->second, a.time_id,
+                            time::timeperiod::add_round_days_to_midnight(
+                                a.time_id, 3600 * 24)))
+        continue;
+      existing.emplace(std::make_tuple(a.ba_id, a.time_id, a.timeperiod_id),
+                       a);
+    }
+  } catch (const std::exception& e) {
+    throw msg_fmt(
+        "BAM-BI: availability thread could not select the BA availabilities "
+        "from the reporting database: {}",
+        e.what());
+  }
+  _logger->debug("{} availabilities already stored for BAs {}",
+                 existing.size(), _bas_to_rebuild);
+}
+
+/**
+ *  @brief  Compute the daily availabilities of several BAs.
+ *
+ *  The valid ranges of the timeperiods are computed first, day by day. The
+ *  timeperiods need a process-wide timezone lock, the ranges don't, so the
+ *  BAs are then computed by dedicated threads without contention. Each
+ *  thread takes the next BA not yet computed until there are no more, so a
+ *  BA with many events does not delay the others.
+ *
+ *  @param[in] events    The events of each BA.
+ *  @param[in] days      The boundaries of the days to compute, the last one
+ *                       being the end of the last day.
+ *  @param[in] logger    The logger to use.
+ *  @param[in] affected  If given, only the days covered by these intervals
+ *                       are computed for each BA.
+ *
+ *  @return  The availabilities, one by BA, day and timeperiod.
+ */
+std::vector<availability_thread::availability>
+availability_thread::compute_availabilities(
+    const ba_events& events,
+    const std::vector<time_t>& days,
+    const std::shared_ptr<spdlog::logger>& logger,
+    const affected_periods* affected) {
+  std::vector<availability> retval;
+  if (events.empty() || days.size() < 2)
+    return retval;
+
+  const day_ranges ranges = _compute_day_ranges(events, days);
+
+  std::vector<std::pair<ba_events::const_pointer,
+                        const std::vector<std::pair<time_t, time_t>>*>>
+      bas;
+  bas.reserve(events.size());
+  for (auto& p : events) {
+    const std::vector<std::pair<time_t, time_t>>* ba_affected = nullptr;
+    if (affected) {
+      auto found = affected->find(p.first);
+      if (found == affected->end())
+        continue;
+      ba_affected = &found->second;
+    }
+    bas.emplace_back(&p, ba_affected);
+  }
+  if (bas.empty())
+    return retval;
+
+  size_t threads_count = std::min<size_t>(
+      std::max(std::thread::hardware_concurrency(), 1u), bas.size());
+  std::atomic<size_t> next_ba{0};
+  std::vector<std::vector<availability>> results(threads_count);
+  std::vector<std::exception_ptr> errors(threads_count);
+  std::vector<std::thread> threads;
+  threads.reserve(threads_count);
+
+  for (size_t i = 0; i < threads_count; ++i) {
+    threads.emplace_back([&, i] {
+      try {
+        for (size_t idx = next_ba++; idx < bas.size(); idx = next_ba++)
+          _compute_ba_availabilities(bas[idx].first->first,
+                                     bas[idx].first->second, days, ranges,
+                                     bas[idx].second, results[i], logger);
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+    });
+    pthread_setname_np(threads.back().native_handle(),
+                       fmt::format("bam_avail_{}", i).c_str());
+  }
+
+  for (auto& t : threads)
+    t.join();
+  for (auto& e : errors)
+    if (e)
+      std::rethrow_exception(e);
+
+  size_t size = 0;
+  for (auto& r : results)
+    size += r.size();
+  retval.reserve(size);
+  for (auto& r : results)
+    retval.insert(retval.end(), r.begin(), r.end());
+  return retval;
+}
+
+/**
+ *  @brief  Compute the valid ranges of the timeperiods of the events, on each
+ *  day concerned by these events. This is done once for all the BAs sharing
+ *  a timeperiod.
+ *
+ *  @param[in] events  The events of each BA.
+ *  @param[in] days    The boundaries of the days to compute.
+ *
+ *  @return  The valid ranges indexed by (timeperiod_id, day index).
+ */
+availability_thread::day_ranges availability_thread::_compute_day_ranges(
+    const ba_events& events,
+    const std::vector<time_t>& days) {
+  // For each timeperiod, the first and the last day used by events.
+  absl::flat_hash_map<uint32_t,
+                      std::tuple<const time::timeperiod*, size_t, size_t>>
+      used;
+  for (auto& p : events) {
+    for (const ba_event& e : p.second) {
+      size_t first = std::upper_bound(days.begin(), days.end(), e.start) -
+                     days.begin();
+      if (first > 0)
+        --first;
+      size_t last = e.end == 0 ? days.size() - 1
+                               : std::upper_bound(days.begin(), days.end(),
+                                                  e.end) -
+                                     days.begin();
+      auto [it, inserted] = used.try_emplace(e.tp->get_id(), e.tp.get(),
+                                             first, last);
+      if (!inserted) {
+        std::get<1>(it->second) = std::min(std::get<1>(it->second), first);
+        std::get<2>(it->second) = std::max(std::get<2>(it->second), last);
+      }
+    }
+  }
+
+  day_ranges retval;
+  for (auto& [tp_id, u] : used) {
+    auto& [tp, first, last] = u;
+    for (size_t idx = first; idx < last && idx + 1 < days.size(); ++idx)
+      retval[{tp_id, idx}] = availability_builder::compute_valid_ranges(
+          *tp, days[idx], days[idx + 1]);
+  }
+  return retval;
+}
+
+/**
+ *  Tell if a day is covered by one of the affected intervals of a BA.
+ *
+ *  @param[in] affected   The intervals, an end of 0 meaning until now.
+ *  @param[in] day_start  The beginning of the day.
+ *  @param[in] day_end    The end of the day.
+ *
+ *  @return  True if the day must be computed.
+ */
+bool availability_thread::_day_is_affected(
+    const std::vector<std::pair<time_t, time_t>>& affected,
     time_t day_start,
-    uint32_t timeperiod_id) {
-  _logger->debug(
-      "BAM-BI: availability thread writing availability for BA {} at day {} "
-      "(timeperiod {})",
-      ba_id, day_start, timeperiod_id);
-
-  std::string query_str(fmt::format(
-      "INSERT INTO mod_bam_reporting_ba_availabilities "
-      "(ba_id, time_id, timeperiod_id, timeperiod_is_default,"
-      " available, unavailable, degraded,"
-      " unknown, downtime, alert_unavailable_opened,"
-      " alert_degraded_opened, alert_unknown_opened,"
-      " nb_downtime)"
-      " VALUES ({},{},{},{},{},{},{},{},{},{},{},{},{})",
-      ba_id, day_start, timeperiod_id, builder.get_timeperiod_is_default(),
-      builder.get_available(), builder.get_unavailable(),
-      builder.get_degraded(), builder.get_unknown(), builder.get_downtime(),
-      builder.get_unavailable_opened(), builder.get_degraded_opened(),
-      builder.get_unknown_opened(), builder.get_downtime_opened()));
-
-  _logger->debug("Query: {}", query_str);
-  _mysql->run_query(query_str, database::mysql_error::insert_availability,
-                    thread_id);
+    time_t day_end) {
+  for (auto& i : affected)
+    if (i.first < day_end && (i.second == 0 || i.second >= day_start))
+      return true;
+  return false;
+}
+
+/**
+ *  @brief  Compute the daily availabilities of one BA. A builder is created
+ *  for each day and timeperiod seen in the events.
+ *
+ *  @param[in] ba_id     The id of the BA.
+ *  @param[in] events    Its events.
+ *  @param[in] days      The boundaries of the days to compute.
+ *  @param[in] ranges    The valid ranges of the timeperiods on each day.
+ *  @param[in] affected  If not null, only the days covered by these
+ *                       intervals are computed.
+ *  @param[out] result   The vector where the availabilities are appended.
+ *  @param[in] logger    The logger to use.
+ */
+void availability_thread::_compute_ba_availabilities(
+    uint32_t ba_id,
+    const std::vector<ba_event>& events,
+    const std::vector<time_t>& days,
+    const day_ranges& ranges,
+    const std::vector<std::pair<time_t, time_t>>* affected,
+    std::vector<availability>& result,
+    const std::shared_ptr<spdlog::logger>& logger) {
+  static const availability_builder::valid_ranges no_range;
+  std::vector<bool> to_compute(days.size() - 1, true);
+  if (affected)
+    for (size_t idx = 0; idx + 1 < days.size(); ++idx)
+      to_compute[idx] = _day_is_affected(*affected, days[idx], days[idx + 1]);
+
+  std::map<std::pair<size_t, uint32_t>, std::unique_ptr<availability_builder>>
+      builders;
+  for (const ba_event& e : events) {
+    // The first day ending after the event start.
+    size_t idx = std::upper_bound(days.begin(), days.end(), e.start) -
+                 days.begin();
+    if (idx > 0)
+      --idx;
+    // A closed event concerns the days until its end, an opened one all the
+    // days until the last one.
+    for (; idx + 1 < days.size() && (e.end == 0 || e.end >= days[idx]);
+         ++idx) {
+      if (!to_compute[idx])
+        continue;
+      auto& builder = builders[{idx, e.tp->get_id()}];
+      if (!builder)
+        builder =
+            std::make_unique<availability_builder>(days[idx + 1], days[idx]);
+      auto found = ranges.find({e.tp->get_id(), idx});
+      builder->add_event(e.status, e.start, e.end, e.in_downtime,
+                         found == ranges.end() ? no_range : found->second,
+                         logger);
+      builder->set_timeperiod_is_default(e.tp_is_default);
+    }
+  }
+  for (auto& p : builders) {
+    const availability_builder& b = *p.second;
+    result.push_back(
+        {.ba_id = ba_id,
+         .time_id = days[p.first.first],
+         .timeperiod_id = p.first.second,
+         .timeperiod_is_default = b.get_timeperiod_is_default(),
+         .available = b.get_available(),
+         .unavailable = b.get_unavailable(),
+         .degraded = b.get_degraded(),
+         .unknown = b.get_unknown(),
+         .downtime = b.get_downtime(),
+         .alert_unavailable_opened = b.get_unavailable_opened(),
+         .alert_degraded_opened = b.get_degraded_opened(),
+         .alert_unknown_opened = b.get_unknown_opened(),
+         .nb_downtime = b.get_downtime_opened()});
+  }
+}
+
+/**
+ *  Write the availabilities to the database. Rows already stored with the
+ *  same values are not written again, and the stored rows that are not
+ *  computed anymore are removed.
+ *
+ *  @param[in] thread_id  Index to one connection to the database.
+ *  @param[in] computed   The computed availabilities.
+ *  @param[in] existing   The availabilities currently stored, emptied of the
+ *                        computed ones.
+ */
+void availability_thread::_write_availabilities(
+    int thread_id,
+    const std::vector<availability>& computed,
+    availability_map& existing) {
+  constexpr size_t max_rows = 1000;
+  std::vector<std::string> values;
+  values.reserve(std::min(computed.size(), max_rows));
+  size_t written = 0;
+
+  auto flush_values = [&] {
+    if (values.empty())
+      return;
+    std::string query_str(fmt::format(
+        "INSERT INTO mod_bam_reporting_ba_availabilities "
+        "(ba_id, time_id, timeperiod_id, timeperiod_is_default,"
+        " available, unavailable, degraded,"
+        " unknown, downtime, alert_unavailable_opened,"
+        " alert_degraded_opened, alert_unknown_opened,"
+        " nb_downtime) VALUES {} ON DUPLICATE KEY UPDATE"
+        " timeperiod_is_default=VALUES(timeperiod_is_default),"
+        " available=VALUES(available), unavailable=VALUES(unavailable),"
+        " degraded=VALUES(degraded), unknown=VALUES(unknown),"
+        " downtime=VALUES(downtime),"
+        " alert_unavailable_opened=VALUES(alert_unavailable_opened),"
+        " alert_degraded_opened=VALUES(alert_degraded_opened),"
+        " alert_unknown_opened=VALUES(alert_unknown_opened),"
+        " nb_downtime=VALUES(nb_downtime)",
+        fmt::join(values, ",")));
+    _mysql->run_query(query_str, database::mysql_error::insert_availability,
+                      thread_id);
+    written += values.size();
+    values.clear();
+  };
+
+  for (const availability& a : computed) {
+    auto found =
+        existing.find(std::make_tuple(a.ba_id, a.time_id, a.timeperiod_id));
+    if (found != existing.end()) {
+      bool same = found->second == a;
+      existing.erase(found);
+      if (same)
+        continue;
+    }
+    values.emplace_back(fmt::format(
+        "({},{},{},{},{},{},{},{},{},{},{},{},{})", a.ba_id, a.time_id,
+        a.timeperiod_id, a.timeperiod_is_default, a.available, a.unavailable,
+        a.degraded, a.unknown, a.downtime, a.alert_unavailable_opened,
+        a.alert_degraded_opened, a.alert_unknown_opened, a.nb_downtime));
+    if (values.size() >= max_rows)
+      flush_values();
+  }
+  flush_values();
+
+  // The remaining rows are not produced by the events anymore.
+  std::vector<std::string> keys;
+  auto flush_keys = [&] {
+    if (keys.empty())
+      return;
+    _mysql->run_query(
+        fmt::format("DELETE FROM mod_bam_reporting_ba_availabilities WHERE "
+                    "(ba_id,time_id,timeperiod_id) IN ({})",
+                    fmt::join(keys, ",")),
+        database::mysql_error::delete_availabilities, thread_id);
+    keys.clear();
+  };
+  for (auto& p : existing) {
+    keys.emplace_back(fmt::format("({},{},{})", std::get<0>(p.first),
+                                  std::get<1>(p.first), std::get<2>(p.first)));
+    if (keys.size() >= max_rows)
+      flush_keys();
+  }
+  flush_keys();
+
+  _logger->info(
+      "BAM-BI: availability thread wrote {} availabilities on {} computed, {} "
+      "removed",
+      written, computed.size(), existing.size());
 }
 
 /**
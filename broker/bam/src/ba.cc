@@ -584,14 +584,51 @@ void ba::set_level_warning(double level) {
  */
 void ba::update_from(computable* child, io::stream* visitor) {
   _logger->trace("ba::update_from (BA {})", _id);
+  bool previous_in_downtime = _in_downtime;
+  bool changed = _apply_child_changes(static_cast<kpi*>(child), true);
+  _commit_changes(changed, previous_in_downtime, visitor);
+}
+
+/**
+ * @brief Update this computable with the modifications of several children.
+ * Impacts are all applied before the BA status is generated, so the BA is
+ * visited and its parents notified at most once.
+ *
+ * @param children The children that changed.
+ * @param visitor The visitor to handle events.
+ */
+void ba::update_from_children(const std::vector<computable*>& children,
+                              io::stream* visitor) {
+  _logger->trace("ba::update_from_children (BA {}, {} children)", _id,
+                 children.size());
+  bool previous_in_downtime = _in_downtime;
+  bool changed = false;
+  /* When the BA is computed from all its impacts, only the last one needs to
+   * trigger the computation. */
+  bool full_recompute = _full_recompute();
+  for (size_t i = 0; i < children.size(); ++i) {
+    bool compute = !full_recompute || i + 1 == children.size();
+    changed |= _apply_child_changes(static_cast<kpi*>(children[i]), compute);
+  }
+  _commit_changes(changed, previous_in_downtime, visitor);
+}
+
+/**
+ * @brief Apply to this BA the current impacts of a KPI.
+ *
+ * @param kpi_child The KPI that changed.
+ * @param compute If false, the new impacts are only stored, the BA is not
+ *                computed.
+ *
+ * @return True if the BA changed.
+ */
+bool ba::_apply_child_changes(kpi* kpi_child, bool compute) {
   // Get impact.
   impact_values new_hard_impact;
   impact_values new_soft_impact;
-  kpi* kpi_child = static_cast<kpi*>(child);
   kpi_child->impact_hard(new_hard_impact);
   kpi_child->impact_soft(new_soft_impact);
   bool kpi_in_downtime(kpi_child->in_downtime());
-  bool previous_in_downtime = _in_downtime;
 
   // Logging.
   SPDLOG_LOGGER_DEBUG(
@@ -605,13 +642,36 @@ void ba::update_from(computable* child, io::stream* visitor) {
   if (!last_state_change.is_null())
     _last_kpi_update = std::max(_last_kpi_update, last_state_change);
 
+  if (!compute) {
+    auto found = _impacts.find(kpi_child);
+    if (found != _impacts.end()) {
+      found->second.hard_impact = new_hard_impact;
+      found->second.soft_impact = new_soft_impact;
+      found->second.in_downtime = kpi_in_downtime;
+    }
+    return false;
+  }
+
   // Apply new data.
   SPDLOG_LOGGER_TRACE(_logger, "BAM: BA {} updated from KPI {}", _id,
                       kpi_child->get_id());
   bool changed = _apply_changes(kpi_child, new_hard_impact, new_soft_impact,
                                 kpi_in_downtime);
   SPDLOG_LOGGER_TRACE(_logger, "BA {} has changed: {}", _id, changed);
+  return changed;
+}
 
+/**
+ * @brief Once the impacts of the changed KPIs are applied, compute the
+ * inherited downtime, generate the BA events and notify the parents if needed.
+ *
+ * @param changed True if the BA changed while applying the impacts.
+ * @param previous_in_downtime The downtime flag before the impacts applied.
+ * @param visitor The visitor to handle events.
+ */
+void ba::_commit_changes(bool changed,
+                         bool previous_in_downtime,
+                         io::stream* visitor) {
   // Check for inherited downtimes.
   _compute_inherited_downtime(visitor);
 
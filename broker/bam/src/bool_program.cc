@@ -0,0 +1,407 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/broker/bam/bool_program.hh"
+
+using namespace com::centreon::broker::bam;
+
+static constexpr double eps = 0.000001;
+static constexpr double compare_eps = 0.0001;
+
+/**
+ * @brief Append an instruction to the program and link its operands to it.
+ *
+ * @param ins The instruction.
+ *
+ * @return The slot of the instruction.
+ */
+uint32_t bool_program::_push(instruction&& ins) {
+  uint32_t retval = _code.size();
+  if (ins.op != op_operand && ins.op != op_constant) {
+    _code[ins.left].parent = retval;
+    if (ins.right != npos)
+      _code[ins.right].parent = retval;
+  }
+  _code.emplace_back(std::move(ins));
+  _root = retval;
+  return retval;
+}
+
+/**
+ * @brief Add an operand to the program. The program must then be added as
+ * parent of the operand, so that it is notified of its changes.
+ *
+ * @param operand The operand (usually a bool_service).
+ *
+ * @return The slot of the operand.
+ */
+uint32_t bool_program::push_operand(const bool_value::ptr& operand) {
+  instruction ins{.op = op_operand, .left = uint32_t(_operands.size())};
+  _operands.push_back(operand);
+  uint32_t retval = _push(std::move(ins));
+  _slots[operand.get()].push_back(retval);
+  return retval;
+}
+
+/**
+ * @brief Add a constant to the program.
+ *
+ * @param value The value of the constant.
+ *
+ * @return The slot of the constant.
+ */
+uint32_t bool_program::push_constant(double value) {
+  return _push({.op = op_constant, .left_hard = value});
+}
+
+/**
+ * @brief Add a NOT operator to the program.
+ *
+ * @param operand The slot of its operand.
+ *
+ * @return The slot of the operator.
+ */
+uint32_t bool_program::push_not(uint32_t operand) {
+  return _push({.op = op_not, .left = operand});
+}
+
+/**
+ * @brief Add a binary operator to the program and compute its initial state.
+ *
+ * @param op The operator.
+ * @param left The slot of its left operand.
+ * @param right The slot of its right operand.
+ *
+ * @return The slot of the operator.
+ */
+uint32_t bool_program::push_binary(opcode op, uint32_t left, uint32_t right) {
+  uint32_t retval = _push({.op = op, .left = left, .right = right});
+  _update(retval);
+  return retval;
+}
+
+/**
+ * @brief Set the slot giving the value of the whole expression. By default,
+ * it is the last instruction pushed.
+ *
+ * @param slot The slot of the root.
+ */
+void bool_program::set_root(uint32_t slot) {
+  _root = slot;
+}
+
+/**
+ * @brief Compute the state of a binary operator from its operands.
+ *
+ * AND and OR can be known as soon as one of their operands is known to be
+ * false (resp. true), the other operators need both operands to be known.
+ *
+ * @param slot The slot of the operator.
+ */
+void bool_program::_update(uint32_t slot) {
+  instruction& ins = _code[slot];
+  auto generic_rule = [this, &ins] {
+    ins.known = _state_known(ins.left) && _state_known(ins.right);
+    if (ins.known) {
+      ins.left_hard = _value_hard(ins.left);
+      ins.right_hard = _value_hard(ins.right);
+      ins.downtime = _in_downtime(ins.left) || _in_downtime(ins.right);
+    }
+  };
+
+  switch (ins.op) {
+    case op_and:
+      if (_state_known(ins.left) && !_boolean_value(ins.left)) {
+        ins.left_hard = 0;
+        ins.boolean = false;
+        ins.known = true;
+      } else if (_state_known(ins.right) && !_boolean_value(ins.right)) {
+        ins.right_hard = 0;
+        ins.boolean = false;
+        ins.known = true;
+      } else {
+        generic_rule();
+        ins.boolean = ins.known && std::abs(ins.left_hard) > eps &&
+                      std::abs(ins.right_hard) > eps;
+      }
+      break;
+    case op_or:
+      if (_state_known(ins.left) && _boolean_value(ins.left)) {
+        ins.left_hard = 1;
+        ins.boolean = true;
+        ins.known = true;
+      } else if (_state_known(ins.right) && _boolean_value(ins.right)) {
+        ins.right_hard = 1;
+        ins.boolean = true;
+        ins.known = true;
+      } else {
+        ins.boolean = false;
+        generic_rule();
+      }
+      break;
+    default:
+      generic_rule();
+      break;
+  }
+  _logger->trace(
+      "bool_program::_update: slot {} opcode {}: known: {} - left: {} - right: "
+      "{} - downtime: {}",
+      slot, static_cast<uint32_t>(ins.op), ins.known, ins.left_hard,
+      ins.right_hard, ins.downtime);
+}
+
+/**
+ * @brief Walk from a changed slot to the root, computing each operator on the
+ * way. The walk stops as soon as an operator sees no change in its operand.
+ *
+ * @param slot The slot that changed.
+ *
+ * @return True if the root has been reached, i.e. the expression changed.
+ */
+bool bool_program::_propagate(uint32_t slot) {
+  for (;;) {
+    uint32_t parent = _code[slot].parent;
+    if (parent == npos)
+      return slot == _root;
+    instruction& ins = _code[parent];
+    if (ins.op != op_not) {
+      double previous = slot == ins.left ? ins.left_hard : ins.right_hard;
+      if (_state_known(slot) == ins.known &&
+          std::abs(previous - _value_hard(slot)) <= eps) {
+        _logger->trace("bool_program: slot {} unchanged, stop at slot {}",
+                       slot, parent);
+        return false;
+      }
+      _update(parent);
+    }
+    slot = parent;
+  }
+}
+
+/**
+ * @brief Get the value of a slot.
+ *
+ * @param slot The slot.
+ *
+ * @return A double.
+ */
+double bool_program::_value_hard(uint32_t slot) const {
+  const instruction& ins = _code[slot];
+  switch (ins.op) {
+    case op_operand:
+      return _operands[ins.left]->value_hard();
+    case op_constant:
+      return ins.left_hard;
+    case op_not:
+      return std::abs(_value_hard(ins.left)) < eps;
+    case op_and:
+    case op_or:
+      return ins.boolean;
+    case op_xor:
+      return (std::abs(ins.left_hard) > eps) ^
+             (std::abs(ins.right_hard) > eps);
+    case op_equal:
+      return ins.known &&
+             std::fabs(ins.left_hard - ins.right_hard) < compare_eps;
+    case op_not_equal:
+      return std::fabs(ins.left_hard - ins.right_hard) >= compare_eps ? 1.0
+                                                                      : 0.0;
+    case op_more_than:
+      return ins.left_hard > ins.right_hard;
+    case op_more_equal:
+      return ins.left_hard >= ins.right_hard;
+    case op_less_than:
+      return ins.left_hard < ins.right_hard;
+    case op_less_equal:
+      return ins.left_hard <= ins.right_hard;
+    case op_addition:
+      return ins.left_hard + ins.right_hard;
+    case op_substraction:
+      return ins.left_hard - ins.right_hard;
+    case op_multiplication:
+      return ins.left_hard * ins.right_hard;
+    case op_division:
+      if (std::fabs(ins.right_hard) < compare_eps)
+        return NAN;
+      return ins.left_hard / ins.right_hard;
+    case op_modulo: {
+      long long left_val = static_cast<long long>(ins.left_hard);
+      long long right_val = static_cast<long long>(ins.right_hard);
+      if (right_val == 0)
+        return NAN;
+      return left_val % right_val;
+    }
+  }
+  return NAN;
+}
+
+/**
+ * @brief Get the boolean value of a slot.
+ *
+ * @param slot The slot.
+ *
+ * @return A boolean.
+ */
+bool bool_program::_boolean_value(uint32_t slot) const {
+  const instruction& ins = _code[slot];
+  switch (ins.op) {
+    case op_operand:
+      return _operands[ins.left]->boolean_value();
+    case op_constant:
+      return std::abs(ins.left_hard) > eps;
+    case op_multiplication:
+      return std::fabs(ins.left_hard * ins.right_hard) > compare_eps;
+    case op_division:
+      if (std::fabs(ins.right_hard) < compare_eps)
+        return false;
+      return ins.left_hard / ins.right_hard;
+    case op_modulo:
+      return static_cast<long long>(ins.right_hard) != 0 &&
+             _value_hard(slot);
+    default:
+      return _value_hard(slot);
+  }
+}
+
+/**
+ * @brief Tell if the value of a slot is known.
+ *
+ * @param slot The slot.
+ *
+ * @return A boolean.
+ */
+bool bool_program::_state_known(uint32_t slot) const {
+  const instruction& ins = _code[slot];
+  switch (ins.op) {
+    case op_operand:
+      return _operands[ins.left]->state_known();
+    case op_constant:
+      return true;
+    case op_not:
+      return _state_known(ins.left);
+    case op_division:
+    case op_modulo:
+      return ins.known && std::fabs(ins.right_hard) >= compare_eps;
+    default:
+      return ins.known;
+  }
+}
+
+/**
+ * @brief Tell if a slot is in downtime.
+ *
+ * @param slot The slot.
+ *
+ * @return A boolean.
+ */
+bool bool_program::_in_downtime(uint32_t slot) const {
+  const instruction& ins = _code[slot];
+  switch (ins.op) {
+    case op_operand:
+      return _operands[ins.left]->in_downtime();
+    case op_constant:
+      return false;
+    case op_not:
+      return _in_downtime(ins.left);
+    default:
+      return ins.downtime;
+  }
+}
+
+/**
+ *  Get the hard value of the expression.
+ *
+ *  @return Hard value.
+ */
+double bool_program::value_hard() const {
+  return _root == npos ? 0 : _value_hard(_root);
+}
+
+/**
+ *  Get the boolean value of the expression.
+ *
+ *  @return Boolean value.
+ */
+bool bool_program::boolean_value() const {
+  return _root != npos && _boolean_value(_root);
+}
+
+/**
+ *  Get if the state is known, i.e has been computed at least once.
+ *
+ *  @return  True if the state is known.
+ */
+bool bool_program::state_known() const {
+  return _root != npos && _state_known(_root);
+}
+
+/**
+ *  Is this expression in downtime?
+ *
+ *  @return  True if this expression is in downtime.
+ */
+bool bool_program::in_downtime() const {
+  return _root != npos && _in_downtime(_root);
+}
+
+/**
+ * @brief Update this computable with the child modifications. Only the
+ * operators between the child and the root are computed.
+ *
+ * @param child The child that changed.
+ * @param visitor The visitor to handle events.
+ */
+void bool_program::update_from(computable* child, io::stream* visitor) {
+  _logger->trace("bool_program::update_from");
+  auto found = _slots.find(child);
+  if (found == _slots.end())
+    return;
+  bool changed = false;
+  for (uint32_t slot : found->second)
+    changed |= _propagate(slot);
+  if (changed)
+    notify_parents_of_change(visitor);
+}
+
+/**
+ * @brief This method is used by the dump() method. It gives a summary of this
+ * computable main informations.
+ *
+ * @return A multiline strings with various informations.
+ */
+std::string bool_program::object_info() const {
+  return fmt::format(
+      "PROGRAM {:p}\ninstructions: {}\nknown: {}\nvalue: {}",
+      static_cast<const void*>(this), _code.size(),
+      state_known() ? "true" : "false", boolean_value() ? "true" : "false");
+}
+
+/**
+ * @brief Recursive or not method that writes object informations to the
+ * output stream. If there are children, each one dump() is then called.
+ *
+ * @param output An output stream.
+ */
+void bool_program::dump(std::ofstream& output) const {
+  for (auto& operand : _operands) {
+    output << fmt::format("\"{}\" -> \"{}\"\n", object_info(),
+                          operand->object_info());
+    operand->dump(output);
+  }
+  dump_parents(output);
+}
@@ -20,6 +20,9 @@
 
 using namespace com::centreon::broker::bam;
 
+std::atomic<uint64_t> computable::_topology_version{1};
+thread_local computable::batch* computable::batch::_current = nullptr;
+
 /**
  *  Add a new parent.
  *
@@ -30,6 +33,7 @@ void computable::add_parent(std::shared_ptr<computable> const& parent) {
     if (it->lock().get() == parent.get())
       return;
   _parents.push_back(std::weak_ptr<computable>(parent));
+  ++_topology_version;
 }
 
 /**
@@ -43,6 +47,7 @@ void computable::remove_parent(std::shared_ptr<computable> const& parent) {
        it != end; ++it)
     if (it->lock().get() == parent.get()) {
       _parents.erase(it);
+      ++_topology_version;
       break;
     }
 }
@@ -54,9 +59,115 @@ void computable::remove_parent(std::shared_ptr<computable> const& parent) {
  */
 void computable::notify_parents_of_change(io::stream* visitor) {
   _logger->trace("{}::notify_parents_of_change: ", typeid(*this).name());
-  for (auto& p : _parents) {
-    if (std::shared_ptr<computable> parent = p.lock())
-      parent->update_from(this, visitor);
+  batch* current = batch::_current;
+  if (current && current->_visitor == visitor)
+    current->_mark_parents_of(this);
+  else {
+    batch changes(visitor);
+    changes._mark_parents_of(this);
+    changes.commit();
+  }
+}
+
+/**
+ * @brief Update this computable from several changed children at once. The
+ * default implementation just calls update_from() for each of them, classes
+ * whose update is expensive override it to be computed only once.
+ *
+ * @param children The children that changed.
+ * @param visitor The visitor to handle events.
+ */
+void computable::update_from_children(const std::vector<computable*>& children,
+                                      io::stream* visitor) {
+  for (computable* child : children)
+    update_from(child, visitor);
+}
+
+/**
+ * @brief Get the rank of this computable in the BA/KPI tree. A computable
+ * without parent has rank 0, otherwise its rank is one more than the biggest
+ * rank of its parents. So a child always has a rank greater than its parents.
+ *
+ * @return The rank.
+ */
+uint32_t computable::rank() const {
+  uint64_t version = _topology_version;
+  if (_rank_version != version) {
+    uint32_t retval = 0;
+    for (auto& p : _parents) {
+      if (std::shared_ptr<computable> parent = p.lock())
+        retval = std::max(retval, parent->rank() + 1);
+    }
+    _rank = retval;
+    _rank_version = version;
+  }
+  return _rank;
+}
+
+/**
+ * @brief Constructor. The batch becomes the current one of this thread until
+ * its destruction.
+ *
+ * @param visitor The visitor given to the computables on commit.
+ */
+computable::batch::batch(io::stream* visitor)
+    : _visitor{visitor}, _previous{_current} {
+  _current = this;
+}
+
+/**
+ * @brief Destructor. Computables not committed are forgotten.
+ */
+computable::batch::~batch() noexcept {
+  suspend();
+}
+
+/**
+ * @brief Stop collecting the changes, the batch that was current before this
+ * one becomes current again. Dirty computables are kept.
+ */
+void computable::batch::suspend() noexcept {
+  if (_current == this)
+    _current = _previous;
+}
+
+/**
+ * @brief Make this batch the current one of this thread again, after a
+ * suspend().
+ */
+void computable::batch::resume() noexcept {
+  _current = this;
+}
+
+/**
+ * @brief Mark the parents of child as dirty because of it.
+ *
+ * @param child The computable that changed.
+ */
+void computable::batch::_mark_parents_of(computable* child) {
+  for (auto& p : child->_parents) {
+    if (std::shared_ptr<computable> parent = p.lock()) {
+      entry& e = _dirty[{parent->rank(), parent.get()}];
+      if (!e.node)
+        e.node = std::move(parent);
+      if (std::find(e.children.begin(), e.children.end(), child) ==
+          e.children.end())
+        e.children.push_back(child);
+    }
+  }
+}
+
+/**
+ * @brief Update all the dirty computables. Those with the greatest rank are
+ * computed first, their parents are then marked dirty with a smaller rank, so
+ * each computable is updated only once.
+ */
+void computable::batch::commit() {
+  while (!_dirty.empty()) {
+    auto first = _dirty.begin();
+    entry e = std::move(first->second);
+    _dirty.erase(first);
+    e.node->update_from_children(e.children, _visitor);
   }
 }
 
@@ -18,17 +18,7 @@
 
 #include "com/centreon/broker/bam/exp_builder.hh"
 
-#include "com/centreon/broker/bam/bool_and.hh"
-#include "com/centreon/broker/bam/bool_constant.hh"
-#include "com/centreon/broker/bam/bool_equal.hh"
-#include "com/centreon/broker/bam/bool_less_than.hh"
-#include "com/centreon/broker/bam/bool_more_than.hh"
-#include "com/centreon/broker/bam/bool_not.hh"
-#include "com/centreon/broker/bam/bool_not_equal.hh"
-#include "com/centreon/broker/bam/bool_operation.hh"
-#include "com/centreon/broker/bam/bool_or.hh"
 #include "com/centreon/broker/bam/bool_service.hh"
-#include "com/centreon/broker/bam/bool_xor.hh"
 #include "com/centreon/broker/bam/exp_parser.hh"
 #include "com/centreon/exceptions/msg_fmt.hh"
 
@@ -49,7 +39,9 @@ using namespace com::centreon::broker::bam;
 exp_builder::exp_builder(exp_parser::notation const& postfix,
                          hst_svc_mapping const& mapping,
                          const std::shared_ptr<spdlog::logger>& logger)
-    : _logger(logger), _mapping(mapping) {
+    : _logger(logger),
+      _mapping(mapping),
+      _program{std::make_shared<bool_program>(logger)} {
   // Browse all tokens.
   for (exp_parser::notation::const_iterator it(postfix.begin()),
        end(postfix.end());
@@ -60,45 +52,47 @@ exp_builder::exp_builder(exp_parser::notation const& postfix,
       if (*it == "-u") {
         // XXX
       } else if (*it == "!") {
-        bool_value::ptr arg(_pop_operand());
-        any_operand exp(std::make_shared<bool_not>(arg, _logger), "");
-        arg->add_parent(exp.first);
-        _operands.push(exp);
+        uint32_t arg = _pop_operand();
+        _operands.push(any_operand(_program->push_not(arg), ""));
       }
       // Binary operators.
       else {
-        bool_binary_operator::ptr binary;
+        bool_program::opcode op;
         if (*it == "&&" || *it == "AND")
-          binary = std::make_shared<bool_and>(_logger);
+          op = bool_program::op_and;
         else if (*it == "||" || *it == "OR")
-          binary = std::make_shared<bool_or>(_logger);
+          op = bool_program::op_or;
         else if (*it == "^" || *it == "XOR")
-          binary = std::make_shared<bool_xor>(_logger);
+          op = bool_program::op_xor;
         else if (*it == "==" || *it == "IS")
-          binary = std::make_shared<bool_equal>(_logger);
+          op = bool_program::op_equal;
         else if (*it == "!=" || *it == "NOT")
-          binary = std::make_shared<bool_not_equal>(_logger);
+          op = bool_program::op_not_equal;
         else if (*it == ">")
-          binary = std::make_shared<bool_more_than>(true, _logger);
+          op = bool_program::op_more_than;
         else if (*it == ">=")
-          binary = std::make_shared<bool_more_than>(false, _logger);
+          op = bool_program::op_more_equal;
         else if (*it == "<")
-          binary = std::make_shared<bool_less_than>(true, _logger);
+          op = bool_program::op_less_than;
         else if (*it == "<=")
-          binary = std::make_shared<bool_less_than>(false, _logger);
-        else if (*it == "+" || *it == "-" || *it == "*" || *it == "/" ||
-                 *it == "%")
-          binary = std::make_shared<bool_operation>(*it, _logger);
+          op = bool_program::op_less_equal;
+        else if (*it == "+")
+          op = bool_program::op_addition;
+        else if (*it == "-")
+          op = bool_program::op_substraction;
+        else if (*it == "*")
+          op = bool_program::op_multiplication;
+        else if (*it == "/")
+          op = bool_program::op_division;
+        else if (*it == "%")
+          op = bool_program::op_modulo;
         else
           throw msg_fmt(
               "unsupported operator {} found while parsing expression", *it);
-        bool_value::ptr right(_pop_operand());
-        bool_value::ptr left(_pop_operand());
-        left->add_parent(binary);
-        right->add_parent(binary);
-        binary->set_left(left);
-        binary->set_right(right);
-        _operands.push(any_operand(binary, ""));
+        uint32_t right = _pop_operand();
+        uint32_t left = _pop_operand();
+        _operands.push(
+            any_operand(_program->push_binary(op, left, right), ""));
       }
     }
     // "Static" function calls (status or metrics retrieval).
@@ -137,7 +131,8 @@ exp_builder::exp_builder(exp_parser::notation const& postfix,
             std::make_shared<bool_service>(ids.first, ids.second, _logger)};
 
         // Store it in the operand stack and within the service list.
-        _operands.push(any_operand(obj, ""));
+        _operands.push(any_operand(_program->push_operand(obj), ""));
+        obj->add_parent(_program);
         _services.push_back(obj);
       }
       // Single metric.
@@ -181,15 +176,16 @@ exp_builder::exp_builder(exp_parser::notation const& postfix,
     }
     // Operand (will be evaluated when poped).
     else {
-      any_operand op(bool_value::ptr(), *it);
+      any_operand op(bool_program::npos, *it);
       _operands.push(op);
     }
   }
 
-  // The sole remaining operand should be the tree root.
-  _tree = _pop_operand();
+  // The sole remaining operand should be the program root.
+  _program->set_root(_pop_operand());
   if (!_operands.empty())
     throw msg_fmt("unable to build an expression: incorrect syntax");
+  _tree = _program;
 }
 
 /**
@@ -211,9 +207,9 @@ exp_builder::list_service const& exp_builder::get_services() const {
 }
 
 /**
- *  Get expression tree.
+ *  Get the compiled expression.
  *
- *  @return The expression tree.
+ *  @return The expression program.
  */
 bool_value::ptr exp_builder::get_tree() const {
   return _tree;
@@ -254,9 +250,9 @@ bool exp_builder::_is_static_function(std::string const& str) const {
  *  If the operand has not yet been evaluated it is converted to its
  *  numerical value.
  *
- *  @return The ready-to-use operand.
+ *  @return The slot of the ready-to-use operand in the program.
  */
-bool_value::ptr exp_builder::_pop_operand() {
+uint32_t exp_builder::_pop_operand() {
   // Check that operand exist.
   if (_operands.empty())
     throw msg_fmt(
@@ -264,8 +260,8 @@ bool_value::ptr exp_builder::_pop_operand() {
         "operator or function");
 
   // Check if operand needs to be converted.
-  bool_value::ptr retval;
-  if (!_operands.top().first) {
+  uint32_t retval;
+  if (_operands.top().first == bool_program::npos) {
     std::string& value_str(_operands.top().second);
     double value;
     if (value_str == "OK")
@@ -284,7 +280,7 @@ bool_value::ptr exp_builder::_pop_operand() {
       value = 2;
     else
       value = std::strtod(value_str.c_str(), nullptr);
-    retval.reset(new bool_constant(value, _logger));
+    retval = _program->push_constant(value);
   } else
     retval = _operands.top().first;
 
@@ -308,7 +304,8 @@ std::string exp_builder::_pop_string() {
         "operator or function");
 
   // Check that operand is a string.
-  if (_operands.top().first || _operands.top().second.empty())
+  if (_operands.top().first != bool_program::npos ||
+      _operands.top().second.empty())
     throw msg_fmt("syntax error: operand was expected to be a string");
 
   // Retval.
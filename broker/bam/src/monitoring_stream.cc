@@ -65,6 +65,7 @@ monitoring_stream::monitoring_stream(
       _conf_queries_per_transaction(db_cfg.get_queries_per_transaction()),
       _pending_events(0),
       _pending_request(0),
+      _batched_events(0),
       _storage_db_cfg(storage_db_cfg),
       _cache(std::move(cache)),
       _forced_svc_checks_timer{com::centreon::common::pool::io_context()},
@@ -101,6 +102,7 @@ monitoring_stream::~monitoring_stream() {
  *  @return Number of acknowledged events.
  */
 int32_t monitoring_stream::flush() {
+  _commit_batch();
   _execute();
   _pending_request = 0;
   int retval = _pending_events;
@@ -184,6 +186,8 @@ bool monitoring_stream::read(std::shared_ptr<io::data>& d, time_t deadline) {
 void monitoring_stream::update() {
   SPDLOG_LOGGER_TRACE(_logger, "BAM: monitoring_stream update");
   try {
+    // The computables of the batch may be removed by the new configuration.
+    _commit_batch();
     configuration::state s{_logger};
     configuration::reader_v2 r(_mysql, _storage_db_cfg);
     r.read(s);
@@ -381,7 +385,9 @@ int monitoring_stream::write(const std::shared_ptr<io::data>& data) {
 
   SPDLOG_LOGGER_TRACE(_logger, "BAM: {} pending events", _pending_events);
 
-  // Process service status events.
+  // Process service status events. Changes are collected in a batch kept
+  // until the next flush, so that each impacted BA is computed only once for
+  // all the events read from the muxer since then.
   switch (data->type()) {
     case neb::service_status::static_type():
     case neb::service::static_type(): {
@@ -393,10 +399,9 @@ int monitoring_stream::write(const std::shared_ptr<io::data>& data) {
           "{}, "
           "current state {})",
           ss->host_id, ss->service_id, ss->last_hard_state, ss->current_state);
-      multiplexing::publisher pblshr;
-      event_cache_visitor ev_cache;
-      _applier.book_service().update(ss, &ev_cache);
-      ev_cache.commit_to(pblshr);
+      _update_in_batch([this, &ss](io::stream* visitor) {
+        _applier.book_service().update(ss, visitor);
+      });
     } break;
     case neb::pb_service_status::static_type(): {
       auto ss = std::static_pointer_cast<neb::pb_service_status>(data);
@@ -406,10 +411,9 @@ int monitoring_stream::write(const std::shared_ptr<io::data>& data) {
           "BAM: processing pb service status (host: {}, service: {}, hard "
           "state {}, current state {})",
           o.host_id(), o.service_id(), o.last_hard_state(), o.state());
-      multiplexing::publisher pblshr;
-      event_cache_visitor ev_cache;
-      _applier.book_service().update(ss, &ev_cache);
-      ev_cache.commit_to(pblshr);
+      _update_in_batch([this, &ss](io::stream* visitor) {
+        _applier.book_service().update(ss, visitor);
+      });
     } break;
     case neb::pb_adaptive_service_status::static_type(): {
       auto ss = std::static_pointer_cast<neb::pb_adaptive_service_status>(data);
@@ -418,10 +422,9 @@ int monitoring_stream::write(const std::shared_ptr<io::data>& data) {
                           "BAM: processing pb adaptive service status (host: "
                           "{}, service: {})",
                           o.host_id(), o.service_id());
-      multiplexing::publisher pblshr;
-      event_cache_visitor ev_cache;
-      _applier.book_service().update(ss, &ev_cache);
-      ev_cache.commit_to(pblshr);
+      _update_in_batch([this, &ss](io::stream* visitor) {
+        _applier.book_service().update(ss, visitor);
+      });
     } break;
     case neb::pb_service::static_type(): {
       auto s = std::static_pointer_cast<neb::pb_service>(data);
@@ -431,10 +434,9 @@ int monitoring_stream::write(const std::shared_ptr<io::data>& data) {
           "BAM: processing pb service (host: {}, service: {}, hard "
           "state {}, current state {})",
           o.host_id(), o.service_id(), o.last_hard_state(), o.state());
-      multiplexing::publisher pblshr;
-      event_cache_visitor ev_cache;
-      _applier.book_service().update(s, &ev_cache);
-      ev_cache.commit_to(pblshr);
+      _update_in_batch([this, &s](io::stream* visitor) {
+        _applier.book_service().update(s, visitor);
+      });
     } break;
     case neb::pb_acknowledgement::static_type(): {
       std::shared_ptr<neb::pb_acknowledgement> ack(
@@ -442,10 +444,9 @@ int monitoring_stream::write(const std::shared_ptr<io::data>& data) {
       SPDLOG_LOGGER_TRACE(_logger,
                           "BAM: processing acknowledgement on service ({}, {})",
                           ack->obj().host_id(), ack->obj().service_id());
-      multiplexing::publisher pblshr;
-      event_cache_visitor ev_cache;
-      _applier.book_service().update(ack, &ev_cache);
-      ev_cache.commit_to(pblshr);
+      _update_in_batch([this, &ack](io::stream* visitor) {
+        _applier.book_service().update(ack, visitor);
+      });
     } break;
     case neb::acknowledgement::static_type(): {
       std::shared_ptr<neb::acknowledgement> ack(
@@ -453,10 +454,9 @@ int monitoring_stream::write(const std::shared_ptr<io::data>& data) {
       SPDLOG_LOGGER_TRACE(_logger,
                           "BAM: processing acknowledgement on service ({}, {})",
                           ack->host_id, ack->service_id);
-      multiplexing::publisher pblshr;
-      event_cache_visitor ev_cache;
-      _applier.book_service().update(ack, &ev_cache);
-      ev_cache.commit_to(pblshr);
+      _update_in_batch([this, &ack](io::stream* visitor) {
+        _applier.book_service().update(ack, visitor);
+      });
     } break;
     case neb::downtime::static_type(): {
       std::shared_ptr<neb::downtime> dt(
@@ -467,10 +467,9 @@ int monitoring_stream::write(const std::shared_ptr<io::data>& data) {
           "stopped: {}",
           dt->internal_id, dt->host_id, dt->service_id, dt->was_started,
           dt->was_cancelled);
-      multiplexing::publisher pblshr;
-      event_cache_visitor ev_cache;
-      _applier.book_service().update(dt, &ev_cache);
-      ev_cache.commit_to(pblshr);
+      _update_in_batch([this, &dt](io::stream* visitor) {
+        _applier.book_service().update(dt, visitor);
+      });
     } break;
     case neb::pb_downtime::static_type(): {
       std::shared_ptr<neb::pb_downtime> dt(
@@ -483,10 +482,9 @@ int monitoring_stream::write(const std::shared_ptr<io::data>& data) {
                           downtime.id(), downtime.host_id(),
                           downtime.service_id(), downtime.started(),
                           downtime.cancelled());
-      multiplexing::publisher pblshr;
-      event_cache_visitor ev_cache;
-      _applier.book_service().update(dt, &ev_cache);
-      ev_cache.commit_to(pblshr);
+      _update_in_batch([this, &dt](io::stream* visitor) {
+        _applier.book_service().update(dt, visitor);
+      });
     } break;
     case bam::ba_status::static_type(): {
       ba_status* status(static_cast<ba_status*>(data.get()));
@@ -594,6 +592,7 @@ int monitoring_stream::write(const std::shared_ptr<io::data>& data) {
     } break;
     case extcmd::pb_ba_info::static_type(): {
       _logger->info("BAM: dump BA");
+      _commit_batch();
       extcmd::pb_ba_info const& e =
           *std::static_pointer_cast<const extcmd::pb_ba_info>(data);
       auto& obj = e.obj();
@@ -609,8 +608,11 @@ int monitoring_stream::write(const std::shared_ptr<io::data>& data) {
       break;
   }
 
-  // if uncommited request, we can't yet acknowledge
-  if (_pending_request) {
+  if (_batched_events >= max_batched_events)
+    _commit_batch();
+
+  // if uncommited request or changes not computed, we can't yet acknowledge
+  if (_pending_request || _changes) {
     if (_pending_events >= 10 * _conf_queries_per_transaction) {
       _logger->trace(
           "BAM: monitoring_stream write: too many pending events =>flush and "
@@ -630,6 +632,48 @@ int monitoring_stream::write(const std::shared_ptr<io::data>& data) {
   return retval;
 }
 
+/**
+ *  Apply an update to the BA tree in the batch of changes, the batch is
+ *  opened if needed.
+ *
+ *  @param[in] update  The update, called with the visitor of the batch.
+ */
+void monitoring_stream::_update_in_batch(
+    const std::function<void(io::stream*)>& update) {
+  if (!_changes) {
+    _ev_cache = std::make_unique<event_cache_visitor>();
+    _changes = std::make_unique<computable::batch>(_ev_cache.get());
+  } else
+    _changes->resume();
+  ++_batched_events;
+  try {
+    update(_ev_cache.get());
+  } catch (...) {
+    _changes->suspend();
+    throw;
+  }
+  _changes->suspend();
+}
+
+/**
+ *  Compute the BAs impacted by the batch of changes and publish the events
+ *  they produced.
+ */
+void monitoring_stream::_commit_batch() {
+  if (!_changes)
+    return;
+  SPDLOG_LOGGER_TRACE(_logger, "BAM: commit of {} changes from {} events",
+                      _changes->size(), _batched_events);
+  std::unique_ptr<computable::batch> changes = std::move(_changes);
+  std::unique_ptr<event_cache_visitor> ev_cache = std::move(_ev_cache);
+  _batched_events = 0;
+  changes->resume();
+  changes->commit();
+  changes.reset();
+  multiplexing::publisher pblshr;
+  ev_cache->commit_to(pblshr);
+}
+
 /**
  *  Prepare bulk queries.
  */
@@ -2065,11 +2065,14 @@ void reporting_stream::_process_pb_dimension_ba_timeperiod_relation(
  *  The event durations are computed from the associated timeperiods of the
  * BA.
  *
- *  @param[in] ev       The ba_event generating the durations.
- *  @param[in] visitor  A visitor stream.
+ *  @param[in] ev         The ba_event generating the durations.
+ *  @param[in] visitor    A visitor stream.
+ *  @param[out] computed  If not null, the durations written are appended.
  */
-void reporting_stream::_compute_event_durations(const BaEvent& ev,
-                                                io::stream* visitor) {
+void reporting_stream::_compute_event_durations(
+    const BaEvent& ev,
+    io::stream* visitor,
+    std::vector<BaDurationEvent>* computed) {
   if (!visitor)
     return;
 
@@ -2120,6 +2123,8 @@ void reporting_stream::_compute_event_durations(const BaEvent& ev,
           "{}",
           ev.start_time(), ev.end_time(), ev.ba_id(), tp->get_name(),
           dur_ev.duration(), dur_ev.sla_duration());
+      if (computed)
+        computed->push_back(dur_ev);
       visitor->write(to_write);
     } else
       SPDLOG_LOGGER_DEBUG(
@@ -2144,11 +2149,67 @@ void reporting_stream::_process_rebuild(std::shared_ptr<io::data> const& e) {
 
   _update_status("rebuilding: querying ba events");
 
+  // The days to recompute by the availability thread, those covered by the
+  // events whose durations changed and by the opened events.
+  availability_thread::affected_periods affected;
+
   // We block the availability thread to prevent it waking
   // up on truncated event durations.
   try {
     std::lock_guard<availability_thread> lock(*_availabilities);
 
+    // The durations before the rebuild, indexed by (ba_id, real_start_time,
+    // timeperiod_id), to be compared to the new ones.
+    absl::flat_hash_map<std::tuple<uint32_t, time_t, uint32_t>,
+                        std::tuple<time_t, time_t, uint32_t, bool>>
+        old_durations;
+    {
+      std::string query(fmt::format(
+          "SELECT b.ba_id, b.start_time, a.timeperiod_id, a.start_time, "
+          "a.end_time, a.sla_duration, a.timeperiod_is_default FROM "
+          "mod_bam_reporting_ba_events_durations AS a INNER JOIN "
+          "mod_bam_reporting_ba_events AS b ON a.ba_event_id = b.ba_event_id "
+          "WHERE b.ba_id IN ({})",
+          r.bas_to_rebuild));
+      std::promise<mysql_result> promise;
+      std::future<mysql_result> future = promise.get_future();
+      SPDLOG_LOGGER_TRACE(_logger, "reporting_stream: query: '{}'", query);
+      _mysql.run_query_and_get_result(query, std::move(promise));
+      try {
+        mysql_result res(future.get());
+        while (_mysql.fetch_row(res))
+          old_durations.emplace(
+              std::make_tuple(res.value_as_u32(0), res.value_as_i64(1),
+                              res.value_as_u32(2)),
+              std::make_tuple(res.value_as_i64(3), res.value_as_i64(4),
+                              res.value_as_u32(5), res.value_as_bool(6)));
+      } catch (std::exception const& e) {
+        throw msg_fmt("BAM-BI: could not get BA durations of {} : {}",
+                      r.bas_to_rebuild, e.what());
+      }
+    }
+
+    // The opened events have no duration, their days are always recomputed.
+    {
+      std::string query(
+          fmt::format("SELECT ba_id, start_time FROM "
+                      "mod_bam_reporting_ba_events WHERE end_time IS NULL AND "
+                      "ba_id IN ({})",
+                      r.bas_to_rebuild));
+      std::promise<mysql_result> promise;
+      std::future<mysql_result> future = promise.get_future();
+      SPDLOG_LOGGER_TRACE(_logger, "reporting_stream: query: '{}'", query);
+      _mysql.run_query_and_get_result(query, std::move(promise));
+      try {
+        mysql_result res(future.get());
+        while (_mysql.fetch_row(res))
+          affected[res.value_as_u32(0)].emplace_back(res.value_as_i64(1), 0);
+      } catch (std::exception const& e) {
+        throw msg_fmt("BAM-BI: could not get opened BA events of {} : {}",
+                      r.bas_to_rebuild, e.what());
+      }
+    }
+
     // Delete obsolete ba events durations.
     {
       std::string query(
@@ -2200,14 +2261,37 @@ void reporting_stream::_process_rebuild(std::shared_ptr<io::data> const& e) {
     size_t ba_events_curr = 0;
 
     // Generate new ba events durations for each ba events.
+    std::vector<BaDurationEvent> computed;
     {
       for (const auto& ev : ba_events) {
         std::string s(fmt::format("rebuilding: ba event {}/{}",
                                   ba_events_curr++, ba_events_num));
         _update_status(s);
-        _compute_event_durations(ev->obj(), this);
+        _compute_event_durations(ev->obj(), this, &computed);
+      }
+    }
+
+    // The events whose durations are new or changed, then those whose
+    // durations disappeared.
+    for (const BaDurationEvent& d : computed) {
+      auto found = old_durations.find(std::make_tuple(
+          d.ba_id(), static_cast<time_t>(d.real_start_time()),
+          d.timeperiod_id()));
+      if (found != old_durations.end()) {
+        bool same = found->second ==
+                    std::make_tuple(static_cast<time_t>(d.start_time()),
+                                    static_cast<time_t>(d.end_time()),
+                                    d.sla_duration(),
+                                    d.timeperiod_is_default());
+        old_durations.erase(found);
+        if (same)
+          continue;
       }
+      affected[d.ba_id()].emplace_back(d.real_start_time(), d.end_time());
     }
+    for (auto& [key, value] : old_durations)
+      affected[std::get<0>(key)].emplace_back(std::get<1>(key),
+                                              std::get<1>(value));
   } catch (...) {
     _update_status("");
     throw;
@@ -2219,7 +2303,10 @@ void reporting_stream::_process_rebuild(std::shared_ptr<io::data> const& e) {
       "now");
 
   // Ask for the availabilities thread to recompute the availabilities.
-  _availabilities->rebuild_availabilities(r.bas_to_rebuild);
+  SPDLOG_LOGGER_INFO(_logger,
+                     "BAM-BI: availabilities of {} BAs on {} to recompute",
+                     affected.size(), r.bas_to_rebuild);
+  _availabilities->rebuild_availabilities(affected);
 
   _update_status("");
 }
@@ -0,0 +1,86 @@
+/**
+ * Copyright 2025 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+/**
+ * Rebuild of the daily availabilities of BAs with one event per hour, as the
+ * availability thread does it, once for all the days and once for a single
+ * affected day per BA.
+
+ ./bam-availability-bench [BAs] [days]
+
+ Default is 2000 BAs during 365 days.
+*/
+#include <fmt/format.h>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+#include "com/centreon/broker/bam/availability_thread.hh"
+#include "com/centreon/broker/misc/time.hh"
+#include "common/log_v2/log_v2.hh"
+
+using namespace com::centreon::broker;
+using com::centreon::common::log_v2::log_v2;
+
+int main(int argc, char** argv) {
+  uint32_t ba_count = argc > 1 ? std::atoi(argv[1]) : 2000;
+  uint32_t day_count = argc > 2 ? std::atoi(argv[2]) : 365;
+
+  log_v2::load("bam-availability-bench");
+  std::shared_ptr<spdlog::logger> logger = log_v2::instance().get(log_v2::BAM);
+  auto tp = std::make_shared<time::timeperiod>(
+      1, "24x7", "24x7", "00:00-24:00", "00:00-24:00", "00:00-24:00",
+      "00:00-24:00", "00:00-24:00", "00:00-24:00", "00:00-24:00");
+
+  std::vector<time_t> days{misc::start_of_day(1609459200)};
+  for (uint32_t i = 0; i < day_count; ++i)
+    days.push_back(
+        time::timeperiod::add_round_days_to_midnight(days.back(), 3600 * 24));
+
+  bam::availability_thread::ba_events events;
+  bam::availability_thread::affected_periods one_day;
+  for (uint32_t ba_id = 1; ba_id <= ba_count; ++ba_id) {
+    std::vector<bam::availability_thread::ba_event>& v = events[ba_id];
+    v.reserve(day_count * 24);
+    for (time_t t = days.front(); t < days.back(); t += 3600)
+      v.push_back({.status = static_cast<short>((t / 3600 + ba_id) % 3),
+                   .start = t,
+                   .end = t + 3600,
+                   .in_downtime = false,
+                   .tp = tp,
+                   .tp_is_default = true});
+    time_t changed = days[ba_id % day_count] + 3600;
+    one_day[ba_id].emplace_back(changed, changed + 1800);
+  }
+
+  for (auto* affected :
+       {static_cast<bam::availability_thread::affected_periods*>(nullptr),
+        &one_day}) {
+    auto start = std::chrono::steady_clock::now();
+    auto result = bam::availability_thread::compute_availabilities(
+        events, days, logger, affected);
+    auto duration = std::chrono::steady_clock::now() - start;
+    std::cout << fmt::format(
+        "{} BAs on {} days, {}: {} availabilities computed in {}ms\n",
+        ba_count, day_count, affected ? "one affected day" : "full rebuild",
+        result.size(),
+        std::chrono::duration_cast<std::chrono::milliseconds>(duration)
+            .count());
+  }
+  return 0;
+}
@@ -0,0 +1,154 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "com/centreon/broker/bam/availability_thread.hh"
+#include "com/centreon/broker/misc/time.hh"
+#include "common/log_v2/log_v2.hh"
+
+using namespace com::centreon::broker;
+using com::centreon::common::log_v2::log_v2;
+
+class BamAvailabilityThread : public ::testing::Test {
+ protected:
+  std::shared_ptr<spdlog::logger> _logger;
+  time::timeperiod::ptr _tp;
+
+ public:
+  void SetUp() override {
+    _logger = log_v2::instance().get(log_v2::BAM);
+    _tp = std::make_shared<time::timeperiod>(
+        1, "24x7", "24x7", "00:00-24:00", "00:00-24:00", "00:00-24:00",
+        "00:00-24:00", "00:00-24:00", "00:00-24:00", "00:00-24:00");
+  }
+
+  /**
+   * @brief The boundaries of count days starting at first_day.
+   */
+  static std::vector<time_t> days(time_t first_day, uint32_t count) {
+    std::vector<time_t> retval{first_day};
+    for (uint32_t i = 0; i < count; ++i)
+      retval.push_back(time::timeperiod::add_round_days_to_midnight(
+          retval.back(), 3600 * 24));
+    return retval;
+  }
+};
+
+/**
+ * An event over three days gives one availability per day, the middle day
+ * being fully available.
+ */
+TEST_F(BamAvailabilityThread, EventOverSeveralDays) {
+  std::vector<time_t> d = days(misc::start_of_day(1617023058), 4);
+  bam::availability_thread::ba_events events;
+  events[12].push_back({.status = 0,
+                        .start = d[0] + 3600,
+                        .end = d[2] + 3600,
+                        .in_downtime = false,
+                        .tp = _tp,
+                        .tp_is_default = true});
+
+  auto result = bam::availability_thread::compute_availabilities(events, d,
+                                                                 _logger);
+  ASSERT_EQ(result.size(), 3u);
+  std::sort(result.begin(), result.end(),
+            [](const auto& a, const auto& b) { return a.time_id < b.time_id; });
+  ASSERT_EQ(result[0].time_id, d[0]);
+  ASSERT_EQ(result[0].available, d[1] - d[0] - 3600);
+  ASSERT_EQ(result[0].ba_id, 12u);
+  ASSERT_TRUE(result[0].timeperiod_is_default);
+  ASSERT_EQ(result[1].available, d[2] - d[1]);
+  ASSERT_EQ(result[2].available, 3600);
+}
+
+/**
+ * An opened critical event concerns all the days until the last one and is
+ * counted as opened only the day it starts.
+ */
+TEST_F(BamAvailabilityThread, OpenedEvent) {
+  std::vector<time_t> d = days(misc::start_of_day(1617023058), 3);
+  bam::availability_thread::ba_events events;
+  events[3].push_back({.status = 2,
+                       .start = d[1] - 60,
+                       .end = 0,
+                       .in_downtime = false,
+                       .tp = _tp,
+                       .tp_is_default = false});
+
+  auto result = bam::availability_thread::compute_availabilities(events, d,
+                                                                 _logger);
+  ASSERT_EQ(result.size(), 3u);
+  std::sort(result.begin(), result.end(),
+            [](const auto& a, const auto& b) { return a.time_id < b.time_id; });
+  ASSERT_EQ(result[0].unavailable, 60);
+  ASSERT_EQ(result[0].alert_unavailable_opened, 1);
+  ASSERT_EQ(result[1].unavailable, d[2] - d[1]);
+  ASSERT_EQ(result[1].alert_unavailable_opened, 0);
+  ASSERT_EQ(result[2].unavailable, d[3] - d[2]);
+}
+
+/**
+ * With affected intervals, only the days they cover are computed, and the
+ * BAs without interval are skipped.
+ */
+TEST_F(BamAvailabilityThread, OnlyAffectedDays) {
+  std::vector<time_t> d = days(misc::start_of_day(1617023058), 4);
+  bam::availability_thread::ba_events events;
+  for (uint32_t ba_id : {1, 2})
+    events[ba_id].push_back({.status = 0,
+                             .start = d[0],
+                             .end = d[4],
+                             .in_downtime = false,
+                             .tp = _tp,
+                             .tp_is_default = true});
+  bam::availability_thread::affected_periods affected;
+  affected[1].emplace_back(d[1] + 60, d[1] + 120);
+
+  auto result = bam::availability_thread::compute_availabilities(
+      events, d, _logger, &affected);
+  ASSERT_EQ(result.size(), 1u);
+  ASSERT_EQ(result[0].ba_id, 1u);
+  ASSERT_EQ(result[0].time_id, d[1]);
+  ASSERT_EQ(result[0].available, d[2] - d[1]);
+}
+
+/**
+ * The valid ranges of a timeperiod give the same durations as
+ * duration_intersect().
+ */
+TEST_F(BamAvailabilityThread, ValidRanges) {
+  auto tp = std::make_shared<time::timeperiod>(
+      2, "office", "office", "", "08:00-12:00,14:00-18:00",
+      "08:00-12:00,14:00-18:00", "08:00-12:00,14:00-18:00",
+      "08:00-12:00,14:00-18:00", "08:00-12:00,14:00-18:00", "");
+  std::vector<time_t> d = days(misc::start_of_day(1617023058), 7);
+  for (size_t i = 0; i + 1 < d.size(); ++i) {
+    auto ranges =
+        bam::availability_builder::compute_valid_ranges(*tp, d[i], d[i + 1]);
+    for (time_t start = d[i]; start < d[i + 1]; start += 3 * 3600 + 17) {
+      time_t end = std::min(start + 5 * 3600, d[i + 1]);
+      bam::availability_builder from_tp(d[i + 1], d[i]);
+      from_tp.add_event(0, start, end, false, tp, _logger);
+      bam::availability_builder from_ranges(d[i + 1], d[i]);
+      from_ranges.add_event(0, start, end, false, ranges, _logger);
+      ASSERT_EQ(from_ranges.get_available(), from_tp.get_available());
+    }
+  }
+}
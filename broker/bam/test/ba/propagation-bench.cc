@@ -0,0 +1,88 @@
+/**
+ * Copyright 2025 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+/**
+ * Propagation of KPI changes in the tree of the BamPropagation tests: BAs
+ * under a top BA, each one with a KPI service. All the KPIs become critical,
+ * once without batch (the top BA is computed for each of them) and once in
+ * a single batch (each BA is computed once).
+
+ ./bam-propagation-bench [BAs]
+
+ Default is 10000 BAs.
+*/
+#include <fmt/format.h>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+
+#include "com/centreon/broker/bam/computable.hh"
+#include "com/centreon/broker/config/applier/init.hh"
+
+#include "ba/propagation.hh"
+
+using namespace com::centreon::broker;
+using com::centreon::common::log_v2::log_v2;
+
+class propagation_bench : public propagation_tree {
+ public:
+  /**
+   * @brief Build the tree, make all its KPIs critical and print the
+   * duration.
+   *
+   * @param count The number of BAs under the top one.
+   * @param with_batch true to propagate the changes in one batch.
+   *
+   * @return true if the top BA is critical and computed as expected.
+   */
+  bool run(uint32_t count, bool with_batch) {
+    build(count);
+    status_counter visitor;
+    auto start = std::chrono::steady_clock::now();
+    if (with_batch) {
+      bam::computable::batch changes(&visitor);
+      make_critical(&visitor);
+      changes.commit();
+    } else
+      make_critical(&visitor);
+    auto duration = std::chrono::steady_clock::now() - start;
+    std::cout << fmt::format(
+        "{} BAs, {}: {} BA statuses ({} of the top BA) in {}ms\n", count,
+        with_batch ? "one batch" : "no batch", visitor.order().size(),
+        visitor.ba_status_count(1),
+        std::chrono::duration_cast<std::chrono::milliseconds>(duration)
+            .count());
+    bool ok = _top_ba->get_state_hard() == bam::state_critical &&
+              visitor.ba_status_count(1) == (with_batch ? 1u : count);
+    clear();
+    return ok;
+  }
+};
+
+int main(int argc, char** argv) {
+  uint32_t ba_count = argc > 1 ? std::atoi(argv[1]) : 10000;
+
+  log_v2::load("bam-propagation-bench");
+  config::applier::init(com::centreon::common::BROKER, 0,
+                        "bam-propagation-bench", 0);
+  propagation_bench bench;
+  bool ok = bench.run(ba_count, false);
+  ok = bench.run(ba_count, true) && ok;
+  config::applier::deinit();
+  return ok ? 0 : 1;
+}
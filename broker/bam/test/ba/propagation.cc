@@ -0,0 +1,123 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include <gtest/gtest.h>
+
+#include "com/centreon/broker/bam/computable.hh"
+#include "com/centreon/broker/config/applier/init.hh"
+
+#include "ba/propagation.hh"
+
+using namespace com::centreon::broker;
+
+class BamPropagation : public ::testing::Test, public propagation_tree {
+ public:
+  void SetUp() override {
+    config::applier::init(com::centreon::common::BROKER, 0, "test_broker", 0);
+  }
+
+  void TearDown() override {
+    clear();
+    config::applier::deinit();
+  }
+};
+
+/**
+ * Without batch, the top BA is computed each time one of its KPIs changes.
+ */
+TEST_F(BamPropagation, WithoutBatch) {
+  build(100);
+  status_counter visitor;
+  make_critical(&visitor);
+
+  ASSERT_EQ(_top_ba->get_state_hard(), bam::state_critical);
+  ASSERT_EQ(visitor.ba_status_count(1), 100u);
+  for (uint32_t i = 0; i < 100; ++i)
+    ASSERT_EQ(visitor.ba_status_count(i + 2), 1u);
+}
+
+/**
+ * With a batch, each BA is computed once, after all its children, and the
+ * result is the same as without batch.
+ */
+TEST_F(BamPropagation, WithBatch) {
+  build(100);
+  status_counter visitor;
+  {
+    bam::computable::batch changes(&visitor);
+    make_critical(&visitor);
+    /* The 100 BAs are dirty, nothing has been computed yet. */
+    ASSERT_EQ(changes.size(), 100u);
+    ASSERT_EQ(visitor.ba_status_count(1), 0u);
+    changes.commit();
+    ASSERT_EQ(changes.size(), 0u);
+  }
+
+  ASSERT_EQ(_top_ba->get_state_hard(), bam::state_critical);
+  ASSERT_EQ(visitor.ba_status_count(1), 1u);
+  for (uint32_t i = 0; i < 100; ++i)
+    ASSERT_EQ(visitor.ba_status_count(i + 2), 1u);
+  /* The top BA is the last one computed. */
+  ASSERT_EQ(visitor.order().back(), 1u);
+}
+
+/**
+ * The top BA has rank 0, its kpi_ba 1, the BA below 2 and so on.
+ */
+TEST_F(BamPropagation, Rank) {
+  build(2);
+  ASSERT_EQ(_top_ba->rank(), 0u);
+  ASSERT_EQ(_kpi_bas[0]->rank(), 1u);
+  ASSERT_EQ(_bas[1]->rank(), 2u);
+  ASSERT_EQ(_kpis[0]->rank(), 3u);
+
+  _kpi_bas[0]->remove_parent(_top_ba);
+  ASSERT_EQ(_kpi_bas[0]->rank(), 0u);
+  ASSERT_EQ(_kpis[0]->rank(), 2u);
+  ASSERT_EQ(_kpis[1]->rank(), 3u);
+}
+
+/**
+ * A suspended batch does not collect the changes, they are propagated right
+ * away. Once resumed, it collects them again.
+ */
+TEST_F(BamPropagation, SuspendedBatch) {
+  build(2);
+  status_counter visitor;
+  bam::computable::batch changes(&visitor);
+  changes.suspend();
+  time_t now = time(nullptr);
+  auto ss = std::make_shared<neb::service_status>();
+  ss->host_id = 2;
+  ss->last_check = now;
+  ss->last_hard_state = bam::state_critical;
+  ss->current_state = ss->last_hard_state;
+  ss->service_id = 1;
+  _kpis[0]->service_update(ss, &visitor);
+  ASSERT_EQ(changes.size(), 0u);
+  ASSERT_EQ(visitor.ba_status_count(2), 1u);
+
+  changes.resume();
+  ss->service_id = 2;
+  _kpis[1]->service_update(ss, &visitor);
+  ASSERT_EQ(changes.size(), 1u);
+  ASSERT_EQ(visitor.ba_status_count(3), 0u);
+  changes.commit();
+  ASSERT_EQ(visitor.ba_status_count(3), 1u);
+  ASSERT_EQ(_top_ba->get_state_hard(), bam::state_critical);
+}
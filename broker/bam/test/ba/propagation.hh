@@ -0,0 +1,155 @@
+/**
+ * Copyright 2025 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCB_BAM_TEST_PROPAGATION_HH
+#define CCB_BAM_TEST_PROPAGATION_HH
+
+#include <fmt/format.h>
+
+#include "com/centreon/broker/bam/ba_worst.hh"
+#include "com/centreon/broker/bam/internal.hh"
+#include "com/centreon/broker/bam/kpi_ba.hh"
+#include "com/centreon/broker/bam/kpi_service.hh"
+#include "com/centreon/broker/neb/service_status.hh"
+#include "common/log_v2/log_v2.hh"
+
+namespace com::centreon::broker {
+
+/**
+ * A visitor that just counts the BA statuses it receives.
+ */
+class status_counter : public io::stream {
+  absl::flat_hash_map<uint32_t, uint32_t> _ba_status;
+  std::vector<uint32_t> _order;
+
+ public:
+  status_counter() : io::stream("status-counter") {}
+  int32_t stop() override { return 0; }
+  bool read(std::shared_ptr<io::data>& d [[maybe_unused]],
+            time_t deadline [[maybe_unused]]) override {
+    return true;
+  }
+  int32_t write(const std::shared_ptr<io::data>& d) override {
+    if (d->type() == bam::pb_ba_status::static_type()) {
+      uint32_t ba_id =
+          std::static_pointer_cast<bam::pb_ba_status>(d)->obj().ba_id();
+      ++_ba_status[ba_id];
+      _order.push_back(ba_id);
+    }
+    return 1;
+  }
+  uint32_t ba_status_count(uint32_t ba_id) const {
+    auto found = _ba_status.find(ba_id);
+    return found == _ba_status.end() ? 0 : found->second;
+  }
+  const std::vector<uint32_t>& order() const { return _order; }
+};
+
+/**
+ * The tree of BAs used by the propagation tests and by
+ * bam-propagation-bench.
+ */
+class propagation_tree {
+ protected:
+  std::shared_ptr<spdlog::logger> _logger;
+  std::shared_ptr<bam::ba> _top_ba;
+  std::vector<std::shared_ptr<bam::ba>> _bas;
+  std::vector<std::shared_ptr<bam::kpi_ba>> _kpi_bas;
+  std::vector<std::shared_ptr<bam::kpi_service>> _kpis;
+
+ public:
+  propagation_tree()
+      : _logger(common::log_v2::log_v2::instance().get(
+            common::log_v2::log_v2::BAM)) {}
+
+  void clear() {
+    _kpis.clear();
+    _kpi_bas.clear();
+    _bas.clear();
+    _top_ba.reset();
+  }
+
+  /**
+   * @brief Build the following tree:
+   *
+   *                         top BA (1)
+   *                /            |              \
+   *        kpi_ba         kpi_ba          ...   kpi_ba
+   *          |              |                     |
+   *        BA (2)         BA (3)          ...   BA (count + 1)
+   *          |              |                     |
+   *    kpi_service    kpi_service         ...   kpi_service
+   *
+   * @param count The number of BAs under the top one.
+   */
+  void build(uint32_t count) {
+    _top_ba = std::make_shared<bam::ba_worst>(1, 1, 1, false, _logger);
+    _top_ba->set_name("top-ba");
+    for (uint32_t i = 0; i < count; ++i) {
+      uint32_t ba_id = i + 2;
+      std::shared_ptr<bam::ba> b =
+          std::make_shared<bam::ba_worst>(ba_id, 1, ba_id, false, _logger);
+      b->set_name(fmt::format("ba-{}", ba_id));
+
+      auto s = std::make_shared<bam::kpi_service>(
+          i + 1, ba_id, 2, i + 1, fmt::format("host_2/serv_{}", i + 1),
+          _logger);
+      s->set_impact_critical(100);
+      s->set_impact_warning(75);
+      s->set_state_hard(bam::state_ok);
+      s->set_state_soft(s->get_state_hard());
+      b->add_impact(s);
+      s->add_parent(b);
+
+      auto k = std::make_shared<bam::kpi_ba>(count + i + 1, ba_id,
+                                             b->get_name(), _logger);
+      k->set_impact_critical(100);
+      k->set_impact_warning(75);
+      k->link_ba(b);
+      b->add_parent(k);
+      _top_ba->add_impact(k);
+      k->add_parent(_top_ba);
+
+      _bas.push_back(std::move(b));
+      _kpi_bas.push_back(std::move(k));
+      _kpis.push_back(std::move(s));
+    }
+  }
+
+  /**
+   * @brief Make each KPI service critical.
+   *
+   * @param visitor The visitor receiving the events.
+   */
+  void make_critical(io::stream* visitor) {
+    time_t now = time(nullptr);
+    auto ss = std::make_shared<neb::service_status>();
+    ss->host_id = 2;
+    ss->last_check = now;
+    ss->last_hard_state = bam::state_critical;
+    ss->current_state = ss->last_hard_state;
+    for (uint32_t i = 0; i < _kpis.size(); ++i) {
+      ss->service_id = i + 1;
+      _kpis[i]->service_update(ss, visitor);
+    }
+  }
+};
+
+}  // namespace com::centreon::broker
+
+#endif  // !CCB_BAM_TEST_PROPAGATION_HH
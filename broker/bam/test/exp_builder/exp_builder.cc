@@ -22,6 +22,7 @@
 #include "bbdo/neb.pb.h"
 #include "com/centreon/broker/bam/ba_impact.hh"
 #include "com/centreon/broker/bam/bool_expression.hh"
+#include "com/centreon/broker/bam/bool_program.hh"
 #include "com/centreon/broker/bam/bool_value.hh"
 #include "com/centreon/broker/bam/exp_parser.hh"
 #include "com/centreon/broker/bam/kpi_boolexp.hh"
@@ -769,6 +770,60 @@ TEST_F(BamExpBuilder, BoolexpServiceXorService) {
   ASSERT_FALSE(b->boolean_value());
 }
 
+/**
+ * The expression is compiled into a single flat program: two services, two
+ * constants, two comparisons and the AND operator.
+ */
+TEST_F(BamExpBuilder, BoolexpProgram) {
+  config::applier::modules modules(_logger);
+  modules.load_file("./broker/lib/10-neb.so");
+  bam::exp_parser p(
+      "({host_1 service_1} {IS} {CRITICAL}) {AND} ({host_1 service_2} {IS} "
+      "{OK})");
+  bam::hst_svc_mapping mapping(_logger);
+  mapping.set_service("host_1", "service_1", 1, 1, true);
+  mapping.set_service("host_1", "service_2", 1, 2, true);
+  bam::exp_builder builder(p.get_postfix(), mapping, _logger);
+  auto b = std::dynamic_pointer_cast<bam::bool_program>(builder.get_tree());
+  ASSERT_TRUE(b);
+  ASSERT_EQ(b->size(), 7u);
+
+  bam::service_book book(_logger);
+  for (auto& svc : builder.get_services()) {
+    book.listen(svc->get_host_id(), svc->get_service_id(), svc.get());
+    /* Services are directly plugged on the program. */
+    ASSERT_EQ(svc->rank(), 1u);
+  }
+
+  auto svc1 = std::make_shared<neb::pb_service_status>();
+  svc1->mut_obj().set_host_id(1);
+  svc1->mut_obj().set_service_id(1);
+  svc1->mut_obj().set_state(ServiceStatus::OK);
+  svc1->mut_obj().set_last_hard_state(ServiceStatus::OK);
+  book.update(svc1);
+
+  /* AND is known as soon as one of its operands is false. */
+  ASSERT_TRUE(b->state_known());
+  ASSERT_FALSE(b->boolean_value());
+
+  svc1->mut_obj().set_state(ServiceStatus::CRITICAL);
+  svc1->mut_obj().set_last_hard_state(ServiceStatus::CRITICAL);
+  book.update(svc1);
+
+  ASSERT_FALSE(b->state_known());
+  ASSERT_FALSE(b->boolean_value());
+
+  auto svc2 = std::make_shared<neb::pb_service_status>();
+  svc2->mut_obj().set_host_id(1);
+  svc2->mut_obj().set_service_id(2);
+  svc2->mut_obj().set_state(ServiceStatus::OK);
+  svc2->mut_obj().set_last_hard_state(ServiceStatus::OK);
+  book.update(svc2);
+
+  ASSERT_TRUE(b->state_known());
+  ASSERT_TRUE(b->boolean_value());
+}
+
 TEST_F(BamExpBuilder, BoolexpLTWithServiceStatus) {
   config::applier::modules modules(_logger);
   modules.load_file("./broker/lib/10-neb.so");
@@ -100,6 +100,7 @@ std::shared_ptr<io::stream> acceptor::open() {
       my_bbdo->set_negotiate(_negotiate);
       my_bbdo->set_timeout(_timeout);
       my_bbdo->set_ack_limit(_ack_limit);
+      my_bbdo->set_relayed(_relayed);
       try {
         my_bbdo->negotiate(bbdo::stream::negotiate_second);
       } catch (const std::exception& e) {
@@ -124,3 +125,13 @@ void acceptor::stats(nlohmann::json& tree) {
   if (_from)
     _from->stats(tree);
 }
+
+/**
+ * @brief Set the types of the events read by the accepted streams that are
+ * only forwarded, and so that are not decoded.
+ *
+ * @param relayed The types of the events to relay.
+ */
+void acceptor::set_relayed(absl::flat_hash_set<uint32_t>&& relayed) {
+  _relayed = std::move(relayed);
+}
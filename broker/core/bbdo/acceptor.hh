@@ -19,6 +19,8 @@
 #ifndef CCB_BBDO_ACCEPTOR_HH
 #define CCB_BBDO_ACCEPTOR_HH
 
+#include <absl/container/flat_hash_set.h>
+
 #include "com/centreon/broker/io/endpoint.hh"
 #include "com/centreon/broker/io/extension.hh"
 
@@ -48,6 +50,7 @@ class acceptor : public io::endpoint {
   uint32_t _ack_limit;
   std::list<std::shared_ptr<io::extension>> _extensions;
   const bool _grpc_serialized;
+  absl::flat_hash_set<uint32_t> _relayed;
 
  public:
   acceptor(std::string name, bool negotiate, time_t timeout,
@@ -61,6 +64,8 @@ class acceptor : public io::endpoint {
   std::shared_ptr<io::stream> open() override;
   void stats(nlohmann::json& tree) override;
   bool is_output() const { return _is_output; }
+  bool accepts_opaque() const override { return true; }
+  void set_relayed(absl::flat_hash_set<uint32_t>&& relayed);
 
  private:
   uint32_t _negotiate_features(std::shared_ptr<io::stream> stream,
@@ -101,6 +101,17 @@ std::shared_ptr<io::stream> connector::_open(
       throw;
     }
     bbdo_stream->set_ack_limit(_ack_limit);
+    bbdo_stream->set_relayed(_relayed);
   }
   return bbdo_stream;
 }
+
+/**
+ * @brief Set the types of the events read by this connector that are only
+ * forwarded, and so that are not decoded.
+ *
+ * @param relayed The types of the events to relay.
+ */
+void connector::set_relayed(absl::flat_hash_set<uint32_t>&& relayed) {
+  _relayed = std::move(relayed);
+}
@@ -19,6 +19,8 @@
 #ifndef CCB_BBDO_CONNECTOR_HH
 #define CCB_BBDO_CONNECTOR_HH
 
+#include <absl/container/flat_hash_set.h>
+
 #include "com/centreon/broker/io/endpoint.hh"
 #include "com/centreon/broker/io/extension.hh"
 
@@ -38,6 +40,7 @@ class connector : public io::endpoint {
   uint32_t _ack_limit;
   std::list<std::shared_ptr<io::extension>> _extensions;
   const bool _grpc_serialized;
+  absl::flat_hash_set<uint32_t> _relayed;
 
   std::shared_ptr<io::stream> _open(std::shared_ptr<io::stream> stream);
 
@@ -50,6 +53,8 @@ class connector : public io::endpoint {
   connector(const connector&) = delete;
   connector& operator=(const connector&) = delete;
   std::shared_ptr<io::stream> open() override;
+  bool accepts_opaque() const override { return true; }
+  void set_relayed(absl::flat_hash_set<uint32_t>&& relayed);
 };
 }  // namespace com::centreon::broker::bbdo
 
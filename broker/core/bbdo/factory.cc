@@ -16,13 +16,16 @@
  * For more information : contact@centreon.com
  */
 
+#include <absl/strings/ascii.h>
 #include <absl/strings/match.h>
+#include <absl/strings/str_split.h>
 
 #include "broker/core/bbdo/acceptor.hh"
 #include "broker/core/bbdo/connector.hh"
 #include "broker/core/bbdo/factory.hh"
 #include "com/centreon/broker/config/applier/state.hh"
 #include "com/centreon/broker/config/parser.hh"
+#include "com/centreon/broker/io/events.hh"
 #include "com/centreon/broker/io/protocols.hh"
 #include "common/log_v2/log_v2.hh"
 
@@ -165,17 +168,23 @@ io::endpoint* factory::new_endpoint(
           "be "
           "set only when the connection is reversed");
 
-    retval = std::make_unique<bbdo::acceptor>(
+    auto a = std::make_unique<bbdo::acceptor>(
         cfg.name, negotiate, cfg.read_timeout, acceptor_is_output, coarse,
         ack_limit, std::move(extensions), grpc_serialized);
+    if (!acceptor_is_output)
+      a->set_relayed(_relayed(cfg));
+    retval = std::move(a);
     if (acceptor_is_output && keep_retention)
       is_acceptor = false;
     logger->debug("BBDO: new acceptor {}", cfg.name);
   } else {
     bool connector_is_input = cfg.get_io_type() == config::endpoint::input;
-    retval = std::make_unique<bbdo::connector>(
+    auto c = std::make_unique<bbdo::connector>(
         negotiate, cfg.read_timeout, connector_is_input, coarse, ack_limit,
         std::move(extensions), grpc_serialized);
+    if (connector_is_input)
+      c->set_relayed(_relayed(cfg));
+    retval = std::move(c);
     logger->debug("BBDO: new connector {}", cfg.name);
   }
   return retval.release();
@@ -208,3 +217,44 @@ std::list<std::shared_ptr<io::extension>> factory::_extensions(
   }
   return retval;
 }
+
+/**
+ *  @brief Get the types of the events that an input only forwards to other
+ *  BBDO outputs. They are given by the 'relay' parameter, a comma separated
+ *  list of categories or events, as in the filters ("neb", "storage",
+ *  "neb:ServiceStatus"...). These events are not decoded by the input, they
+ *  are read as opaque events and written as they were received. Only BBDO
+ *  outputs get them, the muxers of the other outputs reject them (see
+ *  io::endpoint::accepts_opaque()). BBDO, internal and local events are never
+ *  relayed.
+ *
+ *  @param[in] cfg  Endpoint configuration.
+ *
+ *  @return The types of the events to relay.
+ */
+absl::flat_hash_set<uint32_t> factory::_relayed(
+    const config::endpoint& cfg) const {
+  absl::flat_hash_set<uint32_t> retval;
+  auto it = cfg.params.find("relay");
+  if (it == cfg.params.end())
+    return retval;
+
+  auto logger = log_v2::instance().get(log_v2::CORE);
+  for (absl::string_view f :
+       absl::StrSplit(it->second, ',', absl::SkipWhitespace())) {
+    std::string name(absl::StripAsciiWhitespace(f));
+    try {
+      for (auto& e : io::events::instance().get_matching_events(name)) {
+        uint16_t category = e.first >> 16;
+        if (category != io::bbdo && category != io::internal &&
+            category != io::local)
+          retval.insert(e.first);
+      }
+    } catch (const std::exception& e) {
+      logger->error("BBDO: cannot relay '{}': {}", name, e.what());
+    }
+  }
+  logger->info("BBDO: endpoint '{}' relays {} event types without decoding",
+               cfg.name, retval.size());
+  return retval;
+}
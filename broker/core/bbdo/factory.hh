@@ -19,6 +19,8 @@
 #ifndef CCB_BBDO_FACTORY_HH
 #define CCB_BBDO_FACTORY_HH
 
+#include <absl/container/flat_hash_set.h>
+
 #include "com/centreon/broker/io/factory.hh"
 
 namespace com::centreon::broker::bbdo {
@@ -32,6 +34,7 @@ namespace com::centreon::broker::bbdo {
 class factory : public io::factory {
   std::list<std::shared_ptr<io::extension>> _extensions(
       config::endpoint& cfg) const;
+  absl::flat_hash_set<uint32_t> _relayed(const config::endpoint& cfg) const;
 
  public:
   factory() = default;
@@ -48,6 +48,10 @@ using pb_engine_configuration = com::centreon::broker::io::protobuf<
     com::centreon::broker::EngineConfiguration,
     make_type(io::bbdo, bbdo::de_pb_engine_configuration)>;
 
+using pb_trace =
+    com::centreon::broker::io::protobuf<Trace,
+                                        make_type(io::bbdo, bbdo::de_pb_trace)>;
+
 using pb_bench = com::centreon::broker::io::
     protobuf<Bench, make_type(io::extcmd, extcmd::de_pb_bench)>;
 
@@ -26,6 +26,7 @@
 #include "bbdo/bbdo/version_response.hh"
 #include "com/centreon/broker/config/applier/state.hh"
 #include "com/centreon/broker/exceptions/timeout.hh"
+#include "com/centreon/broker/io/opaque.hh"
 #include "com/centreon/broker/io/protocols.hh"
 #include "com/centreon/broker/misc/misc.hh"
 #include "com/centreon/broker/multiplexing/publisher.hh"
@@ -405,9 +406,13 @@ io::raw* stream::serialize(const io::data& e) {
   // Get event info (mapping).
   const io::event_info* info = io::events::instance().get_event_info(e.type());
   if (info) {
+    /* A relayed event already contains its payload. */
+    const io::opaque* relayed =
+        typeid(e) == typeid(io::opaque) ? static_cast<const io::opaque*>(&e)
+                                        : nullptr;
     // Serialize properties of the object.
     const mapping::entry* current_entry = info->get_mapping();
-    if (current_entry) {
+    if (current_entry && !relayed) {
       // Serialization buffer.
       queue.emplace_back(std::vector<char>());
       auto* header = &queue.back();
@@ -491,11 +496,32 @@ io::raw* stream::serialize(const io::data& e) {
           htons(misc::crc16_ccitt(header->data() + 2, BBDO_HEADER_SIZE - 2));
 
     } else {
-      /* Here is the protobuf case: no mapping */
-      std::string r{info->get_operations().serialize(e)};
+      /* Here is the protobuf case: no mapping. The payload is stored in the
+       * event, so it is computed only once even if the event is written to
+       * several streams. The relayed events are also written here, with the
+       * payload they were read with. */
+      std::string serialized;
+      std::shared_ptr<const std::string> encoding;
+      std::string_view r;
+      if (relayed)
+        r = std::string_view(relayed->payload().data(),
+                             relayed->payload().size());
+      else if (const io::protobuf_base* pb =
+                   dynamic_cast<const io::protobuf_base*>(&e)) {
+        encoding = pb->encoded(io::protobuf_base::bbdo_payload,
+                               [info, &e](std::string& payload) {
+                                 payload = info->get_operations().serialize(e);
+                               });
+        r = *encoding;
+      } else {
+        serialized = info->get_operations().serialize(e);
+        r = serialized;
+      }
       size_t size = r.size();
       auto it = r.begin();
-      do {
+      /* The last packet is always shorter than 0xffff, even empty, otherwise
+       * the peer would wait for the end of the event. */
+      for (;;) {
         // Serialization buffer.
         queue.emplace_back(std::vector<char>());
         auto* content = &queue.back();
@@ -526,7 +552,7 @@ io::raw* stream::serialize(const io::data& e) {
           size -= 0xffff;
           it += 0xffff;
         }
-      } while (size > 0);
+      }
     }
 
     // Finalization: concatenation of all the vectors in the queue.
@@ -772,6 +798,7 @@ void stream::negotiate(stream::negotiation_type neg) {
       /* I don't know what I am. */
       else
         obj.set_extended_negotiation(false);
+      obj.set_traces(true);
       _write(welcome);
     }
   }
@@ -809,6 +836,7 @@ void stream::negotiate(stream::negotiation_type neg) {
 
   std::string peer_extensions;
   _extended_negotiation = false;
+  _peer_traces = false;
 
   if (d->type() == version_response::static_type()) {
     std::shared_ptr<version_response> v(
@@ -896,11 +924,13 @@ void stream::negotiate(stream::negotiation_type neg) {
       /* I don't have access to any configuration directory. */
       else
         obj.set_extended_negotiation(false);
+      obj.set_traces(true);
 
       _write(welcome);
       _substream->flush();
     }
     peer_extensions = w->obj().extensions();
+    _peer_traces = w->obj().traces();
     _poller_id = w->obj().poller_id();
     _poller_name = w->obj().poller_name();
     _broker_name = w->obj().broker_name();
@@ -1125,6 +1155,14 @@ void stream::_handle_bbdo_event(const std::shared_ptr<io::data>& d) {
         _write(engine_conf);
       }
     } break;
+    case pb_trace::static_type(): {
+      /* The trace of the next event, it is not acknowledged. */
+      const Trace& t = std::static_pointer_cast<pb_trace>(d)->obj();
+      _pending_trace = std::make_shared<io::trace>();
+      for (int i = 0; i < t.stages_size() && i < t.times_size(); ++i)
+        _pending_trace->add_stamp(static_cast<io::trace::stage>(t.stages(i)),
+                                  t.times(i));
+    } break;
     default:
       break;
   }
@@ -1203,6 +1241,13 @@ bool stream::read(std::shared_ptr<io::data>& d, time_t deadline) {
    *  * an event has been returned but we could not unserialize it.
    */
   if (!timed_out) {
+    if (_pending_trace) {
+      if (d) {
+        _pending_trace->add_stamp(io::trace::bbdo_read);
+        d->trace = std::move(_pending_trace);
+      } else
+        _pending_trace.reset();
+    }
     ++_events_received_since_last_ack;
     SPDLOG_LOGGER_TRACE(_logger, "{} events to acknowledge",
                         _events_received_since_last_ack);
@@ -1352,6 +1397,16 @@ bool stream::_read_any(std::shared_ptr<io::data>& d, time_t deadline) {
 
         // Maybe it is bigger now.
         packet_size = content.size();
+        if (_relayed.contains(event_id)) {
+          /* This event is only forwarded, its payload is kept as is. */
+          d = std::make_shared<io::opaque>(event_id, std::move(content));
+          d->source_id = source_id;
+          d->destination_id = dest_id;
+          SPDLOG_LOGGER_TRACE(_logger,
+                              "relayed {} bytes for event of type {}",
+                              BBDO_HEADER_SIZE + packet_size, event_id);
+          return true;
+        }
         d.reset(unserialize(event_id, source_id, dest_id, pack, packet_size));
         if (d) {
           SPDLOG_LOGGER_TRACE(_logger,
@@ -1469,6 +1524,16 @@ void stream::set_coarse(bool coarse) {
   _coarse = coarse;
 }
 
+/**
+ * @brief Set the types of the events that are relayed without being decoded.
+ * Events of these types are read as io::opaque events.
+ *
+ * @param relayed The types of the events to relay.
+ */
+void stream::set_relayed(const absl::flat_hash_set<uint32_t>& relayed) {
+  _relayed = relayed;
+}
+
 /**
  *  Set whether or not the stream should negotiate features.
  *
@@ -1584,6 +1649,20 @@ void stream::_write(const std::shared_ptr<io::data>& d) {
   if (d->type() == neb::pb_instance::static_type())
     _negotiate_engine_conf();
 
+  /* The trace is sent just before its event. The event may be shared with
+   * other muxers, so the bbdo_write stamp is only added to the copy. */
+  if (d->trace && _peer_traces) {
+    auto t = std::make_shared<pb_trace>();
+    auto& obj = t->mut_obj();
+    for (auto& s : d->trace->stamps()) {
+      obj.add_stages(s.s);
+      obj.add_times(s.time);
+    }
+    obj.add_stages(io::trace::bbdo_write);
+    obj.add_times(io::trace::now());
+    _write(t);
+  }
+
   if (!_grpc_serialized || !std::dynamic_pointer_cast<io::protobuf_base>(d)) {
     std::shared_ptr<io::raw> serialized(serialize(*d));
     if (serialized) {
@@ -19,11 +19,14 @@
 #ifndef CCB_BBDO_STREAM_HH
 #define CCB_BBDO_STREAM_HH
 
+#include <absl/container/flat_hash_set.h>
+
 #include "bbdo/bbdo/bbdo_version.hh"
 #include "bbdo/common.pb.h"
 #include "com/centreon/broker/io/extension.hh"
 #include "com/centreon/broker/io/raw.hh"
 #include "com/centreon/broker/io/stream.hh"
+#include "com/centreon/broker/io/trace.hh"
 
 namespace com::centreon::broker::bbdo {
 /**
@@ -146,6 +149,13 @@ class stream : public io::stream {
    */
   std::deque<std::shared_ptr<io::data>> _grpc_serialized_queue;
 
+  /**
+   * @brief Types of the events read but not decoded: they are only forwarded
+   * to other BBDO outputs, so they are given as io::opaque events whose
+   * payload is written back as is.
+   */
+  absl::flat_hash_set<uint32_t> _relayed;
+
   /**
    * It is possible to mix bbdo stream with others like tls or compression.
    * This list of extensions provides a simple access to others ones with
@@ -176,6 +186,10 @@ class stream : public io::stream {
   bool _extended_negotiation = false;
   /* Type of the peer: used since BBDO 3.0.1 */
   common::PeerType _peer_type = common::UNKNOWN;
+  /* True if the peer understands Trace events, they are only sent then. */
+  bool _peer_traces = false;
+  /* Trace read, waiting for the event it belongs to. */
+  std::shared_ptr<io::trace> _pending_trace;
   /* Currently, this is a hash of the Engine configuration directory. It's
    * filled when neb::pb_instance is sent to Broker. */
   std::string _config_version;
@@ -203,6 +217,7 @@ class stream : public io::stream {
             time_t deadline = (time_t)-1) override;
   void set_ack_limit(uint32_t limit);
   void set_coarse(bool coarse);
+  void set_relayed(const absl::flat_hash_set<uint32_t>& relayed);
   void set_negotiate(bool negotiate);
   void set_timeout(int timeout);
   void statistics(nlohmann::json& tree) const override;
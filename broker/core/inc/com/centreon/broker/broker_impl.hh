@@ -99,6 +99,12 @@ class broker_impl final : public Broker::Service {
                                   const ::google::protobuf::Empty* request
                                   __attribute__((unused)),
                                   ProcessingStats* response) override;
+
+  grpc::Status GetEventLatencyStats(grpc::ServerContext* context
+                                    [[maybe_unused]],
+                                    const ::google::protobuf::Empty* request
+                                    [[maybe_unused]],
+                                    EventLatencyStats* response) override;
   grpc::Status RemovePoller(grpc::ServerContext* context
                             __attribute__((unused)),
                             const GenericNameOrIndex* request,
@@ -51,6 +51,8 @@ class state {
   int _poller_id;
   std::string _poller_name;
   size_t _pool_size;
+  /* One event over _event_trace_sampling is traced, 0 to disable traces. */
+  uint32_t _event_trace_sampling = 0u;
 
   /* The directory where the engine configuration files are stored. This file
    * has a sense only for the cbmod (usual value: /etc/centreon-engine) */
@@ -136,6 +138,8 @@ class state {
   int poller_id() const noexcept;
   void pool_size(int size) noexcept;
   int pool_size() const noexcept;
+  void event_trace_sampling(uint32_t sampling) noexcept;
+  uint32_t event_trace_sampling() const noexcept;
   void poller_name(const std::string& name);
   const std::string& poller_name() const noexcept;
   void set_engine_config_dir(const std::string& dir);
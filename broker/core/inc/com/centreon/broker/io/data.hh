@@ -20,6 +20,8 @@
 #define CCB_IO_DATA_HH
 
 namespace com::centreon::broker::io {
+class trace;
+
 /**
  *  @class data data.hh "com/centreon/broker/io/data.hh"
  *  @brief Data abstraction.
@@ -68,6 +70,8 @@ class data {
 
   uint32_t source_id;
   uint32_t destination_id;
+  /* Only set on sampled events, see io::trace. */
+  std::shared_ptr<io::trace> trace;
 
   static uint32_t broker_id;
 };
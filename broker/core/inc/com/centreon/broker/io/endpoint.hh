@@ -70,6 +70,14 @@ class endpoint {
   virtual bool is_ready() const;
   virtual void stats(nlohmann::json& tree);
 
+  /**
+   * @brief Tell if the streams opened by this endpoint can write the events
+   * relayed without being decoded (io::opaque). Only BBDO streams can.
+   *
+   * @return false by default.
+   */
+  virtual bool accepts_opaque() const { return false; }
+
   /**
    * @brief accessor to the filter wanted by the stream used by this endpoint.
    * This filter is defined by the stream itself and cannot change. It lists
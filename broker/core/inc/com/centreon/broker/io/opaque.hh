@@ -0,0 +1,51 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCB_IO_OPAQUE_HH
+#define CCB_IO_OPAQUE_HH
+
+#include "com/centreon/broker/io/data.hh"
+
+namespace com::centreon::broker::io {
+/**
+ *  @class opaque opaque.hh "com/centreon/broker/io/opaque.hh"
+ *  @brief Event relayed without being decoded.
+ *
+ *  A BBDO input configured as a relay does not unserialize the events it only
+ *  forwards. It gives instead this object, with the type of the event read,
+ *  so that muxer filters work as usual, and its BBDO payload. A BBDO output
+ *  then writes this payload as is.
+ *
+ *  Only a BBDO stream can handle such an event, the content of the event is
+ *  not accessible to other consumers. So the muxers of the other outputs do
+ *  not queue it.
+ */
+class opaque final : public data {
+  std::vector<char> _payload;
+
+ public:
+  opaque(uint32_t type, std::vector<char>&& payload);
+  opaque(const opaque&) = delete;
+  opaque& operator=(const opaque&) = delete;
+  ~opaque() noexcept = default;
+  const std::vector<char>& payload() const { return _payload; }
+  void dump(std::ostream& s) const override;
+};
+}  // namespace com::centreon::broker::io
+
+#endif  // !CCB_IO_OPAQUE_HH
@@ -45,9 +45,27 @@ namespace com::centreon::broker::io {
  *  This class is very important when we want to parse a protobuf message
  *  without knowing about its exact type. This is very useful with reflection
  *  (see code in Lua module for more examples).
+ *
+ *  An event is often written to several streams. So its encodings (the BBDO
+ *  payload, the JSON used by Lua...) can be stored in it by the first stream
+ *  computing them, the other ones just reuse them. They are forgotten as soon
+ *  as the message is accessed as mutable. A stream still using an encoding
+ *  at this time shares its ownership, so it stays valid until it is done.
+ *
+ *  mut_msg() and mut_obj() forget the encodings before the modification, so
+ *  they are only for messages not shared yet. A shared message must be
+ *  modified with modify_msg() or modify(): encodings are forgotten once the
+ *  modification is done, an encoding stored meanwhile can't survive it.
  */
 class protobuf_base : public data {
+ public:
+  enum encoding { bbdo_payload, lua_json, encoding_count };
+
+ private:
   google::protobuf::Message* _msg;
+  /* Only accessed through std::atomic_* functions. */
+  mutable std::array<std::shared_ptr<const std::string>, encoding_count>
+      _encoded;
 
  protected:
   protobuf_base(uint32_t typ, google::protobuf::Message* msg)
@@ -55,6 +73,18 @@ class protobuf_base : public data {
 
   void set_message(google::protobuf::Message* msg) { _msg = msg; }
 
+  /**
+   * @brief Forget the stored encodings. It must be called after any
+   * modification of a shared message.
+   */
+  void clear_encoded() noexcept {
+    for (auto& e : _encoded) {
+      if (std::atomic_load_explicit(&e, std::memory_order_acquire))
+        std::atomic_store_explicit(&e, std::shared_ptr<const std::string>(),
+                                   std::memory_order_release);
+    }
+  }
+
  public:
   enum attribute {
     always_valid = 0,
@@ -62,12 +92,17 @@ class protobuf_base : public data {
     invalid_on_minus_one = (1 << 1)
   };
 
+  ~protobuf_base() noexcept override = default;
+
   /**
    * @brief Accessor to the protobuf::Message* pointer as mutable.
    *
    * @return a google::protobuf::Message* pointer.
    */
-  google::protobuf::Message* mut_msg() { return _msg; }
+  google::protobuf::Message* mut_msg() {
+    clear_encoded();
+    return _msg;
+  }
 
   /**
    * @brief Accessor to the protouf::Message* pointer.
@@ -75,6 +110,47 @@ class protobuf_base : public data {
    * @return a google::protobuf::Message* pointer.
    */
   const google::protobuf::Message* msg() const { return _msg; }
+
+  /**
+   * @brief Modify the message, then forget the stored encodings.
+   *
+   * @param f A function taking the google::protobuf::Message& to modify.
+   */
+  template <typename F>
+  void modify_msg(F&& f) {
+    f(*_msg);
+    clear_encoded();
+  }
+
+  /**
+   * @brief Get an encoding of the message. The first call computes it with
+   * the given function, the following ones return the stored one. Several
+   * threads can call it at the same time, if they all compute the encoding,
+   * only one result is kept. The message can be modified by another thread
+   * meanwhile, the returned encoding stays valid.
+   *
+   * @param e The encoding.
+   * @param encode A function filling the string given as argument.
+   *
+   * @return The encoded message.
+   */
+  template <typename F>
+  std::shared_ptr<const std::string> encoded(encoding e, F&& encode) const {
+    std::shared_ptr<const std::string> retval =
+        std::atomic_load_explicit(&_encoded[e], std::memory_order_acquire);
+    if (!retval) {
+      auto s = std::make_shared<std::string>();
+      encode(*s);
+      std::shared_ptr<const std::string> expected;
+      if (std::atomic_compare_exchange_strong_explicit(
+              &_encoded[e], &expected, std::shared_ptr<const std::string>(s),
+              std::memory_order_acq_rel, std::memory_order_acquire))
+        retval = std::move(s);
+      else
+        retval = std::move(expected);
+    }
+    return retval;
+  }
 };
 
 /**
@@ -126,6 +202,7 @@ class protobuf : public protobuf_base {
 
   protobuf& operator=(const protobuf& to_clone) {
     _obj.CopyFrom(to_clone._obj);
+    clear_encoded();
     return *this;
   }
 
@@ -183,9 +260,30 @@ class protobuf : public protobuf_base {
 
   virtual const T& obj() const { return _obj; }
 
-  virtual T& mut_obj() { return _obj; }
+  /**
+   * @brief Mutable access to a message not shared yet. See modify().
+   */
+  virtual T& mut_obj() {
+    clear_encoded();
+    return _obj;
+  }
+
+  virtual void set_obj(T&& obj) {
+    _obj = std::move(obj);
+    clear_encoded();
+  }
 
-  virtual void set_obj(T&& obj) { _obj = std::move(obj); }
+  /**
+   * @brief Modify the message, then forget the stored encodings. To use when
+   * the event may already be written by other streams.
+   *
+   * @param f A function taking the T& to modify.
+   */
+  template <typename F>
+  void modify(F&& f) {
+    f(_obj);
+    clear_encoded();
+  }
 
   void dump(std::ostream& s) const override;
   void dump_more_detail(std::ostream& s) const override;
@@ -73,6 +73,7 @@ class stream {
   const std::string& get_name() const { return _name; }
 
   virtual bool wait_for_all_events_written(unsigned ms_timeout);
+  virtual bool set_ktls_tx(const std::vector<char>& crypto_info);
 };
 }  // namespace com::centreon::broker::io
 
@@ -0,0 +1,79 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCB_IO_TRACE_HH
+#define CCB_IO_TRACE_HH
+
+namespace com::centreon::broker::io {
+/**
+ *  @class trace trace.hh "com/centreon/broker/io/trace.hh"
+ *  @brief Timestamps collected by a sampled event along its way.
+ *
+ *  One event over N (event_trace_sampling in the configuration) gets a trace
+ *  when it is emitted by the cbmod. The trace is then stamped at each hop:
+ *  muxer enqueue, BBDO write and BBDO read. When an output has committed the
+ *  event, the delays between consecutive stamps are added to the latency
+ *  histograms of the stats center.
+ *
+ *  Stamps are only added while the event has a single owner, that is before
+ *  its publication to the muxers. Then the trace is only read, so it does not
+ *  need to be protected.
+ */
+class trace {
+ public:
+  enum stage : uint32_t {
+    callback = 0,
+    muxer = 1,
+    bbdo_write = 2,
+    bbdo_read = 3,
+  };
+
+  struct stamp {
+    stage s;
+    /* Microseconds since epoch, so that stamps of several hosts can be
+     * compared. */
+    int64_t time;
+  };
+
+  /* A trace cannot grow forever if an event goes through a loop. */
+  static constexpr size_t max_stamps = 16u;
+
+ private:
+  std::vector<stamp> _stamps;
+
+  static std::atomic<uint32_t> _sampling;
+  static std::atomic<uint32_t> _counter;
+
+ public:
+  trace() = default;
+  trace(const trace&) = default;
+  trace& operator=(const trace&) = delete;
+
+  static void set_sampling(uint32_t sampling);
+  static uint32_t sampling();
+  static std::shared_ptr<trace> sample();
+  static int64_t now();
+  static const char* stage_name(uint32_t s);
+
+  void add_stamp(stage s, int64_t time = now());
+  const std::vector<stamp>& stamps() const { return _stamps; }
+  void commit(const std::string& output) const;
+};
+}  // namespace com::centreon::broker::io
+
+#endif  // !CCB_IO_TRACE_HH
@@ -91,6 +91,12 @@ class center {
       ABSL_LOCKS_EXCLUDED(_stats_m);
   void get_processing_stats(ProcessingStats* response)
       ABSL_LOCKS_EXCLUDED(_stats_m);
+  void init_event_latency(uint32_t sampling) ABSL_LOCKS_EXCLUDED(_stats_m);
+  void add_event_latencies(
+      const std::vector<std::pair<std::string, int64_t>>& latencies)
+      ABSL_LOCKS_EXCLUDED(_stats_m);
+  void get_event_latency_stats(EventLatencyStats* response)
+      ABSL_LOCKS_EXCLUDED(_stats_m);
   const BrokerStats& stats() const;
   void lock() ABSL_EXCLUSIVE_LOCK_FUNCTION(_stats_m);
   void unlock() ABSL_UNLOCK_FUNCTION(_stats_m);
@@ -71,6 +71,9 @@ class muxer : public io::stream, public std::enable_shared_from_this<muxer> {
 
   std::shared_ptr<data_handler> _data_handler;
   std::atomic_bool _reader_running = false;
+  /* False if the streams fed by this muxer cannot write the events relayed
+   * without being decoded (io::opaque), they are then not queued. */
+  std::atomic_bool _accepts_opaque = true;
 
   /** Events are stacked into _events or into _file. Because several threads
    * access to them, they are protected by a mutex _events_m. */
@@ -107,6 +110,7 @@ class muxer : public io::stream, public std::enable_shared_from_this<muxer> {
         const muxer_filter& w_filter,
         bool persistent = false);
   void _execute_reader_if_needed();
+  bool _allows(const io::data& event) const;
 
  public:
   static std::string queue_file(const std::string& name);
@@ -143,6 +147,7 @@ class muxer : public io::stream, public std::enable_shared_from_this<muxer> {
   const std::string& name() const;
   void set_read_filter(const muxer_filter& w_filter);
   void set_write_filter(const muxer_filter& w_filter);
+  void set_accepts_opaque(bool accepts);
   void clear_read_handler();
   void unsubscribe();
   void set_action_on_new_data(const std::shared_ptr<data_handler>& handler)
@@ -25,6 +25,7 @@
 
 #include "com/centreon/broker/config/applier/state.hh"
 #include "com/centreon/broker/io/events.hh"
+#include "com/centreon/broker/io/trace.hh"
 #include "com/centreon/broker/misc/misc.hh"
 #include "com/centreon/broker/multiplexing/muxer.hh"
 #include "com/centreon/common/pool.hh"
@@ -101,6 +102,9 @@ void engine::unload() {
  */
 void engine::publish(const std::shared_ptr<io::data>& e) {
   bool have_to_send = false;
+  /* Last stamp before the event is shared between muxers. */
+  if (e->trace)
+    e->trace->add_stamp(io::trace::muxer);
   {
     absl::MutexLock lck(&_kiew_m);
     switch (_state) {
@@ -127,6 +131,9 @@ void engine::publish(const std::shared_ptr<io::data>& e) {
 
 void engine::publish(const std::deque<std::shared_ptr<io::data>>& to_publish) {
   bool have_to_send = false;
+  for (auto& e : to_publish)
+    if (e->trace)
+      e->trace->add_stamp(io::trace::muxer);
   {
     absl::MutexLock lck(&_kiew_m);
     switch (_state) {
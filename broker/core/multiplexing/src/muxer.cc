@@ -24,6 +24,7 @@
 #include "com/centreon/broker/config/applier/state.hh"
 #include "com/centreon/broker/exceptions/shutdown.hh"
 #include "com/centreon/broker/io/events.hh"
+#include "com/centreon/broker/io/opaque.hh"
 #include "com/centreon/broker/misc/misc.hh"
 #include "com/centreon/broker/misc/string.hh"
 #include "com/centreon/common/pool.hh"
@@ -47,11 +48,13 @@ static void add_bench_point(bbdo::pb_bench& event,
                             const char* funct_name)
     ABSL_LOCKS_EXCLUDED(_add_bench_point_m) {
   absl::MutexLock lck(&_add_bench_point_m);
-  com::centreon::broker::TimePoint* muxer_tp = event.mut_obj().add_points();
-  muxer_tp->set_name(muxer_name);
-  muxer_tp->set_function(funct_name);
-  com::centreon::common::time_point_to_google_ts(
-      std::chrono::system_clock::now(), *muxer_tp->mutable_time());
+  event.modify([&muxer_name, funct_name](com::centreon::broker::Bench& obj) {
+    com::centreon::broker::TimePoint* muxer_tp = obj.add_points();
+    muxer_tp->set_name(muxer_name);
+    muxer_tp->set_function(funct_name);
+    com::centreon::common::time_point_to_google_ts(
+        std::chrono::system_clock::now(), *muxer_tp->mutable_time());
+  });
 }
 
 uint32_t muxer::_event_queue_max_size = std::numeric_limits<uint32_t>::max();
@@ -363,7 +366,7 @@ void muxer::publish(const std::deque<std::shared_ptr<io::data>>& event_queue) {
       for (; evt != event_queue.end() && _events_size < event_queue_max_size();
            ++evt) {
         auto event = *evt;
-        if (!_write_filter.allows(event->type())) {
+        if (!_allows(*event)) {
           SPDLOG_LOGGER_TRACE(_logger,
                               "muxer {} event {} rejected by write filter",
                               _name, *event);
@@ -404,7 +407,7 @@ void muxer::publish(const std::deque<std::shared_ptr<io::data>>& event_queue) {
     absl::MutexLock lck(&_events_m);
     for (; evt != event_queue.end(); ++evt) {
       auto event = *evt;
-      if (!_write_filter.allows(event->type())) {
+      if (!_allows(*event)) {
         SPDLOG_LOGGER_TRACE(
             _logger, "muxer {} event of type {:x} rejected by write filter",
             _name, event->type());
@@ -780,6 +783,32 @@ void muxer::set_write_filter(const muxer_filter& w_filter) {
   _write_filters_str = misc::dump_filters(w_filter);
 }
 
+/**
+ * @brief Tell if the streams fed by this muxer can write the events relayed
+ * by a BBDO input without being decoded (io::opaque). If not, these events
+ * are rejected as if they were not in the write filter.
+ *
+ * @param accepts true if they can.
+ */
+void muxer::set_accepts_opaque(bool accepts) {
+  _logger->trace("multiplexing: '{}' {} relayed events", _name,
+                 accepts ? "accepts" : "rejects");
+  _accepts_opaque = accepts;
+}
+
+/**
+ * @brief Check an event against the write filter. Relayed events are also
+ * rejected if the streams fed by this muxer cannot write them.
+ *
+ * @param event The event to publish.
+ *
+ * @return true if the event is to be queued.
+ */
+bool muxer::_allows(const io::data& event) const {
+  return _write_filter.allows(event.type()) &&
+         (_accepts_opaque || typeid(event) != typeid(io::opaque));
+}
+
 /**
  * @brief Unsubscribe this muxer from the parent engine.
  */
@@ -114,7 +114,8 @@ class mysql_error {
     update_services_enabled = 78,
     update_hosts_resources_enabled = 79,
     update_services_resources_enabled = 80,
-    insert_update_agent_information = 81
+    insert_update_agent_information = 81,
+    insert_metrics = 82
   };
 
   static constexpr const char* msg[]{
@@ -200,7 +201,8 @@ class mysql_error {
       "could not update the enabled flag in services table: ",
       "could not update the enabled flag in resources table for host: ",
       "could not update the enabled flag in resources table for service: ",
-      "could not insert or update agent_information table: "};
+      "could not insert or update agent_information table: ",
+      "could not insert metrics: "};
 
   mysql_error() : _active(false) {}
   mysql_error(mysql_error const& other) = delete;
@@ -304,6 +304,15 @@ grpc::Status broker_impl::GetProcessingStats(
   return grpc::Status::OK;
 }
 
+grpc::Status broker_impl::GetEventLatencyStats(
+    grpc::ServerContext* context [[maybe_unused]],
+    const ::google::protobuf::Empty* request [[maybe_unused]],
+    EventLatencyStats* response) {
+  config::applier::state::instance().center()->get_event_latency_stats(
+      response);
+  return grpc::Status::OK;
+}
+
 grpc::Status broker_impl::RemovePoller(grpc::ServerContext* context
                                        [[maybe_unused]],
                                        const GenericNameOrIndex* request,
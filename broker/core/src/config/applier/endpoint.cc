@@ -227,6 +227,9 @@ void endpoint::apply(std::list<config::endpoint> const& endpoints,
         auto mux = multiplexing::muxer::create(
             ep.name, multiplexing::engine::instance_ptr(), r_filter, w_filter,
             true);
+        /* Events relayed by a BBDO input are only given to BBDO outputs, the
+         * failovers may change it. */
+        mux->set_accepts_opaque(e->accepts_opaque());
         endp.reset(_create_failover(ep, global_params, mux, e, endp_to_create));
       }
       {
@@ -408,6 +411,8 @@ processing::failover* endpoint::_create_failover(
             "endpoint applier: cannot allow acceptor '{}' as failover for "
             "endpoint '{}'",
             front_failover, cfg.name);
+      if (!e->accepts_opaque())
+        mux->set_accepts_opaque(false);
       failovr = std::shared_ptr<processing::failover>(
           _create_failover(*it, global_params, mux, e, l));
 
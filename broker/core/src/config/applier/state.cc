@@ -22,6 +22,7 @@
 #include <fmt/format.h>
 
 #include "com/centreon/broker/config/applier/endpoint.hh"
+#include "com/centreon/broker/io/trace.hh"
 #include "com/centreon/broker/vars.hh"
 #include "com/centreon/exceptions/msg_fmt.hh"
 #include "common.pb.h"
@@ -118,6 +119,10 @@ void state::apply(const com::centreon::broker::config::state& s, bool run_mux) {
   // Thread pool size.
   _pool_size = s.pool_size();
 
+  // Event traces.
+  io::trace::set_sampling(s.event_trace_sampling());
+  _center->init_event_latency(s.event_trace_sampling());
+
   // Set cache directory.
   std::filesystem::path cache_dir;
   if (s.cache_directory().empty())
@@ -293,6 +293,10 @@ state parser::parse(std::string const& file) {
           auto eqts = check_and_read<uint64_t>(json_document["centreonBroker"],
                                                "event_queues_total_size");
           retval.event_queues_total_size(eqts.value());
+        } else if (it.key() == "event_trace_sampling") {
+          auto sampling = check_and_read<uint32_t>(
+              json_document["centreonBroker"], "event_trace_sampling");
+          retval.event_trace_sampling(sampling.value());
         } else if (it.key() == "output") {
           if (it.value().is_array()) {
             for (const json& node : it.value()) {
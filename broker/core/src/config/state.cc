@@ -67,6 +67,7 @@ state::state(const state& other)
       _poller_id(other._poller_id),
       _poller_name(other._poller_name),
       _pool_size(other._pool_size),
+      _event_trace_sampling(other._event_trace_sampling),
       _log_conf(other._log_conf) {}
 
 /**
@@ -98,6 +99,7 @@ state& state::operator=(state const& other) {
     _poller_id = other._poller_id;
     _poller_name = other._poller_name;
     _pool_size = other._pool_size;
+    _event_trace_sampling = other._event_trace_sampling;
   }
   return *this;
 }
@@ -121,6 +123,7 @@ void state::clear() {
   _poller_id = 0;
   _poller_name.clear();
   _pool_size = 0;
+  _event_trace_sampling = 0u;
 }
 
 /**
@@ -411,6 +414,25 @@ int state::pool_size() const noexcept {
   return _pool_size;
 }
 
+/**
+ * @brief Set the event traces sampling: one event over sampling emitted by
+ * the cbmod carries a trace (see io::trace).
+ *
+ * @param sampling A non negative integer, 0 disables traces.
+ */
+void state::event_trace_sampling(uint32_t sampling) noexcept {
+  _event_trace_sampling = sampling;
+}
+
+/**
+ * @brief Get the event traces sampling.
+ *
+ * @return One event over this value is traced, 0 means no trace.
+ */
+uint32_t state::event_trace_sampling() const noexcept {
+  return _event_trace_sampling;
+}
+
 /**
  *  Set the poller name.
  *
@@ -41,7 +41,8 @@ data::data(uint32_t type)
 data::data(data const& other)
     : _type(other._type),
       source_id(other.source_id),
-      destination_id(other.destination_id) {}
+      destination_id(other.destination_id),
+      trace(other.trace) {}
 
 /**
  *  Assignment operator.
@@ -54,6 +55,7 @@ data& data::operator=(data const& other) {
   if (this != &other) {
     source_id = other.source_id;
     destination_id = other.destination_id;
+    trace = other.trace;
   }
   return *this;
 }
@@ -228,6 +228,8 @@ events::events() : _logger{log_v2::instance().get(log_v2::CONFIG)} {
   register_event(bbdo::pb_engine_configuration::static_type(),
                  "EngineConfiguration",
                  &bbdo::pb_engine_configuration::operations);
+  register_event(bbdo::pb_trace::static_type(), "Trace",
+                 &bbdo::pb_trace::operations);
 
   // Register BBDO protocol.
   io::protocols::instance().reg("BBDO", std::make_shared<bbdo::factory>(), 7,
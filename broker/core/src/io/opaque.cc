@@ -0,0 +1,41 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/broker/io/opaque.hh"
+
+using namespace com::centreon::broker::io;
+
+/**
+ * @brief Constructor.
+ *
+ * @param type The type of the relayed event.
+ * @param payload Its BBDO payload, without the BBDO header.
+ */
+opaque::opaque(uint32_t type, std::vector<char>&& payload)
+    : data(type), _payload(std::move(payload)) {}
+
+/**
+ * @brief Dump the event: since it is not decoded, only its type and its size
+ * are known.
+ *
+ * @param s The output stream.
+ */
+void opaque::dump(std::ostream& s) const {
+  data::dump(s);
+  s << " opaque payload_length:" << _payload.size();
+}
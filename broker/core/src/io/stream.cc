@@ -115,3 +115,18 @@ bool stream::wait_for_all_events_written(unsigned ms_timeout) {
   }
   return true;
 }
+
+/**
+ * @brief Give the encryption of the data written on this stream to the kernel
+ * (kTLS). Only a stream writing directly on a socket can do it, so the
+ * request is not forwarded to the substream: a layer between the TLS stream
+ * and the socket would see plain data instead of encrypted ones.
+ *
+ * @param crypto_info The kernel tls12_crypto_info_* structure to install.
+ *
+ * @return true if the kernel encrypts the data from now on.
+ */
+bool stream::set_ktls_tx(const std::vector<char>& crypto_info
+                         [[maybe_unused]]) {
+  return false;
+}
@@ -0,0 +1,111 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/broker/io/trace.hh"
+#include "com/centreon/broker/config/applier/state.hh"
+#include "com/centreon/broker/stats/center.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::io;
+
+std::atomic<uint32_t> trace::_sampling{0u};
+std::atomic<uint32_t> trace::_counter{0u};
+
+/**
+ * @brief Set the sampling of the traces: one event over sampling is traced.
+ *
+ * @param sampling The sampling, 0 to disable traces.
+ */
+void trace::set_sampling(uint32_t sampling) {
+  _sampling.store(sampling, std::memory_order_relaxed);
+}
+
+uint32_t trace::sampling() {
+  return _sampling.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Called for each new event, this function returns a new trace once
+ * every sampling calls. The rest of the time, and when traces are disabled,
+ * it returns nullptr.
+ *
+ * @return A trace or nullptr.
+ */
+std::shared_ptr<trace> trace::sample() {
+  uint32_t n = _sampling.load(std::memory_order_relaxed);
+  if (n == 0 || _counter.fetch_add(1, std::memory_order_relaxed) % n)
+    return nullptr;
+  return std::make_shared<trace>();
+}
+
+/**
+ * @brief The current time as stored in the stamps.
+ *
+ * @return A number of microseconds since epoch.
+ */
+int64_t trace::now() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+}
+
+const char* trace::stage_name(uint32_t s) {
+  static const char* names[] = {"callback", "muxer", "bbdo_write",
+                                "bbdo_read"};
+  return s < sizeof(names) / sizeof(names[0]) ? names[s] : "unknown";
+}
+
+/**
+ * @brief Add a stamp to the trace. Beyond max_stamps stamps, nothing is
+ * added.
+ *
+ * @param s The stage reached by the event.
+ * @param time The time in microseconds since epoch.
+ */
+void trace::add_stamp(stage s, int64_t time) {
+  if (_stamps.size() < max_stamps)
+    _stamps.push_back({s, time});
+}
+
+/**
+ * @brief The event carrying this trace has been committed by the output
+ * named output. Delays between consecutive stamps are added to the stats
+ * center histograms with names like "callback_to_muxer", the last one is
+ * "<last stage>_to_<output>" and the delay since the first stamp is added
+ * to "total_to_<output>".
+ *
+ * @param output The output type, for example "unified_sql".
+ */
+void trace::commit(const std::string& output) const {
+  if (_stamps.empty() || !config::applier::state::loaded())
+    return;
+
+  int64_t committed = now();
+  std::vector<std::pair<std::string, int64_t>> latencies;
+  latencies.reserve(_stamps.size() + 1);
+  for (size_t i = 1; i < _stamps.size(); ++i)
+    latencies.emplace_back(fmt::format("{}_to_{}", stage_name(_stamps[i - 1].s),
+                                       stage_name(_stamps[i].s)),
+                           _stamps[i].time - _stamps[i - 1].time);
+  latencies.emplace_back(
+      fmt::format("{}_to_{}", stage_name(_stamps.back().s), output),
+      committed - _stamps.back().time);
+  latencies.emplace_back(fmt::format("total_to_{}", output),
+                         committed - _stamps.front().time);
+  config::applier::state::instance().center()->add_event_latencies(latencies);
+}
@@ -77,6 +77,8 @@ void failover::add_secondary_endpoint(std::shared_ptr<io::endpoint> endp) {
     w_filter -= sec_endpt->get_stream_forbidden_filter();
   }
   _muxer->set_write_filter(w_filter);
+  if (!endp->accepts_opaque())
+    _muxer->set_accepts_opaque(false);
 }
 
 /**
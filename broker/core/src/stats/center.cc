@@ -220,6 +220,56 @@ void center::get_processing_stats(ProcessingStats* response) {
   *response = _stats.processing();
 }
 
+/**
+ * @brief Initialize the event latency histograms: their bounds are fixed, in
+ * milliseconds, from 1ms to 1 minute.
+ *
+ * @param sampling The configured sampling, only given as information.
+ */
+void center::init_event_latency(uint32_t sampling) {
+  static constexpr double bounds[] = {1,    2,    5,    10,    20,
+                                      50,   100,  200,  500,   1000,
+                                      2000, 5000, 10000, 30000, 60000};
+  absl::MutexLock lck(&_stats_m);
+  auto* latency = _stats.mutable_event_latency();
+  latency->set_sampling(sampling);
+  if (latency->bounds().empty())
+    for (double b : bounds)
+      latency->add_bounds(b);
+}
+
+/**
+ * @brief Add durations to the event latency histograms.
+ *
+ * @param latencies Pairs of stage names and durations in microseconds.
+ */
+void center::add_event_latencies(
+    const std::vector<std::pair<std::string, int64_t>>& latencies) {
+  absl::MutexLock lck(&_stats_m);
+  auto* latency = _stats.mutable_event_latency();
+  const auto& bounds = latency->bounds();
+  for (auto& [name, duration] : latencies) {
+    /* Clocks of different hosts are not synchronized, a negative duration
+     * is counted as 0. */
+    double ms = std::max<int64_t>(duration, 0) / 1000.0;
+    LatencyHistogram& h = (*latency->mutable_stages())[name];
+    if (h.buckets().empty())
+      h.mutable_buckets()->Resize(bounds.size() + 1, 0u);
+    h.set_count(h.count() + 1);
+    h.set_sum(h.sum() + ms);
+    if (ms > h.max())
+      h.set_max(ms);
+    int idx = std::lower_bound(bounds.begin(), bounds.end(), ms) -
+              bounds.begin();
+    h.set_buckets(idx, h.buckets(idx) + 1);
+  }
+}
+
+void center::get_event_latency_stats(EventLatencyStats* response) {
+  absl::MutexLock lck(&_stats_m);
+  *response = _stats.event_latency();
+}
+
 void center::clear_muxer_queue_file(const std::string& name) {
   absl::MutexLock lck(&_stats_m);
   if (_stats.processing().muxers().contains(name))
@@ -20,12 +20,18 @@
 #include <arpa/inet.h>
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <thread>
+
 #include "broker/core/bbdo/stream.hh"
 #include "com/centreon/broker/config/applier/init.hh"
 #include "com/centreon/broker/config/applier/modules.hh"
+#include "com/centreon/broker/io/opaque.hh"
 #include "com/centreon/broker/lua/macro_cache.hh"
 #include "com/centreon/broker/misc/string.hh"
 #include "com/centreon/broker/misc/variant.hh"
+#include "com/centreon/broker/multiplexing/engine.hh"
+#include "com/centreon/broker/multiplexing/muxer.hh"
 #include "com/centreon/broker/neb/service.hh"
 #include "common/log_v2/log_v2.hh"
 
@@ -451,3 +457,172 @@ TEST_F(OutputTest, ServiceTooShortAndAGoodOne) {
   ASSERT_EQ(new_svc->output, std::string("SecondOutput"));
   ASSERT_EQ(new_svc->perf_data, std::string("metric=3.14"));
 }
+
+// Given a protobuf event written to two BBDO streams
+// Then it is serialized only once, both streams sending the same bytes.
+// And when the event is modified, it is serialized again.
+TEST_F(OutputTest, WritePbServiceStatusSerializedOnce) {
+  config::applier::modules modules(_logger);
+  modules.load_file("./broker/lib/10-neb.so");
+
+  auto ss = std::make_shared<neb::pb_service_status>();
+  ss->mut_obj().set_host_id(12345);
+  ss->mut_obj().set_service_id(18);
+  ss->mut_obj().set_output("Bonjour");
+
+  auto memory1 = std::make_shared<into_memory>();
+  auto memory2 = std::make_shared<into_memory>();
+  bbdo::stream stm1(true);
+  bbdo::stream stm2(true);
+  stm1.set_substream(memory1);
+  stm2.set_substream(memory2);
+  for (bbdo::stream* stm : {&stm1, &stm2}) {
+    stm->set_coarse(false);
+    stm->set_negotiate(false);
+    stm->negotiate(bbdo::stream::negotiate_first);
+  }
+  stm1.write(ss);
+  bool computed = false;
+  ss->encoded(io::protobuf_base::bbdo_payload,
+              [&computed](std::string&) { computed = true; });
+  ASSERT_FALSE(computed);
+  stm2.write(ss);
+  ASSERT_EQ(memory1->get_memory(), memory2->get_memory());
+
+  ss->mut_obj().set_output("Conjour");
+  stm1.write(ss);
+  std::shared_ptr<io::data> e;
+  stm1.read(e, time(nullptr) + 1000);
+  ASSERT_EQ(std::static_pointer_cast<neb::pb_service_status>(e)->obj().output(),
+            "Conjour");
+}
+
+// Given a protobuf event whose payload is stored
+// When a thread modifies it while another one serializes it
+// Then the payload used by the serializing thread stays valid.
+TEST_F(OutputTest, PbEncodingModifiedWhileSerialized) {
+  auto ss = std::make_shared<neb::pb_service_status>();
+  std::atomic_bool done{false};
+  std::thread serializer([ss, &done] {
+    for (int i = 0; i < 100000; ++i) {
+      std::shared_ptr<const std::string> payload =
+          ss->encoded(io::protobuf_base::bbdo_payload,
+                      [](std::string& p) { p.assign(1000, 'x'); });
+      EXPECT_EQ(payload->size(), 1000u);
+      EXPECT_EQ(payload->back(), 'x');
+    }
+    done = true;
+  });
+  while (!done)
+    ss->mut_obj();
+  serializer.join();
+}
+
+// Given a protobuf event whose payload is stored
+// When a stream stores the payload again while the event is being modified
+// Then the payload computed after the modification is the new one.
+TEST_F(OutputTest, PbEncodingStoredDuringModify) {
+  auto ss = std::make_shared<neb::pb_service_status>();
+  ss->mut_obj().set_output("Bonjour");
+  auto serialize = [&ss](std::string& p) { ss->obj().SerializeToString(&p); };
+  auto output = [&ss, &serialize] {
+    ServiceStatus obj;
+    obj.ParseFromString(*ss->encoded(io::protobuf_base::bbdo_payload,
+                                     serialize));
+    return obj.output();
+  };
+  ASSERT_EQ(output(), "Bonjour");
+
+  ss->modify([&output](ServiceStatus& obj) {
+    // another stream encodes the event before it is modified
+    ASSERT_EQ(output(), "Bonjour");
+    obj.set_output("Conjour");
+  });
+  ASSERT_EQ(output(), "Conjour");
+}
+
+// Given a BBDO input relaying the ServiceStatus events
+// When it reads a long ServiceStatus and a legacy service
+// Then the ServiceStatus is read as an opaque event, written to a BBDO output
+// with the same bytes, and the service is decoded as usual.
+TEST_F(OutputTest, RelayedEventWrittenAsReceived) {
+  config::applier::modules modules(_logger);
+  modules.load_file("./broker/lib/10-neb.so");
+
+  auto ss = std::make_shared<neb::pb_service_status>();
+  ss->mut_obj().set_host_id(12345);
+  ss->mut_obj().set_service_id(18);
+  ss->mut_obj().set_output(std::string(200000, 'a'));
+  auto svc = std::make_shared<neb::service>();
+  svc->host_id = 12345;
+  svc->service_id = 18;
+
+  auto memory = std::make_shared<into_memory>();
+  bbdo::stream stm(true);
+  stm.set_substream(memory);
+  stm.set_coarse(false);
+  stm.set_negotiate(false);
+  stm.negotiate(bbdo::stream::negotiate_first);
+  stm.write(ss);
+  std::vector<char> expected = memory->get_memory();
+  stm.write(svc);
+  std::vector<char> svc_bytes = memory->get_memory();
+
+  bbdo::stream relay(true);
+  relay.set_substream(memory);
+  relay.set_coarse(false);
+  relay.set_negotiate(false);
+  relay.negotiate(bbdo::stream::negotiate_first);
+  relay.set_relayed({neb::pb_service_status::static_type()});
+  memory->get_mutable_memory() = expected;
+  std::shared_ptr<io::data> e;
+  relay.read(e, time(nullptr) + 1000);
+  ASSERT_EQ(e->type(), neb::pb_service_status::static_type());
+  ASSERT_TRUE(std::dynamic_pointer_cast<io::opaque>(e));
+
+  auto output = std::make_shared<into_memory>();
+  bbdo::stream out(false);
+  out.set_substream(output);
+  out.set_coarse(false);
+  out.set_negotiate(false);
+  out.negotiate(bbdo::stream::negotiate_first);
+  out.write(e);
+  ASSERT_EQ(output->get_memory(), expected);
+
+  memory->get_mutable_memory() = svc_bytes;
+  relay.read(e, time(nullptr) + 1000);
+  ASSERT_EQ(e->type(), neb::service::static_type());
+  ASSERT_EQ(std::static_pointer_cast<neb::service>(e)->service_id, 18u);
+}
+
+// Given the muxers of a BBDO output and of an output that cannot write
+// relayed events
+// When a relayed ServiceStatus and a decoded one are published
+// Then the BBDO muxer queues both, the other one only the decoded event.
+TEST_F(OutputTest, RelayedEventOnlyQueuedForBbdo) {
+  auto bbdo_mux = multiplexing::muxer::create(
+      "relay_bbdo", multiplexing::engine::instance_ptr(),
+      multiplexing::muxer_filter(), multiplexing::muxer_filter(), false);
+  auto other_mux = multiplexing::muxer::create(
+      "relay_other", multiplexing::engine::instance_ptr(),
+      multiplexing::muxer_filter(), multiplexing::muxer_filter(), false);
+  other_mux->set_accepts_opaque(false);
+
+  auto relayed = std::make_shared<io::opaque>(
+      neb::pb_service_status::static_type(), std::vector<char>(10, 'a'));
+  auto ss = std::make_shared<neb::pb_service_status>();
+  std::deque<std::shared_ptr<io::data>> events{relayed, ss};
+  bbdo_mux->publish(events);
+  other_mux->publish(events);
+
+  std::shared_ptr<io::data> e;
+  ASSERT_TRUE(bbdo_mux->read(e, 0));
+  ASSERT_EQ(e, relayed);
+  ASSERT_TRUE(bbdo_mux->read(e, 0));
+  ASSERT_EQ(e, ss);
+  ASSERT_TRUE(other_mux->read(e, 0));
+  ASSERT_EQ(e, ss);
+  ASSERT_FALSE(other_mux->read(e, 0));
+  bbdo_mux->unsubscribe();
+  other_mux->unsubscribe();
+}
@@ -18,7 +18,9 @@
  */
 
 #include <gtest/gtest.h>
+#include "com/centreon/broker/config/applier/state.hh"
 #include "com/centreon/broker/io/raw.hh"
+#include "com/centreon/broker/io/trace.hh"
 
 using namespace com::centreon::broker;
 
@@ -29,4 +31,71 @@ TEST(IO, DefaultCtor) {
   // Check construction.
   ASSERT_TRUE(data.type() == io::raw::static_type());
   ASSERT_TRUE(data.size() == 0);
-}
\ No newline at end of file
+}
+
+TEST(IO, TraceSampling) {
+  io::trace::set_sampling(0);
+  for (int i = 0; i < 10; ++i)
+    ASSERT_FALSE(io::trace::sample());
+
+  io::trace::set_sampling(4);
+  int count = 0;
+  for (int i = 0; i < 40; ++i)
+    if (io::trace::sample())
+      ++count;
+  ASSERT_EQ(count, 10);
+  io::trace::set_sampling(0);
+
+  /* Copies of an event share its trace. */
+  io::raw data;
+  data.trace = std::make_shared<io::trace>();
+  io::raw copy(data);
+  ASSERT_EQ(copy.trace, data.trace);
+}
+
+TEST(IO, TraceCommit) {
+  config::applier::state::load(com::centreon::common::PeerType::BROKER);
+  auto center = config::applier::state::instance().center();
+  center->init_event_latency(1);
+
+  int64_t now = io::trace::now();
+  io::trace t;
+  t.add_stamp(io::trace::callback, now - 1500000);
+  t.add_stamp(io::trace::muxer, now - 1499000);
+  t.add_stamp(io::trace::bbdo_write, now - 1000000);
+  for (size_t i = 0; i < 2 * io::trace::max_stamps; ++i)
+    t.add_stamp(io::trace::bbdo_read);
+  ASSERT_EQ(t.stamps().size(), io::trace::max_stamps);
+
+  io::trace u;
+  u.add_stamp(io::trace::callback, now - 3000);
+  u.add_stamp(io::trace::muxer, now - 2000);
+  t.commit("unified_sql");
+  u.commit("unified_sql");
+
+  EventLatencyStats stats;
+  center->get_event_latency_stats(&stats);
+  ASSERT_EQ(stats.sampling(), 1u);
+  const auto& stages = stats.stages();
+  ASSERT_EQ(stages.count("callback_to_muxer"), 1u);
+  ASSERT_EQ(stages.count("muxer_to_bbdo_write"), 1u);
+  ASSERT_EQ(stages.count("bbdo_write_to_bbdo_read"), 1u);
+  ASSERT_EQ(stages.count("bbdo_read_to_unified_sql"), 1u);
+  ASSERT_EQ(stages.count("muxer_to_unified_sql"), 1u);
+
+  const LatencyHistogram& h = stages.at("callback_to_muxer");
+  ASSERT_EQ(h.count(), 2u);
+  ASSERT_DOUBLE_EQ(h.sum(), 2.0);
+  ASSERT_EQ(h.buckets_size(), stats.bounds_size() + 1);
+  /* Both durations are 1ms, they are in the first bucket (<= 1ms). */
+  ASSERT_EQ(h.buckets(0), 2u);
+
+  const LatencyHistogram& total = stages.at("total_to_unified_sql");
+  ASSERT_EQ(total.count(), 2u);
+  ASSERT_GE(total.max(), 1500.0);
+  /* 1.5s is in the (1000ms, 2000ms] bucket. */
+  ASSERT_EQ(total.buckets(10), 1u);
+
+  config::applier::state::unload();
+}
+
@@ -27,12 +27,21 @@ namespace com::centreon::broker {
 
 namespace http_tsdb {
 class http_tsdb_config : public common::http::http_config {
+ public:
+  /* line_protocol: influxdb text format, remote_write: Prometheus remote
+   * write protocol (protobuf compressed with snappy). */
+  enum class body_format { line_protocol, remote_write };
+
+ private:
   std::string _http_target;
   std::string _user;
   std::string _pwd;
   unsigned _max_queries_per_transaction;
   std::vector<column> _status_columns;
   std::vector<column> _metric_columns;
+  body_format _format = body_format::line_protocol;
+  /* line protocol bodies are sent gzip compressed. */
+  bool _gzip = false;
 
  public:
   http_tsdb_config(const common::http::http_config& http_conf,
@@ -69,6 +78,10 @@ class http_tsdb_config : public common::http::http_config {
   const std::vector<column>& get_metric_columns() const {
     return _metric_columns;
   }
+  body_format get_format() const { return _format; }
+  void set_format(body_format format) { _format = format; }
+  bool get_gzip() const { return _gzip; }
+  void set_gzip(bool gzip) { _gzip = gzip; }
 };
 }  // namespace http_tsdb
 
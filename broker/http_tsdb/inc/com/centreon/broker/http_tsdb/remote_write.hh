@@ -0,0 +1,87 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCB_HTTP_TSDB_REMOTE_WRITE_HH
+#define CCB_HTTP_TSDB_REMOTE_WRITE_HH
+
+namespace com::centreon::broker {
+
+namespace http_tsdb {
+
+/**
+ * @class remote_write remote_write.hh
+ * "com/centreon/broker/http_tsdb/remote_write.hh"
+ * @brief Encoder of the Prometheus remote write protocol.
+ *
+ * A remote write body is a WriteRequest protobuf message compressed with
+ * snappy (block format). Since a repeated field can be split in several
+ * chunks, each time series is encoded as a complete WriteRequest, so bodies
+ * can be concatenated as the line protocol ones.
+ *
+ * An object of this class is a scratch area where the labels of the current
+ * time series are collected, it is reused from one series to the next to
+ * avoid allocations.
+ */
+class remote_write {
+  /* Names and values of the labels, one after the other. */
+  std::string _labels;
+  /* For each label, offset of its name, of its value and end of its value in
+   * _labels. */
+  std::vector<std::array<uint32_t, 3>> _offsets;
+
+  void _append(const absl::AlphaNum& piece) {
+    _labels.append(piece.data(), piece.size());
+  }
+
+  void _push_label(size_t name_begin, size_t value_begin) {
+    _offsets.push_back({static_cast<uint32_t>(name_begin),
+                        static_cast<uint32_t>(value_begin),
+                        static_cast<uint32_t>(_labels.size())});
+  }
+
+ public:
+  void clear();
+
+  /**
+   * @brief Add a label to the current time series.
+   *
+   * @param name Name of the label.
+   * @param value Value of the label, its pieces are concatenated as
+   * absl::StrCat() does.
+   */
+  template <typename... Args>
+  void add_label(std::string_view name, const Args&... value) {
+    size_t name_begin = _labels.size();
+    _labels.append(name);
+    size_t value_begin = _labels.size();
+    (_append(absl::AlphaNum(value)), ...);
+    _push_label(name_begin, value_begin);
+  }
+
+  void add_line_protocol_tags(std::string_view tags);
+
+  void append_series(std::string& buffer, double value, int64_t timestamp_ms);
+
+  static void snappy_compress(std::string_view in, std::string& out);
+};
+
+}  // namespace http_tsdb
+
+}  // namespace com::centreon::broker
+
+#endif  // !CCB_HTTP_TSDB_REMOTE_WRITE_HH
@@ -34,9 +34,17 @@ namespace com::centreon::broker {
 namespace http_tsdb {
 
 class request : public http::request_base {
+ public:
+  /* How the content is compressed into the body before being sent. */
+  enum class encoding { none, gzip, snappy };
+
  protected:
   unsigned _nb_metric;
   unsigned _nb_status;
+  encoding _encoding = encoding::none;
+  /* Uncompressed data when the body is compressed, otherwise data are
+   * written directly in the body. */
+  std::string _content;
 
  public:
   using pointer = std::shared_ptr<request>;
@@ -57,6 +65,21 @@ class request : public http::request_base {
 
   virtual void append(const request::pointer& data_to_append);
 
+  /**
+   * @brief The buffer where data must be written: the body or, if it is
+   * compressed, the buffer that will be compressed by encode().
+   */
+  std::string& content() {
+    return _encoding == encoding::none ? body() : _content;
+  }
+  const std::string& content() const {
+    return _encoding == encoding::none ? body() : _content;
+  }
+  void set_encoding(encoding enc);
+  void encode();
+  void reuse_buffers(std::vector<std::string>& spares, size_t size_to_reserve);
+  void release_buffers(std::vector<std::string>& spares, size_t max_spares);
+
   unsigned get_nb_metric() const { return _nb_metric; }
   unsigned get_nb_status() const { return _nb_status; }
   unsigned get_nb_data() const { return _nb_metric + _nb_status; }
@@ -88,6 +111,9 @@ class stream : public io::stream, public std::enable_shared_from_this<stream> {
   unsigned _acknowledged;
   // the current request that buffers metric to send
   request::pointer _request;
+  // buffers of the acknowledged requests, reused by the next ones. It is
+  // mutable since create_request() takes them.
+  mutable std::vector<std::string> _spare_buffers;
   // the two beans stat_unit and stat_average are used to produce statistics
   // about request time
   /*
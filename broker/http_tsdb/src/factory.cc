@@ -101,7 +101,11 @@ static const absl::flat_hash_map<std::string, asio::ssl::context_base::method>
 
 /**
  * @brief this method parse conf and fill these attributes in conf bean:
- *  - "http_target" -> http_tsdb_config._http_target /write by default
+ *  - "http_target" -> http_tsdb_config._http_target /write by default,
+ *    /api/v1/write with the remote_write format
+ *  - "http_format" -> http_tsdb_config._format, line_protocol (default) or
+ *    remote_write
+ *  - "gzip" -> http_tsdb_config._gzip, line protocol bodies are compressed
  *  - "db_user" -> http_tsdb_config._user mandatory
  *  - "db_password" -> http_tsdb_config._pwd mandatory
  *  - "db_host" "db_port" -> http_config._endpoint mandatory
@@ -141,8 +145,29 @@ void factory::create_conf(const config::endpoint& cfg,
   std::string passwd(find_param(cfg, "db_password"));
   std::string addr(find_param(cfg, "db_host"));
 
-  std::string target = "/write";
-  auto it = cfg.params.find("http_target");
+  http_tsdb_config::body_format format =
+      http_tsdb_config::body_format::line_protocol;
+  auto it = cfg.params.find("http_format");
+  if (it != cfg.params.end()) {
+    if (it->second == "remote_write")
+      format = http_tsdb_config::body_format::remote_write;
+    else if (it->second != "line_protocol")
+      throw msg_fmt("unknown value for http_format: {}", it->second);
+  }
+
+  bool gzip = false;
+  it = cfg.params.find("gzip");
+  if (it != cfg.params.end()) {
+    if (!absl::SimpleAtob(it->second, &gzip)) {
+      throw msg_fmt("couldn't parse gzip '{}' defined for endpoint '{}'",
+                    it->second, cfg.name);
+    }
+  }
+
+  std::string target =
+      format == http_tsdb_config::body_format::remote_write ? "/api/v1/write"
+                                                             : "/write";
+  it = cfg.params.find("http_target");
   if (it != cfg.params.end()) {
     target = it->second;
   }
@@ -245,6 +270,8 @@ void factory::create_conf(const config::endpoint& cfg,
   conf =
       http_tsdb_config(http_cfg, target, user, passwd, queries_per_transaction,
                        status_column_list, metric_column_list);
+  conf.set_format(format);
+  conf.set_gzip(gzip);
 }
 
 std::vector<column> factory::get_columns(const json& cfg) {
@@ -0,0 +1,284 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/broker/http_tsdb/remote_write.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::http_tsdb;
+
+/************************************************************************
+ *      protobuf
+ ************************************************************************/
+
+/* Tags of the fields we write: (field number << 3) | wire type. */
+static constexpr char _write_request_timeseries = (1 << 3) | 2;
+static constexpr char _time_series_labels = (1 << 3) | 2;
+static constexpr char _time_series_samples = (2 << 3) | 2;
+static constexpr char _label_name = (1 << 3) | 2;
+static constexpr char _label_value = (2 << 3) | 2;
+static constexpr char _sample_value = (1 << 3) | 1;
+static constexpr char _sample_timestamp = (2 << 3) | 0;
+
+static size_t _varint_size(uint64_t value) {
+  size_t retval = 1;
+  while (value >= 0x80) {
+    value >>= 7;
+    ++retval;
+  }
+  return retval;
+}
+
+static char* _write_varint(char* p, uint64_t value) {
+  while (value >= 0x80) {
+    *p++ = static_cast<char>(value | 0x80);
+    value >>= 7;
+  }
+  *p++ = static_cast<char>(value);
+  return p;
+}
+
+/**
+ * @brief Size of a length delimited field, tag included.
+ */
+static size_t _field_size(size_t len) {
+  return 1 + _varint_size(len) + len;
+}
+
+static char* _write_field(char* p, char tag, std::string_view value) {
+  *p++ = tag;
+  p = _write_varint(p, value.size());
+  memcpy(p, value.data(), value.size());
+  return p + value.size();
+}
+
+/**
+ * @brief Forget the labels of the previous time series.
+ */
+void remote_write::clear() {
+  _labels.clear();
+  _offsets.clear();
+}
+
+/**
+ * @brief Add the tags of an influxdb line protocol string as labels. This is
+ * used to reuse the columns of the configuration, the tags are the ones
+ * generated by line_protocol_query, that is ",name=value,name=value". Tags
+ * are unescaped and the parsing stops at the first unescaped space, fields
+ * are so ignored.
+ *
+ * @param tags The tags as generated by line_protocol_query.
+ */
+void remote_write::add_line_protocol_tags(std::string_view tags) {
+  size_t name_begin = 0;
+  size_t value_begin = 0;
+  bool in_value = false;
+  bool started = false;
+  for (size_t i = 0; i < tags.size(); ++i) {
+    char c = tags[i];
+    if (c == '\\' && i + 1 < tags.size()) {
+      _labels.push_back(tags[++i]);
+    } else if (c == ',' || c == ' ') {
+      if (started && in_value)
+        _push_label(name_begin, value_begin);
+      else if (started)
+        _labels.resize(name_begin);
+      if (c == ' ')
+        return;
+      name_begin = _labels.size();
+      in_value = false;
+      started = true;
+    } else if (c == '=' && !in_value) {
+      value_begin = _labels.size();
+      in_value = true;
+    } else {
+      _labels.push_back(c);
+    }
+  }
+  if (started && in_value)
+    _push_label(name_begin, value_begin);
+  else if (started)
+    _labels.resize(name_begin);
+}
+
+/**
+ * @brief Append to buffer a WriteRequest containing one TimeSeries made of
+ * the labels collected since the last clear() and of one sample. Labels are
+ * sorted by name as required by the protocol.
+ *
+ * @param buffer The body to fill.
+ * @param value The sample value.
+ * @param timestamp_ms The sample timestamp in milliseconds.
+ */
+void remote_write::append_series(std::string& buffer,
+                                 double value,
+                                 int64_t timestamp_ms) {
+  std::string_view labels(_labels);
+  auto name = [labels](const std::array<uint32_t, 3>& o) {
+    return labels.substr(o[0], o[1] - o[0]);
+  };
+  /* Few labels, often almost sorted: an insertion sort is the fastest. */
+  auto less = [&name](std::string_view n, const std::array<uint32_t, 3>& o) {
+    std::string_view other = name(o);
+    /* Names mostly differ by their first character. */
+    if (!n.empty() && !other.empty() && n[0] != other[0])
+      return n[0] < other[0];
+    return n < other;
+  };
+  for (size_t i = 1; i < _offsets.size(); ++i) {
+    std::array<uint32_t, 3> o = _offsets[i];
+    std::string_view n = name(o);
+    size_t j = i;
+    for (; j > 0 && less(n, _offsets[j - 1]); --j)
+      _offsets[j] = _offsets[j - 1];
+    _offsets[j] = o;
+  }
+
+  size_t series_size = 0;
+  for (auto& o : _offsets) {
+    size_t label_size = _field_size(o[1] - o[0]) + _field_size(o[2] - o[1]);
+    series_size += _field_size(label_size);
+  }
+  size_t sample_size = 1 + sizeof(double) + 1 +
+                       _varint_size(static_cast<uint64_t>(timestamp_ms));
+  series_size += _field_size(sample_size);
+
+  /* The size is known, the buffer is resized once and filled. */
+  size_t offset = buffer.size();
+  buffer.resize(offset + _field_size(series_size));
+  char* p = buffer.data() + offset;
+  *p++ = _write_request_timeseries;
+  p = _write_varint(p, series_size);
+  for (auto& o : _offsets) {
+    size_t label_size = _field_size(o[1] - o[0]) + _field_size(o[2] - o[1]);
+    *p++ = _time_series_labels;
+    p = _write_varint(p, label_size);
+    p = _write_field(p, _label_name, name(o));
+    p = _write_field(p, _label_value, labels.substr(o[1], o[2] - o[1]));
+  }
+  *p++ = _time_series_samples;
+  p = _write_varint(p, sample_size);
+  *p++ = _sample_value;
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  for (size_t i = 0; i < sizeof(bits); ++i, bits >>= 8)
+    *p++ = static_cast<char>(bits & 0xff);
+  *p++ = _sample_timestamp;
+  _write_varint(p, static_cast<uint64_t>(timestamp_ms));
+}
+
+/************************************************************************
+ *      snappy
+ ************************************************************************/
+
+static constexpr size_t _snappy_block_size = 1 << 16;
+static constexpr int _snappy_hash_bits = 14;
+
+static uint32_t _load32(const char* p) {
+  uint32_t retval;
+  memcpy(&retval, p, sizeof(retval));
+  return retval;
+}
+
+static void _snappy_literal(std::string& out, const char* begin, size_t len) {
+  if (len == 0)
+    return;
+  size_t n = len - 1;
+  if (n < 60) {
+    out.push_back(static_cast<char>(n << 2));
+  } else {
+    size_t count = 1;
+    while (count < 4 && (n >> (8 * count)))
+      ++count;
+    out.push_back(static_cast<char>((59 + count) << 2));
+    for (size_t i = 0; i < count; ++i)
+      out.push_back(static_cast<char>((n >> (8 * i)) & 0xff));
+  }
+  out.append(begin, len);
+}
+
+/**
+ * @brief Emit one copy element, len must be in [4, 64].
+ */
+static void _snappy_copy_element(std::string& out, size_t offset, size_t len) {
+  if (len < 12 && offset < 2048) {
+    out.push_back(
+        static_cast<char>(1 | ((len - 4) << 2) | ((offset >> 8) << 5)));
+    out.push_back(static_cast<char>(offset & 0xff));
+  } else {
+    out.push_back(static_cast<char>(2 | ((len - 1) << 2)));
+    out.push_back(static_cast<char>(offset & 0xff));
+    out.push_back(static_cast<char>(offset >> 8));
+  }
+}
+
+static void _snappy_copy(std::string& out, size_t offset, size_t len) {
+  while (len >= 68) {
+    _snappy_copy_element(out, offset, 64);
+    len -= 64;
+  }
+  if (len > 64) {
+    _snappy_copy_element(out, offset, 60);
+    len -= 60;
+  }
+  _snappy_copy_element(out, offset, len);
+}
+
+/**
+ * @brief Compress data in the snappy block format (the one expected by
+ * remote write receivers, not the framed one). The compressor is the usual
+ * greedy one: input is cut in 64kB blocks, and in each block, 4 bytes
+ * sequences are looked up in a hash table to find matches.
+ *
+ * @param in The data to compress.
+ * @param out The compressed data, its previous content is replaced.
+ */
+void remote_write::snappy_compress(std::string_view in, std::string& out) {
+  char preamble[10];
+  out.assign(preamble, _write_varint(preamble, in.size()));
+
+  uint16_t table[1 << _snappy_hash_bits];
+  for (size_t block = 0; block < in.size(); block += _snappy_block_size) {
+    const char* base = in.data() + block;
+    const char* end = base + std::min(_snappy_block_size, in.size() - block);
+    const char* lit = base;
+    if (end - base >= 16) {
+      memset(table, 0, sizeof(table));
+      const char* ip = base + 1;
+      const char* limit = end - 4;
+      while (ip <= limit) {
+        uint32_t bytes = _load32(ip);
+        uint32_t h = (bytes * 0x1e35a7bd) >> (32 - _snappy_hash_bits);
+        const char* candidate = base + table[h];
+        table[h] = static_cast<uint16_t>(ip - base);
+        if (_load32(candidate) != bytes) {
+          /* The longer we don't find anything, the faster we skip. */
+          ip += 1 + ((ip - lit) >> 5);
+          continue;
+        }
+        _snappy_literal(out, lit, ip - lit);
+        size_t len = 4;
+        while (ip + len < end && candidate[len] == ip[len])
+          ++len;
+        _snappy_copy(out, ip - candidate, len);
+        ip += len;
+        lit = ip;
+      }
+    }
+    _snappy_literal(out, lit, end - lit);
+  }
+}
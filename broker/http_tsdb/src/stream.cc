@@ -18,11 +18,14 @@
  */
 
 #include "com/centreon/broker/http_tsdb/stream.hh"
+#include <zlib.h>
 #include "bbdo/storage/metric.hh"
 #include "bbdo/storage/status.hh"
 #include "com/centreon/broker/cache/global_cache.hh"
 #include "com/centreon/broker/exceptions/shutdown.hh"
 #include "com/centreon/broker/http_tsdb/internal.hh"
+#include "com/centreon/broker/http_tsdb/remote_write.hh"
+#include "com/centreon/exceptions/msg_fmt.hh"
 
 using namespace com::centreon::broker;
 using namespace com::centreon::exceptions;
@@ -39,11 +42,110 @@ using namespace com::centreon::broker::http_tsdb;
  * @param data_to_append
  */
 void request::append(const request::pointer& data_to_append) {
-  body() += data_to_append->body();
+  content() += data_to_append->content();
   _nb_metric += data_to_append->_nb_metric;
   _nb_status += data_to_append->_nb_status;
 }
 
+/**
+ * @brief Choose how the content is compressed, this must be called before
+ * any data is added. The Content-Encoding header is set accordingly.
+ *
+ * @param enc The encoding.
+ */
+void request::set_encoding(encoding enc) {
+  _encoding = enc;
+  switch (enc) {
+    case encoding::gzip:
+      set(boost::beast::http::field::content_encoding, "gzip");
+      break;
+    case encoding::snappy:
+      set(boost::beast::http::field::content_encoding, "snappy");
+      break;
+    default:
+      erase(boost::beast::http::field::content_encoding);
+      break;
+  }
+}
+
+/**
+ * @brief Compress data in the gzip format.
+ *
+ * @param in The data to compress.
+ * @param out The compressed data, its previous content is replaced.
+ */
+static void _gzip_compress(const std::string& in, std::string& out) {
+  z_stream zs{};
+  /* 15 + 16: max window with a gzip header and trailer. */
+  if (deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8,
+                   Z_DEFAULT_STRATEGY) != Z_OK)
+    throw msg_fmt("unable to initialize gzip compression");
+  out.resize(deflateBound(&zs, in.size()));
+  zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(in.data()));
+  zs.avail_in = in.size();
+  zs.next_out = reinterpret_cast<Bytef*>(out.data());
+  zs.avail_out = out.size();
+  int res = deflate(&zs, Z_FINISH);
+  out.resize(zs.total_out);
+  deflateEnd(&zs);
+  if (res != Z_STREAM_END)
+    throw msg_fmt("unable to gzip {} bytes", in.size());
+}
+
+/**
+ * @brief Build the body from the content if it is compressed. The content is
+ * kept, so data can still be appended to it if the request fails and the
+ * body is built again before the next try.
+ */
+void request::encode() {
+  switch (_encoding) {
+    case encoding::gzip:
+      _gzip_compress(_content, body());
+      break;
+    case encoding::snappy:
+      remote_write::snappy_compress(_content, body());
+      break;
+    default:
+      break;
+  }
+}
+
+/**
+ * @brief Give to the request the buffers of an old one if there are some,
+ * otherwise the content buffer is just reserved.
+ *
+ * @param spares The buffers of the acknowledged requests.
+ * @param size_to_reserve The expected size of the content.
+ */
+void request::reuse_buffers(std::vector<std::string>& spares,
+                            size_t size_to_reserve) {
+  auto reuse = [&spares](std::string& buffer) {
+    if (!spares.empty()) {
+      buffer.swap(spares.back());
+      spares.pop_back();
+      buffer.clear();
+    }
+  };
+  reuse(content());
+  if (_encoding != encoding::none)
+    reuse(body());
+  content().reserve(size_to_reserve);
+}
+
+/**
+ * @brief Give back the buffers of an acknowledged request.
+ *
+ * @param spares The buffers to reuse.
+ * @param max_spares We don't keep more buffers than that.
+ */
+void request::release_buffers(std::vector<std::string>& spares,
+                              size_t max_spares) {
+  if (spares.size() < max_spares)
+    spares.emplace_back(std::move(content()));
+  if (_encoding != encoding::none && spares.size() < max_spares)
+    spares.emplace_back(std::move(body()));
+}
+
 void request::dump(std::ostream& stream) const {
   request_base::dump(stream);
   stream << " nb metric: " << _nb_metric << " nb status:" << _nb_status;
@@ -313,11 +415,13 @@ int32_t stream::stop() {
 
 /**
  * @brief send request to tsdb
- * it only calculates content-length of the request before sending it
+ * it compresses the body if needed and calculates content-length of the
+ * request before sending it
  *
  * @param request
  */
 void stream::send_request(const request::pointer& request) {
+  request->encode();
   request->content_length(request->body().length());
   _http_client->send(request, [me = shared_from_this(), request](
                                   const boost::beast::error_code& err,
@@ -386,6 +490,9 @@ void stream::send_handler(const boost::beast::error_code& err,
     add_to_stat(_status_stat, request->get_nb_status());
     actu_stat_avg();
     _acknowledged += request->get_nb_data();
+    // one buffer for each request in flight, two when they are compressed
+    request->release_buffers(_spare_buffers,
+                             2 * (_conf->get_max_connections() + 1));
   }
 }
 
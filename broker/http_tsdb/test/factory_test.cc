@@ -132,3 +132,33 @@ TEST(HttpTsdbFactory, ParseParameter) {
             std::chrono::seconds(9));
   ASSERT_EQ(conf.get_max_connections(), 10);
 }
+
+TEST(HttpTsdbFactory, BodyFormat) {
+  factory_test fact("http_tsdb_test", g_io_context);
+  config::endpoint cfg(config::endpoint::io_type::output);
+  http_tsdb::http_tsdb_config conf;
+
+  cfg.params["db_user"] = "admin";
+  cfg.params["db_password"] = "pass";
+  cfg.params["db_host"] = "localhost";
+
+  fact.create_conf(cfg, conf);
+  ASSERT_EQ(conf.get_format(),
+            http_tsdb::http_tsdb_config::body_format::line_protocol);
+  ASSERT_FALSE(conf.get_gzip());
+  ASSERT_EQ(conf.get_http_target(), "/write");
+
+  cfg.params["gzip"] = "true";
+  cfg.params["http_format"] = "remote_write";
+  fact.create_conf(cfg, conf);
+  ASSERT_EQ(conf.get_format(),
+            http_tsdb::http_tsdb_config::body_format::remote_write);
+  ASSERT_TRUE(conf.get_gzip());
+  ASSERT_EQ(conf.get_http_target(), "/api/v1/write");
+
+  cfg.params["http_format"] = "json";
+  ASSERT_THROW(fact.create_conf(cfg, conf), msg_fmt);
+  cfg.params["http_format"] = "line_protocol";
+  cfg.params["gzip"] = "maybe";
+  ASSERT_THROW(fact.create_conf(cfg, conf), msg_fmt);
+}
@@ -0,0 +1,235 @@
+/**
+ * Copyright 2024 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+/**
+ * Bytes on wire and CPU needed to send metrics to a tsdb with the line
+ * protocol, the gzipped line protocol and the remote write protocol. Bodies
+ * look like the victoria_metrics ones with the default columns, they are
+ * built into reused buffers and posted by batches to a local http server
+ * that only reads them.
+
+ ./http_tsdb-bench [number of metrics] [metrics per request]
+
+ Defaults are 100000 metrics by requests of 1000.
+*/
+#include <absl/strings/str_cat.h>
+#include <arpa/inet.h>
+#include <fmt/format.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <zlib.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "com/centreon/broker/http_tsdb/remote_write.hh"
+
+using namespace com::centreon::broker;
+
+enum mode { line_protocol, line_protocol_gzip, remote_write };
+
+static void gzip_compress(const std::string& in, std::string& out) {
+  z_stream zs{};
+  deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8,
+               Z_DEFAULT_STRATEGY);
+  out.resize(deflateBound(&zs, in.size()));
+  zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(in.data()));
+  zs.avail_in = in.size();
+  zs.next_out = reinterpret_cast<Bytef*>(out.data());
+  zs.avail_out = out.size();
+  deflate(&zs, Z_FINISH);
+  out.resize(zs.total_out);
+  deflateEnd(&zs);
+}
+
+/**
+ * @brief The stand-in server: it reads http requests and answers 204 to each
+ * one.
+ *
+ * @return The number of bytes received.
+ */
+static size_t serve(int fd) {
+  static constexpr std::string_view response =
+      "HTTP/1.1 204 No Content\r\nContent-Length: 0\r\n\r\n";
+  std::vector<char> buf(1 << 16);
+  std::string pending;
+  size_t retval = 0;
+  ssize_t r;
+  while ((r = recv(fd, buf.data(), buf.size(), 0)) > 0) {
+    retval += r;
+    pending.append(buf.data(), r);
+    for (;;) {
+      size_t end = pending.find("\r\n\r\n");
+      if (end == std::string::npos)
+        break;
+      size_t pos = pending.find("Content-Length: ");
+      size_t length = strtoul(pending.c_str() + pos + 16, nullptr, 10);
+      if (pending.size() < end + 4 + length)
+        break;
+      pending.erase(0, end + 4 + length);
+      send(fd, response.data(), response.size(), 0);
+    }
+  }
+  return retval;
+}
+
+struct result {
+  size_t bytes;
+  double cpu;
+  double elapsed;
+};
+
+/**
+ * @brief The client: it builds the bodies and posts them.
+ */
+static result run(mode m, size_t count, size_t batch) {
+  int listener = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t len = sizeof(addr);
+  if (bind(listener, reinterpret_cast<sockaddr*>(&addr), len) < 0 ||
+      listen(listener, 1) < 0 ||
+      getsockname(listener, reinterpret_cast<sockaddr*>(&addr), &len) < 0) {
+    perror("listen");
+    exit(1);
+  }
+
+  size_t received = 0;
+  std::thread server([&] {
+    int fd = accept(listener, nullptr, nullptr);
+    received = serve(fd);
+    close(fd);
+  });
+
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (connect(fd, reinterpret_cast<sockaddr*>(&addr), len) < 0) {
+    perror("connect");
+    exit(1);
+  }
+
+  timespec cpu_start, cpu_end;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu_start);
+  auto start = std::chrono::steady_clock::now();
+
+  http_tsdb::remote_write series;
+  std::string content, body, header;
+  char answer[256];
+  for (size_t done = 0; done < count;) {
+    content.clear();
+    size_t end = std::min(count, done + batch);
+    for (; done < end; ++done) {
+      uint64_t host_id = done / 50 + 1;
+      uint64_t service_id = done / 5 + 1;
+      double value = (done * 7919 % 10000) / 100.0;
+      int64_t time = 1700000000 + done / 1000;
+      std::string host = absl::StrCat("host_", host_id);
+      std::string serv = absl::StrCat("service_", service_id);
+      if (m == remote_write) {
+        series.clear();
+        series.add_label("__name__", "metric_val");
+        series.add_label("id", done + 1);
+        series.add_label("name", "rta");
+        series.add_label("host_id", host_id);
+        series.add_label("serv_id", service_id);
+        series.add_label("unit", "ms");
+        series.add_label("severity_id", 1);
+        series.add_label("host", host);
+        series.add_label("serv", serv);
+        series.add_label("min", 0);
+        series.add_label("max", 100);
+        series.append_series(content, value, time * 1000);
+      } else {
+        absl::StrAppend(&content, "metric,id=", done + 1,
+                        ",name=rta,host_id=", host_id, ",serv_id=", service_id,
+                        ",unit=ms,severity_id=1,host=", host, ",serv=", serv,
+                        ",min=0,max=100 val=", value, " ", time, "\n");
+      }
+    }
+
+    const std::string* to_send = &content;
+    if (m == line_protocol_gzip) {
+      gzip_compress(content, body);
+      to_send = &body;
+    } else if (m == remote_write) {
+      http_tsdb::remote_write::snappy_compress(content, body);
+      to_send = &body;
+    }
+
+    header = absl::StrCat(
+        "POST /write HTTP/1.1\r\nHost: localhost\r\n",
+        m == remote_write
+            ? "Content-Type: application/x-protobuf\r\n"
+              "Content-Encoding: snappy\r\n"
+              "X-Prometheus-Remote-Write-Version: 0.1.0\r\n"
+            : (m == line_protocol_gzip
+                   ? "Content-Type: text/plain\r\nContent-Encoding: gzip\r\n"
+                   : "Content-Type: text/plain\r\n"),
+        "Content-Length: ", to_send->size(), "\r\n\r\n");
+    if (send(fd, header.data(), header.size(), MSG_MORE) < 0 ||
+        send(fd, to_send->data(), to_send->size(), 0) < 0 ||
+        recv(fd, answer, sizeof(answer), 0) <= 0) {
+      fmt::print(stderr, "http error\n");
+      exit(1);
+    }
+  }
+
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu_end);
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  shutdown(fd, SHUT_WR);
+  server.join();
+  close(fd);
+  close(listener);
+
+  return {received,
+          (cpu_end.tv_sec - cpu_start.tv_sec) +
+              (cpu_end.tv_nsec - cpu_start.tv_nsec) / 1e9,
+          elapsed.count()};
+}
+
+int main(int argc, char* argv[]) {
+  static const char* names[] = {"line protocol", "line protocol gzip",
+                                "remote write"};
+  size_t count = argc > 1 ? strtoul(argv[1], nullptr, 10) : 100000;
+  size_t batch = argc > 2 ? strtoul(argv[2], nullptr, 10) : 1000;
+  if (count == 0 || batch == 0) {
+    fmt::print(stderr, "usage: {} [metrics] [metrics per request]\n",
+               argv[0]);
+    return 1;
+  }
+
+  fmt::print("{} metrics by requests of {}, per 100k metrics:\n", count,
+             batch);
+  for (mode m : {line_protocol, line_protocol_gzip, remote_write}) {
+    result r = run(m, count, batch);
+    double ratio = 100000.0 / count;
+    fmt::print("{:>20}: {:>10} bytes on wire, {:>7.1f} ms cpu, {:>7.1f} ms\n",
+               names[m], static_cast<size_t>(r.bytes * ratio),
+               r.cpu * ratio * 1000, r.elapsed * ratio * 1000);
+  }
+  return 0;
+}
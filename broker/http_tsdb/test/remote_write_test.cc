@@ -0,0 +1,227 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include <gtest/gtest.h>
+
+#include <absl/strings/str_cat.h>
+#include <cstring>
+#include <map>
+#include <random>
+
+#include "com/centreon/broker/http_tsdb/remote_write.hh"
+
+using namespace com::centreon::broker;
+
+/**
+ * @brief Reference snappy decoder, it follows the format description and
+ * checks every bound.
+ */
+static bool snappy_uncompress(const std::string& in, std::string& out) {
+  size_t pos = 0;
+  uint64_t len = 0;
+  for (int shift = 0;; shift += 7) {
+    if (pos >= in.size() || shift > 63)
+      return false;
+    uint8_t b = in[pos++];
+    len |= static_cast<uint64_t>(b & 0x7f) << shift;
+    if (!(b & 0x80))
+      break;
+  }
+  out.clear();
+  while (pos < in.size()) {
+    uint8_t tag = in[pos++];
+    size_t length, offset;
+    switch (tag & 3) {
+      case 0:
+        length = tag >> 2;
+        if (length >= 60) {
+          size_t count = length - 59;
+          if (pos + count > in.size())
+            return false;
+          length = 0;
+          for (size_t i = 0; i < count; ++i)
+            length |= static_cast<size_t>(static_cast<uint8_t>(in[pos++]))
+                      << (8 * i);
+        }
+        ++length;
+        if (pos + length > in.size())
+          return false;
+        out.append(in, pos, length);
+        pos += length;
+        continue;
+      case 1:
+        if (pos + 1 > in.size())
+          return false;
+        length = ((tag >> 2) & 7) + 4;
+        offset = ((tag >> 5) << 8) | static_cast<uint8_t>(in[pos++]);
+        break;
+      case 2:
+        if (pos + 2 > in.size())
+          return false;
+        length = (tag >> 2) + 1;
+        offset = static_cast<uint8_t>(in[pos]) |
+                 (static_cast<uint8_t>(in[pos + 1]) << 8);
+        pos += 2;
+        break;
+      default:
+        return false;
+    }
+    if (offset == 0 || offset > out.size())
+      return false;
+    for (size_t i = 0; i < length; ++i)
+      out.push_back(out[out.size() - offset]);
+  }
+  return out.size() == len;
+}
+
+struct series {
+  std::vector<std::pair<std::string, std::string>> labels;
+  double value;
+  int64_t timestamp;
+};
+
+/**
+ * @brief Minimal protobuf reader for the messages we write.
+ */
+class reader {
+  std::string_view _buf;
+
+ public:
+  reader(std::string_view buf) : _buf(buf) {}
+  bool empty() const { return _buf.empty(); }
+  uint64_t varint() {
+    uint64_t retval = 0;
+    for (int shift = 0; !_buf.empty(); shift += 7) {
+      uint8_t b = _buf[0];
+      _buf.remove_prefix(1);
+      retval |= static_cast<uint64_t>(b & 0x7f) << shift;
+      if (!(b & 0x80))
+        break;
+    }
+    return retval;
+  }
+  std::string_view bytes() {
+    size_t len = varint();
+    std::string_view retval = _buf.substr(0, len);
+    _buf.remove_prefix(retval.size());
+    return retval;
+  }
+  double fixed64() {
+    double retval;
+    memcpy(&retval, _buf.data(), sizeof(retval));
+    _buf.remove_prefix(sizeof(retval));
+    return retval;
+  }
+};
+
+static std::vector<series> parse_write_request(std::string_view buf) {
+  std::vector<series> retval;
+  reader wr(buf);
+  while (!wr.empty()) {
+    EXPECT_EQ(wr.varint(), 0x0au);
+    reader ts(wr.bytes());
+    series s;
+    while (!ts.empty()) {
+      uint64_t tag = ts.varint();
+      reader sub(ts.bytes());
+      if (tag == 0x0a) {
+        EXPECT_EQ(sub.varint(), 0x0au);
+        std::string name(sub.bytes());
+        EXPECT_EQ(sub.varint(), 0x12u);
+        std::string value(sub.bytes());
+        s.labels.emplace_back(name, value);
+      } else {
+        EXPECT_EQ(tag, 0x12u);
+        EXPECT_EQ(sub.varint(), 0x09u);
+        s.value = sub.fixed64();
+        EXPECT_EQ(sub.varint(), 0x10u);
+        s.timestamp = sub.varint();
+      }
+      EXPECT_TRUE(sub.empty());
+    }
+    retval.push_back(std::move(s));
+  }
+  return retval;
+}
+
+TEST(HttpTsdbRemoteWrite, Series) {
+  http_tsdb::remote_write rw;
+  std::string body;
+
+  rw.add_label("__name__", "metric_val");
+  rw.add_label("id", 12345);
+  rw.add_label("name", std::string("rta"));
+  rw.add_line_protocol_tags(",host=my\\ host,serv=ping\\,1 field=3");
+  rw.append_series(body, 1.5, 1700000000000);
+
+  rw.clear();
+  rw.add_label("__name__", "status_val");
+  rw.add_line_protocol_tags(",empty=,host_grp=grp");
+  rw.append_series(body, 75, 1700000001000);
+
+  std::vector<series> result = parse_write_request(body);
+  ASSERT_EQ(result.size(), 2u);
+  std::vector<std::pair<std::string, std::string>> expected{
+      {"__name__", "metric_val"},
+      {"host", "my host"},
+      {"id", "12345"},
+      {"name", "rta"},
+      {"serv", "ping,1"}};
+  ASSERT_EQ(result[0].labels, expected);
+  ASSERT_EQ(result[0].value, 1.5);
+  ASSERT_EQ(result[0].timestamp, 1700000000000);
+
+  expected = {{"__name__", "status_val"}, {"empty", ""}, {"host_grp", "grp"}};
+  ASSERT_EQ(result[1].labels, expected);
+  ASSERT_EQ(result[1].value, 75);
+  ASSERT_EQ(result[1].timestamp, 1700000001000);
+}
+
+TEST(HttpTsdbRemoteWrite, SnappyRoundTrip) {
+  std::mt19937 gen(42);
+  std::vector<std::string> inputs{"", "a", "abcdabcdabcdabcdabcdabcd",
+                                  std::string(200000, 'x')};
+  std::string random(150000, 0);
+  for (char& c : random)
+    c = gen() & 0xff;
+  inputs.push_back(random);
+
+  /* Something looking like a real body: repetitive with some noise. */
+  http_tsdb::remote_write rw;
+  std::string body;
+  for (int i = 0; i < 5000; ++i) {
+    rw.clear();
+    rw.add_label("__name__", "metric_val");
+    rw.add_label("id", i);
+    rw.add_label("host", "host_", i % 100);
+    rw.append_series(body, gen() % 1000 / 10.0, 1700000000000 + i);
+  }
+  inputs.push_back(body);
+
+  for (const std::string& in : inputs) {
+    std::string compressed, uncompressed;
+    http_tsdb::remote_write::snappy_compress(in, compressed);
+    ASSERT_TRUE(snappy_uncompress(compressed, uncompressed));
+    ASSERT_EQ(uncompressed, in);
+  }
+
+  std::string compressed;
+  http_tsdb::remote_write::snappy_compress(body, compressed);
+  ASSERT_LT(compressed.size(), body.size() / 3);
+}
@@ -45,6 +45,9 @@ namespace com::centreon::broker::lua {
  *  to this object. So almost every script working on version 1 should also
  *  work with version 2.
  *
+ *  Version 3 uses the same userdata, the write_batch() function of the
+ *  script receiving an array of them.
+ *
  */
 class broker_event {
   struct gc_info {
@@ -38,7 +38,8 @@ class connector : public io::endpoint {
   connector& operator=(connector const&) = delete;
   void connect_to(std::string const& lua_script,
                   std::map<std::string, misc::variant> const& cfg_params,
-                  std::shared_ptr<persistent_cache> const& cache);
+                  std::shared_ptr<persistent_cache> const& cache,
+                  uint32_t workers = 1);
   std::shared_ptr<io::stream> open() override;
 
   const std::map<std::string, misc::variant>& conf_params() const {
@@ -49,6 +50,8 @@ class connector : public io::endpoint {
   std::string _lua_script;
   std::map<std::string, misc::variant> _conf_params;
   std::shared_ptr<persistent_cache> _cache;
+  /* Number of Lua interpreters, more than one gives a parallel_stream. */
+  uint32_t _workers;
 };
 
 }  // namespace com::centreon::broker::lua
@@ -0,0 +1,138 @@
+/**
+ * Copyright 2025 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCB_LUA_COW_MAP_HH
+#define CCB_LUA_COW_MAP_HH
+
+#include <array>
+#include <bitset>
+
+namespace com::centreon::broker::lua {
+
+/**
+ *  @class cow_map cow_map.hh "com/centreon/broker/lua/cow_map.hh"
+ *  @brief Copy-on-write map, split into shards.
+ *
+ *  Copying a cow_map only copies pointers to its shards, the shards being
+ *  shared with the original. The first modification of a shard through the
+ *  copy makes it a private copy of this shard, the other ones are still
+ *  shared. So a new version of a big map modified on a few keys only costs the
+ *  copy of a few shards.
+ *
+ *  A cow_map is modified by one writer, between two calls to
+ *  start_version(). Once published, a version is only read: it must not be
+ *  modified anymore, only copied.
+ *
+ *  @tparam Key The key type.
+ *  @tparam Map The type of a shard, a map of Key.
+ *  @tparam N The number of shards. With N = 1, the whole map is available
+ *  through map(), useful for ordered maps.
+ */
+template <typename Key, typename Map, size_t N = 1>
+class cow_map {
+  std::array<std::shared_ptr<Map>, N> _shards;
+  /* Shards already copied since the last start_version(). */
+  std::bitset<N> _owned;
+
+  static size_t _shard_of(const Key& k) {
+    if constexpr (N == 1)
+      return 0;
+    else
+      return absl::Hash<Key>{}(k) % N;
+  }
+
+ public:
+  using mapped_type = typename Map::mapped_type;
+
+  cow_map() {
+    for (auto& s : _shards)
+      s = std::make_shared<Map>();
+    _owned.set();
+  }
+
+  /**
+   * @brief Start a new version: the next modifications of a shard copy it.
+   * To call on a copy of the published version, before modifying it.
+   */
+  void start_version() { _owned.reset(); }
+
+  /**
+   * @brief Find the value of a key.
+   *
+   * @param k The key.
+   *
+   * @return A pointer to the value or nullptr if not found.
+   */
+  const mapped_type* find(const Key& k) const {
+    const Map& m = *_shards[_shard_of(k)];
+    auto found = m.find(k);
+    return found == m.end() ? nullptr : &found->second;
+  }
+
+  /**
+   * @brief Get the shard containing a key, to modify it. The shard is copied
+   * if it is still shared with a published version.
+   *
+   * @param k The key.
+   *
+   * @return The shard.
+   */
+  Map& mut(const Key& k) {
+    size_t idx = _shard_of(k);
+    if (!_owned[idx]) {
+      _shards[idx] = std::make_shared<Map>(*_shards[idx]);
+      _owned.set(idx);
+    }
+    return *_shards[idx];
+  }
+
+  void set(const Key& k, mapped_type v) { mut(k)[k] = std::move(v); }
+
+  void erase(const Key& k) {
+    if (find(k))
+      mut(k).erase(k);
+  }
+
+  void clear() {
+    for (auto& s : _shards)
+      s = std::make_shared<Map>();
+    _owned.set();
+  }
+
+  /**
+   * @brief The whole map, only available with one shard.
+   */
+  const Map& map() const {
+    static_assert(N == 1, "map() needs a cow_map with only one shard");
+    return *_shards[0];
+  }
+
+  /**
+   * @brief Call f on each (key, value) pair.
+   */
+  template <typename F>
+  void for_each(F&& f) const {
+    for (auto& s : _shards)
+      for (auto& p : *s)
+        f(p);
+  }
+};
+
+}  // namespace com::centreon::broker::lua
+
+#endif  // !CCB_LUA_COW_MAP_HH
@@ -0,0 +1,50 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCB_LUA_EVENT_IDS_HH
+#define CCB_LUA_EVENT_IDS_HH
+
+#include "com/centreon/broker/io/protobuf.hh"
+
+namespace com::centreon::broker::lua {
+
+/**
+ *  @class event_ids event_ids.hh "com/centreon/broker/lua/event_ids.hh"
+ *  @brief Extract the host_id and the service_id of events.
+ *
+ *  Only protobuf events are handled, their fields are found by reflection.
+ *  The field descriptors are looked up once per event type. This object is
+ *  not thread safe.
+ */
+class event_ids {
+  struct fields {
+    const google::protobuf::FieldDescriptor* host_id;
+    const google::protobuf::FieldDescriptor* service_id;
+  };
+  absl::flat_hash_map<uint32_t, fields> _fields;
+
+  const fields& _fields_of(const io::data& d);
+
+ public:
+  uint64_t host_id(const io::data& d);
+  std::pair<uint64_t, uint64_t> host_service_id(const io::data& d);
+};
+
+}  // namespace com::centreon::broker::lua
+
+#endif  // !CCB_LUA_EVENT_IDS_HH
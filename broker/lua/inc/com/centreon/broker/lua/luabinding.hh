@@ -19,6 +19,7 @@
 #ifndef CCB_LUA_LUABINDING_HH
 #define CCB_LUA_LUABINDING_HH
 
+#include "com/centreon/broker/lua/event_ids.hh"
 #include "com/centreon/broker/lua/macro_cache.hh"
 #include "com/centreon/broker/misc/variant.hh"
 
@@ -79,6 +80,27 @@ namespace com::centreon::broker::lua {
  *    queue and events are acknowledged so it will be possible again to call the
  *    write() function.
  *
+ *  With the api v3 (broker_api_version = 3), events are given as userdata as
+ *  with the v2 api, and two more features are available:
+ *  * a global table broker_filter, that may be set by init(conf). It
+ *    declares the events the script is interested in, and is evaluated in C++
+ *    before entering Lua. Its fields are all optional:
+ *
+ *        broker_filter = {
+ *          categories = { 1, 3 },          -- accepted categories
+ *          elements = { { 6, 1 } },        -- accepted {category, element}
+ *          hosts = { 12, 15 },             -- accepted host ids
+ *          services = { { 12, 18 } },      -- accepted {host_id, service_id}
+ *        }
+ *
+ *    An event is accepted if its category or its type is declared (or if
+ *    none are declared), and if it is tied to a declared host or service (or
+ *    if none are declared, or if the event is not tied to a host).
+ *  * a global function write_batch(events) that can replace write(). It
+ *    receives an array of events. Events are given to it when
+ *    broker_batch_size events (1000 by default) are waiting or when Broker
+ *    flushes the stream. It returns true to acknowledge the events as write()
+ *    does.
  */
 class luabinding {
   // The Lua state machine.
@@ -96,9 +118,21 @@ class luabinding {
   // Count on events
   int32_t _total;
 
-  // Api version among (1, 2)
+  // Api version among (1, 2, 3)
   uint32_t _broker_api_version;
 
+  // True if there is a write_batch() function in the Lua script (api v3).
+  bool _write_batch;
+  uint32_t _batch_size;
+  std::vector<std::shared_ptr<io::data>> _batch;
+
+  // The events accepted by the script (api v3), empty sets accept everything.
+  absl::flat_hash_set<uint16_t> _accepted_categories;
+  absl::flat_hash_set<uint32_t> _accepted_types;
+  absl::flat_hash_set<uint64_t> _accepted_hosts;
+  absl::flat_hash_set<std::pair<uint64_t, uint64_t>> _accepted_services;
+  event_ids _ids;
+
   // logger.
   std::shared_ptr<spdlog::logger> _logger;
 
@@ -106,6 +140,9 @@ class luabinding {
   void _load_script(const std::string& lua_script);
   void _init_script(std::map<std::string, misc::variant> const& conf_params);
   void _update_lua_path(std::string const& path);
+  void _load_filter();
+  bool _accept(const io::data& d);
+  int32_t _send_batch() noexcept;
 
  public:
   luabinding(std::string const& lua_script,
@@ -117,6 +154,7 @@ class luabinding {
   bool has_filter() const noexcept;
   int32_t write(std::shared_ptr<io::data> const& data) noexcept;
   bool has_flush() const noexcept;
+  bool has_batch() const noexcept;
   int32_t flush() noexcept;
   int32_t stop();
 };
@@ -20,132 +20,234 @@
 #define CCB_LUA_MACRO_CACHE_HH
 
 #include "com/centreon/broker/bam/internal.hh"
+#include "com/centreon/broker/lua/cow_map.hh"
 #include "com/centreon/broker/lua/internal.hh"
 #include "com/centreon/broker/neb/internal.hh"
 #include "com/centreon/broker/persistent_cache.hh"
 
-namespace com::centreon::broker::lua {
+namespace com::centreon::broker {
+namespace multiplexing {
+class muxer;
+}
+
+namespace lua {
 
 /**
  *  @class macro_cache macro_cache.hh "com/centreon/broker/lua/macro_cache.hh"
  *  @brief Data cache for Lua macro.
+ *
+ *  A single cache is shared by all the Lua outputs of broker (see instance()),
+ *  each one reading it from its own thread. It is not fed by the outputs but
+ *  by its own muxer, subscribed to the neb, storage and bam categories: so its
+ *  content does not depend on the filters of an output nor on its backlog.
+ *  Like the outputs, it receives the events asynchronously, so an output
+ *  without backlog may handle an event just before the cache contains it.
+ *
+ *  The content is immutable. Each batch of events received by the muxer is
+ *  applied to a copy of the current content, that is then published in place
+ *  of it with std::atomic_store(). The maps are copy-on-write (see cow_map),
+ *  so a new version only copies the shards modified by the batch. The getters
+ *  never wait for a writer, and the objects they return stay valid even if
+ *  the cache is updated meanwhile.
  */
 class macro_cache {
-  std::shared_ptr<persistent_cache> _cache;
-  absl::flat_hash_map<uint64_t, std::shared_ptr<neb::pb_instance>> _instances;
-  absl::flat_hash_map<uint64_t, std::shared_ptr<neb::pb_host>> _hosts;
-  /* The host groups cache stores also a set with the pollers telling they need
-   * the cache. So if no more poller needs a host group, we can remove it from
-   * the cache. */
-  absl::flat_hash_map<uint64_t,
-                      std::pair<std::shared_ptr<neb::pb_host_group>,
-                                absl::flat_hash_set<uint32_t>>>
-      _host_groups;
-  absl::btree_map<std::pair<uint64_t, uint64_t>,
-                  std::shared_ptr<neb::pb_host_group_member>>
-      _host_group_members;
-  absl::flat_hash_map<std::pair<uint64_t, uint64_t>,
-                      std::shared_ptr<neb::pb_custom_variable>>
-      _custom_vars;
-  absl::flat_hash_map<std::pair<uint64_t, uint64_t>,
-                      std::shared_ptr<neb::pb_service>>
-      _services;
-  /* The service groups cache stores also a set with the pollers telling they
-   * need the cache. So if no more poller needs a service group, we can remove
-   * it from the cache. */
-  absl::flat_hash_map<uint64_t,
-                      std::pair<std::shared_ptr<neb::pb_service_group>,
-                                absl::flat_hash_set<uint32_t>>>
-      _service_groups;
-  absl::btree_map<std::tuple<uint64_t, uint64_t, uint64_t>,
-                  std::shared_ptr<neb::pb_service_group_member>>
-      _service_group_members;
-  absl::flat_hash_map<uint64_t, std::shared_ptr<storage::pb_index_mapping>>
-      _index_mappings;
-  absl::flat_hash_map<uint64_t, std::shared_ptr<storage::pb_metric_mapping>>
-      _metric_mappings;
-  absl::flat_hash_map<uint64_t, std::shared_ptr<bam::pb_dimension_ba_event>>
-      _dimension_ba_events;
-  std::unordered_multimap<
-      uint64_t,
-      std::shared_ptr<bam::pb_dimension_ba_bv_relation_event>>
-      _dimension_ba_bv_relation_events;
-  absl::flat_hash_map<uint64_t, std::shared_ptr<bam::pb_dimension_bv_event>>
-      _dimension_bv_events;
+ public:
+  /* A version of the cache content. */
+  struct content {
+    cow_map<uint64_t,
+            absl::flat_hash_map<uint64_t, std::shared_ptr<neb::pb_instance>>>
+        instances;
+    cow_map<uint64_t,
+            absl::flat_hash_map<uint64_t, std::shared_ptr<neb::pb_host>>,
+            64>
+        hosts;
+    /* The host groups cache stores also a set with the pollers telling they
+     * need the cache. So if no more poller needs a host group, we can remove
+     * it from the cache. */
+    cow_map<uint64_t,
+            absl::flat_hash_map<
+                uint64_t,
+                std::pair<std::shared_ptr<neb::pb_host_group>,
+                          absl::flat_hash_set<uint32_t>>>>
+        host_groups;
+    cow_map<std::pair<uint64_t, uint64_t>,
+            absl::btree_map<std::pair<uint64_t, uint64_t>,
+                            std::shared_ptr<neb::pb_host_group_member>>>
+        host_group_members;
+    cow_map<std::pair<uint64_t, uint64_t>,
+            absl::flat_hash_map<std::pair<uint64_t, uint64_t>,
+                                std::shared_ptr<neb::pb_custom_variable>>,
+            16>
+        custom_vars;
+    cow_map<std::pair<uint64_t, uint64_t>,
+            absl::flat_hash_map<std::pair<uint64_t, uint64_t>,
+                                std::shared_ptr<neb::pb_service>>,
+            256>
+        services;
+    /* The service groups cache stores also a set with the pollers telling
+     * they need the cache. So if no more poller needs a service group, we can
+     * remove it from the cache. */
+    cow_map<uint64_t,
+            absl::flat_hash_map<
+                uint64_t,
+                std::pair<std::shared_ptr<neb::pb_service_group>,
+                          absl::flat_hash_set<uint32_t>>>>
+        service_groups;
+    cow_map<std::tuple<uint64_t, uint64_t, uint64_t>,
+            absl::btree_map<std::tuple<uint64_t, uint64_t, uint64_t>,
+                            std::shared_ptr<neb::pb_service_group_member>>>
+        service_group_members;
+    cow_map<uint64_t,
+            absl::flat_hash_map<uint64_t,
+                                std::shared_ptr<storage::pb_index_mapping>>,
+            64>
+        index_mappings;
+    cow_map<uint64_t,
+            absl::flat_hash_map<uint64_t,
+                                std::shared_ptr<storage::pb_metric_mapping>>,
+            64>
+        metric_mappings;
+    cow_map<uint64_t,
+            absl::flat_hash_map<uint64_t,
+                                std::shared_ptr<bam::pb_dimension_ba_event>>>
+        dimension_ba_events;
+    cow_map<uint64_t,
+            std::unordered_multimap<
+                uint64_t,
+                std::shared_ptr<bam::pb_dimension_ba_bv_relation_event>>>
+        dimension_ba_bv_relation_events;
+    cow_map<uint64_t,
+            absl::flat_hash_map<uint64_t,
+                                std::shared_ptr<bam::pb_dimension_bv_event>>>
+        dimension_bv_events;
+
+    void start_version();
+  };
+
+ private:
+  static absl::Mutex _instance_m;
+  static std::shared_ptr<macro_cache> _instance ABSL_GUARDED_BY(_instance_m);
+
+  std::shared_ptr<spdlog::logger> _logger;
+
+  /* The persistent cache of the shared cache, nullptr for a private one. */
+  std::shared_ptr<persistent_cache> _pcache;
+  /* The muxer feeding the shared cache. */
+  std::shared_ptr<multiplexing::muxer> _muxer;
+
+  /* Serializes the writers. */
+  absl::Mutex _write_m;
+  /* The published content, only accessed through std::atomic_load() and
+   * std::atomic_store(). */
+  std::shared_ptr<const content> _content;
+
+  void _load(persistent_cache& cache);
+  void _process(content& c, const std::shared_ptr<io::data>& data);
 
  public:
+  /**
+   *  While a pin exists, the getters called from its thread on the cache read
+   *  the pinned version of the content instead of the current one.
+   */
+  class pin {
+    const macro_cache* _prev_cache;
+    std::shared_ptr<const content> _prev_version;
+
+   public:
+    pin(const macro_cache& cache, std::shared_ptr<const content> version);
+    pin(const pin&) = delete;
+    pin& operator=(const pin&) = delete;
+    ~pin() noexcept;
+  };
+
+  static std::shared_ptr<macro_cache> instance(
+      const std::shared_ptr<persistent_cache>& cache);
+  static void unload();
+
   macro_cache(const std::shared_ptr<persistent_cache>& cache);
   macro_cache(const macro_cache&) = delete;
-  ~macro_cache();
+  macro_cache& operator=(const macro_cache&) = delete;
+  ~macro_cache() noexcept;
 
   void write(std::shared_ptr<io::data> const& data);
+  void write(const std::vector<std::shared_ptr<io::data>>& events);
+  void save(persistent_cache& cache) const;
+  std::shared_ptr<const content> current() const;
 
-  const storage::pb_index_mapping& get_index_mapping(uint64_t index_id) const;
-  const std::shared_ptr<storage::pb_metric_mapping>& get_metric_mapping(
+  std::shared_ptr<storage::pb_index_mapping> get_index_mapping(
+      uint64_t index_id) const;
+  std::shared_ptr<storage::pb_metric_mapping> get_metric_mapping(
       uint64_t metric_id) const;
-  const std::shared_ptr<neb::pb_host>& get_host(uint64_t host_id) const;
-  const std::shared_ptr<neb::pb_service>& get_service(
-      uint64_t host_id,
-      uint64_t service_id) const;
-  const std::string& get_host_name(uint64_t host_id) const;
-  const std::string& get_notes_url(uint64_t host_id, uint64_t service_id) const;
-  const std::string& get_notes(uint64_t host_id, uint64_t service_id) const;
-  const std::string& get_action_url(uint64_t host_id,
-                                    uint64_t service_id) const;
+  std::shared_ptr<neb::pb_host> get_host(uint64_t host_id) const;
+  std::shared_ptr<neb::pb_service> get_service(uint64_t host_id,
+                                               uint64_t service_id) const;
+  std::string get_host_name(uint64_t host_id) const;
+  std::string get_notes_url(uint64_t host_id, uint64_t service_id) const;
+  std::string get_notes(uint64_t host_id, uint64_t service_id) const;
+  std::string get_action_url(uint64_t host_id, uint64_t service_id) const;
   int32_t get_severity(uint64_t host_id, uint64_t service_id) const;
-  std::string_view get_check_command(uint64_t host_id,
-                                     uint64_t service_id = 0) const;
-  const std::string& get_host_group_name(uint64_t id) const;
-  const std::string& get_host_group_alias(uint64_t id) const;
-  absl::btree_map<std::pair<uint64_t, uint64_t>,
-                  std::shared_ptr<neb::pb_host_group_member>> const&
-  get_host_group_members() const;
-  const std::string& get_service_description(uint64_t host_id,
-                                             uint64_t service_id) const;
-  const std::string& get_service_group_name(uint64_t id) const;
-  absl::btree_map<std::tuple<uint64_t, uint64_t, uint64_t>,
-                  std::shared_ptr<neb::pb_service_group_member>> const&
-  get_service_group_members() const;
-  const std::string& get_instance(uint64_t instance_id) const;
-
-  const std::unordered_multimap<
-      uint64_t,
-      std::shared_ptr<bam::pb_dimension_ba_bv_relation_event>>&
-  get_dimension_ba_bv_relation_events() const;
-  const std::shared_ptr<bam::pb_dimension_ba_event>& get_dimension_ba_event(
+  std::string get_check_command(uint64_t host_id,
+                                uint64_t service_id = 0) const;
+  std::string get_host_group_name(uint64_t id) const;
+  std::string get_host_group_alias(uint64_t id) const;
+  std::vector<std::shared_ptr<neb::pb_host_group_member>>
+  get_host_group_members(uint64_t host_id) const;
+  std::string get_service_description(uint64_t host_id,
+                                      uint64_t service_id) const;
+  std::string get_service_group_name(uint64_t id) const;
+  std::vector<std::shared_ptr<neb::pb_service_group_member>>
+  get_service_group_members(uint64_t host_id, uint64_t service_id) const;
+  std::string get_instance(uint64_t instance_id) const;
+
+  std::vector<uint64_t> get_dimension_bv_ids(uint64_t ba_id) const;
+  std::shared_ptr<bam::pb_dimension_ba_event> get_dimension_ba_event(
       uint64_t id) const;
-  const std::shared_ptr<bam::pb_dimension_bv_event>& get_dimension_bv_event(
+  std::shared_ptr<bam::pb_dimension_bv_event> get_dimension_bv_event(
       uint64_t id) const;
 
  private:
-  macro_cache& operator=(macro_cache const& f);
-
-  void _process_pb_instance(std::shared_ptr<io::data> const& data);
-  void _process_pb_host(std::shared_ptr<io::data> const& data);
-  void _process_pb_host_status(std::shared_ptr<io::data> const& data);
-  void _process_pb_adaptive_host_status(const std::shared_ptr<io::data>& data);
-  void _process_pb_adaptive_host(std::shared_ptr<io::data> const& data);
-  void _process_pb_host_group(std::shared_ptr<io::data> const& data);
-  void _process_pb_host_group_member(std::shared_ptr<io::data> const& data);
-  void _process_pb_custom_variable(std::shared_ptr<io::data> const& data);
-  void _process_pb_service(std::shared_ptr<io::data> const& data);
-  void _process_pb_service_status(const std::shared_ptr<io::data>& data);
+  void _process_pb_instance(content& c, const std::shared_ptr<io::data>& data);
+  void _process_pb_host(content& c, const std::shared_ptr<io::data>& data);
+  void _process_pb_host_status(content& c,
+                               const std::shared_ptr<io::data>& data);
+  void _process_pb_adaptive_host_status(content& c,
+                                        const std::shared_ptr<io::data>& data);
+  void _process_pb_adaptive_host(content& c,
+                                 const std::shared_ptr<io::data>& data);
+  void _process_pb_host_group(content& c,
+                              const std::shared_ptr<io::data>& data);
+  void _process_pb_host_group_member(content& c,
+                                     const std::shared_ptr<io::data>& data);
+  void _process_pb_custom_variable(content& c,
+                                   const std::shared_ptr<io::data>& data);
+  void _process_pb_service(content& c, const std::shared_ptr<io::data>& data);
+  void _process_pb_service_status(content& c,
+                                  const std::shared_ptr<io::data>& data);
   void _process_pb_adaptive_service_status(
+      content& c,
       const std::shared_ptr<io::data>& data);
-  void _process_pb_adaptive_service(std::shared_ptr<io::data> const& data);
-  void _process_pb_service_group(std::shared_ptr<io::data> const& data);
-  void _process_pb_service_group_member(std::shared_ptr<io::data> const& data);
-  void _process_index_mapping(std::shared_ptr<io::data> const& data);
-  void _process_metric_mapping(std::shared_ptr<io::data> const& data);
-  void _process_dimension_ba_event(std::shared_ptr<io::data> const& data);
+  void _process_pb_adaptive_service(content& c,
+                                    const std::shared_ptr<io::data>& data);
+  void _process_pb_service_group(content& c,
+                                 const std::shared_ptr<io::data>& data);
+  void _process_pb_service_group_member(content& c,
+                                        const std::shared_ptr<io::data>& data);
+  void _process_index_mapping(content& c,
+                              const std::shared_ptr<io::data>& data);
+  void _process_metric_mapping(content& c,
+                               const std::shared_ptr<io::data>& data);
+  void _process_dimension_ba_event(content& c,
+                                   const std::shared_ptr<io::data>& data);
   void _process_dimension_ba_bv_relation_event(
-      std::shared_ptr<io::data> const& data);
-  void _process_dimension_bv_event(std::shared_ptr<io::data> const& data);
+      content& c,
+      const std::shared_ptr<io::data>& data);
+  void _process_dimension_bv_event(content& c,
+                                   const std::shared_ptr<io::data>& data);
   void _process_pb_dimension_truncate_table_signal(
-      std::shared_ptr<io::data> const& data);
-
-  void _save_to_disk();
+      content& c,
+      const std::shared_ptr<io::data>& data);
 };
-}  // namespace com::centreon::broker::lua
+}  // namespace lua
+}  // namespace com::centreon::broker
 
 #endif  // !CCB_LUA_MACRO_CACHE_HH
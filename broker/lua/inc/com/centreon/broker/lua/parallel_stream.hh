@@ -0,0 +1,121 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCB_LUA_PARALLEL_STREAM_HH
+#define CCB_LUA_PARALLEL_STREAM_HH
+
+#include "com/centreon/broker/lua/event_ids.hh"
+#include "com/centreon/broker/lua/luabinding.hh"
+#include "com/centreon/broker/lua/macro_cache.hh"
+#include "com/centreon/broker/misc/variant.hh"
+
+namespace com::centreon::broker::lua {
+
+/**
+ *  @class parallel_stream parallel_stream.hh
+ *  "com/centreon/broker/lua/parallel_stream.hh"
+ *  @brief Lua stream running several Lua interpreters.
+ *
+ *  The script is loaded in several workers, each one with its own thread and
+ *  its own Lua state, the macro cache being shared by all of them. Events are
+ *  partitioned by host_id, so all the events of a host are handled by the
+ *  same worker, in the order they are received. Events not tied to a host
+ *  (instances, groups, BA events...) are given to the first worker's script.
+ *
+ *  The macro cache is the one shared by all the Lua streams, fed by its own
+ *  muxer: it contains the events handled by the other workers too (a metric
+ *  mapping for example). Each worker has its own view of it: the version of
+ *  its content when an event is received is queued with the event, and pinned
+ *  while the script handles it. So a late worker does not see a cache updated
+ *  by events received after the one it handles.
+ *
+ *  Each worker acknowledges its own events. Since the muxer can only
+ *  acknowledge events from the beginning of its queue, the stream keeps the
+ *  worker of each event in the order they were written, and only returns the
+ *  acknowledgements of the longest prefix whose events are all acknowledged.
+ */
+class parallel_stream : public io::stream {
+  class worker {
+    const macro_cache& _cache;
+    luabinding _luabinding;
+
+    std::thread _thread;
+    std::mutex _m;
+    std::condition_variable _cv;
+    /* Events to give to the script, with the version of the macro cache
+     * content when they were received. */
+    std::deque<std::pair<std::shared_ptr<io::data>,
+                         std::shared_ptr<const macro_cache::content>>>
+        _queue;
+    /* The version of the last event handled, used by flush(). */
+    std::shared_ptr<const macro_cache::content> _version;
+    /* Incremented by ask_flush(), the worker sets _flushed to it when done. */
+    uint32_t _flush_asked = 0;
+    uint32_t _flushed = 0;
+    bool _exit = false;
+    /* Events of this worker acknowledged by the script and not yet returned
+     * by the stream. */
+    std::atomic<int32_t> _acks{0};
+
+    void _run();
+
+   public:
+    worker(const std::string& lua_script,
+           const std::map<std::string, misc::variant>& conf_params,
+           macro_cache& cache,
+           uint32_t id);
+    worker(const worker&) = delete;
+    worker& operator=(const worker&) = delete;
+    ~worker() noexcept;
+    void push(const std::shared_ptr<io::data>& d,
+              std::shared_ptr<const macro_cache::content> version);
+    uint32_t ask_flush();
+    void wait_flush(uint32_t ticket);
+    void stop();
+    bool take_ack();
+  };
+
+  std::shared_ptr<spdlog::logger> _logger;
+  std::shared_ptr<macro_cache> _cache;
+  std::vector<std::unique_ptr<worker>> _workers;
+
+  /* The worker of each event not acknowledged yet, in the muxer order. */
+  std::deque<uint32_t> _pending;
+  bool _stopped = false;
+
+  event_ids _ids;
+
+  int32_t _pop_acks();
+
+ public:
+  parallel_stream(const std::string& lua_script,
+                  const std::map<std::string, misc::variant>& conf_params,
+                  const std::shared_ptr<persistent_cache>& cache,
+                  uint32_t workers_count);
+  ~parallel_stream() noexcept;
+  parallel_stream& operator=(const parallel_stream&) = delete;
+  parallel_stream(const parallel_stream&) = delete;
+  bool read(std::shared_ptr<io::data>& d, time_t deadline) override;
+  int write(std::shared_ptr<io::data> const& d) override;
+  int32_t flush() override;
+  int32_t stop() override;
+};
+
+}  // namespace com::centreon::broker::lua
+
+#endif  // !CCB_LUA_PARALLEL_STREAM_HH
@@ -49,13 +49,13 @@ namespace com::centreon::broker::lua {
  *  exit, the thread waits for 500ms before rechecking events.
  */
 class stream : public io::stream {
-  /* The Lua engine */
-  luabinding _luabinding;
-
   std::shared_ptr<spdlog::logger> _logger;
 
-  /* Macro cache */
-  macro_cache _cache;
+  /* The macro cache shared by all the Lua streams. */
+  std::shared_ptr<macro_cache> _cache;
+
+  /* The Lua engine */
+  luabinding _luabinding;
 
  public:
   stream(std::string const& lua_script,
@@ -49,7 +49,8 @@ static int l_broker_cache_get_ba_v1(lua_State* L) {
   int ba_id(luaL_checkinteger(L, 2));
 
   try {
-    const DimensionBaEvent& ba(cache->get_dimension_ba_event(ba_id)->obj());
+    auto dba = cache->get_dimension_ba_event(ba_id);
+    const DimensionBaEvent& ba(dba->obj());
     lua_createtable(L, 0, 7);
     lua_pushinteger(L, ba.ba_id());
     lua_setfield(L, -2, "ba_id");
@@ -98,7 +99,8 @@ static int l_broker_cache_get_bv_v1(lua_State* L) {
   int bv_id(luaL_checkinteger(L, 2));
 
   try {
-    const bam::pb_dimension_bv_event& bv(*cache->get_dimension_bv_event(bv_id));
+    auto dbv = cache->get_dimension_bv_event(bv_id);
+    const bam::pb_dimension_bv_event& bv(*dbv);
     lua_createtable(L, 0, 3);
     lua_pushinteger(L, bv.obj().bv_id());
     lua_setfield(L, -2, "bv_id");
@@ -142,17 +144,15 @@ static int l_broker_cache_get_bvs(lua_State* L) {
       *static_cast<macro_cache**>(luaL_checkudata(L, 1, "lua_broker_cache")));
   uint32_t ba_id(luaL_checkinteger(L, 2));
 
-  auto const& relations(cache->get_dimension_ba_bv_relation_events());
-  auto it = relations.find(ba_id);
+  std::vector<uint64_t> bv_ids(cache->get_dimension_bv_ids(ba_id));
 
   lua_newtable(L);
 
   int i = 1;
-  while (it != relations.end() && it->first == ba_id) {
-    lua_pushinteger(L, it->second->obj().bv_id());
+  for (uint64_t bv_id : bv_ids) {
+    lua_pushinteger(L, bv_id);
     lua_rawseti(L, -2, i);
     ++i;
-    ++it;
   }
   return 1;
 }
@@ -314,9 +314,8 @@ static int l_broker_cache_get_index_mapping(lua_State* L) {
   int index_id(luaL_checkinteger(L, 2));
 
   try {
-    const storage::pb_index_mapping& mapping{
-        cache->get_index_mapping(index_id)};
-    const auto& m_obj = mapping.obj();
+    auto mapping = cache->get_index_mapping(index_id);
+    const auto& m_obj = mapping->obj();
     lua_createtable(L, 0, 3);
 
     lua_pushinteger(L, m_obj.index_id());
@@ -371,9 +370,8 @@ static int l_broker_cache_get_metric_mapping_v1(lua_State* L) {
   int metric_id(luaL_checkinteger(L, 2));
 
   try {
-    const storage::pb_metric_mapping& mapping(
-        *cache->get_metric_mapping(metric_id));
-    const auto& m_obj = mapping.obj();
+    auto mapping = cache->get_metric_mapping(metric_id);
+    const auto& m_obj = mapping->obj();
     lua_createtable(L, 0, 2);
 
     lua_pushinteger(L, m_obj.metric_id());
@@ -394,9 +392,7 @@ static int l_broker_cache_get_metric_mapping_v2(lua_State* L) {
   int metric_id(luaL_checkinteger(L, 2));
 
   try {
-    const std::shared_ptr<storage::pb_metric_mapping>& mm{
-        cache->get_metric_mapping(metric_id)};
-    broker_event::create(L, mm);
+    broker_event::create(L, cache->get_metric_mapping(metric_id));
   } catch (std::exception const& e) {
     (void)e;
     lua_pushnil(L);
@@ -465,20 +461,15 @@ static int l_broker_cache_get_servicegroups(lua_State* L) {
   uint64_t host_id(luaL_checkinteger(L, 2));
   uint64_t service_id(luaL_checkinteger(L, 3));
 
-  auto const& members = cache->get_service_group_members();
-
-  auto first(members.lower_bound(std::make_tuple(host_id, service_id, 0)));
-  auto second(members.upper_bound(std::make_tuple(host_id, service_id + 1, 0)));
+  auto members = cache->get_service_group_members(host_id, service_id);
 
   lua_newtable(L);
 
-  if (first != members.end()) {
+  if (!members.empty()) {
     int i{1};
-    for (auto it(first), end(second); it != end; ++it) {
+    for (auto& m : members) {
       lua_createtable(L, 0, 2);
-      const ServiceGroupMember& sgm =
-          std::static_pointer_cast<neb::pb_service_group_member>(it->second)
-              ->obj();
+      const ServiceGroupMember& sgm = m->obj();
 
       lua_pushinteger(L, sgm.servicegroup_id());
       lua_setfield(L, -2, "group_id");
@@ -505,20 +496,14 @@ static int l_broker_cache_get_hostgroups(lua_State* L) {
       *static_cast<macro_cache**>(luaL_checkudata(L, 1, "lua_broker_cache"))};
   uint64_t id{static_cast<uint64_t>(luaL_checkinteger(L, 2))};
 
-  auto const& members = cache->get_host_group_members();
-
-  auto const first = members.lower_bound({id, 0});
-  auto const second = members.upper_bound({id + 1, 0});
+  auto members = cache->get_host_group_members(id);
 
   lua_newtable(L);
-  if (first != members.end()) {
+  if (!members.empty()) {
     int i = 1;
-    for (auto it(first); it != second; ++it) {
+    for (auto& m : members) {
       lua_createtable(L, 0, 2);
-      std::shared_ptr<io::data> evt = it->second;
-      const HostGroupMember& hgm =
-          std::static_pointer_cast<neb::pb_host_group_member>(it->second)
-              ->obj();
+      const HostGroupMember& hgm = m->obj();
       lua_pushinteger(L, hgm.hostgroup_id());
       lua_setfield(L, -2, "group_id");
 
@@ -654,8 +639,7 @@ static int32_t l_broker_cache_get_check_command(lua_State* L) {
     service_id = luaL_checkinteger(L, 3);
 
   try {
-    std::string_view check_command =
-        cache->get_check_command(host_id, service_id);
+    std::string check_command = cache->get_check_command(host_id, service_id);
     lua_pushlstring(L, check_command.data(), check_command.size());
   } catch (std::exception const& e) {
     (void)e;
@@ -704,7 +688,7 @@ void broker_cache::broker_cache_reg(lua_State* L,
       {"get_hostgroup_alias", l_broker_cache_get_hostgroup_alias},
       {nullptr, nullptr}};
 
-  if (api_version == 2) {
+  if (api_version >= 2) {
     s_broker_cache_regs[1].func = l_broker_cache_get_ba_v2;
     s_broker_cache_regs[2].func = l_broker_cache_get_bv_v2;
     s_broker_cache_regs[7].func = l_broker_cache_get_host_v2;
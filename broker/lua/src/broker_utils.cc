@@ -433,10 +433,15 @@ static void broker_json_encode_broker_event(std::shared_ptr<io::data> e,
       }
     } else {
       oss << ", ";
-      /* Here is the protobuf case: no mapping */
-      const google::protobuf::Message* p =
-          static_cast<const io::protobuf_base*>(e.get())->msg();
-      _message_to_json(oss, p);
+      /* Here is the protobuf case: no mapping. The JSON is stored in the
+       * event, so the other Lua streams encoding it reuse it. */
+      const io::protobuf_base* pb =
+          static_cast<const io::protobuf_base*>(e.get());
+      oss << *pb->encoded(io::protobuf_base::lua_json, [pb](std::string& json) {
+        std::ostringstream pb_oss;
+        _message_to_json(pb_oss, pb->msg());
+        json = pb_oss.str();
+      });
     }
   } else
     throw msg_fmt(
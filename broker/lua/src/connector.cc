@@ -17,6 +17,7 @@
  */
 
 #include "com/centreon/broker/lua/connector.hh"
+#include "com/centreon/broker/lua/parallel_stream.hh"
 #include "com/centreon/broker/lua/stream.hh"
 #include "com/centreon/broker/multiplexing/muxer_filter.hh"
 
@@ -31,7 +32,8 @@ connector::connector()
           false,
           multiplexing::muxer_filter(multiplexing::muxer_filter::zero_init()),
           multiplexing::muxer_filter(multiplexing::muxer_filter::zero_init())
-              .add_category(io::local)) {}
+              .add_category(io::local)),
+      _workers{1} {}
 
 /**
  *  Copy constructor.
@@ -42,7 +44,8 @@ connector::connector(connector const& other)
     : io::endpoint(other),
       _lua_script(other._lua_script),
       _conf_params(other._conf_params),
-      _cache(other._cache) {}
+      _cache(other._cache),
+      _workers{other._workers} {}
 
 /**
  *  Destructor.
@@ -56,14 +59,17 @@ connector::~connector() {}
  *  @param[in] cfg_params              A hash table containing the user
  *                                     parameters
  *  @param[in] cache                   The cache
+ *  @param[in] workers                 The number of Lua interpreters
  */
 void connector::connect_to(
     const std::string& lua_script,
     const std::map<std::string, misc::variant>& cfg_params,
-    const std::shared_ptr<persistent_cache>& cache) {
+    const std::shared_ptr<persistent_cache>& cache,
+    uint32_t workers) {
   _conf_params = cfg_params;
   _lua_script = lua_script;
   _cache = cache;
+  _workers = workers;
 }
 
 /**
@@ -72,5 +78,8 @@ void connector::connect_to(
  *  @return a lua connection object.
  */
 std::shared_ptr<io::stream> connector::open() {
+  if (_workers > 1)
+    return std::make_unique<parallel_stream>(_lua_script, _conf_params, _cache,
+                                             _workers);
   return std::make_unique<stream>(_lua_script, _conf_params, _cache);
 }
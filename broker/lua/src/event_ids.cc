@@ -0,0 +1,107 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/broker/lua/event_ids.hh"
+
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::lua;
+
+/**
+ * @brief Get the integer value of a field of a message.
+ *
+ * @param msg The message.
+ * @param f The field, may be nullptr.
+ *
+ * @return The value or 0 if the field is not an integer.
+ */
+static uint64_t integer_value(const google::protobuf::Message& msg,
+                              const google::protobuf::FieldDescriptor* f) {
+  if (!f)
+    return 0;
+  const google::protobuf::Reflection* refl = msg.GetReflection();
+  switch (f->cpp_type()) {
+    case google::protobuf::FieldDescriptor::CPPTYPE_UINT64:
+      return refl->GetUInt64(msg, f);
+    case google::protobuf::FieldDescriptor::CPPTYPE_INT64:
+      return refl->GetInt64(msg, f);
+    case google::protobuf::FieldDescriptor::CPPTYPE_UINT32:
+      return refl->GetUInt32(msg, f);
+    case google::protobuf::FieldDescriptor::CPPTYPE_INT32:
+      return refl->GetInt32(msg, f);
+    default:
+      return 0;
+  }
+}
+
+/**
+ * @brief Get the host_id and service_id field descriptors of an event type.
+ *
+ * @param d An event of the type.
+ *
+ * @return The descriptors, nullptr when the field does not exist.
+ */
+const event_ids::fields& event_ids::_fields_of(const io::data& d) {
+  auto found = _fields.find(d.type());
+  if (found == _fields.end()) {
+    fields f{nullptr, nullptr};
+    const io::protobuf_base* pb = dynamic_cast<const io::protobuf_base*>(&d);
+    if (pb) {
+      const google::protobuf::Descriptor* desc = pb->msg()->GetDescriptor();
+      f.host_id = desc->FindFieldByName("host_id");
+      if (f.host_id && f.host_id->is_repeated())
+        f.host_id = nullptr;
+      f.service_id = desc->FindFieldByName("service_id");
+      if (f.service_id && f.service_id->is_repeated())
+        f.service_id = nullptr;
+    }
+    found = _fields.emplace(d.type(), f).first;
+  }
+  return found->second;
+}
+
+/**
+ * @brief Get the host_id of an event.
+ *
+ * @param d The event.
+ *
+ * @return The host_id or 0 if the event is not tied to a host.
+ */
+uint64_t event_ids::host_id(const io::data& d) {
+  const fields& f = _fields_of(d);
+  if (!f.host_id)
+    return 0;
+  return integer_value(*static_cast<const io::protobuf_base&>(d).msg(),
+                       f.host_id);
+}
+
+/**
+ * @brief Get the host_id and the service_id of an event.
+ *
+ * @param d The event.
+ *
+ * @return A pair (host_id, service_id), 0 for the missing ones.
+ */
+std::pair<uint64_t, uint64_t> event_ids::host_service_id(const io::data& d) {
+  const fields& f = _fields_of(d);
+  if (!f.host_id && !f.service_id)
+    return {0, 0};
+  const google::protobuf::Message& msg =
+      *static_cast<const io::protobuf_base&>(d).msg();
+  return {integer_value(msg, f.host_id), integer_value(msg, f.service_id)};
+}
@@ -177,9 +177,17 @@ io::endpoint* factory::new_endpoint(
       }
     }
   }
+  // Number of Lua interpreters, events are then dispatched by host.
+  uint32_t workers = 1;
+  auto it = cfg.params.find("workers");
+  if (it != cfg.params.end() &&
+      (!absl::SimpleAtoi(it->second, &workers) || workers == 0))
+    throw msg_fmt("lua: 'workers' must be a positive integer, not '{}'",
+                  it->second);
+
   // Connector.
   auto c{std::make_unique<lua::connector>()};
-  c->connect_to(filename, conf_map, cache);
+  c->connect_to(filename, conf_map, cache, workers);
   is_acceptor = false;
   return c.release();
 }
@@ -20,6 +20,7 @@
 
 #include <cassert>
 
+#include "com/centreon/broker/io/trace.hh"
 #include "com/centreon/broker/lua/broker_cache.hh"
 #include "com/centreon/broker/lua/broker_event.hh"
 #include "com/centreon/broker/lua/broker_log.hh"
@@ -64,6 +65,8 @@ luabinding::luabinding(std::string const& lua_script,
       _cache(cache),
       _total{0},
       _broker_api_version{1},
+      _write_batch{false},
+      _batch_size{1000},
       _logger{log_v2::instance().get(log_v2::LUA)} {
   size_t pos(lua_script.find_last_of('/'));
   std::string path(lua_script.substr(0, pos));
@@ -75,6 +78,8 @@ luabinding::luabinding(std::string const& lua_script,
   try {
     _load_script(lua_script);
     _init_script(conf_params);
+    if (_broker_api_version == 3)
+      _load_filter();
   } catch (std::exception const& e) {
     lua_close(_L);
     throw;
@@ -138,6 +143,14 @@ bool luabinding::has_flush() const noexcept {
   return _flush;
 }
 
+/**
+ *  Returns true if events are given to the write_batch() function of the Lua
+ *  script.
+ */
+bool luabinding::has_batch() const noexcept {
+  return _write_batch;
+}
+
 /**
  *  Reads the Lua script, checks its syntax and checks if
  *   - init()
@@ -169,10 +182,14 @@ void luabinding::_load_script(const std::string& lua_script) {
     throw msg_fmt("lua: '{}' init() global function is missing", lua_script);
   lua_pop(_L, 1);
 
-  // Checking for write() availability: this function is mandatory
+  // Checking for write() availability: this function is mandatory unless
+  // write_batch() is defined with the api v3 (checked below).
   lua_getglobal(_L, "write");
-  if (!lua_isfunction(_L, lua_gettop(_L)))
-    throw msg_fmt("lua: '{}' write() global function is missing", lua_script);
+  bool has_write = lua_isfunction(_L, lua_gettop(_L));
+  lua_pop(_L, 1);
+
+  lua_getglobal(_L, "write_batch");
+  _write_batch = lua_isfunction(_L, lua_gettop(_L));
   lua_pop(_L, 1);
 
   // Checking for filter() availability: this function is optional
@@ -230,18 +247,27 @@ void luabinding::_load_script(const std::string& lua_script) {
     _broker_api_version = strtol(lua_tostring(_L, 1), &end, 10);
   }
 
-  if (_broker_api_version != 1 && _broker_api_version != 2) {
+  if (_broker_api_version < 1 || _broker_api_version > 3) {
     SPDLOG_LOGGER_ERROR(
         _logger,
         "broker_api_version represents the Lua broker api to use, it must be "
-        "one of (1, 2) and not '{}'. Setting it to 1",
+        "one of (1, 2, 3) and not '{}'. Setting it to 1",
         _broker_api_version);
     _broker_api_version = 1;
   }
   lua_pop(_L, 1);
 
+  if (_write_batch && _broker_api_version < 3) {
+    SPDLOG_LOGGER_INFO(_logger,
+                       "lua: write_batch() is ignored, it needs "
+                       "broker_api_version = 3");
+    _write_batch = false;
+  }
+  if (!has_write && !_write_batch)
+    throw msg_fmt("lua: '{}' write() global function is missing", lua_script);
+
 #ifdef LUA51
-  if (_broker_api_version == 2) {
+  if (_broker_api_version >= 2) {
     lua_getglobal(_L, "pairs");
     lua_setglobal(_L, "__pairs");
     lua_pushcfunction(_L, l_pairs);
@@ -322,6 +348,103 @@ void luabinding::_init_script(
   }
 }
 
+/**
+ *  Read the broker_filter and broker_batch_size globals of a script using
+ *  the api v3. broker_filter is a table that can contain:
+ *  * categories: an array of categories.
+ *  * elements: an array of {category, element} pairs.
+ *  * hosts: an array of host ids.
+ *  * services: an array of {host_id, service_id} pairs.
+ *  Events not matching it are acknowledged without being given to the script.
+ */
+void luabinding::_load_filter() {
+  lua_getglobal(_L, "broker_batch_size");
+  if (lua_isnumber(_L, -1)) {
+    lua_Integer size = lua_tointeger(_L, -1);
+    if (size > 0)
+      _batch_size = size;
+  }
+  lua_pop(_L, 1);
+
+  lua_getglobal(_L, "broker_filter");
+  if (!lua_istable(_L, -1)) {
+    lua_pop(_L, 1);
+    return;
+  }
+
+  /* Read the two integers of the pair at the top of the stack. */
+  auto read_pair = [this](lua_Integer& first, lua_Integer& second) {
+    lua_rawgeti(_L, -1, 1);
+    first = lua_tointeger(_L, -1);
+    lua_rawgeti(_L, -2, 2);
+    second = lua_tointeger(_L, -1);
+    lua_pop(_L, 2);
+  };
+
+  /* Call f for each value of the array broker_filter[name]. */
+  auto for_each = [this](const char* name, auto&& f) {
+    lua_getfield(_L, -1, name);
+    if (lua_istable(_L, -1)) {
+      lua_pushnil(_L);
+      while (lua_next(_L, -2) != 0) {
+        f();
+        lua_pop(_L, 1);
+      }
+    }
+    lua_pop(_L, 1);
+  };
+
+  for_each("categories", [this] {
+    _accepted_categories.insert(lua_tointeger(_L, -1));
+  });
+  for_each("elements", [this, &read_pair] {
+    lua_Integer cat, elem;
+    read_pair(cat, elem);
+    _accepted_types.insert(
+        make_type(static_cast<io::data_category>(cat), elem));
+  });
+  for_each("hosts",
+           [this] { _accepted_hosts.insert(lua_tointeger(_L, -1)); });
+  for_each("services", [this, &read_pair] {
+    lua_Integer host_id, service_id;
+    read_pair(host_id, service_id);
+    _accepted_services.emplace(host_id, service_id);
+  });
+  lua_pop(_L, 1);
+
+  SPDLOG_LOGGER_INFO(_logger,
+                     "lua: broker_filter with {} categories, {} elements, {} "
+                     "hosts and {} services, batches of {} events",
+                     _accepted_categories.size(), _accepted_types.size(),
+                     _accepted_hosts.size(), _accepted_services.size(),
+                     _batch_size);
+}
+
+/**
+ *  Tell if an event matches the broker_filter table of the script.
+ *
+ *  @param d The event.
+ *
+ *  @return true if the event is to be given to the script.
+ */
+bool luabinding::_accept(const io::data& d) {
+  if (!_accepted_categories.empty() || !_accepted_types.empty()) {
+    uint32_t type = d.type();
+    if (!_accepted_categories.contains(category_of_type(type)) &&
+        !_accepted_types.contains(type))
+      return false;
+  }
+
+  if (!_accepted_hosts.empty() || !_accepted_services.empty()) {
+    auto ids = _ids.host_service_id(d);
+    /* Events not related to a host are not filtered here. */
+    if (ids.first && !_accepted_hosts.contains(ids.first) &&
+        !_accepted_services.contains(ids))
+      return false;
+  }
+  return true;
+}
+
 /**
  *  The write method called by the stream::write method.
  *
@@ -338,9 +461,6 @@ int luabinding::write(std::shared_ptr<io::data> const& data) noexcept {
     SPDLOG_LOGGER_DEBUG(_logger, "lua: luabinding::write call");
   }
 
-  // Give data to cache.
-  _cache.write(data);
-
   // Process event.
   uint32_t mess_type(data->type());
   uint16_t cat(category_of_type(mess_type));
@@ -351,6 +471,11 @@ int luabinding::write(std::shared_ptr<io::data> const& data) noexcept {
   // Total to acknowledge incremented
   ++_total;
 
+  // With the api v3, the broker_filter table is applied before any call to
+  // the script.
+  if (_broker_api_version == 3 && !_accept(*data))
+    return 0;
+
   if (has_filter()) {
     // Let's get the function to call
     lua_getglobal(_L, "filter");
@@ -382,6 +507,13 @@ int luabinding::write(std::shared_ptr<io::data> const& data) noexcept {
   if (!execute_write)
     return 0;
 
+  if (_write_batch) {
+    _batch.push_back(data);
+    if (_batch.size() >= _batch_size)
+      return _send_batch();
+    return 0;
+  }
+
   // Let's get the function to call
   lua_getglobal(_L, "write");
 
@@ -394,6 +526,7 @@ int luabinding::write(std::shared_ptr<io::data> const& data) noexcept {
       broker_event::create_as_table(_L, d);
     } break;
     case 2:
+    case 3:
       broker_event::create(_L, data);
       break;
   }
@@ -413,6 +546,8 @@ int luabinding::write(std::shared_ptr<io::data> const& data) noexcept {
     SPDLOG_LOGGER_ERROR(_logger, "lua: `write' must return a boolean");
     RETURN_AND_POP(0);
   }
+  if (data->trace)
+    data->trace->commit("lua");
   int acknowledge = lua_toboolean(_L, -1);
 
   // We have to acknowledge rejected events by the filter. It is only possible
@@ -438,9 +573,64 @@ lua_State* luabinding::_load_interpreter() {
   return L;
 }
 
+/**
+ *  Give the pending events to the write_batch() function of the script. They
+ *  are given in an array of broker_event objects.
+ *
+ *  @return The number of events acknowledged.
+ */
+int32_t luabinding::_send_batch() noexcept {
+  SPDLOG_LOGGER_DEBUG(_logger, "lua: write_batch() called with {} events",
+                      _batch.size());
+  lua_getglobal(_L, "write_batch");
+  lua_createtable(_L, _batch.size(), 0);
+  std::vector<std::shared_ptr<io::trace>> traces;
+  for (uint32_t i = 0; i < _batch.size(); ++i) {
+    broker_event::create(_L, _batch[i]);
+    lua_rawseti(_L, -2, i + 1);
+    if (_batch[i]->trace)
+      traces.push_back(_batch[i]->trace);
+  }
+  _batch.clear();
+
+  if (lua_pcall(_L, 1, 1, 0) != 0) {
+    const char* ret = lua_tostring(_L, -1);
+    if (ret)
+      SPDLOG_LOGGER_ERROR(_logger,
+                          "lua: error running function `write_batch' {}", ret);
+    else
+      SPDLOG_LOGGER_ERROR(_logger,
+                          "lua: unknown error running function `write_batch'");
+    RETURN_AND_POP(0);
+  }
+
+  if (!lua_isboolean(_L, -1)) {
+    SPDLOG_LOGGER_ERROR(_logger, "lua: `write_batch' must return a boolean");
+    RETURN_AND_POP(0);
+  }
+  for (auto& t : traces)
+    t->commit("lua");
+
+  int32_t retval = 0;
+  if (lua_toboolean(_L, -1)) {
+    retval = _total;
+    _total = 0;
+  }
+  RETURN_AND_POP(retval);
+}
+
+/**
+ *  Call the flush() function of the script. With the api v3, pending events
+ *  are first given to write_batch().
+ *
+ *  @return The number of events acknowledged.
+ */
 int32_t luabinding::flush() noexcept {
+  int32_t retval = 0;
+  if (!_batch.empty())
+    retval = _send_batch();
   if (!_flush)
-    return 0;
+    return retval;
   // Let's get the function to call
   lua_getglobal(_L, "flush");
   if (lua_pcall(_L, 0, 1, 0) != 0) {
@@ -459,9 +649,8 @@ int32_t luabinding::flush() noexcept {
   }
   bool acknowledge = lua_toboolean(_L, -1);
 
-  int32_t retval = 0;
   if (acknowledge) {
-    retval = _total;
+    retval += _total;
     _total = 0;
   }
   RETURN_AND_POP(retval);
@@ -18,6 +18,7 @@
 
 #include "com/centreon/broker/lua/macro_cache.hh"
 #include <absl/strings/str_split.h>
+#include <filesystem>
 
 #include "bbdo/bam/dimension_ba_bv_relation_event.hh"
 #include "bbdo/bam/dimension_ba_event.hh"
@@ -25,6 +26,9 @@
 #include "bbdo/bam/dimension_truncate_table_signal.hh"
 #include "bbdo/storage/index_mapping.hh"
 #include "bbdo/storage/metric_mapping.hh"
+#include "com/centreon/broker/config/applier/state.hh"
+#include "com/centreon/broker/multiplexing/engine.hh"
+#include "com/centreon/broker/multiplexing/muxer.hh"
 #include "com/centreon/broker/neb/bbdo2_to_bbdo3.hh"
 #include "com/centreon/broker/neb/custom_variable.hh"
 #include "com/centreon/broker/neb/host.hh"
@@ -40,37 +44,188 @@ using namespace com::centreon::exceptions;
 using namespace com::centreon::broker;
 using namespace com::centreon::broker::lua;
 
+absl::Mutex macro_cache::_instance_m;
+std::shared_ptr<macro_cache> macro_cache::_instance;
+
+namespace {
+/**
+ *  Gives the events received by the muxer of the shared macro cache to it.
+ */
+class cache_feeder : public multiplexing::muxer::data_handler {
+  std::weak_ptr<macro_cache> _cache;
+
+ public:
+  cache_feeder(const std::shared_ptr<macro_cache>& cache) : _cache{cache} {}
+  uint32_t on_events(
+      const std::vector<std::shared_ptr<io::data>>& events) override {
+    std::shared_ptr<macro_cache> cache = _cache.lock();
+    if (cache)
+      cache->write(events);
+    return events.size();
+  }
+};
+/* The cache and the version of its content pinned by the current thread. */
+thread_local const macro_cache* pinned_cache = nullptr;
+thread_local std::shared_ptr<const macro_cache::content> pinned_version;
+}  // namespace
+
+/**
+ *  Pin a version of the content of a cache for the current thread.
+ *
+ *  @param[in] cache    The cache.
+ *  @param[in] version  The version, got from current().
+ */
+macro_cache::pin::pin(const macro_cache& cache,
+                      std::shared_ptr<const content> version)
+    : _prev_cache{pinned_cache}, _prev_version{std::move(pinned_version)} {
+  pinned_cache = &cache;
+  pinned_version = std::move(version);
+}
+
+/**
+ *  Destructor, the previous pin of the thread is restored.
+ */
+macro_cache::pin::~pin() noexcept {
+  pinned_cache = _prev_cache;
+  pinned_version = std::move(_prev_version);
+}
+
+/**
+ *  Get the macro cache shared by all the Lua streams. If it does not exist
+ *  yet, it is created and loaded from its own persistent cache. Then, it is
+ *  fed by its own muxer until the module is unloaded (see unload()).
+ *
+ *  If its persistent cache does not exist yet, the cache is loaded from the
+ *  persistent cache of the stream, written by an older version of broker.
+ *
+ *  @param[in] cache  The persistent cache of the stream.
+ *
+ *  @return The shared macro cache.
+ */
+std::shared_ptr<macro_cache> macro_cache::instance(
+    const std::shared_ptr<persistent_cache>& cache) {
+  absl::MutexLock lck(&_instance_m);
+  if (!_instance) {
+    std::string filename = fmt::format(
+        "{}.cache.lua_macro_cache",
+        config::applier::state::instance().cache_dir());
+    bool exists = std::filesystem::exists(filename);
+    auto pcache = std::make_shared<persistent_cache>(filename, cache->logger());
+    _instance = std::make_shared<macro_cache>(exists ? pcache : cache);
+    _instance->_pcache = std::move(pcache);
+
+    auto engine = multiplexing::engine::instance_ptr();
+    if (engine) {
+      multiplexing::muxer_filter w_filter =
+          multiplexing::muxer_filter(multiplexing::muxer_filter::zero_init())
+              .add_category(io::neb)
+              .add_category(io::storage)
+              .add_category(io::bam);
+      _instance->_muxer = multiplexing::muxer::create(
+          "lua-macro-cache", engine,
+          multiplexing::muxer_filter(multiplexing::muxer_filter::zero_init()),
+          w_filter, false);
+      _instance->_muxer->set_accepts_opaque(false);
+      _instance->_muxer->set_action_on_new_data(
+          std::make_shared<cache_feeder>(_instance));
+    } else
+      _instance->_logger->error(
+          "lua: no multiplexing engine, the macro cache will not be updated");
+  }
+  return _instance;
+}
+
+/**
+ *  Release the shared macro cache. It is destroyed once the last stream using
+ *  it is, it then stops receiving events and is saved into its persistent
+ *  cache.
+ */
+void macro_cache::unload() {
+  std::shared_ptr<macro_cache> to_release;
+  {
+    absl::MutexLock lck(&_instance_m);
+    to_release.swap(_instance);
+  }
+}
+
 /**
  *  Construct a macro cache
  *
- *  @param[in] cache  Persistent cache used by the macro cache.
+ *  @param[in] cache  Persistent cache used to initialize the macro cache.
  */
 macro_cache::macro_cache(const std::shared_ptr<persistent_cache>& cache)
-    : _cache(cache) {
-  if (_cache != nullptr) {
-    std::shared_ptr<io::data> d;
-    do {
-      _cache->get(d);
-      write(d);
-    } while (d);
-  }
+    : _logger{cache->logger()}, _content{std::make_shared<content>()} {
+  _load(*cache);
 }
 
 /**
- *  Destructor.
+ *  Destructor. The shared cache is saved into its persistent cache.
  */
-macro_cache::~macro_cache() {
-  if (_cache != nullptr) {
+macro_cache::~macro_cache() noexcept {
+  if (_muxer) {
+    _muxer->clear_action_on_new_data();
+    _muxer->unsubscribe();
+    _muxer->remove_queue_files();
+  }
+  if (_pcache) {
     try {
-      _save_to_disk();
-    } catch (std::exception const& e) {
-      SPDLOG_LOGGER_ERROR(_cache->logger(),
-                          "lua: macro cache couldn't save data to disk: '{}'",
-                          e.what());
+      save(*_pcache);
+    } catch (const std::exception& e) {
+      _logger->error("lua: macro cache couldn't save data to disk: '{}'",
+                     e.what());
     }
   }
 }
 
+/**
+ *  Load the content of a persistent cache, as one batch.
+ *
+ *  @param[in] cache  The persistent cache.
+ */
+void macro_cache::_load(persistent_cache& cache) {
+  std::vector<std::shared_ptr<io::data>> events;
+  for (;;) {
+    std::shared_ptr<io::data> d;
+    cache.get(d);
+    if (!d)
+      break;
+    events.push_back(std::move(d));
+  }
+  write(events);
+}
+
+/**
+ *  Get the current content of the cache, or the version pinned by the current
+ *  thread if any (see pin). It is never modified, so it can be read without
+ *  lock, even if the cache is updated meanwhile.
+ *
+ *  @return The content.
+ */
+std::shared_ptr<const macro_cache::content> macro_cache::current() const {
+  if (pinned_cache == this && pinned_version)
+    return pinned_version;
+  return std::atomic_load(&_content);
+}
+
+/**
+ *  Start a new version of all the maps, see cow_map::start_version().
+ */
+void macro_cache::content::start_version() {
+  instances.start_version();
+  hosts.start_version();
+  host_groups.start_version();
+  host_group_members.start_version();
+  custom_vars.start_version();
+  services.start_version();
+  service_groups.start_version();
+  service_group_members.start_version();
+  index_mappings.start_version();
+  metric_mappings.start_version();
+  dimension_ba_events.start_version();
+  dimension_ba_bv_relation_events.start_version();
+  dimension_bv_events.start_version();
+}
+
 /**
  *  Get the mapping of an index.
  *
@@ -78,12 +233,13 @@ macro_cache::~macro_cache() {
  *
  *  @return               The status mapping.
  */
-const storage::pb_index_mapping& macro_cache::get_index_mapping(
+std::shared_ptr<storage::pb_index_mapping> macro_cache::get_index_mapping(
     uint64_t index_id) const {
-  const auto found = _index_mappings.find(index_id);
-  if (found == _index_mappings.end())
+  auto c = current();
+  const auto* found = c->index_mappings.find(index_id);
+  if (!found)
     throw msg_fmt("lua: could not find host/service of index {}", index_id);
-  return *found->second;
+  return *found;
 }
 
 /**
@@ -93,12 +249,13 @@ const storage::pb_index_mapping& macro_cache::get_index_mapping(
  *
  *  @return               The metric mapping.
  */
-const std::shared_ptr<storage::pb_metric_mapping>&
-macro_cache::get_metric_mapping(uint64_t metric_id) const {
-  auto const found = _metric_mappings.find(metric_id);
-  if (found == _metric_mappings.end())
+std::shared_ptr<storage::pb_metric_mapping> macro_cache::get_metric_mapping(
+    uint64_t metric_id) const {
+  auto c = current();
+  const auto* found = c->metric_mappings.find(metric_id);
+  if (!found)
     throw msg_fmt("lua: could not find index of metric {}", metric_id);
-  return found->second;
+  return *found;
 }
 
 /**
@@ -109,15 +266,16 @@ macro_cache::get_metric_mapping(uint64_t metric_id) const {
  *
  *  @return             A shared pointer on the service.
  */
-const std::shared_ptr<neb::pb_service>& macro_cache::get_service(
+std::shared_ptr<neb::pb_service> macro_cache::get_service(
     uint64_t host_id,
     uint64_t service_id) const {
-  auto found = _services.find({host_id, service_id});
+  auto c = current();
+  const auto* found = c->services.find({host_id, service_id});
 
-  if (found == _services.end())
+  if (!found)
     throw msg_fmt("lua: could not find information on service ({}, {})",
                   host_id, service_id);
-  return found->second;
+  return *found;
 }
 
 /**
@@ -127,14 +285,14 @@ const std::shared_ptr<neb::pb_service>& macro_cache::get_service(
  *
  *  @return             A shared pointer on the host.
  */
-const std::shared_ptr<neb::pb_host>& macro_cache::get_host(
-    uint64_t host_id) const {
-  auto found = _hosts.find(host_id);
+std::shared_ptr<neb::pb_host> macro_cache::get_host(uint64_t host_id) const {
+  auto c = current();
+  const auto* found = c->hosts.find(host_id);
 
-  if (found == _hosts.end())
+  if (!found)
     throw msg_fmt("lua: could not find information on host {}", host_id);
 
-  return found->second;
+  return *found;
 }
 
 /**
@@ -144,13 +302,14 @@ const std::shared_ptr<neb::pb_host>& macro_cache::get_host(
  *
  *  @return             The name of the host.
  */
-std::string const& macro_cache::get_host_name(uint64_t host_id) const {
-  auto found = _hosts.find(host_id);
+std::string macro_cache::get_host_name(uint64_t host_id) const {
+  auto c = current();
+  const auto* found = c->hosts.find(host_id);
 
-  if (found == _hosts.end())
+  if (!found)
     throw msg_fmt("lua: could not find information on host {}", host_id);
 
-  return found->second->obj().name();
+  return (*found)->obj().name();
 }
 
 /**
@@ -162,15 +321,16 @@ std::string const& macro_cache::get_host_name(uint64_t host_id) const {
  * @return a severity (int32_t).
  */
 int32_t macro_cache::get_severity(uint64_t host_id, uint64_t service_id) const {
-  auto found = _custom_vars.find({host_id, service_id});
-  if (found == _custom_vars.end())
+  auto c = current();
+  const auto* found = c->custom_vars.find({host_id, service_id});
+  if (!found)
     throw msg_fmt(
         "lua: could not find the severity of the object (host_id: {}, "
         "service_id: {})",
         host_id, service_id);
   int32_t ret;
   if (absl::SimpleAtoi(
-          std::static_pointer_cast<neb::pb_custom_variable>(found->second)
+          std::static_pointer_cast<neb::pb_custom_variable>((*found))
               ->obj()
               .value(),
           &ret)) {
@@ -189,31 +349,30 @@ int32_t macro_cache::get_severity(uint64_t host_id, uint64_t service_id) const {
  * @param host_id An integer representing a host ID.
  * @param service_id An service ID or 0 for a host.
  *
- * @return A string view pointing to the check command.
+ * @return The check command.
  */
-std::string_view macro_cache::get_check_command(uint64_t host_id,
-                                                uint64_t service_id) const {
+std::string macro_cache::get_check_command(uint64_t host_id,
+                                           uint64_t service_id) const {
+  auto c = current();
   /* Case of services */
-  std::string_view retval;
+  std::string retval;
   if (service_id) {
-    auto found = _services.find({host_id, service_id});
-    if (found == _services.end())
+    const auto* found = c->services.find({host_id, service_id});
+    if (!found)
       throw msg_fmt(
           "lua: could not find the check command of the service (host_id: {}, "
           "service_id: {})",
           host_id, service_id);
-    neb::pb_service& s = static_cast<neb::pb_service&>(*found->second);
-    retval = s.obj().check_command();
+    retval = (*found)->obj().check_command();
   }
   /* Case of hosts */
   else {
-    auto found = _hosts.find(host_id);
-    if (found == _hosts.end())
+    const auto* found = c->hosts.find(host_id);
+    if (!found)
       throw msg_fmt(
           "lua: could not find the check command of the host (host_id: {})",
           host_id);
-    neb::pb_host& s = static_cast<neb::pb_host&>(*found->second);
-    retval = s.obj().check_command();
+    retval = (*found)->obj().check_command();
   }
   return retval;
 }
@@ -226,22 +385,23 @@ std::string_view macro_cache::get_check_command(uint64_t host_id,
  *
  *  @return             The notes url.
  */
-std::string const& macro_cache::get_notes_url(uint64_t host_id,
-                                              uint64_t service_id) const {
+std::string macro_cache::get_notes_url(uint64_t host_id,
+                                       uint64_t service_id) const {
+  auto c = current();
   if (service_id) {
-    auto found = _services.find({host_id, service_id});
+    const auto* found = c->services.find({host_id, service_id});
 
-    if (found == _services.end())
+    if (!found)
       throw msg_fmt("lua: could not find information on service ({}, {})",
                     host_id, service_id);
-    return found->second->obj().notes_url();
+    return (*found)->obj().notes_url();
   } else {
-    auto found = _hosts.find(host_id);
+    const auto* found = c->hosts.find(host_id);
 
-    if (found == _hosts.end())
+    if (!found)
       throw msg_fmt("lua: could not find information on host {}", host_id);
 
-    return found->second->obj().notes_url();
+    return (*found)->obj().notes_url();
   }
 }
 
@@ -253,22 +413,23 @@ std::string const& macro_cache::get_notes_url(uint64_t host_id,
  *
  *  @return             The action url.
  */
-std::string const& macro_cache::get_action_url(uint64_t host_id,
-                                               uint64_t service_id) const {
+std::string macro_cache::get_action_url(uint64_t host_id,
+                                        uint64_t service_id) const {
+  auto c = current();
   if (service_id) {
-    auto found = _services.find({host_id, service_id});
+    const auto* found = c->services.find({host_id, service_id});
 
-    if (found == _services.end())
+    if (!found)
       throw msg_fmt("lua: could not find information on service ({}, {})",
                     host_id, service_id);
-    return found->second->obj().action_url();
+    return (*found)->obj().action_url();
   } else {
-    auto found = _hosts.find(host_id);
+    const auto* found = c->hosts.find(host_id);
 
-    if (found == _hosts.end())
+    if (!found)
       throw msg_fmt("lua: could not find information on host {}", host_id);
 
-    return found->second->obj().action_url();
+    return (*found)->obj().action_url();
   }
 }
 
@@ -280,33 +441,41 @@ std::string const& macro_cache::get_action_url(uint64_t host_id,
  *
  *  @return             The notes.
  */
-std::string const& macro_cache::get_notes(uint64_t host_id,
-                                          uint64_t service_id) const {
+std::string macro_cache::get_notes(uint64_t host_id,
+                                   uint64_t service_id) const {
+  auto c = current();
   if (service_id) {
-    auto found = _services.find({host_id, service_id});
+    const auto* found = c->services.find({host_id, service_id});
 
-    if (found == _services.end())
+    if (!found)
       throw msg_fmt("lua: cound not find information on service ({}, {})",
                     host_id, service_id);
-    return found->second->obj().notes();
+    return (*found)->obj().notes();
   } else {
-    auto found = _hosts.find(host_id);
+    const auto* found = c->hosts.find(host_id);
 
-    if (found == _hosts.end())
+    if (!found)
       throw msg_fmt("lua: could not find information on host {}", host_id);
-    return found->second->obj().notes();
+    return (*found)->obj().notes();
   }
 }
 
 /**
- *  Get a map of the host groups members index by host_id and host_group.
+ *  Get the host group memberships of a host.
  *
- *  @return             A std::map
+ *  @param[in] host_id  The id of the host.
+ *
+ *  @return             A vector of host group members.
  */
-const absl::btree_map<std::pair<uint64_t, uint64_t>,
-                      std::shared_ptr<neb::pb_host_group_member>>&
-macro_cache::get_host_group_members() const {
-  return _host_group_members;
+std::vector<std::shared_ptr<neb::pb_host_group_member>>
+macro_cache::get_host_group_members(uint64_t host_id) const {
+  auto c = current();
+  std::vector<std::shared_ptr<neb::pb_host_group_member>> retval;
+  for (auto it = c->host_group_members.map().lower_bound({host_id, 0}),
+            end = c->host_group_members.map().upper_bound({host_id + 1, 0});
+       it != end; ++it)
+    retval.push_back(it->second);
+  return retval;
 }
 
 /**
@@ -316,15 +485,16 @@ macro_cache::get_host_group_members() const {
  *
  *  @return             The name of the host group.
  */
-const std::string& macro_cache::get_host_group_name(uint64_t id) const {
-  const auto found = _host_groups.find(id);
+std::string macro_cache::get_host_group_name(uint64_t id) const {
+  auto c = current();
+  const auto* found = c->host_groups.find(id);
 
-  if (found == _host_groups.end()) {
-    _cache->logger()->error("lua: could not find information on host group {}",
+  if (!found) {
+    _logger->error("lua: could not find information on host group {}",
                             id);
     throw msg_fmt("lua: could not find information on host group {}", id);
   }
-  return found->second.first->obj().name();
+  return found->first->obj().name();
 }
 
 /**
@@ -334,16 +504,17 @@ const std::string& macro_cache::get_host_group_name(uint64_t id) const {
  *
  *  @return             The alias of the host group.
  */
-const std::string& macro_cache::get_host_group_alias(uint64_t id) const {
-  const auto found = _host_groups.find(id);
+std::string macro_cache::get_host_group_alias(uint64_t id) const {
+  auto c = current();
+  const auto* found = c->host_groups.find(id);
 
-  if (found == _host_groups.end()) {
-    _cache->logger()->error("lua: could not find information on host group {}",
+  if (!found) {
+    _logger->error("lua: could not find information on host group {}",
                             id);
     throw msg_fmt("lua: could not find information on host group {}", id);
   }
 
-  return found->second.first->obj().alias();
+  return found->first->obj().alias();
 }
 
 /**
@@ -354,28 +525,36 @@ const std::string& macro_cache::get_host_group_alias(uint64_t id) const {
  *
  *  @return             The description of the service.
  */
-std::string const& macro_cache::get_service_description(
-    uint64_t host_id,
-    uint64_t service_id) const {
-  auto const found = _services.find({host_id, service_id});
-  if (found == _services.end())
+std::string macro_cache::get_service_description(uint64_t host_id,
+                                                 uint64_t service_id) const {
+  auto c = current();
+  const auto* found = c->services.find({host_id, service_id});
+  if (!found)
     throw msg_fmt("lua: could not find information on service ({}, {})",
                   host_id, service_id);
-  return found->second->obj().description();
+  return (*found)->obj().description();
 }
 
 /**
- *  Service group members accessor
+ *  Get the service group memberships of a service.
  *
  *  @param[in] host_id  The id of the host.
  *  @param[in] service_id  The id of the service.
  *
- *  @return   A map indexed by host_id/service_id/group_id.
+ *  @return   A vector of service group members.
  */
-absl::btree_map<std::tuple<uint64_t, uint64_t, uint64_t>,
-                std::shared_ptr<neb::pb_service_group_member>> const&
-macro_cache::get_service_group_members() const {
-  return _service_group_members;
+std::vector<std::shared_ptr<neb::pb_service_group_member>>
+macro_cache::get_service_group_members(uint64_t host_id,
+                                       uint64_t service_id) const {
+  auto c = current();
+  std::vector<std::shared_ptr<neb::pb_service_group_member>> retval;
+  for (auto it = c->service_group_members.map().lower_bound(
+                std::make_tuple(host_id, service_id, 0)),
+            end = c->service_group_members.map().upper_bound(
+                std::make_tuple(host_id, service_id + 1, 0));
+       it != end; ++it)
+    retval.push_back(it->second);
+  return retval;
 }
 
 /**
@@ -385,15 +564,16 @@ macro_cache::get_service_group_members() const {
  *
  *  @return            The name of the service group.
  */
-std::string const& macro_cache::get_service_group_name(uint64_t id) const {
-  auto found = _service_groups.find(id);
+std::string macro_cache::get_service_group_name(uint64_t id) const {
+  auto c = current();
+  const auto* found = c->service_groups.find(id);
 
-  if (found == _service_groups.end()) {
-    _cache->logger()->error(
+  if (!found) {
+    _logger->error(
         "lua: could not find information on service group {}", id);
     throw msg_fmt("lua: could not find information on service group {}", id);
   }
-  return found->second.first->obj().name();
+  return found->first->obj().name();
 }
 
 /**
@@ -403,25 +583,29 @@ std::string const& macro_cache::get_service_group_name(uint64_t id) const {
  *
  *  @return   The name of the instance.
  */
-std::string const& macro_cache::get_instance(uint64_t instance_id) const {
-  auto const found = _instances.find(instance_id);
-  if (found == _instances.end())
+std::string macro_cache::get_instance(uint64_t instance_id) const {
+  auto c = current();
+  const auto* found = c->instances.find(instance_id);
+  if (!found)
     throw msg_fmt("lua: could not find information on instance {}",
                   instance_id);
-  return found->second->obj().name();
+  return (*found)->obj().name();
 }
 
 /**
- *  Accessor to the multi hash containing ba bv relations.
+ *  Get the ids of the BVs containing a BA.
+ *
+ * @param ba_id The id of the BA.
  *
- * @return A reference to an unordered_multimap containining ba/bv relation
- * events.
+ * @return A vector of BV ids.
  */
-std::unordered_multimap<
-    uint64_t,
-    std::shared_ptr<bam::pb_dimension_ba_bv_relation_event>> const&
-macro_cache::get_dimension_ba_bv_relation_events() const {
-  return _dimension_ba_bv_relation_events;
+std::vector<uint64_t> macro_cache::get_dimension_bv_ids(uint64_t ba_id) const {
+  auto c = current();
+  std::vector<uint64_t> retval;
+  auto range = c->dimension_ba_bv_relation_events.map().equal_range(ba_id);
+  for (auto it = range.first; it != range.second; ++it)
+    retval.push_back(it->second->obj().bv_id());
+  return retval;
 }
 
 /**
@@ -429,15 +613,16 @@ macro_cache::get_dimension_ba_bv_relation_events() const {
  *
  * @param ba_id The id
  *
- * @return a reference to the dimension_ba_event.
+ * @return the dimension_ba_event.
  */
-const std::shared_ptr<bam::pb_dimension_ba_event>&
-macro_cache::get_dimension_ba_event(uint64_t ba_id) const {
-  auto const found = _dimension_ba_events.find(ba_id);
-  if (found == _dimension_ba_events.end())
+std::shared_ptr<bam::pb_dimension_ba_event> macro_cache::get_dimension_ba_event(
+    uint64_t ba_id) const {
+  auto c = current();
+  const auto* found = c->dimension_ba_events.find(ba_id);
+  if (!found)
     throw msg_fmt("lua: could not find information on dimension ba event {}",
                   ba_id);
-  return found->second;
+  return *found;
 }
 
 /**
@@ -445,15 +630,32 @@ macro_cache::get_dimension_ba_event(uint64_t ba_id) const {
  *
  * @param bv_id The id
  *
- * @return a reference to the dimension_bv_event.
+ * @return the dimension_bv_event.
  */
-const std::shared_ptr<bam::pb_dimension_bv_event>&
-macro_cache::get_dimension_bv_event(uint64_t bv_id) const {
-  auto const found = _dimension_bv_events.find(bv_id);
-  if (found == _dimension_bv_events.end())
+std::shared_ptr<bam::pb_dimension_bv_event> macro_cache::get_dimension_bv_event(
+    uint64_t bv_id) const {
+  auto c = current();
+  const auto* found = c->dimension_bv_events.find(bv_id);
+  if (!found)
     throw msg_fmt("lua: could not find information on dimension bv event {}",
                   bv_id);
-  return found->second;
+  return *found;
+}
+
+/**
+ *  Write a batch of events into the cache: they are applied to a copy of the
+ *  current content, published once all of them are applied.
+ *
+ *  @param[in] events  The events to write.
+ */
+void macro_cache::write(const std::vector<std::shared_ptr<io::data>>& events) {
+  absl::MutexLock lck(&_write_m);
+  auto next = std::make_shared<content>(*std::atomic_load(&_content));
+  next->start_version();
+  for (auto& d : events)
+    if (d)
+      _process(*next, d);
+  std::atomic_store(&_content, std::shared_ptr<const content>(std::move(next)));
 }
 
 /**
@@ -464,115 +666,124 @@ macro_cache::get_dimension_bv_event(uint64_t bv_id) const {
 void macro_cache::write(std::shared_ptr<io::data> const& data) {
   if (!data)
     return;
+  write(std::vector<std::shared_ptr<io::data>>{data});
+}
 
+/**
+ *  Apply an event to a content being built.
+ *
+ *  @param[in] c     The content.
+ *  @param[in] data  The event.
+ */
+void macro_cache::_process(content& c, const std::shared_ptr<io::data>& data) {
   switch (data->type()) {
     case neb::instance::static_type():
-      _process_pb_instance(neb::bbdo2_to_bbdo3(data));
+      _process_pb_instance(c, neb::bbdo2_to_bbdo3(data));
       break;
     case neb::pb_instance::static_type():
-      _process_pb_instance(data);
+      _process_pb_instance(c, data);
       break;
     case neb::host::static_type():
-      _process_pb_host(neb::bbdo2_to_bbdo3(data));
+      _process_pb_host(c, neb::bbdo2_to_bbdo3(data));
       break;
     case neb::pb_host::static_type():
-      _process_pb_host(data);
+      _process_pb_host(c, data);
       break;
     case neb::host_status::static_type():
-      _process_pb_host_status(neb::bbdo2_to_bbdo3(data));
+      _process_pb_host_status(c, neb::bbdo2_to_bbdo3(data));
       break;
     case neb::pb_host_status::static_type():
-      _process_pb_host_status(data);
+      _process_pb_host_status(c, data);
       break;
     case neb::pb_adaptive_host::static_type():
-      _process_pb_adaptive_host(data);
+      _process_pb_adaptive_host(c, data);
       break;
     case neb::pb_adaptive_host_status::static_type():
-      _process_pb_adaptive_host_status(data);
+      _process_pb_adaptive_host_status(c, data);
       break;
     case neb::host_group::static_type():
-      _process_pb_host_group(neb::bbdo2_to_bbdo3(data));
+      _process_pb_host_group(c, neb::bbdo2_to_bbdo3(data));
       break;
     case neb::pb_host_group::static_type():
-      _process_pb_host_group(data);
+      _process_pb_host_group(c, data);
       break;
     case neb::host_group_member::static_type():
-      _process_pb_host_group_member(neb::bbdo2_to_bbdo3(data));
+      _process_pb_host_group_member(c, neb::bbdo2_to_bbdo3(data));
       break;
     case neb::pb_host_group_member::static_type():
-      _process_pb_host_group_member(data);
+      _process_pb_host_group_member(c, data);
       break;
     case neb::service::static_type():
-      _process_pb_service(neb::bbdo2_to_bbdo3(data));
+      _process_pb_service(c, neb::bbdo2_to_bbdo3(data));
       break;
     case neb::pb_service::static_type():
-      _process_pb_service(data);
+      _process_pb_service(c, data);
       break;
     case neb::service_status::static_type():
-      _process_pb_service_status(neb::bbdo2_to_bbdo3(data));
+      _process_pb_service_status(c, neb::bbdo2_to_bbdo3(data));
       break;
     case neb::pb_service_status::static_type():
-      _process_pb_service_status(data);
+      _process_pb_service_status(c, data);
       break;
     case neb::pb_adaptive_service_status::static_type():
-      _process_pb_adaptive_service_status(data);
+      _process_pb_adaptive_service_status(c, data);
       break;
     case neb::pb_adaptive_service::static_type():
-      _process_pb_adaptive_service(data);
+      _process_pb_adaptive_service(c, data);
       break;
     case neb::service_group::static_type():
-      _process_pb_service_group(neb::bbdo2_to_bbdo3(data));
+      _process_pb_service_group(c, neb::bbdo2_to_bbdo3(data));
       break;
     case neb::pb_service_group::static_type():
-      _process_pb_service_group(data);
+      _process_pb_service_group(c, data);
       break;
     case neb::service_group_member::static_type():
-      _process_pb_service_group_member(neb::bbdo2_to_bbdo3(data));
+      _process_pb_service_group_member(c, neb::bbdo2_to_bbdo3(data));
       break;
     case neb::pb_service_group_member::static_type():
-      _process_pb_service_group_member(data);
+      _process_pb_service_group_member(c, data);
       break;
     case neb::custom_variable::static_type():
-      _process_pb_custom_variable(neb::bbdo2_to_bbdo3(data));
+      _process_pb_custom_variable(c, neb::bbdo2_to_bbdo3(data));
       break;
     case neb::pb_custom_variable::static_type():
-      _process_pb_custom_variable(data);
+      _process_pb_custom_variable(c, data);
       break;
     case storage::pb_index_mapping::static_type():
-      _process_index_mapping(data);
+      _process_index_mapping(c, data);
       break;
     case storage::index_mapping::static_type():
-      _process_index_mapping(neb::bbdo2_to_bbdo3(data));
+      _process_index_mapping(c, neb::bbdo2_to_bbdo3(data));
       break;
     case storage::pb_metric_mapping::static_type():
-      _process_metric_mapping(data);
+      _process_metric_mapping(c, data);
       break;
     case storage::metric_mapping::static_type():
-      _process_metric_mapping(neb::bbdo2_to_bbdo3(data));
+      _process_metric_mapping(c, neb::bbdo2_to_bbdo3(data));
       break;
     case bam::dimension_ba_event::static_type():
-      _process_dimension_ba_event(neb::bbdo2_to_bbdo3(data));
+      _process_dimension_ba_event(c, neb::bbdo2_to_bbdo3(data));
       break;
     case bam::pb_dimension_ba_event::static_type():
-      _process_dimension_ba_event(data);
+      _process_dimension_ba_event(c, data);
       break;
     case bam::dimension_ba_bv_relation_event::static_type():
-      _process_dimension_ba_bv_relation_event(neb::bbdo2_to_bbdo3(data));
+      _process_dimension_ba_bv_relation_event(c, neb::bbdo2_to_bbdo3(data));
       break;
     case bam::pb_dimension_ba_bv_relation_event::static_type():
-      _process_dimension_ba_bv_relation_event(data);
+      _process_dimension_ba_bv_relation_event(c, data);
       break;
     case bam::dimension_bv_event::static_type():
-      _process_dimension_bv_event(neb::bbdo2_to_bbdo3(data));
+      _process_dimension_bv_event(c, neb::bbdo2_to_bbdo3(data));
       break;
     case bam::pb_dimension_bv_event::static_type():
-      _process_dimension_bv_event(data);
+      _process_dimension_bv_event(c, data);
       break;
     case bam::dimension_truncate_table_signal::static_type():
-      _process_pb_dimension_truncate_table_signal(neb::bbdo2_to_bbdo3(data));
+      _process_pb_dimension_truncate_table_signal(c, neb::bbdo2_to_bbdo3(data));
       break;
     case bam::pb_dimension_truncate_table_signal::static_type():
-      _process_pb_dimension_truncate_table_signal(data);
+      _process_pb_dimension_truncate_table_signal(c, data);
       break;
     default:
       break;
@@ -584,9 +795,10 @@ void macro_cache::write(std::shared_ptr<io::data> const& data) {
  *
  *  @param in  The event.
  */
-void macro_cache::_process_pb_instance(std::shared_ptr<io::data> const& data) {
+void macro_cache::_process_pb_instance(content& c,
+                                       const std::shared_ptr<io::data>& data) {
   auto const& in = std::static_pointer_cast<neb::pb_instance>(data);
-  _instances[in->obj().instance_id()] = in;
+  c.instances.set(in->obj().instance_id(), in);
 }
 
 /**
@@ -594,35 +806,40 @@ void macro_cache::_process_pb_instance(std::shared_ptr<io::data> const& data) {
  *
  *  @param h  The event.
  */
-void macro_cache::_process_pb_host(std::shared_ptr<io::data> const& data) {
+void macro_cache::_process_pb_host(content& c,
+                                   const std::shared_ptr<io::data>& data) {
   const auto& h = std::static_pointer_cast<neb::pb_host>(data);
-  SPDLOG_LOGGER_DEBUG(_cache->logger(),
+  SPDLOG_LOGGER_DEBUG(_logger,
                       "lua: processing host '{}' of id {} enabled {}",
                       h->obj().name(), h->obj().host_id(), h->obj().enabled());
   if (h->obj().enabled())
-    _hosts[h->obj().host_id()] = h;
+    c.hosts.set(h->obj().host_id(), h);
   else
-    _hosts.erase(h->obj().host_id());
+    c.hosts.erase(h->obj().host_id());
 }
 
 void macro_cache::_process_pb_host_status(
+    content& c,
     const std::shared_ptr<io::data>& data) {
   const auto& s = std::static_pointer_cast<neb::pb_host_status>(data);
   const auto& obj = s->obj();
 
-  SPDLOG_LOGGER_DEBUG(_cache->logger(), "lua: processing host status ({})",
+  SPDLOG_LOGGER_DEBUG(_logger, "lua: processing host status ({})",
                       obj.host_id());
 
-  auto it = _hosts.find(obj.host_id());
-  if (it == _hosts.end()) {
-    _cache->logger()->warn(
+  const auto* found = c.hosts.find(obj.host_id());
+  if (!found) {
+    _logger->warn(
         "lua: Attempt to update host ({}) in lua cache, but it does not "
         "exist. Maybe Engine should be restarted to update the cache.",
         obj.host_id());
     return;
   }
 
-  auto& hst = std::static_pointer_cast<neb::pb_host>(it->second)->mut_obj();
+  /* The stored host is replaced by an updated copy, the current one may be
+   * read by other threads. */
+  auto host = std::make_shared<neb::pb_host>(**found);
+  auto& hst = host->mut_obj();
   hst.set_checked(obj.checked());
   hst.set_check_type(static_cast<Host_CheckType>(obj.check_type()));
   hst.set_state(static_cast<Host_State>(obj.state()));
@@ -649,6 +866,7 @@ void macro_cache::_process_pb_host_status(
   hst.set_next_host_notification(obj.next_host_notification());
   hst.set_acknowledgement_type(obj.acknowledgement_type());
   hst.set_scheduled_downtime_depth(obj.scheduled_downtime_depth());
+  c.hosts.set(obj.host_id(), std::move(host));
 }
 
 /**
@@ -657,30 +875,33 @@ void macro_cache::_process_pb_host_status(
  * @param data An AdaptiveHostStatus event.
  */
 void macro_cache::_process_pb_adaptive_host_status(
+    content& c,
     const std::shared_ptr<io::data>& data) {
   const auto& s = std::static_pointer_cast<neb::pb_adaptive_host_status>(data);
   const auto& obj = s->obj();
 
-  SPDLOG_LOGGER_DEBUG(_cache->logger(),
+  SPDLOG_LOGGER_DEBUG(_logger,
                       "lua: processing adaptive host status ({})",
                       obj.host_id());
 
-  auto it = _hosts.find(obj.host_id());
-  if (it == _hosts.end()) {
-    _cache->logger()->warn(
+  const auto* found = c.hosts.find(obj.host_id());
+  if (!found) {
+    _logger->warn(
         "lua: Attempt to update host ({}) in lua cache, but it does not "
         "exist. Maybe Engine should be restarted to update the cache.",
         obj.host_id());
     return;
   }
 
-  auto& hst = std::static_pointer_cast<neb::pb_host>(it->second)->mut_obj();
+  auto host = std::make_shared<neb::pb_host>(**found);
+  auto& hst = host->mut_obj();
   if (obj.has_scheduled_downtime_depth())
     hst.set_scheduled_downtime_depth(obj.scheduled_downtime_depth());
   if (obj.has_acknowledgement_type())
     hst.set_acknowledgement_type(obj.acknowledgement_type());
   if (obj.has_notification_number())
     hst.set_notification_number(obj.notification_number());
+  c.hosts.set(obj.host_id(), std::move(host));
 }
 
 /**
@@ -689,14 +910,16 @@ void macro_cache::_process_pb_adaptive_host_status(
  *  @param s  The event.
  */
 void macro_cache::_process_pb_adaptive_host(
+    content& c,
     const std::shared_ptr<io::data>& data) {
   const auto& h = std::static_pointer_cast<neb::pb_adaptive_host>(data);
-  SPDLOG_LOGGER_DEBUG(_cache->logger(), "lua: processing adaptive host {}",
+  SPDLOG_LOGGER_DEBUG(_logger, "lua: processing adaptive host {}",
                       h->obj().host_id());
   auto& ah = h->obj();
-  auto it = _hosts.find(ah.host_id());
-  if (it != _hosts.end()) {
-    auto& h = it->second->mut_obj();
+  const auto* found = c.hosts.find(ah.host_id());
+  if (found) {
+    auto host = std::make_shared<neb::pb_host>(**found);
+    auto& h = host->mut_obj();
     if (ah.has_notify())
       h.set_notify(ah.notify());
     if (ah.has_active_checks())
@@ -727,9 +950,10 @@ void macro_cache::_process_pb_adaptive_host(
       h.set_check_period(ah.check_period());
     if (ah.has_notification_period())
       h.set_notification_period(ah.notification_period());
+    c.hosts.set(ah.host_id(), std::move(host));
   } else
     SPDLOG_LOGGER_WARN(
-        _cache->logger(),
+        _logger,
         "lua: cannot update cache for host {}, it does not exist in "
         "the cache",
         h->obj().host_id());
@@ -741,35 +965,34 @@ void macro_cache::_process_pb_adaptive_host(
  *  @param data  The event.
  */
 void macro_cache::_process_pb_host_group(
+    content& c,
     const std::shared_ptr<io::data>& data) {
   auto pb_hg = std::static_pointer_cast<neb::pb_host_group>(data);
   const HostGroup& hg = pb_hg->obj();
-  SPDLOG_LOGGER_DEBUG(_cache->logger(),
+  SPDLOG_LOGGER_DEBUG(_logger,
                       "lua: processing pb host group '{}' of id {}, enabled {}",
                       hg.name(), hg.hostgroup_id(), hg.enabled());
+  auto& groups = c.host_groups.mut(hg.hostgroup_id());
   if (hg.enabled()) {
-    auto found = _host_groups.find(hg.hostgroup_id());
-    if (found != _host_groups.end()) {
+    auto found = groups.find(hg.hostgroup_id());
+    if (found != groups.end()) {
       found->second.second.insert(hg.poller_id());
-      HostGroup& current_hg =
-          std::static_pointer_cast<neb::pb_host_group>(found->second.first)
-              ->mut_obj();
-      current_hg.set_name(hg.name());
+      found->second.first = std::move(pb_hg);
     } else {
       absl::flat_hash_set<uint32_t> pollers{hg.poller_id()};
-      _host_groups[hg.hostgroup_id()] =
+      groups[hg.hostgroup_id()] =
           std::make_pair(std::move(pb_hg), pollers);
     }
   } else {
     /* We check that no more pollers need this host group. So if the set is
      * empty, we can also remove the host group. */
-    auto found = _host_groups.find(hg.hostgroup_id());
-    if (found != _host_groups.end()) {
+    auto found = groups.find(hg.hostgroup_id());
+    if (found != groups.end()) {
       auto f = found->second.second.find(hg.poller_id());
       if (f != found->second.second.end()) {
         found->second.second.erase(f);
         if (found->second.second.empty()) {
-          _host_groups.erase(found);
+          groups.erase(found);
         }
       }
     }
@@ -782,19 +1005,20 @@ void macro_cache::_process_pb_host_group(
  *  @param data  The event.
  */
 void macro_cache::_process_pb_host_group_member(
-    std::shared_ptr<io::data> const& data) {
+    content& c,
+    const std::shared_ptr<io::data>& data) {
   auto hgm = std::static_pointer_cast<neb::pb_host_group_member>(data);
   const HostGroupMember& hgm_obj = hgm->obj();
   SPDLOG_LOGGER_DEBUG(
-      _cache->logger(),
+      _logger,
       "lua: processing pb host group member (group_name: '{}', group_id: {}, "
       "host_id: {}, enabled: {})",
       hgm_obj.name(), hgm_obj.hostgroup_id(), hgm_obj.host_id(),
       hgm_obj.enabled());
   if (hgm_obj.enabled())
-    _host_group_members[{hgm_obj.host_id(), hgm_obj.hostgroup_id()}] = hgm;
+    c.host_group_members.set({hgm_obj.host_id(), hgm_obj.hostgroup_id()}, hgm);
   else
-    _host_group_members.erase({hgm_obj.host_id(), hgm_obj.hostgroup_id()});
+    c.host_group_members.erase({hgm_obj.host_id(), hgm_obj.hostgroup_id()});
 }
 
 /**
@@ -802,17 +1026,18 @@ void macro_cache::_process_pb_host_group_member(
  *
  *  @param s  The event.
  */
-void macro_cache::_process_pb_service(std::shared_ptr<io::data> const& data) {
+void macro_cache::_process_pb_service(content& c,
+                                      const std::shared_ptr<io::data>& data) {
   auto const& s = std::static_pointer_cast<neb::pb_service>(data);
   SPDLOG_LOGGER_DEBUG(
-      _cache->logger(),
+      _logger,
       "lua: processing service ({}, {}) (description:{}) enabled {}",
       s->obj().host_id(), s->obj().service_id(), s->obj().description(),
       s->obj().enabled());
   if (s->obj().enabled())
-    _services[{s->obj().host_id(), s->obj().service_id()}] = s;
+    c.services.set({s->obj().host_id(), s->obj().service_id()}, s);
   else
-    _services.erase({s->obj().host_id(), s->obj().service_id()});
+    c.services.erase({s->obj().host_id(), s->obj().service_id()});
 }
 
 /**
@@ -821,52 +1046,59 @@ void macro_cache::_process_pb_service(std::shared_ptr<io::data> const& data) {
  * @param data An AdaptiveServiceStatus event.
  */
 void macro_cache::_process_pb_adaptive_service_status(
+    content& c,
     const std::shared_ptr<io::data>& data) {
   const auto& s =
       std::static_pointer_cast<neb::pb_adaptive_service_status>(data);
   const auto& obj = s->obj();
 
-  SPDLOG_LOGGER_DEBUG(_cache->logger(),
+  SPDLOG_LOGGER_DEBUG(_logger,
                       "lua: processing adaptive service status ({}, {})",
                       obj.host_id(), obj.service_id());
 
-  auto it = _services.find({obj.host_id(), obj.service_id()});
-  if (it == _services.end()) {
-    _cache->logger()->warn(
+  const auto* found = c.services.find({obj.host_id(), obj.service_id()});
+  if (!found) {
+    _logger->warn(
         "lua: Attempt to update service ({}, {}) in lua cache, but it does not "
         "exist. Maybe Engine should be restarted to update the cache.",
         obj.host_id(), obj.service_id());
     return;
   }
 
-  auto& svc = std::static_pointer_cast<neb::pb_service>(it->second)->mut_obj();
+  auto service = std::make_shared<neb::pb_service>(**found);
+  auto& svc = service->mut_obj();
   if (obj.has_acknowledgement_type())
     svc.set_acknowledgement_type(obj.acknowledgement_type());
   if (obj.has_scheduled_downtime_depth())
     svc.set_scheduled_downtime_depth(obj.scheduled_downtime_depth());
   if (obj.has_notification_number())
     svc.set_notification_number(obj.notification_number());
+  c.services.set({obj.host_id(), obj.service_id()}, std::move(service));
 }
 
 void macro_cache::_process_pb_service_status(
+    content& c,
     const std::shared_ptr<io::data>& data) {
   const auto& s = std::static_pointer_cast<neb::pb_service_status>(data);
   const auto& obj = s->obj();
 
-  SPDLOG_LOGGER_DEBUG(_cache->logger(),
+  SPDLOG_LOGGER_DEBUG(_logger,
                       "lua: processing service status ({}, {})", obj.host_id(),
                       obj.service_id());
 
-  auto it = _services.find({obj.host_id(), obj.service_id()});
-  if (it == _services.end()) {
-    _cache->logger()->warn(
+  const auto* found = c.services.find({obj.host_id(), obj.service_id()});
+  if (!found) {
+    _logger->warn(
         "lua: Attempt to update service ({}, {}) in lua cache, but it does not "
         "exist. Maybe Engine should be restarted to update the cache.",
         obj.host_id(), obj.service_id());
     return;
   }
 
-  auto& svc = it->second->mut_obj();
+  /* The stored service is replaced by an updated copy, the current one may be
+   * read by other threads. */
+  auto service = std::make_shared<neb::pb_service>(**found);
+  auto& svc = service->mut_obj();
   svc.set_checked(obj.checked());
   svc.set_check_type(static_cast<Service_CheckType>(obj.check_type()));
   svc.set_state(static_cast<Service_State>(obj.state()));
@@ -894,6 +1126,7 @@ void macro_cache::_process_pb_service_status(
   svc.set_next_notification(obj.next_notification());
   svc.set_acknowledgement_type(obj.acknowledgement_type());
   svc.set_scheduled_downtime_depth(obj.scheduled_downtime_depth());
+  c.services.set({obj.host_id(), obj.service_id()}, std::move(service));
 }
 
 /**
@@ -902,15 +1135,17 @@ void macro_cache::_process_pb_service_status(
  *  @param s  The event.
  */
 void macro_cache::_process_pb_adaptive_service(
-    std::shared_ptr<io::data> const& data) {
+    content& c,
+    const std::shared_ptr<io::data>& data) {
   const auto& s = std::static_pointer_cast<neb::pb_adaptive_service>(data);
-  SPDLOG_LOGGER_DEBUG(_cache->logger(),
+  SPDLOG_LOGGER_DEBUG(_logger,
                       "lua: processing adaptive service ({}, {})",
                       s->obj().host_id(), s->obj().service_id());
   auto& as = s->obj();
-  auto it = _services.find({as.host_id(), as.service_id()});
-  if (it != _services.end()) {
-    auto& s = it->second->mut_obj();
+  const auto* found = c.services.find({as.host_id(), as.service_id()});
+  if (found) {
+    auto service = std::make_shared<neb::pb_service>(**found);
+    auto& s = service->mut_obj();
     if (as.has_notify())
       s.set_notify(as.notify());
     if (as.has_active_checks())
@@ -941,9 +1176,10 @@ void macro_cache::_process_pb_adaptive_service(
       s.set_check_period(as.check_period());
     if (as.has_notification_period())
       s.set_notification_period(as.notification_period());
+    c.services.set({as.host_id(), as.service_id()}, std::move(service));
   } else {
     SPDLOG_LOGGER_WARN(
-        _cache->logger(),
+        _logger,
         "lua: cannot update cache for service ({}, {}), it does not exist in "
         "the cache",
         s->obj().host_id(), s->obj().service_id());
@@ -956,34 +1192,35 @@ void macro_cache::_process_pb_adaptive_service(
  *  @param sg  The event.
  */
 void macro_cache::_process_pb_service_group(
+    content& c,
     const std::shared_ptr<io::data>& data) {
   auto pb_sg = std::static_pointer_cast<neb::pb_service_group>(data);
   const ServiceGroup& sg = pb_sg->obj();
-  SPDLOG_LOGGER_DEBUG(_cache->logger(),
+  SPDLOG_LOGGER_DEBUG(_logger,
                       "lua: processing pb service group '{}' of id {}",
                       sg.name(), sg.servicegroup_id());
+  auto& groups = c.service_groups.mut(sg.servicegroup_id());
   if (sg.enabled()) {
-    auto found = _service_groups.find(sg.servicegroup_id());
-    if (found != _service_groups.end()) {
+    auto found = groups.find(sg.servicegroup_id());
+    if (found != groups.end()) {
       found->second.second.insert(sg.poller_id());
-      ServiceGroup& current_sg = found->second.first->mut_obj();
-      current_sg.set_name(sg.name());
+      found->second.first = std::move(pb_sg);
     } else {
       /* Here, we add the servicegroup and the first poller that needs it */
       absl::flat_hash_set<uint32_t> pollers{sg.poller_id()};
-      _service_groups[sg.servicegroup_id()] =
+      groups[sg.servicegroup_id()] =
           std::make_pair(std::move(pb_sg), pollers);
     }
   } else {
     /* We check that no more pollers need this service group. So if the set is
      * empty, we can also remove the service group. */
-    auto found = _service_groups.find(sg.servicegroup_id());
-    if (found != _service_groups.end()) {
+    auto found = groups.find(sg.servicegroup_id());
+    if (found != groups.end()) {
       auto f = found->second.second.find(sg.poller_id());
       if (f != found->second.second.end()) {
         found->second.second.erase(f);
         if (found->second.second.empty()) {
-          _service_groups.erase(found);
+          groups.erase(found);
         }
       }
     }
@@ -996,10 +1233,11 @@ void macro_cache::_process_pb_service_group(
  *  @param data  The event.
  */
 void macro_cache::_process_pb_service_group_member(
-    std::shared_ptr<io::data> const& data) {
+    content& c,
+    const std::shared_ptr<io::data>& data) {
   auto sgm = std::static_pointer_cast<neb::pb_service_group_member>(data);
   const ServiceGroupMember& sgm_obj = sgm->obj();
-  SPDLOG_LOGGER_DEBUG(_cache->logger(),
+  SPDLOG_LOGGER_DEBUG(_logger,
                       "lua: processing pb service group member (group_name: "
                       "{}, group_id: {}, "
                       "host_id: {}, service_id: {} enabled: {}",
@@ -1007,11 +1245,12 @@ void macro_cache::_process_pb_service_group_member(
                       sgm_obj.host_id(), sgm_obj.service_id(),
                       sgm_obj.enabled());
   if (sgm_obj.enabled())
-    _service_group_members[std::make_tuple(
-        sgm_obj.host_id(), sgm_obj.service_id(), sgm_obj.servicegroup_id())] =
-        sgm;
+    c.service_group_members.set(
+        std::make_tuple(sgm_obj.host_id(), sgm_obj.service_id(),
+                        sgm_obj.servicegroup_id()),
+        sgm);
   else
-    _service_group_members.erase(std::make_tuple(
+    c.service_group_members.erase(std::make_tuple(
         sgm_obj.host_id(), sgm_obj.service_id(), sgm_obj.servicegroup_id()));
 }
 
@@ -1021,9 +1260,10 @@ void macro_cache::_process_pb_service_group_member(
  *  @param im  The event.
  */
 void macro_cache::_process_index_mapping(
-    std::shared_ptr<io::data> const& data) {
+    content& c,
+    const std::shared_ptr<io::data>& data) {
   auto im = std::static_pointer_cast<storage::pb_index_mapping>(data);
-  _index_mappings[im->obj().index_id()] = im;
+  c.index_mappings.set(im->obj().index_id(), im);
 }
 
 /**
@@ -1032,9 +1272,10 @@ void macro_cache::_process_index_mapping(
  *  @param data  The event.
  */
 void macro_cache::_process_metric_mapping(
-    std::shared_ptr<io::data> const& data) {
+    content& c,
+    const std::shared_ptr<io::data>& data) {
   const auto& mm = std::static_pointer_cast<storage::pb_metric_mapping>(data);
-  _metric_mappings[mm->obj().metric_id()] = mm;
+  c.metric_mappings.set(mm->obj().metric_id(), mm);
 }
 
 /**
@@ -1043,12 +1284,13 @@ void macro_cache::_process_metric_mapping(
  *  @param data  The event.
  */
 void macro_cache::_process_dimension_ba_event(
-    std::shared_ptr<io::data> const& data) {
+    content& c,
+    const std::shared_ptr<io::data>& data) {
   auto const& dbae = std::static_pointer_cast<bam::pb_dimension_ba_event>(data);
-  SPDLOG_LOGGER_DEBUG(_cache->logger(),
+  SPDLOG_LOGGER_DEBUG(_logger,
                       "lua: pb processing dimension ba event of id {}",
                       dbae->obj().ba_id());
-  _dimension_ba_events[dbae->obj().ba_id()] = dbae;
+  c.dimension_ba_events.set(dbae->obj().ba_id(), dbae);
 }
 
 /**
@@ -1057,15 +1299,17 @@ void macro_cache::_process_dimension_ba_event(
  *  @param data  The event.
  */
 void macro_cache::_process_dimension_ba_bv_relation_event(
-    std::shared_ptr<io::data> const& data) {
+    content& c,
+    const std::shared_ptr<io::data>& data) {
   const auto& pb_data =
       std::static_pointer_cast<bam::pb_dimension_ba_bv_relation_event>(data);
   const DimensionBaBvRelationEvent& rel = pb_data->obj();
-  SPDLOG_LOGGER_DEBUG(_cache->logger(),
+  SPDLOG_LOGGER_DEBUG(_logger,
                       "lua: processing pb dimension ba bv relation event "
                       "(ba_id: {}, bv_id: {})",
                       rel.ba_id(), rel.bv_id());
-  _dimension_ba_bv_relation_events.insert({rel.ba_id(), pb_data});
+  c.dimension_ba_bv_relation_events.mut(rel.ba_id()).insert(
+      {rel.ba_id(), pb_data});
 }
 
 /**
@@ -1074,9 +1318,10 @@ void macro_cache::_process_dimension_ba_bv_relation_event(
  *  @param data  The event.
  */
 void macro_cache::_process_dimension_bv_event(
-    std::shared_ptr<io::data> const& data) {
+    content& c,
+    const std::shared_ptr<io::data>& data) {
   const auto& dbve = std::static_pointer_cast<bam::pb_dimension_bv_event>(data);
-  _dimension_bv_events[dbve->obj().bv_id()] = dbve;
+  c.dimension_bv_events.set(dbve->obj().bv_id(), dbve);
 }
 
 /**
@@ -1085,16 +1330,17 @@ void macro_cache::_process_dimension_bv_event(
  * @param data  The event.
  */
 void macro_cache::_process_pb_dimension_truncate_table_signal(
-    std::shared_ptr<io::data> const& data) {
-  SPDLOG_LOGGER_DEBUG(_cache->logger(),
+    content& c,
+    const std::shared_ptr<io::data>& data) {
+  SPDLOG_LOGGER_DEBUG(_logger,
                       "lua: processing dimension truncate table signal");
 
   if (std::static_pointer_cast<bam::pb_dimension_truncate_table_signal>(data)
           ->obj()
           .update_started()) {
-    _dimension_ba_events.clear();
-    _dimension_ba_bv_relation_events.clear();
-    _dimension_bv_events.clear();
+    c.dimension_ba_events.clear();
+    c.dimension_ba_bv_relation_events.clear();
+    c.dimension_bv_events.clear();
   }
 }
 
@@ -1106,21 +1352,22 @@ void macro_cache::_process_pb_dimension_truncate_table_signal(
  *  @param data  The event.
  */
 void macro_cache::_process_pb_custom_variable(
-    std::shared_ptr<io::data> const& data) {
+    content& c,
+    const std::shared_ptr<io::data>& data) {
   neb::pb_custom_variable::shared_ptr cv =
       std::static_pointer_cast<neb::pb_custom_variable>(data);
   if (cv->obj().name() == "CRITICALITY_LEVEL") {
     int32_t value;
     if (absl::SimpleAtoi(cv->obj().value(), &value)) {
-      SPDLOG_LOGGER_DEBUG(_cache->logger(),
+      SPDLOG_LOGGER_DEBUG(_logger,
                           "lua: processing custom variable representing a "
                           "criticality level for "
                           "host_id {} and service_id {} and level {}",
                           cv->obj().host_id(), cv->obj().service_id(), value);
       if (value)
-        _custom_vars[{cv->obj().host_id(), cv->obj().service_id()}] = cv;
+        c.custom_vars.set({cv->obj().host_id(), cv->obj().service_id()}, cv);
     } else {
-      SPDLOG_LOGGER_ERROR(_cache->logger(),
+      SPDLOG_LOGGER_ERROR(_logger,
                           "lua: processing custom variable representing a "
                           "criticality level for "
                           "host_id {} and service_id {} incorrect value {}",
@@ -1131,68 +1378,45 @@ void macro_cache::_process_pb_custom_variable(
 }
 
 /**
- *  Save all data to disk.
+ *  Save all data into a persistent cache.
+ *
+ *  @param[in] cache  The persistent cache to fill.
  */
-void macro_cache::_save_to_disk() {
-  _cache->transaction();
-
-  for (auto it(_instances.begin()), end(_instances.end()); it != end; ++it)
-    _cache->add(it->second);
-
-  for (auto it(_hosts.begin()), end(_hosts.end()); it != end; ++it)
-    _cache->add(it->second);
-
-  for (auto it = _host_groups.begin(), end = _host_groups.end(); it != end;
-       ++it) {
-    for (auto poller_id : it->second.second) {
-      it->second.first->mut_obj().set_poller_id(poller_id);
-      _cache->add(it->second.first);
+void macro_cache::save(persistent_cache& cache) const {
+  auto c = current();
+  auto add = [&cache](const auto& p) { cache.add(p.second); };
+  cache.transaction();
+
+  c->instances.for_each(add);
+  c->hosts.for_each(add);
+
+  /* Stored groups are not modified, a copy is saved for each poller. */
+  c->host_groups.for_each([&cache](const auto& p) {
+    for (auto poller_id : p.second.second) {
+      auto hg = std::make_shared<neb::pb_host_group>(*p.second.first);
+      hg->mut_obj().set_poller_id(poller_id);
+      cache.add(hg);
     }
-  }
-
-  for (auto it(_host_group_members.begin()), end(_host_group_members.end());
-       it != end; ++it)
-    _cache->add(it->second);
+  });
 
-  for (auto it(_services.begin()), end(_services.end()); it != end; ++it)
-    _cache->add(it->second);
+  c->host_group_members.for_each(add);
+  c->services.for_each(add);
 
-  for (auto it = _service_groups.begin(), end = _service_groups.end();
-       it != end; ++it) {
-    for (auto poller_id : it->second.second) {
-      it->second.first->mut_obj().set_poller_id(poller_id);
-      _cache->add(it->second.first);
+  c->service_groups.for_each([&cache](const auto& p) {
+    for (auto poller_id : p.second.second) {
+      auto sg = std::make_shared<neb::pb_service_group>(*p.second.first);
+      sg->mut_obj().set_poller_id(poller_id);
+      cache.add(sg);
     }
-  }
-
-  for (auto it = _service_group_members.begin(),
-            end = _service_group_members.end();
-       it != end; ++it)
-    _cache->add(it->second);
-
-  for (auto it(_index_mappings.begin()), end(_index_mappings.end()); it != end;
-       ++it)
-    _cache->add(it->second);
-
-  for (auto it = _metric_mappings.begin(), end = _metric_mappings.end();
-       it != end; ++it)
-    _cache->add(it->second);
+  });
 
-  for (auto it(_dimension_ba_events.begin()), end(_dimension_ba_events.end());
-       it != end; ++it)
-    _cache->add(it->second);
-
-  for (auto it(_dimension_ba_bv_relation_events.begin()),
-       end(_dimension_ba_bv_relation_events.end());
-       it != end; ++it)
-    _cache->add(it->second);
-
-  for (auto it(_dimension_bv_events.begin()), end(_dimension_bv_events.end());
-       it != end; ++it)
-    _cache->add(it->second);
+  c->service_group_members.for_each(add);
+  c->index_mappings.for_each(add);
+  c->metric_mappings.for_each(add);
+  c->dimension_ba_events.for_each(add);
+  c->dimension_ba_bv_relation_events.for_each(add);
+  c->dimension_bv_events.for_each(add);
+  c->custom_vars.for_each(add);
 
-  for (auto it = _custom_vars.begin(), end = _custom_vars.end(); it != end;
-       ++it)
-    _cache->add(it->second);
-  _cache->commit();
+  cache.commit();
 }
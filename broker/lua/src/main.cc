@@ -26,6 +26,7 @@
 #include "bbdo/storage/status.hh"
 #include "com/centreon/broker/io/protocols.hh"
 #include "com/centreon/broker/lua/factory.hh"
+#include "com/centreon/broker/lua/macro_cache.hh"
 #include "com/centreon/broker/lua/stream.hh"
 #include "common/log_v2/log_v2.hh"
 
@@ -59,6 +60,7 @@ bool broker_module_deinit() {
   if (!--instances) {
     // Unregister generic lua module.
     io::protocols::instance().unreg("lua");
+    lua::macro_cache::unload();
   }
   return true;  // ok to be unloaded
 }
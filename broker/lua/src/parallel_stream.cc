@@ -0,0 +1,275 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/broker/lua/parallel_stream.hh"
+
+#include "com/centreon/broker/exceptions/shutdown.hh"
+
+using namespace com::centreon::broker;
+using namespace com::centreon::broker::lua;
+
+/**
+ * @brief Constructor of a worker. Its Lua state is initialized here, its
+ * thread is started just after.
+ *
+ * @param lua_script The script to load.
+ * @param conf_params The configuration given to the script init() function.
+ * @param cache The macro cache shared by all the workers.
+ * @param id The index of the worker, used to name its thread.
+ */
+parallel_stream::worker::worker(
+    const std::string& lua_script,
+    const std::map<std::string, misc::variant>& conf_params,
+    macro_cache& cache,
+    uint32_t id)
+    : _cache{cache}, _luabinding(lua_script, conf_params, cache) {
+  _thread = std::thread(&worker::_run, this);
+  pthread_setname_np(_thread.native_handle(),
+                     fmt::format("lua_worker_{}", id).c_str());
+}
+
+/**
+ * @brief Destructor of a worker, it is stopped if not already done.
+ */
+parallel_stream::worker::~worker() noexcept {
+  stop();
+}
+
+/**
+ * @brief The worker thread main loop. Events are handled by batches, the
+ * queue being swapped under the lock.
+ */
+void parallel_stream::worker::_run() {
+  for (;;) {
+    std::deque<std::pair<std::shared_ptr<io::data>,
+                         std::shared_ptr<const macro_cache::content>>>
+        queue;
+    uint32_t flush_asked;
+    bool exit;
+    {
+      std::unique_lock<std::mutex> lck(_m);
+      _cv.wait(lck, [this] {
+        return !_queue.empty() || _flush_asked != _flushed || _exit;
+      });
+      std::swap(queue, _queue);
+      flush_asked = _flush_asked;
+      exit = _exit;
+    }
+
+    for (auto& [d, version] : queue) {
+      _version = std::move(version);
+      macro_cache::pin pin(_cache, _version);
+      _acks += _luabinding.write(d);
+    }
+
+    macro_cache::pin pin(_cache, _version);
+    if (exit) {
+      _acks += _luabinding.stop();
+      return;
+    }
+
+    if (flush_asked != _flushed) {
+      if (_luabinding.has_flush() || _luabinding.has_batch())
+        _acks += _luabinding.flush();
+      std::lock_guard<std::mutex> lck(_m);
+      _flushed = flush_asked;
+      _cv.notify_all();
+    }
+  }
+}
+
+/**
+ * @brief Give an event to the worker.
+ *
+ * @param d The event.
+ * @param version The version of the macro cache content when the event was
+ * received, the script reads it while handling the event.
+ */
+void parallel_stream::worker::push(
+    const std::shared_ptr<io::data>& d,
+    std::shared_ptr<const macro_cache::content> version) {
+  std::lock_guard<std::mutex> lck(_m);
+  _queue.emplace_back(d, std::move(version));
+  _cv.notify_all();
+}
+
+/**
+ * @brief Ask the worker to handle its pending events and to call the flush()
+ * function of its script.
+ *
+ * @return A ticket to give to wait_flush().
+ */
+uint32_t parallel_stream::worker::ask_flush() {
+  std::lock_guard<std::mutex> lck(_m);
+  ++_flush_asked;
+  _cv.notify_all();
+  return _flush_asked;
+}
+
+/**
+ * @brief Wait for a flush asked with ask_flush() to be done.
+ *
+ * @param ticket The value returned by ask_flush().
+ */
+void parallel_stream::worker::wait_flush(uint32_t ticket) {
+  std::unique_lock<std::mutex> lck(_m);
+  _cv.wait(lck, [this, ticket] { return _flushed == ticket || _exit; });
+}
+
+/**
+ * @brief Stop the worker. Its pending events are handled and its script is
+ * flushed before its thread exits.
+ */
+void parallel_stream::worker::stop() {
+  {
+    std::lock_guard<std::mutex> lck(_m);
+    _exit = true;
+    _cv.notify_all();
+  }
+  if (_thread.joinable())
+    _thread.join();
+}
+
+/**
+ * @brief Consume one acknowledgement of this worker.
+ *
+ * @return True if there was one.
+ */
+bool parallel_stream::worker::take_ack() {
+  /* Only the stream thread decrements the counter. */
+  if (_acks.load() > 0) {
+    --_acks;
+    return true;
+  }
+  return false;
+}
+
+/**
+ *  Constructor.
+ *
+ *  @param[in] lua_script     The script to load.
+ *  @param[in] conf_params    The configuration given to the script.
+ *  @param[in] cache          The persistent cache.
+ *  @param[in] workers_count  The number of Lua interpreters.
+ */
+parallel_stream::parallel_stream(
+    const std::string& lua_script,
+    const std::map<std::string, misc::variant>& conf_params,
+    const std::shared_ptr<persistent_cache>& cache,
+    uint32_t workers_count)
+    : io::stream("lua"),
+      _logger{cache->logger()},
+      _cache{macro_cache::instance(cache)} {
+  _workers.reserve(workers_count);
+  for (uint32_t i = 0; i < workers_count; ++i)
+    _workers.emplace_back(
+        std::make_unique<worker>(lua_script, conf_params, *_cache, i));
+  _logger->info("lua: stream started with {} workers", _workers.size());
+}
+
+/**
+ *  Destructor.
+ */
+parallel_stream::~parallel_stream() noexcept {
+  _logger->trace("lua::parallel_stream destructor {}",
+                 static_cast<void*>(this));
+  try {
+    stop();
+  } catch (const std::exception& e) {
+    _logger->error("lua: error while stopping the stream: {}", e.what());
+  }
+}
+
+/**
+ *  Read from the connector.
+ *
+ *  @param[out] d         Cleared.
+ *  @param[in]  deadline  Timeout.
+ *
+ *  @return This method will throw.
+ */
+bool parallel_stream::read(std::shared_ptr<io::data>& d, time_t deadline) {
+  (void)deadline;
+  d.reset();
+  throw exceptions::shutdown("cannot read from lua generic connector");
+}
+
+/**
+ * @brief Get the number of events that can be acknowledged to the muxer, that
+ * is the number of events at the beginning of the pending queue that are
+ * acknowledged by their worker.
+ *
+ * @return The number of events to acknowledge.
+ */
+int32_t parallel_stream::_pop_acks() {
+  int32_t retval = 0;
+  while (!_pending.empty() && _workers[_pending.front()]->take_ack()) {
+    _pending.pop_front();
+    ++retval;
+  }
+  return retval;
+}
+
+/**
+ *  Write an event.
+ *
+ *  @param[in] data Event pointer.
+ *
+ *  @return Number of events acknowledged.
+ */
+int parallel_stream::write(std::shared_ptr<io::data> const& data) {
+  assert(data);
+  uint32_t idx = _ids.host_id(*data) % _workers.size();
+  _workers[idx]->push(data, _cache->current());
+  _pending.push_back(idx);
+  return _pop_acks();
+}
+
+/**
+ *  Ask all the workers to flush and wait for them.
+ *
+ * @return The number of events to ack.
+ */
+int32_t parallel_stream::flush() {
+  if (_stopped)
+    return 0;
+  std::vector<uint32_t> tickets;
+  tickets.reserve(_workers.size());
+  for (auto& w : _workers)
+    tickets.push_back(w->ask_flush());
+  for (uint32_t i = 0; i < _workers.size(); ++i)
+    _workers[i]->wait_flush(tickets[i]);
+  int32_t retval = _pop_acks();
+  _logger->debug("parallel_stream: flush {} events acknowledged", retval);
+  return retval;
+}
+
+/**
+ * @brief Stops the workers.
+ *
+ * @return The number of acknowledged events.
+ */
+int32_t parallel_stream::stop() {
+  if (_stopped)
+    return 0;
+  _stopped = true;
+  _logger->trace("lua::parallel_stream stop {}", static_cast<void*>(this));
+  for (auto& w : _workers)
+    w->stop();
+  return _pop_acks();
+}
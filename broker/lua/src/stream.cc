@@ -40,9 +40,9 @@ stream::stream(const std::string& lua_script,
                const std::map<std::string, misc::variant>& conf_params,
                const std::shared_ptr<persistent_cache>& cache)
     : io::stream("lua"),
-      _luabinding(lua_script, conf_params, _cache),
       _logger{cache->logger()},
-      _cache{cache} {}
+      _cache{macro_cache::instance(cache)},
+      _luabinding(lua_script, conf_params, *_cache) {}
 
 stream::~stream() noexcept {
   _logger->trace("lua::stream destructor {}", static_cast<void*>(this));
@@ -70,10 +70,6 @@ bool stream::read(std::shared_ptr<io::data>& d, time_t deadline) {
  */
 int stream::write(std::shared_ptr<io::data> const& data) {
   assert(data);
-
-  // Give data to cache.
-  _cache.write(data);
-
   return _luabinding.write(data);
 }
 
@@ -86,7 +82,7 @@ int stream::write(std::shared_ptr<io::data> const& data) {
  */
 int32_t stream::flush() {
   int32_t retval = 0;
-  if (_luabinding.has_flush()) {
+  if (_luabinding.has_flush() || _luabinding.has_batch()) {
     retval = _luabinding.flush();
     _logger->debug("stream: flush {} events acknowledged", retval);
   }
@@ -31,10 +31,13 @@
 #include "broker/test/test_server.hh"
 #include "com/centreon/broker/config/applier/init.hh"
 #include "com/centreon/broker/config/applier/modules.hh"
+#include "com/centreon/broker/config/applier/state.hh"
 #include "com/centreon/broker/config/endpoint.hh"
 #include "com/centreon/broker/lua/connector.hh"
 #include "com/centreon/broker/lua/factory.hh"
 #include "com/centreon/broker/lua/luabinding.hh"
+#include "com/centreon/broker/lua/parallel_stream.hh"
+#include "com/centreon/broker/multiplexing/engine.hh"
 #include "com/centreon/broker/neb/events.hh"
 #include "com/centreon/exceptions/msg_fmt.hh"
 #include "common/crypto/aes256.hh"
@@ -72,8 +75,9 @@ class LuaTest : public ::testing::Test {
     _cache = std::make_unique<macro_cache>(pcache);
   }
   void TearDown() override {
-    // The cache must be destroyed before the applier deinit() call.
+    // The caches must be destroyed before the applier deinit() call.
     _cache.reset();
+    macro_cache::unload();
     config::applier::deinit();
     ::remove("/tmp/broker_test_cache");
   }
@@ -2923,6 +2927,7 @@ TEST_F(LuaTest, TestHostApiV1) {
                "  broker_log:info(0, 'type of hst = ' .. type(hst))\n"
                "end\n");
   auto binding{std::make_unique<luabinding>(filename, conf, *_cache)};
+  _cache->write(hst);
   binding->write(hst);
   std::string lst(ReadFile("/tmp/event_log"));
   ASSERT_NE(lst.find("type of d = table"), std::string::npos);
@@ -2950,6 +2955,7 @@ TEST_F(LuaTest, TestHostApiV2) {
                "  broker_log:info(0, 'type of hst = ' .. type(hst))\n"
                "end\n");
   auto binding{std::make_unique<luabinding>(filename, conf, *_cache)};
+  _cache->write(hst);
   binding->write(hst);
   std::string lst(ReadFile("/tmp/event_log"));
   ASSERT_NE(lst.find("type of d = userdata"), std::string::npos);
@@ -2978,6 +2984,7 @@ TEST_F(LuaTest, PbTestHostApiV1) {
                "  broker_log:info(0, 'type of hst = ' .. type(hst))\n"
                "end\n");
   auto binding{std::make_unique<luabinding>(filename, conf, *_cache)};
+  _cache->write(hst);
   binding->write(hst);
   std::string lst(ReadFile("/tmp/event_log"));
   ASSERT_NE(lst.find("type of d = table"), std::string::npos);
@@ -3006,6 +3013,7 @@ TEST_F(LuaTest, PbTestHostApiV2) {
                "  broker_log:info(0, 'type of hst = ' .. type(hst))\n"
                "end\n");
   auto binding{std::make_unique<luabinding>(filename, conf, *_cache)};
+  _cache->write(hst);
   binding->write(hst);
   std::string lst(ReadFile("/tmp/event_log"));
   ASSERT_NE(lst.find("type of d = userdata"), std::string::npos);
@@ -3178,6 +3186,7 @@ TEST_F(LuaTest, TestSvcApiV2) {
                "  broker_log:info(0, 'type of svc = ' .. type(svc))\n"
                "end\n");
   auto binding{std::make_unique<luabinding>(filename, conf, *_cache)};
+  _cache->write(svc);
   binding->write(svc);
   std::string lst(ReadFile("/tmp/event_log"));
   ASSERT_NE(lst.find("type of d = userdata"), std::string::npos);
@@ -3209,6 +3218,7 @@ TEST_F(LuaTest, TestSvcApiV1) {
                "  broker_log:info(0, 'type of svc = ' .. type(svc))\n"
                "end\n");
   auto binding{std::make_unique<luabinding>(filename, conf, *_cache)};
+  _cache->write(svc);
   binding->write(svc);
   std::string lst(ReadFile("/tmp/event_log"));
   ASSERT_NE(lst.find("type of d = table"), std::string::npos);
@@ -3238,6 +3248,7 @@ TEST_F(LuaTest, BrokerEventCache) {
                "  broker_log:info(0, 'description = ' .. svc.description)\n"
                "end\n");
   auto binding{std::make_unique<luabinding>(filename, conf, *_cache)};
+  _cache->write(svc);
   binding->write(svc);
   std::string lst(ReadFile("/tmp/event_log"));
   ASSERT_NE(lst.find("description = foo bar cache"), std::string::npos);
@@ -3270,6 +3281,7 @@ TEST_F(LuaTest, PbTestSvcApiV2) {
                "  broker_log:info(0, 'type of svc = ' .. type(svc))\n"
                "end\n");
   auto binding{std::make_unique<luabinding>(filename, conf, *_cache)};
+  _cache->write(svc);
   binding->write(svc);
   std::string lst(ReadFile("/tmp/event_log"));
   std::cout << lst << std::endl;
@@ -3304,6 +3316,7 @@ TEST_F(LuaTest, PbTestSvcApiV1) {
                "  broker_log:info(0, 'type of svc = ' .. type(svc))\n"
                "end\n");
   auto binding{std::make_unique<luabinding>(filename, conf, *_cache)};
+  _cache->write(svc);
   binding->write(svc);
   std::string lst(ReadFile("/tmp/event_log"));
   std::cout << lst << std::endl;
@@ -3521,6 +3534,7 @@ TEST_F(LuaTest, PbBrokerEventCache) {
                "svc.description)\n"
                "end\n");
   auto binding{std::make_unique<luabinding>(filename, conf, *_cache)};
+  _cache->write(svc);
   binding->write(svc);
   std::string lst(ReadFile("/tmp/event_log"));
   std::cout << lst << std::endl;
@@ -5226,3 +5240,323 @@ TEST_F(LuaTest, Base64) {
   RemoveFile(filename);
   RemoveFile("/tmp/log");
 }
+
+// When events of several hosts are written to a stream with several workers
+// Then all of them are acknowledged, and the acknowledgements returned by the
+// stream never exceed the events written.
+TEST_F(LuaTest, ParallelStreamAcks) {
+  std::map<std::string, misc::variant> conf;
+  std::string filename("/tmp/parallel.lua");
+  CreateScript(filename,
+               "broker_api_version = 2\n"
+               "function init(conf)\n"
+               "end\n\n"
+               "function write(d)\n"
+               "  return true\n"
+               "end\n");
+  auto pcache = std::make_shared<persistent_cache>(
+      "/tmp/broker_test_parallel_cache", _logger);
+  auto s = std::make_unique<parallel_stream>(filename, conf, pcache, 4);
+
+  constexpr int32_t count = 10000;
+  int32_t acks = 0;
+  for (int32_t i = 0; i < count; ++i) {
+    auto ss = std::make_shared<neb::pb_service_status>();
+    ss->mut_obj().set_host_id(i % 50 + 1);
+    ss->mut_obj().set_service_id(i + 1);
+    acks += s->write(ss);
+    ASSERT_LE(acks, i + 1);
+  }
+  acks += s->flush();
+  acks += s->stop();
+  ASSERT_EQ(acks, count);
+  s.reset();
+  RemoveFile(filename);
+  RemoveFile("/tmp/broker_test_parallel_cache");
+}
+
+// When the script of a stream with several workers only acknowledges its
+// events in flush()
+// Then the stream acknowledges nothing until it is flushed.
+TEST_F(LuaTest, ParallelStreamFlush) {
+  std::map<std::string, misc::variant> conf;
+  std::string filename("/tmp/parallel_flush.lua");
+  CreateScript(filename,
+               "broker_api_version = 2\n"
+               "function init(conf)\n"
+               "end\n\n"
+               "function write(d)\n"
+               "  return false\n"
+               "end\n\n"
+               "function flush()\n"
+               "  return true\n"
+               "end\n");
+  auto pcache = std::make_shared<persistent_cache>(
+      "/tmp/broker_test_parallel_cache", _logger);
+  auto s = std::make_unique<parallel_stream>(filename, conf, pcache, 3);
+
+  int32_t acks = 0;
+  for (int32_t i = 0; i < 100; ++i) {
+    auto hs = std::make_shared<neb::pb_host_status>();
+    hs->mut_obj().set_host_id(i + 1);
+    acks += s->write(hs);
+  }
+  /* An event not tied to a host. */
+  acks += s->write(std::make_shared<neb::pb_instance>());
+  ASSERT_EQ(acks, 0);
+  ASSERT_EQ(s->flush(), 101);
+  s.reset();
+  RemoveFile(filename);
+  RemoveFile("/tmp/broker_test_parallel_cache");
+}
+
+// Given a script using the api v3 with a write_batch() function and a
+// broker_filter table accepting only the services of the host 1
+// When events are written
+// Then write_batch() receives them by batches of broker_batch_size events,
+// only with the accepted ones, and all the events are acknowledged.
+TEST_F(LuaTest, WriteBatchWithFilter) {
+  std::map<std::string, misc::variant> conf;
+  std::string filename("/tmp/write_batch.lua");
+  CreateScript(filename,
+               "broker_api_version = 3\n"
+               "broker_batch_size = 10\n"
+               "broker_filter = {\n"
+               "  elements = { { 1, 29 } },\n"
+               "  hosts = { 1 },\n"
+               "}\n"
+               "function init(conf)\n"
+               "  broker_log:set_parameters(3, '/tmp/log')\n"
+               "end\n\n"
+               "function write_batch(events)\n"
+               "  local ids = {}\n"
+               "  for i, e in ipairs(events) do\n"
+               "    ids[#ids + 1] = e.host_id .. ':' .. e.service_id\n"
+               "  end\n"
+               "  broker_log:info(1, 'batch ' .. table.concat(ids, ','))\n"
+               "  return true\n"
+               "end\n");
+  auto binding{std::make_unique<luabinding>(filename, conf, *_cache)};
+  ASSERT_TRUE(binding->has_batch());
+
+  int32_t acks = 0;
+  for (int32_t i = 0; i < 30; ++i) {
+    auto ss = std::make_shared<neb::pb_service_status>();
+    ss->mut_obj().set_host_id(i % 2 + 1);
+    ss->mut_obj().set_service_id(i);
+    acks += binding->write(ss);
+  }
+  /* Not accepted by the elements of the filter. */
+  auto hs = std::make_shared<neb::pb_host_status>();
+  hs->mut_obj().set_host_id(1);
+  acks += binding->write(hs);
+  /* 15 services are accepted, so one batch has been sent. */
+  ASSERT_EQ(acks, 19);
+  acks += binding->flush();
+  ASSERT_EQ(acks, 31);
+
+  std::string lst(ReadFile("/tmp/log"));
+  ASSERT_NE(lst.find("batch 1:0,1:2,1:4,1:6,1:8,1:10,1:12,1:14,1:16,1:18\n"),
+            std::string::npos);
+  ASSERT_NE(lst.find("batch 1:20,1:22,1:24,1:26,1:28\n"), std::string::npos);
+  ASSERT_EQ(lst.find(",2:"), std::string::npos);
+  binding.reset();
+  RemoveFile(filename);
+  RemoveFile("/tmp/log");
+}
+
+// Given two Lua streams
+// When they get the macro cache
+// Then they share the same one, loaded only once.
+// And when a host status is written, the host returned before is not modified.
+TEST_F(LuaTest, SharedMacroCache) {
+  auto pcache1 = std::make_shared<persistent_cache>(
+      "/tmp/broker_test_shared_cache1", _logger);
+  auto pcache2 = std::make_shared<persistent_cache>(
+      "/tmp/broker_test_shared_cache2", _logger);
+  auto cache1 = macro_cache::instance(pcache1);
+  auto cache2 = macro_cache::instance(pcache2);
+  ASSERT_EQ(cache1, cache2);
+
+  auto hst{std::make_shared<neb::pb_host>()};
+  hst->mut_obj().set_host_id(1);
+  hst->mut_obj().set_name("centreon");
+  hst->mut_obj().set_enabled(true);
+  cache1->write(hst);
+
+  auto before = cache2->get_host(1);
+  auto hs{std::make_shared<neb::pb_host_status>()};
+  hs->mut_obj().set_host_id(1);
+  hs->mut_obj().set_output("new output");
+  cache2->write(hs);
+  auto after = cache1->get_host(1);
+
+  ASSERT_EQ(before, hst);
+  ASSERT_EQ(before->obj().output(), "");
+  ASSERT_NE(after, before);
+  ASSERT_EQ(after->obj().output(), "new output");
+  ASSERT_EQ(after->obj().name(), "centreon");
+
+  cache1.reset();
+  cache2.reset();
+  macro_cache::unload();
+  RemoveFile("/tmp/broker_test_shared_cache1");
+  RemoveFile("/tmp/broker_test_shared_cache2");
+  RemoveFile(fmt::format("{}.cache.lua_macro_cache",
+                         config::applier::state::instance().cache_dir()));
+}
+
+// Given the shared macro cache
+// When events are published by the multiplexing engine
+// Then the cache receives them from its own muxer, without any Lua stream
+// writing them.
+// And a content got before an update is not modified by it.
+TEST_F(LuaTest, SharedMacroCacheFedByEngine) {
+  auto pcache = std::make_shared<persistent_cache>(
+      "/tmp/broker_test_shared_cache", _logger);
+  auto cache = macro_cache::instance(pcache);
+  multiplexing::engine::instance_ptr()->start();
+
+  auto wait_for = [&cache](const std::string& output) {
+    for (int i = 0; i < 500; ++i) {
+      auto c = cache->current();
+      auto found = c->hosts.find(1);
+      if (found && (*found)->obj().output() == output)
+        return true;
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+  };
+
+  auto hst{std::make_shared<neb::pb_host>()};
+  hst->mut_obj().set_host_id(1);
+  hst->mut_obj().set_name("centreon");
+  hst->mut_obj().set_enabled(true);
+  hst->mut_obj().set_output("first output");
+  multiplexing::engine::instance_ptr()->publish(hst);
+  ASSERT_TRUE(wait_for("first output"));
+
+  auto before = cache->current();
+  auto hs{std::make_shared<neb::pb_host_status>()};
+  hs->mut_obj().set_host_id(1);
+  hs->mut_obj().set_output("new output");
+  multiplexing::engine::instance_ptr()->publish(hs);
+  ASSERT_TRUE(wait_for("new output"));
+  ASSERT_EQ((*before->hosts.find(1))->obj().output(), "first output");
+  ASSERT_EQ(cache->get_host_name(1), "centreon");
+
+  before.reset();
+  cache.reset();
+  macro_cache::unload();
+  RemoveFile("/tmp/broker_test_shared_cache");
+  RemoveFile(fmt::format("{}.cache.lua_macro_cache",
+                         config::applier::state::instance().cache_dir()));
+}
+
+// Given a stream with two workers, the first one being busy
+// When a metric mapping is in the shared cache
+// Then the second worker finds it, even if the first one is still busy.
+TEST_F(LuaTest, ParallelStreamCacheAcrossWorkers) {
+  std::map<std::string, misc::variant> conf;
+  std::string filename("/tmp/parallel_cache.lua");
+  CreateScript(filename,
+               fmt::format(
+                   "broker_api_version = 2\n"
+                   "function init(conf)\n"
+                   "  broker_log:set_parameters(3, '/tmp/log')\n"
+                   "end\n\n"
+                   "function write(d)\n"
+                   "  if d._type == {} then\n"
+                   "    local t = os.clock()\n"
+                   "    while os.clock() - t < 0.5 do end\n"
+                   "  elseif d.category == 1 then\n"
+                   "    local mm = broker_cache:get_metric_mapping(27)\n"
+                   "    broker_log:info(1, 'index of metric 27: ' .. "
+                   "tostring(mm and mm.index_id))\n"
+                   "  end\n"
+                   "  return true\n"
+                   "end\n",
+                   neb::pb_instance::static_type()));
+  auto pcache = std::make_shared<persistent_cache>(
+      "/tmp/broker_test_parallel_cache", _logger);
+  auto s = std::make_unique<parallel_stream>(filename, conf, pcache, 2);
+
+  int32_t acks = s->write(std::make_shared<neb::pb_instance>());
+  auto mm = std::make_shared<storage::pb_metric_mapping>();
+  mm->mut_obj().set_index_id(19);
+  mm->mut_obj().set_metric_id(27);
+  macro_cache::instance(pcache)->write(mm);
+  auto ss = std::make_shared<neb::pb_service_status>();
+  ss->mut_obj().set_host_id(1);
+  ss->mut_obj().set_service_id(1);
+  acks += s->write(ss);
+  acks += s->flush();
+  acks += s->stop();
+  ASSERT_EQ(acks, 2);
+
+  std::string lst(ReadFile("/tmp/log"));
+  ASSERT_NE(lst.find("index of metric 27: 19"), std::string::npos);
+  s.reset();
+  RemoveFile(filename);
+  RemoveFile("/tmp/log");
+  RemoveFile("/tmp/broker_test_parallel_cache");
+}
+
+// Given a stream with two workers, the worker of host 2 being busy
+// When an event of host 2 is written, and then the host is renamed in the
+// shared cache
+// Then the worker still sees the name the host had when the event was
+// received.
+TEST_F(LuaTest, ParallelStreamWorkerCacheView) {
+  std::map<std::string, misc::variant> conf;
+  std::string filename("/tmp/parallel_view.lua");
+  CreateScript(filename,
+               fmt::format(
+                   "broker_api_version = 2\n"
+                   "function init(conf)\n"
+                   "  broker_log:set_parameters(3, '/tmp/log')\n"
+                   "end\n\n"
+                   "function write(d)\n"
+                   "  if d._type == {} then\n"
+                   "    local t = os.clock()\n"
+                   "    while os.clock() - t < 0.5 do end\n"
+                   "  elseif d.category == 1 then\n"
+                   "    broker_log:info(1, 'host name: ' .. "
+                   "tostring(broker_cache:get_hostname(d.host_id)))\n"
+                   "  end\n"
+                   "  return true\n"
+                   "end\n",
+                   neb::pb_instance::static_type()));
+  auto pcache = std::make_shared<persistent_cache>(
+      "/tmp/broker_test_parallel_cache", _logger);
+  auto cache = macro_cache::instance(pcache);
+  auto hst{std::make_shared<neb::pb_host>()};
+  hst->mut_obj().set_host_id(2);
+  hst->mut_obj().set_name("before");
+  hst->mut_obj().set_enabled(true);
+  cache->write(hst);
+
+  auto s = std::make_unique<parallel_stream>(filename, conf, pcache, 2);
+  int32_t acks = s->write(std::make_shared<neb::pb_instance>());
+  auto ss = std::make_shared<neb::pb_service_status>();
+  ss->mut_obj().set_host_id(2);
+  ss->mut_obj().set_service_id(1);
+  acks += s->write(ss);
+
+  auto renamed{std::make_shared<neb::pb_host>(*hst)};
+  renamed->mut_obj().set_name("after");
+  cache->write(renamed);
+
+  acks += s->flush();
+  acks += s->stop();
+  ASSERT_EQ(acks, 2);
+
+  std::string lst(ReadFile("/tmp/log"));
+  ASSERT_NE(lst.find("host name: before"), std::string::npos);
+  ASSERT_EQ(cache->get_host_name(2), "after");
+  s.reset();
+  cache.reset();
+  RemoveFile(filename);
+  RemoveFile("/tmp/log");
+  RemoveFile("/tmp/broker_test_parallel_cache");
+}
@@ -19,6 +19,7 @@
 #include "com/centreon/broker/config/applier/init.hh"
 #include "com/centreon/broker/config/applier/state.hh"
 #include "com/centreon/broker/config/parser.hh"
+#include "com/centreon/broker/io/trace.hh"
 #include "com/centreon/broker/multiplexing/publisher.hh"
 #include "com/centreon/broker/neb/events.hh"
 #include "com/centreon/common/utf8.hh"
@@ -108,6 +109,10 @@ const std::string& cbmod::poller_name() const {
 
 void cbmod::write(const std::shared_ptr<io::data>& msg) {
   _neb_logger->info("cbmod: write event of type {:x}", msg->type());
+  if (auto t = io::trace::sample()) {
+    t->add_stamp(io::trace::callback);
+    msg->trace = std::move(t);
+  }
   _impl->mut_publisher().write(msg);
 }
 
@@ -31,6 +31,7 @@
 #include "bbdo/storage/status.hh"
 #include "com/centreon/broker/exceptions/shutdown.hh"
 #include "com/centreon/broker/io/events.hh"
+#include "com/centreon/broker/io/trace.hh"
 #include "com/centreon/broker/rrd/exceptions/open.hh"
 #include "com/centreon/broker/rrd/exceptions/update.hh"
 #include "com/centreon/common/perfdata.hh"
@@ -538,6 +539,8 @@ int output<T>::write(std::shared_ptr<io::data> const& d) {
       _logger->warn("RRD: unknown BBDO message received of type {}", d->type());
   }
 
+  if (d->trace)
+    d->trace->commit("rrd");
   return 1;
 }
 
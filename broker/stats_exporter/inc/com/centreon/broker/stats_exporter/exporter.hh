@@ -159,14 +159,24 @@ class exporter {
   };
   std::vector<sql_connection> _conn;
 
+  /* Event latencies, stages appear with the first traced events. */
+  struct latency_instrument {
+    std::unique_ptr<instrument_i64> count;
+    std::unique_ptr<instrument_f64> average;
+    std::unique_ptr<instrument_f64> p95;
+  };
+  std::map<std::string, latency_instrument> _latency;
+
   /**
-   * @brief This is useful when mysql connections change, we can update
-   * observers.
+   * @brief This is useful when mysql connections change or when new event
+   * latency stages appear, we can update observers.
    */
   asio::steady_timer _connections_watcher;
 
   void _check_connections(std::shared_ptr<metrics_api::MeterProvider> provider,
                           const boost::system::error_code& ec);
+  void _check_event_latency(
+      std::shared_ptr<metrics_api::MeterProvider>& provider);
 
  public:
   exporter();
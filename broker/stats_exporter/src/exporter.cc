@@ -268,6 +268,8 @@ void exporter::_check_connections(
     if (_conn.size() > count)
       _conn.resize(count);
 
+    _check_event_latency(provider);
+
     _connections_watcher.expires_after(std::chrono::seconds(10));
     _connections_watcher.async_wait(
         [this, provider](const boost::system::error_code& err) {
@@ -275,3 +277,81 @@ void exporter::_check_connections(
         });
   }
 }
+
+/**
+ * @brief Estimate a percentile of a latency histogram: it is the upper bound
+ * of the bucket containing it (the max for the last bucket).
+ *
+ * @param h The histogram.
+ * @param bounds The bounds of the buckets.
+ * @param q The percentile in [0, 1].
+ *
+ * @return A duration in milliseconds.
+ */
+static double latency_percentile(
+    const LatencyHistogram& h,
+    const google::protobuf::RepeatedField<double>& bounds,
+    double q) {
+  uint64_t rank = static_cast<uint64_t>(std::ceil(q * h.count()));
+  uint64_t cumul = 0;
+  for (int i = 0; i < h.buckets_size(); ++i) {
+    cumul += h.buckets(i);
+    if (cumul >= rank && cumul > 0)
+      return i < bounds.size() ? std::min(bounds[i], h.max()) : h.max();
+  }
+  return 0;
+}
+
+/**
+ * @brief Add instruments for the event latency stages that appeared since the
+ * last check: for each one, the number of traced events, the average and the
+ * 95th percentile of the latency in milliseconds.
+ *
+ * @param provider The meter provider.
+ */
+void exporter::_check_event_latency(
+    std::shared_ptr<metrics_api::MeterProvider>& provider) {
+  std::vector<std::string> stages;
+  {
+    std::lock_guard<stats::center> lck(*_center);
+    for (auto& p : _center->stats().event_latency().stages())
+      if (_latency.find(p.first) == _latency.end())
+        stages.push_back(p.first);
+  }
+
+  for (auto& name : stages) {
+    latency_instrument& li = _latency[name];
+    li.count = std::make_unique<instrument_i64>(
+        provider, fmt::format("event_latency_{}_count", name),
+        fmt::format("Number of traced events for the stage '{}'", name),
+        [name, center = _center]() -> int64_t {
+          const auto& s = center->stats().event_latency();
+          auto it = s.stages().find(name);
+          return it == s.stages().end() ? 0 : it->second.count();
+        });
+
+    li.average = std::make_unique<instrument_f64>(
+        provider, fmt::format("event_latency_{}_average", name),
+        fmt::format("Average latency in milliseconds of the stage '{}'", name),
+        [name, center = _center]() -> double {
+          const auto& s = center->stats().event_latency();
+          auto it = s.stages().find(name);
+          if (it == s.stages().end() || !it->second.count())
+            return 0;
+          return it->second.sum() / it->second.count();
+        });
+
+    li.p95 = std::make_unique<instrument_f64>(
+        provider, fmt::format("event_latency_{}_p95", name),
+        fmt::format("95th percentile of the latency in milliseconds of the "
+                    "stage '{}'",
+                    name),
+        [name, center = _center]() -> double {
+          const auto& s = center->stats().event_latency();
+          auto it = s.stages().find(name);
+          if (it == s.stages().end())
+            return 0;
+          return latency_percentile(it->second, s.bounds(), 0.95);
+        });
+  }
+}
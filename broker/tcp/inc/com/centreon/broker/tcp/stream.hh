@@ -56,6 +56,7 @@ class stream : public io::stream {
   int32_t stop() override;
   int32_t write(std::shared_ptr<io::data> const& d) override;
   bool wait_for_all_events_written(unsigned ms_timeout) override;
+  bool set_ktls_tx(const std::vector<char>& crypto_info) override;
 };
 }  // namespace tcp
 
@@ -81,6 +81,7 @@ class tcp_connection : public std::enable_shared_from_this<tcp_connection> {
   uint16_t port() const;
 
   bool wait_for_all_events_written(unsigned ms_timeout);
+  bool set_ktls_tx(const std::vector<char>& crypto_info);
 };
 
 }  // namespace com::centreon::broker::tcp
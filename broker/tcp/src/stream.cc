@@ -207,3 +207,17 @@ bool stream::wait_for_all_events_written(unsigned ms_timeout) {
 
   return _connection->wait_for_all_events_written(ms_timeout);
 }
+
+/**
+ * @brief Install kTLS on the socket, the data written after this call are
+ * encrypted by the kernel.
+ *
+ * @param crypto_info The kernel tls12_crypto_info_* structure to install.
+ *
+ * @return true on success.
+ */
+bool stream::set_ktls_tx(const std::vector<char>& crypto_info) {
+  if (_connection->is_closed())
+    return false;
+  return _connection->set_ktls_tx(crypto_info);
+}
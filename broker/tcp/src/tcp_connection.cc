@@ -17,6 +17,9 @@
  */
 #include "com/centreon/broker/tcp/tcp_connection.hh"
 
+#include <linux/tls.h>
+#include <netinet/tcp.h>
+
 #include "com/centreon/broker/exceptions/connection_closed.hh"
 #include "com/centreon/common/hex_dump.hh"
 #include "com/centreon/exceptions/msg_fmt.hh"
@@ -27,6 +30,13 @@ using namespace com::centreon::broker::tcp;
 using com::centreon::common::debug_buf;
 using log_v2 = com::centreon::common::log_v2::log_v2;
 
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+
 static const boost::system::error_code _eof_error =
     boost::asio::error::make_error_code(boost::asio::error::misc_errors::eof);
 
@@ -174,6 +184,38 @@ bool tcp_connection::wait_for_all_events_written(unsigned ms_timeout) {
                               [this]() { return !_writing; });
 }
 
+/**
+ * @brief Install kTLS on the socket for the data we send: from now on, the
+ * data given to write() are plain and the kernel encrypts them. The data
+ * already queued (the end of the TLS handshake) must reach the socket before,
+ * so we wait for the write queue to be empty. On failure, nothing is changed
+ * on the socket and the caller keeps encrypting the data itself.
+ *
+ * @param crypto_info The kernel tls12_crypto_info_* structure to install.
+ *
+ * @return true on success.
+ */
+bool tcp_connection::set_ktls_tx(const std::vector<char>& crypto_info) {
+  if (!wait_for_all_events_written(5000)) {
+    _logger->error("kTLS: cannot flush the connection to {}", peer());
+    return false;
+  }
+  int fd = _socket.native_handle();
+  if (setsockopt(fd, SOL_TCP, TCP_ULP, "tls", sizeof("tls")) < 0) {
+    _logger->info("kTLS: not available on the connection to {}: {}", peer(),
+                  strerror(errno));
+    return false;
+  }
+  if (setsockopt(fd, SOL_TLS, TLS_TX, crypto_info.data(),
+                 crypto_info.size()) < 0) {
+    _logger->error("kTLS: cannot install the TX keys for {}: {}", peer(),
+                   strerror(errno));
+    return false;
+  }
+  _logger->info("kTLS: data sent to {} are encrypted by the kernel", peer());
+  return true;
+}
+
 /**
  * @brief Execute the real writing on the socket. Infact, this function:
  *  * checks if the _write_queue is empty, and then exchanges its content with
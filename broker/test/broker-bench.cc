@@ -0,0 +1,697 @@
+/**
+ * Copyright 2024 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+/**
+ * End-to-end throughput of a broker. The real broker runs in this process with
+ * a bbdo_server input over TCP on the loopback and one output. A poller is
+ * simulated by a BBDO client stream that connects to this input and sends
+ * service statuses with perfdata and log entries, or events replayed from a
+ * recorded queue file.
+ *
+ * Events are traced as with the event_trace_sampling configuration entry, so
+ * the latencies are the ones measured by the broker stats, from the
+ * generation of the event to its commit by the output. The run is over when
+ * the last event, always traced, has been committed.
+
+ ./broker-bench [options]
+
+ -n, --events N        number of events to send (100000).
+ -o, --output TYPE     null, file or unified_sql (null). The file output is a
+                       Lua stream connector writing events as json lines.
+ -z, --compression     compress the BBDO stream.
+ -r, --rate N          events per second, 0 for as fast as possible (0).
+ -s, --sampling N      one event over N is traced (100).
+ -R, --replay FILE     send the events of a queue file instead of synthetic
+                       ones. The file is copied first, it is not consumed.
+ -H, --hosts N         number of hosts of the synthetic events (100).
+ -S, --services N      number of services by host (50).
+ -m, --metrics N       number of metrics in each perfdata (4).
+ -l, --logs N          one log entry every N service statuses, 0 for none
+                       (10).
+ -p, --port N          port of the broker input (5699).
+ -w, --work-dir DIR    logs, caches and output files (/tmp/broker-bench).
+ -M, --module-dir DIR  directory of the broker modules (build directory).
+     --db-host, --db-port, --db-user, --db-password, --db-name
+                       database of the unified_sql output (localhost, 3306,
+                       centreon, centreon, centreon_storage).
+
+ The unified_sql output expects a centreon_storage database, events are about
+ hosts 1..N and services 1..M of each host.
+*/
+#include <arpa/inet.h>
+#include <getopt.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <absl/strings/numbers.h>
+#include <boost/asio.hpp>
+#include <fmt/format.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+#include "bbdo/common.pb.h"
+#include "broker/core/bbdo/stream.hh"
+#include "com/centreon/broker/config/applier/init.hh"
+#include "com/centreon/broker/config/applier/state.hh"
+#include "com/centreon/broker/config/state.hh"
+#include "com/centreon/broker/exceptions/shutdown.hh"
+#include "com/centreon/broker/io/endpoint.hh"
+#include "com/centreon/broker/io/factory.hh"
+#include "com/centreon/broker/io/protocols.hh"
+#include "com/centreon/broker/io/raw.hh"
+#include "com/centreon/broker/io/trace.hh"
+#include "com/centreon/broker/neb/internal.hh"
+#include "com/centreon/broker/persistent_file.hh"
+#include "com/centreon/broker/stats/center.hh"
+#include "com/centreon/common/pool.hh"
+#include "com/centreon/exceptions/msg_fmt.hh"
+#include "common/crypto/aes256.hh"
+#include "common/log_v2/log_v2.hh"
+
+namespace asio = boost::asio;
+using namespace com::centreon::broker;
+using namespace com::centreon::exceptions;
+using log_v2 = com::centreon::common::log_v2::log_v2;
+
+std::shared_ptr<asio::io_context> g_io_context =
+    std::make_shared<asio::io_context>();
+
+std::shared_ptr<com::centreon::common::crypto::aes256> credentials_decrypt;
+
+namespace {
+struct options {
+  uint64_t events = 100000;
+  std::string output = "null";
+  bool compression = false;
+  uint32_t rate = 0;
+  uint32_t sampling = 100;
+  std::string replay;
+  uint32_t hosts = 100;
+  uint32_t services = 50;
+  uint32_t metrics = 4;
+  uint32_t logs = 10;
+  uint16_t port = 5699;
+  std::string work_dir = "/tmp/broker-bench";
+  std::string module_dir = BROKER_BENCH_MODULE_DIR;
+  std::string db_host = "localhost";
+  std::string db_port = "3306";
+  std::string db_user = "centreon";
+  std::string db_password = "centreon";
+  std::string db_name = "centreon_storage";
+};
+
+/**
+ * @brief The poller side of the TCP connection. Written buffers are gathered
+ * and sent by 64kB, or when the BBDO stream flushes or waits for its peer.
+ */
+class client_stream : public io::stream {
+  int _fd;
+  std::vector<char> _out;
+
+ public:
+  client_stream(uint16_t port) : io::stream("bench_client") {
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    /* The acceptor of the broker is started asynchronously. */
+    for (int i = 0;; ++i) {
+      _fd = ::socket(AF_INET, SOCK_STREAM, 0);
+      if (::connect(_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) ==
+          0)
+        break;
+      ::close(_fd);
+      if (i == 100)
+        throw msg_fmt("cannot connect to the broker input on port {}", port);
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    int one = 1;
+    ::setsockopt(_fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    _out.reserve(1 << 16);
+  }
+
+  ~client_stream() noexcept { ::close(_fd); }
+
+  bool read(std::shared_ptr<io::data>& d, time_t deadline) override {
+    flush();
+    int timeout = -1;
+    if (deadline != static_cast<time_t>(-1)) {
+      time_t now = time(nullptr);
+      timeout = deadline > now ? (deadline - now) * 1000 : 0;
+    }
+    pollfd pfd{_fd, POLLIN, 0};
+    if (::poll(&pfd, 1, timeout) <= 0) {
+      d.reset();
+      return false;
+    }
+    auto r = std::make_shared<io::raw>();
+    r->resize(1 << 16);
+    ssize_t n = ::recv(_fd, r->data(), r->size(), 0);
+    if (n <= 0)
+      throw msg_fmt("Connection lost");
+    r->resize(n);
+    d = std::move(r);
+    return true;
+  }
+
+  int write(const std::shared_ptr<io::data>& d) override {
+    auto& buffer = std::static_pointer_cast<io::raw>(d)->get_buffer();
+    _out.insert(_out.end(), buffer.begin(), buffer.end());
+    if (_out.size() >= (1 << 16))
+      flush();
+    return 1;
+  }
+
+  int flush() override {
+    size_t sent = 0;
+    while (sent < _out.size()) {
+      ssize_t n = ::send(_fd, _out.data() + sent, _out.size() - sent, 0);
+      if (n < 0)
+        throw msg_fmt("Connection lost");
+      sent += n;
+    }
+    _out.clear();
+    return 0;
+  }
+
+  int32_t stop() override {
+    flush();
+    return 0;
+  }
+};
+
+/**
+ * @brief The null output: events are acknowledged as soon as they are
+ * written, their traces are committed as by any other output.
+ */
+class null_stream : public io::stream {
+ public:
+  null_stream() : io::stream("bench_null") {}
+  bool read(std::shared_ptr<io::data>& d, time_t) override {
+    d.reset();
+    throw exceptions::shutdown("cannot read from a null stream");
+  }
+  int write(const std::shared_ptr<io::data>& d) override {
+    if (d->trace)
+      d->trace->commit("null");
+    return 1;
+  }
+  int32_t stop() override { return 0; }
+};
+
+class null_connector : public io::endpoint {
+ public:
+  null_connector()
+      : io::endpoint(false, multiplexing::muxer_filter(),
+                     multiplexing::muxer_filter(
+                         multiplexing::muxer_filter::zero_init())) {}
+  std::shared_ptr<io::stream> open() override {
+    return std::make_shared<null_stream>();
+  }
+};
+
+class null_factory : public io::factory {
+ public:
+  bool has_endpoint(config::endpoint& cfg, io::extension* ext) override {
+    if (ext)
+      *ext = io::extension("BENCH_NULL", false, false);
+    return cfg.type == "bench_null";
+  }
+  io::endpoint* new_endpoint(
+      config::endpoint& cfg [[maybe_unused]],
+      const std::map<std::string, std::string>& global_params
+      [[maybe_unused]],
+      bool& is_acceptor,
+      std::shared_ptr<persistent_cache> cache
+      [[maybe_unused]]) const override {
+    is_acceptor = false;
+    return new null_connector;
+  }
+};
+
+constexpr std::string_view lua_script =
+    "local out\n"
+    "function init(conf)\n"
+    "  out = io.open(conf.path, 'w')\n"
+    "end\n"
+    "function write(d)\n"
+    "  out:write(broker.json_encode(d), '\\n')\n"
+    "  return true\n"
+    "end\n";
+
+void usage() {
+  fmt::print(
+      "usage: broker-bench [-n events] [-o null|file|unified_sql] [-z] "
+      "[-r rate] [-s sampling] [-R queue file] [-H hosts] [-S services] "
+      "[-m metrics] [-l logs] [-p port] [-w work dir] [-M module dir] "
+      "[--db-host host] [--db-port port] [--db-user user] "
+      "[--db-password password] [--db-name name]\n");
+}
+
+template <typename T>
+T read_number(const char* name, const char* value) {
+  T retval;
+  if (!absl::SimpleAtoi(value, &retval))
+    throw msg_fmt("the option {} expects a positive integer, not '{}'", name,
+                  value);
+  return retval;
+}
+
+options parse_options(int argc, char* argv[]) {
+  enum { db_host = 256, db_port, db_user, db_password, db_name };
+  static const struct option long_options[] = {
+      {"events", required_argument, 0, 'n'},
+      {"output", required_argument, 0, 'o'},
+      {"compression", no_argument, 0, 'z'},
+      {"rate", required_argument, 0, 'r'},
+      {"sampling", required_argument, 0, 's'},
+      {"replay", required_argument, 0, 'R'},
+      {"hosts", required_argument, 0, 'H'},
+      {"services", required_argument, 0, 'S'},
+      {"metrics", required_argument, 0, 'm'},
+      {"logs", required_argument, 0, 'l'},
+      {"port", required_argument, 0, 'p'},
+      {"work-dir", required_argument, 0, 'w'},
+      {"module-dir", required_argument, 0, 'M'},
+      {"db-host", required_argument, 0, db_host},
+      {"db-port", required_argument, 0, db_port},
+      {"db-user", required_argument, 0, db_user},
+      {"db-password", required_argument, 0, db_password},
+      {"db-name", required_argument, 0, db_name},
+      {"help", no_argument, 0, 'h'},
+      {0, 0, 0, 0}};
+
+  options retval;
+  int opt, option_index = 0;
+  while ((opt = getopt_long(argc, argv, "n:o:zr:s:R:H:S:m:l:p:w:M:h",
+                            long_options, &option_index)) != -1) {
+    switch (opt) {
+      case 'n':
+        retval.events = read_number<uint64_t>("-n", optarg);
+        break;
+      case 'o':
+        retval.output = optarg;
+        if (retval.output != "null" && retval.output != "file" &&
+            retval.output != "unified_sql")
+          throw msg_fmt("the output must be null, file or unified_sql");
+        break;
+      case 'z':
+        retval.compression = true;
+        break;
+      case 'r':
+        retval.rate = read_number<uint32_t>("-r", optarg);
+        break;
+      case 's':
+        retval.sampling = read_number<uint32_t>("-s", optarg);
+        if (retval.sampling == 0)
+          throw msg_fmt("the sampling cannot be 0");
+        break;
+      case 'R':
+        retval.replay = optarg;
+        break;
+      case 'H':
+        retval.hosts = std::max(1u, read_number<uint32_t>("-H", optarg));
+        break;
+      case 'S':
+        retval.services = std::max(1u, read_number<uint32_t>("-S", optarg));
+        break;
+      case 'm':
+        retval.metrics = read_number<uint32_t>("-m", optarg);
+        break;
+      case 'l':
+        retval.logs = read_number<uint32_t>("-l", optarg);
+        break;
+      case 'p': {
+        uint32_t port = read_number<uint32_t>("-p", optarg);
+        if (port == 0 || port > 65535)
+          throw msg_fmt("the port must be between 1 and 65535");
+        retval.port = port;
+      } break;
+      case 'w':
+        retval.work_dir = optarg;
+        break;
+      case 'M':
+        retval.module_dir = optarg;
+        break;
+      case db_host:
+        retval.db_host = optarg;
+        break;
+      case db_port:
+        retval.db_port = optarg;
+        break;
+      case db_user:
+        retval.db_user = optarg;
+        break;
+      case db_password:
+        retval.db_password = optarg;
+        break;
+      case db_name:
+        retval.db_name = optarg;
+        break;
+      default:
+        usage();
+        exit(opt == 'h' ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+  }
+  return retval;
+}
+
+/**
+ * @brief The configuration of the broker under test: a bbdo_server input and
+ * the output to measure.
+ */
+config::state make_config(const options& opts) {
+  config::state retval;
+  retval.broker_id(1);
+  retval.broker_name("broker-bench");
+  retval.poller_id(1);
+  retval.poller_name("broker-bench");
+  retval.module_directory(opts.module_dir);
+  retval.cache_directory(opts.work_dir);
+  retval.event_trace_sampling(opts.sampling);
+  auto& log_conf = retval.mut_log_conf();
+  log_conf.set_dirname(opts.work_dir);
+  log_conf.set_filename("broker-bench.log");
+
+  config::endpoint input(config::endpoint::input);
+  input.name = "bench-input";
+  input.type = "bbdo_server";
+  input.params["transport_protocol"] = "tcp";
+  input.params["port"] = std::to_string(opts.port);
+  input.params["compression"] = opts.compression ? "yes" : "no";
+  input.read_filters.insert("all");
+  retval.add_module("50-tcp.so");
+  retval.add_endpoint(std::move(input));
+
+  config::endpoint output(config::endpoint::output);
+  output.name = "bench-output";
+  output.write_filters.insert("all");
+  if (opts.output == "null")
+    output.type = "bench_null";
+  else if (opts.output == "file") {
+    std::string script = fmt::format("{}/bench-output.lua", opts.work_dir);
+    std::ofstream(script) << lua_script;
+    output.type = "lua";
+    output.params["path"] = script;
+    output.cfg["lua_parameter"] = nlohmann::json::array(
+        {{{"name", "path"},
+          {"type", "string"},
+          {"value", fmt::format("{}/bench-output.json", opts.work_dir)}}});
+    retval.add_module("70-lua.so");
+  } else {
+    output.type = "unified_sql";
+    output.params["db_type"] = "mysql";
+    output.params["db_host"] = opts.db_host;
+    output.params["db_port"] = opts.db_port;
+    output.params["db_user"] = opts.db_user;
+    output.params["db_password"] = opts.db_password;
+    output.params["db_name"] = opts.db_name;
+    /* Traces are committed with the transactions, the last one should not be
+     * waited for too long. */
+    output.read_timeout = 1;
+    retval.add_module("20-unified_sql.so");
+  }
+  retval.add_endpoint(std::move(output));
+  return retval;
+}
+
+/**
+ * @brief Load the events of a recorded queue file. The files of the queue are
+ * copied in the work directory since they are removed once read.
+ */
+std::vector<std::shared_ptr<io::data>> load_replay(const options& opts) {
+  namespace fs = std::filesystem;
+  fs::path src(opts.replay);
+  fs::path dst = fs::path(opts.work_dir) / "replay";
+  fs::remove_all(dst);
+  fs::create_directories(dst);
+  std::string prefix = src.filename().string();
+  for (auto& entry : fs::directory_iterator(src.parent_path().empty()
+                                                ? fs::path(".")
+                                                : src.parent_path())) {
+    std::string name = entry.path().filename().string();
+    if (name.compare(0, prefix.size(), prefix) == 0 &&
+        name.find_first_not_of("0123456789", prefix.size()) ==
+            std::string::npos)
+      fs::copy_file(entry.path(), dst / name);
+  }
+
+  std::vector<std::shared_ptr<io::data>> retval;
+  persistent_file file((dst / prefix).string());
+  try {
+    std::shared_ptr<io::data> d;
+    while (retval.size() < opts.events) {
+      if (file.read(d) && d)
+        retval.push_back(std::move(d));
+    }
+  } catch (const exceptions::shutdown&) {
+  }
+  if (retval.empty())
+    throw msg_fmt("no event found in the queue file '{}'", opts.replay);
+  return retval;
+}
+
+/**
+ * @brief Synthetic events: service statuses of all the services one after the
+ * other, with a perfdata of opts.metrics metrics, and a log entry every
+ * opts.logs statuses.
+ */
+class generator {
+  const options& _opts;
+  uint64_t _count = 0;
+  uint64_t _statuses = 0;
+
+ public:
+  generator(const options& opts) : _opts(opts) {}
+
+  std::shared_ptr<io::data> next() {
+    uint64_t host_id = _statuses / _opts.services % _opts.hosts + 1;
+    uint64_t service_id = _statuses % _opts.services + 1;
+    time_t now = time(nullptr);
+    ++_count;
+    if (_opts.logs && _count % (_opts.logs + 1) == 0) {
+      auto le = std::make_shared<neb::pb_log_entry>();
+      auto& obj = le->mut_obj();
+      obj.set_ctime(now);
+      obj.set_instance_name("broker-bench");
+      obj.set_host_id(host_id);
+      obj.set_service_id(service_id);
+      obj.set_host_name(fmt::format("host_{}", host_id));
+      obj.set_service_description(fmt::format("service_{}", service_id));
+      obj.set_output("SERVICE ALERT: the service is critical");
+      obj.set_msg_type(LogEntry_MsgType_SERVICE_ALERT);
+      obj.set_type(LogEntry_LogType_HARD);
+      obj.set_status(2);
+      obj.set_retry(1);
+      return le;
+    }
+    ++_statuses;
+    auto ss = std::make_shared<neb::pb_service_status>();
+    auto& obj = ss->mut_obj();
+    obj.set_host_id(host_id);
+    obj.set_service_id(service_id);
+    obj.set_checked(true);
+    obj.set_state(ServiceStatus_State_OK);
+    obj.set_state_type(ServiceStatus_StateType_HARD);
+    obj.set_last_check(now);
+    obj.set_next_check(now + 300);
+    obj.set_last_time_ok(now);
+    obj.set_check_attempt(1);
+    obj.set_output(fmt::format("OK - service_{} is fine", service_id));
+    std::string perfdata;
+    for (uint32_t i = 0; i < _opts.metrics; ++i)
+      fmt::format_to(std::back_inserter(perfdata),
+                     "{}metric_{}={}ms;80;90;0;100", i ? " " : "", i,
+                     _count % 100);
+    obj.set_perfdata(std::move(perfdata));
+    return ss;
+  }
+};
+
+/**
+ * @brief Percentile of a latency histogram, interpolated in its bucket.
+ *
+ * @return A duration in milliseconds.
+ */
+double percentile(const LatencyHistogram& h,
+                  const google::protobuf::RepeatedField<double>& bounds,
+                  double q) {
+  if (h.count() == 0)
+    return 0;
+  double rank = q * h.count();
+  uint64_t seen = 0;
+  for (int i = 0; i < h.buckets_size(); ++i) {
+    uint64_t n = h.buckets(i);
+    if (n && seen + n >= rank) {
+      if (i >= bounds.size())
+        return h.max();
+      double low = i ? bounds[i - 1] : 0.0;
+      double high = std::min(bounds[i], h.max());
+      return low + (high - low) * (rank - seen) / n;
+    }
+    seen += n;
+  }
+  return h.max();
+}
+
+/**
+ * @brief Resident memory of this process from /proc/self/status.
+ *
+ * @return The field in kB.
+ */
+uint64_t memory_kb(std::string_view field) {
+  std::ifstream f("/proc/self/status");
+  std::string line;
+  uint64_t retval = 0;
+  while (std::getline(f, line)) {
+    if (line.compare(0, field.size(), field) == 0) {
+      std::string_view value(line);
+      value.remove_prefix(field.size() + 1);
+      while (!value.empty() && isspace(value.front()))
+        value.remove_prefix(1);
+      value = value.substr(0, value.find(' '));
+      absl::SimpleAtoi(value, &retval);
+      break;
+    }
+  }
+  return retval;
+}
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start)
+      .count();
+}
+
+int run(const options& opts) {
+  std::filesystem::create_directories(opts.work_dir);
+  config::state conf = make_config(opts);
+  log_v2::instance().apply(conf.log_conf());
+  config::applier::init(com::centreon::common::BROKER, conf);
+  io::protocols::instance().reg("bench_null", std::make_shared<null_factory>(),
+                                1, 7);
+  config::applier::state::instance().apply(conf);
+
+  std::vector<std::shared_ptr<io::data>> recorded;
+  if (!opts.replay.empty())
+    recorded = load_replay(opts);
+  generator gen(opts);
+
+  std::list<std::shared_ptr<io::extension>> extensions;
+  if (opts.compression)
+    extensions.push_back(
+        std::make_shared<io::extension>("COMPRESSION", false, true));
+  auto client = std::make_shared<bbdo::stream>(false, false, extensions);
+  client->set_substream(std::make_shared<client_stream>(opts.port));
+  client->negotiate(bbdo::stream::negotiate_first);
+
+  std::string histogram = fmt::format(
+      "total_to_{}", opts.output == "file" ? "lua" : opts.output);
+  uint64_t traced = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (uint64_t i = 0; i < opts.events; ++i) {
+    std::shared_ptr<io::data> d;
+    if (recorded.empty())
+      d = gen.next();
+    else
+      d = recorded[i % recorded.size()];
+    /* The last event is always traced to know when the run is over. */
+    d->trace = io::trace::sample();
+    if (!d->trace && i + 1 == opts.events)
+      d->trace = std::make_shared<io::trace>();
+    if (d->trace) {
+      d->trace->add_stamp(io::trace::callback);
+      ++traced;
+    }
+    client->write(d);
+    d->trace.reset();
+
+    if ((i & 1023) == 1023) {
+      /* Acknowledgements sent by the broker are read from time to time. */
+      std::shared_ptr<io::data> ack;
+      client->read(ack, time(nullptr));
+    }
+    if (opts.rate && (i & 127) == 127) {
+      auto due = start + std::chrono::microseconds((i + 1) * 1000000 /
+                                                   opts.rate);
+      if (due > std::chrono::steady_clock::now()) {
+        client->flush();
+        std::this_thread::sleep_until(due);
+      }
+    }
+  }
+  client->stop();
+  double sent = seconds_since(start);
+
+  auto center = config::applier::state::instance().center();
+  EventLatencyStats stats;
+  bool done = false;
+  for (int i = 0; i < 6000 && !done; ++i) {
+    stats.Clear();
+    center->get_event_latency_stats(&stats);
+    auto found = stats.stages().find(histogram);
+    done = found != stats.stages().end() && found->second.count() >= traced;
+    if (!done)
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  double processed = seconds_since(start);
+
+  fmt::print("output: {}, compression: {}, events: {}{}\n", opts.output,
+             opts.compression ? "yes" : "no", opts.events,
+             opts.replay.empty() ? "" : fmt::format(" from {}", opts.replay));
+  fmt::print("sent in {:.3f}s: {:.0f} events/s\n", sent, opts.events / sent);
+  if (done)
+    fmt::print("processed in {:.3f}s: {:.0f} events/s\n", processed,
+               opts.events / processed);
+  else
+    fmt::print("not all the events processed after {:.3f}s\n", processed);
+  fmt::print("latencies of 1 event over {} (ms):\n", opts.sampling);
+  for (auto& [name, h] : stats.stages())
+    fmt::print("  {:<28} p50 {:>9.3f}  p99 {:>9.3f}  max {:>9.3f}\n", name,
+               percentile(h, stats.bounds(), 0.5),
+               percentile(h, stats.bounds(), 0.99), h.max());
+  fmt::print("rss: {} kB, peak rss: {} kB\n", memory_kb("VmRSS"),
+             memory_kb("VmHWM"));
+
+  config::applier::deinit();
+  return done ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  int retval;
+  log_v2::load("broker-bench");
+  com::centreon::common::pool::load(g_io_context,
+                                    log_v2::instance().get(log_v2::CORE));
+  try {
+    retval = run(parse_options(argc, argv));
+  } catch (const std::exception& e) {
+    fmt::print(stderr, "broker-bench: {}\n", e.what());
+    retval = EXIT_FAILURE;
+  }
+  g_io_context->stop();
+  log_v2::unload();
+  return retval;
+}
@@ -40,12 +40,14 @@ class acceptor : public io::endpoint {
   std::string _cert;
   std::string _key;
   std::string _tls_hostname;
+  bool _ktls;
 
  public:
   acceptor(std::string cert = std::string(),
            std::string key = std::string(),
            std::string ca = std::string(),
-           std::string tls_hostname = std::string());
+           std::string tls_hostname = std::string(),
+           bool ktls = false);
   ~acceptor() noexcept = default;
   acceptor(const acceptor&) = delete;
   acceptor& operator=(const acceptor&) = delete;
@@ -35,12 +35,14 @@ class connector : public io::endpoint {
   std::string _cert;
   std::string _key;
   std::string _tls_hostname;
+  bool _ktls;
 
  public:
   connector(std::string cert = std::string(),
             std::string key = std::string(),
             std::string ca = std::string(),
-            std::string tls_hostname = std::string());
+            std::string tls_hostname = std::string(),
+            bool ktls = false);
   ~connector() = default;
   connector(const connector&) = delete;
   connector& operator=(const connector&) = delete;
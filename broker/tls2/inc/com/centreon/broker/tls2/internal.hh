@@ -21,6 +21,7 @@
 
 #include <openssl/ssl.h>
 #include <sys/types.h>
+#include <string>
 
 namespace com::centreon::broker {
 
@@ -31,6 +32,10 @@ extern SSL_CTX* ctx;
 // Code.
 void destroy();
 void initialize();
+
+// Client sessions, kept to resume the connections.
+SSL_SESSION* get1_session(const std::string& key);
+void set_session_key(SSL* ssl, const std::string& key);
 }  // namespace tls2
 
 }
@@ -0,0 +1,34 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCB_TLS2_KTLS_HH
+#define CCB_TLS2_KTLS_HH
+
+#include <openssl/ssl.h>
+#include <vector>
+
+namespace com::centreon::broker::tls2 {
+/* The cipher list to use when kTLS is wanted, the kernel only supporting
+ * AES-GCM here. */
+constexpr const char* ktls_cipher_list = "ECDHE+AESGCM";
+constexpr const char* ktls_anonymous_cipher_list = "aNULL+AESGCM";
+
+bool ktls_tx_crypto_info(SSL* ssl, std::vector<char>& crypto_info);
+}  // namespace com::centreon::broker::tls2
+
+#endif  // !CCB_TLS2_KTLS_HH
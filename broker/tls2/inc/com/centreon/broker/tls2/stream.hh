@@ -36,11 +36,17 @@ namespace tls2 {
  *  The TLS stream class wraps a lower layer stream and provides
  *  encryption (and optionnally compression) over this stream. Those
  *  functionnality are provided using the OpenSSL library.
+ *
+ *  With kTLS, once the handshake is done, the encryption of the data we send
+ *  is given to the kernel: the data are then written as is to the substream.
+ *  The data received are still decrypted by OpenSSL.
  */
 class stream : public io::stream {
   enum ssl_action { ssl_handshake, ssl_write, ssl_read };
   bool _server;
   bool _handshake_done;
+  const bool _ktls;
+  bool _ktls_tx;
   time_t _deadline;
   SSL* _ssl;
   BIO* _bio;
@@ -49,12 +55,14 @@ class stream : public io::stream {
   misc::buffer _rbuf;
   misc::buffer _wbuf;
 
+  bool _send_pending();
   void _do_stream();
   bool _do_read(int timeout);
   void _manage_stream_error(int r, ssl_action action);
+  void _enable_ktls();
 
  public:
-  stream(SSL* ssl, BIO* bio, BIO* bio_io, bool server);
+  stream(SSL* ssl, BIO* bio, BIO* bio_io, bool server, bool ktls = false);
   ~stream();
   stream(const stream&) = delete;
   stream& operator=(const stream&) = delete;
@@ -22,6 +22,7 @@
 
 #include "com/centreon/broker/log_v2.hh"
 #include "com/centreon/broker/tls2/internal.hh"
+#include "com/centreon/broker/tls2/ktls.hh"
 #include "com/centreon/broker/tls2/stream.hh"
 #include "com/centreon/exceptions/msg_fmt.hh"
 
@@ -35,16 +36,19 @@ using namespace com::centreon::broker::tls2;
  *  @param[in] cert Certificate.
  *  @param[in] key  Key file.
  *  @param[in] ca   Trusted CA's certificate.
+ *  @param[in] ktls True to give the encryption to the kernel.
  */
 acceptor::acceptor(std::string cert,
                    std::string key,
                    std::string ca,
-                   std::string tls_hostname)
+                   std::string tls_hostname,
+                   bool ktls)
     : io::endpoint(true),
       _ca(std::move(ca)),
       _cert(std::move(cert)),
       _key(std::move(key)),
-      _tls_hostname(std::move(tls_hostname)) {}
+      _tls_hostname(std::move(tls_hostname)),
+      _ktls(ktls) {}
 
 /**
  *  @brief Try to accept a new connection.
@@ -153,14 +157,29 @@ std::shared_ptr<io::stream> acceptor::open(std::shared_ptr<io::stream> lower) {
         if (!SSL_set_cipher_list(s_ssl, "HIGH"))
           throw msg_fmt("Error: cannot set the cipher list to HIGH");
 
+        if (_ktls && !SSL_set_cipher_list(s_ssl, ktls_cipher_list))
+          throw msg_fmt("Error: cannot set the cipher list to {}",
+                        ktls_cipher_list);
+
         /* Force TLS hostname */
       } else {
         log_v2::tls()->info("TLS: using anonymous server credentials");
         SSL_set_security_level(s_ssl, 0);
         if (!SSL_set_cipher_list(s_ssl, "aNULL"))
           throw msg_fmt("Error: cannot set the cipher list to HIGH");
+        if (_ktls && (!SSL_set_cipher_list(s_ssl, ktls_anonymous_cipher_list) ||
+                      !SSL_set_dh_auto(s_ssl, 1)))
+          throw msg_fmt("Error: cannot set the cipher list to {}",
+                        ktls_anonymous_cipher_list);
       }
 
+      /* The kernel can only take the keys of a TLS 1.2 connection. */
+      if (_ktls && !SSL_set_max_proto_version(s_ssl, TLS1_2_VERSION))
+        throw msg_fmt("Error: cannot limit the TLS version to 1.2 for kTLS");
+      /* A renegotiation would change the keys given to the kernel. */
+      if (_ktls)
+        SSL_set_options(s_ssl, SSL_OP_NO_RENEGOTIATION);
+
       BIO *s_bio = nullptr, *server = nullptr, *s_bio_io = nullptr;
 
       // size_t bufsiz = 2048; /* small buffer for testing */
@@ -177,7 +196,7 @@ std::shared_ptr<io::stream> acceptor::open(std::shared_ptr<io::stream> lower) {
       BIO_set_ssl(s_bio, s_ssl, BIO_NOCLOSE);
 
       // Create stream object.
-      u = std::make_unique<stream>(s_ssl, s_bio, s_bio_io, true);
+      u = std::make_unique<stream>(s_ssl, s_bio, s_bio_io, true, _ktls);
     } catch (...) {
       // FIXME DBR: memory leak
       throw;
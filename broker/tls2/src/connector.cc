@@ -21,6 +21,7 @@
 #include <openssl/x509v3.h>
 #include "com/centreon/broker/log_v2.hh"
 #include "com/centreon/broker/tls2/internal.hh"
+#include "com/centreon/broker/tls2/ktls.hh"
 #include "com/centreon/broker/tls2/stream.hh"
 #include "com/centreon/exceptions/msg_fmt.hh"
 
@@ -34,16 +35,19 @@ using namespace com::centreon::exceptions;
  *  @param[in] cert Certificate.
  *  @param[in] key  Key file.
  *  @param[in] ca   Trusted CA's certificate.
+ *  @param[in] ktls True to give the encryption to the kernel.
  */
 connector::connector(std::string cert,
                      std::string key,
                      std::string ca,
-                     std::string tls_hostname)
+                     std::string tls_hostname,
+                     bool ktls)
     : io::endpoint(false),
       _ca(std::move(ca)),
       _cert(std::move(cert)),
       _key(std::move(key)),
-      _tls_hostname(std::move(tls_hostname)) {}
+      _tls_hostname(std::move(tls_hostname)),
+      _ktls(ktls) {}
 
 /**
  *  Connect to the remote TLS peer.
@@ -159,6 +163,18 @@ std::shared_ptr<io::stream> connector::open(std::shared_ptr<io::stream> lower) {
       if (c_ssl == nullptr)
         throw msg_fmt("Unable to allocate connector ssl object");
 
+      /* The last session given by this peer is used to avoid a full
+       * handshake on reconnection. */
+      std::string session_key{
+          fmt::format("{} {} {}", lower->peer(), _tls_hostname, _cert)};
+      if (SSL_SESSION* session = get1_session(session_key)) {
+        log_v2::tls()->debug("TLS: trying to resume the session with '{}'",
+                             lower->peer());
+        SSL_set_session(c_ssl, session);
+        SSL_SESSION_free(session);
+      }
+      set_session_key(c_ssl, session_key);
+
       // SSL_set_info_callback(c_ssl, info_callback);
 
       if (!_cert.empty() && !_key.empty()) {
@@ -195,6 +211,10 @@ std::shared_ptr<io::stream> connector::open(std::shared_ptr<io::stream> lower) {
             !SSL_set_cipher_list(c_ssl, "HIGH"))
           throw msg_fmt("Error: cannot set the cipher list to HIGH");
 
+        if (_ktls && !SSL_set_cipher_list(c_ssl, ktls_cipher_list))
+          throw msg_fmt("Error: cannot set the cipher list to {}",
+                        ktls_cipher_list);
+
         /* Load CA certificate */
         if (!_ca.empty()) {
           if (SSL_CTX_load_verify_locations(tls2::ctx, _ca.c_str(), nullptr) !=
@@ -223,8 +243,18 @@ std::shared_ptr<io::stream> connector::open(std::shared_ptr<io::stream> lower) {
         SSL_set_security_level(c_ssl, 0);
         if (!SSL_set_cipher_list(c_ssl, "aNULL"))
           throw msg_fmt("Error: cannot set the cipher list to HIGH");
+        if (_ktls && !SSL_set_cipher_list(c_ssl, ktls_anonymous_cipher_list))
+          throw msg_fmt("Error: cannot set the cipher list to {}",
+                        ktls_anonymous_cipher_list);
       }
 
+      /* The kernel can only take the keys of a TLS 1.2 connection. */
+      if (_ktls && !SSL_set_max_proto_version(c_ssl, TLS1_2_VERSION))
+        throw msg_fmt("Error: cannot limit the TLS version to 1.2 for kTLS");
+      /* A renegotiation would change the keys given to the kernel. */
+      if (_ktls)
+        SSL_set_options(c_ssl, SSL_OP_NO_RENEGOTIATION);
+
       BIO *c_bio = nullptr, *client = nullptr, *c_bio_io = nullptr;
 
       // size_t bufsiz = 2048; /* small buffer for testing */
@@ -241,7 +271,7 @@ std::shared_ptr<io::stream> connector::open(std::shared_ptr<io::stream> lower) {
       (void)BIO_set_ssl(c_bio, c_ssl, BIO_NOCLOSE);
 
       // Create stream object.
-      u = std::make_unique<stream>(c_ssl, c_bio, c_bio_io, false);
+      u = std::make_unique<stream>(c_ssl, c_bio, c_bio_io, false, _ktls);
     } catch (...) {
       // delete c_ssl;
       throw;
@@ -73,6 +73,11 @@ bool factory::has_endpoint(config::endpoint& cfg, io::extension* ext) {
       it = cfg.params.find("tls_hostname");
       if (it != cfg.params.end())
         ext->mutable_options()["tls_hostname"] = it->second;
+
+      // Kernel TLS.
+      it = cfg.params.find("tls_ktls");
+      if (it != cfg.params.end())
+        ext->mutable_options()["ktls"] = it->second;
     }
   }
   return false;
@@ -99,6 +104,7 @@ io::endpoint* factory::new_endpoint(
   std::string public_cert;
   std::string ca_cert;
   std::string tls_hostname;
+  bool ktls = false;
   {
     // Is TLS enabled ?
     std::map<std::string, std::string>::const_iterator it{
@@ -125,6 +131,11 @@ io::endpoint* factory::new_endpoint(
         it = cfg.params.find("tls_hostname");
         if (it != cfg.params.end())
           tls_hostname = it->second;
+
+        // Kernel TLS.
+        it = cfg.params.find("tls_ktls");
+        if (it != cfg.params.end())
+          ktls = config::parser::parse_boolean(it->second);
       }
     }
   }
@@ -132,10 +143,12 @@ io::endpoint* factory::new_endpoint(
   // Acceptor.
   std::unique_ptr<io::endpoint> endp;
   if (is_acceptor)
-    endp.reset(new acceptor(public_cert, private_key, ca_cert, tls_hostname));
+    endp.reset(
+        new acceptor(public_cert, private_key, ca_cert, tls_hostname, ktls));
   // Connector.
   else
-    endp.reset(new connector(public_cert, private_key, ca_cert, tls_hostname));
+    endp.reset(
+        new connector(public_cert, private_key, ca_cert, tls_hostname, ktls));
   return endp.release();
 }
 
@@ -173,9 +186,14 @@ std::shared_ptr<io::stream> factory::new_stream(
   if (found != options.end())
     tls_hostname = found->second;
 
+  bool ktls = false;
+  found = options.find("ktls");
+  if (found != options.end())
+    ktls = config::parser::parse_boolean(found->second);
+
   return is_acceptor
-             ? acceptor(public_cert, private_key, ca_cert, tls_hostname)
+             ? acceptor(public_cert, private_key, ca_cert, tls_hostname, ktls)
                    .open(to)
-             : connector(public_cert, private_key, ca_cert, tls_hostname)
+             : connector(public_cert, private_key, ca_cert, tls_hostname, ktls)
                    .open(to);
 }
@@ -18,6 +18,8 @@
 
 #include "com/centreon/broker/tls2/internal.hh"
 #include <openssl/x509v3.h>
+#include <mutex>
+#include <unordered_map>
 #include "com/centreon/exceptions/msg_fmt.hh"
 
 using namespace com::centreon::broker;
@@ -25,6 +27,46 @@ using namespace com::centreon::exceptions;
 
 SSL_CTX* tls2::ctx = nullptr;
 
+namespace {
+/* The last resumable session received from each peer, the key being built by
+ * the connector. */
+std::mutex sessions_m;
+std::unordered_map<std::string, SSL_SESSION*> sessions;
+/* Index of the session key in the SSL objects of the connectors. */
+int session_key_index = -1;
+
+void free_session_key(void* parent [[maybe_unused]],
+                      void* ptr,
+                      CRYPTO_EX_DATA* ad [[maybe_unused]],
+                      int idx [[maybe_unused]],
+                      long argl [[maybe_unused]],
+                      void* argp [[maybe_unused]]) {
+  delete static_cast<std::string*>(ptr);
+}
+
+/**
+ * @brief Called by OpenSSL when a client receives a new session (during the
+ * handshake with TLS 1.2, with the session tickets after it with TLS 1.3).
+ *
+ * @param ssl The connection.
+ * @param session The new session.
+ *
+ * @return 1 if we keep the session, 0 otherwise.
+ */
+int new_session(SSL* ssl, SSL_SESSION* session) {
+  auto* key =
+      static_cast<std::string*>(SSL_get_ex_data(ssl, session_key_index));
+  if (!key || !SSL_SESSION_is_resumable(session))
+    return 0;
+  std::lock_guard<std::mutex> lck(sessions_m);
+  SSL_SESSION*& s = sessions[*key];
+  if (s)
+    SSL_SESSION_free(s);
+  s = session;
+  return 1;
+}
+}  // namespace
+
 /**
  *  @brief TLS initialization function.
  *
@@ -46,11 +88,52 @@ void tls2::initialize() {
    * are present. Borrowed from the python ssl code. */
   X509_VERIFY_PARAM_set_flags(params, X509_V_FLAG_TRUSTED_FIRST);
   X509_VERIFY_PARAM_set_hostflags(params, X509_CHECK_FLAG_NO_PARTIAL_WILDCARDS);
+
+  /* Clients keep their sessions to resume them, servers give session tickets
+   * so they do not need to keep them. */
+  session_key_index =
+      SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, free_session_key);
+  SSL_CTX_set_session_cache_mode(
+      ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+  SSL_CTX_sess_set_new_cb(ctx, new_session);
+}
+
+/**
+ * @brief Get the last session received with the given key.
+ *
+ * @param key The key given by the connector.
+ *
+ * @return The session with a new reference or nullptr.
+ */
+SSL_SESSION* tls2::get1_session(const std::string& key) {
+  std::lock_guard<std::mutex> lck(sessions_m);
+  auto found = sessions.find(key);
+  if (found == sessions.end())
+    return nullptr;
+  SSL_SESSION_up_ref(found->second);
+  return found->second;
+}
+
+/**
+ * @brief Set the key under which the sessions received by a connection are
+ * kept.
+ *
+ * @param ssl The connection.
+ * @param key The key.
+ */
+void tls2::set_session_key(SSL* ssl, const std::string& key) {
+  SSL_set_ex_data(ssl, session_key_index, new std::string(key));
 }
 
 /**
  *  Deinit the TLS library.
  */
 void tls2::destroy() {
+  {
+    std::lock_guard<std::mutex> lck(sessions_m);
+    for (auto& p : sessions)
+      SSL_SESSION_free(p.second);
+    sessions.clear();
+  }
   SSL_CTX_free(ctx);
 }
@@ -0,0 +1,138 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/broker/tls2/ktls.hh"
+
+#include <linux/tls.h>
+#include <openssl/evp.h>
+#include <openssl/kdf.h>
+#include <cstring>
+#include <memory>
+
+using namespace com::centreon::broker;
+
+namespace {
+/**
+ * @brief Fill a kernel crypto info structure for AES-GCM.
+ *
+ * @tparam T tls12_crypto_info_aes_gcm_128 or tls12_crypto_info_aes_gcm_256.
+ * @param cipher_type TLS_CIPHER_AES_GCM_128 or TLS_CIPHER_AES_GCM_256.
+ * @param key The write key.
+ * @param salt The implicit part of the nonce (the write IV).
+ * @param crypto_info The structure as a buffer.
+ */
+template <typename T>
+void fill(uint16_t cipher_type,
+          const unsigned char* key,
+          const unsigned char* salt,
+          std::vector<char>& crypto_info) {
+  T info;
+  memset(&info, 0, sizeof(info));
+  info.info.version = TLS_1_2_VERSION;
+  info.info.cipher_type = cipher_type;
+  memcpy(info.key, key, sizeof(info.key));
+  memcpy(info.salt, salt, sizeof(info.salt));
+  /* The Finished message is the only record sent with these keys during the
+   * handshake, so the next record has the sequence number 1. It is also used
+   * as explicit nonce. */
+  info.rec_seq[sizeof(info.rec_seq) - 1] = 1;
+  memcpy(info.iv, info.rec_seq, sizeof(info.iv));
+  crypto_info.assign(reinterpret_cast<const char*>(&info),
+                     reinterpret_cast<const char*>(&info) + sizeof(info));
+}
+}  // namespace
+
+/**
+ * @brief Compute the kernel structure needed to encrypt the records we send on
+ * a TLS connection whose handshake is done.
+ *
+ * Only TLS 1.2 with AES-GCM is supported: the keys are derived from the master
+ * secret as OpenSSL does (RFC 5246 6.3), and no record is sent by OpenSSL
+ * after the handshake without us knowing. With TLS 1.3, session tickets and
+ * key updates are sent by OpenSSL after the handshake.
+ *
+ * @param ssl The TLS connection.
+ * @param crypto_info The structure to give to setsockopt(TLS_TX).
+ *
+ * @return false if the connection cannot be offloaded.
+ */
+bool tls2::ktls_tx_crypto_info(SSL* ssl, std::vector<char>& crypto_info) {
+  if (SSL_version(ssl) != TLS1_2_VERSION)
+    return false;
+
+  const SSL_CIPHER* cipher = SSL_get_current_cipher(ssl);
+  if (!cipher)
+    return false;
+  size_t key_len;
+  switch (SSL_CIPHER_get_cipher_nid(cipher)) {
+    case NID_aes_128_gcm:
+      key_len = TLS_CIPHER_AES_GCM_128_KEY_SIZE;
+      break;
+    case NID_aes_256_gcm:
+      key_len = TLS_CIPHER_AES_GCM_256_KEY_SIZE;
+      break;
+    default:
+      return false;
+  }
+  constexpr size_t salt_len = TLS_CIPHER_AES_GCM_128_SALT_SIZE;
+
+  unsigned char master[SSL_MAX_MASTER_KEY_LENGTH];
+  size_t master_len =
+      SSL_SESSION_get_master_key(SSL_get_session(ssl), master, sizeof(master));
+  unsigned char client_random[SSL3_RANDOM_SIZE];
+  unsigned char server_random[SSL3_RANDOM_SIZE];
+  SSL_get_client_random(ssl, client_random, sizeof(client_random));
+  SSL_get_server_random(ssl, server_random, sizeof(server_random));
+
+  /* key_block = client_write_key server_write_key client_write_IV
+   * server_write_IV, there is no MAC key with AEAD ciphers. */
+  unsigned char key_block[2 * (TLS_CIPHER_AES_GCM_256_KEY_SIZE + salt_len)];
+  size_t block_len = 2 * (key_len + salt_len);
+  std::unique_ptr<EVP_PKEY_CTX, decltype(&EVP_PKEY_CTX_free)> pctx(
+      EVP_PKEY_CTX_new_id(EVP_PKEY_TLS1_PRF, nullptr), EVP_PKEY_CTX_free);
+  static constexpr unsigned char label[] = "key expansion";
+  bool ok =
+      pctx && EVP_PKEY_derive_init(pctx.get()) > 0 &&
+      EVP_PKEY_CTX_set_tls1_prf_md(pctx.get(),
+                                   SSL_CIPHER_get_handshake_digest(cipher)) >
+          0 &&
+      EVP_PKEY_CTX_set1_tls1_prf_secret(pctx.get(), master, master_len) > 0 &&
+      EVP_PKEY_CTX_add1_tls1_prf_seed(pctx.get(), label, sizeof(label) - 1) >
+          0 &&
+      EVP_PKEY_CTX_add1_tls1_prf_seed(pctx.get(), server_random,
+                                      sizeof(server_random)) > 0 &&
+      EVP_PKEY_CTX_add1_tls1_prf_seed(pctx.get(), client_random,
+                                      sizeof(client_random)) > 0 &&
+      EVP_PKEY_derive(pctx.get(), key_block, &block_len) > 0;
+  OPENSSL_cleanse(master, sizeof(master));
+  if (!ok)
+    return false;
+
+  bool server = SSL_is_server(ssl);
+  const unsigned char* key = key_block + (server ? key_len : 0);
+  const unsigned char* salt =
+      key_block + 2 * key_len + (server ? salt_len : 0);
+  if (key_len == TLS_CIPHER_AES_GCM_128_KEY_SIZE)
+    fill<tls12_crypto_info_aes_gcm_128>(TLS_CIPHER_AES_GCM_128, key, salt,
+                                        crypto_info);
+  else
+    fill<tls12_crypto_info_aes_gcm_256>(TLS_CIPHER_AES_GCM_256, key, salt,
+                                        crypto_info);
+  OPENSSL_cleanse(key_block, sizeof(key_block));
+  return true;
+}
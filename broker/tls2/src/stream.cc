@@ -24,6 +24,7 @@
 #include "com/centreon/broker/io/raw.hh"
 #include "com/centreon/broker/log_v2.hh"
 #include "com/centreon/broker/misc/string.hh"
+#include "com/centreon/broker/tls2/ktls.hh"
 #include "com/centreon/exceptions/msg_fmt.hh"
 
 using namespace com::centreon::broker;
@@ -38,11 +39,15 @@ using namespace com::centreon::exceptions;
  *
  *  @param[in] sess  TLS session, providing informations on the
  *                   encryption that should be used.
+ *  @param[in] ktls  True to give the encryption to the kernel after the
+ *                   handshake, if possible.
  */
-stream::stream(SSL* ssl, BIO* bio, BIO* bio_io, bool server)
+stream::stream(SSL* ssl, BIO* bio, BIO* bio_io, bool server, bool ktls)
     : io::stream("TLS"),
       _server(server),
       _handshake_done{false},
+      _ktls{ktls},
+      _ktls_tx{false},
       _deadline((time_t)-1),
       _ssl(ssl),
       _bio(bio),
@@ -55,7 +60,11 @@ stream::stream(SSL* ssl, BIO* bio, BIO* bio_io, bool server)
  *  been released yet.
  */
 stream::~stream() {
-  SSL_shutdown(_ssl);
+  /* With kTLS, OpenSSL does not know the records sent by the kernel, a
+   * close_notify from it would break the stream: the connection is just
+   * closed. */
+  if (!_ktls_tx)
+    SSL_shutdown(_ssl);
   // SSL_free(_ssl);
   BIO_free(_bio);
   BIO_free(_bio_io);
@@ -69,8 +78,31 @@ void stream::handshake() {
   int r;
   while ((r = SSL_do_handshake(_ssl)) != 1)
     _manage_stream_error(r, ssl_handshake);
-  log_v2::tls()->warn("{} Handshake done", _server ? "SERVER" : "CLIENT");
+  /* The last records of the handshake may still be in the BIO (the server
+   * Finished), they must be sent before the kernel encrypts the stream. */
+  _send_pending();
+  log_v2::tls()->warn("{} Handshake done{}", _server ? "SERVER" : "CLIENT",
+                      SSL_session_reused(_ssl) ? " (session resumed)" : "");
   _handshake_done = true;
+  if (_ktls)
+    _enable_ktls();
+}
+
+/**
+ * @brief Give the encryption of the data we send to the kernel. On failure,
+ * the stream continues to encrypt them with OpenSSL.
+ */
+void stream::_enable_ktls() {
+  std::vector<char> crypto_info;
+  if (!ktls_tx_crypto_info(_ssl, crypto_info)) {
+    log_v2::tls()->info("TLS: kTLS is not supported with {} {}",
+                        SSL_get_version(_ssl), SSL_get_cipher_name(_ssl));
+    return;
+  }
+  _ktls_tx = _substream->set_ktls_tx(crypto_info);
+  OPENSSL_cleanse(crypto_info.data(), crypto_info.size());
+  if (!_ktls_tx)
+    log_v2::tls()->info("TLS: kTLS cannot be used on '{}'", peer());
 }
 
 /**
@@ -98,10 +130,25 @@ bool stream::_do_read(int timeout) {
   return no_timeout;
 }
 
-void stream::_do_stream() {
+/**
+ * @brief Send to the substream the records encrypted by OpenSSL.
+ *
+ * Once the kernel encrypts the data we send, OpenSSL must not emit any record
+ * (alert, renegotiation...) as the kernel would encrypt it again with its own
+ * sequence numbers. In this case, the connection is closed.
+ *
+ * @return true if something has been sent.
+ */
+bool stream::_send_pending() {
   int sz;
   bool something_done = false;
   while ((sz = BIO_ctrl_pending(_bio_io)) > 0) {
+    if (_ktls_tx) {
+      log_v2::tls()->error(
+          "TLS: {} bytes emitted by OpenSSL after kTLS offload on '{}'", sz,
+          peer());
+      throw msg_fmt("TLS: OpenSSL record after kTLS offload");
+    }
     something_done = true;
     log_v2::tls()->trace("{} bytes pending to be sent", sz);
     char* dataptr;
@@ -111,6 +158,12 @@ void stream::_do_stream() {
                                 dataptr + sz);
     _substream->write(packet);
   }
+  return something_done;
+}
+
+void stream::_do_stream() {
+  int sz;
+  bool something_done = _send_pending();
 
   while ((sz = BIO_ctrl_get_read_request(_bio_io)) > 0) {
     log_v2::tls()->trace("substream read {} bytes wanted", sz);
@@ -226,9 +279,19 @@ int stream::write(const std::shared_ptr<io::data>& d) {
   assert(d);
 
   io::raw* packet{static_cast<io::raw*>(d.get())};
+  if (_ktls_tx && _wbuf.empty()) {
+    _substream->write(d);
+    return 1;
+  }
+
   _wbuf.push(packet->get_buffer());
 
-  if (_handshake_done) {
+  if (_ktls_tx) {
+    /* Data pushed before the end of the handshake, the kernel encrypts them
+     * too. */
+    while (!_wbuf.empty())
+      _substream->write(std::make_shared<io::raw>(_wbuf.pop()));
+  } else if (_handshake_done) {
     while (!_wbuf.empty()) {
       auto v{_wbuf.front()};
       int r = SSL_write(_ssl, v.first, v.second);
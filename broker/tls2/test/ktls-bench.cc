@@ -0,0 +1,199 @@
+/**
+ * Copyright 2024 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+/**
+ * Throughput over loopback of plain TCP, TLS encrypted by OpenSSL and TLS
+ * encrypted by the kernel (kTLS), the keys being given to the kernel as the
+ * tls2 module does. The receiver always decrypts with OpenSSL.
+
+ ./ktls-bench [MiB to send]
+
+ kTLS needs the tls kernel module (modprobe tls).
+*/
+#include <arpa/inet.h>
+#include <fmt/format.h>
+#include <linux/tls.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "com/centreon/broker/tls2/ktls.hh"
+
+#ifndef TCP_ULP
+#define TCP_ULP 31
+#endif
+#ifndef SOL_TLS
+#define SOL_TLS 282
+#endif
+
+using namespace com::centreon::broker;
+
+enum mode { plain_tcp, user_tls, kernel_tls };
+
+static constexpr size_t chunk_size = 16384;
+
+/**
+ * @brief Create a TLS connection on a socket, both sides use the same
+ * settings as the tls2 module with kTLS and anonymous credentials.
+ */
+static SSL* new_ssl(SSL_CTX* ctx, int fd, bool server) {
+  SSL* ssl = SSL_new(ctx);
+  SSL_set_security_level(ssl, 0);
+  SSL_set_cipher_list(ssl, tls2::ktls_anonymous_cipher_list);
+  SSL_set_max_proto_version(ssl, TLS1_2_VERSION);
+#ifdef SSL_OP_IGNORE_UNEXPECTED_EOF
+  SSL_set_options(ssl, SSL_OP_IGNORE_UNEXPECTED_EOF);
+#endif
+  if (server)
+    SSL_set_dh_auto(ssl, 1);
+  SSL_set_fd(ssl, fd);
+  int r = server ? SSL_accept(ssl) : SSL_connect(ssl);
+  if (r != 1) {
+    ERR_print_errors_fp(stderr);
+    exit(1);
+  }
+  return ssl;
+}
+
+/**
+ * @brief Receive everything until the peer closes the connection.
+ *
+ * @return The number of bytes received.
+ */
+static size_t receive(SSL_CTX* ctx, int fd, mode m) {
+  std::vector<char> buf(chunk_size);
+  size_t retval = 0;
+  if (m == plain_tcp) {
+    ssize_t r;
+    while ((r = recv(fd, buf.data(), buf.size(), 0)) > 0)
+      retval += r;
+  } else {
+    SSL* ssl = new_ssl(ctx, fd, true);
+    int r;
+    while ((r = SSL_read(ssl, buf.data(), buf.size())) > 0)
+      retval += r;
+    SSL_free(ssl);
+  }
+  return retval;
+}
+
+/**
+ * @brief Send size bytes.
+ *
+ * @return false if kTLS cannot be enabled.
+ */
+static bool send_all(SSL_CTX* ctx, int fd, mode m, size_t size) {
+  std::vector<char> buf(chunk_size, 'a');
+  SSL* ssl = nullptr;
+  if (m != plain_tcp)
+    ssl = new_ssl(ctx, fd, false);
+  if (m == kernel_tls) {
+    std::vector<char> crypto_info;
+    if (!tls2::ktls_tx_crypto_info(ssl, crypto_info) ||
+        setsockopt(fd, SOL_TCP, TCP_ULP, "tls", sizeof("tls")) < 0 ||
+        setsockopt(fd, SOL_TLS, TLS_TX, crypto_info.data(),
+                   crypto_info.size()) < 0)
+      return false;
+  }
+  while (size > 0) {
+    size_t s = std::min(size, buf.size());
+    ssize_t r = m == user_tls ? SSL_write(ssl, buf.data(), s)
+                              : send(fd, buf.data(), s, 0);
+    if (r <= 0) {
+      fmt::print(stderr, "write error\n");
+      exit(1);
+    }
+    size -= r;
+  }
+  shutdown(fd, SHUT_WR);
+  SSL_free(ssl);
+  return true;
+}
+
+static void run(SSL_CTX* s_ctx, SSL_CTX* c_ctx, mode m, size_t size) {
+  static const char* names[] = {"tcp", "tls", "ktls"};
+
+  int listener = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t len = sizeof(addr);
+  if (bind(listener, reinterpret_cast<sockaddr*>(&addr), len) < 0 ||
+      listen(listener, 1) < 0 ||
+      getsockname(listener, reinterpret_cast<sockaddr*>(&addr), &len) < 0) {
+    perror("listen");
+    exit(1);
+  }
+
+  size_t received = 0;
+  std::thread server([&] {
+    int fd = accept(listener, nullptr, nullptr);
+    received = receive(s_ctx, fd, m);
+    close(fd);
+  });
+
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (connect(fd, reinterpret_cast<sockaddr*>(&addr), len) < 0) {
+    perror("connect");
+    exit(1);
+  }
+  auto start = std::chrono::steady_clock::now();
+  bool ok = send_all(c_ctx, fd, m, size);
+  if (!ok)
+    shutdown(fd, SHUT_RDWR);
+  server.join();
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  close(fd);
+  close(listener);
+
+  if (!ok)
+    fmt::print("{:>5}: not available on this host\n", names[m]);
+  else if (received != size)
+    fmt::print("{:>5}: {} bytes received instead of {}\n", names[m], received,
+               size);
+  else
+    fmt::print("{:>5}: {:.1f} MiB/s\n", names[m],
+               size / elapsed.count() / (1 << 20));
+}
+
+int main(int argc, char* argv[]) {
+  size_t size = (argc > 1 ? strtoul(argv[1], nullptr, 10) : 1024) << 20;
+
+  SSL_CTX* c_ctx = SSL_CTX_new(TLS_client_method());
+  SSL_CTX* s_ctx = SSL_CTX_new(TLS_server_method());
+  if (c_ctx == nullptr || s_ctx == nullptr) {
+    ERR_print_errors_fp(stderr);
+    return 1;
+  }
+
+  for (mode m : {plain_tcp, user_tls, kernel_tls})
+    run(s_ctx, c_ctx, m, size);
+
+  SSL_CTX_free(c_ctx);
+  SSL_CTX_free(s_ctx);
+  return 0;
+}
@@ -0,0 +1,268 @@
+/**
+ * Copyright 2024 Centreon (https://www.centreon.com/)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <linux/tls.h>
+#include <openssl/evp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+#include "com/centreon/broker/config/applier/init.hh"
+#include "com/centreon/broker/io/raw.hh"
+#include "com/centreon/broker/tls2/acceptor.hh"
+#include "com/centreon/broker/tls2/connector.hh"
+#include "com/centreon/broker/tls2/internal.hh"
+#include "com/centreon/broker/tls2/ktls.hh"
+
+using namespace com::centreon::broker;
+
+class Ktls : public ::testing::Test {
+ protected:
+  int _fd[2];
+  SSL_CTX* _c_ctx;
+  SSL_CTX* _s_ctx;
+  SSL* _client = nullptr;
+  SSL* _server = nullptr;
+
+  static SSL* _connect(SSL_CTX* ctx, int fd, bool server, const char* cipher) {
+    SSL* ssl = SSL_new(ctx);
+    SSL_set_security_level(ssl, 0);
+    SSL_set_cipher_list(ssl, cipher);
+    SSL_set_max_proto_version(ssl, TLS1_2_VERSION);
+    if (server)
+      SSL_set_dh_auto(ssl, 1);
+    SSL_set_fd(ssl, fd);
+    int r = server ? SSL_accept(ssl) : SSL_connect(ssl);
+    return r == 1 ? ssl : nullptr;
+  }
+
+ public:
+  void SetUp() override {
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, _fd), 0);
+    _c_ctx = SSL_CTX_new(TLS_client_method());
+    _s_ctx = SSL_CTX_new(TLS_server_method());
+  }
+
+  void TearDown() override {
+    SSL_free(_client);
+    SSL_free(_server);
+    SSL_CTX_free(_c_ctx);
+    SSL_CTX_free(_s_ctx);
+    close(_fd[0]);
+    close(_fd[1]);
+  }
+
+  void handshake(const char* cipher) {
+    std::thread t([this, cipher] {
+      _server = _connect(_s_ctx, _fd[1], true, cipher);
+    });
+    _client = _connect(_c_ctx, _fd[0], false, cipher);
+    t.join();
+    ASSERT_TRUE(_client);
+    ASSERT_TRUE(_server);
+  }
+
+  /**
+   * @brief Encrypt records as the kernel does with the given crypto info, and
+   * check that the peer decrypts them with OpenSSL.
+   */
+  template <typename T>
+  void check(const std::vector<char>& crypto_info,
+             const EVP_CIPHER* cipher,
+             int fd,
+             SSL* peer) {
+    T info;
+    ASSERT_EQ(crypto_info.size(), sizeof(info));
+    memcpy(&info, crypto_info.data(), sizeof(info));
+
+    const std::string msg{"Bonjour le monde"};
+    for (int i = 0; i < 3; ++i) {
+      unsigned char nonce[12];
+      memcpy(nonce, info.salt, 4);
+      memcpy(nonce + 4, info.iv, 8);
+      unsigned char aad[13];
+      memcpy(aad, info.rec_seq, 8);
+      aad[8] = 23;
+      aad[9] = 3;
+      aad[10] = 3;
+      aad[11] = msg.size() >> 8;
+      aad[12] = msg.size() & 0xff;
+
+      size_t len = 8 + msg.size() + 16;
+      std::vector<unsigned char> record(5 + len);
+      record[0] = 23;
+      record[1] = 3;
+      record[2] = 3;
+      record[3] = len >> 8;
+      record[4] = len & 0xff;
+      memcpy(&record[5], info.iv, 8);
+
+      EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+      const unsigned char* plain =
+          reinterpret_cast<const unsigned char*>(msg.data());
+      int l;
+      ASSERT_TRUE(
+          EVP_EncryptInit_ex(ctx, cipher, nullptr, info.key, nonce) &&
+          EVP_EncryptUpdate(ctx, nullptr, &l, aad, sizeof(aad)) &&
+          EVP_EncryptUpdate(ctx, &record[13], &l, plain, msg.size()) &&
+          EVP_EncryptFinal_ex(ctx, &record[13 + l], &l) &&
+          EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_GCM_GET_TAG, 16,
+                              &record[13 + msg.size()]));
+      EVP_CIPHER_CTX_free(ctx);
+      ASSERT_EQ(write(fd, record.data(), record.size()),
+                static_cast<ssize_t>(record.size()));
+
+      char buf[100];
+      int r = SSL_read(peer, buf, sizeof(buf));
+      ASSERT_EQ(std::string(buf, r > 0 ? r : 0), msg);
+
+      /* The kernel increments the sequence number and the explicit nonce. */
+      for (int j = 7; j >= 0 && ++info.rec_seq[j] == 0; --j)
+        ;
+      memcpy(info.iv, info.rec_seq, 8);
+    }
+  }
+};
+
+TEST_F(Ktls, ClientAes128) {
+  handshake("ADH-AES128-GCM-SHA256");
+  std::vector<char> crypto_info;
+  ASSERT_TRUE(tls2::ktls_tx_crypto_info(_client, crypto_info));
+  check<tls12_crypto_info_aes_gcm_128>(crypto_info, EVP_aes_128_gcm(), _fd[0],
+                                       _server);
+}
+
+TEST_F(Ktls, ServerAes256) {
+  handshake("ADH-AES256-GCM-SHA384");
+  std::vector<char> crypto_info;
+  ASSERT_TRUE(tls2::ktls_tx_crypto_info(_server, crypto_info));
+  check<tls12_crypto_info_aes_gcm_256>(crypto_info, EVP_aes_256_gcm(), _fd[1],
+                                       _client);
+}
+
+TEST_F(Ktls, CbcNotSupported) {
+  handshake("ADH-AES128-SHA256");
+  std::vector<char> crypto_info;
+  ASSERT_FALSE(tls2::ktls_tx_crypto_info(_client, crypto_info));
+}
+
+/**
+ * @brief One end of an in memory connection. It accepts kTLS: once enabled,
+ * what is written is counted, it would be encrypted by the kernel.
+ */
+class KtlsPipeEnd : public io::stream {
+ public:
+  struct pipe {
+    std::mutex m;
+    std::string buf[2];
+  };
+
+ private:
+  std::shared_ptr<pipe> _pipe;
+  const int _side;
+  bool _ktls = false;
+  size_t _written_after_ktls = 0;
+
+ public:
+  KtlsPipeEnd(const std::shared_ptr<pipe>& p, int side)
+      : io::stream("ktls_pipe"), _pipe(p), _side(side) {}
+
+  bool read(std::shared_ptr<io::data>& d, time_t) override {
+    std::lock_guard<std::mutex> lck(_pipe->m);
+    std::string& in = _pipe->buf[1 - _side];
+    if (in.empty())
+      return false;
+    d = std::make_shared<io::raw>(std::vector<char>(in.begin(), in.end()));
+    in.clear();
+    return true;
+  }
+
+  int32_t write(const std::shared_ptr<io::data>& d) override {
+    const std::vector<char>& v =
+        std::static_pointer_cast<io::raw>(d)->get_buffer();
+    if (_ktls)
+      _written_after_ktls += v.size();
+    std::lock_guard<std::mutex> lck(_pipe->m);
+    _pipe->buf[_side].append(v.data(), v.size());
+    return 1;
+  }
+
+  int32_t stop() override { return 0; }
+
+  bool set_ktls_tx(const std::vector<char>&) override {
+    _ktls = true;
+    return true;
+  }
+
+  bool ktls() const { return _ktls; }
+  size_t written_after_ktls() const { return _written_after_ktls; }
+};
+
+class KtlsStream : public ::testing::Test {
+ public:
+  void SetUp() override {
+    try {
+      config::applier::init(com::centreon::common::BROKER, 0, "test_broker", 0);
+    } catch (const std::exception& e) {
+      (void)e;
+    }
+    tls2::initialize();
+  }
+
+  void TearDown() override { config::applier::deinit(); }
+};
+
+// Given two anonymous tls2 streams with kTLS
+// When the handshake is done
+// Then both substreams encrypt what is sent
+// When the streams are closed
+// Then OpenSSL emits no record, no close_notify
+TEST_F(KtlsStream, CloseWithoutOpenSSLRecord) {
+  auto p = std::make_shared<KtlsPipeEnd::pipe>();
+  auto acc_sub = std::make_shared<KtlsPipeEnd>(p, 0);
+  auto con_sub = std::make_shared<KtlsPipeEnd>(p, 1);
+  tls2::acceptor acceptor("", "", "", "", true);
+  tls2::connector connector("", "", "", "", true);
+
+  std::shared_ptr<io::stream> acc;
+  std::thread t([&] { acc = acceptor.open(acc_sub); });
+  std::shared_ptr<io::stream> con = connector.open(con_sub);
+  t.join();
+  ASSERT_TRUE(acc);
+  ASSERT_TRUE(con);
+  ASSERT_TRUE(acc_sub->ktls());
+  ASSERT_TRUE(con_sub->ktls());
+  // the last handshake records were sent before the offload
+  ASSERT_EQ(acc_sub->written_after_ktls(), 0u);
+  ASSERT_EQ(con_sub->written_after_ktls(), 0u);
+
+  // data are given as is to the kernel
+  const std::string msg{"Bonjour"};
+  con->write(
+      std::make_shared<io::raw>(std::vector<char>(msg.begin(), msg.end())));
+  ASSERT_EQ(con_sub->written_after_ktls(), 7u);
+
+  con.reset();
+  acc.reset();
+  ASSERT_EQ(con_sub->written_after_ktls(), 7u);
+  ASSERT_EQ(acc_sub->written_after_ktls(), 0u);
+}
@@ -0,0 +1,58 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCB_UNIFIED_SQL_ACK_COUNTER_HH
+#define CCB_UNIFIED_SQL_ACK_COUNTER_HH
+
+#include <absl/container/btree_set.h>
+
+namespace com::centreon::broker::unified_sql {
+/**
+ * @class ack_counter ack_counter.hh
+ * "com/centreon/broker/unified_sql/ack_counter.hh"
+ * @brief Count the events that can be acknowledged when some of them are
+ * parked.
+ *
+ * Acknowledgements are positional: acknowledging n events releases the n
+ * oldest ones of the muxer queue. So no event received after the oldest
+ * parked one can be acknowledged before it is processed, even if it is
+ * itself processed.
+ *
+ * Each event gets a sequence number, the current one is returned by
+ * current(), and next() must be called once the event has been processed or
+ * parked.
+ */
+class ack_counter {
+  /* Sequence number of the event being processed. */
+  uint64_t _current = 0;
+  /* Events before this sequence number have been counted as acknowledgeable.
+   */
+  uint64_t _released = 0;
+  absl::btree_multiset<uint64_t> _parked;
+
+ public:
+  uint64_t current() const { return _current; }
+  uint64_t park();
+  void unpark(uint64_t seq);
+  void next();
+  uint32_t pop_acknowledgeable();
+  size_t parked() const { return _parked.size(); }
+};
+}  // namespace com::centreon::broker::unified_sql
+
+#endif  // !CCB_UNIFIED_SQL_ACK_COUNTER_HH
@@ -24,6 +24,7 @@
 #include "com/centreon/broker/io/stream.hh"
 #include "com/centreon/broker/misc/shared_mutex.hh"
 #include "com/centreon/broker/sql/mysql_multi_insert.hh"
+#include "com/centreon/broker/unified_sql/ack_counter.hh"
 #include "com/centreon/broker/unified_sql/bulk_bind.hh"
 #include "com/centreon/broker/unified_sql/bulk_queries.hh"
 #include "com/centreon/broker/unified_sql/rebuilder.hh"
@@ -209,6 +210,61 @@ class stream : public io::stream {
     float min;
     float max;
     bool metric_mapping_sent;
+    /* Time of the last value stored, RRD rejects older values. */
+    time_t last_time = 0;
+  };
+
+  /* Key of the metric cache: the index ID and the metric name. */
+  using index_metric = std::pair<uint64_t, std::string>;
+
+  /**
+   * @brief This struct is used to lookup in the metric cache with a
+   * std::pair<uint64_t, std::string_view>, so that no std::string is built
+   * for each perfdata.
+   */
+  struct index_metric_hash_eq {
+    using is_transparent = void;
+    using index_metric_view = std::pair<uint64_t, std::string_view>;
+
+    size_t operator()(const index_metric& to_hash) const {
+      return absl::Hash<index_metric>()(to_hash);
+    }
+    size_t operator()(const index_metric_view& to_hash) const {
+      return absl::Hash<index_metric_view>()(to_hash);
+    }
+
+    bool operator()(const index_metric& left, const index_metric& right) const {
+      return left == right;
+    }
+    bool operator()(const index_metric& left,
+                    const index_metric_view& right) const {
+      return left.first == right.first && left.second == right.second;
+    }
+    bool operator()(const index_metric_view& left,
+                    const index_metric& right) const {
+      return left.first == right.first && left.second == right.second;
+    }
+    bool operator()(const index_metric_view& left,
+                    const index_metric_view& right) const {
+      return left == right;
+    }
+  };
+  using index_metric_view = index_metric_hash_eq::index_metric_view;
+
+  template <typename T>
+  using index_metric_map = absl::flat_hash_map<index_metric,
+                                               T,
+                                               index_metric_hash_eq,
+                                               index_metric_hash_eq>;
+
+  /* A service status whose perfdata contain metrics without ID yet. Its
+   * perfdata are processed again once these IDs are known. */
+  struct parked_perfdata {
+    std::shared_ptr<io::data> event;
+    uint64_t index_id;
+    std::list<common::perfdata> pds;
+    /* Its sequence number in _acks. */
+    uint64_t seq;
   };
 
   instance_state _state;
@@ -219,6 +275,8 @@ class stream : public io::stream {
 
   std::atomic_int _pending_events;
   uint32_t _count;
+  /* Traces of the sampled events written since the last commit. */
+  std::vector<std::shared_ptr<io::trace>> _traces;
   bool _bulk_prepared_statement = false;
 
   /* Current actions by connection */
@@ -262,10 +320,26 @@ class stream : public io::stream {
   absl::flat_hash_map<std::pair<uint64_t, uint64_t>, size_t> _cache_svc_cmd;
   absl::flat_hash_map<std::pair<uint64_t, uint64_t>, index_info> _index_cache;
 
-  absl::flat_hash_map<std::pair<uint64_t, std::string>, metric_info>
-      _metric_cache;
+  index_metric_map<metric_info> _metric_cache;
   misc::shared_mutex _metric_cache_m;
 
+  /* New metrics are not inserted one by one in the database. They are stored
+   * in _metrics_to_create and inserted with one query. While this query is
+   * executed, its metrics are in _metrics_in_flight and _metric_ids will
+   * contain their IDs. Meanwhile, the service statuses using them are parked
+   * in _parked_perfdata, in their reception order. All these are only used by
+   * the stream thread. */
+  index_metric_map<common::perfdata> _metrics_to_create;
+  index_metric_map<common::perfdata> _metrics_in_flight;
+  std::future<database::mysql_result> _metric_ids;
+  std::deque<parked_perfdata> _parked_perfdata;
+  /* Indexes with parked events, the following events of these indexes are
+   * also parked to keep their order. */
+  absl::flat_hash_set<uint64_t> _parked_indexes;
+  /* Events received after the oldest parked one are not acknowledged before
+   * it, even if they are processed. */
+  ack_counter _acks;
+
   absl::flat_hash_map<std::pair<uint64_t, uint16_t>, uint64_t> _severity_cache;
   absl::flat_hash_map<std::pair<uint64_t, uint16_t>, uint64_t> _tags_cache;
 
@@ -356,6 +430,16 @@ class stream : public io::stream {
   std::unique_ptr<database::mysql_stmt_base> _sscr_update;
   std::unique_ptr<bulk_bind> _sscr_bind;
 
+  /* Last service status received for each service, not yet written in the
+   * services and resources tables. They are bound to the statements above by
+   * _flush_service_statuses() when the actions are finished, so a backlog of
+   * statuses costs one row per service. Before a query updating the same
+   * rows, they are written by _write_service_statuses(), and a pb_service,
+   * that writes all the columns, drops the status of its service. Only used
+   * by the stream thread. */
+  absl::flat_hash_map<std::pair<uint64_t, uint64_t>, std::shared_ptr<io::data>>
+      _pending_service_statuses;
+
   /* Statement and binding to enable hosts in the hosts table. One value is
    * set at index 0 that is the host ID. */
   std::unique_ptr<database::mysql_stmt_base> _eh_update;
@@ -456,6 +540,11 @@ class stream : public io::stream {
   uint64_t _process_pb_service_in_resources(const Service& s, int32_t conn);
   void _process_pb_adaptive_service(const std::shared_ptr<io::data>& d);
   void _process_pb_service_status(const std::shared_ptr<io::data>& d);
+  void _store_pb_service_status(const ServiceStatus& sscr);
+  void _flush_service_statuses();
+  void _flush_service_status(uint64_t host_id, uint64_t service_id);
+  void _write_service_statuses();
+  void _send_service_status_binds() ABSL_LOCKS_EXCLUDED(_barrier_timer_m);
   void _process_pb_adaptive_service_status(const std::shared_ptr<io::data>& d);
   void _process_severity(const std::shared_ptr<io::data>& d);
   void _process_tag(const std::shared_ptr<io::data>& d);
@@ -471,6 +560,14 @@ class stream : public io::stream {
 
   void _unified_sql_process_pb_service_status(
       const std::shared_ptr<io::data>& d);
+  void _unified_sql_process_pb_otl_metrics(const std::shared_ptr<io::data>& d);
+  bool _process_pb_perfdata(const std::shared_ptr<io::data>& d,
+                            std::list<common::perfdata>& pds,
+                            bool retry);
+  bool _metric_in_creation(const index_metric_view& key) const;
+  void _create_metrics();
+  void _check_metric_ids(bool wait);
+  void _resume_parked_perfdata();
 
   void _load_deleted_instances();
   void _init_statements();
@@ -0,0 +1,64 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/broker/unified_sql/ack_counter.hh"
+
+using namespace com::centreon::broker::unified_sql;
+
+/**
+ * @brief Park the current event.
+ *
+ * @return Its sequence number, to give to unpark() once it is processed.
+ */
+uint64_t ack_counter::park() {
+  _parked.insert(_current);
+  return _current;
+}
+
+/**
+ * @brief A parked event, or one part of it, has been processed.
+ *
+ * @param seq The sequence number returned by park().
+ */
+void ack_counter::unpark(uint64_t seq) {
+  auto found = _parked.find(seq);
+  if (found != _parked.end())
+    _parked.erase(found);
+}
+
+/**
+ * @brief The current event is done, processed or parked.
+ */
+void ack_counter::next() {
+  ++_current;
+}
+
+/**
+ * @brief Number of events that can be acknowledged since the last call: the
+ * events done and older than the oldest parked one.
+ *
+ * @return A number of events.
+ */
+uint32_t ack_counter::pop_acknowledgeable() {
+  uint64_t limit = _parked.empty() ? _current : *_parked.begin();
+  if (limit <= _released)
+    return 0;
+  uint32_t retval = limit - _released;
+  _released = limit;
+  return retval;
+}
@@ -22,6 +22,7 @@
 #include "bbdo/storage/index_mapping.hh"
 #include "com/centreon/broker/cache/global_cache.hh"
 #include "com/centreon/broker/exceptions/shutdown.hh"
+#include "com/centreon/broker/io/trace.hh"
 #include "com/centreon/broker/multiplexing/publisher.hh"
 #include "com/centreon/broker/neb/events.hh"
 #include "com/centreon/broker/unified_sql/internal.hh"
@@ -257,6 +258,14 @@ stream::~stream() noexcept {
    */
   absl::MutexLock lck(&_barrier_timer_m);
   /* If there are data to write, we write them, so we force their readyness. */
+  try {
+    _flush_service_statuses();
+  } catch (const std::exception& e) {
+    SPDLOG_LOGGER_ERROR(_logger_sql,
+                        "unified_sql: could not write pending service "
+                        "statuses: {}",
+                        e.what());
+  }
   if (_hscr_bind)
     _hscr_bind->force_ready();
   if (_sscr_bind)
@@ -619,7 +628,7 @@ void stream::update_metric_info_cache(uint64_t index_id,
                                       std::string const& metric_name,
                                       short metric_type) {
   misc::read_lock lck(_metric_cache_m);
-  auto it = _metric_cache.find({index_id, metric_name});
+  auto it = _metric_cache.find(index_metric_view(index_id, metric_name));
   if (it != _metric_cache.end()) {
     _logger_sto->info(
         "unified sql: updating metric '{}' of id {} at index {} to "
@@ -667,9 +676,13 @@ void stream::_finish_action(int32_t conn, uint32_t action) {
  */
 void stream::_finish_actions() {
   SPDLOG_LOGGER_TRACE(_logger_sql, "unified sql: finish actions");
+  _flush_service_statuses();
   _mysql.commit();
   for (uint32_t& v : _action)
     v = actions::none;
+  for (auto& t : _traces)
+    t->commit("unified_sql");
+  _traces.clear();
   _ack += _processed;
   _processed = 0;
   SPDLOG_LOGGER_TRACE(_logger_sql, "finish actions processed = {}",
@@ -728,10 +741,16 @@ int32_t stream::write(const std::shared_ptr<io::data>& data) {
   ++_pending_events;
   assert(data);
 
+  /* Parked events are processed as soon as their metric IDs are known. */
+  _check_metric_ids(false);
+
   SPDLOG_LOGGER_TRACE(
       _logger_sql, "unified sql: write event category:{}, element:{}",
       category_of_type(data->type()), element_of_type(data->type()));
 
+  if (data->trace)
+    _traces.push_back(data->trace);
+
   uint32_t type = data->type();
   uint16_t cat = category_of_type(type);
   uint16_t elem = element_of_type(type);
@@ -765,6 +784,8 @@ int32_t stream::write(const std::shared_ptr<io::data>& data) {
       SPDLOG_LOGGER_INFO(_logger_sql, "poller stopped...");
       process_stop(data);
     }
+  } else if (cat == io::storage && elem == storage::de_pb_otl_metrics) {
+    _unified_sql_process_pb_otl_metrics(data);
   } else {
     SPDLOG_LOGGER_TRACE(
         _logger_sql,
@@ -772,8 +793,10 @@ int32_t stream::write(const std::shared_ptr<io::data>& data) {
         "the database.",
         type);
   }
-  _processed++;
+  _acks.next();
+  _processed += _acks.pop_acknowledgeable();
   _count++;
+  _create_metrics();
 
   time_t now = std::time(nullptr);
   if (now >= _next_loop_timeout || _count >= _max_pending_queries) {
@@ -805,6 +828,7 @@ class unified_muxer_filter : public multiplexing::muxer_filter {
     _mask[io::bbdo] |= 1ULL << bbdo::de_remove_graphs;
     _mask[io::bbdo] |= 1ULL << bbdo::de_remove_poller;
     _mask[io::local] |= 1ULL << local::de_pb_stop;
+    _mask[io::storage] |= 1ULL << storage::de_pb_otl_metrics;
     _mask[io::extcmd] |= 1ULL << extcmd::de_pb_bench;
   }
 };
@@ -827,6 +851,8 @@ const multiplexing::muxer_filter& stream::get_forbidden_filter() {
  * @return Number of acknowledged events.
  */
 int32_t stream::flush() {
+  _check_metric_ids(false);
+  _create_metrics();
   if (!_ack)
     _finish_actions();
   int32_t retval = _ack;
@@ -861,6 +887,11 @@ bool stream::read(std::shared_ptr<io::data>& d, time_t deadline) {
  */
 int32_t stream::stop() {
   _logger_sql->trace("unified_sql::stream stop {}", static_cast<void*>(this));
+  /* Parked events must be processed before stopping. */
+  while (!_parked_perfdata.empty() || _metric_ids.valid()) {
+    _create_metrics();
+    _check_metric_ids(true);
+  }
   int32_t retval = flush();
   /* We give the order to stop the check_queues */
   _stop_check_queues = true;
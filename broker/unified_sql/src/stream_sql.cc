@@ -364,6 +364,20 @@ void stream::_update_hosts_and_services_of_instance(uint32_t id,
  *  @param instance_id The id of the instance to have its timestamp updated.
  */
 void stream::_update_timestamp(uint32_t instance_id) {
+  /* The services of the instance are going to be updated, the pending
+   * statuses must be written before. It is done before locking
+   * _stored_timestamps_m as timers lock it after _barrier_timer_m. */
+  bool update_services;
+  {
+    std::lock_guard<std::mutex> l(_stored_timestamps_m);
+    auto found = _stored_timestamps.find(instance_id);
+    update_services =
+        found == _stored_timestamps.end() ||
+        found->second.get_state() == stored_timestamp::unresponsive;
+  }
+  if (update_services)
+    _write_service_statuses();
+
   std::lock_guard<std::mutex> l(_stored_timestamps_m);
   // Find the state of an existing timestamp if it exists.
   std::unordered_map<uint32_t, stored_timestamp>::iterator found =
@@ -3412,6 +3426,7 @@ void stream::_process_service_group(const std::shared_ptr<io::data>& d) {
 
     // Delete group members.
     {
+      _write_service_statuses();
       _finish_action(-1, actions::services);
       std::string query(fmt::format(
           "DELETE services_servicegroups FROM services_servicegroups "
@@ -3468,6 +3483,7 @@ void stream::_process_pb_service_group(const std::shared_ptr<io::data>& d) {
 
     // Delete group members.
     {
+      _write_service_statuses();
       _finish_action(-1, actions::services);
       std::string query(fmt::format(
           "DELETE services_servicegroups FROM services_servicegroups "
@@ -3493,6 +3509,7 @@ void stream::_process_pb_service_group(const std::shared_ptr<io::data>& d) {
  */
 void stream::_process_service_group_member(const std::shared_ptr<io::data>& d) {
   int32_t conn = special_conn::service_group % _mysql.connections_count();
+  _write_service_statuses();
   _finish_action(-1, actions::services);
 
   // Cast object.
@@ -3592,6 +3609,7 @@ void stream::_process_service_group_member(const std::shared_ptr<io::data>& d) {
 void stream::_process_pb_service_group_member(
     const std::shared_ptr<io::data>& d) {
   int32_t conn = special_conn::service_group % _mysql.connections_count();
+  _write_service_statuses();
   _finish_action(-1, actions::services);
 
   // Cast object.
@@ -3794,6 +3812,10 @@ void stream::_process_pb_service(const std::shared_ptr<io::data>& d) {
       "description: {})",
       s.host_id(), s.service_id(), s.description());
 
+  /* This event is newer than the pending status of the service and writes
+   * all its columns, so this status must not be written after it. */
+  _pending_service_statuses.erase({s.host_id(), s.service_id()});
+
   if (s.host_id() && s.service_id()) {
     // Prepare queries.
     if (!_pb_service_insupdate.prepared()) {
@@ -4455,215 +4477,10 @@ void stream::_process_pb_service_status(const std::shared_ptr<io::data>& d) {
                        sscr.host_id(), sscr.service_id(), sscr.last_check(),
                        sscr.state(), sscr.state_type());
 
-    // Processing.
-    if (_store_in_hosts_services) {
-      int32_t conn = _mysql.choose_connection_by_instance(
-          _cache_host_instance[static_cast<uint32_t>(sscr.host_id())]);
-      if (_bulk_prepared_statement) {
-        std::lock_guard<bulk_bind> lck(*_sscr_bind);
-        if (!_sscr_bind->bind(conn))
-          _sscr_bind->init_from_stmt(conn);
-        auto* b = _sscr_bind->bind(conn).get();
-        b->set_value_as_bool(0, sscr.checked());
-        b->set_value_as_i32(1, sscr.check_type());
-        b->set_value_as_i32(2, sscr.state());
-        b->set_value_as_i32(3, sscr.state_type());
-        b->set_value_as_i64(4, sscr.last_state_change(),
-                            mapping::entry::invalid_on_zero);
-        b->set_value_as_i32(5, sscr.last_hard_state());
-        b->set_value_as_i64(6, sscr.last_hard_state_change(),
-                            mapping::entry::invalid_on_zero);
-        b->set_value_as_i64(7, sscr.last_time_ok(),
-                            mapping::entry::invalid_on_zero);
-        b->set_value_as_i64(8, sscr.last_time_warning(),
-                            mapping::entry::invalid_on_zero);
-        b->set_value_as_i64(9, sscr.last_time_critical(),
-                            mapping::entry::invalid_on_zero);
-        b->set_value_as_i64(10, sscr.last_time_unknown(),
-                            mapping::entry::invalid_on_zero);
-        std::string full_output{
-            fmt::format("{}\n{}", sscr.output(), sscr.long_output())};
-        size_t size = common::adjust_size_utf8(
-            full_output, get_centreon_storage_services_col_size(
-                             centreon_storage_services_output));
-        b->set_value_as_str(11, fmt::string_view(full_output.data(), size));
-        size = common::adjust_size_utf8(
-            sscr.perfdata(), get_centreon_storage_services_col_size(
-                                 centreon_storage_services_perfdata));
-        b->set_value_as_str(12, fmt::string_view(sscr.perfdata().data(), size));
-        b->set_value_as_bool(13, sscr.flapping());
-        b->set_value_as_f64(14, sscr.percent_state_change());
-        b->set_value_as_f64(15, sscr.latency());
-        b->set_value_as_f64(16, sscr.execution_time());
-        if (sscr.last_check() == 0)
-          b->set_null_i64(17);
-        else
-          b->set_value_as_i64(17, sscr.last_check());
-        b->set_value_as_i64(18, sscr.next_check());
-        b->set_value_as_bool(19, sscr.should_be_scheduled());
-        b->set_value_as_i32(20, sscr.check_attempt());
-        b->set_value_as_i32(21, sscr.notification_number());
-        b->set_value_as_bool(22, sscr.no_more_notifications());
-        b->set_value_as_i64(23, sscr.last_notification(),
-                            mapping::entry::invalid_on_zero);
-        b->set_value_as_i64(24, sscr.next_notification(),
-                            mapping::entry::invalid_on_zero);
-        b->set_value_as_bool(25, sscr.acknowledgement_type() != AckType::NONE);
-        b->set_value_as_i32(26, sscr.acknowledgement_type());
-        _logger_sql->debug("service3 ({}, {}) scheduled_downtime_depth: {}",
-                           sscr.host_id(), sscr.service_id(),
-                           sscr.scheduled_downtime_depth());
-        b->set_value_as_i32(27, sscr.scheduled_downtime_depth());
-        b->set_value_as_i32(28, sscr.host_id());
-        b->set_value_as_i32(29, sscr.service_id());
-        b->next_row();
-        SPDLOG_LOGGER_TRACE(_logger_sql,
-                            "{} waiting updates for service status in services",
-                            b->current_row());
-      } else {
-        _sscr_update->bind_value_as_bool(0, sscr.checked());
-        _sscr_update->bind_value_as_i32(1, sscr.check_type());
-        _sscr_update->bind_value_as_i32(2, sscr.state());
-        _sscr_update->bind_value_as_i32(3, sscr.state_type());
-        _sscr_update->bind_value_as_i64_ext(4, sscr.last_state_change(),
-                                            mapping::entry::invalid_on_zero);
-        _sscr_update->bind_value_as_i32(5, sscr.last_hard_state());
-        _sscr_update->bind_value_as_i64_ext(6, sscr.last_hard_state_change(),
-                                            mapping::entry::invalid_on_zero);
-        _sscr_update->bind_value_as_i64_ext(7, sscr.last_time_ok(),
-                                            mapping::entry::invalid_on_zero);
-        _sscr_update->bind_value_as_i64_ext(8, sscr.last_time_warning(),
-                                            mapping::entry::invalid_on_zero);
-        _sscr_update->bind_value_as_i64_ext(9, sscr.last_time_critical(),
-                                            mapping::entry::invalid_on_zero);
-        _sscr_update->bind_value_as_i64_ext(10, sscr.last_time_unknown(),
-                                            mapping::entry::invalid_on_zero);
-        std::string full_output{
-            fmt::format("{}\n{}", sscr.output(), sscr.long_output())};
-        size_t size = common::adjust_size_utf8(
-            full_output, get_centreon_storage_services_col_size(
-                             centreon_storage_services_output));
-        _sscr_update->bind_value_as_str(
-            11, fmt::string_view(full_output.data(), size));
-        size = common::adjust_size_utf8(
-            sscr.perfdata(), get_centreon_storage_services_col_size(
-                                 centreon_storage_services_perfdata));
-        _sscr_update->bind_value_as_str(
-            12, fmt::string_view(sscr.perfdata().data(), size));
-        _sscr_update->bind_value_as_bool(13, sscr.flapping());
-        _sscr_update->bind_value_as_f64(14, sscr.percent_state_change());
-        _sscr_update->bind_value_as_f64(15, sscr.latency());
-        _sscr_update->bind_value_as_f64(16, sscr.execution_time());
-        _sscr_update->bind_value_as_i64_ext(17, sscr.last_check(),
-                                            mapping::entry::invalid_on_zero);
-        _sscr_update->bind_value_as_i64(18, sscr.next_check());
-        _sscr_update->bind_value_as_bool(19, sscr.should_be_scheduled());
-        _sscr_update->bind_value_as_i32(20, sscr.check_attempt());
-        _sscr_update->bind_value_as_u64(21, sscr.notification_number());
-        _sscr_update->bind_value_as_bool(22, sscr.no_more_notifications());
-        _sscr_update->bind_value_as_i64_ext(23, sscr.last_notification(),
-                                            mapping::entry::invalid_on_zero);
-        _sscr_update->bind_value_as_i64_ext(24, sscr.next_notification(),
-                                            mapping::entry::invalid_on_zero);
-        _sscr_update->bind_value_as_bool(
-            25, sscr.acknowledgement_type() != AckType::NONE);
-        _sscr_update->bind_value_as_i32(26, sscr.acknowledgement_type());
-        _logger_sql->debug("service4 ({}, {}) scheduled_downtime_depth: {}",
-                           sscr.host_id(), sscr.service_id(),
-                           sscr.scheduled_downtime_depth());
-        _sscr_update->bind_value_as_i32(27, sscr.scheduled_downtime_depth());
-        _sscr_update->bind_value_as_i32(28, sscr.host_id());
-        _sscr_update->bind_value_as_i32(29, sscr.service_id());
-
-        _mysql.run_statement(*_sscr_update,
-                             database::mysql_error::store_service_status, conn);
-
-        _add_action(conn, actions::services);
-      }
-    }
-
-    if (_store_in_resources) {
-      int32_t conn = _mysql.choose_connection_by_instance(
-          _cache_host_instance[static_cast<uint32_t>(sscr.host_id())]);
-      size_t output_size = common::adjust_size_utf8(
-          sscr.output(), get_centreon_storage_resources_col_size(
-                             centreon_storage_resources_output));
-      _logger_sql->debug(
-          "unified_sql: pb service status ({}, {}) {} in resources",
-          sscr.host_id(), sscr.service_id(), sscr.state());
-      if (_bulk_prepared_statement) {
-        _logger_sql->debug(
-            "unified_sql: BULK pb service status ({}, {}) {} in resources",
-            sscr.host_id(), sscr.service_id(), sscr.state());
-        std::lock_guard<bulk_bind> lck(*_sscr_resources_bind);
-        if (!_sscr_resources_bind->bind(conn))
-          _sscr_resources_bind->init_from_stmt(conn);
-        auto* b = _sscr_resources_bind->bind(conn).get();
-        b->set_value_as_i32(0, sscr.state());
-        b->set_value_as_i32(1, svc_ordered_status[sscr.state()]);
-        b->set_value_as_u64(2, sscr.last_state_change(),
-                            mapping::entry::invalid_on_zero);
-        _logger_sql->debug("service5 ({}, {}) scheduled_downtime_depth: {}",
-                           sscr.host_id(), sscr.service_id(),
-                           sscr.scheduled_downtime_depth());
-        b->set_value_as_bool(3, sscr.scheduled_downtime_depth() > 0);
-        b->set_value_as_bool(4, sscr.acknowledgement_type() != AckType::NONE);
-        b->set_value_as_bool(5,
-                             sscr.state_type() == ServiceStatus_StateType_HARD);
-        b->set_value_as_u32(6, sscr.check_attempt());
-        b->set_value_as_bool(7, sscr.perfdata() != "");
-        b->set_value_as_u32(8, sscr.check_type());
-        if (sscr.last_check() == 0)
-          b->set_null_u64(9);
-        else
-          b->set_value_as_u64(9, sscr.last_check());
-        b->set_value_as_str(
-            10, fmt::string_view(sscr.output().c_str(), output_size));
-        b->set_value_as_bool(11, sscr.flapping());
-        b->set_value_as_f64(12, sscr.percent_state_change());
-        b->set_value_as_u64(13, sscr.service_id());
-        b->set_value_as_u64(14, sscr.host_id());
-        b->next_row();
-        SPDLOG_LOGGER_TRACE(
-            _logger_sql, "{} waiting updates for service status in resources",
-            b->current_row());
-      } else {
-        _logger_sql->debug(
-            "unified_sql: NOT BULK pb service status ({}, {}) {} in "
-            "resources",
-            sscr.host_id(), sscr.service_id(), sscr.state());
-        _sscr_resources_update->bind_value_as_i32(0, sscr.state());
-        _sscr_resources_update->bind_value_as_i32(
-            1, svc_ordered_status[sscr.state()]);
-        _sscr_resources_update->bind_value_as_u64_ext(
-            2, sscr.last_state_change(), mapping::entry::invalid_on_zero);
-        _logger_sql->debug("service6 ({}, {}) scheduled_downtime_depth: {}",
-                           sscr.host_id(), sscr.service_id(),
-                           sscr.scheduled_downtime_depth());
-        _sscr_resources_update->bind_value_as_bool(
-            3, sscr.scheduled_downtime_depth() > 0);
-        _sscr_resources_update->bind_value_as_bool(
-            4, sscr.acknowledgement_type() != AckType::NONE);
-        _sscr_resources_update->bind_value_as_bool(
-            5, sscr.state_type() == ServiceStatus_StateType_HARD);
-        _sscr_resources_update->bind_value_as_u32(6, sscr.check_attempt());
-        _sscr_resources_update->bind_value_as_bool(7, sscr.perfdata() != "");
-        _sscr_resources_update->bind_value_as_u32(8, sscr.check_type());
-        _sscr_resources_update->bind_value_as_u64_ext(
-            9, sscr.last_check(), mapping::entry::invalid_on_zero);
-        _sscr_resources_update->bind_value_as_str(
-            10, fmt::string_view(sscr.output().c_str(), output_size));
-        _sscr_resources_update->bind_value_as_bool(11, sscr.flapping());
-        _sscr_resources_update->bind_value_as_f64(12,
-                                                  sscr.percent_state_change());
-        _sscr_resources_update->bind_value_as_u64(13, sscr.service_id());
-        _sscr_resources_update->bind_value_as_u64(14, sscr.host_id());
-
-        _mysql.run_statement(*_sscr_resources_update,
-                             database::mysql_error::store_service_status, conn);
-        _add_action(conn, actions::resources);
-      }
-    }
+    /* Only the last status of the service is written when the pending
+     * statuses are flushed. */
+    if (_store_in_hosts_services || _store_in_resources)
+      _pending_service_statuses[{sscr.host_id(), sscr.service_id()}] = d;
   } else
     // Do nothing.
     SPDLOG_LOGGER_INFO(
@@ -4682,6 +4499,305 @@ void stream::_process_pb_service_status(const std::shared_ptr<io::data>& d) {
   _unified_sql_process_pb_service_status(d);
 }
 
+/**
+ * @brief Write the pending service statuses in the services and resources
+ * tables. Each service has at most one pending status, the last one received,
+ * so a backlog of statuses of the same service costs only one row.
+ */
+void stream::_flush_service_statuses() {
+  if (_pending_service_statuses.empty())
+    return;
+
+  SPDLOG_LOGGER_DEBUG(_logger_sql,
+                      "unified_sql: writing {} pending service statuses",
+                      _pending_service_statuses.size());
+  for (auto& [key, d] : _pending_service_statuses)
+    _store_pb_service_status(
+        static_cast<const neb::pb_service_status*>(d.get())->obj());
+  _pending_service_statuses.clear();
+}
+
+/**
+ * @brief Write the pending status of a service, if any, before an event that
+ * updates the same columns.
+ *
+ * @param host_id The host ID.
+ * @param service_id The service ID.
+ */
+void stream::_flush_service_status(uint64_t host_id, uint64_t service_id) {
+  auto found = _pending_service_statuses.find({host_id, service_id});
+  if (found != _pending_service_statuses.end()) {
+    _store_pb_service_status(
+        static_cast<const neb::pb_service_status*>(found->second.get())
+            ->obj());
+    _pending_service_statuses.erase(found);
+    _send_service_status_binds();
+  }
+}
+
+/**
+ * @brief Write all the pending service statuses before a query that updates
+ * the services or resources tables. Binding them is not enough: the bulk
+ * statements would be sent later, after this query.
+ */
+void stream::_write_service_statuses() {
+  if (_pending_service_statuses.empty())
+    return;
+  _flush_service_statuses();
+  _send_service_status_binds();
+}
+
+/**
+ * @brief Send now the service status rows bound to the bulk statements,
+ * _check_queues() would send them later. Timers are stopped meanwhile, so
+ * _check_queues() cannot send the same binds.
+ */
+void stream::_send_service_status_binds() {
+  if (!_bulk_prepared_statement)
+    return;
+  absl::MutexLock lck(&_barrier_timer_m);
+  if (_store_in_hosts_services && _sscr_bind) {
+    for (uint32_t conn = 0; conn < _sscr_bind->connections_count(); conn++) {
+      if (_sscr_bind->size(conn)) {
+        _sscr_bind->apply_to_stmt(conn);
+        _mysql.run_statement(*_sscr_update,
+                             database::mysql_error::store_service_status,
+                             conn);
+        _add_action(conn, actions::services);
+      }
+    }
+  }
+  if (_store_in_resources && _sscr_resources_bind) {
+    for (uint32_t conn = 0; conn < _sscr_resources_bind->connections_count();
+         conn++) {
+      if (_sscr_resources_bind->size(conn)) {
+        _sscr_resources_bind->apply_to_stmt(conn);
+        _mysql.run_statement(*_sscr_resources_update,
+                             database::mysql_error::store_service_status,
+                             conn);
+        _add_action(conn, actions::resources);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Bind a service status to the services and resources statements.
+ *
+ * @param sscr The service status.
+ */
+void stream::_store_pb_service_status(const ServiceStatus& sscr) {
+  // Processing.
+  if (_store_in_hosts_services) {
+    int32_t conn = _mysql.choose_connection_by_instance(
+        _cache_host_instance[static_cast<uint32_t>(sscr.host_id())]);
+    if (_bulk_prepared_statement) {
+      std::lock_guard<bulk_bind> lck(*_sscr_bind);
+      if (!_sscr_bind->bind(conn))
+        _sscr_bind->init_from_stmt(conn);
+      auto* b = _sscr_bind->bind(conn).get();
+      b->set_value_as_bool(0, sscr.checked());
+      b->set_value_as_i32(1, sscr.check_type());
+      b->set_value_as_i32(2, sscr.state());
+      b->set_value_as_i32(3, sscr.state_type());
+      b->set_value_as_i64(4, sscr.last_state_change(),
+                          mapping::entry::invalid_on_zero);
+      b->set_value_as_i32(5, sscr.last_hard_state());
+      b->set_value_as_i64(6, sscr.last_hard_state_change(),
+                          mapping::entry::invalid_on_zero);
+      b->set_value_as_i64(7, sscr.last_time_ok(),
+                          mapping::entry::invalid_on_zero);
+      b->set_value_as_i64(8, sscr.last_time_warning(),
+                          mapping::entry::invalid_on_zero);
+      b->set_value_as_i64(9, sscr.last_time_critical(),
+                          mapping::entry::invalid_on_zero);
+      b->set_value_as_i64(10, sscr.last_time_unknown(),
+                          mapping::entry::invalid_on_zero);
+      std::string full_output{
+          fmt::format("{}\n{}", sscr.output(), sscr.long_output())};
+      size_t size = common::adjust_size_utf8(
+          full_output, get_centreon_storage_services_col_size(
+                           centreon_storage_services_output));
+      b->set_value_as_str(11, fmt::string_view(full_output.data(), size));
+      size = common::adjust_size_utf8(
+          sscr.perfdata(), get_centreon_storage_services_col_size(
+                               centreon_storage_services_perfdata));
+      b->set_value_as_str(12, fmt::string_view(sscr.perfdata().data(), size));
+      b->set_value_as_bool(13, sscr.flapping());
+      b->set_value_as_f64(14, sscr.percent_state_change());
+      b->set_value_as_f64(15, sscr.latency());
+      b->set_value_as_f64(16, sscr.execution_time());
+      if (sscr.last_check() == 0)
+        b->set_null_i64(17);
+      else
+        b->set_value_as_i64(17, sscr.last_check());
+      b->set_value_as_i64(18, sscr.next_check());
+      b->set_value_as_bool(19, sscr.should_be_scheduled());
+      b->set_value_as_i32(20, sscr.check_attempt());
+      b->set_value_as_i32(21, sscr.notification_number());
+      b->set_value_as_bool(22, sscr.no_more_notifications());
+      b->set_value_as_i64(23, sscr.last_notification(),
+                          mapping::entry::invalid_on_zero);
+      b->set_value_as_i64(24, sscr.next_notification(),
+                          mapping::entry::invalid_on_zero);
+      b->set_value_as_bool(25, sscr.acknowledgement_type() != AckType::NONE);
+      b->set_value_as_i32(26, sscr.acknowledgement_type());
+      _logger_sql->debug("service3 ({}, {}) scheduled_downtime_depth: {}",
+                         sscr.host_id(), sscr.service_id(),
+                         sscr.scheduled_downtime_depth());
+      b->set_value_as_i32(27, sscr.scheduled_downtime_depth());
+      b->set_value_as_i32(28, sscr.host_id());
+      b->set_value_as_i32(29, sscr.service_id());
+      b->next_row();
+      SPDLOG_LOGGER_TRACE(_logger_sql,
+                          "{} waiting updates for service status in services",
+                          b->current_row());
+    } else {
+      _sscr_update->bind_value_as_bool(0, sscr.checked());
+      _sscr_update->bind_value_as_i32(1, sscr.check_type());
+      _sscr_update->bind_value_as_i32(2, sscr.state());
+      _sscr_update->bind_value_as_i32(3, sscr.state_type());
+      _sscr_update->bind_value_as_i64_ext(4, sscr.last_state_change(),
+                                          mapping::entry::invalid_on_zero);
+      _sscr_update->bind_value_as_i32(5, sscr.last_hard_state());
+      _sscr_update->bind_value_as_i64_ext(6, sscr.last_hard_state_change(),
+                                          mapping::entry::invalid_on_zero);
+      _sscr_update->bind_value_as_i64_ext(7, sscr.last_time_ok(),
+                                          mapping::entry::invalid_on_zero);
+      _sscr_update->bind_value_as_i64_ext(8, sscr.last_time_warning(),
+                                          mapping::entry::invalid_on_zero);
+      _sscr_update->bind_value_as_i64_ext(9, sscr.last_time_critical(),
+                                          mapping::entry::invalid_on_zero);
+      _sscr_update->bind_value_as_i64_ext(10, sscr.last_time_unknown(),
+                                          mapping::entry::invalid_on_zero);
+      std::string full_output{
+          fmt::format("{}\n{}", sscr.output(), sscr.long_output())};
+      size_t size = common::adjust_size_utf8(
+          full_output, get_centreon_storage_services_col_size(
+                           centreon_storage_services_output));
+      _sscr_update->bind_value_as_str(
+          11, fmt::string_view(full_output.data(), size));
+      size = common::adjust_size_utf8(
+          sscr.perfdata(), get_centreon_storage_services_col_size(
+                               centreon_storage_services_perfdata));
+      _sscr_update->bind_value_as_str(
+          12, fmt::string_view(sscr.perfdata().data(), size));
+      _sscr_update->bind_value_as_bool(13, sscr.flapping());
+      _sscr_update->bind_value_as_f64(14, sscr.percent_state_change());
+      _sscr_update->bind_value_as_f64(15, sscr.latency());
+      _sscr_update->bind_value_as_f64(16, sscr.execution_time());
+      _sscr_update->bind_value_as_i64_ext(17, sscr.last_check(),
+                                          mapping::entry::invalid_on_zero);
+      _sscr_update->bind_value_as_i64(18, sscr.next_check());
+      _sscr_update->bind_value_as_bool(19, sscr.should_be_scheduled());
+      _sscr_update->bind_value_as_i32(20, sscr.check_attempt());
+      _sscr_update->bind_value_as_u64(21, sscr.notification_number());
+      _sscr_update->bind_value_as_bool(22, sscr.no_more_notifications());
+      _sscr_update->bind_value_as_i64_ext(23, sscr.last_notification(),
+                                          mapping::entry::invalid_on_zero);
+      _sscr_update->bind_value_as_i64_ext(24, sscr.next_notification(),
+                                          mapping::entry::invalid_on_zero);
+      _sscr_update->bind_value_as_bool(
+          25, sscr.acknowledgement_type() != AckType::NONE);
+      _sscr_update->bind_value_as_i32(26, sscr.acknowledgement_type());
+      _logger_sql->debug("service4 ({}, {}) scheduled_downtime_depth: {}",
+                         sscr.host_id(), sscr.service_id(),
+                         sscr.scheduled_downtime_depth());
+      _sscr_update->bind_value_as_i32(27, sscr.scheduled_downtime_depth());
+      _sscr_update->bind_value_as_i32(28, sscr.host_id());
+      _sscr_update->bind_value_as_i32(29, sscr.service_id());
+
+      _mysql.run_statement(*_sscr_update,
+                           database::mysql_error::store_service_status, conn);
+
+      _add_action(conn, actions::services);
+    }
+  }
+
+  if (_store_in_resources) {
+    int32_t conn = _mysql.choose_connection_by_instance(
+        _cache_host_instance[static_cast<uint32_t>(sscr.host_id())]);
+    size_t output_size = common::adjust_size_utf8(
+        sscr.output(), get_centreon_storage_resources_col_size(
+                           centreon_storage_resources_output));
+    _logger_sql->debug(
+        "unified_sql: pb service status ({}, {}) {} in resources",
+        sscr.host_id(), sscr.service_id(), sscr.state());
+    if (_bulk_prepared_statement) {
+      _logger_sql->debug(
+          "unified_sql: BULK pb service status ({}, {}) {} in resources",
+          sscr.host_id(), sscr.service_id(), sscr.state());
+      std::lock_guard<bulk_bind> lck(*_sscr_resources_bind);
+      if (!_sscr_resources_bind->bind(conn))
+        _sscr_resources_bind->init_from_stmt(conn);
+      auto* b = _sscr_resources_bind->bind(conn).get();
+      b->set_value_as_i32(0, sscr.state());
+      b->set_value_as_i32(1, svc_ordered_status[sscr.state()]);
+      b->set_value_as_u64(2, sscr.last_state_change(),
+                          mapping::entry::invalid_on_zero);
+      _logger_sql->debug("service5 ({}, {}) scheduled_downtime_depth: {}",
+                         sscr.host_id(), sscr.service_id(),
+                         sscr.scheduled_downtime_depth());
+      b->set_value_as_bool(3, sscr.scheduled_downtime_depth() > 0);
+      b->set_value_as_bool(4, sscr.acknowledgement_type() != AckType::NONE);
+      b->set_value_as_bool(5,
+                           sscr.state_type() == ServiceStatus_StateType_HARD);
+      b->set_value_as_u32(6, sscr.check_attempt());
+      b->set_value_as_bool(7, sscr.perfdata() != "");
+      b->set_value_as_u32(8, sscr.check_type());
+      if (sscr.last_check() == 0)
+        b->set_null_u64(9);
+      else
+        b->set_value_as_u64(9, sscr.last_check());
+      b->set_value_as_str(
+          10, fmt::string_view(sscr.output().c_str(), output_size));
+      b->set_value_as_bool(11, sscr.flapping());
+      b->set_value_as_f64(12, sscr.percent_state_change());
+      b->set_value_as_u64(13, sscr.service_id());
+      b->set_value_as_u64(14, sscr.host_id());
+      b->next_row();
+      SPDLOG_LOGGER_TRACE(
+          _logger_sql, "{} waiting updates for service status in resources",
+          b->current_row());
+    } else {
+      _logger_sql->debug(
+          "unified_sql: NOT BULK pb service status ({}, {}) {} in "
+          "resources",
+          sscr.host_id(), sscr.service_id(), sscr.state());
+      _sscr_resources_update->bind_value_as_i32(0, sscr.state());
+      _sscr_resources_update->bind_value_as_i32(
+          1, svc_ordered_status[sscr.state()]);
+      _sscr_resources_update->bind_value_as_u64_ext(
+          2, sscr.last_state_change(), mapping::entry::invalid_on_zero);
+      _logger_sql->debug("service6 ({}, {}) scheduled_downtime_depth: {}",
+                         sscr.host_id(), sscr.service_id(),
+                         sscr.scheduled_downtime_depth());
+      _sscr_resources_update->bind_value_as_bool(
+          3, sscr.scheduled_downtime_depth() > 0);
+      _sscr_resources_update->bind_value_as_bool(
+          4, sscr.acknowledgement_type() != AckType::NONE);
+      _sscr_resources_update->bind_value_as_bool(
+          5, sscr.state_type() == ServiceStatus_StateType_HARD);
+      _sscr_resources_update->bind_value_as_u32(6, sscr.check_attempt());
+      _sscr_resources_update->bind_value_as_bool(7, sscr.perfdata() != "");
+      _sscr_resources_update->bind_value_as_u32(8, sscr.check_type());
+      _sscr_resources_update->bind_value_as_u64_ext(
+          9, sscr.last_check(), mapping::entry::invalid_on_zero);
+      _sscr_resources_update->bind_value_as_str(
+          10, fmt::string_view(sscr.output().c_str(), output_size));
+      _sscr_resources_update->bind_value_as_bool(11, sscr.flapping());
+      _sscr_resources_update->bind_value_as_f64(12,
+                                                sscr.percent_state_change());
+      _sscr_resources_update->bind_value_as_u64(13, sscr.service_id());
+      _sscr_resources_update->bind_value_as_u64(14, sscr.host_id());
+
+      _mysql.run_statement(*_sscr_resources_update,
+                           database::mysql_error::store_service_status, conn);
+      _add_action(conn, actions::resources);
+    }
+  }
+}
+
 /**
  * @brief Process an adaptive service status event.
  *
@@ -4714,6 +4830,9 @@ void stream::_process_pb_adaptive_service_status(
     return;
   }
 
+  /* The pending status of the service must not overwrite this one. */
+  _flush_service_status(sscr.host_id(), sscr.service_id());
+
   int32_t conn = _mysql.choose_connection_by_instance(
       _cache_host_instance[sscr.host_id()]);
 
@@ -16,6 +16,7 @@
  * For more information : contact@centreon.com
  */
 
+#include <absl/container/btree_map.h>
 #include <absl/synchronization/mutex.h>
 
 #include <cfloat>
@@ -97,8 +98,6 @@ void stream::_unified_sql_process_pb_service_status(
                                  service_id);
   }
   uint32_t rrd_len;
-  int32_t conn =
-      _mysql.choose_connection_by_instance(_cache_host_instance[host_id]);
   bool index_locked{false};
 
   /* Index does not exist */
@@ -134,248 +133,376 @@ void stream::_unified_sql_process_pb_service_status(
     }
 
     if (!ss.perfdata().empty()) {
-      /* Statements preparations */
-      if (!_metrics_insert.prepared()) {
-        _metrics_insert = _mysql.prepare_query(
-            "INSERT INTO metrics "
-            "(index_id,metric_name,unit_name,warn,warn_low,"
-            "warn_threshold_mode,crit,"
-            "crit_low,crit_threshold_mode,min,max,current_value,"
-            "data_source_type) VALUES (?,?,?,?,?,?,?,?,?,?,?,?,?)");
-      }
-
       /* Parse perfdata. */
       _finish_action(-1, actions::metrics);
       std::list<common::perfdata> pds{common::perfdata::parse_perfdata(
           ss.host_id(), ss.service_id(), ss.perfdata().c_str(), _logger_sto)};
-
-      std::deque<std::shared_ptr<io::data>> to_publish;
       for (auto& pd : pds) {
-        misc::read_lock rlck(_metric_cache_m);
         pd.resize_name(common::adjust_size_utf8(
             pd.name(), get_centreon_storage_metrics_col_size(
                            centreon_storage_metrics_metric_name)));
         pd.resize_unit(common::adjust_size_utf8(
             pd.unit(), get_centreon_storage_metrics_col_size(
                            centreon_storage_metrics_unit_name)));
+      }
 
-        auto it_index_cache = _metric_cache.find({index_id, pd.name()});
-
-        /* The cache does not contain this metric */
-        uint32_t metric_id;
-        bool need_metric_mapping = true;
-        if (it_index_cache == _metric_cache.end()) {
-          rlck.unlock();
-          SPDLOG_LOGGER_DEBUG(
-              _logger_sto,
-              "unified sql: no metrics corresponding to index {} and "
-              "perfdata '{}' found in cache",
-              index_id, pd.name());
-          /* Let's insert it */
-          _metrics_insert.bind_value_as_u64(0, index_id);
-          _metrics_insert.bind_value_as_str(1, pd.name());
-          _metrics_insert.bind_value_as_str(2, pd.unit());
-          _metrics_insert.bind_value_as_f32(3, pd.warning());
-          _metrics_insert.bind_value_as_f32(4, pd.warning_low());
-          _metrics_insert.bind_value_as_tiny(5, pd.warning_mode());
-          _metrics_insert.bind_value_as_f32(6, pd.critical());
-          _metrics_insert.bind_value_as_f32(7, pd.critical_low());
-          _metrics_insert.bind_value_as_tiny(8, pd.critical_mode());
-          _metrics_insert.bind_value_as_f32(9, pd.min());
-          _metrics_insert.bind_value_as_f32(10, pd.max());
-          _metrics_insert.bind_value_as_f32(11, pd.value());
-
-          uint32_t type = pd.value_type();
-          char t[2];
-          t[0] = '0' + type;
-          t[1] = 0;
-          _metrics_insert.bind_value_as_str(12, t);
-
-          // Execute query.
-          std::promise<int> promise;
-          std::future<int> future = promise.get_future();
-          _mysql.run_statement_and_get_int<int>(
-              _metrics_insert, std::move(promise),
-              database::mysql_task::LAST_INSERT_ID, conn);
-          try {
-            metric_id = future.get();
-
-            // Insert metric in cache.
-            _logger_sto->info(
-                "unified sql: new metric {} for index {} and perfdata "
-                "'{}'",
-                metric_id, index_id, pd.name());
-            metric_info info{.locked = false,
-                             .metric_id = metric_id,
-                             .type = type,
-                             .value = pd.value(),
-                             .unit_name = pd.unit(),
-                             .warn = pd.warning(),
-                             .warn_low = pd.warning_low(),
-                             .warn_mode = pd.warning_mode(),
-                             .crit = pd.critical(),
-                             .crit_low = pd.critical_low(),
-                             .crit_mode = pd.critical_mode(),
-                             .min = pd.min(),
-                             .max = pd.max(),
-                             .metric_mapping_sent =
-                                 true};  // It will be done after this block
-
-            std::lock_guard<misc::shared_mutex> lock(_metric_cache_m);
-            _metric_cache[{index_id, pd.name()}] = info;
-          } catch (std::exception const& e) {
-            _logger_sto->error(
-                "unified sql: failed to create metric '{}' with type {}, "
-                "value {}, unit_name {}, warn {}, warn_low {}, warn_mode {}, "
-                "crit {}, crit_low {}, crit_mode {}, min {} and max {}",
-                pd.name(), type, pd.value(), pd.unit(), pd.warning(),
-                pd.warning_low(), pd.warning_mode(), pd.critical(),
-                pd.critical_low(), pd.critical_mode(), pd.min(), pd.max());
-
-            // The metric creation failed, we pass to the next metric.
-            continue;
-          }
-        } else {
-          rlck.unlock();
-          std::lock_guard<misc::shared_mutex> lock(_metric_cache_m);
-          /* We have the metric in the cache */
-          metric_id = it_index_cache->second.metric_id;
-          if (!it_index_cache->second.metric_mapping_sent)
-            it_index_cache->second.metric_mapping_sent = true;
-          else
-            need_metric_mapping = false;
-
-          pd.value_type(static_cast<common::perfdata::data_type>(
-              it_index_cache->second.type));
+      if (!_process_pb_perfdata(d, pds, false)) {
+        SPDLOG_LOGGER_DEBUG(
+            _logger_sto,
+            "unified sql: host_id:{}, service_id:{} - perfdata parked until "
+            "the IDs of their new metrics are known",
+            host_id, service_id);
+        _parked_indexes.insert(index_id);
+        _parked_perfdata.push_back({d, index_id, std::move(pds), _acks.park()});
+      }
+    }
+  }
+}
 
+/**
+ * @brief Process the data points forwarded by the engine opentelemetry module.
+ * Engine adds host_id and service_id attributes to the resources of known
+ * services, the gauge and sum points of these resources are stored as
+ * metrics of the service, the others are ignored. Points are grouped by
+ * second, each group is processed like the perfdata of a service status
+ * checked at that time, with a state 0. A point without time is stored at
+ * the time the event is received.
+ *
+ * A data point may have the name of a metric of the service perfdata, both
+ * then feed the same metric. RRD refuses a value older than the last one
+ * stored, so a point not newer than the last value of its metric is dropped.
+ *
+ * @param d The pb_otl_metrics event.
+ */
+void stream::_unified_sql_process_pb_otl_metrics(
+    const std::shared_ptr<io::data>& d) {
+  const auto& request = static_cast<const neb::pb_otl_metrics*>(d.get())->obj();
+  const time_t now = time(nullptr);
+  bool action_finished = false;
+  for (const auto& resource : request.resource_metrics()) {
+    uint64_t host_id = 0, service_id = 0;
+    for (const auto& key_val : resource.resource().attributes()) {
+      if (!key_val.value().has_int_value())
+        continue;
+      if (key_val.key() == "host_id")
+        host_id = key_val.value().int_value();
+      else if (key_val.key() == "service_id")
+        service_id = key_val.value().int_value();
+    }
+    if (!host_id || !service_id)
+      continue;
+    auto it_index_cache = _index_cache.find({host_id, service_id});
+    if (it_index_cache == _index_cache.end() ||
+        !it_index_cache->second.index_id) {
+      SPDLOG_LOGGER_DEBUG(
+          _logger_sto,
+          "unified sql: no index for service ({}, {}), its data points are "
+          "not stored",
+          host_id, service_id);
+      continue;
+    }
+    uint64_t index_id = it_index_cache->second.index_id;
+
+    /* The last value of a metric is kept for each second. */
+    absl::btree_map<time_t, absl::flat_hash_map<std::string, common::perfdata>>
+        by_time;
+    auto add_point = [&](const ::opentelemetry::proto::metrics::v1::Metric& m,
+                         const ::opentelemetry::proto::metrics::v1::
+                             NumberDataPoint& data_pt,
+                         common::perfdata::data_type type) {
+      time_t point_time = data_pt.time_unix_nano()
+                              ? data_pt.time_unix_nano() / 1000000000
+                              : now;
+      common::perfdata pd;
+      pd.name(m.name());
+      pd.unit(std::string(m.unit()));
+      pd.resize_name(common::adjust_size_utf8(
+          pd.name(), get_centreon_storage_metrics_col_size(
+                         centreon_storage_metrics_metric_name)));
+      pd.resize_unit(common::adjust_size_utf8(
+          pd.unit(), get_centreon_storage_metrics_col_size(
+                         centreon_storage_metrics_unit_name)));
+      {
+        misc::read_lock rlck(_metric_cache_m);
+        auto found = _metric_cache.find(index_metric_view(index_id, pd.name()));
+        if (found != _metric_cache.end() &&
+            point_time <= found->second.last_time) {
           SPDLOG_LOGGER_DEBUG(
               _logger_sto,
-              "unified sql: metric {} concerning index {}, perfdata "
-              "'{}' found in cache",
-              it_index_cache->second.metric_id, index_id, pd.name());
-          // Should we update metrics ?
-          if (!check_equality(it_index_cache->second.value, pd.value()) ||
-              it_index_cache->second.unit_name != pd.unit() ||
-              !check_equality(it_index_cache->second.warn, pd.warning()) ||
-              !check_equality(it_index_cache->second.warn_low,
-                              pd.warning_low()) ||
-              it_index_cache->second.warn_mode != pd.warning_mode() ||
-              !check_equality(it_index_cache->second.crit, pd.critical()) ||
-              !check_equality(it_index_cache->second.crit_low,
-                              pd.critical_low()) ||
-              it_index_cache->second.crit_mode != pd.critical_mode() ||
-              !check_equality(it_index_cache->second.min, pd.min()) ||
-              !check_equality(it_index_cache->second.max, pd.max())) {
-            _logger_sto->info(
-                "unified sql: updating metric {} of index {}, perfdata "
-                "'{}' with unit: {}, warning: {}:{}, critical: {}:{}, min: "
-                "{}, max: {}",
-                it_index_cache->second.metric_id, index_id, pd.name(),
-                pd.unit(), pd.warning_low(), pd.warning(), pd.critical_low(),
-                pd.critical(), pd.min(), pd.max());
-            // Update metrics table.
-            it_index_cache->second.unit_name = pd.unit();
-            it_index_cache->second.value = pd.value();
-            it_index_cache->second.warn = pd.warning();
-            it_index_cache->second.warn_low = pd.warning_low();
-            it_index_cache->second.crit = pd.critical();
-            it_index_cache->second.crit_low = pd.critical_low();
-            it_index_cache->second.warn_mode = pd.warning_mode();
-            it_index_cache->second.crit_mode = pd.critical_mode();
-            it_index_cache->second.min = pd.min();
-            it_index_cache->second.max = pd.max();
-            {
-              std::lock_guard<std::mutex> lck(_queues_m);
-              _metrics[it_index_cache->second.metric_id] =
-                  it_index_cache->second;
-            }
-            SPDLOG_LOGGER_DEBUG(_logger_sto, "new metric with metric_id={}",
-                                it_index_cache->second.metric_id);
-          }
+              "unified sql: data point of metric '{}' of service ({}, {}) at "
+              "{} is not newer than its last value, it is dropped",
+              pd.name(), host_id, service_id, point_time);
+          return;
         }
-        if (cache_ptr) {
-          cache_ptr->set_metric_info(metric_id, index_id, pd.name(), pd.unit(),
-                                     pd.min(), pd.max());
-        }
-        if (need_metric_mapping) {
-          auto mm{std::make_shared<storage::pb_metric_mapping>()};
-          auto& mm_obj = mm->mut_obj();
-          mm_obj.set_index_id(index_id);
-          mm_obj.set_metric_id(metric_id);
-          to_publish.emplace_back(std::move(mm));
+      }
+      pd.value(data_pt.has_as_int() ? data_pt.as_int() : data_pt.as_double());
+      pd.value_type(type);
+      auto& same_time = by_time[point_time];
+      std::string name = pd.name();
+      same_time.insert_or_assign(std::move(name), std::move(pd));
+    };
+    for (const auto& scope : resource.scope_metrics()) {
+      for (const auto& m : scope.metrics()) {
+        if (m.has_gauge()) {
+          for (const auto& data_pt : m.gauge().data_points())
+            add_point(m, data_pt, common::perfdata::gauge);
+        } else if (m.has_sum()) {
+          common::perfdata::data_type type = m.sum().is_monotonic()
+                                                 ? common::perfdata::counter
+                                                 : common::perfdata::gauge;
+          for (const auto& data_pt : m.sum().data_points())
+            add_point(m, data_pt, type);
         }
+      }
+    }
 
-        if (_store_in_db) {
-          // Append perfdata to queue.
-          if (_perfdata_query->is_bulk()) {
-            auto binder = [&](database::mysql_bulk_bind& b) {
-              b.set_value_as_i32(0, metric_id);
-              b.set_value_as_i32(1, ss.last_check());
-              char state[2];
-              state[0] = '0' + ss.state();
-              state[1] = 0;
-              b.set_value_as_str(2, state);
-              if (std::isinf(pd.value()))
-                b.set_value_as_f32(3, pd.value() < 0.0 ? -FLT_MAX : FLT_MAX);
-              else if (std::isnan(pd.value()))
-                b.set_null_f32(3);
-              else
-                b.set_value_as_f32(3, pd.value());
-              SPDLOG_LOGGER_TRACE(
-                  _logger_sql,
-                  "New value {} inserted on metric {} with state {}",
-                  pd.value(), metric_id, ss.state());
-              b.next_row();
-            };
-            _perfdata_query->add_bulk_row(binder);
-          } else {
-            std::string row;
-            if (std::isinf(pd.value()))
-              row = fmt::format("({},{},'{}',{})", metric_id, ss.last_check(),
-                                static_cast<uint32_t>(ss.state()),
-                                pd.value() < 0.0 ? -FLT_MAX : FLT_MAX);
-            else if (std::isnan(pd.value()))
-              row = fmt::format("({},{},'{}',NULL)", metric_id, ss.last_check(),
-                                ss.state());
-            else
-              row = fmt::format("({},{},'{}',{})", metric_id, ss.last_check(),
-                                ss.state(), pd.value());
-            _perfdata_query->add_multi_row(row);
-          }
+    if (!by_time.empty() && !action_finished) {
+      _finish_action(-1, actions::metrics);
+      action_finished = true;
+    }
+    for (auto& [check_time, metrics] : by_time) {
+      auto status = std::make_shared<neb::pb_service_status>();
+      auto& ss = status->mut_obj();
+      ss.set_host_id(host_id);
+      ss.set_service_id(service_id);
+      ss.set_last_check(check_time);
+      std::list<common::perfdata> pds;
+      for (auto& name_pd : metrics)
+        pds.push_back(std::move(name_pd.second));
+      if (!_process_pb_perfdata(status, pds, false)) {
+        SPDLOG_LOGGER_DEBUG(
+            _logger_sto,
+            "unified sql: host_id:{}, service_id:{} - data points parked "
+            "until the IDs of their new metrics are known",
+            host_id, service_id);
+        _parked_indexes.insert(index_id);
+        _parked_perfdata.push_back(
+            {status, index_id, std::move(pds), _acks.park()});
+      }
+    }
+  }
+}
+
+/**
+ * @brief Process the perfdata of a service status: metrics cache, data_bin
+ * and metric events. If some of its metrics have no ID yet, nothing is done,
+ * their creation is queued and false is returned so that the event is parked.
+ *
+ * @param d The pb_service_status.
+ * @param pds Its parsed perfdata.
+ * @param retry True if the event was parked. Its metrics have already been
+ * queued, so those still unknown could not be created and are skipped.
+ *
+ * @return True if the perfdata have been processed.
+ */
+bool stream::_process_pb_perfdata(const std::shared_ptr<io::data>& d,
+                                  std::list<common::perfdata>& pds,
+                                  bool retry) {
+  auto& ss = static_cast<const neb::pb_service_status*>(d.get())->obj();
+  uint64_t host_id = ss.host_id(), service_id = ss.service_id();
+  auto it_index = _index_cache.find({host_id, service_id});
+  if (it_index == _index_cache.end()) {
+    _logger_sto->error(
+        "unified sql: index of service ({}, {}) not found, its perfdata are "
+        "lost",
+        host_id, service_id);
+    return true;
+  }
+  uint64_t index_id = it_index->second.index_id;
+  uint32_t rrd_len = it_index->second.rrd_retention;
+  bool index_locked = it_index->second.locked;
+  uint32_t interval = it_index->second.interval * _interval_length;
+
+  /* The event must wait for its metrics and for the events of the same
+   * service already parked. */
+  bool park = !retry && _parked_indexes.contains(index_id);
+  {
+    misc::read_lock rlck(_metric_cache_m);
+    for (auto& pd : pds) {
+      index_metric_view key{index_id, pd.name()};
+      if (_metric_cache.contains(key))
+        continue;
+      if (_metric_in_creation(key))
+        park = true;
+      else if (!retry) {
+        SPDLOG_LOGGER_DEBUG(
+            _logger_sto,
+            "unified sql: no metrics corresponding to index {} and "
+            "perfdata '{}' found in cache",
+            index_id, pd.name());
+        _metrics_to_create.emplace(index_metric(index_id, pd.name()), pd);
+        park = true;
+      }
+    }
+  }
+  if (park)
+    return false;
+
+  auto cache_ptr = cache::global_cache::instance_ptr();
+  std::deque<std::shared_ptr<io::data>> to_publish;
+  for (auto& pd : pds) {
+    misc::read_lock rlck(_metric_cache_m);
+    auto it_index_cache =
+        _metric_cache.find(index_metric_view(index_id, pd.name()));
+
+    /* The cache does not contain this metric */
+    uint32_t metric_id;
+    bool need_metric_mapping = true;
+    if (it_index_cache == _metric_cache.end()) {
+      rlck.unlock();
+      _logger_sto->error(
+          "unified sql: failed to create metric '{}' with type {}, "
+          "value {}, unit_name {}, warn {}, warn_low {}, warn_mode {}, "
+          "crit {}, crit_low {}, crit_mode {}, min {} and max {}",
+          pd.name(), static_cast<uint32_t>(pd.value_type()), pd.value(),
+          pd.unit(), pd.warning(), pd.warning_low(), pd.warning_mode(),
+          pd.critical(), pd.critical_low(), pd.critical_mode(), pd.min(),
+          pd.max());
+
+      // The metric creation failed, we pass to the next metric.
+      continue;
+    } else {
+      rlck.unlock();
+      std::lock_guard<misc::shared_mutex> lock(_metric_cache_m);
+      /* We have the metric in the cache */
+      metric_id = it_index_cache->second.metric_id;
+      if (!it_index_cache->second.metric_mapping_sent)
+        it_index_cache->second.metric_mapping_sent = true;
+      else
+        need_metric_mapping = false;
+      if (ss.last_check() > it_index_cache->second.last_time)
+        it_index_cache->second.last_time = ss.last_check();
+
+      pd.value_type(static_cast<common::perfdata::data_type>(
+          it_index_cache->second.type));
+
+      SPDLOG_LOGGER_DEBUG(
+          _logger_sto,
+          "unified sql: metric {} concerning index {}, perfdata "
+          "'{}' found in cache",
+          it_index_cache->second.metric_id, index_id, pd.name());
+      // Should we update metrics ?
+      if (!check_equality(it_index_cache->second.value, pd.value()) ||
+          it_index_cache->second.unit_name != pd.unit() ||
+          !check_equality(it_index_cache->second.warn, pd.warning()) ||
+          !check_equality(it_index_cache->second.warn_low,
+                          pd.warning_low()) ||
+          it_index_cache->second.warn_mode != pd.warning_mode() ||
+          !check_equality(it_index_cache->second.crit, pd.critical()) ||
+          !check_equality(it_index_cache->second.crit_low,
+                          pd.critical_low()) ||
+          it_index_cache->second.crit_mode != pd.critical_mode() ||
+          !check_equality(it_index_cache->second.min, pd.min()) ||
+          !check_equality(it_index_cache->second.max, pd.max())) {
+        _logger_sto->info(
+            "unified sql: updating metric {} of index {}, perfdata "
+            "'{}' with unit: {}, warning: {}:{}, critical: {}:{}, min: "
+            "{}, max: {}",
+            it_index_cache->second.metric_id, index_id, pd.name(),
+            pd.unit(), pd.warning_low(), pd.warning(), pd.critical_low(),
+            pd.critical(), pd.min(), pd.max());
+        // Update metrics table.
+        it_index_cache->second.unit_name = pd.unit();
+        it_index_cache->second.value = pd.value();
+        it_index_cache->second.warn = pd.warning();
+        it_index_cache->second.warn_low = pd.warning_low();
+        it_index_cache->second.crit = pd.critical();
+        it_index_cache->second.crit_low = pd.critical_low();
+        it_index_cache->second.warn_mode = pd.warning_mode();
+        it_index_cache->second.crit_mode = pd.critical_mode();
+        it_index_cache->second.min = pd.min();
+        it_index_cache->second.max = pd.max();
+        {
+          std::lock_guard<std::mutex> lck(_queues_m);
+          _metrics[it_index_cache->second.metric_id] =
+              it_index_cache->second;
         }
+        SPDLOG_LOGGER_DEBUG(_logger_sto, "new metric with metric_id={}",
+                            it_index_cache->second.metric_id);
+      }
+    }
+    if (cache_ptr) {
+      cache_ptr->set_metric_info(metric_id, index_id, pd.name(), pd.unit(),
+                                 pd.min(), pd.max());
+    }
+    if (need_metric_mapping) {
+      auto mm{std::make_shared<storage::pb_metric_mapping>()};
+      auto& mm_obj = mm->mut_obj();
+      mm_obj.set_index_id(index_id);
+      mm_obj.set_metric_id(metric_id);
+      to_publish.emplace_back(std::move(mm));
+    }
 
-        // Send perfdata event to processing.
-        if (!index_locked) {
-          auto perf{std::make_shared<storage::pb_metric>()};
-          auto& m = perf->mut_obj();
-          m.set_time(ss.last_check());
-          m.set_interval(interval);
-          m.set_metric_id(metric_id);
-          m.set_rrd_len(rrd_len);
-          m.set_value(pd.value());
-          m.set_value_type(static_cast<Metric_ValueType>(pd.value_type()));
-          m.set_name(pd.name());
-          m.set_host_id(ss.host_id());
-          m.set_service_id(ss.service_id());
-          SPDLOG_LOGGER_DEBUG(
-              _logger_sto,
-              "unified sql: generating perfdata event for metric {} "
-              "(name '{}', time {}, value {}, rrd_len {}, data_type {})",
-              m.metric_id(), pd.name(), m.time(), m.value(), rrd_len,
-              m.value_type());
-          to_publish.emplace_back(std::move(perf));
-        } else {
+    if (_store_in_db) {
+      // Append perfdata to queue.
+      if (_perfdata_query->is_bulk()) {
+        auto binder = [&](database::mysql_bulk_bind& b) {
+          b.set_value_as_i32(0, metric_id);
+          b.set_value_as_i32(1, ss.last_check());
+          char state[2];
+          state[0] = '0' + ss.state();
+          state[1] = 0;
+          b.set_value_as_str(2, state);
+          if (std::isinf(pd.value()))
+            b.set_value_as_f32(3, pd.value() < 0.0 ? -FLT_MAX : FLT_MAX);
+          else if (std::isnan(pd.value()))
+            b.set_null_f32(3);
+          else
+            b.set_value_as_f32(3, pd.value());
           SPDLOG_LOGGER_TRACE(
-              _logger_sto,
-              "unified sql: index {} is locked, so metric {} event not sent "
-              "to rrd",
-              index_id, metric_id);
-        }
+              _logger_sql,
+              "New value {} inserted on metric {} with state {}",
+              pd.value(), metric_id, ss.state());
+          b.next_row();
+        };
+        _perfdata_query->add_bulk_row(binder);
+      } else {
+        std::string row;
+        if (std::isinf(pd.value()))
+          row = fmt::format("({},{},'{}',{})", metric_id, ss.last_check(),
+                            static_cast<uint32_t>(ss.state()),
+                            pd.value() < 0.0 ? -FLT_MAX : FLT_MAX);
+        else if (std::isnan(pd.value()))
+          row = fmt::format("({},{},'{}',NULL)", metric_id, ss.last_check(),
+                            ss.state());
+        else
+          row = fmt::format("({},{},'{}',{})", metric_id, ss.last_check(),
+                            ss.state(), pd.value());
+        _perfdata_query->add_multi_row(row);
       }
-      multiplexing::publisher pblshr;
-      pblshr.write(to_publish);
+    }
+
+    // Send perfdata event to processing.
+    if (!index_locked) {
+      auto perf{std::make_shared<storage::pb_metric>()};
+      auto& m = perf->mut_obj();
+      m.set_time(ss.last_check());
+      m.set_interval(interval);
+      m.set_metric_id(metric_id);
+      m.set_rrd_len(rrd_len);
+      m.set_value(pd.value());
+      m.set_value_type(static_cast<Metric_ValueType>(pd.value_type()));
+      m.set_name(pd.name());
+      m.set_host_id(ss.host_id());
+      m.set_service_id(ss.service_id());
+      SPDLOG_LOGGER_DEBUG(
+          _logger_sto,
+          "unified sql: generating perfdata event for metric {} "
+          "(name '{}', time {}, value {}, rrd_len {}, data_type {})",
+          m.metric_id(), pd.name(), m.time(), m.value(), rrd_len,
+          m.value_type());
+      to_publish.emplace_back(std::move(perf));
+    } else {
+      SPDLOG_LOGGER_TRACE(
+          _logger_sto,
+          "unified sql: index {} is locked, so metric {} event not sent "
+          "to rrd",
+          index_id, metric_id);
     }
   }
+  multiplexing::publisher pblshr;
+  pblshr.write(to_publish);
+  return true;
 }
 
 /**
@@ -536,7 +663,8 @@ void stream::_unified_sql_process_service_status(
             pd.unit(), get_centreon_storage_metrics_col_size(
                            centreon_storage_metrics_unit_name)));
 
-        auto it_index_cache = _metric_cache.find({index_id, pd.name()});
+        auto it_index_cache =
+            _metric_cache.find(index_metric_view(index_id, pd.name()));
 
         /* The cache does not contain this metric */
         uint32_t metric_id;
@@ -796,6 +924,172 @@ void stream::_update_metrics() {
   }
 }
 
+/**
+ * @brief Tell if a metric is waiting to be inserted in the database or is
+ * being inserted.
+ *
+ * @param key The index ID and the metric name.
+ *
+ * @return A boolean.
+ */
+bool stream::_metric_in_creation(const index_metric_view& key) const {
+  return _metrics_to_create.contains(key) || _metrics_in_flight.contains(key);
+}
+
+/**
+ * @brief Insert the new metrics in the database with one query and ask for
+ * their IDs on the same connection. Only one such query is executed at a
+ * time, the metrics appearing meanwhile wait for the next one. The IDs are
+ * then read by _check_metric_ids().
+ */
+void stream::_create_metrics() {
+  if (_metrics_to_create.empty() || _metric_ids.valid())
+    return;
+
+  std::swap(_metrics_in_flight, _metrics_to_create);
+  auto value_or_null = [](float v) -> std::string {
+    return std::isnan(v) || std::isinf(v) ? "NULL" : fmt::format("{}", v);
+  };
+  std::vector<std::string> values;
+  std::vector<std::string> keys;
+  values.reserve(_metrics_in_flight.size());
+  keys.reserve(_metrics_in_flight.size());
+  for (auto& [key, pd] : _metrics_in_flight) {
+    std::string name(misc::string::escape(
+        key.second, get_centreon_storage_metrics_col_size(
+                        centreon_storage_metrics_metric_name)));
+    values.emplace_back(fmt::format(
+        "({},'{}','{}',{},{},'{}',{},{},'{}',{},{},{},'{}')", key.first, name,
+        misc::string::escape(pd.unit(),
+                             get_centreon_storage_metrics_col_size(
+                                 centreon_storage_metrics_unit_name)),
+        value_or_null(pd.warning()), value_or_null(pd.warning_low()),
+        pd.warning_mode() ? 1 : 0, value_or_null(pd.critical()),
+        value_or_null(pd.critical_low()), pd.critical_mode() ? 1 : 0,
+        value_or_null(pd.min()), value_or_null(pd.max()),
+        value_or_null(pd.value()), static_cast<uint32_t>(pd.value_type())));
+    keys.emplace_back(fmt::format("({},'{}')", key.first, name));
+  }
+
+  std::string query(fmt::format(
+      "INSERT INTO metrics (index_id,metric_name,unit_name,warn,warn_low,"
+      "warn_threshold_mode,crit,crit_low,crit_threshold_mode,min,max,"
+      "current_value,data_source_type) VALUES {} ON DUPLICATE KEY UPDATE "
+      "unit_name=VALUES(unit_name), warn=VALUES(warn), "
+      "warn_low=VALUES(warn_low), "
+      "warn_threshold_mode=VALUES(warn_threshold_mode), crit=VALUES(crit), "
+      "crit_low=VALUES(crit_low), "
+      "crit_threshold_mode=VALUES(crit_threshold_mode), min=VALUES(min), "
+      "max=VALUES(max), current_value=VALUES(current_value)",
+      fmt::join(values, ",")));
+  int32_t conn = _mysql.choose_best_connection(-1);
+  _logger_sto->info("unified sql: creating {} new metrics",
+                    _metrics_in_flight.size());
+  SPDLOG_LOGGER_TRACE(_logger_sql, "Send query: {}", query);
+  _mysql.run_query(query, database::mysql_error::insert_metrics, conn);
+  _add_action(conn, actions::metrics);
+
+  /* Queries on a connection are executed in order, so this one sees the
+   * inserted metrics. */
+  std::promise<database::mysql_result> promise;
+  _metric_ids = promise.get_future();
+  _mysql.run_query_and_get_result(
+      fmt::format("SELECT metric_id,index_id,metric_name FROM metrics WHERE "
+                  "(index_id,metric_name) IN ({})",
+                  fmt::join(keys, ",")),
+      std::move(promise), conn);
+}
+
+/**
+ * @brief Read the IDs of the last created metrics if they are available, add
+ * these metrics to the cache and process the parked service statuses.
+ *
+ * @param wait If true, wait for the IDs instead of returning if they are not
+ * available yet.
+ */
+void stream::_check_metric_ids(bool wait) {
+  if (_metric_ids.valid()) {
+    if (!wait && _metric_ids.wait_for(std::chrono::seconds(0)) !=
+                     std::future_status::ready)
+      return;
+
+    try {
+      database::mysql_result res{_metric_ids.get()};
+      std::lock_guard<misc::shared_mutex> lock(_metric_cache_m);
+      while (_mysql.fetch_row(res)) {
+        uint32_t metric_id = res.value_as_u32(0);
+        uint64_t index_id = res.value_as_u64(1);
+        std::string metric_name = res.value_as_str(2);
+        auto it = _metrics_in_flight.find(
+            index_metric_view(index_id, metric_name));
+        if (it == _metrics_in_flight.end())
+          continue;
+
+        const common::perfdata& pd = it->second;
+        _logger_sto->info(
+            "unified sql: new metric {} for index {} and perfdata '{}'",
+            metric_id, index_id, pd.name());
+        /* The metric mapping is sent with the first perfdata of the
+         * metric. */
+        _metric_cache[it->first] = metric_info{
+            .locked = false,
+            .metric_id = metric_id,
+            .type = static_cast<uint32_t>(pd.value_type()),
+            .value = pd.value(),
+            .unit_name = pd.unit(),
+            .warn = pd.warning(),
+            .warn_low = pd.warning_low(),
+            .warn_mode = pd.warning_mode(),
+            .crit = pd.critical(),
+            .crit_low = pd.critical_low(),
+            .crit_mode = pd.critical_mode(),
+            .min = pd.min(),
+            .max = pd.max(),
+            .metric_mapping_sent = false};
+        _metrics_in_flight.erase(it);
+      }
+    } catch (const std::exception& e) {
+      _logger_sto->error(
+          "unified sql: could not get the IDs of {} new metrics: {}",
+          _metrics_in_flight.size(), e.what());
+    }
+    /* Metrics still there could not be created. */
+    _metrics_in_flight.clear();
+  } else if (!_metrics_to_create.empty())
+    /* The parked events wait for a query not sent yet. */
+    return;
+
+  if (!_parked_perfdata.empty())
+    _resume_parked_perfdata();
+}
+
+/**
+ * @brief Process again the parked service statuses. Those still waiting for
+ * a metric ID stay parked, and so do the following ones of the same service
+ * to keep their order. The processed events, and those received after them
+ * up to the oldest event still parked, can be acknowledged.
+ */
+void stream::_resume_parked_perfdata() {
+  std::deque<parked_perfdata> parked;
+  std::swap(parked, _parked_perfdata);
+  _parked_indexes.clear();
+  for (auto& p : parked) {
+    if (!_parked_indexes.contains(p.index_id) &&
+        _process_pb_perfdata(p.event, p.pds, true)) {
+      _acks.unpark(p.seq);
+      continue;
+    }
+    _parked_indexes.insert(p.index_id);
+    _parked_perfdata.push_back(std::move(p));
+  }
+  _processed += _acks.pop_acknowledgeable();
+  SPDLOG_LOGGER_DEBUG(_logger_sto,
+                      "unified sql: {} parked perfdata events processed, {} "
+                      "still parked",
+                      parked.size() - _parked_perfdata.size(),
+                      _parked_perfdata.size());
+}
+
 void stream::_check_queues(boost::system::error_code ec) {
   if (ec)
     _logger_sql->error("unified_sql: the queues check encountered an error: {}",
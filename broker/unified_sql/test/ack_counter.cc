@@ -0,0 +1,104 @@
+/**
+ * Copyright 2024 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/broker/unified_sql/ack_counter.hh"
+
+#include <gtest/gtest.h>
+
+using namespace com::centreon::broker::unified_sql;
+
+// Given events processed without parking
+// Then they are all acknowledgeable, only once.
+TEST(UnifiedSqlAckCounter, NoParking) {
+  ack_counter acks;
+  for (int i = 0; i < 5; ++i)
+    acks.next();
+  ASSERT_EQ(acks.pop_acknowledgeable(), 5u);
+  ASSERT_EQ(acks.pop_acknowledgeable(), 0u);
+}
+
+// Given two processed events, a parked one and a batch of processed ones
+// Then only the events before the parked one are acknowledgeable
+// When the parked event is resumed
+// Then all the events are acknowledgeable.
+TEST(UnifiedSqlAckCounter, ParkBatchResume) {
+  ack_counter acks;
+  acks.next();
+  acks.next();
+  uint64_t parked = acks.park();
+  acks.next();
+  for (int i = 0; i < 10; ++i)
+    acks.next();
+  ASSERT_EQ(acks.parked(), 1u);
+  ASSERT_EQ(acks.pop_acknowledgeable(), 2u);
+  ASSERT_EQ(acks.pop_acknowledgeable(), 0u);
+
+  acks.unpark(parked);
+  ASSERT_EQ(acks.parked(), 0u);
+  ASSERT_EQ(acks.pop_acknowledgeable(), 11u);
+}
+
+// Given two parked events
+// When the newest is resumed first
+// Then nothing is acknowledgeable until the oldest is resumed.
+TEST(UnifiedSqlAckCounter, ResumeOutOfOrder) {
+  ack_counter acks;
+  uint64_t first = acks.park();
+  acks.next();
+  acks.next();
+  uint64_t second = acks.park();
+  acks.next();
+  acks.next();
+
+  acks.unpark(second);
+  ASSERT_EQ(acks.pop_acknowledgeable(), 0u);
+  acks.unpark(first);
+  ASSERT_EQ(acks.pop_acknowledgeable(), 4u);
+}
+
+// Given a parked event resumed while the next event is being processed
+// Then the event being processed is not acknowledgeable yet.
+TEST(UnifiedSqlAckCounter, ResumeDuringWrite) {
+  ack_counter acks;
+  uint64_t parked = acks.park();
+  acks.next();
+  acks.next();
+  // a new event is being processed, the parked one is resumed first
+  acks.unpark(parked);
+  ASSERT_EQ(acks.pop_acknowledgeable(), 2u);
+  acks.next();
+  ASSERT_EQ(acks.pop_acknowledgeable(), 1u);
+}
+
+// Given an event parked twice, once per part of it waiting for a retry
+// When only one part is resumed
+// Then the event stays parked until the other one is resumed.
+TEST(UnifiedSqlAckCounter, ParkedTwice) {
+  ack_counter acks;
+  uint64_t first = acks.park();
+  uint64_t second = acks.park();
+  ASSERT_EQ(first, second);
+  acks.next();
+  ASSERT_EQ(acks.parked(), 2u);
+
+  acks.unpark(first);
+  ASSERT_EQ(acks.parked(), 1u);
+  ASSERT_EQ(acks.pop_acknowledgeable(), 0u);
+  acks.unpark(second);
+  ASSERT_EQ(acks.pop_acknowledgeable(), 1u);
+}
@@ -21,6 +21,7 @@
 
 #include "com/centreon/broker/http_tsdb/http_tsdb_config.hh"
 #include "com/centreon/broker/http_tsdb/line_protocol_query.hh"
+#include "com/centreon/broker/http_tsdb/remote_write.hh"
 #include "com/centreon/broker/http_tsdb/stream.hh"
 
 namespace com::centreon::broker {
@@ -31,10 +32,22 @@ class request : public http_tsdb::request {
   const http_tsdb::line_protocol_query& _metric_formatter;
   const http_tsdb::line_protocol_query& _status_formatter;
 
+  /* Data are encoded with the remote write protocol instead of the line
+   * protocol. */
+  bool _remote_write = false;
+  /* Scratch areas reused from one remote write time series to the next. */
+  http_tsdb::remote_write _series;
+  std::string _tags;
+
   void append_metric_info(const Metric& metric);
 
   void append_status_info(const Status& status);
 
+  void add_remote_write_metric(const storage::pb_metric& metric);
+
+  void add_remote_write_status(const storage::pb_status& status,
+                               int value);
+
  public:
   request(boost::beast::http::verb method,
           const std::string& server_name,
@@ -45,6 +58,8 @@ class request : public http_tsdb::request {
           const http_tsdb::line_protocol_query& status_formatter,
           const std::string& authorization = "");
 
+  void use_remote_write();
+
   virtual void add_metric(const storage::pb_metric& metric) override;
 
   virtual void add_status(const storage::pb_status& status) override;
@@ -63,10 +63,22 @@ request::request(boost::beast::http::verb method,
       _logger{logger},
       _metric_formatter(metric_formatter),
       _status_formatter(status_formatter) {
-  body().reserve(size_to_reserve);
+  content().reserve(size_to_reserve);
   set(boost::beast::http::field::authorization, authorization);
 }
 
+/**
+ * @brief Encode data with the Prometheus remote write protocol, compressed
+ * with snappy, instead of the line protocol. It must be called before any
+ * data is added.
+ * Series are named as VictoriaMetrics names the line protocol ones
+ * (measurement_field), so both formats feed the same series.
+ */
+void request::use_remote_write() {
+  _remote_write = true;
+  set_encoding(encoding::snappy);
+}
+
 static constexpr std::string_view _sz_metric = "metric,id=";
 static constexpr std::string_view _sz_status = "status,id=";
 static constexpr std::string_view _sz_name = ",name=";
@@ -77,17 +89,21 @@ static constexpr std::string_view _sz_severity_id = ",severity_id=";
 static constexpr std::string_view _sz_val = " val=";
 
 void request::add_metric(const storage::pb_metric& metric) {
-  absl::StrAppend(&body(), _sz_metric, metric.obj().metric_id());
-  absl::StrAppend(&body(), _sz_name, string_filter(metric.obj().name()));
-  absl::StrAppend(&body(), _sz_host_id, metric.obj().host_id(), _sz_serv_id,
+  if (_remote_write) {
+    add_remote_write_metric(metric);
+    return;
+  }
+  absl::StrAppend(&content(), _sz_metric, metric.obj().metric_id());
+  absl::StrAppend(&content(), _sz_name, string_filter(metric.obj().name()));
+  absl::StrAppend(&content(), _sz_host_id, metric.obj().host_id(), _sz_serv_id,
                   metric.obj().service_id());
 
   append_metric_info(metric.obj());
-  _metric_formatter.append_metric(metric, body());
-  absl::StrAppend(&body(), _sz_val, metric.obj().value());
-  body().push_back(' ');
-  absl::StrAppend(&body(), metric.obj().time());
-  body().push_back('\n');
+  _metric_formatter.append_metric(metric, content());
+  absl::StrAppend(&content(), _sz_val, metric.obj().value());
+  content().push_back(' ');
+  absl::StrAppend(&content(), metric.obj().time());
+  content().push_back('\n');
   ++_nb_metric;
 }
 
@@ -102,23 +118,27 @@ void request::add_status(const storage::pb_status& status) {
     return;
   }
 
-  absl::StrAppend(&body(), _sz_status, status_obj.index_id());
-  append_status_info(status_obj);
-  _status_formatter.append_status(status, body());
+  int value = 0;
   switch (status_obj.state()) {
     case 0:
-      absl::StrAppend(&body(), _sz_val, 100);
+      value = 100;
       break;
     case 1:
-      absl::StrAppend(&body(), _sz_val, 75);
-      break;
-    case 2:
-      absl::StrAppend(&body(), _sz_val, 0);
+      value = 75;
       break;
   }
-  body().push_back(' ');
-  absl::StrAppend(&body(), status_obj.time());
-  body().push_back('\n');
+  if (_remote_write) {
+    add_remote_write_status(status, value);
+    return;
+  }
+
+  absl::StrAppend(&content(), _sz_status, status_obj.index_id());
+  append_status_info(status_obj);
+  _status_formatter.append_status(status, content());
+  absl::StrAppend(&content(), _sz_val, value);
+  content().push_back(' ');
+  absl::StrAppend(&content(), status_obj.time());
+  content().push_back('\n');
   ++_nb_status;
 }
 
@@ -127,24 +147,77 @@ void request::append_metric_info(const Metric& metric) {
   const cache::metric_info* metric_inf =
       cache::global_cache::instance_ptr()->get_metric_info(metric.metric_id());
   if (metric_inf) {
-    absl::StrAppend(&body(), _sz_unit, string_filter(metric_inf->unit));
+    absl::StrAppend(&content(), _sz_unit, string_filter(metric_inf->unit));
     const cache::resource_info* res_info =
         cache::global_cache::instance_ptr()->get_service(metric.host_id(),
                                                          metric.service_id());
     if (res_info) {
-      absl::StrAppend(&body(), _sz_severity_id, res_info->severity_id);
+      absl::StrAppend(&content(), _sz_severity_id, res_info->severity_id);
     }
   }
 }
 
 void request::append_status_info(const Status& status) {
-  absl::StrAppend(&body(), _sz_host_id, status.host_id(), _sz_serv_id,
+  absl::StrAppend(&content(), _sz_host_id, status.host_id(), _sz_serv_id,
                   status.service_id());
   cache::global_cache::lock l;
   const cache::resource_info* res_info =
       cache::global_cache::instance_ptr()->get_service(status.host_id(),
                                                        status.service_id());
   if (res_info) {
-    absl::StrAppend(&body(), _sz_severity_id, res_info->severity_id);
+    absl::StrAppend(&content(), _sz_severity_id, res_info->severity_id);
+  }
+}
+
+void request::add_remote_write_metric(const storage::pb_metric& metric) {
+  const Metric& obj = metric.obj();
+  _series.clear();
+  _series.add_label("__name__", "metric_val");
+  _series.add_label("id", obj.metric_id());
+  _series.add_label("name", obj.name());
+  _series.add_label("host_id", obj.host_id());
+  _series.add_label("serv_id", obj.service_id());
+  {
+    cache::global_cache::lock l;
+    const cache::metric_info* metric_inf =
+        cache::global_cache::instance_ptr()->get_metric_info(obj.metric_id());
+    if (metric_inf) {
+      _series.add_label(
+          "unit", std::string_view(metric_inf->unit.data(),
+                                   metric_inf->unit.size()));
+      const cache::resource_info* res_info =
+          cache::global_cache::instance_ptr()->get_service(obj.host_id(),
+                                                           obj.service_id());
+      if (res_info)
+        _series.add_label("severity_id", res_info->severity_id);
+    }
   }
+  _tags.clear();
+  _metric_formatter.append_metric(metric, _tags);
+  _series.add_line_protocol_tags(_tags);
+  _series.append_series(content(), obj.value(), obj.time() * 1000);
+  ++_nb_metric;
+}
+
+void request::add_remote_write_status(const storage::pb_status& status,
+                                      int value) {
+  const Status& obj = status.obj();
+  _series.clear();
+  _series.add_label("__name__", "status_val");
+  _series.add_label("id", obj.index_id());
+  _series.add_label("host_id", obj.host_id());
+  _series.add_label("serv_id", obj.service_id());
+  {
+    cache::global_cache::lock l;
+    const cache::resource_info* res_info =
+        cache::global_cache::instance_ptr()->get_service(obj.host_id(),
+                                                         obj.service_id());
+    if (res_info)
+      _series.add_label("severity_id", res_info->severity_id);
+  }
+  _tags.clear();
+  _status_formatter.append_status(status, _tags);
+  _series.add_line_protocol_tags(_tags);
+  _series.append_series(content(), value, obj.time() * 1000);
+  ++_nb_status;
 }
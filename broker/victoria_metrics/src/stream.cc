@@ -76,10 +76,21 @@ std::shared_ptr<stream> stream::load(
 http_tsdb::request::pointer stream::create_request() const {
   auto ret = std::make_shared<request>(
       boost::beast::http::verb::post, _conf->get_server_name(),
-      _conf->get_http_target(), _logger, _body_size_to_reserve,
-      _metric_formatter, _status_formatter, _authorization);
+      _conf->get_http_target(), _logger, 0, _metric_formatter,
+      _status_formatter, _authorization);
 
-  ret->set(boost::beast::http::field::content_type, "text/plain");
+  if (_conf->get_format() ==
+      http_tsdb::http_tsdb_config::body_format::remote_write) {
+    ret->use_remote_write();
+    ret->set(boost::beast::http::field::content_type, "application/x-protobuf");
+    ret->set("X-Prometheus-Remote-Write-Version", "0.1.0");
+  } else {
+    if (_conf->get_gzip())
+      ret->set_encoding(http_tsdb::request::encoding::gzip);
+    ret->set(boost::beast::http::field::content_type, "text/plain");
+  }
+  // create_request() is called with _protect locked
+  ret->reuse_buffers(_spare_buffers, _body_size_to_reserve);
   ret->set(boost::beast::http::field::accept, "application/json");
   ret->set(boost::beast::http::field::accept_encoding, "gzip");
   ret->set("account_id", _account_id);
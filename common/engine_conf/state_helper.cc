@@ -290,8 +290,13 @@ void state_helper::_init() {
   obj->set_max_host_check_spread(5);
   obj->set_max_log_file_size(0);
   obj->set_max_parallel_service_checks(0);
+  obj->set_adaptive_check_scheduling(false);
+  obj->set_max_check_rate(0);
   obj->set_max_service_check_spread(5);
   obj->set_notification_timeout(30);
+  obj->set_notification_digest_window(60);
+  obj->set_notification_digest_threshold(10);
+  obj->set_notification_digest_max_entries(1000);
   obj->set_obsess_over_hosts(false);
   obj->set_obsess_over_services(false);
   obj->set_ochp_command("");
@@ -20,7 +20,9 @@
 #define _COM_ABSL_FLYWEIGHT_FACTORY_HH_
 
 #include <boost/flyweight/factory_tag.hpp>
+#include <boost/flyweight/holder_tag.hpp>
 #include "absl/container/node_hash_set.h"
+#include "absl/synchronization/mutex.h"
 
 namespace com::centreon::common {
 
@@ -103,6 +105,35 @@ struct absl_factory : boost::flyweights::factory_marker {
   };
 };
 
+/**
+ * @brief boost flyweight holder whose factory is never destroyed. Flyweights
+ * owned by static containers can then be released at exit, whatever the
+ * destruction order of the statics.
+ * @code {.c++}
+ * boost::flyweight<std::string,
+ *                  com::centreon::common::absl_factory<false>,
+ *                  com::centreon::common::leaked_holder>
+ * @endcode
+ *
+ * @tparam C
+ */
+template <typename C>
+struct leaked_holder_class : boost::flyweights::holder_marker {
+  static C& get() {
+    static C* instance = new C;
+    return *instance;
+  }
+
+  using type = leaked_holder_class;
+};
+
+struct leaked_holder : boost::flyweights::holder_marker {
+  template <typename C>
+  struct apply {
+    using type = leaked_holder_class<C>;
+  };
+};
+
 }  // namespace com::centreon::common
 
 #endif
@@ -0,0 +1,95 @@
+/**
+ * Copyright 2025 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CENTREON_COMMON_PROCESS_SPAWN_PROTOCOL_HH
+#define CENTREON_COMMON_PROCESS_SPAWN_PROTOCOL_HH
+
+/**
+ * @brief Frames exchanged between centengine and its spawn helper over a unix
+ * socket. Both ends run on the same host, so integers are written in native
+ * byte order.
+ *
+ * Every frame starts with a uint32 giving the size of the rest of the frame.
+ *
+ * A request contains:
+ *  - uint64 id, uint32 timeout in seconds, uint32 nb args, uint32 nb env
+ *  - nb args null terminated strings, the first one is the executable
+ *  - nb env pairs of null terminated strings: the key then the value
+ *
+ * A response contains:
+ *  - uint64 id, int32 exit code, int32 exit status, uint32 stdout length
+ *  - stdout then stderr (the rest of the frame)
+ *
+ * Readers don't copy anything, parsed strings point into the frame.
+ */
+namespace com::centreon::common::spawn_protocol {
+
+/* A bigger frame means a corrupted stream. */
+constexpr uint32_t max_frame_size = 64 * 1024 * 1024;
+
+/**
+ * @brief Appends a request to a buffer. Arguments and environment are
+ * written as they are given, counters are set by end().
+ */
+class request_writer {
+  std::string& _buffer;
+  size_t _begin;
+  uint32_t _nb_args = 0;
+  uint32_t _nb_env = 0;
+
+ public:
+  request_writer(std::string& buffer, uint64_t id, uint32_t timeout);
+  request_writer(const request_writer&) = delete;
+  request_writer& operator=(const request_writer&) = delete;
+
+  void add_arg(const std::string_view& arg);
+  void add_env(const std::string_view& key, const std::string_view& value);
+  void end();
+};
+
+struct request {
+  uint64_t id;
+  uint32_t timeout;
+  std::vector<const char*> args;
+  std::vector<std::pair<std::string_view, std::string_view>> env;
+};
+
+struct response {
+  uint64_t id;
+  int exit_code;
+  int exit_status;
+  std::string_view std_out;
+  std::string_view std_err;
+};
+
+void write_response(std::string& buffer,
+                    uint64_t id,
+                    int exit_code,
+                    int exit_status,
+                    const std::string_view& std_out,
+                    const std::string_view& std_err);
+
+size_t frame_size(const std::string_view& data);
+
+bool parse_request(const std::string_view& frame, request& req);
+
+bool parse_response(const std::string_view& frame, response& resp);
+
+}  // namespace com::centreon::common::spawn_protocol
+
+#endif
@@ -0,0 +1,221 @@
+/**
+ * Copyright 2025 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/common/process/spawn_protocol.hh"
+#include "com/centreon/exceptions/msg_fmt.hh"
+
+using namespace com::centreon::common::spawn_protocol;
+
+namespace {
+template <typename int_type>
+void _append(std::string& buffer, int_type value) {
+  buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename int_type>
+void _overwrite(std::string& buffer, size_t offset, int_type value) {
+  memcpy(buffer.data() + offset, &value, sizeof(value));
+}
+
+/**
+ * @brief read an integer and advance the cursor
+ *
+ * @return false if data is too short
+ */
+template <typename int_type>
+bool _read(std::string_view& data, int_type& value) {
+  if (data.size() < sizeof(value))
+    return false;
+  memcpy(&value, data.data(), sizeof(value));
+  data.remove_prefix(sizeof(value));
+  return true;
+}
+
+/**
+ * @brief read a null terminated string and advance the cursor
+ *
+ * @return false if no null character is found
+ */
+bool _read(std::string_view& data, std::string_view& value) {
+  size_t end = data.find('\0');
+  if (end == std::string_view::npos)
+    return false;
+  value = data.substr(0, end);
+  data.remove_prefix(end + 1);
+  return true;
+}
+
+constexpr size_t request_header_size =
+    sizeof(uint32_t) + sizeof(uint64_t) + 3 * sizeof(uint32_t);
+
+}  // namespace
+
+/**
+ * @brief Construct a new request writer, the frame header is appended to
+ * buffer, previous content of buffer is kept.
+ *
+ * @param buffer
+ * @param id id that will be returned in the response
+ * @param timeout in seconds, 0 means no timeout
+ */
+request_writer::request_writer(std::string& buffer,
+                               uint64_t id,
+                               uint32_t timeout)
+    : _buffer(buffer), _begin(buffer.size()) {
+  _append<uint32_t>(_buffer, 0);
+  _append(_buffer, id);
+  _append(_buffer, timeout);
+  _append<uint32_t>(_buffer, 0);
+  _append<uint32_t>(_buffer, 0);
+}
+
+void request_writer::add_arg(const std::string_view& arg) {
+  _buffer.append(arg.data(), arg.size());
+  _buffer.push_back(0);
+  ++_nb_args;
+}
+
+void request_writer::add_env(const std::string_view& key,
+                             const std::string_view& value) {
+  _buffer.append(key.data(), key.size());
+  _buffer.push_back(0);
+  _buffer.append(value.data(), value.size());
+  _buffer.push_back(0);
+  ++_nb_env;
+}
+
+/**
+ * @brief write frame size and counters. Arguments must be added before
+ * environment.
+ */
+void request_writer::end() {
+  _overwrite<uint32_t>(_buffer, _begin,
+                       _buffer.size() - _begin - sizeof(uint32_t));
+  _overwrite(_buffer, request_header_size - 2 * sizeof(uint32_t) + _begin,
+             _nb_args);
+  _overwrite(_buffer, request_header_size - sizeof(uint32_t) + _begin,
+             _nb_env);
+}
+
+namespace com::centreon::common::spawn_protocol {
+
+/**
+ * @brief append a response frame to buffer
+ */
+void write_response(std::string& buffer,
+                    uint64_t id,
+                    int exit_code,
+                    int exit_status,
+                    const std::string_view& std_out,
+                    const std::string_view& std_err) {
+  uint32_t size = sizeof(uint64_t) + 3 * sizeof(uint32_t) + std_out.size() +
+                  std_err.size();
+  buffer.reserve(buffer.size() + sizeof(uint32_t) + size);
+  _append(buffer, size);
+  _append(buffer, id);
+  _append<int32_t>(buffer, exit_code);
+  _append<int32_t>(buffer, exit_status);
+  _append<uint32_t>(buffer, std_out.size());
+  buffer.append(std_out.data(), std_out.size());
+  buffer.append(std_err.data(), std_err.size());
+}
+
+/**
+ * @brief Returns the size of the first frame of data.
+ *
+ * @param data bytes received
+ * @return size_t the frame size including its length field or 0 if data
+ * doesn't contain a whole frame.
+ * @throw msg_fmt if the announced size is too big
+ */
+size_t frame_size(const std::string_view& data) {
+  uint32_t size;
+  std::string_view cursor(data);
+  if (!_read(cursor, size))
+    return 0;
+  if (size > max_frame_size)
+    throw exceptions::msg_fmt("spawn protocol: frame too big: {} bytes", size);
+  if (cursor.size() < size)
+    return 0;
+  return size + sizeof(uint32_t);
+}
+
+/**
+ * @brief parse a request frame (as delimited by frame_size)
+ *
+ * @param frame
+ * @param req args and env of req point into frame
+ * @return false if the frame is malformed
+ */
+bool parse_request(const std::string_view& frame, request& req) {
+  std::string_view cursor(frame);
+  uint32_t size, nb_args, nb_env;
+  if (!_read(cursor, size) || !_read(cursor, req.id) ||
+      !_read(cursor, req.timeout) || !_read(cursor, nb_args) ||
+      !_read(cursor, nb_env) || !nb_args)
+    return false;
+
+  /* Each string takes at least one byte, it avoids huge allocations on a
+   * corrupted frame. */
+  if (nb_args > cursor.size() || nb_env > cursor.size() / 2)
+    return false;
+
+  req.args.clear();
+  req.args.reserve(nb_args + 1);
+  std::string_view str;
+  for (; nb_args; --nb_args) {
+    if (!_read(cursor, str))
+      return false;
+    req.args.push_back(str.data());
+  }
+  req.args.push_back(nullptr);
+
+  req.env.clear();
+  req.env.reserve(nb_env);
+  std::string_view key, value;
+  for (; nb_env; --nb_env) {
+    if (!_read(cursor, key) || !_read(cursor, value))
+      return false;
+    req.env.emplace_back(key, value);
+  }
+  return true;
+}
+
+/**
+ * @brief parse a response frame (as delimited by frame_size)
+ *
+ * @param frame
+ * @param resp std_out and std_err point into frame
+ * @return false if the frame is malformed
+ */
+bool parse_response(const std::string_view& frame, response& resp) {
+  std::string_view cursor(frame);
+  uint32_t size, out_size;
+  int32_t exit_code, exit_status;
+  if (!_read(cursor, size) || !_read(cursor, resp.id) ||
+      !_read(cursor, exit_code) || !_read(cursor, exit_status) ||
+      !_read(cursor, out_size) || out_size > cursor.size())
+    return false;
+  resp.exit_code = exit_code;
+  resp.exit_status = exit_status;
+  resp.std_out = cursor.substr(0, out_size);
+  resp.std_err = cursor.substr(out_size);
+  return true;
+}
+
+}  // namespace com::centreon::common::spawn_protocol
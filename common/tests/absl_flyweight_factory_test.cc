@@ -145,3 +145,26 @@ TEST(absl_flyweight, concurency) {
     ASSERT_EQ(must_be_equal->c_str(), first);
   }
 }
+
+using string_flyweight_leaked =
+    boost::flyweight<std::string,
+                     absl_factory<false>,
+                     boost::flyweights::tag<tag1>,
+                     leaked_holder>;
+
+/**
+ * @brief a flyweight stored in a static object must still be usable after
+ * being released, as the factory is never destroyed
+ *
+ */
+TEST(absl_flyweight, leaked_holder) {
+  static std::vector<string_flyweight_leaked> test;
+  test.emplace_back("toto");
+  test.emplace_back("toto");
+  test.emplace_back("titi");
+  ASSERT_EQ(test[0]->c_str(), test[1]->c_str());
+  ASSERT_NE(test[0]->c_str(), test[2]->c_str());
+  test.clear();
+  test.emplace_back("toto");
+  ASSERT_EQ(test[0].get(), "toto");
+}
@@ -0,0 +1,105 @@
+/**
+ * Copyright 2025 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include <gtest/gtest.h>
+
+#include "com/centreon/common/process/spawn_protocol.hh"
+
+using namespace com::centreon::common;
+
+TEST(spawn_protocol, request) {
+  std::string buffer;
+  for (uint64_t id = 1; id < 3; ++id) {
+    spawn_protocol::request_writer writer(buffer, id, 10 * id);
+    writer.add_arg("/bin/echo");
+    writer.add_arg("hello");
+    writer.add_arg("");
+    writer.add_env("NAGIOS_HOSTNAME", "host_1");
+    writer.add_env("EMPTY", "");
+    writer.end();
+  }
+
+  std::string_view data(buffer);
+  for (uint64_t id = 1; id < 3; ++id) {
+    // a truncated frame is not complete
+    ASSERT_EQ(spawn_protocol::frame_size(data.substr(0, 10)), 0);
+    size_t size = spawn_protocol::frame_size(data);
+    ASSERT_GT(size, 0);
+    spawn_protocol::request req;
+    ASSERT_TRUE(spawn_protocol::parse_request(data.substr(0, size), req));
+    ASSERT_EQ(req.id, id);
+    ASSERT_EQ(req.timeout, 10 * id);
+    ASSERT_EQ(req.args.size(), 4);
+    ASSERT_STREQ(req.args[0], "/bin/echo");
+    ASSERT_STREQ(req.args[1], "hello");
+    ASSERT_STREQ(req.args[2], "");
+    ASSERT_EQ(req.args[3], nullptr);
+    ASSERT_EQ(req.env.size(), 2);
+    ASSERT_EQ(req.env[0].first, "NAGIOS_HOSTNAME");
+    ASSERT_EQ(req.env[0].second, "host_1");
+    ASSERT_EQ(req.env[1].first, "EMPTY");
+    ASSERT_EQ(req.env[1].second, "");
+    data.remove_prefix(size);
+  }
+  ASSERT_TRUE(data.empty());
+}
+
+TEST(spawn_protocol, response) {
+  std::string buffer;
+  spawn_protocol::write_response(buffer, 5, 2, 0, "CRITICAL: out",
+                                 std::string_view("err\0or", 6));
+  spawn_protocol::write_response(buffer, 6, -1, 2, "", "");
+
+  std::string_view data(buffer);
+  size_t size = spawn_protocol::frame_size(data);
+  spawn_protocol::response resp;
+  ASSERT_TRUE(spawn_protocol::parse_response(data.substr(0, size), resp));
+  ASSERT_EQ(resp.id, 5);
+  ASSERT_EQ(resp.exit_code, 2);
+  ASSERT_EQ(resp.exit_status, 0);
+  ASSERT_EQ(resp.std_out, "CRITICAL: out");
+  ASSERT_EQ(resp.std_err, std::string_view("err\0or", 6));
+
+  data.remove_prefix(size);
+  size = spawn_protocol::frame_size(data);
+  ASSERT_EQ(size, data.size());
+  ASSERT_TRUE(spawn_protocol::parse_response(data, resp));
+  ASSERT_EQ(resp.id, 6);
+  ASSERT_EQ(resp.exit_code, -1);
+  ASSERT_EQ(resp.exit_status, 2);
+  ASSERT_TRUE(resp.std_out.empty());
+  ASSERT_TRUE(resp.std_err.empty());
+}
+
+TEST(spawn_protocol, bad_frame) {
+  std::string buffer;
+  uint32_t huge = spawn_protocol::max_frame_size + 1;
+  buffer.append(reinterpret_cast<const char*>(&huge), sizeof(huge));
+  ASSERT_THROW(spawn_protocol::frame_size(buffer), std::exception);
+
+  buffer.clear();
+  {
+    spawn_protocol::request_writer writer(buffer, 1, 0);
+    writer.add_arg("/bin/true");
+    writer.end();
+  }
+  // remove the null character of the last argument
+  buffer.pop_back();
+  spawn_protocol::request req;
+  ASSERT_FALSE(spawn_protocol::parse_request(buffer, req));
+}
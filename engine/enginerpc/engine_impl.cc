@@ -135,6 +135,32 @@ grpc::Status engine_impl::GetStats(grpc::ServerContext* context
     return grpc::Status(grpc::StatusCode::UNKNOWN, "Unknown error");
 }
 
+/**
+ * @brief Same hosts and services statistics as GetStats with the distribution
+ * of latencies, execution times and state changes.
+ *
+ * @param context gRPC context
+ * @param  unused
+ * @param response A CheckStats object to fill
+ *
+ * @return Status::OK
+ */
+grpc::Status engine_impl::GetCheckStats(
+    grpc::ServerContext* context [[maybe_unused]],
+    const ::google::protobuf::Empty* request [[maybe_unused]],
+    CheckStats* response) {
+  auto fn = std::packaged_task<int(void)>(
+      std::bind(&command_manager::get_check_stats,
+                &command_manager::instance(), response));
+  std::future<int32_t> result = fn.get_future();
+  command_manager::instance().enqueue(std::move(fn));
+  int32_t res = result.get();
+  if (res == 0)
+    return grpc::Status::OK;
+  else
+    return grpc::Status(grpc::StatusCode::UNKNOWN, "Unknown error");
+}
+
 grpc::Status engine_impl::ProcessServiceCheckResult(grpc::ServerContext* context
                                                     [[maybe_unused]],
                                                     const Check* request,
@@ -405,4 +405,8 @@ struct nebstruct_agent_stats_data;
 
 void broker_agent_stats(nebstruct_agent_stats_data& stats);
 
+struct nebstruct_otl_metrics_data;
+
+void broker_otl_metrics(nebstruct_otl_metrics_data& metrics);
+
 #endif /* !CCE_BROKER_HH */
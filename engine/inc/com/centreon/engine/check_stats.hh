@@ -0,0 +1,151 @@
+/**
+ * Copyright 2025 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCE_CHECK_STATS_HH
+#define CCE_CHECK_STATS_HH
+
+#include "com/centreon/engine/checkable.hh"
+
+namespace com::centreon::engine {
+
+/**
+ * @brief Streaming quantile sketch for positive values.
+ *
+ * Values are counted in logarithmic buckets whose bounds grow by gamma, so
+ * that every quantile (min and max included) is given with a relative error
+ * lower than (gamma - 1) / 2. Values lower than min_value share a zero
+ * bucket. Unlike most sketches, a value can be removed, that's what allows
+ * us to follow a value that changes over time.
+ */
+class quantile_sketch {
+ public:
+  static constexpr double gamma = 1.02;
+  static constexpr double min_value = 0.001;
+
+ private:
+  uint64_t _zero = 0;
+  std::vector<uint64_t> _buckets;
+  uint64_t _count = 0;
+  /* sum is stored in micro units so that additions and removals don't
+   * accumulate rounding errors */
+  int64_t _micro_sum = 0;
+
+  static uint32_t _index(double value);
+  static double _value(uint32_t index);
+
+ public:
+  void add(double value);
+  void remove(double value);
+
+  uint64_t count() const { return _count; }
+  double sum() const { return _micro_sum / 1000000.0; }
+  double average() const { return _count ? sum() / _count : 0; }
+  double min() const;
+  double max() const;
+  double quantile(double q) const;
+
+  /**
+   * @brief Call visitor(upper_bound, count) for each non empty bucket, in
+   * increasing order.
+   */
+  template <class visitor_type>
+  void visit(visitor_type&& visitor) const {
+    if (_zero)
+      visitor(min_value, _zero);
+    for (uint32_t i = 0; i < _buckets.size(); ++i)
+      if (_buckets[i])
+        visitor(min_value * std::pow(gamma, i + 1), _buckets[i]);
+  }
+};
+
+/**
+ * @brief Host or service statistics maintained incrementally.
+ *
+ * Instead of walking all the hosts or services on each GetStats call, each
+ * object sends its values here each time its status is published (at each
+ * check result, downtime, flapping change...). We keep the last values sent
+ * by each object, and the aggregates are corrected by the difference between
+ * the old and the new values.
+ *
+ * Everything is called from the main loop thread, so nothing is protected.
+ */
+class check_stats {
+ public:
+  static constexpr uint32_t max_states = 4;
+
+  /* values of an object taken into account in the aggregates */
+  struct sample {
+    bool active;
+    bool checked;
+    bool scheduled;
+    bool flapping;
+    bool downtime;
+    uint32_t state;
+    time_t last_check;
+    double latency;
+    double execution_time;
+    double state_change;
+  };
+
+  struct type_stats {
+    quantile_sketch latency;
+    quantile_sketch execution_time;
+    quantile_sketch state_change;
+    /* last_check -> number of objects checked at this time, only the last
+     * hour is kept */
+    absl::btree_map<time_t, uint32_t> last_checks;
+
+    uint32_t checks_between(time_t from, time_t to) const;
+  };
+
+ private:
+  absl::flat_hash_map<const checkable*, sample> _samples;
+  type_stats _active;
+  type_stats _passive;
+  uint32_t _checked = 0;
+  uint32_t _scheduled = 0;
+  uint32_t _flapping = 0;
+  uint32_t _downtime = 0;
+  std::array<uint32_t, max_states> _states{};
+
+  void _add(const sample& s, int32_t sign);
+  void _prune(time_t now);
+
+ public:
+  static check_stats& hosts();
+  static check_stats& services();
+
+  void update(const checkable& obj, uint32_t state, time_t now);
+  void remove(const checkable& obj);
+  void clear();
+
+  size_t size() const { return _samples.size(); }
+  uint32_t checked() const { return _checked; }
+  uint32_t scheduled() const { return _scheduled; }
+  uint32_t flapping() const { return _flapping; }
+  uint32_t downtime() const { return _downtime; }
+  uint32_t state_count(uint32_t state) const {
+    return state < max_states ? _states[state] : 0;
+  }
+  const type_stats& active() const { return _active; }
+  const type_stats& passive() const { return _passive; }
+};
+
+}  // namespace com::centreon::engine
+
+#endif  // !CCE_CHECK_STATS_HH
@@ -25,6 +25,8 @@
 #include <memory>
 #include <string>
 
+#include "com/centreon/engine/interned_string.hh"
+
 namespace com::centreon::engine {
 namespace commands {
 class command;
@@ -59,55 +61,60 @@ class checkable {
     std::array<command_allowed, 4> command;
   };
 
-  std::string _name;
-  std::string _display_name;
-  std::string _check_command;
+  /* Runtime state read by the scheduler, at each check result and when
+   * statistics or retention walk all the objects. It is kept together at the
+   * head of the object so that these walks touch as few cache lines as
+   * possible. */
+  std::time_t _next_check;
+  std::time_t _last_state_change;
+  std::time_t _last_hard_state_change;
+  double _latency;
+  double _execution_time;
+  double _percent_state_change;
+  int _last_check;
+  int _current_attempt;
+  int _max_attempts;
+  int _scheduled_downtime_depth;
   uint32_t _check_interval;
   uint32_t _retry_interval;
-  int _max_attempts;
-  std::string _check_period;
-  std::string _event_handler;
+  uint32_t _state_history_index;
+  check_type _check_type;
+  enum state_type _state_type;
+  bool _checks_enabled;
+  bool _accept_passive_checks;
+  bool _has_been_checked;
+  bool _should_be_scheduled;
+  bool _is_executing;
+  bool _is_flapping;
+  bool _check_freshness;
+  int _freshness_threshold;
+  std::shared_ptr<commands::command> _check_command_ptr;
+
+  /* Cold configuration, mostly shared strings. */
+  std::string _name;
+  std::string _display_name;
+  interned_string _check_command;
+  interned_string _check_period;
+  interned_string _event_handler;
   bool _event_handler_enabled;
-  std::string _action_url;
-  std::string _icon_image;
-  std::string _icon_image_alt;
-  std::string _notes;
-  std::string _notes_url;
+  bool _flap_detection_enabled;
+  bool _obsess_over;
+  interned_string _action_url;
+  interned_string _icon_image;
+  interned_string _icon_image_alt;
+  interned_string _notes;
+  interned_string _notes_url;
   std::string _plugin_output;
   std::string _long_plugin_output;
   std::string _perf_data;
-  bool _flap_detection_enabled;
   double _low_flap_threshold;
   double _high_flap_threshold;
-  bool _obsess_over;
-  std::string _timezone;
-  bool _checks_enabled;
-  bool _accept_passive_checks;
-  bool _check_freshness;
-  int _freshness_threshold;
-  check_type _check_type;
-  int _current_attempt;
-  bool _has_been_checked;
-  int _scheduled_downtime_depth;
-  double _execution_time;
-  bool _is_flapping;
-  int _last_check;
-  double _latency;
-  std::time_t _next_check;
-  bool _should_be_scheduled;
-  uint32_t _state_history_index;
-  std::time_t _last_state_change;
-  std::time_t _last_hard_state_change;
-  enum state_type _state_type;
-  double _percent_state_change;
+  interned_string _timezone;
   commands::command* _event_handler_ptr;
-  std::shared_ptr<commands::command> _check_command_ptr;
-  bool _is_executing;
   std::shared_ptr<severity> _severity;
   uint64_t _icon_id;
   std::forward_list<std::shared_ptr<tag>> _tags;
 
-  // whitelist cache
   whitelist_last_result _whitelist_last_result;
 
  public:
@@ -55,6 +55,7 @@ class command_manager {
   int get_restart_stats(RestartStats* response);
   int get_services_stats(ServicesStats* sstats);
   int get_hosts_stats(HostsStats* hstats);
+  int get_check_stats(CheckStats* response);
   void execute();
   static void schedule_and_propagate_downtime(host* h,
                                               time_t entry_time,
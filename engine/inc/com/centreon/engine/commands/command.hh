@@ -55,6 +55,8 @@ class command : public std::enable_shared_from_this<command> {
   std::string _command_line;
   command_listener* _listener;
   std::string _name;
+  /* 0 means no limit, used by the adaptive check scheduling */
+  uint32_t _max_parallel_checks = 0;
 
   /**
    * @brief the goal of this structure is to ensure that checks shared by
@@ -102,6 +104,10 @@ class command : public std::enable_shared_from_this<command> {
   virtual const std::string& get_command_line() const noexcept;
   virtual const std::string& get_name() const noexcept;
   e_type get_type() const { return _type; }
+  uint32_t max_parallel_checks() const { return _max_parallel_checks; }
+  void set_max_parallel_checks(uint32_t max_parallel_checks) {
+    _max_parallel_checks = max_parallel_checks;
+  }
   virtual std::string process_cmd(nagios_macros* macros) const;
   virtual uint64_t run(const std::string& processed_cmd,
                        nagios_macros& macors,
@@ -64,7 +64,8 @@ class otel_connector : public command {
 
   static std::shared_ptr<otel_connector> get_otel_connector_from_host_serv(
       const std::string_view& host,
-      const std::string_view& serv);
+      const std::string_view& serv,
+      notifier** host_or_serv = nullptr);
 
   static void clear();
 
@@ -81,8 +82,7 @@ class otel_connector : public command {
   void update(const std::string& cmd_line);
 
   void process_data_pts(
-      const std::string_view& host,
-      const std::string_view& serv,
+      notifier* host_or_serv,
       const modules::opentelemetry::metric_to_datapoints& data_pts);
 
   virtual uint64_t run(const std::string& processed_cmd,
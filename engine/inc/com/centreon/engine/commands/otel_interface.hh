@@ -22,6 +22,10 @@
 #include "com/centreon/engine/commands/result.hh"
 #include "com/centreon/engine/macros/defines.hh"
 
+namespace com::centreon::engine {
+class notifier;
+}
+
 namespace com::centreon::engine::modules::opentelemetry {
 class metric_to_datapoints;
 }
@@ -60,16 +64,25 @@ struct host_serv_metric {
  *
  */
 class host_serv_list {
-  absl::flat_hash_map<std::string, absl::flat_hash_set<std::string>> _data;
-  mutable absl::Mutex _data_m;
-
  public:
   using pointer = std::shared_ptr<host_serv_list>;
+  /* called each time a host is added to or removed from the list */
+  using host_change_listener = std::function<void()>;
 
+ private:
+  mutable absl::Mutex _data_m;
+  absl::flat_hash_map<std::string, absl::flat_hash_set<std::string>> _data
+      ABSL_GUARDED_BY(_data_m);
+  host_change_listener _on_host_change ABSL_GUARDED_BY(_data_m);
+
+ public:
   void register_host_serv(const std::string& host,
                           const std::string& service_description);
   void remove(const std::string& host, const std::string& service_description);
 
+  void set_host_change_listener(host_change_listener&& listener);
+  std::vector<std::string> get_hosts() const;
+
   template <class string_type>
   bool contains(const string_type& host,
                 const string_type& service_description) const;
@@ -139,8 +152,7 @@ class otl_check_result_builder_base {
  public:
   virtual ~otl_check_result_builder_base() = default;
   virtual void process_data_pts(
-      const std::string_view& host,
-      const std::string_view& serv,
+      notifier* host_or_serv,
       const modules::opentelemetry::metric_to_datapoints& data_pts) = 0;
 };
 
@@ -21,6 +21,7 @@
 #include "com/centreon/common/process/process.hh"
 #include "com/centreon/common/process/process_args.hh"
 #include "com/centreon/engine/commands/command.hh"
+#include "com/centreon/engine/commands/spawn_helper.hh"
 
 namespace com::centreon::engine {
 
@@ -29,7 +30,8 @@ class environment;
 
 /**
  *  @brief raw_v2 is a specific implementation of command.
- * It uses common::process to start commands
+ * It uses common::process to start commands, or the spawn helper when it's
+ * enabled.
  *
  */
 class raw_v2 : public command {
@@ -48,6 +50,11 @@ class raw_v2 : public command {
                     const std::string& std_out,
                     const std::string& std_err);
 
+  bool _run_by_spawn_helper(uint64_t command_id,
+                            nagios_macros& macros,
+                            uint32_t timeout,
+                            spawn_helper::handler_type&& handler);
+
  public:
   raw_v2(const std::shared_ptr<asio::io_context> io_context,
          const std::string& name,
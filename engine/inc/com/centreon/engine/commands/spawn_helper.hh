@@ -0,0 +1,95 @@
+/**
+ * Copyright 2025 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCE_COMMANDS_SPAWN_HELPER_HH
+#define CCE_COMMANDS_SPAWN_HELPER_HH
+
+namespace com::centreon::engine::commands {
+
+/**
+ * @brief Connection to centenginespawn, a small process started at boot that
+ * launches checks for us. Forking a centengine that uses gigabytes of memory
+ * is expensive, forking this helper is not.
+ *
+ * Requests are written in a buffer sent as soon as no write is pending, so
+ * they are sent in batches under load. Responses are read the same way.
+ *
+ * If the helper dies, pending checks end with a crash status and callers
+ * start their checks themselves until the helper is restarted (at most once
+ * every restart_delay).
+ */
+class spawn_helper : public std::enable_shared_from_this<spawn_helper> {
+ public:
+  using handler_type = std::function<void(int /*exit_code*/,
+                                          int /*exit_status*/,
+                                          const std::string& /*std_out*/,
+                                          const std::string& /*std_err*/)>;
+
+  static constexpr std::chrono::seconds restart_delay{30};
+
+ private:
+  struct helper_process;
+
+  std::shared_ptr<asio::io_context> _io_context;
+  std::shared_ptr<spdlog::logger> _logger;
+  asio::local::stream_protocol::socket _socket;
+  std::unique_ptr<helper_process> _process;
+
+  mutable absl::Mutex _protect;
+  bool _alive ABSL_GUARDED_BY(_protect) = true;
+  absl::flat_hash_map<uint64_t, handler_type> _pending
+      ABSL_GUARDED_BY(_protect);
+  std::string _to_send ABSL_GUARDED_BY(_protect);
+  std::string _sending ABSL_GUARDED_BY(_protect);
+  bool _write_pending ABSL_GUARDED_BY(_protect) = false;
+
+  /* only used by the read completion handlers, one at a time */
+  std::string _read_buffer;
+  size_t _read_size = 0;
+
+  static absl::Mutex _instance_m;
+  static std::string _path ABSL_GUARDED_BY(_instance_m);
+  static std::shared_ptr<spawn_helper> _instance ABSL_GUARDED_BY(_instance_m);
+  static std::chrono::steady_clock::time_point _last_start
+      ABSL_GUARDED_BY(_instance_m);
+
+  void _start(const std::string& path);
+  void _read();
+  void _on_read(const boost::system::error_code& err, size_t nb_read);
+  void _write() ABSL_EXCLUSIVE_LOCKS_REQUIRED(_protect);
+  void _on_write(const boost::system::error_code& err);
+  void _on_failure(const std::string& reason);
+
+ public:
+  spawn_helper(const std::shared_ptr<asio::io_context>& io_context,
+               const std::shared_ptr<spdlog::logger>& logger);
+  spawn_helper(const spawn_helper&) = delete;
+  spawn_helper& operator=(const spawn_helper&) = delete;
+  ~spawn_helper() noexcept;
+
+  static void load(const std::string& path);
+  static void unload();
+  static std::shared_ptr<spawn_helper> instance();
+
+  bool alive() const;
+  bool run(uint64_t id, std::string&& request, handler_type&& handler);
+};
+
+}  // namespace com::centreon::engine::commands
+
+#endif  // !CCE_COMMANDS_SPAWN_HELPER_HH
@@ -11,6 +11,9 @@ class engine_impl final : public Engine::Service {
   grpc::Status GetStats(grpc::ServerContext* context,
                         const GenericString* request,
                         Stats* response) override;
+  grpc::Status GetCheckStats(grpc::ServerContext* context,
+                             const ::google::protobuf::Empty* request,
+                             CheckStats* response) override;
   grpc::Status GetProcessStats(
       grpc::ServerContext* context,
       const google::protobuf::Empty* request,
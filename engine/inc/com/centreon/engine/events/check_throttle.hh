@@ -0,0 +1,123 @@
+/**
+ * Copyright 2025 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCE_EVENTS_CHECK_THROTTLE_HH
+#define CCE_EVENTS_CHECK_THROTTLE_HH
+
+#include "com/centreon/engine/check_stats.hh"
+
+namespace com::centreon::engine {
+class service;
+
+namespace events {
+
+/**
+ * @brief Adaptive launch control of the scheduled service checks.
+ *
+ * When adaptive_check_scheduling is enabled, the main loop asks admit()
+ * before starting a scheduled service check:
+ *  - a token bucket refilled each second limits the launch rate. This rate
+ *    is max_check_rate if set, lowered to max_parallel_service_checks
+ *    divided by the average execution time (what the pollers can really
+ *    absorb), and halved while the checker has more than one second of
+ *    results waiting to be reaped.
+ *  - a command can't have more than its max_parallel_checks checks running.
+ *
+ * A check that is refused is not nudged randomly: defer() gives it the next
+ * second that still has room at the current rate, so that peaks are spread
+ * evenly. Command limited checks are deferred by the average execution time
+ * of the command.
+ *
+ * Lateness of each scheduled check is measured when it reaches the head of
+ * the queue and when it is really launched, the difference is the cost of
+ * the throttling.
+ *
+ * Everything is called from the main loop thread, so nothing is protected.
+ */
+class check_throttle {
+ public:
+  enum class verdict { run, rate_limited, command_limited };
+
+ private:
+  struct command_stats {
+    uint32_t running = 0;
+    double average_execution_time = 0;
+  };
+
+  struct deferred_check {
+    time_t planned;
+    time_t dispatched;
+  };
+
+  /* tokens of the current second */
+  time_t _bucket_second = 0;
+  double _tokens = 0;
+  double _rate = 0;
+
+  /* deferred checks are given to _next_slot until it's full */
+  time_t _next_slot = 0;
+  uint32_t _slot_used = 0;
+
+  double _average_execution_time = 0;
+  absl::flat_hash_map<std::string, command_stats> _commands;
+  /* running service -> its command name */
+  absl::flat_hash_map<const service*, std::string> _running;
+  /* first planned time of the deferred services */
+  absl::flat_hash_map<const service*, deferred_check> _deferred;
+
+  quantile_sketch _lateness_at_dispatch;
+  quantile_sketch _lateness_at_launch;
+  uint64_t _deferred_count = 0;
+
+  check_throttle() = default;
+
+  void _refill(time_t now, size_t backlog);
+
+ public:
+  static check_throttle& instance();
+  check_throttle(const check_throttle&) = delete;
+  check_throttle& operator=(const check_throttle&) = delete;
+
+  bool enabled() const;
+  double compute_rate(size_t backlog) const;
+
+  verdict admit(const service& svc, time_t now, size_t backlog);
+  time_t defer(const service& svc, verdict why, time_t now);
+  void launched(const service& svc, time_t now);
+
+  void started(const service& svc);
+  void finished(const service& svc, double execution_time);
+  void forget(const service& svc);
+  void clear();
+
+  uint32_t running(const std::string& command_name) const;
+  double average_execution_time() const { return _average_execution_time; }
+  double rate() const { return _rate; }
+  uint64_t deferred_count() const { return _deferred_count; }
+  const quantile_sketch& lateness_at_dispatch() const {
+    return _lateness_at_dispatch;
+  }
+  const quantile_sketch& lateness_at_launch() const {
+    return _lateness_at_launch;
+  }
+};
+
+}  // namespace events
+}  // namespace com::centreon::engine
+
+#endif  // !CCE_EVENTS_CHECK_THROTTLE_HH
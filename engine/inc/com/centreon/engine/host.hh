@@ -44,6 +44,9 @@ class host : public notifier {
 
   enum host_state { state_up, state_down, state_unreachable };
 
+  /* a host rarely belongs to more than two groups */
+  using hostgroup_list = absl::InlinedVector<hostgroup*, 2>;
+
   host(uint64_t host_id,
        std::string const& name,
        std::string const& display_name,
@@ -255,8 +258,8 @@ class host : public notifier {
   static host_id_map hosts_by_id;
 
   service_map_unsafe services;
-  std::list<hostgroup*> const& get_parent_groups() const;
-  std::list<hostgroup*>& get_parent_groups();
+  hostgroup_list const& get_parent_groups() const;
+  hostgroup_list& get_parent_groups();
 
   std::string get_check_command_line(nagios_macros* macros);
 
@@ -267,8 +270,8 @@ class host : public notifier {
   std::string _alias;
   std::string _address;
   bool _process_performance_data;
-  std::string _vrml_image;
-  std::string _statusmap_image;
+  interned_string _vrml_image;
+  interned_string _statusmap_image;
   bool _have_2d_coords;
   bool _have_3d_coords;
   double _x_2d;
@@ -292,7 +295,7 @@ class host : public notifier {
   enum host_state _last_hard_state;
   enum host_state _current_state;
 
-  std::list<hostgroup*> _hostgroups;
+  hostgroup_list _hostgroups;
 };
 
 }  // namespace com::centreon::engine
@@ -318,6 +321,8 @@ com::centreon::engine::host& find_host(uint64_t host_id);
 bool host_exists(uint64_t host_id) noexcept;
 uint64_t get_host_id(std::string const& name);
 std::string get_host_name(const uint64_t host_id);
+host* lookup_host(std::string_view name) noexcept;
+host* lookup_host(uint64_t host_id) noexcept;
 
 }  // namespace com::centreon::engine
 
@@ -0,0 +1,47 @@
+/**
+ * Copyright 2025 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCE_INTERNED_STRING_HH
+#define CCE_INTERNED_STRING_HH
+
+#include <boost/flyweight.hpp>
+#include "com/centreon/common/absl_flyweight_factory.hh"
+
+namespace com::centreon::engine {
+
+struct configuration_string_tag {};
+
+/**
+ * @brief Configuration string shared by all the objects that have the same
+ * value (urls, icons, periods, host names of services...). It only costs a
+ * pointer in the object and the value is stored once. It converts implicitly
+ * to a const std::string&, use get() where a conversion is not possible
+ * (fmt arguments for example).
+ *
+ * The factory is never destroyed since objects living in static containers
+ * are destroyed at exit.
+ */
+using interned_string =
+    boost::flyweight<std::string,
+                     common::absl_factory<false>,
+                     boost::flyweights::tag<configuration_string_tag>,
+                     common::leaked_holder>;
+
+}  // namespace com::centreon::engine
+
+#endif  // !CCE_INTERNED_STRING_HH
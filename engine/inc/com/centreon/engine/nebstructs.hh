@@ -180,4 +180,15 @@ struct nebstruct_agent_stats_data {
   std::unique_ptr<std::vector<cumul_data>> data;
 };
 
+namespace opentelemetry::proto::collector::metrics::v1 {
+class ExportMetricsServiceRequest;
+}
+
+/* OpenTelemetry data points not used by any check */
+struct nebstruct_otl_metrics_data {
+  using request = ::opentelemetry::proto::collector::metrics::v1::
+      ExportMetricsServiceRequest;
+  std::shared_ptr<request> metrics;
+};
+
 #endif /* !CCE_NEBSTRUCTS_HH */
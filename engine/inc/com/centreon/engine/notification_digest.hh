@@ -0,0 +1,101 @@
+/**
+ * Copyright 2025 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCE_NOTIFICATION_DIGEST_HH
+#define CCE_NOTIFICATION_DIGEST_HH
+
+#include "com/centreon/engine/checkable.hh"
+
+namespace com::centreon::engine {
+
+/**
+ * @brief Coalesces notifications during a storm.
+ *
+ * It is enabled by the notification_digest_command option. Each contact can
+ * receive notification_digest_threshold notifications during a window of
+ * notification_digest_window seconds. Beyond that, the notifications of this
+ * contact are buffered by notification command, and at the end of the
+ * window, the digest command is executed once per contact and command with
+ * the path of a JSON file describing them in $ARG1$.
+ *
+ * A digest keeps at most notification_digest_max_entries notifications, the
+ * others are only counted.
+ *
+ * Everything is called from the main loop thread, so nothing is protected.
+ */
+class notification_digest {
+ public:
+  struct entry {
+    time_t time;
+    std::string type;
+    std::string host_name;
+    std::string service_description;
+    std::string state;
+    std::string output;
+  };
+
+  struct digest {
+    time_t start;
+    uint32_t dropped = 0;
+    std::vector<entry> entries;
+  };
+
+ private:
+  struct contact_window {
+    time_t start = 0;
+    uint32_t sent = 0;
+  };
+
+  /* contact name -> notifications sent in the current window */
+  absl::flat_hash_map<std::string, contact_window> _windows;
+  /* (contact name, notification command name) -> buffered notifications */
+  absl::btree_map<std::pair<std::string, std::string>, digest> _digests;
+  time_t _next_flush = 0;
+
+  checkable::static_whitelist_last_result _whitelist_cache{};
+
+  notification_digest() = default;
+
+  void _send(const std::string& contact_name,
+             const std::string& command_name,
+             const digest& to_send);
+
+ public:
+  static notification_digest& instance();
+  notification_digest(const notification_digest&) = delete;
+  notification_digest& operator=(const notification_digest&) = delete;
+
+  bool enabled() const;
+  bool add(const std::string& contact_name,
+           const std::string& command_name,
+           entry&& notif,
+           time_t now);
+  void flush(time_t now);
+  void clear();
+
+  const digest* pending(const std::string& contact_name,
+                        const std::string& command_name) const;
+
+  static std::string payload(const std::string& contact_name,
+                             const std::string& command_name,
+                             const digest& to_send);
+};
+
+}  // namespace com::centreon::engine
+
+#endif  // !CCE_NOTIFICATION_DIGEST_HH
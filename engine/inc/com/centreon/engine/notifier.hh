@@ -328,7 +328,7 @@ class notifier : public checkable {
   uint64_t _current_notification_id;
   time_t _next_notification;
   time_t _last_notification;
-  std::string _notification_period;
+  interned_string _notification_period;
   timeperiod* _notification_period_ptr;
   uint32_t _first_notification_delay;
   uint32_t _recovery_notification_delay;
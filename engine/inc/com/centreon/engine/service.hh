@@ -19,6 +19,8 @@
 #ifndef CCE_SERVICE_HH
 #define CCE_SERVICE_HH
 
+#include <absl/container/inlined_vector.h>
+
 #include "com/centreon/engine/check_result.hh"
 #include "com/centreon/engine/hash.hh"
 #include "com/centreon/engine/logging.hh"
@@ -118,6 +120,9 @@ class service : public notifier {
 
   enum service_state { state_ok, state_warning, state_critical, state_unknown };
 
+  /* a service rarely belongs to more than two groups */
+  using servicegroup_list = absl::InlinedVector<servicegroup*, 2>;
+
   service(std::string const& hostname,
           std::string const& description,
           std::string const& display_name,
@@ -248,8 +253,8 @@ class service : public notifier {
   bool is_in_downtime() const override;
   void resolve(uint32_t& w, uint32_t& e);
 
-  std::list<servicegroup*> const& get_parent_groups() const;
-  std::list<servicegroup*>& get_parent_groups();
+  servicegroup_list const& get_parent_groups() const;
+  servicegroup_list& get_parent_groups();
   void set_host_ptr(host* h);
   host const* get_host_ptr() const;
   host* get_host_ptr();
@@ -266,9 +271,9 @@ class service : public notifier {
  private:
   uint64_t _host_id;
   uint64_t _service_id;
-  std::string _hostname;
-  std::string _event_handler_args;
-  std::string _check_command_args;
+  interned_string _hostname;
+  interned_string _event_handler_args;
+  interned_string _check_command_args;
 
   int _process_performance_data;
   bool _check_flapping_recovery_notification;
@@ -281,7 +286,7 @@ class service : public notifier {
   enum service_state _current_state;
   enum service_state _last_hard_state;
   enum service_state _last_state;
-  std::list<servicegroup*> _servicegroups;
+  servicegroup_list _servicegroups;
   host* _host_ptr;
   bool _host_problem_at_last_check;
 };
@@ -354,6 +359,9 @@ std::pair<std::string, std::string> get_host_and_service_names(
     const uint64_t host_id,
     const uint64_t service_id);
 uint64_t get_service_id(std::string const& host, std::string const& svc);
+service* lookup_service(std::string_view host_name,
+                        std::string_view description) noexcept;
+service* lookup_service(uint64_t host_id, uint64_t service_id) noexcept;
 
 }  // namespace com::centreon::engine
 
@@ -0,0 +1,146 @@
+/**
+ * Copyright 2025 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCE_MOD_OTL_BROKER_FORWARDER_HH
+#define CCE_MOD_OTL_BROKER_FORWARDER_HH
+
+#include <absl/synchronization/mutex.h>
+
+#include "otl_data_point.hh"
+
+namespace com::centreon::engine::modules::opentelemetry {
+
+/**
+ * @brief "broker_forward" object of the module configuration file
+ *
+ */
+struct broker_forward_config {
+  bool enabled = true;
+  /* a batch is sent when it contains batch_size data points... */
+  unsigned batch_size = 1000;
+  /* ...or when its first data point is older than max_delay */
+  std::chrono::milliseconds max_delay = std::chrono::milliseconds(1000);
+  /* max data points accepted per second and per source, 0 means no limit */
+  unsigned max_points_per_source = 0;
+
+  bool operator==(const broker_forward_config& right) const {
+    return enabled == right.enabled && batch_size == right.batch_size &&
+           max_delay == right.max_delay &&
+           max_points_per_source == right.max_points_per_source;
+  }
+};
+
+/**
+ * @brief Data points that are not matched by any extractor are given to this
+ * object. They are gathered in an ExportMetricsServiceRequest where data
+ * points of the same resource (host.name and service.name resource
+ * attributes), scope and metric share one ResourceMetrics, ScopeMetrics and
+ * Metric. Full batches are given to the handler, the default one sends them
+ * to broker as pb_otl_metrics events from the main thread. Before, the
+ * host_id and service_id of the engine service named by host.name and
+ * service.name are added to the resource attributes, so that broker stores
+ * these data points as metrics of this service.
+ * On shutdown, the pending batch is given to the sync handler, called from
+ * the main thread, the default one sends it immediately.
+ * Each source can't send more than max_points_per_source data points per
+ * second, others are dropped.
+ * on_data_points is called by grpc threads and the timer by the io_context
+ * ones, so all is protected by _protect.
+ */
+class broker_forwarder : public std::enable_shared_from_this<broker_forwarder> {
+ public:
+  using batch_handler = std::function<void(const metric_request_ptr&)>;
+
+ private:
+  std::shared_ptr<asio::io_context> _io_context;
+  std::shared_ptr<spdlog::logger> _logger;
+  batch_handler _handler;
+  batch_handler _sync_handler;
+
+  mutable absl::Mutex _protect;
+  broker_forward_config _conf ABSL_GUARDED_BY(_protect);
+  asio::system_timer _flush_timer ABSL_GUARDED_BY(_protect);
+  bool _flush_timer_armed ABSL_GUARDED_BY(_protect) = false;
+
+  metric_request_ptr _batch ABSL_GUARDED_BY(_protect);
+  unsigned _batch_size ABSL_GUARDED_BY(_protect) = 0;
+  /* indexes of the current batch, string_views point to the batch content */
+  absl::flat_hash_map<std::pair<std::string, std::string>,
+                      ::opentelemetry::proto::metrics::v1::ResourceMetrics*>
+      _resources ABSL_GUARDED_BY(_protect);
+  absl::flat_hash_map<
+      std::pair<const ::opentelemetry::proto::metrics::v1::ResourceMetrics*,
+                std::string_view>,
+      ::opentelemetry::proto::metrics::v1::ScopeMetrics*>
+      _scopes ABSL_GUARDED_BY(_protect);
+  absl::flat_hash_map<
+      std::pair<const ::opentelemetry::proto::metrics::v1::ScopeMetrics*,
+                std::string_view>,
+      ::opentelemetry::proto::metrics::v1::Metric*>
+      _metrics ABSL_GUARDED_BY(_protect);
+
+  /* data points received from each source during _rate_second */
+  time_t _rate_second ABSL_GUARDED_BY(_protect) = 0;
+  absl::flat_hash_map<std::string, unsigned> _source_points
+      ABSL_GUARDED_BY(_protect);
+
+  uint64_t _forwarded ABSL_GUARDED_BY(_protect) = 0;
+  uint64_t _dropped ABSL_GUARDED_BY(_protect) = 0;
+  uint64_t _batches ABSL_GUARDED_BY(_protect) = 0;
+
+  bool _accept(const std::string& source, time_t now)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(_protect);
+  void _add(const std::string& source, const otl_data_point& data_pt)
+      ABSL_EXCLUSIVE_LOCKS_REQUIRED(_protect);
+  metric_request_ptr _pop_batch() ABSL_EXCLUSIVE_LOCKS_REQUIRED(_protect);
+  void _start_flush_timer() ABSL_EXCLUSIVE_LOCKS_REQUIRED(_protect);
+  void _flush_timer_handler(const boost::system::error_code& err);
+
+ public:
+  using pointer = std::shared_ptr<broker_forwarder>;
+
+  broker_forwarder(const std::shared_ptr<asio::io_context>& io_context,
+                   const std::shared_ptr<spdlog::logger>& logger,
+                   batch_handler&& handler = send_to_broker,
+                   batch_handler&& sync_handler = write_to_broker);
+
+  static void send_to_broker(const metric_request_ptr& batch);
+  static void write_to_broker(const metric_request_ptr& batch);
+  static void add_resource_ids(
+      ::opentelemetry::proto::collector::metrics::v1::
+          ExportMetricsServiceRequest& batch);
+
+  static std::string get_source(const otl_data_point& data_pt);
+  static std::string get_service(const otl_data_point& data_pt);
+
+  void update_config(const broker_forward_config& conf);
+
+  void on_data_points(const std::vector<otl_data_point>& data_pts,
+                      time_t now = time(nullptr));
+
+  void flush();
+  void shutdown();
+
+  uint64_t get_forwarded() const;
+  uint64_t get_dropped() const;
+  uint64_t get_batches() const;
+};
+
+}  // namespace com::centreon::engine::modules::opentelemetry
+
+#endif  // !CCE_MOD_OTL_BROKER_FORWARDER_HH
@@ -39,6 +39,13 @@ class agent_config {
   uint32_t _export_period;
   // after this timeout, process is killed (in seconds)
   uint32_t _check_timeout;
+  // agent sends results as soon as they reach this size (in bytes, 0: default)
+  uint32_t _max_batch_size = 0;
+  // longest time a result waits on agent side (in ms, 0: export_period)
+  uint32_t _max_batch_delay = 0;
+  // threads that run agent connections io_contexts and handle their messages
+  // (0: engine io_context and grpc threads)
+  uint32_t _connection_threads = 0;
 
  public:
   agent_config(const rapidjson::Value& json_config_v);
@@ -62,6 +69,9 @@ class agent_config {
   uint32_t get_max_concurrent_checks() const { return _max_concurrent_checks; }
   uint32_t get_export_period() const { return _export_period; }
   uint32_t get_check_timeout() const { return _check_timeout; }
+  uint32_t get_max_batch_size() const { return _max_batch_size; }
+  uint32_t get_max_batch_delay() const { return _max_batch_delay; }
+  uint32_t get_connection_threads() const { return _connection_threads; }
 
   bool operator==(const agent_config& right) const;
 
@@ -28,6 +28,10 @@
 
 namespace com::centreon::engine::modules::opentelemetry::centreon_agent {
 
+void split_service_scopes(
+    ::opentelemetry::proto::collector::metrics::v1::ExportMetricsServiceRequest&
+        request);
+
 /**
  * @brief this class manages connection with centreon monitoring agent
  * reverse connection or no
@@ -39,6 +43,8 @@ class agent_impl
     : public bireactor_class,
       public std::enable_shared_from_this<agent_impl<bireactor_class>> {
   std::shared_ptr<boost::asio::io_context> _io_context;
+  // _io_context is a connection_pool one: received messages are handled in it
+  const bool _pooled;
   const std::string_view _class_name;
   const bool _reversed;
   const bool _is_crypted;
@@ -48,29 +54,46 @@ class agent_impl
 
   agent_config::pointer _conf ABSL_GUARDED_BY(_protect);
   bool _agent_can_receive_encrypted_credentials ABSL_GUARDED_BY(_protect);
+  // check results dropped by agent because engine was too slow, as reported
+  // by agent
+  uint64_t _dropped_results ABSL_GUARDED_BY(_protect) = 0;
 
   metric_handler _metric_handler;
 
   std::shared_ptr<agent::MessageFromAgent> _agent_info
       ABSL_GUARDED_BY(_protect);
-  std::shared_ptr<agent::MessageToAgent> _last_sent_config
+  std::shared_ptr<const agent::MessageToAgent> _last_sent_config
       ABSL_GUARDED_BY(_protect);
 
-  static std::set<std::shared_ptr<agent_impl>>* _instances
+  static absl::flat_hash_set<std::shared_ptr<agent_impl>>* _instances
       ABSL_GUARDED_BY(_instances_m);
   static absl::Mutex _instances_m;
 
   bool _write_pending;
-  std::deque<std::shared_ptr<agent::MessageToAgent>> _write_queue
+  std::deque<std::shared_ptr<const agent::MessageToAgent>> _write_queue
       ABSL_GUARDED_BY(_protect);
   std::shared_ptr<agent::MessageFromAgent> _read_current
       ABSL_GUARDED_BY(_protect);
 
-  void _calc_and_send_config_if_needed();
+  /**
+   * @brief configurations calculated during one pass in the main thread.
+   * Agents that supervise the same host with the same credentials mode share
+   * the same immutable message.
+   */
+  using config_cache =
+      absl::flat_hash_map<std::pair<std::string, bool>,
+                          std::shared_ptr<const agent::MessageToAgent>>;
+
+  void _calc_and_send_config_if_needed(config_cache& cache);
+
+  std::shared_ptr<const agent::MessageToAgent> _calc_config(
+      const agent_config& conf,
+      const std::string& host,
+      bool crypt_credentials);
 
   virtual const std::string& get_peer() const = 0;
 
-  void _write(const std::shared_ptr<agent::MessageToAgent>& request);
+  void _write(const std::shared_ptr<const agent::MessageToAgent>& request);
 
  protected:
   std::shared_ptr<spdlog::logger> _logger;
@@ -26,7 +26,7 @@
 namespace com::centreon::engine::modules::opentelemetry::centreon_agent {
 
 class agent_stat : public std::enable_shared_from_this<agent_stat> {
-  using agent_info_set = std::set<const void*>;
+  using agent_info_set = absl::flat_hash_set<const void*>;
   struct group_by_key
       : public std::tuple<
             unsigned /*agent major version*/,
@@ -0,0 +1,70 @@
+/**
+ * Copyright 2025 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCE_MOD_OTL_CENTREON_AGENT_CONNECTION_POOL_HH
+#define CCE_MOD_OTL_CENTREON_AGENT_CONNECTION_POOL_HH
+
+#include <absl/synchronization/mutex.h>
+#include <thread>
+
+namespace com::centreon::engine::modules::opentelemetry::centreon_agent {
+
+/**
+ * @brief io_contexts dedicated to agent connections.
+ * Each new connection is given one of these io_contexts in a round robin way,
+ * each one is run by its own thread. Socket io of agent streams is done by
+ * grpc threads, but a connection that owns a pool io_context handles the
+ * received messages (init, configuration calculation, otel data) in it, so
+ * grpc threads are given back as soon as a message is read and the messages
+ * of a connection are still handled in order.
+ * Default size is given by centreon_agent connection_threads. With 0, there
+ * is no sharding: connections use the io_context given by caller and handle
+ * messages in grpc threads.
+ * Like common::pool, size can only be increased. Container is never deleted
+ * because threads terminate in unknown order.
+ */
+class connection_pool {
+  struct shard {
+    std::shared_ptr<asio::io_context> io_context;
+    asio::executor_work_guard<asio::io_context::executor_type> worker;
+    std::thread thread;
+
+    shard(size_t index, const std::shared_ptr<spdlog::logger>& logger);
+  };
+
+  static std::vector<shard*>* _shards ABSL_GUARDED_BY(_protect);
+  static size_t _next ABSL_GUARDED_BY(_protect);
+  static absl::Mutex _protect;
+
+ public:
+  static void set_size(size_t nb_threads,
+                       const std::shared_ptr<spdlog::logger>& logger);
+
+  static std::shared_ptr<asio::io_context> get_io_context(
+      const std::shared_ptr<asio::io_context>& default_io_context);
+
+  static size_t size();
+
+  static bool owns(const std::shared_ptr<asio::io_context>& io_context);
+
+  static void stop();
+};
+
+}  // namespace com::centreon::engine::modules::opentelemetry::centreon_agent
+
+#endif
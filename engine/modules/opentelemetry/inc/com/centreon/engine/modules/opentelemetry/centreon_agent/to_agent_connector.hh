@@ -40,7 +40,7 @@ class to_agent_connector
       public std::enable_shared_from_this<to_agent_connector> {
   std::shared_ptr<boost::asio::io_context> _io_context;
   metric_handler _metric_handler;
-  agent_config::pointer _conf;
+  agent_config::pointer _conf ABSL_GUARDED_BY(_connection_m);
 
   bool _alive;
   std::unique_ptr<agent::ReversedAgentService::Stub> _stub;
@@ -70,8 +70,7 @@ class to_agent_connector
       const std::shared_ptr<spdlog::logger>& logger,
       const agent_stat::pointer& stats);
 
-  void refresh_agent_configuration_if_needed(
-      const agent_config::pointer& new_conf);
+  void update_agent_configuration(const agent_config::pointer& new_conf);
 
   virtual void shutdown();
 
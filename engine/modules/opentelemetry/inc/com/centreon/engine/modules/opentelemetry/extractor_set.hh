@@ -0,0 +1,79 @@
+/**
+ * Copyright 2025 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#ifndef CCE_MOD_OTL_EXTRACTOR_SET_HH
+#define CCE_MOD_OTL_EXTRACTOR_SET_HH
+
+#include "host_serv_extractor.hh"
+#include "otl_check_result_builder.hh"
+
+namespace com::centreon::engine::modules::opentelemetry {
+
+/**
+ * @brief data points grouped by host and service, string_views point to the
+ * content of the requests owned by the data points
+ */
+using host_serv_data_points =
+    absl::flat_hash_map<std::pair<std::string_view, std::string_view>,
+                        metric_to_datapoints>;
+
+/**
+ * @brief Immutable set of host serv extractors.
+ * open_telemetry builds a new one each time an extractor is added or removed,
+ * or a host is added to or removed from the host_serv_list of an extractor,
+ * and swaps it atomically, so grpc threads extract host and service of their
+ * requests in parallel without any lock.
+ * Attributes extractors are grouped by the location of their host attribute,
+ * and in a group, indexed by the hosts of their host_serv_list: this attribute
+ * is read once per data point and per location, and only the extractors that
+ * know its value are tried.
+ */
+class extractor_set {
+  struct attribute_group {
+    host_serv_attributes_extractor::attribute_owner owner;
+    std::string key;
+    std::vector<std::shared_ptr<host_serv_attributes_extractor>> extractors;
+    /* host name => indexes in extractors of those that know it */
+    absl::flat_hash_map<std::string, absl::InlinedVector<size_t, 1>> by_host;
+  };
+
+  std::vector<attribute_group> _groups;
+  /* extractors that are not indexed, they are tried one after the other */
+  std::vector<std::shared_ptr<host_serv_extractor>> _others;
+  size_t _size = 0;
+
+ public:
+  using pointer = std::shared_ptr<const extractor_set>;
+
+  extractor_set() = default;
+  extractor_set(
+      const std::vector<std::shared_ptr<host_serv_extractor>>& extractors);
+
+  bool empty() const { return !_size; }
+  size_t size() const { return _size; }
+
+  host_serv_metric extract(const otl_data_point& data_pt) const;
+
+  void extract(const metric_request_ptr& request,
+               host_serv_data_points& known,
+               std::vector<otl_data_point>& unknown) const;
+};
+
+}  // namespace com::centreon::engine::modules::opentelemetry
+
+#endif  // !CCE_MOD_OTL_EXTRACTOR_SET_HH
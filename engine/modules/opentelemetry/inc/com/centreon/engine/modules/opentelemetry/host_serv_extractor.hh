@@ -19,6 +19,8 @@
 #ifndef CCE_MOD_OTL_SERVER_HOST_SERV_EXTRACTOR_HH
 #define CCE_MOD_OTL_SERVER_HOST_SERV_EXTRACTOR_HH
 
+#include <absl/container/inlined_vector.h>
+
 #include "com/centreon/engine/commands/otel_interface.hh"
 #include "otl_data_point.hh"
 
@@ -44,6 +46,9 @@ class host_serv_extractor : public commands::otel::host_serv_extractor {
   host_serv_extractor& operator=(const host_serv_extractor&) = delete;
 
   const std::string& get_command_line() const { return _command_line; }
+  const commands::otel::host_serv_list::pointer& get_host_serv_list() const {
+    return _host_serv_list;
+  }
 
   static std::shared_ptr<host_serv_extractor> create(
       const std::string& command_line,
@@ -108,7 +113,12 @@ host_serv_metric host_serv_extractor::is_allowed(
  *
  */
 class host_serv_attributes_extractor : public host_serv_extractor {
+ public:
   enum class attribute_owner { resource, scope, otl_data_point };
+  /* an attribute is usually present once, values are not deduplicated */
+  using attribute_values = absl::InlinedVector<std::string_view, 2>;
+
+ private:
   attribute_owner _host_path;
   std::string _host_key;
   attribute_owner _serv_path;
@@ -119,8 +129,19 @@ class host_serv_attributes_extractor : public host_serv_extractor {
       const std::string& command_line,
       const commands::otel::host_serv_list::pointer& host_serv_list);
 
+  attribute_owner get_host_path() const { return _host_path; }
+  const std::string& get_host_key() const { return _host_key; }
+
+  static attribute_values extract_attribute(const otl_data_point& data_pt,
+                                            attribute_owner owner,
+                                            const std::string& key);
+
   host_serv_metric extract_host_serv_metric(
       const otl_data_point& data_pt) const override;
+
+  host_serv_metric extract_host_serv_metric(
+      const otl_data_point& data_pt,
+      const attribute_values& hosts) const;
 };
 
 }  // namespace com::centreon::engine::modules::opentelemetry
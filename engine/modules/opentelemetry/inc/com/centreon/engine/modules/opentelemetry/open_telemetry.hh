@@ -22,8 +22,9 @@
 
 #include "com/centreon/engine/commands/otel_interface.hh"
 
+#include "broker_forwarder.hh"
 #include "centreon_agent/agent_reverse_client.hh"
-#include "host_serv_extractor.hh"
+#include "extractor_set.hh"
 #include "otl_check_result_builder.hh"
 #include "otl_config.hh"
 
@@ -41,7 +42,9 @@ class otl_server;
  * create_extractor() and check(). a second period timer is also used to process
  * check timeouts
  * All attributes are (timers, _conf, _otl_server) are protected by _protect
- * mutex
+ * mutex. on_metric() is called by several grpc threads and doesn't lock it,
+ * it only reads _extractor_set snapshot, unless the hosts of an extractor
+ * have changed and the snapshot must be rebuilt.
  *
  */
 class open_telemetry : public commands::otel::open_telemetry_base {
@@ -52,6 +55,12 @@ class open_telemetry : public commands::otel::open_telemetry_base {
   using cmd_line_to_extractor_map =
       absl::btree_map<std::string, std::shared_ptr<host_serv_extractor>>;
   cmd_line_to_extractor_map _extractors;
+  /* snapshot of _extractors used by on_metric, it's read and replaced with
+   * std::atomic_load and std::atomic_store */
+  extractor_set::pointer _extractor_set;
+  /* set when a host is added to or removed from the host_serv_list of an
+   * extractor, _extractor_set is then rebuilt by the next on_metric */
+  std::atomic_bool _extractor_set_outdated = false;
   std::string _config_file_path;
   std::unique_ptr<otl_config> _conf;
   std::shared_ptr<spdlog::logger> _logger;
@@ -61,6 +70,17 @@ class open_telemetry : public commands::otel::open_telemetry_base {
 
   centreon_agent::agent_stat::pointer _agent_stats;
 
+  broker_forwarder::pointer _broker_forwarder;
+
+  /* data points waiting for the main thread */
+  std::mutex _pending_m;
+  host_serv_data_points _pending;
+  bool _pending_posted = false;
+
+  void _update_extractor_set();
+  void _post_data_points(host_serv_data_points&& known);
+  void _process_data_points();
+
   void _forward_to_broker(const std::vector<otl_data_point>& unknown);
 
   void _create_telegraf_conf_server(
@@ -98,6 +118,10 @@ class open_telemetry : public commands::otel::open_telemetry_base {
 
   void on_metric(const metric_request_ptr& metric);
 
+  const broker_forwarder::pointer& get_broker_forwarder() const {
+    return _broker_forwarder;
+  }
+
   std::shared_ptr<commands::otel::host_serv_extractor> create_extractor(
       const std::string& cmdline,
       const commands::otel::host_serv_list::pointer& host_serv_list) override;
@@ -78,8 +78,7 @@ class otl_check_result_builder
 
   virtual void dump(std::string& output) const;
 
-  void process_data_pts(const std::string_view& host,
-                        const std::string_view& serv,
+  void process_data_pts(notifier* host_or_serv,
                         const metric_to_datapoints& data_pts) override;
 
   static std::shared_ptr<otl_check_result_builder> create(
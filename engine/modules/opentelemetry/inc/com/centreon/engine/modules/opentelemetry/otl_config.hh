@@ -19,6 +19,7 @@
 #ifndef CCE_MOD_OTL_SERVER_OTLCONFIG_HH
 #define CCE_MOD_OTL_SERVER_OTLCONFIG_HH
 
+#include "broker_forwarder.hh"
 #include "centreon_agent/agent_config.hh"
 #include "grpc_config.hh"
 #include "telegraf/conf_server.hh"
@@ -34,6 +35,8 @@ class otl_config {
   bool _json_grpc_log = false;    // if true, otel object are logged in json
                                   // format instead of protobuf debug format
 
+  broker_forward_config _broker_forward_config;
+
  public:
   otl_config(const std::string_view& file_path, asio::io_context& io_context);
 
@@ -50,6 +53,10 @@ class otl_config {
   int get_max_length_grpc_log() const { return _max_length_grpc_log; }
   bool get_json_grpc_log() const { return _json_grpc_log; }
 
+  const broker_forward_config& get_broker_forward_config() const {
+    return _broker_forward_config;
+  }
+
   bool operator==(const otl_config& right) const;
 
   inline bool operator!=(const otl_config& right) const {
@@ -0,0 +1,388 @@
+/**
+ * Copyright 2025 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/engine/broker.hh"
+#include "com/centreon/engine/command_manager.hh"
+#include "com/centreon/engine/nebstructs.hh"
+#include "com/centreon/engine/service.hh"
+
+#include "broker_forwarder.hh"
+
+using namespace com::centreon::engine::modules::opentelemetry;
+using namespace ::opentelemetry::proto::metrics::v1;
+
+/**
+ * @brief Construct a new broker forwarder object
+ *
+ * @param io_context used by the flush timer
+ * @param logger
+ * @param handler called on each batch, send_to_broker by default
+ * @param sync_handler called from the main thread on the last batch by
+ * shutdown(), write_to_broker by default
+ */
+broker_forwarder::broker_forwarder(
+    const std::shared_ptr<asio::io_context>& io_context,
+    const std::shared_ptr<spdlog::logger>& logger,
+    batch_handler&& handler,
+    batch_handler&& sync_handler)
+    : _io_context(io_context),
+      _logger(logger),
+      _handler(std::move(handler)),
+      _sync_handler(std::move(sync_handler)),
+      _flush_timer(*io_context) {}
+
+/**
+ * @brief default batch handler, batch is sent to broker from the main thread
+ *
+ * @param batch
+ */
+void broker_forwarder::send_to_broker(const metric_request_ptr& batch) {
+  auto fn = std::packaged_task<int(void)>([batch]() {
+    write_to_broker(batch);
+    return OK;
+  });
+  command_manager::instance().enqueue(std::move(fn));
+}
+
+/**
+ * @brief send a batch to broker, caution: must be called from the main thread
+ *
+ * @param batch
+ */
+void broker_forwarder::write_to_broker(const metric_request_ptr& batch) {
+  add_resource_ids(*batch);
+  nebstruct_otl_metrics_data to_send{batch};
+  broker_otl_metrics(to_send);
+}
+
+/**
+ * @brief add host_id and service_id int attributes to the resources whose
+ * host.name and service.name attributes name an engine service. Broker only
+ * stores the data points of these resources. Caution: service::services is
+ * read, so it must be called from the main thread
+ *
+ * @param batch
+ */
+void broker_forwarder::add_resource_ids(
+    ::opentelemetry::proto::collector::metrics::v1::ExportMetricsServiceRequest&
+        batch) {
+  for (ResourceMetrics& resource : *batch.mutable_resource_metrics()) {
+    std::string_view hst, serv;
+    for (const auto& key_val : resource.resource().attributes()) {
+      if (!key_val.value().has_string_value())
+        continue;
+      if (key_val.key() == "host.name")
+        hst = key_val.value().string_value();
+      else if (key_val.key() == "service.name")
+        serv = key_val.value().string_value();
+    }
+    if (hst.empty() || serv.empty())
+      continue;
+    auto found = service::services.find(std::make_pair(hst, serv));
+    if (found == service::services.end())
+      continue;
+    auto* attributes = resource.mutable_resource()->mutable_attributes();
+    auto* host_id = attributes->Add();
+    host_id->set_key("host_id");
+    host_id->mutable_value()->set_int_value(found->second->host_id());
+    auto* service_id = attributes->Add();
+    service_id->set_key("service_id");
+    service_id->mutable_value()->set_int_value(found->second->service_id());
+  }
+}
+
+/**
+ * @brief the source of a data point is the host.name attribute of its
+ * resource
+ *
+ * @param data_pt
+ * @return std::string empty if not found
+ */
+std::string broker_forwarder::get_source(const otl_data_point& data_pt) {
+  for (const auto& key_val : data_pt.get_resource().attributes()) {
+    if (key_val.key() == "host.name" && key_val.value().has_string_value())
+      return key_val.value().string_value();
+  }
+  return {};
+}
+
+void broker_forwarder::update_config(const broker_forward_config& conf) {
+  metric_request_ptr to_send;
+  {
+    absl::MutexLock l(&_protect);
+    _conf = conf;
+    if (!_conf.enabled || _batch_size >= _conf.batch_size)
+      to_send = _pop_batch();
+  }
+  if (to_send)
+    _handler(to_send);
+}
+
+/**
+ * @brief rate limit of a source
+ *
+ * @return true if the data point can be forwarded
+ */
+bool broker_forwarder::_accept(const std::string& source, time_t now) {
+  if (!_conf.max_points_per_source)
+    return true;
+  if (now != _rate_second) {
+    _rate_second = now;
+    _source_points.clear();
+  }
+  unsigned& received = _source_points[source];
+  if (received >= _conf.max_points_per_source) {
+    if (received++ == _conf.max_points_per_source)
+      SPDLOG_LOGGER_WARN(_logger,
+                         "more than {} data points per second received from "
+                         "'{}', data points are dropped",
+                         _conf.max_points_per_source, source);
+    return false;
+  }
+  ++received;
+  return true;
+}
+
+/**
+ * @brief the service of a data point is the service.name attribute of its
+ * resource
+ *
+ * @param data_pt
+ * @return std::string empty if not found
+ */
+std::string broker_forwarder::get_service(const otl_data_point& data_pt) {
+  for (const auto& key_val : data_pt.get_resource().attributes()) {
+    if (key_val.key() == "service.name" && key_val.value().has_string_value())
+      return key_val.value().string_value();
+  }
+  return {};
+}
+
+/**
+ * @brief copy a data point in the batch, resource, scope and metric are
+ * created only if they are not yet in the batch
+ *
+ * @param source
+ * @param data_pt
+ */
+void broker_forwarder::_add(const std::string& source,
+                            const otl_data_point& data_pt) {
+  if (!_batch)
+    _batch = std::make_shared<::opentelemetry::proto::collector::metrics::v1::
+                                  ExportMetricsServiceRequest>();
+
+  ResourceMetrics*& resource = _resources[{source, get_service(data_pt)}];
+  if (!resource) {
+    resource = _batch->add_resource_metrics();
+    *resource->mutable_resource() = data_pt.get_resource();
+  }
+
+  const auto& pb_scope = data_pt.get_scope();
+  ScopeMetrics*& scope = _scopes[{resource, pb_scope.name()}];
+  if (!scope) {
+    scope = resource->add_scope_metrics();
+    *scope->mutable_scope() = pb_scope;
+  }
+
+  const Metric& pb_metric = data_pt.get_metric();
+  Metric*& metric = _metrics[{scope, pb_metric.name()}];
+  if (!metric) {
+    metric = scope->add_metrics();
+    metric->set_name(pb_metric.name());
+    metric->set_description(pb_metric.description());
+    metric->set_unit(pb_metric.unit());
+    switch (pb_metric.data_case()) {
+      case Metric::kGauge:
+        metric->mutable_gauge();
+        break;
+      case Metric::kSum:
+        metric->mutable_sum()->set_aggregation_temporality(
+            pb_metric.sum().aggregation_temporality());
+        metric->mutable_sum()->set_is_monotonic(
+            pb_metric.sum().is_monotonic());
+        break;
+      case Metric::kHistogram:
+        metric->mutable_histogram()->set_aggregation_temporality(
+            pb_metric.histogram().aggregation_temporality());
+        break;
+      case Metric::kExponentialHistogram:
+        metric->mutable_exponential_histogram()->set_aggregation_temporality(
+            pb_metric.exponential_histogram().aggregation_temporality());
+        break;
+      case Metric::kSummary:
+        metric->mutable_summary();
+        break;
+      default:
+        break;
+    }
+  }
+
+  /* a metric name can't be reused with another type, in that case the data
+   * point is dropped */
+  if (metric->data_case() != pb_metric.data_case()) {
+    ++_dropped;
+    return;
+  }
+
+  const google::protobuf::Message& pb_data_pt = data_pt.get_data_point();
+  switch (pb_metric.data_case()) {
+    case Metric::kGauge:
+      metric->mutable_gauge()->add_data_points()->CopyFrom(pb_data_pt);
+      break;
+    case Metric::kSum:
+      metric->mutable_sum()->add_data_points()->CopyFrom(pb_data_pt);
+      break;
+    case Metric::kHistogram:
+      metric->mutable_histogram()->add_data_points()->CopyFrom(pb_data_pt);
+      break;
+    case Metric::kExponentialHistogram:
+      metric->mutable_exponential_histogram()->add_data_points()->CopyFrom(
+          pb_data_pt);
+      break;
+    case Metric::kSummary:
+      metric->mutable_summary()->add_data_points()->CopyFrom(pb_data_pt);
+      break;
+    default:
+      return;
+  }
+  ++_batch_size;
+  ++_forwarded;
+}
+
+/**
+ * @brief take the current batch and reset indexes
+ *
+ * @return metric_request_ptr null if batch is empty
+ */
+metric_request_ptr broker_forwarder::_pop_batch() {
+  metric_request_ptr ret;
+  if (_batch_size) {
+    ret = std::move(_batch);
+    ++_batches;
+  }
+  _batch.reset();
+  _batch_size = 0;
+  _resources.clear();
+  _scopes.clear();
+  _metrics.clear();
+  return ret;
+}
+
+/**
+ * @brief data points not matched by any extractor are passed to this method
+ *
+ * @param data_pts
+ * @param now used by rate limit
+ */
+void broker_forwarder::on_data_points(
+    const std::vector<otl_data_point>& data_pts,
+    time_t now) {
+  std::vector<metric_request_ptr> to_send;
+  {
+    absl::MutexLock l(&_protect);
+    if (!_conf.enabled) {
+      SPDLOG_LOGGER_TRACE(_logger,
+                          "forward to broker disabled, {} data points dropped",
+                          data_pts.size());
+      return;
+    }
+    std::string source;
+    for (const otl_data_point& data_pt : data_pts) {
+      source = get_source(data_pt);
+      if (!_accept(source, now)) {
+        ++_dropped;
+        continue;
+      }
+      _add(source, data_pt);
+      if (_batch_size >= _conf.batch_size)
+        to_send.push_back(_pop_batch());
+    }
+    if (_batch_size && !_flush_timer_armed)
+      _start_flush_timer();
+  }
+  for (const metric_request_ptr& batch : to_send) {
+    SPDLOG_LOGGER_DEBUG(_logger, "forward batch of {} resources to broker",
+                        batch->resource_metrics_size());
+    _handler(batch);
+  }
+}
+
+void broker_forwarder::_start_flush_timer() {
+  _flush_timer_armed = true;
+  _flush_timer.expires_after(_conf.max_delay);
+  _flush_timer.async_wait(
+      [me = shared_from_this()](const boost::system::error_code& err) {
+        me->_flush_timer_handler(err);
+      });
+}
+
+void broker_forwarder::_flush_timer_handler(
+    const boost::system::error_code& err) {
+  {
+    absl::MutexLock l(&_protect);
+    _flush_timer_armed = false;
+  }
+  if (!err)
+    flush();
+}
+
+/**
+ * @brief send the current batch even if it's not full
+ *
+ */
+void broker_forwarder::flush() {
+  metric_request_ptr to_send;
+  {
+    absl::MutexLock l(&_protect);
+    to_send = _pop_batch();
+  }
+  if (to_send)
+    _handler(to_send);
+}
+
+/**
+ * @brief to call on module unload, from the main thread. The pending batch is
+ * given to the sync handler instead of being enqueued as a main thread task
+ * that would run after unload.
+ *
+ */
+void broker_forwarder::shutdown() {
+  metric_request_ptr to_send;
+  {
+    absl::MutexLock l(&_protect);
+    _flush_timer.cancel();
+    to_send = _pop_batch();
+  }
+  if (to_send)
+    _sync_handler(to_send);
+}
+
+uint64_t broker_forwarder::get_forwarded() const {
+  absl::MutexLock l(&_protect);
+  return _forwarded;
+}
+
+uint64_t broker_forwarder::get_dropped() const {
+  absl::MutexLock l(&_protect);
+  return _dropped;
+}
+
+uint64_t broker_forwarder::get_batches() const {
+  absl::MutexLock l(&_protect);
+  return _batches;
+}
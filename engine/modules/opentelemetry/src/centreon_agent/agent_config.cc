@@ -45,6 +45,21 @@ static constexpr std::string_view _config_schema(R"(
             "type": "integer",
             "minimum": 1
         },
+        "max_batch_size": {
+            "description": "size in bytes from which agent sends check results, 0: 2MB",
+            "type": "integer",
+            "minimum": 0
+        },
+        "max_batch_delay": {
+            "description": "longest wait of a check result on agent side in ms, 0: export_period",
+            "type": "integer",
+            "minimum": 0
+        },
+        "connection_threads": {
+            "description": "number of threads dedicated to agent connections (default 2), 0: engine and grpc threads",
+            "type": "integer",
+            "minimum": 0
+        },
         "reverse_connections": {
             "description": "array of agent endpoints (reverse mode, engine connects to centreon-agent) ",
             "type": "array",
@@ -60,6 +75,7 @@ static constexpr std::string_view _config_schema(R"(
 constexpr unsigned default_max_concurrent_checks = 100;
 constexpr unsigned default_export_period = 60;
 constexpr unsigned default_check_timeout = 120;
+constexpr unsigned default_connection_threads = 2;
 
 /**
  * @brief Construct a new agent config::agent from json data
@@ -79,6 +95,10 @@ agent_config::agent_config(const rapidjson::Value& json_config_v) {
       file_content.get_unsigned("export_period", default_export_period);
   _check_timeout =
       file_content.get_unsigned("check_timeout", default_check_timeout);
+  _max_batch_size = file_content.get_unsigned("max_batch_size", 0);
+  _max_batch_delay = file_content.get_unsigned("max_batch_delay", 0);
+  _connection_threads = file_content.get_unsigned(
+      "connection_threads", default_connection_threads);
 
   if (file_content.has_member("reverse_connections")) {
     const auto& reverse_array = file_content.get_member("reverse_connections");
@@ -97,7 +117,8 @@ agent_config::agent_config(const rapidjson::Value& json_config_v) {
 agent_config::agent_config()
     : _max_concurrent_checks(default_max_concurrent_checks),
       _export_period(default_export_period),
-      _check_timeout(default_check_timeout) {}
+      _check_timeout(default_check_timeout),
+      _connection_threads(default_connection_threads) {}
 
 /**
  * @brief Constructor used by tests
@@ -142,6 +163,9 @@ bool agent_config::operator==(const agent_config& right) const {
   if (_max_concurrent_checks != right._max_concurrent_checks ||
       _export_period != right._export_period ||
       _check_timeout != right._check_timeout ||
+      _max_batch_size != right._max_batch_size ||
+      _max_batch_delay != right._max_batch_delay ||
+      _connection_threads != right._connection_threads ||
       _agent_grpc_reverse_conf.size() != right._agent_grpc_reverse_conf.size())
     return false;
 
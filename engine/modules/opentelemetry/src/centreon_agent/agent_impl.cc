@@ -19,6 +19,7 @@
 #include <google/protobuf/util/message_differencer.h>
 
 #include "centreon_agent/agent_impl.hh"
+#include "centreon_agent/connection_pool.hh"
 #include "com/centreon/engine/globals.hh"
 #include "common/crypto/base64.hh"
 
@@ -28,6 +29,73 @@
 
 using namespace com::centreon::engine::modules::opentelemetry::centreon_agent;
 
+namespace com::centreon::engine::modules::opentelemetry::centreon_agent {
+
+/**
+ * @brief agents configured with service_scopes send one ResourceMetrics per
+ * host whose ScopeMetrics carry the service.name attribute. This function
+ * gives back one ResourceMetrics per service, with host.name and
+ * service.name resource attributes, as extractors and broker expect them.
+ * Requests of older agents are not modified.
+ *
+ * @param request
+ */
+void split_service_scopes(
+    ::opentelemetry::proto::collector::metrics::v1::ExportMetricsServiceRequest&
+        request) {
+  using ::opentelemetry::proto::common::v1::KeyValue;
+  using ::opentelemetry::proto::metrics::v1::ResourceMetrics;
+  using ::opentelemetry::proto::metrics::v1::ScopeMetrics;
+
+  auto is_service = [](const KeyValue& key_val) {
+    return key_val.key() == "service.name";
+  };
+  auto* resources = request.mutable_resource_metrics();
+  std::vector<int> emptied;
+  for (int res_index = 0, nb_resources = resources->size();
+       res_index < nb_resources; ++res_index) {
+    ResourceMetrics* grouped = resources->Mutable(res_index);
+    if (std::none_of(grouped->scope_metrics().begin(),
+                     grouped->scope_metrics().end(),
+                     [&is_service](const ScopeMetrics& scope) {
+                       return std::any_of(scope.scope().attributes().begin(),
+                                          scope.scope().attributes().end(),
+                                          is_service);
+                     })) {
+      continue;
+    }
+    google::protobuf::RepeatedPtrField<ScopeMetrics> scopes;
+    scopes.Swap(grouped->mutable_scope_metrics());
+    for (ScopeMetrics& scope : scopes) {
+      auto* attributes = scope.mutable_scope()->mutable_attributes();
+      auto serv = std::find_if(attributes->begin(), attributes->end(),
+                               is_service);
+      if (serv == attributes->end()) {
+        grouped->add_scope_metrics()->Swap(&scope);
+        continue;
+      }
+      // resources->Add() doesn't move other elements, grouped stays valid
+      ResourceMetrics* by_service = resources->Add();
+      *by_service->mutable_resource() = grouped->resource();
+      by_service->mutable_resource()->add_attributes()->Swap(&*serv);
+      attributes->erase(serv);
+      if (attributes->empty() && scope.scope().name().empty()) {
+        scope.clear_scope();
+      }
+      by_service->add_scope_metrics()->Swap(&scope);
+    }
+    if (grouped->scope_metrics().empty()) {
+      emptied.push_back(res_index);
+    }
+  }
+  for (auto to_erase = emptied.rbegin(); to_erase != emptied.rend();
+       ++to_erase) {
+    resources->DeleteSubrange(*to_erase, 1);
+  }
+}
+
+}  // namespace com::centreon::engine::modules::opentelemetry::centreon_agent
+
 /**
  * @brief when BiReactor::OnDone is called by grpc layers, we should delete
  * this. But this object is even used by others.
@@ -38,9 +106,9 @@ using namespace com::centreon::engine::modules::opentelemetry::centreon_agent;
  * @tparam bireactor_class
  */
 template <class bireactor_class>
-std::set<std::shared_ptr<agent_impl<bireactor_class>>>*
+absl::flat_hash_set<std::shared_ptr<agent_impl<bireactor_class>>>*
     agent_impl<bireactor_class>::_instances =
-        new std::set<std::shared_ptr<agent_impl<bireactor_class>>>;
+        new absl::flat_hash_set<std::shared_ptr<agent_impl<bireactor_class>>>;
 
 template <class bireactor_class>
 absl::Mutex agent_impl<bireactor_class>::_instances_m;
@@ -65,6 +133,7 @@ agent_impl<bireactor_class>::agent_impl(
     bool is_crypted,
     const agent_stat::pointer& stats)
     : _io_context(io_context),
+      _pooled(connection_pool::owns(io_context)),
       _class_name(class_name),
       _reversed(reversed),
       _is_crypted(is_crypted),
@@ -91,6 +160,7 @@ agent_impl<bireactor_class>::agent_impl(
     const agent_stat::pointer& stats,
     const std::chrono::system_clock::time_point& exp_time)
     : _io_context(io_context),
+      _pooled(connection_pool::owns(io_context)),
       _class_name(class_name),
       _reversed(reversed),
       _is_crypted(is_crypted),
@@ -137,7 +207,8 @@ void agent_impl<bireactor_class>::calc_and_send_config_if_needed(
            shared_from_this()]() mutable -> int32_t {
         // then we are in the main thread
         // services, hosts and commands are stable
-        me->_calc_and_send_config_if_needed();
+        config_cache cache;
+        me->_calc_and_send_config_if_needed(cache);
         return 0;
       });
   command_manager::instance().enqueue(std::move(to_call));
@@ -145,16 +216,37 @@ void agent_impl<bireactor_class>::calc_and_send_config_if_needed(
 
 /**
  * @brief static method used to push new configuration to all agents
+ * All agents are processed by only one task in the main thread, so
+ * configuration of each host is calculated only once
  *
  * @tparam bireactor_class
  */
 template <class bireactor_class>
 void agent_impl<bireactor_class>::all_agent_calc_and_send_config_if_needed(
     const agent_config::pointer& new_conf) {
-  absl::MutexLock l(&_instances_m);
-  for (auto& instance : *_instances) {
-    instance->calc_and_send_config_if_needed(new_conf);
+  std::vector<std::shared_ptr<agent_impl>> instances;
+  {
+    absl::MutexLock l(&_instances_m);
+    instances.assign(_instances->begin(), _instances->end());
+  }
+  if (instances.empty()) {
+    return;
   }
+  for (const std::shared_ptr<agent_impl>& instance : instances) {
+    absl::MutexLock l(&instance->_protect);
+    instance->_conf = new_conf;
+  }
+  auto to_call = std::packaged_task<int(void)>(
+      [instances = std::move(instances)]() mutable -> int32_t {
+        // then we are in the main thread
+        // services, hosts and commands are stable
+        config_cache cache;
+        for (const std::shared_ptr<agent_impl>& instance : instances) {
+          instance->_calc_and_send_config_if_needed(cache);
+        }
+        return 0;
+      });
+  command_manager::instance().enqueue(std::move(to_call));
 }
 
 static bool add_command_to_agent_conf(
@@ -201,79 +293,121 @@ static bool add_command_to_agent_conf(
  * agent
  *
  * @tparam bireactor_class
+ * @param cache configurations already calculated in this main thread pass
  */
 template <class bireactor_class>
-void agent_impl<bireactor_class>::_calc_and_send_config_if_needed() {
-  std::shared_ptr<agent::MessageToAgent> new_conf =
-      std::make_shared<agent::MessageToAgent>();
+void agent_impl<bireactor_class>::_calc_and_send_config_if_needed(
+    config_cache& cache) {
+  agent_config::pointer conf;
+  std::string host;
+  bool crypt_credentials = false;
   {
-    agent::AgentConfiguration* cnf = new_conf->mutable_config();
-    cnf->set_check_timeout(_conf->get_check_timeout());
-    cnf->set_export_period(_conf->get_export_period());
-    cnf->set_max_concurrent_checks(_conf->get_max_concurrent_checks());
-    cnf->set_use_exemplar(true);
-    bool crypt_credentials = false;
+    absl::MutexLock l(&_protect);
+    if (!_alive) {
+      return;
+    }
+    conf = _conf;
+    if (_agent_info) {
+      host = _agent_info->init().host();
+    }
     if (!_is_crypted) {
       SPDLOG_LOGGER_INFO(_logger,
                          "As connection is not encrypted, Engine will send no "
                          "encrypted credentials to agent {}",
-                         *new_conf);
+                         get_peer());
     } else if (!_agent_can_receive_encrypted_credentials) {
       SPDLOG_LOGGER_INFO(
           _logger,
           "Agent is not credentials encrypted ready, Engine will send no "
           "encrypted credentials to agent {}",
-          *new_conf);
+          get_peer());
     } else if (pb_config.credentials_encryption() && credentials_decrypt) {
-      cnf->set_key(
-          common::crypto::base64_encode(credentials_decrypt->first_key()));
-      cnf->set_salt(
-          common::crypto::base64_encode(credentials_decrypt->second_key()));
       SPDLOG_LOGGER_INFO(_logger,
                          "Engine will send encrypted credentials to agent {}",
-                         *new_conf);
+                         get_peer());
       crypt_credentials = true;
     } else {
       SPDLOG_LOGGER_INFO(
           _logger, "Engine will send no encrypted credentials to agent {}",
-          *new_conf);
+          get_peer());
     }
+  }
 
+  std::shared_ptr<const agent::MessageToAgent>& new_conf =
+      cache[std::make_pair(host, crypt_credentials)];
+  if (!new_conf) {
+    new_conf = _calc_config(*conf, host, crypt_credentials);
+  }
+
+  {
     absl::MutexLock l(&_protect);
     if (!_alive) {
       return;
     }
-    if (_agent_info) {
-      const std::string& peer = get_peer();
-      bool at_least_one_command_found = get_otel_commands(
-          _agent_info->init().host(),
-          [cnf, &peer, crypt_credentials](
-              const std::string& cmd_name, const std::string& cmd_line,
-              const std::string& service, uint32_t check_interval,
-              const std::shared_ptr<spdlog::logger>& logger) {
-            return add_command_to_agent_conf(cmd_name, cmd_line, service,
-                                             check_interval, cnf, logger, peer,
-                                             crypt_credentials);
-          },
-          _whitelist_cache, _logger);
-      if (!at_least_one_command_found) {
-        SPDLOG_LOGGER_ERROR(_logger, "no command found for agent {}",
-                            get_peer());
-      }
-    }
-    if (!_last_sent_config ||
-        !::google::protobuf::util::MessageDifferencer::Equals(
-            *cnf, _last_sent_config->config())) {
-      _last_sent_config = new_conf;
-    } else {
-      new_conf.reset();
+    if (_last_sent_config &&
+        (_last_sent_config == new_conf ||
+         ::google::protobuf::util::MessageDifferencer::Equals(
+             new_conf->config(), _last_sent_config->config()))) {
       SPDLOG_LOGGER_DEBUG(_logger, "no need to update conf to {}", get_peer());
+      return;
     }
+    _last_sent_config = new_conf;
   }
-  if (new_conf) {
-    SPDLOG_LOGGER_DEBUG(_logger, "send conf to {}", get_peer());
-    _write(new_conf);
+  SPDLOG_LOGGER_DEBUG(_logger, "send conf to {}", get_peer());
+  _write(new_conf);
+}
+
+/**
+ * @brief this function must be called in the engine main thread
+ * It calculates the configuration of the agents that supervise host
+ *
+ * @tparam bireactor_class
+ * @param conf
+ * @param host empty if agent has not yet sent its init message
+ * @param crypt_credentials if true, command lines are encrypted
+ * @return std::shared_ptr<const agent::MessageToAgent>
+ */
+template <class bireactor_class>
+std::shared_ptr<const com::centreon::agent::MessageToAgent>
+agent_impl<bireactor_class>::_calc_config(const agent_config& conf,
+                                          const std::string& host,
+                                          bool crypt_credentials) {
+  std::shared_ptr<agent::MessageToAgent> new_conf =
+      std::make_shared<agent::MessageToAgent>();
+  agent::AgentConfiguration* cnf = new_conf->mutable_config();
+  cnf->set_check_timeout(conf.get_check_timeout());
+  cnf->set_export_period(conf.get_export_period());
+  cnf->set_max_concurrent_checks(conf.get_max_concurrent_checks());
+  cnf->set_max_batch_size(conf.get_max_batch_size());
+  cnf->set_max_batch_delay(conf.get_max_batch_delay());
+  cnf->set_service_scopes(true);
+  cnf->set_use_exemplar(true);
+  if (crypt_credentials) {
+    cnf->set_key(
+        common::crypto::base64_encode(credentials_decrypt->first_key()));
+    cnf->set_salt(
+        common::crypto::base64_encode(credentials_decrypt->second_key()));
+  }
+
+  if (!host.empty()) {
+    const std::string& peer = get_peer();
+    bool at_least_one_command_found = get_otel_commands(
+        host,
+        [cnf, &peer, crypt_credentials](
+            const std::string& cmd_name, const std::string& cmd_line,
+            const std::string& service, uint32_t check_interval,
+            const std::shared_ptr<spdlog::logger>& logger) {
+          return add_command_to_agent_conf(cmd_name, cmd_line, service,
+                                           check_interval, cnf, logger, peer,
+                                           crypt_credentials);
+        },
+        _whitelist_cache, _logger);
+    if (!at_least_one_command_found) {
+      SPDLOG_LOGGER_ERROR(_logger, "no command found for agent {}",
+                          get_peer());
+    }
   }
+  return new_conf;
 }
 
 /**
@@ -300,7 +434,23 @@ void agent_impl<bireactor_class>::on_request(
     calc_and_send_config_if_needed(agent_conf);
   }
   if (request->has_otel_request()) {
+    uint64_t newly_dropped = 0;
+    {
+      absl::MutexLock l(&_protect);
+      if (request->dropped_results() > _dropped_results) {
+        newly_dropped = request->dropped_results() - _dropped_results;
+        _dropped_results = request->dropped_results();
+      }
+    }
+    if (newly_dropped) {
+      SPDLOG_LOGGER_ERROR(_logger,
+                          "agent {} dropped {} check results because engine "
+                          "was too slow ({} since agent start)",
+                          get_peer(), newly_dropped,
+                          request->dropped_results());
+    }
     metric_request_ptr received(request->unsafe_arena_release_otel_request());
+    split_service_scopes(*received);
     _metric_handler(received);
   }
 }
@@ -313,7 +463,7 @@ void agent_impl<bireactor_class>::on_request(
  */
 template <class bireactor_class>
 void agent_impl<bireactor_class>::_write(
-    const std::shared_ptr<agent::MessageToAgent>& request) {
+    const std::shared_ptr<const agent::MessageToAgent>& request) {
   {
     absl::MutexLock l(&_protect);
     if (!_alive) {
@@ -383,7 +533,16 @@ void agent_impl<bireactor_class>::OnReadDone(bool ok) {
       _read_current.reset();
     }
     start_read();
-    on_request(readden);
+    if (_pooled) {
+      // grpc thread is given back, messages of this connection are handled
+      // in order by the only thread of its io_context
+      asio::post(*_io_context,
+                 [me = std::enable_shared_from_this<
+                      agent_impl<bireactor_class>>::shared_from_this(),
+                  readden]() { me->on_request(readden); });
+    } else {
+      on_request(readden);
+    }
   } else {
     SPDLOG_LOGGER_ERROR(_logger, "{:p} {} fail read from {}",
                         static_cast<void*>(this), _class_name, get_peer());
@@ -399,7 +558,7 @@ void agent_impl<bireactor_class>::OnReadDone(bool ok) {
  */
 template <class bireactor_class>
 void agent_impl<bireactor_class>::start_write() {
-  std::shared_ptr<agent::MessageToAgent> to_send;
+  std::shared_ptr<const agent::MessageToAgent> to_send;
   {
     absl::MutexLock l(&_protect);
     if (!_alive || _write_pending || _write_queue.empty()) {
@@ -516,11 +675,12 @@ void agent_impl<bireactor_class>::shutdown() {
  */
 template <class bireactor_class>
 void agent_impl<bireactor_class>::shutdown_all() {
-  std::set<std::shared_ptr<agent_impl>>* to_shutdown;
+  absl::flat_hash_set<std::shared_ptr<agent_impl>>* to_shutdown;
   {
     absl::MutexLock l(&_instances_m);
     to_shutdown = _instances;
-    _instances = new std::set<std::shared_ptr<agent_impl<bireactor_class>>>;
+    _instances =
+        new absl::flat_hash_set<std::shared_ptr<agent_impl<bireactor_class>>>;
   }
   for (std::shared_ptr<agent_impl> conn : *to_shutdown) {
     conn->shutdown();
@@ -17,6 +17,7 @@
  */
 
 #include "centreon_agent/agent_reverse_client.hh"
+#include "centreon_agent/connection_pool.hh"
 #include "centreon_agent/to_agent_connector.hh"
 
 using namespace com::centreon::engine::modules::opentelemetry::centreon_agent;
@@ -83,8 +84,7 @@ void agent_reverse_client::update(const agent_config::pointer& new_conf) {
       _shutdown_connection(connection_iterator);
       connection_iterator = _agents.erase(connection_iterator);
     } else {
-      connection_iterator->second->refresh_agent_configuration_if_needed(
-          new_conf);
+      connection_iterator->second->update_agent_configuration(new_conf);
       ++connection_iterator;
       ++conf_iterator;
     }
@@ -103,6 +103,7 @@ void agent_reverse_client::update(const agent_config::pointer& new_conf) {
 
 /**
  * @brief create and start a new agent reversed connection
+ * connection is given one of the connection_pool io_contexts
  *
  * @param agent_endpoint endpoint to connect
  * @param new_conf global agent configuration
@@ -115,8 +116,10 @@ agent_reverse_client::_create_new_client_connection(
     const agent_config::pointer& agent_conf) {
   auto insert_res = _agents.try_emplace(
       agent_endpoint,
-      to_agent_connector::load(agent_endpoint, _io_context, agent_conf,
-                               _metric_handler, _logger, _agent_stats));
+      to_agent_connector::load(agent_endpoint,
+                               connection_pool::get_io_context(_io_context),
+                               agent_conf, _metric_handler, _logger,
+                               _agent_stats));
   return insert_res.first;
 }
 
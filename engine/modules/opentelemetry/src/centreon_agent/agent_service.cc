@@ -17,6 +17,7 @@
  */
 
 #include "centreon_agent/agent_service.hh"
+#include "centreon_agent/connection_pool.hh"
 #include "common/crypto/jwt.hh"
 
 using namespace com::centreon::engine::modules::opentelemetry::centreon_agent;
@@ -233,8 +234,8 @@ agent_service::Export(::grpc::CallbackServerContext* context) {
   {
     absl::MutexLock l(&_conf_m);
     new_reactor = std::make_shared<server_bireactor>(
-        _io_context, _conf, _metric_handler, _logger, context->peer(),
-        _is_crypted, _stats, exp_time);
+        connection_pool::get_io_context(_io_context), _conf, _metric_handler,
+        _logger, context->peer(), _is_crypted, _stats, exp_time);
   }
   server_bireactor::register_stream(new_reactor);
   new_reactor->start_read();
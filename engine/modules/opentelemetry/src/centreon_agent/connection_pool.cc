@@ -0,0 +1,129 @@
+/**
+ * Copyright 2025 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "centreon_agent/connection_pool.hh"
+
+using namespace com::centreon::engine::modules::opentelemetry::centreon_agent;
+
+std::vector<connection_pool::shard*>* connection_pool::_shards =
+    new std::vector<connection_pool::shard*>;
+
+size_t connection_pool::_next = 0;
+
+absl::Mutex connection_pool::_protect;
+
+/**
+ * @brief create an io_context and the thread that runs it
+ *
+ * @param index used to name the thread
+ * @param logger
+ */
+connection_pool::shard::shard(size_t index,
+                              const std::shared_ptr<spdlog::logger>& logger)
+    : io_context(std::make_shared<asio::io_context>()),
+      worker(asio::make_work_guard(*io_context)),
+      thread([ctx = io_context, logger] {
+        try {
+          SPDLOG_LOGGER_INFO(logger, "start of agent connection thread {:x}",
+                             pthread_self());
+          ctx->run();
+        } catch (const std::exception& e) {
+          SPDLOG_LOGGER_CRITICAL(
+              logger, "catch in agent connection io_context run: {} {}",
+              e.what(), typeid(e).name());
+        }
+      }) {
+  pthread_setname_np(thread.native_handle(),
+                     fmt::format("agent_conn{}", index).c_str());
+}
+
+/**
+ * @brief start new threads if nb_threads is greater than the current size
+ *
+ * @param nb_threads
+ * @param logger
+ */
+void connection_pool::set_size(size_t nb_threads,
+                               const std::shared_ptr<spdlog::logger>& logger) {
+  absl::MutexLock l(&_protect);
+  if (nb_threads <= _shards->size()) {
+    if (nb_threads < _shards->size()) {
+      SPDLOG_LOGGER_WARN(logger,
+                         "agent connection threads can't be decreased from {} "
+                         "to {} without restart",
+                         _shards->size(), nb_threads);
+    }
+    return;
+  }
+  SPDLOG_LOGGER_INFO(logger, "start {} agent connection threads",
+                     nb_threads - _shards->size());
+  while (_shards->size() < nb_threads) {
+    _shards->push_back(new shard(_shards->size(), logger));
+  }
+}
+
+/**
+ * @brief io_context that a new connection will use
+ *
+ * @param default_io_context returned if pool is empty
+ * @return std::shared_ptr<asio::io_context>
+ */
+std::shared_ptr<asio::io_context> connection_pool::get_io_context(
+    const std::shared_ptr<asio::io_context>& default_io_context) {
+  absl::MutexLock l(&_protect);
+  if (_shards->empty()) {
+    return default_io_context;
+  }
+  return (*_shards)[_next++ % _shards->size()]->io_context;
+}
+
+size_t connection_pool::size() {
+  absl::MutexLock l(&_protect);
+  return _shards->size();
+}
+
+/**
+ * @brief tells if an io_context is one of the pool ones
+ *
+ * @param io_context
+ * @return true if io_context is run by a pool thread
+ */
+bool connection_pool::owns(
+    const std::shared_ptr<asio::io_context>& io_context) {
+  absl::MutexLock l(&_protect);
+  return std::any_of(
+      _shards->begin(), _shards->end(),
+      [&io_context](const shard* s) { return s->io_context == io_context; });
+}
+
+/**
+ * @brief stop all io_contexts and join threads, to call on module unload
+ * pending handlers are not executed
+ */
+void connection_pool::stop() {
+  absl::MutexLock l(&_protect);
+  for (shard* to_stop : *_shards) {
+    to_stop->worker.reset();
+    to_stop->io_context->stop();
+    if (to_stop->thread.joinable()) {
+      to_stop->thread.join();
+    }
+    delete to_stop;
+  }
+  _shards->clear();
+}
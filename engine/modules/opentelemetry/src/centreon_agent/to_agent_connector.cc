@@ -16,6 +16,8 @@
  * For more information : contact@centreon.com
  */
 
+#include <random>
+
 #include "com/centreon/common/defer.hh"
 
 #include "centreon_agent/to_agent_connector.hh"
@@ -193,16 +195,15 @@ void to_agent_connector::start() {
 }
 
 /**
- * @brief send conf to agent if something has changed (list of services,
- * commands...)
+ * @brief store agent configuration used by next connections
+ * Configuration of current connection is pushed to agent with all others by
+ * agent_impl::all_agent_calc_and_send_config_if_needed
  *
  */
-void to_agent_connector::refresh_agent_configuration_if_needed(
+void to_agent_connector::update_agent_configuration(
     const agent_config::pointer& new_conf) {
   absl::MutexLock l(&_connection_m);
-  if (_connection) {
-    _connection->calc_and_send_config_if_needed(new_conf);
-  }
+  _conf = new_conf;
 }
 
 /**
@@ -225,10 +226,16 @@ void to_agent_connector::shutdown() {
 
 /**
  * @brief called by connection
- * reconnection is delayed of 10 second
+ * reconnection is delayed of 10 to 15 seconds, so that thousands of agents
+ * that have lost their connection at the same time are not reconnected at the
+ * same time
  *
  */
 void to_agent_connector::on_error() {
-  common::defer(_io_context, std::chrono::seconds(10),
+  static thread_local std::mt19937 gen(std::random_device{}());
+  std::uniform_int_distribution<unsigned> jitter(0, 5000);
+  std::chrono::milliseconds delay =
+      std::chrono::seconds(10) + std::chrono::milliseconds(jitter(gen));
+  common::defer(_io_context, delay,
                 [me = shared_from_this()] { me->start(); });
 }
@@ -0,0 +1,113 @@
+/**
+ * Copyright 2025 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "extractor_set.hh"
+
+using namespace com::centreon::engine::modules::opentelemetry;
+
+/**
+ * @brief Construct a new extractor set object
+ *
+ * @param extractors extractors are grouped by host attribute location in the
+ * order of this vector, the hosts of their host_serv_list are copied in the
+ * index of their group
+ */
+extractor_set::extractor_set(
+    const std::vector<std::shared_ptr<host_serv_extractor>>& extractors)
+    : _size(extractors.size()) {
+  for (const std::shared_ptr<host_serv_extractor>& extractor : extractors) {
+    std::shared_ptr<host_serv_attributes_extractor> attributes_extractor =
+        std::dynamic_pointer_cast<host_serv_attributes_extractor>(extractor);
+    if (!attributes_extractor) {
+      _others.push_back(extractor);
+      continue;
+    }
+    auto group = std::find_if(
+        _groups.begin(), _groups.end(),
+        [&attributes_extractor](const attribute_group& grp) {
+          return grp.owner == attributes_extractor->get_host_path() &&
+                 grp.key == attributes_extractor->get_host_key();
+        });
+    if (group == _groups.end()) {
+      _groups.push_back({attributes_extractor->get_host_path(),
+                         attributes_extractor->get_host_key(),
+                         {},
+                         {}});
+      group = _groups.end() - 1;
+    }
+    size_t index = group->extractors.size();
+    for (std::string& host :
+         attributes_extractor->get_host_serv_list()->get_hosts())
+      group->by_host[std::move(host)].push_back(index);
+    group->extractors.push_back(std::move(attributes_extractor));
+  }
+}
+
+/**
+ * @brief find host and service of a data point
+ *
+ * @param data_pt
+ * @return host_serv_metric host is empty if no extractor matches
+ */
+host_serv_metric extractor_set::extract(const otl_data_point& data_pt) const {
+  for (const attribute_group& group : _groups) {
+    host_serv_attributes_extractor::attribute_values hosts =
+        host_serv_attributes_extractor::extract_attribute(data_pt, group.owner,
+                                                          group.key);
+    for (std::string_view host : hosts) {
+      auto candidates = group.by_host.find(host);
+      if (candidates == group.by_host.end())
+        continue;
+      for (size_t index : candidates->second) {
+        host_serv_metric ret =
+            group.extractors[index]->extract_host_serv_metric(data_pt, hosts);
+        if (!ret.host.empty())
+          return ret;
+      }
+    }
+  }
+  for (const auto& extractor : _others) {
+    host_serv_metric ret = extractor->extract_host_serv_metric(data_pt);
+    if (!ret.host.empty())
+      return ret;
+  }
+  return {};
+}
+
+/**
+ * @brief group the data points of a request by host and service
+ *
+ * @param request
+ * @param known data points with a host, they are added to this map
+ * @param unknown data points that no extractor matches
+ */
+void extractor_set::extract(const metric_request_ptr& request,
+                            host_serv_data_points& known,
+                            std::vector<otl_data_point>& unknown) const {
+  otl_data_point::extract_data_points(
+      request, [this, &known, &unknown](const otl_data_point& data_pt) {
+        host_serv_metric hostservmetric = extract(data_pt);
+        if (hostservmetric.host.empty()) {
+          unknown.push_back(data_pt);
+        } else {
+          known[std::make_pair(hostservmetric.host, hostservmetric.service)]
+               [data_pt.get_metric().name()]
+                   .insert(data_pt);
+        }
+      });
+}
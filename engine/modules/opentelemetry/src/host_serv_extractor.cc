@@ -155,6 +155,42 @@ host_serv_attributes_extractor::host_serv_attributes_extractor(
   }
 }
 
+/**
+ * @brief get the string values of the key attributes of a data point
+ *
+ * @param data_pt
+ * @param owner resource, scope or data point attributes
+ * @param key
+ * @return attribute_values views on data_pt content
+ */
+host_serv_attributes_extractor::attribute_values
+host_serv_attributes_extractor::extract_attribute(const otl_data_point& data_pt,
+                                                  attribute_owner owner,
+                                                  const std::string& key) {
+  attribute_values ret;
+  const ::google::protobuf::RepeatedPtrField<
+      ::opentelemetry::proto::common::v1::KeyValue>* attributes = nullptr;
+  switch (owner) {
+    case attribute_owner::otl_data_point:
+      attributes = &data_pt.get_data_point_attributes();
+      break;
+    case attribute_owner::scope:
+      attributes = &data_pt.get_scope().attributes();
+      break;
+    case attribute_owner::resource:
+      attributes = &data_pt.get_resource().attributes();
+      break;
+    default:
+      return ret;
+  }
+  for (const auto& key_val : *attributes) {
+    if (key_val.key() == key && key_val.value().has_string_value()) {
+      ret.push_back(key_val.value().string_value());
+    }
+  }
+  return ret;
+}
+
 /**
  * @brief extract host and service names from configured attribute type
  *
@@ -164,45 +200,30 @@ host_serv_attributes_extractor::host_serv_attributes_extractor(
  */
 host_serv_metric host_serv_attributes_extractor::extract_host_serv_metric(
     const otl_data_point& data_pt) const {
-  auto extract =
-      [](const otl_data_point& data_pt, attribute_owner owner,
-         const std::string& key) -> absl::flat_hash_set<std::string_view> {
-    absl::flat_hash_set<std::string_view> ret;
-    const ::google::protobuf::RepeatedPtrField<
-        ::opentelemetry::proto::common::v1::KeyValue>* attributes = nullptr;
-    switch (owner) {
-      case attribute_owner::otl_data_point:
-        attributes = &data_pt.get_data_point_attributes();
-        break;
-      case attribute_owner::scope:
-        attributes = &data_pt.get_scope().attributes();
-        break;
-      case attribute_owner::resource:
-        attributes = &data_pt.get_resource().attributes();
-        break;
-      default:
-        return ret;
-    }
-    for (const auto& key_val : *attributes) {
-      if (key_val.key() == key && key_val.value().has_string_value()) {
-        ret.insert(key_val.value().string_value());
-      }
-    }
-    return ret;
-  };
+  attribute_values hosts = extract_attribute(data_pt, _host_path, _host_key);
+  if (hosts.empty())
+    return {};
+  return extract_host_serv_metric(data_pt, hosts);
+}
 
+/**
+ * @brief same as above but host attribute values have already been extracted,
+ * it's used when several extractors use the same host attribute
+ *
+ * @param data_pt
+ * @param hosts values of the host attribute of this extractor
+ * @return host_serv_metric host attribute is empty if no allowed host service
+ * is found
+ */
+host_serv_metric host_serv_attributes_extractor::extract_host_serv_metric(
+    const otl_data_point& data_pt,
+    const attribute_values& hosts) const {
   host_serv_metric ret;
 
-  absl::flat_hash_set<std::string_view> hosts =
-      extract(data_pt, _host_path, _host_key);
-
-  if (!hosts.empty()) {
-    absl::flat_hash_set<std::string_view> services =
-        extract(data_pt, _serv_path, _serv_key);
-    ret = is_allowed(hosts, services);
-    if (!ret.host.empty()) {
-      ret.metric = data_pt.get_metric().name();
-    }
+  attribute_values services = extract_attribute(data_pt, _serv_path, _serv_key);
+  ret = is_allowed(hosts, services);
+  if (!ret.host.empty()) {
+    ret.metric = data_pt.get_metric().name();
   }
 
   return ret;
@@ -19,6 +19,7 @@
 #include "com/centreon/exceptions/msg_fmt.hh"
 
 #include "centreon_agent/agent_impl.hh"
+#include "centreon_agent/connection_pool.hh"
 #include "com/centreon/common/http/https_connection.hh"
 
 #include "com/centreon/engine/host.hh"
@@ -47,7 +48,9 @@ open_telemetry::open_telemetry(
     : _config_file_path(config_file_path),
       _logger(logger),
       _io_context(io_context),
-      _agent_stats(centreon_agent::agent_stat::load(io_context)) {
+      _agent_stats(centreon_agent::agent_stat::load(io_context)),
+      _broker_forwarder(std::make_shared<broker_forwarder>(io_context,
+                                                           logger)) {
   SPDLOG_LOGGER_INFO(_logger, "load of open telemetry module");
 }
 
@@ -59,6 +62,12 @@ void open_telemetry::_reload() {
   std::unique_ptr<otl_config> new_conf =
       std::make_unique<otl_config>(_config_file_path, *_io_context);
 
+  _broker_forwarder->update_config(new_conf->get_broker_forward_config());
+
+  // must be done before connections creation
+  centreon_agent::connection_pool::set_size(
+      new_conf->get_centreon_agent_config()->get_connection_threads(), _logger);
+
   if (new_conf->get_grpc_config()) {
     if (!_conf || !_conf->get_grpc_config() ||
         *new_conf->get_grpc_config() != *_conf->get_grpc_config()) {
@@ -265,6 +274,8 @@ void open_telemetry::_shutdown() {
     to_shutdown->shutdown(std::chrono::seconds(10));
   }
   _agent_stats->stop_send_timer();
+  _broker_forwarder->shutdown();
+  centreon_agent::connection_pool::stop();
 }
 
 /**
@@ -282,41 +293,71 @@ std::shared_ptr<com::centreon::engine::commands::otel::host_serv_extractor>
 open_telemetry::create_extractor(
     const std::string& cmdline,
     const commands::otel::host_serv_list::pointer& host_serv_list) {
-  // erase host serv extractors that are only owned by this object
+  // erase host serv extractors that are only owned by this object, that's to
+  // say by _extractors and by the current extractor set
   auto clean = [this]() {
+    bool erased = false;
     for (cmd_line_to_extractor_map::const_iterator to_test =
              _extractors.begin();
          !_extractors.empty() && to_test != _extractors.end();) {
-      if (to_test->second.use_count() <= 1) {
+      if (to_test->second.use_count() <= 2) {
         SPDLOG_LOGGER_DEBUG(_logger, "remove extractor:{}", *to_test->second);
         to_test = _extractors.erase(to_test);
+        erased = true;
       } else {
         ++to_test;
       }
     }
+    return erased;
   };
   std::lock_guard l(_protect);
   auto exist = _extractors.find(cmdline);
   if (exist != _extractors.end()) {
     std::shared_ptr<com::centreon::engine::commands::otel::host_serv_extractor>
         to_ret = exist->second;
-    clean();
+    if (clean())
+      _update_extractor_set();
     return to_ret;
   }
   clean();
   try {
     std::shared_ptr<host_serv_extractor> new_extractor =
         host_serv_extractor::create(cmdline, host_serv_list);
+    // the extractor set indexes extractors by the hosts of their list
+    host_serv_list->set_host_change_listener(
+        [me = std::weak_ptr<open_telemetry>(
+             std::static_pointer_cast<open_telemetry>(shared_from_this()))]() {
+          auto otel = me.lock();
+          if (otel)
+            otel->_extractor_set_outdated = true;
+        });
     _extractors.emplace(cmdline, new_extractor);
+    _update_extractor_set();
     SPDLOG_LOGGER_DEBUG(_logger, "create extractor:{}", *new_extractor);
     return new_extractor;
   } catch (const std::exception& e) {
+    _update_extractor_set();
     SPDLOG_LOGGER_ERROR(_logger, "fail to create extractor \"{}\" : {}",
                         cmdline, e.what());
     throw;
   }
 }
 
+/**
+ * @brief build a new extractor set from _extractors and publish it to the
+ * readers. Readers that still use the previous one keep it alive until they
+ * have finished.
+ *
+ */
+void open_telemetry::_update_extractor_set() {
+  std::vector<std::shared_ptr<host_serv_extractor>> extractors;
+  extractors.reserve(_extractors.size());
+  for (const auto& cmdline_extractor : _extractors)
+    extractors.push_back(cmdline_extractor.second);
+  extractor_set::pointer new_set = std::make_shared<extractor_set>(extractors);
+  std::atomic_store(&_extractor_set, std::move(new_set));
+}
+
 std::shared_ptr<
     com::centreon::engine::commands::otel::otl_check_result_builder_base>
 open_telemetry::create_check_result_builder(const std::string& cmdline) {
@@ -324,83 +365,36 @@ open_telemetry::create_check_result_builder(const std::string& cmdline) {
 }
 
 /**
- * @brief called on metric reception
- * we first fill otl_data_point fifos and then if a converter of a service is
- * waiting for otl_data_point, we call him. If it achieve to generate a check
- * result, the handler of otl_check_result_builder is called
+ * @brief called on metric reception by grpc threads
+ * Host and service of each data point are extracted without lock with the
+ * current extractor set, rebuilt first if hosts of an extractor have
+ * changed, then data points are grouped by host and service and handed to the
+ * main thread. If it achieves to generate a check result, the
+ * handler of otl_check_result_builder is called.
  * unknown metrics are passed to _forward_to_broker
  *
  * @param metrics collector request
  */
 void open_telemetry::on_metric(const metric_request_ptr& metrics) {
   std::vector<otl_data_point> unknown;
-  {
+  // flag is reset before the lists are read, so a host change that occurs
+  // during the rebuild will trigger another one
+  if (_extractor_set_outdated.exchange(false)) {
     std::lock_guard l(_protect);
-    if (_extractors.empty()) {  // no extractor configured => all unknown
-      otl_data_point::extract_data_points(
-          metrics, [&unknown](const otl_data_point& data_pt) {
-            unknown.push_back(data_pt);
-          });
-    } else {
-      std::shared_ptr<absl::flat_hash_map<
-          std::pair<std::string_view, std::string_view>, metric_to_datapoints>>
-          known_data_pt = std::make_shared<
-              absl::flat_hash_map<std::pair<std::string_view, std::string_view>,
-                                  metric_to_datapoints>>();
-      auto last_success = _extractors.begin();
-      otl_data_point::extract_data_points(
-          metrics, [this, &unknown, &last_success,
-                    known_data_pt](const otl_data_point& data_pt) {
-            bool data_point_known = false;
-            // we try all extractors and we begin with the last which has
-            // achieved to extract host
-            for (unsigned tries = 0; tries < _extractors.size(); ++tries) {
-              host_serv_metric hostservmetric =
-                  last_success->second->extract_host_serv_metric(data_pt);
-
-              if (!hostservmetric.host.empty()) {  // match
-                (*known_data_pt)[std::make_pair(hostservmetric.host,
-                                                hostservmetric.service)]
-                                [data_pt.get_metric().name()]
-                                    .insert(data_pt);
-                data_point_known = true;
-                break;
-              }
-              // no match => we try next extractor
-              ++last_success;
-              if (last_success == _extractors.end()) {
-                last_success = _extractors.begin();
-              }
-            }
-            if (!data_point_known) {
-              unknown.push_back(
-                  data_pt);  // unknown metric => forward to broker
-            }
-          });
-
-      // we post all check results in the main thread
-      auto fn = std::packaged_task<int(void)>(
-          [known_data_pt, metrics, logger = _logger]() {
-            // for each host or service, we generate a result
-            for (const auto& host_serv_data : *known_data_pt) {
-              // get connector for this service
-              std::shared_ptr<commands::otel_connector> conn =
-                  commands::otel_connector::get_otel_connector_from_host_serv(
-                      host_serv_data.first.first, host_serv_data.first.second);
-              if (!conn) {
-                SPDLOG_LOGGER_ERROR(
-                    logger, "no opentelemetry connector found for {}:{}",
-                    host_serv_data.first.first, host_serv_data.first.second);
-              } else {
-                conn->process_data_pts(host_serv_data.first.first,
-                                       host_serv_data.first.second,
-                                       host_serv_data.second);
-              }
-            }
-            return OK;
-          });
-      command_manager::instance().enqueue(std::move(fn));
-    }
+    _update_extractor_set();
+  }
+  extractor_set::pointer extractors = std::atomic_load(&_extractor_set);
+  if (!extractors || extractors->empty()) {
+    // no extractor configured => all unknown
+    otl_data_point::extract_data_points(
+        metrics, [&unknown](const otl_data_point& data_pt) {
+          unknown.push_back(data_pt);
+        });
+  } else {
+    host_serv_data_points known;
+    extractors->extract(metrics, known, unknown);
+    if (!known.empty())
+      _post_data_points(std::move(known));
   }
   if (!unknown.empty()) {
     SPDLOG_LOGGER_TRACE(_logger, "{} unknown data_points", unknown.size());
@@ -409,9 +403,76 @@ void open_telemetry::on_metric(const metric_request_ptr& metrics) {
 }
 
 /**
- * @brief unknown metrics are directly forwarded to broker
+ * @brief add data points to the ones waiting for the main thread. Only one
+ * task is posted to the main thread until it has processed them, so data
+ * points received by all the grpc threads meanwhile are processed together.
+ *
+ * @param known data points grouped by host and service
+ */
+void open_telemetry::_post_data_points(host_serv_data_points&& known) {
+  {
+    std::lock_guard l(_pending_m);
+    if (_pending.empty()) {
+      _pending = std::move(known);
+    } else {
+      for (auto& host_serv_data : known) {
+        metric_to_datapoints& dest = _pending[host_serv_data.first];
+        for (auto& metric_data : host_serv_data.second)
+          dest[metric_data.first].insert(metric_data.second.begin(),
+                                         metric_data.second.end());
+      }
+    }
+    if (_pending_posted)
+      return;
+    _pending_posted = true;
+  }
+
+  auto fn = std::packaged_task<int(void)>([me = shared_from_this()]() {
+    me->_process_data_points();
+    return OK;
+  });
+  command_manager::instance().enqueue(std::move(fn));
+}
+
+/**
+ * @brief called from the main thread, the waiting data points are given to the
+ * otel connector of each host or service
+ *
+ */
+void open_telemetry::_process_data_points() {
+  host_serv_data_points to_process;
+  {
+    std::lock_guard l(_pending_m);
+    to_process.swap(_pending);
+    _pending_posted = false;
+  }
+
+  // for each host or service, we generate a result
+  for (const auto& host_serv_data : to_process) {
+    // get connector for this service, the host or service is looked up only
+    // once and given to the connector
+    notifier* host_or_serv;
+    std::shared_ptr<commands::otel_connector> conn =
+        commands::otel_connector::get_otel_connector_from_host_serv(
+            host_serv_data.first.first, host_serv_data.first.second,
+            &host_or_serv);
+    if (!conn) {
+      SPDLOG_LOGGER_ERROR(_logger, "no opentelemetry connector found for {}:{}",
+                          host_serv_data.first.first,
+                          host_serv_data.first.second);
+    } else {
+      conn->process_data_pts(host_or_serv, host_serv_data.second);
+    }
+  }
+}
+
+/**
+ * @brief unknown metrics are given to the broker forwarder that sends them by
+ * batches
  *
  * @param unknown
  */
 void open_telemetry::_forward_to_broker(
-    [[maybe_unused]] const std::vector<otl_data_point>& unknown) {}
+    const std::vector<otl_data_point>& unknown) {
+  _broker_forwarder->on_data_points(unknown);
+}
@@ -95,33 +95,19 @@ std::shared_ptr<otl_check_result_builder> otl_check_result_builder::create(
  * checks::checker::instance() Caution, this function must be called from engine
  * main thread
  *
- * @param host
- * @param serv empty if result of host check
+ * The host or the service has already been looked up by the caller, it is
+ * not searched again here.
+ *
+ * @param host_or_serv host or service that owns the data points
  * @param data_pts opentelemetry data points
  */
 void otl_check_result_builder::process_data_pts(
-    const std::string_view& hst,
-    const std::string_view& serv,
+    notifier* host_or_serv,
     const metric_to_datapoints& data_pts) {
-  check_source notifier_type = check_source::service_check;
-  notifier* host_or_serv = nullptr;
-
-  if (serv.empty()) {
-    notifier_type = check_source::host_check;
-    auto found = host::hosts.find(hst);
-    if (found == host::hosts.end()) {
-      SPDLOG_LOGGER_ERROR(_logger, "unknow host: {}", hst);
-      return;
-    }
-    host_or_serv = found->second.get();
-  } else {
-    auto found = service::services.find(std::make_pair(hst, serv));
-    if (found == service::services.end()) {
-      SPDLOG_LOGGER_ERROR(_logger, "unknow service {} for host", serv, hst);
-      return;
-    }
-    host_or_serv = found->second.get();
-  }
+  check_source notifier_type =
+      host_or_serv->get_notifier_type() == notifier::host_notification
+          ? check_source::host_check
+          : check_source::service_check;
   timeval zero = {0, 0};
   std::shared_ptr<check_result> res = std::make_shared<check_result>(
       notifier_type, host_or_serv, checkable::check_type::check_passive,
@@ -131,9 +117,8 @@ void otl_check_result_builder::process_data_pts(
   } else {
     SPDLOG_LOGGER_ERROR(
         _logger,
-        "fail to convert opentelemetry datas in centreon check_result for host "
-        "{}, serv {}",
-        hst, serv);
+        "fail to convert opentelemetry datas in centreon check_result for {}",
+        host_or_serv->name());
   }
 }
 
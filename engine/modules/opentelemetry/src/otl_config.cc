@@ -58,6 +58,30 @@ static constexpr std::string_view _grpc_config_schema(R"(
         "centreon_agent": {
             "description": "config of centreon_agent",
             "type": "object"
+        },
+        "broker_forward": {
+            "description": "forward of unused data points to broker",
+            "type": "object",
+            "properties": {
+                "enabled": {
+                    "type": "boolean"
+                },
+                "batch_size": {
+                    "description": "max data points sent in one event",
+                    "type": "integer",
+                    "minimum": 1
+                },
+                "max_delay": {
+                    "description": "max delay in ms before sending a batch",
+                    "type": "integer",
+                    "minimum": 1
+                },
+                "max_points_per_source": {
+                    "description": "max data points per second and per host",
+                    "type": "integer",
+                    "minimum": 0
+                }
+            }
         }
       }, 
       "type" : "object"
@@ -123,6 +147,19 @@ otl_config::otl_config(const std::string_view& file_path,
     _centreon_agent_config = std::make_shared<centreon_agent::agent_config>();
   }
 
+  if (file_content.has_member("broker_forward")) {
+    rapidjson_helper broker_forward(file_content.get_member("broker_forward"));
+    _broker_forward_config.enabled =
+        broker_forward.get_bool("enabled", _broker_forward_config.enabled);
+    _broker_forward_config.batch_size = broker_forward.get_unsigned(
+        "batch_size", _broker_forward_config.batch_size);
+    _broker_forward_config.max_delay =
+        std::chrono::milliseconds(broker_forward.get_unsigned(
+            "max_delay", _broker_forward_config.max_delay.count()));
+    _broker_forward_config.max_points_per_source = broker_forward.get_unsigned(
+        "max_points_per_source", _broker_forward_config.max_points_per_source);
+  }
+
   if (file_content.has_member("telegraf_conf_server")) {
     try {
       _telegraf_conf_server_config =
@@ -150,7 +187,8 @@ bool otl_config::operator==(const otl_config& right) const {
   }
   bool ret = *_grpc_conf == *right._grpc_conf &&
              _max_length_grpc_log == right._max_length_grpc_log &&
-             _json_grpc_log == right._json_grpc_log;
+             _json_grpc_log == right._json_grpc_log &&
+             _broker_forward_config == right._broker_forward_config;
 
   if (!ret) {
     return false;
@@ -4815,3 +4815,19 @@ void broker_agent_stats(nebstruct_agent_stats_data& stats) {
 
   cbm->write(to_send);
 }
+
+/**
+ * @brief send to broker OpenTelemetry data points that are not used by any
+ * check. The request is moved into the event.
+ *
+ * @param metrics
+ */
+void broker_otl_metrics(nebstruct_otl_metrics_data& metrics) {
+  if (!cbm || !metrics.metrics)
+    return;
+
+  auto to_send = std::make_shared<neb::pb_otl_metrics>();
+  to_send->mut_obj().Swap(metrics.metrics.get());
+
+  cbm->write(to_send);
+}
@@ -0,0 +1,245 @@
+/**
+ * Copyright 2025 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+/**
+ * centenginespawn is started by centengine at boot when the spawn_helper
+ * option is set. It receives check requests on a unix socket (its stdin),
+ * launches them, reaps them and sends back their results.
+ *
+ * As this process stays small, forking it is much cheaper than forking
+ * centengine, and centengine doesn't have to manage thousands of pipes and
+ * child processes.
+ */
+
+#include <fcntl.h>
+#include <signal.h>
+
+#include <spdlog/sinks/stdout_sinks.h>
+
+#include "com/centreon/common/process/process.hh"
+#include "com/centreon/common/process/spawn_protocol.hh"
+
+using namespace com::centreon::common;
+
+namespace {
+
+using stream_socket = asio::local::stream_protocol::socket;
+
+/**
+ * @brief The connection to centengine. Everything runs in one thread.
+ */
+class spawn_server : public std::enable_shared_from_this<spawn_server> {
+  std::shared_ptr<asio::io_context> _io_context;
+  std::shared_ptr<spdlog::logger> _logger;
+  stream_socket _socket;
+
+  std::string _read_buffer;
+  size_t _read_size = 0;
+
+  /* responses are accumulated in _to_send while a write is pending, so they
+   * are sent in batches */
+  std::string _to_send;
+  std::string _sending;
+  bool _write_pending = false;
+
+  absl::flat_hash_map<uint64_t, std::shared_ptr<process<false>>> _running;
+
+  void _read();
+  void _on_read(const boost::system::error_code& err, size_t nb_read);
+  void _run(const spawn_protocol::request& req);
+  void _on_complete(uint64_t id,
+                    int exit_code,
+                    int exit_status,
+                    const std::string& std_out,
+                    const std::string& std_err);
+  void _write();
+  void _shutdown();
+
+ public:
+  spawn_server(const std::shared_ptr<asio::io_context>& io_context,
+               const std::shared_ptr<spdlog::logger>& logger,
+               int fd)
+      : _io_context(io_context),
+        _logger(logger),
+        _socket(*io_context, asio::local::stream_protocol(), fd),
+        _read_buffer(0x10000, 0) {}
+
+  void start() { _read(); }
+};
+
+void spawn_server::_read() {
+  if (_read_buffer.size() - _read_size < 0x1000)
+    _read_buffer.resize(_read_buffer.size() * 2);
+  _socket.async_read_some(
+      asio::buffer(_read_buffer.data() + _read_size,
+                   _read_buffer.size() - _read_size),
+      [me = shared_from_this()](const boost::system::error_code& err,
+                                size_t nb_read) {
+        me->_on_read(err, nb_read);
+      });
+}
+
+/**
+ * @brief parse all the complete requests received and start them.
+ */
+void spawn_server::_on_read(const boost::system::error_code& err,
+                            size_t nb_read) {
+  if (err) {
+    if (err != asio::error::eof)
+      _logger->error("fail to read from centengine: {}", err.message());
+    _shutdown();
+    return;
+  }
+  _read_size += nb_read;
+
+  std::string_view data(_read_buffer.data(), _read_size);
+  spawn_protocol::request req;
+  try {
+    for (size_t size = spawn_protocol::frame_size(data); size;
+         size = spawn_protocol::frame_size(data)) {
+      if (spawn_protocol::parse_request(data.substr(0, size), req))
+        _run(req);
+      else
+        _logger->error("malformed request ignored");
+      data.remove_prefix(size);
+    }
+  } catch (const std::exception& e) {
+    _logger->error("{}", e.what());
+    _shutdown();
+    return;
+  }
+  if (data.size() < _read_size) {
+    memmove(_read_buffer.data(), data.data(), data.size());
+    _read_size = data.size();
+  }
+  _read();
+}
+
+void spawn_server::_run(const spawn_protocol::request& req) {
+  std::vector<std::string> args(req.args.begin() + 1, req.args.end() - 1);
+  auto proc_args =
+      std::make_shared<process_args>(req.args[0], std::move(args));
+
+  process<false>::shared_env env;
+  if (!req.env.empty()) {
+    static const std::vector<std::pair<std::string, std::string>> empty_args;
+    env =
+        std::make_shared<boost::process::v2::process_environment>(empty_args);
+    env->env_buffer.reserve(req.env.size());
+    for (const auto& [key, value] : req.env)
+      env->env_buffer.emplace_back(std::string(key), std::string(value));
+    env->env = env->build_env(empty_args);
+  }
+
+  uint64_t id = req.id;
+  try {
+    auto proc = std::make_shared<process<false>>(_io_context, _logger,
+                                                 proc_args, true, false, env);
+    proc->start_process(
+        [me = shared_from_this(), id](
+            const process<false>&, int exit_code, int exit_status,
+            const std::string& std_out, const std::string& std_err) {
+          me->_on_complete(id, exit_code, exit_status, std_out, std_err);
+        },
+        std::chrono::seconds(req.timeout));
+    _running.emplace(id, std::move(proc));
+  } catch (const std::exception& e) {
+    // same behavior as a failed exec in a child process
+    spawn_protocol::write_response(_to_send, id, -1, e_exit_status::normal, "",
+                                   e.what());
+    _write();
+  }
+}
+
+void spawn_server::_on_complete(uint64_t id,
+                                int exit_code,
+                                int exit_status,
+                                const std::string& std_out,
+                                const std::string& std_err) {
+  _running.erase(id);
+  spawn_protocol::write_response(_to_send, id, exit_code, exit_status,
+                                 std_out, std_err);
+  _write();
+}
+
+void spawn_server::_write() {
+  if (_write_pending || _to_send.empty() || !_socket.is_open())
+    return;
+  _sending.swap(_to_send);
+  _to_send.clear();
+  _write_pending = true;
+  asio::async_write(
+      _socket, asio::buffer(_sending),
+      [me = shared_from_this()](const boost::system::error_code& err, size_t) {
+        me->_write_pending = false;
+        if (err) {
+          me->_logger->error("fail to write to centengine: {}", err.message());
+          me->_shutdown();
+          return;
+        }
+        me->_write();
+      });
+}
+
+/**
+ * @brief centengine is gone, we kill the running checks and we stop.
+ */
+void spawn_server::_shutdown() {
+  if (_socket.is_open()) {
+    boost::system::error_code err;
+    _socket.close(err);
+  }
+  for (auto& to_kill : _running)
+    to_kill.second->kill();
+  _running.clear();
+  _io_context->stop();
+}
+
+}  // namespace
+
+/**
+ * @brief centengine gives us the socket as stdin, we replace it by /dev/null
+ * so that checks don't inherit the socket.
+ */
+int main(int, char**) {
+  int fd = fcntl(STDIN_FILENO, F_DUPFD_CLOEXEC, 3);
+  if (fd < 0) {
+    std::cerr << "centenginespawn: no usable socket on stdin" << std::endl;
+    return EXIT_FAILURE;
+  }
+  int null_fd = open("/dev/null", O_RDONLY);
+  if (null_fd >= 0 && null_fd != STDIN_FILENO) {
+    dup2(null_fd, STDIN_FILENO);
+    close(null_fd);
+  }
+  signal(SIGPIPE, SIG_IGN);
+
+  auto io_context = std::make_shared<asio::io_context>();
+  auto logger = std::make_shared<spdlog::logger>(
+      "spawn_helper", std::make_shared<spdlog::sinks::stderr_sink_mt>());
+  logger->set_level(spdlog::level::err);
+
+  try {
+    std::make_shared<spawn_server>(io_context, logger, fd)->start();
+  } catch (const std::exception& e) {
+    std::cerr << "centenginespawn: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+  io_context->run();
+  return EXIT_SUCCESS;
+}
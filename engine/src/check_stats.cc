@@ -0,0 +1,222 @@
+/**
+ * Copyright 2025 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/engine/check_stats.hh"
+
+using namespace com::centreon::engine;
+
+/* values are not supposed to be bigger than that (1e6 seconds is more than
+ * 11 days), bigger values are counted in the last bucket */
+static const uint32_t _max_index = static_cast<uint32_t>(
+    std::ceil(std::log(1e9) / std::log(quantile_sketch::gamma)));
+
+/**
+ * @brief index of the bucket of value, value must not be in the zero bucket.
+ * The bucket i contains values in ]min_value*gamma^i, min_value*gamma^(i+1)].
+ */
+uint32_t quantile_sketch::_index(double value) {
+  double idx = std::ceil(std::log(value / min_value) / std::log(gamma)) - 1;
+  if (idx <= 0)
+    return 0;
+  if (idx >= _max_index)
+    return _max_index;
+  return static_cast<uint32_t>(idx);
+}
+
+/**
+ * @brief value representing the bucket index, its relative error is lower
+ * than (gamma - 1) / 2 for every value of the bucket.
+ */
+double quantile_sketch::_value(uint32_t index) {
+  return min_value * std::pow(gamma, index) * 2 * gamma / (gamma + 1);
+}
+
+void quantile_sketch::add(double value) {
+  ++_count;
+  _micro_sum += std::llround(value * 1000000);
+  if (value < min_value) {
+    ++_zero;
+    return;
+  }
+  uint32_t idx = _index(value);
+  if (idx >= _buckets.size())
+    _buckets.resize(idx + 1, 0);
+  ++_buckets[idx];
+}
+
+/**
+ * @brief remove a value previously added, it's the caller's job to only
+ * remove added values.
+ */
+void quantile_sketch::remove(double value) {
+  if (!_count)
+    return;
+  --_count;
+  _micro_sum -= std::llround(value * 1000000);
+  if (value < min_value) {
+    if (_zero)
+      --_zero;
+    return;
+  }
+  uint32_t idx = _index(value);
+  if (idx < _buckets.size() && _buckets[idx])
+    --_buckets[idx];
+}
+
+double quantile_sketch::min() const {
+  return quantile(0);
+}
+
+double quantile_sketch::max() const {
+  return quantile(1);
+}
+
+/**
+ * @brief estimation of a quantile
+ *
+ * @param q between 0 and 1
+ * @return 0 if there is no value
+ */
+double quantile_sketch::quantile(double q) const {
+  if (!_count)
+    return 0;
+  /* rank of the wanted value, starting at 1 */
+  uint64_t rank = q <= 0 ? 1 : static_cast<uint64_t>(std::ceil(q * _count));
+  if (rank > _count)
+    rank = _count;
+  if (rank <= _zero)
+    return 0;
+  uint64_t seen = _zero;
+  for (uint32_t i = 0; i < _buckets.size(); ++i) {
+    seen += _buckets[i];
+    if (seen >= rank)
+      return _value(i);
+  }
+  return _value(_buckets.size() - 1);
+}
+
+/**
+ * @brief number of objects whose last check is in [from, to]
+ */
+uint32_t check_stats::type_stats::checks_between(time_t from,
+                                                 time_t to) const {
+  uint32_t ret = 0;
+  for (auto it = last_checks.lower_bound(from);
+       it != last_checks.end() && it->first <= to; ++it)
+    ret += it->second;
+  return ret;
+}
+
+/* Instances are never destroyed because hosts and services stored in static
+ * containers unregister themselves when they are destroyed at exit. */
+check_stats& check_stats::hosts() {
+  static check_stats* instance = new check_stats;
+  return *instance;
+}
+
+check_stats& check_stats::services() {
+  static check_stats* instance = new check_stats;
+  return *instance;
+}
+
+/**
+ * @brief add (sign = 1) or remove (sign = -1) a sample from the aggregates
+ */
+void check_stats::_add(const sample& s, int32_t sign) {
+  _checked += sign * s.checked;
+  _scheduled += sign * s.scheduled;
+  _flapping += sign * s.flapping;
+  _downtime += sign * s.downtime;
+  if (s.state < max_states)
+    _states[s.state] += sign;
+
+  type_stats& stats = s.active ? _active : _passive;
+  if (sign > 0) {
+    stats.latency.add(s.latency);
+    stats.state_change.add(s.state_change);
+    if (s.active)
+      stats.execution_time.add(s.execution_time);
+    if (s.last_check)
+      ++stats.last_checks[s.last_check];
+  } else {
+    stats.latency.remove(s.latency);
+    stats.state_change.remove(s.state_change);
+    if (s.active)
+      stats.execution_time.remove(s.execution_time);
+    auto found = stats.last_checks.find(s.last_check);
+    if (found != stats.last_checks.end() && !--found->second)
+      stats.last_checks.erase(found);
+  }
+}
+
+/**
+ * @brief forget the last checks older than one hour, nobody asks for them.
+ */
+void check_stats::_prune(time_t now) {
+  for (type_stats* stats : {&_active, &_passive}) {
+    auto end = stats->last_checks.lower_bound(now - 3600);
+    stats->last_checks.erase(stats->last_checks.begin(), end);
+  }
+}
+
+/**
+ * @brief take into account the current values of a host or a service.
+ *
+ * @param obj
+ * @param state current state of obj
+ * @param now
+ */
+void check_stats::update(const checkable& obj, uint32_t state, time_t now) {
+  sample s{obj.get_check_type() == checkable::check_active,
+           obj.has_been_checked(),
+           obj.get_should_be_scheduled(),
+           obj.get_is_flapping(),
+           obj.is_in_downtime(),
+           state,
+           obj.get_last_check(),
+           obj.get_latency(),
+           obj.get_execution_time(),
+           obj.get_percent_state_change()};
+  /* last checks older than one hour would be pruned at once */
+  if (s.last_check < now - 3600)
+    s.last_check = 0;
+
+  auto [it, inserted] = _samples.try_emplace(&obj, s);
+  if (!inserted) {
+    _add(it->second, -1);
+    it->second = s;
+  }
+  _add(s, 1);
+  _prune(now);
+}
+
+void check_stats::remove(const checkable& obj) {
+  auto found = _samples.find(&obj);
+  if (found != _samples.end()) {
+    _add(found->second, -1);
+    _samples.erase(found);
+  }
+}
+
+void check_stats::clear() {
+  _samples.clear();
+  _active = type_stats();
+  _passive = type_stats();
+  _checked = _scheduled = _flapping = _downtime = 0;
+  _states.fill(0);
+}
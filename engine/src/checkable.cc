@@ -50,47 +50,47 @@ checkable::checkable(const std::string& name,
                      bool obsess_over,
                      const std::string& timezone,
                      uint64_t icon_id)
-    : _name{name},
-      _display_name{display_name.empty() ? name : display_name},
-      _check_command{check_command},
+    : _next_check{0L},
+      _last_state_change{0},
+      _last_hard_state_change{0},
+      _latency{0.0},
+      _execution_time{0.0},
+      _percent_state_change{0.0},
+      _last_check{0},
+      _current_attempt{0},
+      _max_attempts{max_attempts},
+      _scheduled_downtime_depth{0},
       _check_interval{check_interval},
       _retry_interval{retry_interval},
-      _max_attempts{max_attempts},
+      _state_history_index{0},
+      _check_type{check_active},
+      _state_type{soft},
+      _checks_enabled{checks_enabled},
+      _accept_passive_checks{accept_passive_checks},
+      _has_been_checked{false},
+      _should_be_scheduled{true},
+      _is_executing{false},
+      _is_flapping{false},
+      _check_freshness{check_freshness},
+      _freshness_threshold{freshness_threshold},
+      _check_command_ptr{nullptr},
+      _name{name},
+      _display_name{display_name.empty() ? name : display_name},
+      _check_command{check_command},
       _check_period{check_period},
       _event_handler{event_handler},
       _event_handler_enabled{event_handler_enabled},
+      _flap_detection_enabled{flap_detection_enabled},
+      _obsess_over{obsess_over},
       _action_url{action_url},
       _icon_image{icon_image},
       _icon_image_alt{icon_image_alt},
       _notes{notes},
       _notes_url{notes_url},
-      _flap_detection_enabled{flap_detection_enabled},
       _low_flap_threshold{low_flap_threshold},
       _high_flap_threshold{high_flap_threshold},
-      _obsess_over{obsess_over},
       _timezone{timezone},
-      _checks_enabled{checks_enabled},
-      _accept_passive_checks{accept_passive_checks},
-      _check_freshness{check_freshness},
-      _freshness_threshold{freshness_threshold},
-      _check_type{check_active},
-      _current_attempt{0},
-      _has_been_checked{false},
-      _scheduled_downtime_depth{0},
-      _execution_time{0.0},
-      _is_flapping{false},
-      _last_check{0},
-      _latency{0.0},
-      _next_check{0L},
-      _should_be_scheduled{true},
-      _state_history_index{0},
-      _last_state_change{0},
-      _last_hard_state_change{0},
-      _state_type{soft},
-      _percent_state_change{0.0},
       _event_handler_ptr{nullptr},
-      _check_command_ptr{nullptr},
-      _is_executing{false},
       _icon_id{icon_id},
       check_period_ptr{nullptr} {
   if (max_attempts <= 0 || retry_interval <= 0 || freshness_threshold < 0) {
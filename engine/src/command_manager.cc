@@ -22,10 +22,12 @@
 
 #include "com/centreon/engine/host.hh"
 
+#include "com/centreon/engine/check_stats.hh"
 #include "com/centreon/engine/checks/checker.hh"
 #include "com/centreon/engine/command_manager.hh"
 #include "com/centreon/engine/comment.hh"
 #include "com/centreon/engine/downtimes/downtime_manager.hh"
+#include "com/centreon/engine/events/check_throttle.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging/logger.hh"
 
@@ -408,424 +410,161 @@ void command_manager::schedule_and_propagate_downtime(
   }
 }
 
-int command_manager::get_services_stats(ServicesStats* sstats) {
-  time_t now;
-  time(&now);
-  uint32_t checked_services = 0;
-  uint32_t scheduled_services = 0;
-  uint32_t actively_checked = 0;
-  uint32_t passively_checked = 0;
-
-  double global_min_state_change = std::numeric_limits<double>::max(),
-         global_max_state_change = std::numeric_limits<double>::min(),
-         global_avg_state_change = 0;
-
-  double active_min_state_change = std::numeric_limits<double>::max(),
-         active_max_state_change = std::numeric_limits<double>::min(),
-         active_avg_state_change = 0;
-
-  double passive_min_state_change = std::numeric_limits<double>::max(),
-         passive_max_state_change = std::numeric_limits<double>::min(),
-         passive_avg_state_change = 0;
-
-  double active_min_latency = std::numeric_limits<double>::max(),
-         active_max_latency = std::numeric_limits<double>::min(),
-         active_avg_latency = 0;
-
-  double passive_min_latency = std::numeric_limits<double>::max(),
-         passive_max_latency = std::numeric_limits<double>::min(),
-         passive_avg_latency = 0;
-
-  double active_min_execution_time = std::numeric_limits<double>::max(),
-         active_max_execution_time = std::numeric_limits<double>::min(),
-         active_avg_execution_time = 0;
-
-  uint32_t active_checks_last_1min = 0, active_checks_last_5min = 0,
-           active_checks_last_15min = 0, active_checks_last_1hour = 0;
-
-  uint32_t passive_checks_last_1min = 0, passive_checks_last_5min = 0,
-           passive_checks_last_15min = 0, passive_checks_last_1hour = 0;
-
-  uint32_t ok = 0, warning = 0, critical = 0, unknown = 0;
-
-  uint32_t downtime = 0, flapping = 0;
-
-  auto min_max_sum = [](double v, double& min, double& max, double& sum) {
-    sum += v;
-    if (v < min)
-      min = v;
-    if (v > max)
-      max = v;
-  };
-
-  for (auto it = service::services_by_id.begin(),
-            end = service::services_by_id.end();
-       it != end; ++it) {
-    service* svc = it->second.get();
-
-    /******************************** GLOBAL **********************************/
-    min_max_sum(svc->get_percent_state_change(), global_min_state_change,
-                global_max_state_change, global_avg_state_change);
-
-    if (svc->has_been_checked())
-      ++checked_services;
-    if (svc->get_should_be_scheduled())
-      ++scheduled_services;
-
-    switch (svc->get_current_state()) {
-      case service::state_ok:
-        ++ok;
-        break;
-      case service::state_warning:
-        ++warning;
-        break;
-      case service::state_critical:
-        ++critical;
-        break;
-      case service::state_unknown:
-        ++unknown;
-        break;
-    }
-
-    if (svc->is_in_downtime())
-      ++downtime;
-    if (svc->get_is_flapping())
-      ++flapping;
-
-    if (svc->get_check_type() == checkable::check_active) {
-      /****************************** ACTIVE **********************************/
-      ++actively_checked;
-      min_max_sum(svc->get_latency(), active_min_latency, active_max_latency,
-                  active_avg_latency);
-
-      min_max_sum(svc->get_execution_time(), active_min_execution_time,
-                  active_max_execution_time, active_avg_execution_time);
-
-      min_max_sum(svc->get_percent_state_change(), active_min_state_change,
-                  active_max_state_change, active_avg_state_change);
-
-      uint32_t time_diff = now - svc->get_last_check();
-      if (time_diff <= 60)
-        ++active_checks_last_1min;
-      if (time_diff <= 300)
-        ++active_checks_last_5min;
-      if (time_diff <= 900)
-        ++active_checks_last_15min;
-      if (time_diff <= 900)
-        ++active_checks_last_1hour;
-
-    } else {
-      /****************************** PASSIVE *********************************/
-      ++passively_checked;
-      min_max_sum(svc->get_latency(), passive_min_latency, passive_max_latency,
-                  passive_avg_latency);
-
-      min_max_sum(svc->get_percent_state_change(), passive_min_state_change,
-                  passive_max_state_change, passive_avg_state_change);
-
-      uint32_t time_diff = now - svc->get_last_check();
-      if (time_diff <= 60)
-        ++passive_checks_last_1min;
-      if (time_diff <= 300)
-        ++passive_checks_last_5min;
-      if (time_diff <= 900)
-        ++passive_checks_last_15min;
-      if (time_diff <= 900)
-        ++passive_checks_last_1hour;
-    }
-  }
-
-  /********************************* SUMMARY **********************************/
-  size_t size = service::services.size();
-  if (size)
-    global_avg_state_change /= size;
+/**
+ * @brief Fill the statistics common to active and passive hosts or services.
+ *
+ * @tparam type_stats ServiceTypeStats or HostTypeStats
+ * @param stats incremental statistics
+ * @param now
+ * @param to_fill
+ */
+template <class type_stats>
+static void fill_type_stats(const check_stats::type_stats& stats,
+                            time_t now,
+                            type_stats* to_fill) {
+  to_fill->set_min_latency(stats.latency.min());
+  to_fill->set_max_latency(stats.latency.max());
+  to_fill->set_average_latency(stats.latency.average());
+
+  to_fill->set_min_execution_time(stats.execution_time.min());
+  to_fill->set_max_execution_time(stats.execution_time.max());
+  to_fill->set_average_execution_time(stats.execution_time.average());
+
+  to_fill->set_min_state_change(stats.state_change.min());
+  to_fill->set_max_state_change(stats.state_change.max());
+  to_fill->set_average_state_change(stats.state_change.average());
+
+  to_fill->set_checks_last_1min(stats.checks_between(now - 60, now));
+  to_fill->set_checks_last_5min(stats.checks_between(now - 300, now));
+  to_fill->set_checks_last_15min(stats.checks_between(now - 900, now));
+  to_fill->set_checks_last_1hour(stats.checks_between(now - 3600, now));
+}
 
-  if (actively_checked) {
-    active_avg_state_change /= actively_checked;
-    active_avg_latency /= actively_checked;
-    active_avg_execution_time /= actively_checked;
+/**
+ * @brief Global state change statistics of active and passive objects.
+ *
+ * @tparam global_stats ServicesStats or HostsStats
+ */
+template <class global_stats>
+static void fill_global_state_change(const check_stats& stats,
+                                     global_stats* to_fill) {
+  const quantile_sketch& active = stats.active().state_change;
+  const quantile_sketch& passive = stats.passive().state_change;
+  if (active.count() && passive.count()) {
+    to_fill->set_min_state_change(std::min(active.min(), passive.min()));
+    to_fill->set_max_state_change(std::max(active.max(), passive.max()));
+    to_fill->set_average_state_change((active.sum() + passive.sum()) /
+                                      (active.count() + passive.count()));
   } else {
-    active_min_state_change = active_max_state_change = 0;
-    active_min_latency = active_max_latency = 0;
+    const quantile_sketch& used = active.count() ? active : passive;
+    to_fill->set_min_state_change(used.min());
+    to_fill->set_max_state_change(used.max());
+    to_fill->set_average_state_change(used.average());
   }
+}
 
-  if (passively_checked) {
-    passive_avg_state_change /= passively_checked;
-    passive_avg_latency /= passively_checked;
-  } else {
-    passive_min_state_change = passive_max_state_change = 0;
-    passive_min_latency = passive_max_latency = 0;
-  }
+/**
+ * @brief Services statistics. They are maintained by check_stats as check
+ * results come, so we don't have to walk all the services here.
+ */
+int command_manager::get_services_stats(ServicesStats* sstats) {
+  time_t now = time(nullptr);
+  const check_stats& stats = check_stats::services();
 
-  sstats->set_services_count(size);
-  sstats->set_checked_services(checked_services);
-  sstats->set_scheduled_services(scheduled_services);
+  uint32_t actively_checked = stats.active().latency.count();
+  sstats->set_services_count(service::services.size());
+  sstats->set_checked_services(stats.checked());
+  sstats->set_scheduled_services(stats.scheduled());
   sstats->set_actively_checked(actively_checked);
+  sstats->set_passively_checked(stats.passive().latency.count());
 
-  sstats->set_min_state_change(global_min_state_change);
-  sstats->set_max_state_change(global_max_state_change);
-  sstats->set_average_state_change(global_avg_state_change);
-
-  sstats->mutable_active_services()->set_min_latency(active_min_latency);
-  sstats->mutable_active_services()->set_max_latency(active_max_latency);
-  sstats->mutable_active_services()->set_average_latency(active_avg_latency);
-
-  sstats->mutable_active_services()->set_min_execution_time(
-      active_min_execution_time);
-  sstats->mutable_active_services()->set_max_execution_time(
-      active_max_execution_time);
-  sstats->mutable_active_services()->set_average_execution_time(
-      active_avg_execution_time);
-
-  sstats->mutable_active_services()->set_min_state_change(
-      active_min_state_change);
-  sstats->mutable_active_services()->set_max_state_change(
-      active_max_state_change);
-  sstats->mutable_active_services()->set_average_state_change(
-      active_avg_state_change);
-
-  sstats->mutable_active_services()->set_checks_last_1min(
-      active_checks_last_1min);
-  sstats->mutable_active_services()->set_checks_last_5min(
-      active_checks_last_5min);
-  sstats->mutable_active_services()->set_checks_last_15min(
-      active_checks_last_15min);
-  sstats->mutable_active_services()->set_checks_last_1hour(
-      active_checks_last_1hour);
-
-  sstats->mutable_passive_services()->set_min_latency(passive_min_latency);
-  sstats->mutable_passive_services()->set_max_latency(passive_max_latency);
-  sstats->mutable_passive_services()->set_average_latency(passive_avg_latency);
-
-  sstats->mutable_passive_services()->set_min_state_change(
-      passive_min_state_change);
-  sstats->mutable_passive_services()->set_max_state_change(
-      passive_max_state_change);
-  sstats->mutable_passive_services()->set_average_state_change(
-      passive_avg_state_change);
-
-  sstats->mutable_passive_services()->set_checks_last_1min(
-      passive_checks_last_1min);
-  sstats->mutable_passive_services()->set_checks_last_5min(
-      passive_checks_last_5min);
-  sstats->mutable_passive_services()->set_checks_last_15min(
-      passive_checks_last_15min);
-  sstats->mutable_passive_services()->set_checks_last_1hour(
-      passive_checks_last_1hour);
-
-  sstats->set_ok(ok);
-  sstats->set_warning(warning);
-  sstats->set_critical(critical);
-  sstats->set_unknown(unknown);
-
-  sstats->set_flapping(flapping);
-  sstats->set_downtime(downtime);
+  fill_global_state_change(stats, sstats);
+  fill_type_stats(stats.active(), now, sstats->mutable_active_services());
+  fill_type_stats(stats.passive(), now, sstats->mutable_passive_services());
+
+  sstats->set_ok(stats.state_count(service::state_ok));
+  sstats->set_warning(stats.state_count(service::state_warning));
+  sstats->set_critical(stats.state_count(service::state_critical));
+  sstats->set_unknown(stats.state_count(service::state_unknown));
+
+  sstats->set_flapping(stats.flapping());
+  sstats->set_downtime(stats.downtime());
   return 0;
 }
 
+/**
+ * @brief Hosts statistics. They are maintained by check_stats as check
+ * results come, so we don't have to walk all the hosts here.
+ */
 int command_manager::get_hosts_stats(HostsStats* hstats) {
-  time_t now;
-  time(&now);
-  uint32_t checked_hosts = 0;
-  uint32_t scheduled_hosts = 0;
-  uint32_t actively_checked = 0;
-  uint32_t passively_checked = 0;
-
-  double global_min_state_change = std::numeric_limits<double>::max(),
-         global_max_state_change = std::numeric_limits<double>::min(),
-         global_avg_state_change = 0;
-
-  double active_min_state_change = std::numeric_limits<double>::max(),
-         active_max_state_change = std::numeric_limits<double>::min(),
-         active_avg_state_change = 0;
-
-  double passive_min_state_change = std::numeric_limits<double>::max(),
-         passive_max_state_change = std::numeric_limits<double>::min(),
-         passive_avg_state_change = 0;
-
-  double active_min_latency = std::numeric_limits<double>::max(),
-         active_max_latency = std::numeric_limits<double>::min(),
-         active_avg_latency = 0;
-
-  double passive_min_latency = std::numeric_limits<double>::max(),
-         passive_max_latency = std::numeric_limits<double>::min(),
-         passive_avg_latency = 0;
-
-  double active_min_execution_time = std::numeric_limits<double>::max(),
-         active_max_execution_time = std::numeric_limits<double>::min(),
-         active_avg_execution_time = 0;
-
-  uint32_t active_checks_last_1min = 0, active_checks_last_5min = 0,
-           active_checks_last_15min = 0, active_checks_last_1hour = 0;
-
-  uint32_t passive_checks_last_1min = 0, passive_checks_last_5min = 0,
-           passive_checks_last_15min = 0, passive_checks_last_1hour = 0;
-
-  uint32_t up = 0, down = 0, unreachable = 0;
-
-  uint32_t downtime = 0, flapping = 0;
-
-  auto min_max_sum = [](double v, double& min, double& max, double& sum) {
-    sum += v;
-    if (v < min)
-      min = v;
-    if (v > max)
-      max = v;
-  };
-
-  for (auto it = host::hosts_by_id.begin(), end = host::hosts_by_id.end();
-       it != end; ++it) {
-    host* hst = it->second.get();
-
-    /******************************** GLOBAL **********************************/
-    min_max_sum(hst->get_percent_state_change(), global_min_state_change,
-                global_max_state_change, global_avg_state_change);
-
-    if (hst->has_been_checked())
-      ++checked_hosts;
-    if (hst->get_should_be_scheduled())
-      ++scheduled_hosts;
-
-    switch (hst->get_current_state()) {
-      case host::state_up:
-        ++up;
-        break;
-      case host::state_down:
-        ++down;
-        break;
-      case host::state_unreachable:
-        ++unreachable;
-        break;
-    }
+  time_t now = time(nullptr);
+  const check_stats& stats = check_stats::hosts();
 
-    if (hst->is_in_downtime())
-      ++downtime;
-    if (hst->get_is_flapping())
-      ++flapping;
-
-    if (hst->get_check_type() == checkable::check_active) {
-      /****************************** ACTIVE **********************************/
-      ++actively_checked;
-      min_max_sum(hst->get_latency(), active_min_latency, active_max_latency,
-                  active_avg_latency);
-
-      min_max_sum(hst->get_execution_time(), active_min_execution_time,
-                  active_max_execution_time, active_avg_execution_time);
-
-      min_max_sum(hst->get_percent_state_change(), active_min_state_change,
-                  active_max_state_change, active_avg_state_change);
-
-      uint32_t time_diff = now - hst->get_last_check();
-      if (time_diff <= 60)
-        ++active_checks_last_1min;
-      if (time_diff <= 300)
-        ++active_checks_last_5min;
-      if (time_diff <= 900)
-        ++active_checks_last_15min;
-      if (time_diff <= 900)
-        ++active_checks_last_1hour;
-
-    } else {
-      /****************************** PASSIVE *********************************/
-      ++passively_checked;
-      min_max_sum(hst->get_latency(), passive_min_latency, passive_max_latency,
-                  passive_avg_latency);
-
-      min_max_sum(hst->get_percent_state_change(), passive_min_state_change,
-                  passive_max_state_change, passive_avg_state_change);
-
-      uint32_t time_diff = now - hst->get_last_check();
-      if (time_diff <= 60)
-        ++passive_checks_last_1min;
-      if (time_diff <= 300)
-        ++passive_checks_last_5min;
-      if (time_diff <= 900)
-        ++passive_checks_last_15min;
-      if (time_diff <= 900)
-        ++passive_checks_last_1hour;
-    }
-  }
+  hstats->set_hosts_count(host::hosts.size());
+  hstats->set_checked_hosts(stats.checked());
+  hstats->set_scheduled_hosts(stats.scheduled());
+  hstats->set_actively_checked(stats.active().latency.count());
+  hstats->set_passively_checked(stats.passive().latency.count());
 
-  /********************************* SUMMARY **********************************/
-  size_t size = host::hosts.size();
-  if (size)
-    global_avg_state_change /= size;
+  fill_global_state_change(stats, hstats);
+  fill_type_stats(stats.active(), now, hstats->mutable_active_hosts());
+  fill_type_stats(stats.passive(), now, hstats->mutable_passive_hosts());
 
-  if (actively_checked) {
-    active_avg_state_change /= actively_checked;
-    active_avg_latency /= actively_checked;
-    active_avg_execution_time /= actively_checked;
-  } else {
-    active_min_state_change = active_max_state_change = 0;
-    active_min_latency = active_max_latency = 0;
-  }
+  hstats->set_up(stats.state_count(host::state_up));
+  hstats->set_down(stats.state_count(host::state_down));
+  hstats->set_unreachable(stats.state_count(host::state_unreachable));
 
-  if (passively_checked) {
-    passive_avg_state_change /= passively_checked;
-    passive_avg_latency /= passively_checked;
-  } else {
-    passive_min_state_change = passive_max_state_change = 0;
-    passive_min_latency = passive_max_latency = 0;
-  }
+  hstats->set_flapping(stats.flapping());
+  hstats->set_downtime(stats.downtime());
+  return 0;
+}
 
-  hstats->set_hosts_count(size);
-  hstats->set_checked_hosts(checked_hosts);
-  hstats->set_scheduled_hosts(scheduled_hosts);
-  hstats->set_actively_checked(actively_checked);
-
-  hstats->set_min_state_change(global_min_state_change);
-  hstats->set_max_state_change(global_max_state_change);
-  hstats->set_average_state_change(global_avg_state_change);
-
-  hstats->mutable_active_hosts()->set_min_latency(active_min_latency);
-  hstats->mutable_active_hosts()->set_max_latency(active_max_latency);
-  hstats->mutable_active_hosts()->set_average_latency(active_avg_latency);
-
-  hstats->mutable_active_hosts()->set_min_execution_time(
-      active_min_execution_time);
-  hstats->mutable_active_hosts()->set_max_execution_time(
-      active_max_execution_time);
-  hstats->mutable_active_hosts()->set_average_execution_time(
-      active_avg_execution_time);
-
-  hstats->mutable_active_hosts()->set_min_state_change(active_min_state_change);
-  hstats->mutable_active_hosts()->set_max_state_change(active_max_state_change);
-  hstats->mutable_active_hosts()->set_average_state_change(
-      active_avg_state_change);
-
-  hstats->mutable_active_hosts()->set_checks_last_1min(active_checks_last_1min);
-  hstats->mutable_active_hosts()->set_checks_last_5min(active_checks_last_5min);
-  hstats->mutable_active_hosts()->set_checks_last_15min(
-      active_checks_last_15min);
-  hstats->mutable_active_hosts()->set_checks_last_1hour(
-      active_checks_last_1hour);
-
-  hstats->mutable_passive_hosts()->set_min_latency(passive_min_latency);
-  hstats->mutable_passive_hosts()->set_max_latency(passive_max_latency);
-  hstats->mutable_passive_hosts()->set_average_latency(passive_avg_latency);
-
-  hstats->mutable_passive_hosts()->set_min_state_change(
-      passive_min_state_change);
-  hstats->mutable_passive_hosts()->set_max_state_change(
-      passive_max_state_change);
-  hstats->mutable_passive_hosts()->set_average_state_change(
-      passive_avg_state_change);
-
-  hstats->mutable_passive_hosts()->set_checks_last_1min(
-      passive_checks_last_1min);
-  hstats->mutable_passive_hosts()->set_checks_last_5min(
-      passive_checks_last_5min);
-  hstats->mutable_passive_hosts()->set_checks_last_15min(
-      passive_checks_last_15min);
-  hstats->mutable_passive_hosts()->set_checks_last_1hour(
-      passive_checks_last_1hour);
-
-  hstats->set_up(up);
-  hstats->set_down(down);
-  hstats->set_unreachable(unreachable);
-
-  hstats->set_flapping(flapping);
-  hstats->set_downtime(downtime);
+static void fill_distribution(const quantile_sketch& sketch,
+                              StatsDistribution* to_fill) {
+  to_fill->set_count(sketch.count());
+  to_fill->set_min(sketch.min());
+  to_fill->set_max(sketch.max());
+  to_fill->set_average(sketch.average());
+  to_fill->set_p50(sketch.quantile(0.5));
+  to_fill->set_p90(sketch.quantile(0.9));
+  to_fill->set_p95(sketch.quantile(0.95));
+  to_fill->set_p99(sketch.quantile(0.99));
+  sketch.visit([to_fill](double upper_bound, uint64_t count) {
+    StatsHistogramBucket* bucket = to_fill->add_buckets();
+    bucket->set_upper_bound(upper_bound);
+    bucket->set_count(count);
+  });
+}
+
+static void fill_distributions(const check_stats::type_stats& stats,
+                               CheckTypeDistributions* to_fill) {
+  fill_distribution(stats.latency, to_fill->mutable_latency());
+  fill_distribution(stats.execution_time, to_fill->mutable_execution_time());
+  fill_distribution(stats.state_change, to_fill->mutable_state_change());
+}
+
+/**
+ * @brief GetStats hosts and services statistics with their histograms.
+ */
+int command_manager::get_check_stats(CheckStats* response) {
+  get_services_stats(response->mutable_services_stats());
+  get_hosts_stats(response->mutable_hosts_stats());
+  fill_distributions(check_stats::services().active(),
+                     response->mutable_active_services());
+  fill_distributions(check_stats::services().passive(),
+                     response->mutable_passive_services());
+  fill_distributions(check_stats::hosts().active(),
+                     response->mutable_active_hosts());
+  fill_distributions(check_stats::hosts().passive(),
+                     response->mutable_passive_hosts());
+
+  const events::check_throttle& throttle = events::check_throttle::instance();
+  fill_distribution(throttle.lateness_at_dispatch(),
+                    response->mutable_service_lateness_at_dispatch());
+  fill_distribution(throttle.lateness_at_launch(),
+                    response->mutable_service_lateness_at_launch());
+  response->set_deferred_service_checks(throttle.deferred_count());
+  response->set_service_check_rate(throttle.rate());
   return 0;
 }
 
@@ -178,11 +178,10 @@ int cmd_add_comment(int cmd, time_t entry_time, char* args) {
       return ERROR;
 
     /* verify that the service is valid */
-    service_map::const_iterator found(
-        service::services.find({host_name, svc_description}));
-    if (found == service::services.end() || !found->second)
+    const service* found = lookup_service(host_name, svc_description);
+    if (!found)
       return ERROR;
-    service_id = found->second->service_id();
+    service_id = found->service_id();
   } else {
     command_name = "ADD_HOST_COMMENT";
   }
@@ -260,10 +259,7 @@ int cmd_delete_all_comments(int cmd, char* args) {
       return ERROR;
 
     /* verify that the service is valid */
-    service_map::const_iterator found(
-        service::services.find({host_name, svc_description}));
-    if (found != service::services.end())
-      temp_service = found->second.get();
+    temp_service = lookup_service(host_name, svc_description);
     if (temp_service == nullptr)
       return ERROR;
     /* delete comments */
@@ -507,36 +503,32 @@ int cmd_process_service_check_result(int cmd [[maybe_unused]],
   if (ait == a.end())
     return ERROR;
 
-  std::string real_host_name;
-  auto host_name = *ait;
+  std::string_view host_name{ait->data(), ait->size()};
   ++ait;
 
   if (ait == a.end())
     return ERROR;
-  std::string svc_description{ait->data(), ait->size()};
+  std::string_view svc_description{ait->data(), ait->size()};
   ++ait;
 
   /* find the host by its name or address */
-  host_map::const_iterator it(host::hosts.find(host_name));
-  if (it != host::hosts.end() && it->second)
-    real_host_name = std::string(host_name.data(), host_name.size());
-  else {
+  const host* hst = lookup_host(host_name);
+  if (!hst) {
     for (host_map::iterator itt = host::hosts.begin(), end = host::hosts.end();
          itt != end; ++itt) {
       if (itt->second && itt->second->get_address() == host_name) {
-        real_host_name = itt->first;
-        it = itt;
+        hst = itt->second.get();
         break;
       }
     }
   }
 
   /* we couldn't find the host */
-  if (real_host_name.empty()) {
+  if (!hst) {
     engine_logger(log_runtime_warning, basic)
         << "Warning:  Passive check result was received for service '"
-        << svc_description << "' on host '" << real_host_name
-        << "', but the host could not be found!";
+        << std::string(svc_description) << "' on host '"
+        << std::string(host_name) << "', but the host could not be found!";
     runtime_logger->warn(
         "Warning:  Passive check result was received for service '{}' on host "
         "'{}', but the host could not be found!",
@@ -545,12 +537,11 @@ int cmd_process_service_check_result(int cmd [[maybe_unused]],
   }
 
   /* make sure the service exists */
-  service_map::const_iterator found(
-      service::services.find({real_host_name, svc_description}));
-  if (found == service::services.end() || !found->second) {
+  service* found = lookup_service(hst->name(), svc_description);
+  if (!found) {
     engine_logger(log_runtime_warning, basic)
         << "Warning:  Passive check result was received for service '"
-        << svc_description << "' on host '" << real_host_name
+        << std::string(svc_description) << "' on host '" << hst->name()
         << "', but the service could not be found!";
     runtime_logger->warn(
         "Warning:  Passive check result was received for service '{}' on "
@@ -560,7 +551,7 @@ int cmd_process_service_check_result(int cmd [[maybe_unused]],
   }
 
   /* skip this is we aren't accepting passive checks for this service */
-  if (!found->second->passive_checks_enabled())
+  if (!found->passive_checks_enabled())
     return ERROR;
 
   int32_t return_code;
@@ -578,8 +569,7 @@ int cmd_process_service_check_result(int cmd [[maybe_unused]],
   timeval set_tv = {.tv_sec = check_time, .tv_usec = 0};
 
   check_result::pointer result = std::make_shared<check_result>(
-      service_check, found->second.get(), checkable::check_passive,
-      CHECK_OPTION_NONE, false,
+      service_check, found, checkable::check_passive, CHECK_OPTION_NONE, false,
       static_cast<double>(tv.tv_sec - check_time) +
           static_cast<double>(tv.tv_usec / 1000000.0),
       set_tv, set_tv, false, true, return_code, std::move(output));
@@ -604,8 +594,6 @@ int process_passive_service_check(time_t check_time,
                                   char const* svc_description,
                                   int return_code,
                                   char const* output) {
-  char const* real_host_name(nullptr);
-
   bool accept_passive_service_checks =
       pb_config.accept_passive_service_checks();
 
@@ -619,22 +607,19 @@ int process_passive_service_check(time_t check_time,
     return ERROR;
 
   /* find the host by its name or address */
-  host_map::const_iterator it(host::hosts.find(host_name));
-  if (it != host::hosts.end() && it->second)
-    real_host_name = host_name;
-  else {
+  const host* hst = lookup_host(host_name);
+  if (!hst) {
     for (host_map::iterator itt(host::hosts.begin()), end(host::hosts.end());
          itt != end; ++itt) {
       if (itt->second && itt->second->get_address() == host_name) {
-        real_host_name = itt->first.c_str();
-        it = itt;
+        hst = itt->second.get();
         break;
       }
     }
   }
 
   /* we couldn't find the host */
-  if (real_host_name == nullptr) {
+  if (!hst) {
     engine_logger(log_runtime_warning, basic)
         << "Warning:  Passive check result was received for service '"
         << svc_description << "' on host '" << host_name
@@ -648,9 +633,8 @@ int process_passive_service_check(time_t check_time,
   }
 
   /* make sure the service exists */
-  service_map::const_iterator found(
-      service::services.find({real_host_name, svc_description}));
-  if (found == service::services.end() || !found->second) {
+  service* found = lookup_service(hst->name(), svc_description);
+  if (!found) {
     engine_logger(log_runtime_warning, basic)
         << "Warning:  Passive check result was received for service '"
         << svc_description << "' on host '" << host_name
@@ -664,7 +648,7 @@ int process_passive_service_check(time_t check_time,
   }
 
   /* skip this is we aren't accepting passive checks for this service */
-  if (!found->second->passive_checks_enabled())
+  if (!found->passive_checks_enabled())
     return ERROR;
 
   timeval tv;
@@ -673,8 +657,7 @@ int process_passive_service_check(time_t check_time,
   timeval set_tv = {.tv_sec = check_time, .tv_usec = 0};
 
   check_result::pointer result = std::make_shared<check_result>(
-      service_check, found->second.get(), checkable::check_passive,
-      CHECK_OPTION_NONE, false,
+      service_check, found, checkable::check_passive, CHECK_OPTION_NONE, false,
       static_cast<double>(tv.tv_sec - check_time) +
           static_cast<double>(tv.tv_usec / 1000000.0),
       set_tv, set_tv, false, true, return_code, output);
@@ -916,13 +899,13 @@ int cmd_remove_acknowledgement(int cmd, char* args) {
           return ERROR;
 
         /* verify that the service is valid */
-        service_map::const_iterator sit = service::services.find(
-            std::make_pair(std::string(hostname.data(), hostname.size()),
-                           std::string(ait->data(), ait->size())));
+        service* svc = lookup_service(
+            std::string_view(hostname.data(), hostname.size()),
+            std::string_view(ait->data(), ait->size()));
 
-        if (sit == service::services.end() || !sit->second)
+        if (!svc)
           return ERROR;
-        remove_service_acknowledgement(sit->second.get());
+        remove_service_acknowledgement(svc);
       }
       break;
   }
@@ -977,13 +960,12 @@ int cmd_schedule_downtime(int cmd, time_t entry_time, char* args) {
       /* get the service name */
       if (ait == a.end())
         return ERROR;
-      service_map::const_iterator found = service::services.find(
-          {temp_host->name(), std::string(ait->data(), ait->size())});
+      temp_service = lookup_service(
+          temp_host->name(), std::string_view(ait->data(), ait->size()));
 
-      if (found == service::services.end() || !found->second)
+      if (!temp_service)
         return ERROR;
       ++ait;
-      temp_service = found->second.get();
     }
   }
 
@@ -2107,17 +2089,17 @@ int cmd_change_object_custom_var(int cmd, char* args) {
       temp_host->add_modified_attributes(MODATTR_CUSTOM_VARIABLE);
     } break;
     case CMD_CHANGE_CUSTOM_SVC_VAR: {
-      service_map::const_iterator found(service::services.find({name1, name2}));
+      service* found = lookup_service(name1, name2);
 
-      if (found == service::services.end() || !found->second)
+      if (!found)
         return ERROR;
-      map_customvar::iterator it(found->second->custom_variables.find(varname));
-      if (it == found->second->custom_variables.end())
-        found->second->custom_variables[varname] = customvariable(varvalue);
+      map_customvar::iterator it(found->custom_variables.find(varname));
+      if (it == found->custom_variables.end())
+        found->custom_variables[varname] = customvariable(varvalue);
       else
         it->second.update(varvalue);
 
-      found->second->add_modified_attributes(MODATTR_CUSTOM_VARIABLE);
+      found->add_modified_attributes(MODATTR_CUSTOM_VARIABLE);
     } break;
     case CMD_CHANGE_CUSTOM_CONTACT_VAR: {
       contact_map::iterator cnct_it = contact::contacts.find(name1);
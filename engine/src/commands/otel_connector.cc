@@ -17,6 +17,9 @@
  */
 
 #include "com/centreon/engine/commands/otel_connector.hh"
+#include "com/centreon/engine/commands/forward.hh"
+#include "com/centreon/engine/host.hh"
+#include "com/centreon/engine/service.hh"
 #include "com/centreon/exceptions/msg_fmt.hh"
 #include "common/log_v2/log_v2.hh"
 
@@ -96,14 +99,39 @@ std::shared_ptr<otel_connector> otel_connector::get_otel_connector(
  * @brief get otel command that is used by host serv
  * Caution: This function must be called from engine main thread
  *
+ * The host or the service is looked up once and its check command gives the
+ * connector, we only try every connector if this command is not an otel one.
+ *
  * @param host
  * @param serv
+ * @param host_or_serv if not null, filled with the host or the service found
+ * so that the caller doesn't have to look it up again
  * @return std::shared_ptr<otel_connector> null if not found
  */
 std::shared_ptr<otel_connector>
 otel_connector::get_otel_connector_from_host_serv(
     const std::string_view& host,
-    const std::string_view& serv) {
+    const std::string_view& serv,
+    notifier** host_or_serv) {
+  notifier* target;
+  if (serv.empty())
+    target = lookup_host(host);
+  else
+    target = lookup_service(host, serv);
+  if (host_or_serv)
+    *host_or_serv = target;
+  if (!target)
+    return {};
+
+  std::shared_ptr<forward> fwd =
+      std::dynamic_pointer_cast<forward>(target->get_check_command_ptr());
+  if (fwd) {
+    std::shared_ptr<otel_connector> conn =
+        std::dynamic_pointer_cast<otel_connector>(fwd->get_sub_command());
+    if (conn)
+      return conn;
+  }
+
   for (const auto& name_to_conn : _commands) {
     if (name_to_conn.second->_host_serv_list->contains(host, serv)) {
       return name_to_conn.second;
@@ -205,16 +233,14 @@ void otel_connector::run(const std::string& processed_cmd [[maybe_unused]],
  * checks::checker::instance() Caution, this function must be called from engine
  * main thread
  *
- * @param host
- * @param serv empty if result of host check
+ * @param host_or_serv host or service that owns the data points
  * @param data_pts opentelemetry data points
  */
 void otel_connector::process_data_pts(
-    const std::string_view& host,
-    const std::string_view& serv,
+    notifier* host_or_serv,
     const com::centreon::engine::modules::opentelemetry::metric_to_datapoints&
         data_pts) {
-  _check_result_builder->process_data_pts(host, serv, data_pts);
+  _check_result_builder->process_data_pts(host_or_serv, data_pts);
 }
 
 /**
@@ -30,18 +30,58 @@ std::shared_ptr<com::centreon::engine::commands::otel::open_telemetry_base>
 void host_serv_list::register_host_serv(
     const std::string& host,
     const std::string& service_description) {
-  absl::WriterMutexLock l(&_data_m);
-  _data[host].insert(service_description);
+  host_change_listener to_call;
+  {
+    absl::WriterMutexLock l(&_data_m);
+    auto host_insert = _data.try_emplace(host);
+    host_insert.first->second.insert(service_description);
+    if (host_insert.second)
+      to_call = _on_host_change;
+  }
+  if (to_call)
+    to_call();
 }
 
 void host_serv_list::remove(const std::string& host,
                             const std::string& service_description) {
-  absl::WriterMutexLock l(&_data_m);
-  auto host_search = _data.find(host);
-  if (host_search != _data.end()) {
-    host_search->second.erase(service_description);
-    if (host_search->second.empty()) {
-      _data.erase(host_search);
+  host_change_listener to_call;
+  {
+    absl::WriterMutexLock l(&_data_m);
+    auto host_search = _data.find(host);
+    if (host_search != _data.end()) {
+      host_search->second.erase(service_description);
+      if (host_search->second.empty()) {
+        _data.erase(host_search);
+        to_call = _on_host_change;
+      }
     }
   }
+  if (to_call)
+    to_call();
+}
+
+/**
+ * @brief set the function called each time a host is added to or removed
+ * from the list. It's called without lock, by the thread that modifies the
+ * list.
+ *
+ * @param listener
+ */
+void host_serv_list::set_host_change_listener(host_change_listener&& listener) {
+  absl::WriterMutexLock l(&_data_m);
+  _on_host_change = std::move(listener);
+}
+
+/**
+ * @brief copy of the host names of the list
+ *
+ * @return std::vector<std::string>
+ */
+std::vector<std::string> host_serv_list::get_hosts() const {
+  std::vector<std::string> ret;
+  absl::ReaderMutexLock l(&_data_m);
+  ret.reserve(_data.size());
+  for (const auto& host_servs : _data)
+    ret.push_back(host_servs.first);
+  return ret;
 }
@@ -629,15 +629,15 @@ void processing::_redirector_service(int id, time_t entry_time, char* args) {
   char* name(my_strtok(args, ";"));
   char* description(my_strtok(NULL, ";"));
 
-  service_map::const_iterator found(
-      service::services.find({name, description}));
+  service* found =
+      name && description ? lookup_service(name, description) : nullptr;
 
-  if (found == service::services.end() || !found->second) {
+  if (!found) {
     SPDLOG_LOGGER_ERROR(external_command_logger, "unknown service: {}@{}",
-                        description, name);
+                        description ? description : "", name ? name : "");
     return;
   }
-  (*fptr)(found->second.get());
+  (*fptr)(found);
 }
 
 template <void (*fptr)(service*, char*)>
@@ -645,17 +645,18 @@ void processing::_redirector_service(int id, time_t entry_time, char* args) {
   (void)id;
   (void)entry_time;
 
-  std::string name{my_strtok(args, ";")};
-  std::string description{my_strtok(NULL, ";")};
-  service_map::const_iterator found{
-      service::services.find({name, description})};
+  const char* name_str = my_strtok(args, ";");
+  const char* description_str = my_strtok(NULL, ";");
+  std::string_view name{name_str ? name_str : ""};
+  std::string_view description{description_str ? description_str : ""};
+  service* found = lookup_service(name, description);
 
-  if (found == service::services.end() || !found->second) {
+  if (!found) {
     SPDLOG_LOGGER_ERROR(external_command_logger, "unknown service: {}@{}",
                         description, name);
     return;
   }
-  (*fptr)(found->second.get(), args + name.length() + description.length() + 2);
+  (*fptr)(found, args + name.length() + description.length() + 2);
 }
 
 template <void (*fptr)(service*)>
@@ -765,26 +766,24 @@ void processing::_redirector_anomalydetection(int id,
   (void)id;
   (void)entry_time;
 
-  std::string name{my_strtok(args, ";")};
-  std::string description{my_strtok(NULL, ";")};
-  service_map::const_iterator found{
-      service::services.find({name, description})};
+  std::string_view name{my_strtok(args, ";")};
+  std::string_view description{my_strtok(NULL, ";")};
+  service* found = lookup_service(name, description);
 
-  if (found == service::services.end() || !found->second) {
+  if (!found) {
     SPDLOG_LOGGER_ERROR(external_command_logger,
                         "unknown anomaly detection {}@{}", description, name);
     return;
   }
 
-  if (found->second->get_service_type() != service_type::ANOMALY_DETECTION) {
+  if (found->get_service_type() != service_type::ANOMALY_DETECTION) {
     SPDLOG_LOGGER_ERROR(external_command_logger,
                         "{}@{} is not an anomalydetection", description, name);
     return;
   }
 
-  std::shared_ptr<anomalydetection> ano =
-      std::static_pointer_cast<anomalydetection>(found->second);
-  (*fptr)(ano.get(), args + name.length() + description.length() + 2);
+  (*fptr)(static_cast<anomalydetection*>(found),
+          args + name.length() + description.length() + 2);
 }
 
 bool processing::execute(const std::string& cmdstr) {
@@ -18,7 +18,9 @@
 
 #include "com/centreon/engine/commands/raw_v2.hh"
 #include "com/centreon/common/process/process.hh"
+#include "com/centreon/common/process/spawn_protocol.hh"
 #include "com/centreon/engine/commands/environment.hh"
+#include "com/centreon/engine/commands/spawn_helper.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging/logger.hh"
 #include "com/centreon/engine/macros.hh"
@@ -57,12 +59,37 @@ raw_v2::~raw_v2() {
   }
 }
 
-static void _build_argv_macro_environment(
-    nagios_macros const& macros,
-    boost::process::v2::process_environment& env) {
+static std::vector<std::pair<std::string, std::string>> _empty_args;
+
+/**
+ * Environment variables are either stored in a process_environment when
+ * centengine starts the check itself, or written directly in the request sent
+ * to the spawn helper.
+ */
+static void _add_env(boost::process::v2::process_environment& env,
+                     const std::string& key,
+                     const std::string& value) {
+  env.env_buffer.emplace_back(key, value);
+}
+
+static void _add_env(spawn_protocol::request_writer& env,
+                     const std::string& key,
+                     const std::string& value) {
+  env.add_env(key, value);
+}
+
+static void _end_env(boost::process::v2::process_environment& env) {
+  env.env = env.build_env(_empty_args);
+}
+
+static void _end_env(spawn_protocol::request_writer&) {}
+
+template <typename env_type>
+static void _build_argv_macro_environment(nagios_macros const& macros,
+                                          env_type& env) {
   for (uint32_t i(0); i < MAX_COMMAND_ARGUMENTS; ++i) {
-    env.env_buffer.emplace_back(
-        fmt::format(MACRO_ENV_VAR_PREFIX "ARG{}", i + 1), macros.argv[i]);
+    _add_env(env, fmt::format(MACRO_ENV_VAR_PREFIX "ARG{}", i + 1),
+             macros.argv[i]);
   }
 }
 
@@ -72,15 +99,15 @@ static void _build_argv_macro_environment(
  *  @param[in]  macros  The macros data struct.
  *  @param[out] env     The environment to fill.
  */
-static void _build_contact_address_environment(
-    nagios_macros const& macros,
-    boost::process::v2::process_environment& env) {
+template <typename env_type>
+static void _build_contact_address_environment(nagios_macros const& macros,
+                                               env_type& env) {
   if (!macros.contact_ptr)
     return;
   std::vector<std::string> const& address(macros.contact_ptr->get_addresses());
   for (uint32_t i(0); i < address.size(); ++i) {
-    env.env_buffer.emplace_back(
-        fmt::format(MACRO_ENV_VAR_PREFIX "CONTACTADDRESS{}", i), address[i]);
+    _add_env(env, fmt::format(MACRO_ENV_VAR_PREFIX "CONTACTADDRESS{}", i),
+             address[i]);
   }
 }
 
@@ -90,9 +117,9 @@ static void _build_contact_address_environment(
  *  @param[in,out] macros  The macros data struct.
  *  @param[out]    env     The environment to fill.
  */
-static void _build_custom_contact_macro_environment(
-    nagios_macros& macros,
-    boost::process::v2::process_environment& env) {
+template <typename env_type>
+static void _build_custom_contact_macro_environment(nagios_macros& macros,
+                                                    env_type& env) {
   // Build custom contact variable.
   contact* cntct(macros.contact_ptr);
   if (cntct) {
@@ -113,7 +140,7 @@ static void _build_custom_contact_macro_environment(
           cv.second.value(), STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS));
       key = MACRO_ENV_VAR_PREFIX;
       key.append(cv.first);
-      env.env_buffer.emplace_back(key, value);
+      _add_env(env, key, value);
     }
   }
 }
@@ -124,9 +151,9 @@ static void _build_custom_contact_macro_environment(
  *  @param[in,out] macros  The macros data struct.
  *  @param[out]    env     The environment to fill.
  */
-static void _build_custom_host_macro_environment(
-    nagios_macros& macros,
-    boost::process::v2::process_environment& env) {
+template <typename env_type>
+static void _build_custom_host_macro_environment(nagios_macros& macros,
+                                                 env_type& env) {
   // Build custom host variable.
   host* hst(macros.host_ptr);
   if (hst) {
@@ -147,7 +174,7 @@ static void _build_custom_host_macro_environment(
           cv.second.value(), STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS));
       key = MACRO_ENV_VAR_PREFIX;
       key.append(cv.first);
-      env.env_buffer.emplace_back(key, value);
+      _add_env(env, key, value);
     }
   }
 }
@@ -158,9 +185,9 @@ static void _build_custom_host_macro_environment(
  *  @param[in,out] macros  The macros data struct.
  *  @param[out]    env     The environment to fill.
  */
-static void _build_custom_service_macro_environment(
-    nagios_macros& macros,
-    boost::process::v2::process_environment& env) {
+template <typename env_type>
+static void _build_custom_service_macro_environment(nagios_macros& macros,
+                                                    env_type& env) {
   // Build custom service variable.
   service* svc(macros.service_ptr);
   if (svc) {
@@ -182,7 +209,7 @@ static void _build_custom_service_macro_environment(
       std::string key;
       key = MACRO_ENV_VAR_PREFIX;
       key.append(cv.first);
-      env.env_buffer.emplace_back(key, value);
+      _add_env(env, key, value);
     }
   }
 }
@@ -193,9 +220,8 @@ static void _build_custom_service_macro_environment(
  *  @param[in,out] macros  The macros data struct.
  *  @param[out]    env     The environment to fill.
  */
-static void _build_macrosx_environment(
-    nagios_macros& macros,
-    boost::process::v2::process_environment& env) {
+template <typename env_type>
+static void _build_macrosx_environment(nagios_macros& macros, env_type& env) {
   bool use_large_installation_tweaks =
       pb_config.use_large_installation_tweaks();
   std::string key;
@@ -216,7 +242,7 @@ static void _build_macrosx_environment(
       std::string line;
       key = MACRO_ENV_VAR_PREFIX;
       key.append(macro_x_names[i]);
-      env.env_buffer.emplace_back(key, macros.x[i]);
+      _add_env(env, key, macros.x[i]);
     }
 
     // Release memory if necessary.
@@ -226,16 +252,14 @@ static void _build_macrosx_environment(
   }
 }
 
-static std::vector<std::pair<std::string, std::string>> _empty_args;
-
 /**
  *  Build all macro environemnt variable.
  *
  *  @param[in,out] macros  The macros data struct.
  *  @param[out]    env     The environment to fill.
  */
-void _build_environment_macros(nagios_macros& macros,
-                               boost::process::v2::process_environment& env) {
+template <typename env_type>
+static void _build_environment_macros(nagios_macros& macros, env_type& env) {
   bool enable_environment_macros = pb_config.enable_environment_macros();
   if (enable_environment_macros) {
     _build_macrosx_environment(macros, env);
@@ -244,7 +268,7 @@ void _build_environment_macros(nagios_macros& macros,
     _build_custom_service_macro_environment(macros, env);
     _build_custom_contact_macro_environment(macros, env);
     _build_contact_address_environment(macros, env);
-    env.env = env.build_env(_empty_args);
+    _end_env(env);
   }
 }
 
@@ -286,27 +310,38 @@ uint64_t raw_v2::run(const std::string& processed_cmd,
     return command_id;
   }
 
+  SPDLOG_LOGGER_TRACE(commands_logger, "raw_v2::run: id={}", command_id);
+
+  // we don't want that lambda own raw because raw could be deleted by lambda
+  // exit called by pool thread
+  auto on_complete = [me = weak_from_this(), command_id,
+                      start = time(nullptr)](
+                         int exit_code, int exit_status,
+                         const std::string& std_out,
+                         const std::string& std_err) {
+    std::shared_ptr<raw_v2> parent =
+        std::static_pointer_cast<raw_v2>(me.lock());
+    if (parent) {
+      parent->_on_complete(command_id, start, exit_code, exit_status, std_out,
+                           std_err);
+    }
+  };
+
+  if (_run_by_spawn_helper(command_id, macros, timeout, on_complete))
+    return command_id;
+
   std::shared_ptr<boost::process::v2::process_environment> env =
       std::make_shared<boost::process::v2::process_environment>(_empty_args);
-
-  SPDLOG_LOGGER_TRACE(commands_logger, "raw_v2::run: id={}", command_id);
   _build_environment_macros(macros, *env);
 
   try {
     _process = std::make_shared<common::process<true>>(
         g_io_context, commands_logger, _process_args, true, false, env);
-    // we don't want that lambda own raw because raw could be deleted by lambda
-    // exit called by pool thread
     _process->start_process(
-        [me = weak_from_this(), command_id, start = time(nullptr)](
-            const common::process<true>&, int exit_code, int exit_status,
-            const std::string& std_out, const std::string& std_err) {
-          std::shared_ptr<raw_v2> parent =
-              std::static_pointer_cast<raw_v2>(me.lock());
-          if (parent) {
-            parent->_on_complete(command_id, start, exit_code, exit_status,
-                                 std_out, std_err);
-          }
+        [on_complete](const common::process<true>&, int exit_code,
+                      int exit_status, const std::string& std_out,
+                      const std::string& std_err) {
+          on_complete(exit_code, exit_status, std_out, std_err);
         },
         std::chrono::seconds(timeout));
     SPDLOG_LOGGER_TRACE(commands_logger,
@@ -322,6 +357,46 @@ uint64_t raw_v2::run(const std::string& processed_cmd,
   return command_id;
 }
 
+/**
+ * @brief start the check with the spawn helper if it's available. The
+ * request, arguments and environment included, is written in one buffer.
+ *
+ * @param command_id
+ * @param macros
+ * @param timeout
+ * @param handler called on check completion
+ * @return true if the helper has accepted the check, false if the caller has
+ * to start the process itself.
+ */
+bool raw_v2::_run_by_spawn_helper(uint64_t command_id,
+                                  nagios_macros& macros,
+                                  uint32_t timeout,
+                                  spawn_helper::handler_type&& handler) {
+  std::shared_ptr<spawn_helper> helper = spawn_helper::instance();
+  if (!helper)
+    return false;
+
+  std::string request;
+  {
+    spawn_protocol::request_writer writer(request, command_id, timeout);
+    for (const char* arg : _process_args->get_c_args()) {
+      if (arg)
+        writer.add_arg(arg);
+    }
+    _build_environment_macros(macros, writer);
+    writer.end();
+  }
+  if (!helper->run(command_id, std::move(request), std::move(handler)))
+    return false;
+
+  // a previous process launched by centengine is over
+  _process.reset();
+  SPDLOG_LOGGER_TRACE(commands_logger,
+                      "raw_v2::run: check sent to spawn helper: id={}",
+                      command_id);
+  return true;
+}
+
 /**
  * @brief completion handler called by child process object
  * It fills a result struct. If std_out is not empty, we store it in result.out
@@ -413,48 +488,57 @@ void raw_v2::run(const std::string& processed_cmd,
 
   uint64_t command_id(get_uniq_id());
 
-  std::shared_ptr<boost::process::v2::process_environment> env =
-      std::make_shared<boost::process::v2::process_environment>(_empty_args);
-
   SPDLOG_LOGGER_TRACE(commands_logger, "raw_v2::run: id={}", command_id);
-  _build_environment_macros(macros, *env);
 
   absl::Mutex waiter;
   bool done = false;
 
-  try {
-    _process = std::make_shared<common::process<true>>(
-        g_io_context, commands_logger, _process_args, true, false, env);
-    _process->start_process(
-        [me = shared_from_this(), command_id, start = time(nullptr), &waiter,
-         &done, &res](const common::process<true>&, int exit_code,
-                      int exit_status, const std::string& std_out,
-                      const std::string& std_err) {
-          absl::MutexLock lck(&waiter);
-          bool expected = true;
-          if (!me->_running.compare_exchange_strong(expected, false)) {
-            SPDLOG_LOGGER_ERROR(commands_logger,
-                                "bad running state while waiting for {}",
-                                me->get_name());
-            return;
-          }
-          res.command_id = command_id;
-          res.start_time = start;
-          res.end_time = time(nullptr);
-          res.exit_code = exit_code;
-          res.exit_status = static_cast<process::status>(exit_status);
-          res.output = !std_out.empty() ? std_out : std_err;
-          done = true;
-        },
-        std::chrono::seconds(timeout));
-    SPDLOG_LOGGER_TRACE(commands_logger,
-                        "raw_v2::run: start process success: id={}",
-                        command_id);
-  } catch (const std::exception& e) {
-    SPDLOG_LOGGER_TRACE(commands_logger,
-                        "raw_v2::run: start process failed: id={}, {}: {}",
-                        command_id, _name, e.what());
-    throw;
+  auto on_complete = [me = shared_from_this(), command_id,
+                      start = time(nullptr), &waiter, &done,
+                      &res](int exit_code, int exit_status,
+                            const std::string& std_out,
+                            const std::string& std_err) {
+    absl::MutexLock lck(&waiter);
+    bool expected = true;
+    if (!me->_running.compare_exchange_strong(expected, false)) {
+      SPDLOG_LOGGER_ERROR(commands_logger,
+                          "bad running state while waiting for {}",
+                          me->get_name());
+      return;
+    }
+    res.command_id = command_id;
+    res.start_time = start;
+    res.end_time = time(nullptr);
+    res.exit_code = exit_code;
+    res.exit_status = static_cast<process::status>(exit_status);
+    res.output = !std_out.empty() ? std_out : std_err;
+    done = true;
+  };
+
+  if (!_run_by_spawn_helper(command_id, macros, timeout, on_complete)) {
+    std::shared_ptr<boost::process::v2::process_environment> env =
+        std::make_shared<boost::process::v2::process_environment>(_empty_args);
+    _build_environment_macros(macros, *env);
+
+    try {
+      _process = std::make_shared<common::process<true>>(
+          g_io_context, commands_logger, _process_args, true, false, env);
+      _process->start_process(
+          [on_complete](const common::process<true>&, int exit_code,
+                        int exit_status, const std::string& std_out,
+                        const std::string& std_err) {
+            on_complete(exit_code, exit_status, std_out, std_err);
+          },
+          std::chrono::seconds(timeout));
+      SPDLOG_LOGGER_TRACE(commands_logger,
+                          "raw_v2::run: start process success: id={}",
+                          command_id);
+    } catch (const std::exception& e) {
+      SPDLOG_LOGGER_TRACE(commands_logger,
+                          "raw_v2::run: start process failed: id={}, {}: {}",
+                          command_id, _name, e.what());
+      throw;
+    }
   }
 
   absl::MutexLock lck(&waiter);
@@ -0,0 +1,306 @@
+/**
+ * Copyright 2025 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include <sys/socket.h>
+
+#include "com/centreon/common/process/detail/spawnp_launcher.hh"
+#include "com/centreon/common/process/process.hh"
+#include "com/centreon/common/process/spawn_protocol.hh"
+#include "com/centreon/engine/commands/spawn_helper.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/exceptions/msg_fmt.hh"
+
+using namespace com::centreon::common;
+using namespace com::centreon::engine::commands;
+
+struct spawn_helper::helper_process {
+  boost::process::v2::basic_process<asio::io_context::executor_type> proc;
+
+  helper_process(
+      boost::process::v2::basic_process<asio::io_context::executor_type>&&
+          created)
+      : proc(std::move(created)) {}
+};
+
+absl::Mutex spawn_helper::_instance_m;
+std::string spawn_helper::_path;
+std::shared_ptr<spawn_helper> spawn_helper::_instance;
+std::chrono::steady_clock::time_point spawn_helper::_last_start;
+
+spawn_helper::spawn_helper(const std::shared_ptr<asio::io_context>& io_context,
+                           const std::shared_ptr<spdlog::logger>& logger)
+    : _io_context(io_context),
+      _logger(logger),
+      _socket(*io_context),
+      _read_buffer(0x10000, 0) {}
+
+/**
+ * @brief the helper is not killed, it exits when it reads the end of the
+ * socket.
+ */
+spawn_helper::~spawn_helper() noexcept {
+  boost::system::error_code err;
+  _socket.close(err);
+  if (_process)
+    _process->proc.detach();
+}
+
+/**
+ * @brief start centenginespawn with a unix socket as stdin.
+ *
+ * @param path path of the centenginespawn executable
+ */
+void spawn_helper::_start(const std::string& path) {
+  int fds[2];
+  if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, fds))
+    throw exceptions::msg_fmt("fail to create spawn helper socket: {}",
+                              strerror(errno));
+
+  auto args =
+      std::make_shared<process_args>(path, std::vector<std::string>());
+  try {
+    _process = std::make_unique<helper_process>(
+        detail::spawnp(*_io_context, args, false, fds[1], -1, -1, nullptr));
+  } catch (const std::exception& e) {
+    ::close(fds[0]);
+    ::close(fds[1]);
+    throw exceptions::msg_fmt("fail to start spawn helper {}: {}", path,
+                              e.what());
+  }
+  ::close(fds[1]);
+  _socket.assign(asio::local::stream_protocol(), fds[0]);
+
+  SPDLOG_LOGGER_INFO(_logger, "spawn helper {} started, pid={}", path,
+                     _process->proc.id());
+
+  _process->proc.async_wait(
+      [me = shared_from_this()](const boost::system::error_code& err,
+                                int raw_exit_status) {
+        if (err)
+          me->_on_failure(
+              fmt::format("spawn helper lost: {}", err.message()));
+        else
+          me->_on_failure(fmt::format("spawn helper exited with status {}",
+                                      raw_exit_status));
+      });
+  _read();
+}
+
+/**
+ * @brief start the helper at boot. An empty path disables it.
+ *
+ * @param path path of the centenginespawn executable
+ */
+void spawn_helper::load(const std::string& path) {
+  absl::MutexLock l(&_instance_m);
+  _path = path;
+  if (path.empty())
+    return;
+  _last_start = std::chrono::steady_clock::now();
+  try {
+    auto helper = std::make_shared<spawn_helper>(g_io_context, commands_logger);
+    helper->_start(path);
+    _instance = std::move(helper);
+  } catch (const std::exception& e) {
+    SPDLOG_LOGGER_ERROR(commands_logger,
+                        "{}, checks will be started by centengine", e.what());
+  }
+}
+
+/**
+ * @brief close the connection, the helper kills the running checks and
+ * exits.
+ */
+void spawn_helper::unload() {
+  absl::MutexLock l(&_instance_m);
+  _path.clear();
+  if (_instance) {
+    {
+      absl::MutexLock lck(&_instance->_protect);
+      _instance->_alive = false;
+      _instance->_pending.clear();
+      boost::system::error_code err;
+      _instance->_socket.close(err);
+    }
+    _instance.reset();
+  }
+}
+
+/**
+ * @brief get the running helper. If it's dead, it's restarted if it has not
+ * been started in the last restart_delay.
+ *
+ * @return std::shared_ptr<spawn_helper> nullptr if helper is disabled or not
+ * available, caller has to start the check itself.
+ */
+std::shared_ptr<spawn_helper> spawn_helper::instance() {
+  absl::MutexLock l(&_instance_m);
+  if (_instance && _instance->alive())
+    return _instance;
+  if (_path.empty())
+    return nullptr;
+  auto now = std::chrono::steady_clock::now();
+  if (now - _last_start < restart_delay)
+    return nullptr;
+  _last_start = now;
+  _instance.reset();
+  try {
+    auto helper = std::make_shared<spawn_helper>(g_io_context, commands_logger);
+    helper->_start(_path);
+    _instance = std::move(helper);
+  } catch (const std::exception& e) {
+    SPDLOG_LOGGER_ERROR(commands_logger, "{}", e.what());
+  }
+  return _instance;
+}
+
+bool spawn_helper::alive() const {
+  absl::MutexLock l(&_protect);
+  return _alive;
+}
+
+/**
+ * @brief send a request to the helper
+ *
+ * @param id request id, it must be unique among pending requests
+ * @param request a request built with spawn_protocol::request_writer
+ * @param handler called from an io_context thread when check is over
+ * @return false if helper is dead, handler won't be called.
+ */
+bool spawn_helper::run(uint64_t id,
+                       std::string&& request,
+                       handler_type&& handler) {
+  absl::MutexLock l(&_protect);
+  if (!_alive)
+    return false;
+  _pending.insert_or_assign(id, std::move(handler));
+  if (_to_send.empty())
+    _to_send = std::move(request);
+  else
+    _to_send.append(request);
+  _write();
+  return true;
+}
+
+/**
+ * @brief send all the requests waiting in _to_send if no write is pending
+ */
+void spawn_helper::_write() {
+  if (_write_pending || _to_send.empty())
+    return;
+  _sending.swap(_to_send);
+  _to_send.clear();
+  _write_pending = true;
+  asio::async_write(
+      _socket, asio::buffer(_sending),
+      [me = shared_from_this()](const boost::system::error_code& err,
+                                size_t) { me->_on_write(err); });
+}
+
+void spawn_helper::_on_write(const boost::system::error_code& err) {
+  if (err) {
+    _on_failure(fmt::format("fail to write to spawn helper: {}",
+                            err.message()));
+    return;
+  }
+  absl::MutexLock l(&_protect);
+  _write_pending = false;
+  if (_alive)
+    _write();
+}
+
+void spawn_helper::_read() {
+  if (_read_buffer.size() - _read_size < 0x1000)
+    _read_buffer.resize(_read_buffer.size() * 2);
+  _socket.async_read_some(
+      asio::buffer(_read_buffer.data() + _read_size,
+                   _read_buffer.size() - _read_size),
+      [me = shared_from_this()](const boost::system::error_code& err,
+                                size_t nb_read) {
+        me->_on_read(err, nb_read);
+      });
+}
+
+/**
+ * @brief handle all the complete responses received. Handlers are called
+ * outside of the lock.
+ */
+void spawn_helper::_on_read(const boost::system::error_code& err,
+                            size_t nb_read) {
+  if (err) {
+    _on_failure(
+        fmt::format("fail to read from spawn helper: {}", err.message()));
+    return;
+  }
+  _read_size += nb_read;
+
+  std::string_view data(_read_buffer.data(), _read_size);
+  spawn_protocol::response resp;
+  try {
+    for (size_t size = spawn_protocol::frame_size(data); size;
+         size = spawn_protocol::frame_size(data)) {
+      if (!spawn_protocol::parse_response(data.substr(0, size), resp))
+        throw exceptions::msg_fmt("malformed response from spawn helper");
+      data.remove_prefix(size);
+
+      handler_type handler;
+      {
+        absl::MutexLock l(&_protect);
+        auto found = _pending.find(resp.id);
+        if (found == _pending.end())
+          continue;
+        handler = std::move(found->second);
+        _pending.erase(found);
+      }
+      handler(resp.exit_code, resp.exit_status, std::string(resp.std_out),
+              std::string(resp.std_err));
+    }
+  } catch (const std::exception& e) {
+    _on_failure(e.what());
+    return;
+  }
+  if (data.size() < _read_size) {
+    memmove(_read_buffer.data(), data.data(), data.size());
+    _read_size = data.size();
+  }
+  _read();
+}
+
+/**
+ * @brief helper is dead or unreachable, all pending checks end with a crash
+ * status. The next call to instance() may start a new helper.
+ *
+ * @param reason
+ */
+void spawn_helper::_on_failure(const std::string& reason) {
+  absl::flat_hash_map<uint64_t, handler_type> pending;
+  {
+    absl::MutexLock l(&_protect);
+    if (!_alive)
+      return;
+    _alive = false;
+    pending.swap(_pending);
+    _to_send.clear();
+    boost::system::error_code err;
+    _socket.close(err);
+  }
+  SPDLOG_LOGGER_ERROR(_logger, "{}, {} running checks are lost", reason,
+                      pending.size());
+  for (auto& to_call : pending)
+    to_call.second(-1, e_exit_status::crash, "", reason);
+}
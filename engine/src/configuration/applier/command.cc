@@ -74,6 +74,8 @@ void applier::command::add_object(const configuration::Command& obj) {
       }
     }
   }
+  commands::command::commands[obj.command_name()]->set_max_parallel_checks(
+      obj.max_parallel_checks());
 }
 
 /**
@@ -144,6 +146,7 @@ void applier::command::modify_object(configuration::Command* to_modify,
       }
     }
   }
+  it_obj->second->set_max_parallel_checks(new_obj.max_parallel_checks());
 }
 
 /**
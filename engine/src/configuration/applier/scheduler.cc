@@ -18,6 +18,7 @@
  */
 
 #include "com/centreon/engine/configuration/applier/scheduler.hh"
+#include "com/centreon/engine/check_stats.hh"
 #include "com/centreon/engine/configuration/applier/difference.hh"
 #include "com/centreon/engine/configuration/applier/state.hh"
 #include "com/centreon/engine/deleter/listmember.hh"
@@ -863,6 +864,8 @@ void applier::scheduler::_schedule_host_events(
     // update status of all hosts (scheduled or not).
     // FIXME DBO: Is this really needed?
     // h->update_status();
+    // Statistics have to follow the values restored from retention.
+    check_stats::hosts().update(*h, h->get_current_state(), now);
 
     // skip most hosts that shouldn't be scheduled.
     if (!h->get_should_be_scheduled()) {
@@ -972,6 +975,8 @@ void applier::scheduler::_schedule_service_events(
     // update status of all services (scheduled or not).
     // FIXME DBO: Is this really needed?
     // s->update_status();
+    // Statistics have to follow the values restored from retention.
+    check_stats::services().update(*s, s->get_current_state(), now);
 
     // skip most services that shouldn't be scheduled.
     if (!s->get_should_be_scheduled()) {
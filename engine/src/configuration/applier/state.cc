@@ -357,8 +357,18 @@ void applier::state::_apply(const configuration::State& new_cfg,
   pb_config.set_max_log_file_size(new_cfg.max_log_file_size());
   pb_config.set_max_parallel_service_checks(
       new_cfg.max_parallel_service_checks());
+  pb_config.set_adaptive_check_scheduling(new_cfg.adaptive_check_scheduling());
+  pb_config.set_max_check_rate(new_cfg.max_check_rate());
   pb_config.set_max_service_check_spread(new_cfg.max_service_check_spread());
   pb_config.set_notification_timeout(new_cfg.notification_timeout());
+  pb_config.set_notification_digest_command(
+      new_cfg.notification_digest_command());
+  pb_config.set_notification_digest_window(
+      new_cfg.notification_digest_window());
+  pb_config.set_notification_digest_threshold(
+      new_cfg.notification_digest_threshold());
+  pb_config.set_notification_digest_max_entries(
+      new_cfg.notification_digest_max_entries());
   pb_config.set_obsess_over_hosts(new_cfg.obsess_over_hosts());
   pb_config.set_obsess_over_services(new_cfg.obsess_over_services());
   pb_config.set_ochp_command(new_cfg.ochp_command());
@@ -428,6 +438,7 @@ void applier::state::_apply(const configuration::State& new_cfg,
       new_cfg.host_down_disable_service_checks());
   pb_config.set_broker_module_cfg_file(new_cfg.broker_module_cfg_file());
   pb_config.set_credentials_encryption(new_cfg.credentials_encryption());
+  pb_config.set_spawn_helper(new_cfg.spawn_helper());
   pb_config.clear_user();
   for (auto& p : new_cfg.user())
     pb_config.mutable_user()->at(p.first) = p.second;
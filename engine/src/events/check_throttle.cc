@@ -0,0 +1,223 @@
+/**
+ * Copyright 2025 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/engine/events/check_throttle.hh"
+#include "com/centreon/engine/commands/command.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/service.hh"
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::events;
+
+/**
+ * @brief exponentially weighted moving average, the first value is taken as
+ * is.
+ */
+static double _ewma(double average, double value) {
+  return average ? average + 0.1 * (value - average) : value;
+}
+
+/* Never destroyed because services stored in static containers forget
+ * themselves when they are destroyed at exit. */
+check_throttle& check_throttle::instance() {
+  static check_throttle* instance = new check_throttle;
+  return *instance;
+}
+
+bool check_throttle::enabled() const {
+  return pb_config.adaptive_check_scheduling();
+}
+
+/**
+ * @brief The number of service checks we can launch per second.
+ *
+ * @param backlog number of check results waiting to be reaped
+ * @return 0 if there is no limit
+ */
+double check_throttle::compute_rate(size_t backlog) const {
+  double rate = pb_config.max_check_rate();
+  uint32_t max_parallel = pb_config.max_parallel_service_checks();
+  if (max_parallel && _average_execution_time > 0) {
+    double sustainable = max_parallel / _average_execution_time;
+    if (!rate || sustainable < rate)
+      rate = sustainable;
+  }
+  if (rate) {
+    if (backlog > rate)
+      rate /= 2;
+    if (rate < 1)
+      rate = 1;
+  }
+  return rate;
+}
+
+void check_throttle::_refill(time_t now, size_t backlog) {
+  if (now != _bucket_second) {
+    _bucket_second = now;
+    _rate = compute_rate(backlog);
+    _tokens = _rate;
+  }
+}
+
+/**
+ * @brief Called by the main loop before starting a scheduled service check.
+ * A token is consumed if the check can run.
+ *
+ * @param svc
+ * @param now
+ * @param backlog number of check results waiting to be reaped
+ */
+check_throttle::verdict check_throttle::admit(const service& svc,
+                                              time_t now,
+                                              size_t backlog) {
+  _refill(now, backlog);
+
+  const std::shared_ptr<commands::command>& cmd = svc.get_check_command_ptr();
+  if (cmd && cmd->max_parallel_checks()) {
+    auto found = _commands.find(cmd->get_name());
+    if (found != _commands.end() &&
+        found->second.running >= cmd->max_parallel_checks())
+      return verdict::command_limited;
+  }
+
+  if (_rate) {
+    if (_tokens < 1)
+      return verdict::rate_limited;
+    _tokens -= 1;
+  }
+  return verdict::run;
+}
+
+/**
+ * @brief Give a new check time to a service check that can't run now.
+ *
+ * @param svc
+ * @param why verdict of admit()
+ * @param now
+ * @return time_t the new check time, always in the future.
+ */
+time_t check_throttle::defer(const service& svc, verdict why, time_t now) {
+  ++_deferred_count;
+  _deferred.try_emplace(&svc, deferred_check{svc.get_next_check(), now});
+
+  if (why == verdict::command_limited) {
+    double delay = _average_execution_time;
+    const std::shared_ptr<commands::command>& cmd = svc.get_check_command_ptr();
+    if (cmd) {
+      auto found = _commands.find(cmd->get_name());
+      if (found != _commands.end() && found->second.average_execution_time)
+        delay = found->second.average_execution_time;
+    }
+    return now + std::max<time_t>(1, std::ceil(delay));
+  }
+
+  /* half of each second is left to the checks planned at that time */
+  double slot_size = std::max(1.0, _rate / 2);
+  if (_next_slot <= now) {
+    _next_slot = now + 1;
+    _slot_used = 0;
+  }
+  time_t ret = _next_slot;
+  if (++_slot_used >= slot_size) {
+    ++_next_slot;
+    _slot_used = 0;
+  }
+  return ret;
+}
+
+/**
+ * @brief Called by the main loop when a scheduled check is launched to
+ * measure its lateness. It works even if throttling is disabled, so that
+ * lateness can be compared with and without it.
+ */
+void check_throttle::launched(const service& svc, time_t now) {
+  auto found = _deferred.find(&svc);
+  if (found != _deferred.end()) {
+    _lateness_at_dispatch.add(
+        std::max<time_t>(0, found->second.dispatched - found->second.planned));
+    _lateness_at_launch.add(
+        std::max<time_t>(0, now - found->second.planned));
+    _deferred.erase(found);
+  } else {
+    double lateness = std::max<time_t>(0, now - svc.get_next_check());
+    _lateness_at_dispatch.add(lateness);
+    _lateness_at_launch.add(lateness);
+  }
+}
+
+/**
+ * @brief Called when the check command of a service is started.
+ */
+void check_throttle::started(const service& svc) {
+  const std::shared_ptr<commands::command>& cmd = svc.get_check_command_ptr();
+  if (!cmd)
+    return;
+  auto [it, inserted] = _running.try_emplace(&svc, cmd->get_name());
+  if (inserted)
+    ++_commands[it->second].running;
+}
+
+/**
+ * @brief Called when the result of a service check is handled.
+ *
+ * @param svc
+ * @param execution_time negative if unknown (orphaned check)
+ */
+void check_throttle::finished(const service& svc, double execution_time) {
+  auto found = _running.find(&svc);
+  if (found == _running.end())
+    return;
+  auto cmd = _commands.find(found->second);
+  if (cmd != _commands.end()) {
+    if (cmd->second.running)
+      --cmd->second.running;
+    if (execution_time >= 0)
+      cmd->second.average_execution_time =
+          _ewma(cmd->second.average_execution_time, execution_time);
+  }
+  if (execution_time >= 0)
+    _average_execution_time = _ewma(_average_execution_time, execution_time);
+  _running.erase(found);
+}
+
+/**
+ * @brief Called when a service is destroyed.
+ */
+void check_throttle::forget(const service& svc) {
+  finished(svc, -1);
+  _deferred.erase(&svc);
+}
+
+void check_throttle::clear() {
+  _bucket_second = 0;
+  _tokens = _rate = 0;
+  _next_slot = 0;
+  _slot_used = 0;
+  _average_execution_time = 0;
+  _commands.clear();
+  _running.clear();
+  _deferred.clear();
+  _lateness_at_dispatch = quantile_sketch();
+  _lateness_at_launch = quantile_sketch();
+  _deferred_count = 0;
+}
+
+uint32_t check_throttle::running(const std::string& command_name) const {
+  auto found = _commands.find(command_name);
+  return found == _commands.end() ? 0 : found->second.running;
+}
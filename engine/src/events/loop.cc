@@ -23,11 +23,14 @@
 #include "com/centreon/engine/events/loop.hh"
 #include <future>
 #include "com/centreon/engine/broker.hh"
+#include "com/centreon/engine/checks/checker.hh"
 #include "com/centreon/engine/command_manager.hh"
 #include "com/centreon/engine/configuration/applier/state.hh"
 #include "com/centreon/engine/configuration/extended_conf.hh"
+#include "com/centreon/engine/events/check_throttle.hh"
 #include "com/centreon/engine/globals.hh"
 #include "com/centreon/engine/logging/logger.hh"
+#include "com/centreon/engine/notification_digest.hh"
 #include "com/centreon/engine/statusdata.hh"
 #include "common/engine_conf/parser.hh"
 
@@ -80,6 +83,9 @@ void loop::run() {
   _sleep_event.event_options = 0;
 
   _dispatching();
+
+  // Don't lose the notifications still waiting in digests.
+  notification_digest::instance().flush(std::numeric_limits<time_t>::max());
   clear();
 }
 
@@ -229,6 +235,9 @@ void loop::_dispatching() {
       update_program_status(false);
     }
 
+    // Send the notification digests whose window is over.
+    notification_digest::instance().flush(current_time);
+
     // Handle high priority events.
     bool run_event(true);
     if (!_event_list_high.empty() &&
@@ -258,6 +267,9 @@ void loop::_dispatching() {
         int nudge_seconds(0);
         service* temp_service(
             static_cast<service*>(_event_list_low.front()->event_data));
+        check_throttle& throttle = check_throttle::instance();
+        bool forced = temp_service->get_check_options() &
+                      CHECK_OPTION_FORCE_EXECUTION;
 
         // Don't run a service check if we're already maxed out on the
         // number of parallel service checks...
@@ -265,7 +277,15 @@ void loop::_dispatching() {
             currently_running_service_checks >= max_parallel_service_checks) {
           // Move it at least 5 seconds (to overcome the current peak),
           // with a random 10 seconds (to spread the load).
-          nudge_seconds = 5 + (rand() % 10);
+          // The adaptive scheduling gives it the next free slot instead.
+          if (throttle.enabled() && !forced)
+            nudge_seconds = std::max<time_t>(
+                1, throttle.defer(*temp_service,
+                                  check_throttle::verdict::rate_limited,
+                                  current_time) -
+                       temp_service->get_next_check());
+          else
+            nudge_seconds = 5 + (rand() % 10);
           engine_logger(dbg_events | dbg_checks, basic)
               << "**WARNING** Max concurrent service checks ("
               << currently_running_service_checks << "/"
@@ -294,6 +314,29 @@ void loop::_dispatching() {
               temp_service->get_hostname(), temp_service->description(),
               nudge_seconds);
           run_event = false;
+        } else if (throttle.enabled() && !forced && execute_service_checks) {
+          // Smooth the launch rate and limit the heavy commands.
+          size_t backlog = 0;
+          checks::checker::instance().inspect_reap_partial(
+              [&backlog](const std::deque<check_result::pointer>& queue) {
+                backlog = queue.size();
+              });
+          check_throttle::verdict verdict =
+              throttle.admit(*temp_service, current_time, backlog);
+          if (verdict != check_throttle::verdict::run) {
+            nudge_seconds = std::max<time_t>(
+                1, throttle.defer(*temp_service, verdict, current_time) -
+                       temp_service->get_next_check());
+            events_logger->debug(
+                "Adaptive scheduling: check of {}:{} {}, delayed by {} "
+                "seconds",
+                temp_service->get_hostname(), temp_service->description(),
+                verdict == check_throttle::verdict::rate_limited
+                    ? "exceeds the check rate"
+                    : "exceeds the parallel checks of its command",
+                nudge_seconds);
+            run_event = false;
+          }
         }
 
         // Don't run a service check if active checks are disabled.
@@ -308,9 +351,12 @@ void loop::_dispatching() {
         }
 
         // Forced checks override normal check logic.
-        if (temp_service->get_check_options() & CHECK_OPTION_FORCE_EXECUTION)
+        if (forced)
           run_event = true;
 
+        if (run_event)
+          throttle.launched(*temp_service, current_time);
+
         // Reschedule the check if we can't run it now.
         if (!run_event) {
           // Remove the service check from the event queue and
@@ -21,6 +21,7 @@
 #include <fmt/chrono.h>
 
 #include "com/centreon/engine/broker.hh"
+#include "com/centreon/engine/check_stats.hh"
 #include "com/centreon/engine/checks/checker.hh"
 #include "com/centreon/engine/common.hh"
 #include "com/centreon/engine/configuration/applier/state.hh"
@@ -34,6 +35,7 @@
 #include "com/centreon/engine/macros.hh"
 #include "com/centreon/engine/neberrors.hh"
 #include "com/centreon/engine/notification.hh"
+#include "com/centreon/engine/notification_digest.hh"
 #include "com/centreon/engine/objects.hh"
 #include "com/centreon/engine/sehandlers.hh"
 #include "com/centreon/engine/statusdata.hh"
@@ -289,9 +291,11 @@ host::host(uint64_t host_id,
   set_flap_type((flap_detection_on_down > 0 ? down : 0) |
                 (flap_detection_on_unreachable > 0 ? unreachable : 0) |
                 (flap_detection_on_up > 0 ? up : 0));
+  check_stats::hosts().update(*this, _current_state, time(nullptr));
 }
 
 host::~host() {
+  check_stats::hosts().remove(*this);
   std::shared_ptr<commands::command> cmd = get_check_command_ptr();
   if (cmd) {
     cmd->unregister_host_serv(name(), "");
@@ -1188,6 +1192,28 @@ std::string engine::get_host_name(const uint64_t host_id) {
   return retval;
 }
 
+/**
+ * @brief Find a host by its name without copying it.
+ *
+ * @param name
+ * @return host* nullptr if not found
+ */
+host* engine::lookup_host(std::string_view name) noexcept {
+  host_map::const_iterator found = host::hosts.find(name);
+  return found != host::hosts.end() ? found->second.get() : nullptr;
+}
+
+/**
+ * @brief Find a host by its id.
+ *
+ * @param host_id
+ * @return host* nullptr if not found
+ */
+host* engine::lookup_host(uint64_t host_id) noexcept {
+  host_id_map::const_iterator found = host::hosts_by_id.find(host_id);
+  return found != host::hosts_by_id.end() ? found->second.get() : nullptr;
+}
+
 /**
  *  Schedule acknowledgement expiration.
  *
@@ -2306,6 +2332,7 @@ void host::clear_flap(double percent_change,
  * STATUS_ALL).
  */
 void host::update_status(uint32_t attributes) {
+  check_stats::hosts().update(*this, _current_state, time(nullptr));
   broker_host_status(this, attributes);
 }
 
@@ -2603,6 +2630,8 @@ int host::notify_contact(nagios_macros* mac,
   /* get start time */
   gettimeofday(&start_time, nullptr);
 
+  notification_digest& digest = notification_digest::instance();
+
   /* process all the notification commands this user has */
   for (std::shared_ptr<commands::command> const& cmd :
        cntct->get_host_notification_commands()) {
@@ -2664,6 +2693,22 @@ int host::notify_contact(nagios_macros* mac,
                                  this->get_plugin_output(), info);
     }
 
+    /* during a storm, the notification may be sent later in a digest */
+    if (digest.enabled()) {
+      notification_digest::entry notif{
+          start_time.tv_sec,
+          mac->x[MACRO_NOTIFICATIONTYPE],
+          name(),
+          "",
+          (unsigned int)_current_state < tab_host_states.size()
+              ? tab_host_states[_current_state].second
+              : "UP",
+          get_plugin_output()};
+      if (digest.add(cntct->get_name(), cmd->get_name(), std::move(notif),
+                     start_time.tv_sec))
+        continue;
+    }
+
     /* run the notification command */
     if (command_is_allowed_by_whitelist(processed_command, NOTIF_TYPE)) {
       try {
@@ -3663,11 +3708,11 @@ enum host::host_state host::determine_host_reachability(
   return state;
 }
 
-std::list<hostgroup*> const& host::get_parent_groups() const {
+host::hostgroup_list const& host::get_parent_groups() const {
   return _hostgroups;
 }
 
-std::list<hostgroup*>& host::get_parent_groups() {
+host::hostgroup_list& host::get_parent_groups() {
   return _hostgroups;
 }
 
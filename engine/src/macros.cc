@@ -137,13 +137,12 @@ int grab_custom_macro_value_r(nagios_macros* mac,
       if (mac->host_ptr == nullptr)
         return ERROR;
 
-      service_map::const_iterator found = service::services.find(
-          {mac->host_ptr ? mac->host_ptr->name() : "", arg2});
+      service* found = lookup_service(mac->host_ptr->name(), arg2);
 
-      if (found != service::services.end() && found->second) {
+      if (found) {
         /* get the service macro value */
-        result = grab_custom_object_macro_r(
-            mac, macro_name.substr(8), found->second->custom_variables, output);
+        result = grab_custom_object_macro_r(mac, macro_name.substr(8),
+                                            found->custom_variables, output);
       }
       /* else we have a service macro with a servicegroup name and a
          delimiter... */
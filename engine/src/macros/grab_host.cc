@@ -112,7 +112,7 @@ static std::string get_host_group_names(host& hst, nagios_macros* mac) {
 
   std::string buf;
   // Find all hostgroups this host is associated with.
-  for (std::list<hostgroup*>::const_iterator
+  for (host::hostgroup_list::const_iterator
            it{hst.get_parent_groups().begin()},
        end{hst.get_parent_groups().end()};
        it != end; ++it) {
@@ -68,7 +68,7 @@ static std::string get_service_group_names(service& svc, nagios_macros* mac) {
 
   // Find all servicegroups this service is associated with.
   std::string buf;
-  for (std::list<servicegroup*>::const_iterator
+  for (service::servicegroup_list::const_iterator
            it{svc.get_parent_groups().begin()},
        end{svc.get_parent_groups().end()};
        it != end; ++it) {
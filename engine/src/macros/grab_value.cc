@@ -192,25 +192,24 @@ static int handle_service_macro(nagios_macros* mac,
       if (!mac->host_ptr)
         retval = ERROR;
       else if (!arg2.empty()) {
-        service_map::const_iterator found(
-            service::services.find({mac->host_ptr->name(), arg2}));
+        service* found = lookup_service(mac->host_ptr->name(), arg2);
 
-        if (found == service::services.end() || !found->second)
+        if (!found)
           retval = ERROR;
         else
           // Get the service macro value.
-          retval = grab_standard_service_macro_r(
-              mac, macro_type, found->second.get(), output, free_macro);
+          retval = grab_standard_service_macro_r(mac, macro_type, found,
+                                                 output, free_macro);
       } else
         retval = ERROR;
     } else if (!arg1.empty() && !arg2.empty()) {
       // On-demand macro with both host and service name.
-      service_map::const_iterator found(service::services.find({arg1, arg2}));
+      service* found = lookup_service(arg1, arg2);
 
-      if (found != service::services.end() && found->second)
+      if (found)
         // Get the service macro value.
-        retval = grab_standard_service_macro_r(
-            mac, macro_type, found->second.get(), output, free_macro);
+        retval = grab_standard_service_macro_r(mac, macro_type, found, output,
+                                               free_macro);
       // Else we have a service macro with a
       // servicegroup name and a delimiter...
       else {
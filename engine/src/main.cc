@@ -45,6 +45,7 @@ namespace po = boost::program_options;
 #include "com/centreon/engine/broker/loader.hh"
 #include "com/centreon/engine/checks/checker.hh"
 #include "com/centreon/engine/commands/connector.hh"
+#include "com/centreon/engine/commands/spawn_helper.hh"
 #include "com/centreon/engine/config.hh"
 #include "com/centreon/engine/configuration/applier/logging.hh"
 #include "com/centreon/engine/configuration/applier/state.hh"
@@ -395,6 +396,9 @@ int main(int argc, char* argv[]) {
           configuration::applier::state::instance().apply_log_config(
               new_config);
 
+          // Start the spawn helper while centengine is still small.
+          commands::spawn_helper::load(new_config.spawn_helper());
+
           neb_init_callback_list();
 
           for (auto& m : new_config.broker_module()) {
@@ -457,6 +461,8 @@ int main(int argc, char* argv[]) {
                                "Caught SIG {}, shutting down ...",
                                sigs[sig_id]);
           }
+          commands::spawn_helper::unload();
+
           // Send program data to broker.
           broker_program_state(NEBTYPE_PROCESS_EVENTLOOPEND, NEBFLAG_NONE);
           if (sigshutdown)
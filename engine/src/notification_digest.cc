@@ -0,0 +1,288 @@
+/**
+ * Copyright 2025 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include "com/centreon/engine/notification_digest.hh"
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+#include <unistd.h>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include "com/centreon/engine/commands/command.hh"
+#include "com/centreon/engine/contact.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/macros.hh"
+#include "com/centreon/engine/macros/misc.hh"
+#include "com/centreon/engine/macros/process.hh"
+#include "com/centreon/engine/utils.hh"
+
+using namespace com::centreon::engine;
+
+notification_digest& notification_digest::instance() {
+  static notification_digest instance;
+  return instance;
+}
+
+/**
+ * @brief Digests are enabled if notification_digest_command is the name of an
+ * existing command.
+ */
+bool notification_digest::enabled() const {
+  const std::string& cmd_name = pb_config.notification_digest_command();
+  return !cmd_name.empty() && commands::command::commands.find(cmd_name) !=
+                                  commands::command::commands.end();
+}
+
+/**
+ * @brief Called for each notification command of a contact.
+ *
+ * @param contact_name
+ * @param command_name the notification command
+ * @param notif the notification description
+ * @param now
+ * @return true if the notification is buffered, false if the caller has to
+ * send it as usual.
+ */
+bool notification_digest::add(const std::string& contact_name,
+                              const std::string& command_name,
+                              entry&& notif,
+                              time_t now) {
+  if (!enabled())
+    return false;
+
+  time_t window = pb_config.notification_digest_window();
+  contact_window& sent = _windows[contact_name];
+  if (now - sent.start >= window) {
+    sent.start = now;
+    sent.sent = 0;
+  }
+  if (sent.sent < pb_config.notification_digest_threshold()) {
+    ++sent.sent;
+    return false;
+  }
+
+  auto [dgst, created] = _digests.try_emplace({contact_name, command_name});
+  if (created) {
+    dgst->second.start = now;
+    if (!_next_flush || now + window < _next_flush)
+      _next_flush = now + window;
+  }
+  if (dgst->second.entries.size() <
+      pb_config.notification_digest_max_entries())
+    dgst->second.entries.push_back(std::move(notif));
+  else
+    ++dgst->second.dropped;
+
+  notifications_logger->debug(
+      "notification of contact '{}' by '{}' added to digest ({} entries, {} "
+      "dropped)",
+      contact_name, command_name, dgst->second.entries.size(),
+      dgst->second.dropped);
+  return true;
+}
+
+/**
+ * @brief Send the digests whose window is over. It is called at each turn of
+ * the main loop, so it has to be cheap when there is nothing to do.
+ *
+ * @param now
+ */
+void notification_digest::flush(time_t now) {
+  if (_digests.empty() || now < _next_flush)
+    return;
+
+  time_t window = pb_config.notification_digest_window();
+  _next_flush = 0;
+  for (auto it = _digests.begin(); it != _digests.end();) {
+    time_t end = it->second.start + window;
+    if (end <= now) {
+      _send(it->first.first, it->first.second, it->second);
+      it = _digests.erase(it);
+    } else {
+      if (!_next_flush || end < _next_flush)
+        _next_flush = end;
+      ++it;
+    }
+  }
+
+  absl::erase_if(_windows, [now, window](const auto& p) {
+    return now - p.second.start >= window;
+  });
+}
+
+void notification_digest::clear() {
+  _windows.clear();
+  _digests.clear();
+  _next_flush = 0;
+}
+
+/**
+ * @brief Accessor to a digest, used by tests.
+ *
+ * @return nullptr if there is no buffered notification for this contact and
+ * command.
+ */
+const notification_digest::digest* notification_digest::pending(
+    const std::string& contact_name,
+    const std::string& command_name) const {
+  auto found = _digests.find({contact_name, command_name});
+  return found == _digests.end() ? nullptr : &found->second;
+}
+
+/**
+ * @brief The JSON document given to the digest command.
+ */
+std::string notification_digest::payload(const std::string& contact_name,
+                                         const std::string& command_name,
+                                         const digest& to_send) {
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  writer.StartObject();
+  writer.Key("contact");
+  writer.String(contact_name.c_str(), contact_name.size());
+  writer.Key("command");
+  writer.String(command_name.c_str(), command_name.size());
+  writer.Key("start");
+  writer.Int64(to_send.start);
+  writer.Key("dropped");
+  writer.Uint(to_send.dropped);
+  writer.Key("notifications");
+  writer.StartArray();
+  for (const entry& e : to_send.entries) {
+    writer.StartObject();
+    writer.Key("time");
+    writer.Int64(e.time);
+    writer.Key("type");
+    writer.String(e.type.c_str(), e.type.size());
+    writer.Key("host_name");
+    writer.String(e.host_name.c_str(), e.host_name.size());
+    if (!e.service_description.empty()) {
+      writer.Key("service_description");
+      writer.String(e.service_description.c_str(),
+                    e.service_description.size());
+    }
+    writer.Key("state");
+    writer.String(e.state.c_str(), e.state.size());
+    writer.Key("output");
+    writer.String(e.output.c_str(), e.output.size());
+    writer.EndObject();
+  }
+  writer.EndArray();
+  writer.EndObject();
+  return std::string(buffer.GetString(), buffer.GetSize());
+}
+
+/**
+ * @brief Write the digest in a temporary file and execute the digest command
+ * with the contact macros and the file path in $ARG1$. The file is removed
+ * once the command is over.
+ */
+void notification_digest::_send(const std::string& contact_name,
+                                const std::string& command_name,
+                                const digest& to_send) {
+  auto ctc = contact::contacts.find(contact_name);
+  auto cmd = commands::command::commands.find(
+      pb_config.notification_digest_command());
+  if (ctc == contact::contacts.end() ||
+      cmd == commands::command::commands.end()) {
+    notifications_logger->error(
+        "digest of {} notifications for contact '{}' lost: contact or digest "
+        "command not found",
+        to_send.entries.size() + to_send.dropped, contact_name);
+    return;
+  }
+
+  /* mkstemps creates the file with O_EXCL and mode 0600: its name can't be
+   * guessed nor replaced by a link, and other users can't read it. */
+  std::error_code ec;
+  std::filesystem::path path = std::filesystem::temp_directory_path(ec);
+  path /= "centengine-digest-XXXXXX.json";
+  std::string path_str = path.string();
+  int fd = mkstemps(path_str.data(), 5);
+  if (fd < 0) {
+    notifications_logger->error(
+        "digest for contact '{}' lost: unable to create {}: {}", contact_name,
+        path_str, strerror(errno));
+    return;
+  }
+  path = path_str;
+  {
+    std::string content = payload(contact_name, command_name, to_send);
+    const char* data = content.data();
+    size_t remaining = content.size();
+    while (remaining > 0) {
+      ssize_t written = write(fd, data, remaining);
+      if (written < 0 && errno == EINTR)
+        continue;
+      if (written <= 0) {
+        notifications_logger->error(
+            "digest for contact '{}' lost: unable to write {}: {}",
+            contact_name, path_str, strerror(errno));
+        close(fd);
+        std::filesystem::remove(path, ec);
+        return;
+      }
+      data += written;
+      remaining -= written;
+    }
+    close(fd);
+  }
+
+  nagios_macros* mac = get_global_macros();
+  clear_volatile_macros_r(mac);
+  grab_contact_macros_r(mac, ctc->second.get());
+  mac->argv[0] = path.string();
+
+  std::string processed_command;
+  process_macros_r(mac, cmd->second->get_command_line(), processed_command,
+                   STRIP_ILLEGAL_MACRO_CHARS | ESCAPE_MACRO_CHARS);
+
+  if (processed_command.empty()) {
+    notifications_logger->error("digest command of contact '{}' is empty",
+                                contact_name);
+  } else if (!checkable::command_is_allowed_by_whitelist(processed_command,
+                                                         _whitelist_cache)) {
+    notifications_logger->error(
+        "Error: can't execute notification digest for contact '{}' : it is "
+        "not allowed by the whitelist",
+        contact_name);
+  } else {
+    notifications_logger->info(
+        "NOTIFICATION DIGEST: {};{};{} notifications;{} dropped", contact_name,
+        command_name, to_send.entries.size(), to_send.dropped);
+    try {
+      bool early_timeout;
+      double exectime;
+      std::string out;
+      my_system_r(mac, processed_command, pb_config.notification_timeout(),
+                  &early_timeout, &exectime, out, 0);
+      if (early_timeout)
+        notifications_logger->info(
+            "Warning: notification digest of contact '{}' timed out after {} "
+            "seconds",
+            contact_name, pb_config.notification_timeout());
+    } catch (const std::exception& e) {
+      notifications_logger->error(
+          "Error: can't execute notification digest for contact '{}': {}",
+          contact_name, e.what());
+    }
+  }
+
+  clear_volatile_macros_r(mac);
+  std::filesystem::remove(path, ec);
+}
@@ -20,10 +20,12 @@
 #include <absl/strings/match.h>
 
 #include "com/centreon/engine/broker.hh"
+#include "com/centreon/engine/check_stats.hh"
 #include "com/centreon/engine/checks/checker.hh"
 #include "com/centreon/engine/configuration/whitelist.hh"
 #include "com/centreon/engine/deleter/listmember.hh"
 #include "com/centreon/engine/downtimes/downtime_manager.hh"
+#include "com/centreon/engine/events/check_throttle.hh"
 #include "com/centreon/engine/events/loop.hh"
 #include "com/centreon/engine/exceptions/error.hh"
 #include "com/centreon/engine/flapping.hh"
@@ -32,6 +34,7 @@
 #include "com/centreon/engine/macros.hh"
 #include "com/centreon/engine/neberrors.hh"
 #include "com/centreon/engine/notification.hh"
+#include "com/centreon/engine/notification_digest.hh"
 #include "com/centreon/engine/objects.hh"
 #include "com/centreon/engine/sehandlers.hh"
 #include "com/centreon/engine/string.hh"
@@ -146,13 +149,16 @@ service::service(const std::string& hostname,
       _service_type = SERVICE;
   }
   set_current_attempt(1);
+  check_stats::services().update(*this, _current_state, time(nullptr));
 }
 
 service::~service() noexcept {
+  check_stats::services().remove(*this);
+  events::check_throttle::instance().forget(*this);
   std::shared_ptr<commands::command> cmd = get_check_command_ptr();
   if (cmd) {
     cmd->remove_caller(this);
-    cmd->unregister_host_serv(_hostname, description());
+    cmd->unregister_host_serv(_hostname.get(), description());
   }
 }
 
@@ -887,11 +893,10 @@ bool engine::is_service_exist(std::pair<uint64_t, uint64_t> const& id) {
 std::pair<uint64_t, uint64_t> engine::get_host_and_service_id(
     const std::string& host,
     const std::string& svc) {
-  service_map::const_iterator found = service::services.find({host, svc});
-  return found != service::services.end()
-             ? std::pair<uint64_t, uint64_t>{found->second->host_id(),
-                                             found->second->service_id()}
-             : std::pair<uint64_t, uint64_t>{0u, 0u};
+  const service* found = lookup_service(host, svc);
+  return found ? std::pair<uint64_t, uint64_t>{found->host_id(),
+                                               found->service_id()}
+               : std::pair<uint64_t, uint64_t>{0u, 0u};
 }
 
 /**
@@ -926,6 +931,36 @@ uint64_t engine::get_service_id(const std::string& host,
   return get_host_and_service_id(host, svc).second;
 }
 
+/**
+ * @brief Find a service by its names. Unlike services.find({host, svc}), no
+ * std::string is built for the key, names are hashed where they are.
+ *
+ * @param host_name
+ * @param description
+ * @return service* nullptr if not found
+ */
+service* engine::lookup_service(std::string_view host_name,
+                                std::string_view description) noexcept {
+  service_map::const_iterator found = service::services.find(
+      host_serv_hash_eq::host_serv_string_view{host_name, description});
+  return found != service::services.end() ? found->second.get() : nullptr;
+}
+
+/**
+ * @brief Find a service by its ids.
+ *
+ * @param host_id
+ * @param service_id
+ * @return service* nullptr if not found
+ */
+service* engine::lookup_service(uint64_t host_id,
+                                uint64_t service_id) noexcept {
+  service_id_map::const_iterator found =
+      service::services_by_id.find({host_id, service_id});
+  return found != service::services_by_id.end() ? found->second.get()
+                                                : nullptr;
+}
+
 /**
  *  Schedule acknowledgement expiration check.
  *
@@ -963,16 +998,16 @@ uint64_t service::service_id() const {
  * @param name
  */
 void service::set_hostname(const std::string& name) {
-  if (_hostname == name) {
+  if (_hostname.get() == name) {
     return;
   }
   std::shared_ptr<commands::command> cmd = get_check_command_ptr();
   if (cmd) {
-    cmd->unregister_host_serv(_hostname, description());
+    cmd->unregister_host_serv(_hostname.get(), description());
   }
   _hostname = name;
   if (cmd) {
-    cmd->register_host_serv(_hostname, description());
+    cmd->register_host_serv(_hostname.get(), description());
   }
 }
 
@@ -982,7 +1017,7 @@ void service::set_hostname(const std::string& name) {
  * @return A string reference to the host name.
  */
 const std::string& service::get_hostname() const {
-  return _hostname;
+  return _hostname.get();
 }
 
 /**
@@ -997,11 +1032,11 @@ void service::set_name(std::string const& desc) {
   }
   std::shared_ptr<commands::command> cmd = get_check_command_ptr();
   if (cmd) {
-    cmd->unregister_host_serv(_hostname, name());
+    cmd->unregister_host_serv(_hostname.get(), name());
   }
   notifier::set_name(desc);
   if (cmd) {
-    cmd->register_host_serv(_hostname, name());
+    cmd->register_host_serv(_hostname.get(), name());
   }
 }
 
@@ -1114,7 +1149,7 @@ int service::handle_async_check_result(
   SPDLOG_LOGGER_TRACE(
       checks_logger,
       "** Handling check result for service '{}' on host '{}'...", name(),
-      _hostname);
+      _hostname.get());
   engine_logger(dbg_checks, more)
       << "HOST: " << _hostname << ", SERVICE: " << name() << ", CHECK TYPE: "
       << (queued_check_result.get_check_type() == check_active ? "Active"
@@ -1130,7 +1165,7 @@ int service::handle_async_check_result(
       checks_logger,
       "HOST: {}, SERVICE: {}, CHECK TYPE: {}, OPTIONS: {}, RESCHEDULE: {}, "
       "EXITED OK: {}, EXEC TIME: {}, return CODE: {}, OUTPUT: {}",
-      _hostname, name(),
+      _hostname.get(), name(),
       queued_check_result.get_check_type() == check_active ? "Active"
                                                            : "Passive",
       queued_check_result.get_check_options(),
@@ -1139,9 +1174,11 @@ int service::handle_async_check_result(
       queued_check_result.get_return_code(), queued_check_result.get_output());
 
   /* decrement the number of service checks still out there... */
-  if (queued_check_result.get_check_type() == check_active &&
-      currently_running_service_checks > 0)
-    currently_running_service_checks--;
+  if (queued_check_result.get_check_type() == check_active) {
+    if (currently_running_service_checks > 0)
+      currently_running_service_checks--;
+    events::check_throttle::instance().finished(*this, execution_time);
+  }
 
   /*
    * skip this service check results if its passive and we aren't accepting
@@ -1241,7 +1278,7 @@ int service::handle_async_check_result(
     SPDLOG_LOGGER_WARN(
         runtime_logger,
         "Warning:  Check of service '{}' on host '{}' did not exit properly!",
-        name(), _hostname);
+        name(), _hostname.get());
 
     set_plugin_output("(Service check did not exit properly)");
     _current_state = service::state_unknown;
@@ -1263,7 +1300,7 @@ int service::handle_async_check_result(
         runtime_logger,
         "Warning: return (code of {} for check of service '{}' on host '{}' "
         "was out of bounds.{}",
-        queued_check_result.get_return_code(), name(), _hostname,
+        queued_check_result.get_return_code(), name(), _hostname.get(),
         (queued_check_result.get_return_code() == 126
              ? "Make sure the plugin you're trying to run is executable."
              : (queued_check_result.get_return_code() == 127
@@ -1335,7 +1372,7 @@ int service::handle_async_check_result(
         queued_check_result.get_return_code());
     SPDLOG_LOGGER_DEBUG(
         checks_logger, "now host:{} serv:{} _current_state={} state_type={}",
-        _hostname, name(), static_cast<uint32_t>(_current_state),
+        _hostname.get(), name(), static_cast<uint32_t>(_current_state),
         (get_state_type() == soft ? "SOFT" : "HARD"));
   }
 
@@ -1371,7 +1408,8 @@ int service::handle_async_check_result(
           << "PASSIVE SERVICE CHECK: " << _hostname << ";" << name() << ";"
           << _current_state << ";" << get_plugin_output();
     SPDLOG_LOGGER_INFO(checks_logger, "PASSIVE SERVICE CHECK: {};{};{};{}",
-                       _hostname, name(), static_cast<uint32_t>(_current_state),
+                       _hostname.get(), name(),
+                       static_cast<uint32_t>(_current_state),
                        get_plugin_output());
   }
 
@@ -1881,7 +1919,7 @@ int service::handle_async_check_result(
          * execution */
         /* we do this because we might be sending out a notification soon and we
          * want the dependency logic to be accurate */
-        std::pair<std::string, std::string> id({_hostname, name()});
+        std::pair<std::string, std::string> id({_hostname.get(), name()});
         auto p(servicedependency::servicedependencies.equal_range(id));
         for (servicedependency_mmap::const_iterator it{p.first}, end{p.second};
              it != end; ++it) {
@@ -2109,7 +2147,7 @@ int service::log_event() {
       << state_type << ";" << get_current_attempt() << ";"
       << get_plugin_output();
   SPDLOG_LOGGER_INFO(events_logger, "SERVICE ALERT: {};{};{};{};{};{}",
-                     _hostname, name(), state, state_type,
+                     _hostname.get(), name(), state, state_type,
                      get_current_attempt(), get_plugin_output());
   return OK;
 }
@@ -2149,7 +2187,7 @@ void service::check_for_flapping(bool update,
       << "' for flapping...";
   SPDLOG_LOGGER_DEBUG(checks_logger,
                       "Checking service '{}' on host '{}' for flapping...",
-                      name(), _hostname);
+                      name(), _hostname.get());
 
   /* what threshold values should we use (global or service-specific)? */
   low_threshold = (get_low_flap_threshold() <= 0.0) ? low_service_flap_threshold
@@ -2408,7 +2446,7 @@ int service::obsessive_compulsive_service_check_processor() {
       runtime_logger,
       "Warning: OCSP command '{}' for service '{}' on host '{}' timed out "
       "after {} seconds",
-      processed_command, name(), _hostname, ocsp_timeout);
+      processed_command, name(), _hostname.get(), ocsp_timeout);
 
   return OK;
 }
@@ -2445,7 +2483,7 @@ int service::run_scheduled_check(int check_options, double latency) {
       checks_logger,
       "Attempting to run scheduled check of service '{}' on host '{}': check "
       "options={}, latency={}",
-      name(), _hostname, check_options, latency);
+      name(), _hostname.get(), check_options, latency);
 
   /* attempt to run the check */
   result = run_async_check(check_options, latency, true, true, &time_is_valid,
@@ -2497,7 +2535,7 @@ int service::run_scheduled_check(int check_options, double latency) {
               runtime_logger,
               "Warning: Check of service '{}' on host '{}' could not be "
               "rescheduled properly. Scheduling check for next week...",
-              name(), _hostname);
+              name(), _hostname.get());
           engine_logger(dbg_checks, more)
               << "Unable to find any valid times to reschedule the next "
                  "service check!";
@@ -2689,6 +2727,8 @@ int service::run_async_check_local(int check_options,
     return OK;
   }
 
+  events::check_throttle::instance().started(*this);
+
   // Update statistics.
   update_check_stats(scheduled_check ? ACTIVE_SCHEDULED_SERVICE_CHECK_STATS
                                      : ACTIVE_ONDEMAND_SERVICE_CHECK_STATS,
@@ -2755,7 +2795,7 @@ int service::run_async_check_local(int check_options,
                                                    check_result_info, this);
         SPDLOG_LOGGER_DEBUG(checks_logger,
                             "run id={} {} for service {} host {}", id,
-                            processed_cmd, _service_id, _hostname);
+                            processed_cmd, _service_id, _hostname.get());
 
       } catch (std::exception const& e) {
         run_failure("(Execute command failed)");
@@ -2792,7 +2832,7 @@ bool service::schedule_check(time_t check_time,
       checks_logger,
       "Scheduling a {}, active check of service '{}' on host '{}' @ {}",
       options & CHECK_OPTION_FORCE_EXECUTION ? "forced" : "non-forced", name(),
-      _hostname, my_ctime(&check_time));
+      _hostname.get(), my_ctime(&check_time));
 
   // Don't schedule a check if active checks
   // of this service are disabled.
@@ -2928,7 +2968,7 @@ void service::set_flap(double percent_change,
                                     << _hostname << "' started flapping!";
   SPDLOG_LOGGER_DEBUG(checks_logger,
                       "Service '{}' on host '{}' started flapping!", name(),
-                      _hostname);
+                      _hostname.get());
 
   /* log a notice - this one is parsed by the history CGI */
   engine_logger(log_runtime_warning, basic)
@@ -2940,7 +2980,7 @@ void service::set_flap(double percent_change,
       runtime_logger,
       "SERVICE FLAPPING ALERT: {};{};STARTED; Service appears to have started "
       "flapping ({:.1f}% change >= {:.1f}% threshold)",
-      _hostname, name(), percent_change, high_threshold);
+      _hostname.get(), name(), percent_change, high_threshold);
 
   /* add a non-persistent comment to the service */
   std::ostringstream oss;
@@ -2982,7 +3022,7 @@ void service::clear_flap(double percent_change,
                                     << _hostname << "' stopped flapping.";
   SPDLOG_LOGGER_DEBUG(checks_logger,
                       "Service '{}' on host '{}' stopped flapping.", name(),
-                      _hostname);
+                      _hostname.get());
 
   /* log a notice - this one is parsed by the history CGI */
   engine_logger(log_info_message, basic)
@@ -2994,7 +3034,7 @@ void service::clear_flap(double percent_change,
       events_logger,
       "SERVICE FLAPPING ALERT: {};{};STOPPED; Service appears to have stopped "
       "flapping ({:.1f}% change < {:.1f}% threshold)",
-      _hostname, name(), percent_change, low_threshold);
+      _hostname.get(), name(), percent_change, low_threshold);
 
   /* delete the comment we added earlier */
   if (this->get_flapping_comment_id() != 0)
@@ -3023,7 +3063,7 @@ void service::enable_flap_detection() {
       << _hostname << "'.";
   SPDLOG_LOGGER_DEBUG(checks_logger,
                       "Enabling flap detection for service '{}' on host '{}'.",
-                      name(), _hostname);
+                      name(), _hostname.get());
 
   /* nothing to do... */
   if (flap_detection_enabled())
@@ -3060,7 +3100,7 @@ void service::disable_flap_detection() {
       << _hostname << "'.";
   SPDLOG_LOGGER_DEBUG(checks_logger,
                       "Disabling flap detection for service '{}' on host '{}'.",
-                      name(), _hostname);
+                      name(), _hostname.get());
 
   /* nothing to do... */
   if (!flap_detection_enabled())
@@ -3087,6 +3127,7 @@ void service::disable_flap_detection() {
  * value: STATUS_ALL).
  */
 void service::update_status(uint32_t status_attributes) {
+  check_stats::services().update(*this, _current_state, time(nullptr));
   broker_service_status(this, status_attributes);
 }
 
@@ -3212,6 +3253,8 @@ int service::notify_contact(nagios_macros* mac,
   /* get start time */
   gettimeofday(&start_time, nullptr);
 
+  notification_digest& digest = notification_digest::instance();
+
   /* process all the notification commands this user has */
   for (std::shared_ptr<commands::command> const& cmd :
        cntct->get_service_notification_commands()) {
@@ -3274,6 +3317,22 @@ int service::notify_contact(nagios_macros* mac,
                                  cmd->get_name(), get_plugin_output(), info);
     }
 
+    /* during a storm, the notification may be sent later in a digest */
+    if (digest.enabled()) {
+      notification_digest::entry notif{
+          start_time.tv_sec,
+          mac->x[MACRO_NOTIFICATIONTYPE],
+          get_hostname(),
+          description(),
+          (unsigned int)_current_state < tab_service_states.size()
+              ? tab_service_states[_current_state].second
+              : "UNKNOWN",
+          get_plugin_output()};
+      if (digest.add(cntct->get_name(), cmd->get_name(), std::move(notif),
+                     start_time.tv_sec))
+        continue;
+    }
+
     /* run the notification command */
     if (command_is_allowed_by_whitelist(processed_command, NOTIF_TYPE)) {
       uint32_t notification_timeout = pb_config.notification_timeout();
@@ -3569,11 +3628,11 @@ void service::handle_flap_detection_disabled() {
   update_status();
 }
 
-std::list<servicegroup*> const& service::get_parent_groups() const {
+service::servicegroup_list const& service::get_parent_groups() const {
   return _servicegroups;
 }
 
-std::list<servicegroup*>& service::get_parent_groups() {
+service::servicegroup_list& service::get_parent_groups() {
   return _servicegroups;
 }
 
@@ -3599,8 +3658,8 @@ bool service::authorized_by_dependencies(
   SPDLOG_LOGGER_TRACE(functions_logger,
                       "service::authorized_by_dependencies()");
 
-  auto p(
-      servicedependency::servicedependencies.equal_range({_hostname, name()}));
+  auto p(servicedependency::servicedependencies.equal_range(
+      {_hostname.get(), name()}));
   for (servicedependency_mmap::const_iterator it{p.first}, end{p.second};
        it != end; ++it) {
     servicedependency* dep{it->second.get()};
@@ -3707,6 +3766,7 @@ void service::check_for_orphaned() {
       /* decrement the number of running service checks */
       if (currently_running_service_checks > 0)
         currently_running_service_checks--;
+      events::check_throttle::instance().finished(*it->second, -1);
 
       /* disable the executing flag */
       it->second->set_is_executing(false);
@@ -3834,12 +3894,12 @@ void service::resolve(uint32_t& w, uint32_t& e) {
     config_logger->error(
         "Error: Service description '{}' of host '{}' has problem in its "
         "notifier part: {}",
-        name(), _hostname, e.what());
+        name(), _hostname.get(), e.what());
   }
 
   {
     /* check for a valid host */
-    host_map::const_iterator it{host::hosts.find(_hostname)};
+    host_map::const_iterator it{host::hosts.find(_hostname.get())};
 
     /* we couldn't find an associated host! */
 
@@ -3851,7 +3911,7 @@ void service::resolve(uint32_t& w, uint32_t& e) {
           << name() << "' not defined anywhere!";
       config_logger->error(
           "Error: Host '{}' specified in service '{}' not defined anywhere!",
-          _hostname, name());
+          _hostname.get(), name());
       errors++;
       set_host_ptr(nullptr);
     } else {
@@ -3861,7 +3921,7 @@ void service::resolve(uint32_t& w, uint32_t& e) {
       /* add a reverse link from the host to the service for faster lookups
        * later
        */
-      it->second->services.insert({{_hostname, name()}, this});
+      it->second->services.insert({{_hostname.get(), name()}, this});
 
       // Notify event broker.
       broker_relation_data(NEBTYPE_PARENT_ADD, get_host_ptr(), nullptr, nullptr,
@@ -3881,7 +3941,7 @@ void service::resolve(uint32_t& w, uint32_t& e) {
         "Warning: Recovery notification option in service '{}' for host '{}' "
         "doesn't make any sense - specify warning and /or critical "
         "options as well",
-        name(), _hostname);
+        name(), _hostname.get());
     warnings++;
   }
 
@@ -3900,7 +3960,7 @@ void service::resolve(uint32_t& w, uint32_t& e) {
         "its check interval!  Notifications are only re-sent after "
         "checks are made, so the effective notification interval will "
         "be that of the check interval.",
-        name(), _hostname);
+        name(), _hostname.get());
     warnings++;
   }
 
@@ -3913,7 +3973,7 @@ void service::resolve(uint32_t& w, uint32_t& e) {
     config_logger->error(
         "Error: The description string for service '{}' on host '{}' contains "
         "one or more illegal characters.",
-        name(), _hostname);
+        name(), _hostname.get());
     errors++;
   }
 
@@ -3951,11 +4011,11 @@ void service::set_check_command_ptr(
     return;
   }
   if (old) {
-    old->unregister_host_serv(_hostname, description());
+    old->unregister_host_serv(_hostname.get(), description());
   }
   notifier::set_check_command_ptr(cmd);
   if (cmd) {
-    cmd->register_host_serv(_hostname, description());
+    cmd->register_host_serv(_hostname.get(), description());
   }
 }
 
@@ -0,0 +1,163 @@
+/**
+ * Copyright 2025 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include <gtest/gtest.h>
+
+#include "../test_engine.hh"
+#include "com/centreon/engine/check_stats.hh"
+#include "com/centreon/engine/command_manager.hh"
+#include "com/centreon/engine/configuration/applier/contact.hh"
+#include "com/centreon/engine/configuration/applier/host.hh"
+#include "helper.hh"
+
+using namespace com::centreon::engine;
+
+TEST(QuantileSketch, Empty) {
+  quantile_sketch sketch;
+  ASSERT_EQ(sketch.count(), 0u);
+  ASSERT_EQ(sketch.min(), 0);
+  ASSERT_EQ(sketch.max(), 0);
+  ASSERT_EQ(sketch.average(), 0);
+  ASSERT_EQ(sketch.quantile(0.5), 0);
+}
+
+TEST(QuantileSketch, Quantiles) {
+  quantile_sketch sketch;
+  for (int i = 1; i <= 1000; ++i)
+    sketch.add(i / 100.0);
+  sketch.add(0);
+
+  ASSERT_EQ(sketch.count(), 1001u);
+  ASSERT_NEAR(sketch.average(), 5005.0 / 1001, 1e-9);
+  ASSERT_EQ(sketch.min(), 0);
+  ASSERT_NEAR(sketch.max(), 10, 10 * 0.01);
+  ASSERT_NEAR(sketch.quantile(0.5), 5, 5 * 0.01);
+  ASSERT_NEAR(sketch.quantile(0.99), 9.9, 9.9 * 0.01);
+
+  uint64_t total = 0;
+  double previous = 0;
+  sketch.visit([&](double upper_bound, uint64_t count) {
+    ASSERT_GT(upper_bound, previous);
+    previous = upper_bound;
+    total += count;
+  });
+  ASSERT_EQ(total, 1001u);
+}
+
+TEST(QuantileSketch, Remove) {
+  quantile_sketch sketch;
+  sketch.add(0.5);
+  sketch.add(120);
+  sketch.add(3);
+  sketch.remove(120);
+  ASSERT_EQ(sketch.count(), 2u);
+  ASSERT_NEAR(sketch.max(), 3, 3 * 0.01);
+  ASSERT_NEAR(sketch.min(), 0.5, 0.5 * 0.01);
+  ASSERT_DOUBLE_EQ(sketch.sum(), 3.5);
+}
+
+class IncrementalCheckStats : public TestEngine {
+ public:
+  void SetUp() override {
+    init_config_state();
+
+    configuration::applier::contact ct_aply;
+    configuration::Contact ctct = new_pb_configuration_contact("admin", true);
+    ct_aply.add_object(ctct);
+
+    configuration::applier::host hst_aply;
+    configuration::Host hst1 = new_pb_configuration_host("host_1", "admin", 1);
+    hst_aply.add_object(hst1);
+    configuration::Host hst2 = new_pb_configuration_host("host_2", "admin", 2);
+    hst_aply.add_object(hst2);
+  }
+
+  void TearDown() override { deinit_config_state(); }
+};
+
+TEST_F(IncrementalCheckStats, Hosts) {
+  time_t now = time(nullptr);
+  host* hst1 = host::hosts["host_1"].get();
+  host* hst2 = host::hosts["host_2"].get();
+  ASSERT_EQ(check_stats::hosts().size(), 2u);
+
+  hst1->set_current_state(host::state_down);
+  hst1->set_has_been_checked(true);
+  hst1->set_latency(2);
+  hst1->set_execution_time(4);
+  hst1->set_percent_state_change(10);
+  hst1->set_last_check(now - 100);
+  hst1->update_status();
+
+  hst2->set_check_type(checkable::check_passive);
+  hst2->set_has_been_checked(true);
+  hst2->set_latency(1);
+  hst2->set_percent_state_change(30);
+  hst2->set_last_check(now - 10);
+  hst2->update_status();
+
+  HostsStats stats;
+  command_manager::instance().get_hosts_stats(&stats);
+  ASSERT_EQ(stats.hosts_count(), 2u);
+  ASSERT_EQ(stats.checked_hosts(), 2u);
+  ASSERT_EQ(stats.actively_checked(), 1u);
+  ASSERT_EQ(stats.passively_checked(), 1u);
+  ASSERT_EQ(stats.up(), 1u);
+  ASSERT_EQ(stats.down(), 1u);
+  ASSERT_DOUBLE_EQ(stats.average_state_change(), 20);
+  ASSERT_NEAR(stats.max_state_change(), 30, 30 * 0.01);
+  ASSERT_DOUBLE_EQ(stats.active_hosts().average_latency(), 2);
+  ASSERT_DOUBLE_EQ(stats.active_hosts().average_execution_time(), 4);
+  ASSERT_NEAR(stats.active_hosts().max_execution_time(), 4, 4 * 0.01);
+  ASSERT_EQ(stats.active_hosts().checks_last_1min(), 0u);
+  ASSERT_EQ(stats.active_hosts().checks_last_5min(), 1u);
+  ASSERT_EQ(stats.passive_hosts().checks_last_1min(), 1u);
+  ASSERT_DOUBLE_EQ(stats.passive_hosts().average_latency(), 1);
+  ASSERT_EQ(stats.passive_hosts().average_execution_time(), 0);
+
+  // a new check result replaces the previous values
+  hst1->set_current_state(host::state_up);
+  hst1->set_latency(6);
+  hst1->set_last_check(now);
+  hst1->update_status();
+
+  stats.Clear();
+  command_manager::instance().get_hosts_stats(&stats);
+  ASSERT_EQ(stats.up(), 2u);
+  ASSERT_EQ(stats.down(), 0u);
+  ASSERT_DOUBLE_EQ(stats.active_hosts().average_latency(), 6);
+  ASSERT_EQ(stats.active_hosts().checks_last_1min(), 1u);
+
+  CheckStats response;
+  command_manager::instance().get_check_stats(&response);
+  ASSERT_EQ(response.hosts_stats().up(), 2u);
+  ASSERT_EQ(response.active_hosts().latency().count(), 1u);
+  ASSERT_EQ(response.active_hosts().latency().buckets_size(), 1);
+  ASSERT_NEAR(response.active_hosts().latency().p50(), 6, 6 * 0.01);
+}
+
+TEST_F(IncrementalCheckStats, RemovedHost) {
+  host* hst1 = host::hosts["host_1"].get();
+  hst1->set_current_state(host::state_down);
+  hst1->update_status();
+  check_stats::hosts().remove(*hst1);
+
+  ASSERT_EQ(check_stats::hosts().size(), 1u);
+  ASSERT_EQ(check_stats::hosts().state_count(host::state_down), 0u);
+  ASSERT_EQ(check_stats::hosts().state_count(host::state_up), 1u);
+}
@@ -822,3 +822,90 @@ TEST_F(ApplierService, PbServicesCheckValidityTags) {
   host_map const& hm(engine::host::hosts);
   ASSERT_EQ(sm.begin()->second->get_host_ptr(), hm.begin()->second.get());
 }
+
+// Given two services sharing the same host and the same urls
+// Then their configuration strings are stored once
+TEST_F(ApplierService, PbServicesShareConfigurationStrings) {
+  configuration::applier::host hst_aply;
+  configuration::Host hst;
+  configuration::host_helper hst_hlp(&hst);
+  hst.set_host_name("test_host");
+  hst.set_address("127.0.0.1");
+  hst.set_host_id(1);
+  hst_aply.add_object(hst);
+
+  configuration::applier::command cmd_aply;
+  configuration::Command cmd;
+  configuration::command_helper cmd_hlp(&cmd);
+  cmd.set_command_name("cmd");
+  cmd.set_command_line("echo 1");
+  cmd_aply.add_object(cmd);
+
+  configuration::applier::service svc_aply;
+  for (uint64_t id : {3u, 4u}) {
+    configuration::Service svc;
+    configuration::service_helper svc_hlp(&svc);
+    svc.set_host_name("test_host");
+    svc.set_host_id(1);
+    svc.set_service_description(fmt::format("test_description{}", id));
+    svc.set_service_id(id);
+    svc.set_check_command("cmd");
+    svc.set_notes_url("http://localhost/notes/$HOSTNAME$/$SERVICEDESC$");
+    svc.set_icon_image("service.png");
+    svc_aply.add_object(svc);
+  }
+
+  const engine::service& svc3 = *engine::service::services_by_id[{1u, 3u}];
+  engine::service& svc4 = *engine::service::services_by_id[{1u, 4u}];
+  ASSERT_EQ(&svc3.get_hostname(), &svc4.get_hostname());
+  ASSERT_EQ(&svc3.get_notes_url(), &svc4.get_notes_url());
+  ASSERT_EQ(&svc3.get_icon_image(), &svc4.get_icon_image());
+  ASSERT_EQ(&svc3.check_command(), &svc4.check_command());
+
+  svc4.set_icon_image("other.png");
+  ASSERT_EQ(svc3.get_icon_image(), "service.png");
+  ASSERT_EQ(svc4.get_icon_image(), "other.png");
+}
+
+// Given a service added by the applier
+// Then it is found by its names and by its ids without building a key
+TEST_F(ApplierService, PbLookupService) {
+  configuration::applier::host hst_aply;
+  configuration::Host hst;
+  configuration::host_helper hst_hlp(&hst);
+  hst.set_host_name("test_host");
+  hst.set_address("127.0.0.1");
+  hst.set_host_id(1);
+  hst_aply.add_object(hst);
+
+  configuration::applier::command cmd_aply;
+  configuration::Command cmd;
+  configuration::command_helper cmd_hlp(&cmd);
+  cmd.set_command_name("cmd");
+  cmd.set_command_line("echo 1");
+  cmd_aply.add_object(cmd);
+
+  configuration::applier::service svc_aply;
+  configuration::Service svc;
+  configuration::service_helper svc_hlp(&svc);
+  svc.set_host_name("test_host");
+  svc.set_host_id(1);
+  svc.set_service_description("test_description");
+  svc.set_service_id(3);
+  svc.set_check_command("cmd");
+  svc_aply.add_object(svc);
+
+  std::string_view host_name("test_host;test_description", 9);
+  std::string_view description("test_host;test_description");
+  description.remove_prefix(10);
+  engine::service* found = lookup_service(host_name, description);
+  ASSERT_TRUE(found);
+  ASSERT_EQ(found->service_id(), 3u);
+  ASSERT_EQ(lookup_service(1, 3), found);
+  ASSERT_EQ(lookup_service(host_name, "unknown"), nullptr);
+  ASSERT_EQ(lookup_service(1, 4), nullptr);
+
+  ASSERT_EQ(lookup_host(host_name), lookup_host(1));
+  ASSERT_EQ(lookup_host(1)->name(), "test_host");
+  ASSERT_EQ(lookup_host("unknown"), nullptr);
+}
@@ -0,0 +1,139 @@
+/**
+ * Copyright 2025 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+/**
+ * Lookups of services in service::services and service::services_by_id, as
+ * external commands, macros and opentelemetry do them. Services are real
+ * engine services, names are extracted from external command lines.
+ * Three ways are compared:
+ *  - copy: services.find() with a std::pair of std::string built from the
+ *    names (the former code)
+ *  - names: lookup_service(host_name, description), without copy
+ *  - ids: lookup_service(host_id, service_id)
+
+ ./host_serv_lookup-bench [hosts] [services per host] [lookups]
+
+ Defaults are 15000 hosts, 10 services per host and 10000000 lookups.
+*/
+
+#include <fmt/format.h>
+#include <chrono>
+#include <iostream>
+
+#include "com/centreon/engine/service.hh"
+
+using namespace com::centreon::engine;
+
+/* cce_core is linked as a whole archive, it needs this engine main global */
+std::shared_ptr<asio::io_context> g_io_context(
+    std::make_shared<asio::io_context>());
+
+/**
+ * @brief create the services and the external commands that target them
+ *
+ * @param hosts
+ * @param services_per_host
+ * @return std::vector<std::string> one "host;service;0;OK" per service
+ */
+static std::vector<std::string> create_services(uint64_t hosts,
+                                                uint64_t services_per_host) {
+  std::vector<std::string> commands;
+  commands.reserve(hosts * services_per_host);
+  for (uint64_t host_id = 1; host_id <= hosts; ++host_id) {
+    std::string host_name = fmt::format("srv-{:06}.paris.example.com", host_id);
+    for (uint64_t i = 0; i < services_per_host; ++i) {
+      uint64_t service_id = host_id * services_per_host + i;
+      std::string description = fmt::format("Disk-/var/lib/data{}", i);
+      auto svc = std::make_shared<service>(
+          host_name, description, description, "check_disk", true, true, 5, 1,
+          0, 3, 0, 0, "", false, false, "", "", false, "", "", "", "", "",
+          false, 0.0, 0.0, false, 0, false, "", 0);
+      svc->set_host_id(host_id);
+      svc->set_service_id(service_id);
+      service::services[{host_name, description}] = svc;
+      service::services_by_id[{host_id, service_id}] = svc;
+      commands.emplace_back(fmt::format("{};{};0;OK", host_name, description));
+    }
+  }
+  return commands;
+}
+
+static std::pair<std::string_view, std::string_view> split(
+    std::string_view cmd) {
+  size_t first = cmd.find(';');
+  size_t second = cmd.find(';', first + 1);
+  return {cmd.substr(0, first), cmd.substr(first + 1, second - first - 1)};
+}
+
+/**
+ * @brief run lookups and print the mean duration of one of them
+ *
+ * @param name
+ * @param lookups number of lookups
+ * @param count number of services, lookups are spread over them
+ * @param lookup called with a service index, returns the service found
+ */
+template <typename lookup_fn>
+static void run(const char* name,
+                uint64_t lookups,
+                uint64_t count,
+                lookup_fn&& lookup) {
+  uint64_t found = 0;
+  uint64_t idx = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (uint64_t i = 0; i < lookups; ++i) {
+    if (lookup(idx))
+      ++found;
+    idx = (idx + 7919) % count;
+  }
+  auto duration = std::chrono::steady_clock::now() - start;
+  std::cout << fmt::format(
+      "{:>6}: {} lookups, {} found, {:.1f} ns per lookup\n", name, lookups,
+      found,
+      std::chrono::duration<double, std::nano>(duration).count() / lookups);
+}
+
+int main(int argc, char** argv) {
+  uint64_t hosts = argc > 1 ? std::stoul(argv[1]) : 15000;
+  uint64_t services_per_host = argc > 2 ? std::stoul(argv[2]) : 10;
+  uint64_t lookups = argc > 3 ? std::stoul(argv[3]) : 10000000;
+
+  std::vector<std::string> commands =
+      create_services(hosts, services_per_host);
+  uint64_t count = commands.size();
+
+  run("copy", lookups, count, [&commands](uint64_t idx) {
+    auto [host_name, description] = split(commands[idx]);
+    auto found = service::services.find(
+        {std::string(host_name), std::string(description)});
+    return found != service::services.end() ? found->second.get() : nullptr;
+  });
+  run("names", lookups, count, [&commands](uint64_t idx) {
+    auto [host_name, description] = split(commands[idx]);
+    return lookup_service(host_name, description);
+  });
+  run("ids", lookups, count, [services_per_host](uint64_t idx) {
+    uint64_t host_id = idx / services_per_host + 1;
+    uint64_t service_id = host_id * services_per_host + idx % services_per_host;
+    return lookup_service(host_id, service_id);
+  });
+
+  service::services_by_id.clear();
+  service::services.clear();
+  return 0;
+}
@@ -0,0 +1,139 @@
+/**
+ * Copyright 2025 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include <gtest/gtest.h>
+
+#include "../test_engine.hh"
+#include "com/centreon/engine/commands/command.hh"
+#include "com/centreon/engine/configuration/applier/contact.hh"
+#include "com/centreon/engine/configuration/applier/host.hh"
+#include "com/centreon/engine/configuration/applier/service.hh"
+#include "helper.hh"
+
+#include "com/centreon/engine/events/check_throttle.hh"
+
+using namespace com::centreon;
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::configuration;
+using verdict = events::check_throttle::verdict;
+
+class CheckThrottle : public TestEngine {
+ protected:
+  std::shared_ptr<engine::service> _svc;
+
+ public:
+  void SetUp() override {
+    error_cnt err;
+    init_config_state();
+    events::check_throttle::instance().clear();
+
+    configuration::applier::contact ct_aply;
+    configuration::Contact ctct{new_pb_configuration_contact("admin", true)};
+    ct_aply.add_object(ctct);
+    ct_aply.expand_objects(pb_config);
+    ct_aply.resolve_object(ctct, err);
+
+    configuration::Host hst{new_pb_configuration_host("test_host", "admin")};
+    configuration::applier::host hst_aply;
+    hst_aply.add_object(hst);
+
+    configuration::Service svc{
+        new_pb_configuration_service("test_host", "test_svc", "admin")};
+    configuration::applier::service svc_aply;
+    svc_aply.add_object(svc);
+
+    hst_aply.resolve_object(hst, err);
+    svc_aply.resolve_object(svc, err);
+
+    _svc = engine::service::services.begin()->second;
+    pb_config.set_adaptive_check_scheduling(true);
+  }
+
+  void TearDown() override {
+    events::check_throttle::instance().clear();
+    _svc.reset();
+    deinit_config_state();
+  }
+};
+
+TEST_F(CheckThrottle, RateLimit) {
+  events::check_throttle& throttle = events::check_throttle::instance();
+  pb_config.set_max_check_rate(2);
+
+  ASSERT_EQ(throttle.admit(*_svc, 1000, 0), verdict::run);
+  ASSERT_EQ(throttle.admit(*_svc, 1000, 0), verdict::run);
+  ASSERT_EQ(throttle.admit(*_svc, 1000, 0), verdict::rate_limited);
+
+  // one deferred check per second at this rate
+  ASSERT_EQ(throttle.defer(*_svc, verdict::rate_limited, 1000), 1001);
+  ASSERT_EQ(throttle.defer(*_svc, verdict::rate_limited, 1000), 1002);
+  ASSERT_EQ(throttle.deferred_count(), 2u);
+
+  // tokens are given back the next second
+  ASSERT_EQ(throttle.admit(*_svc, 1001, 0), verdict::run);
+}
+
+TEST_F(CheckThrottle, Rate) {
+  events::check_throttle& throttle = events::check_throttle::instance();
+  pb_config.set_max_parallel_service_checks(10);
+  ASSERT_EQ(throttle.compute_rate(0), 0);
+
+  throttle.started(*_svc);
+  throttle.finished(*_svc, 5);
+  ASSERT_DOUBLE_EQ(throttle.average_execution_time(), 5);
+  ASSERT_DOUBLE_EQ(throttle.compute_rate(0), 2);
+  ASSERT_DOUBLE_EQ(throttle.compute_rate(10), 1);
+
+  pb_config.set_max_check_rate(1);
+  ASSERT_DOUBLE_EQ(throttle.compute_rate(0), 1);
+}
+
+TEST_F(CheckThrottle, CommandLimit) {
+  events::check_throttle& throttle = events::check_throttle::instance();
+  const std::shared_ptr<commands::command>& cmd =
+      _svc->get_check_command_ptr();
+  ASSERT_TRUE(cmd);
+  cmd->set_max_parallel_checks(1);
+
+  throttle.started(*_svc);
+  ASSERT_EQ(throttle.running(cmd->get_name()), 1u);
+  ASSERT_EQ(throttle.admit(*_svc, 1000, 0), verdict::command_limited);
+
+  throttle.finished(*_svc, 4);
+  ASSERT_EQ(throttle.running(cmd->get_name()), 0u);
+  ASSERT_EQ(throttle.admit(*_svc, 1000, 0), verdict::run);
+  ASSERT_EQ(throttle.defer(*_svc, verdict::command_limited, 1000), 1004);
+}
+
+TEST_F(CheckThrottle, Lateness) {
+  events::check_throttle& throttle = events::check_throttle::instance();
+  _svc->set_next_check(1000);
+  throttle.defer(*_svc, verdict::rate_limited, 1002);
+  throttle.launched(*_svc, 1005);
+
+  ASSERT_EQ(throttle.lateness_at_dispatch().count(), 1u);
+  ASSERT_DOUBLE_EQ(throttle.lateness_at_dispatch().sum(), 2);
+  ASSERT_DOUBLE_EQ(throttle.lateness_at_launch().sum(), 5);
+
+  // not deferred, both lateness are the same
+  _svc->set_next_check(1010);
+  throttle.launched(*_svc, 1011);
+  ASSERT_EQ(throttle.lateness_at_launch().count(), 2u);
+  ASSERT_DOUBLE_EQ(throttle.lateness_at_dispatch().sum(), 3);
+  ASSERT_DOUBLE_EQ(throttle.lateness_at_launch().sum(), 6);
+}
@@ -0,0 +1,123 @@
+/**
+ * Copyright 2025 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include <gtest/gtest.h>
+#include <rapidjson/document.h>
+
+#include "com/centreon/engine/configuration/applier/command.hh"
+#include "com/centreon/engine/globals.hh"
+#include "com/centreon/engine/notification_digest.hh"
+#include "common/engine_conf/command_helper.hh"
+#include "helper.hh"
+
+using namespace com::centreon::engine;
+
+class NotificationDigest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    init_config_state();
+    configuration::applier::command aply;
+    configuration::Command cmd;
+    configuration::command_helper cmd_hlp(&cmd);
+    cmd.set_command_name("digest");
+    cmd.set_command_line("/bin/true $ARG1$");
+    aply.add_object(cmd);
+
+    pb_config.set_notification_digest_command("digest");
+    pb_config.set_notification_digest_window(60);
+    pb_config.set_notification_digest_threshold(2);
+    pb_config.set_notification_digest_max_entries(3);
+  }
+
+  void TearDown() override {
+    notification_digest::instance().clear();
+    deinit_config_state();
+  }
+
+  static notification_digest::entry new_entry(time_t now,
+                                              const std::string& svc) {
+    return {now, "PROBLEM", "host_1", svc, "CRITICAL", "down !"};
+  }
+};
+
+TEST_F(NotificationDigest, Disabled) {
+  pb_config.set_notification_digest_command("");
+  notification_digest& digest = notification_digest::instance();
+  ASSERT_FALSE(digest.enabled());
+  for (int i = 0; i < 10; ++i)
+    ASSERT_FALSE(digest.add("admin", "notify", new_entry(1000, "svc"), 1000));
+
+  pb_config.set_notification_digest_command("unknown");
+  ASSERT_FALSE(digest.enabled());
+}
+
+TEST_F(NotificationDigest, Threshold) {
+  notification_digest& digest = notification_digest::instance();
+  ASSERT_TRUE(digest.enabled());
+  ASSERT_FALSE(digest.add("admin", "notify", new_entry(1000, "svc0"), 1000));
+  ASSERT_FALSE(digest.add("admin", "notify", new_entry(1000, "svc1"), 1000));
+  for (int i = 2; i < 7; ++i)
+    ASSERT_TRUE(digest.add("admin", "notify",
+                           new_entry(1001, fmt::format("svc{}", i)), 1001));
+
+  // another contact has its own quota
+  ASSERT_FALSE(digest.add("guest", "notify", new_entry(1001, "svc0"), 1001));
+
+  const notification_digest::digest* pending =
+      digest.pending("admin", "notify");
+  ASSERT_NE(pending, nullptr);
+  ASSERT_EQ(pending->start, 1001);
+  ASSERT_EQ(pending->entries.size(), 3u);
+  ASSERT_EQ(pending->dropped, 2u);
+  ASSERT_EQ(pending->entries[0].service_description, "svc2");
+  ASSERT_EQ(digest.pending("guest", "notify"), nullptr);
+
+  // the window is not over
+  digest.flush(1060);
+  ASSERT_NE(digest.pending("admin", "notify"), nullptr);
+
+  digest.flush(1061);
+  ASSERT_EQ(digest.pending("admin", "notify"), nullptr);
+
+  // a new window begins
+  ASSERT_FALSE(digest.add("admin", "notify", new_entry(1070, "svc0"), 1070));
+}
+
+TEST_F(NotificationDigest, Payload) {
+  notification_digest::digest dgst{1000, 4, {}};
+  dgst.entries.push_back(new_entry(1001, "svc\"1"));
+  dgst.entries.push_back(new_entry(1002, ""));
+
+  std::string json = notification_digest::payload("admin", "notify", dgst);
+  rapidjson::Document doc;
+  doc.Parse(json.c_str());
+  ASSERT_FALSE(doc.HasParseError());
+  ASSERT_STREQ(doc["contact"].GetString(), "admin");
+  ASSERT_STREQ(doc["command"].GetString(), "notify");
+  ASSERT_EQ(doc["start"].GetInt64(), 1000);
+  ASSERT_EQ(doc["dropped"].GetUint(), 4u);
+  const auto& notifs = doc["notifications"];
+  ASSERT_EQ(notifs.Size(), 2u);
+  ASSERT_STREQ(notifs[0u]["service_description"].GetString(), "svc\"1");
+  ASSERT_STREQ(notifs[0u]["state"].GetString(), "CRITICAL");
+  // the expanded command line may carry credentials
+  ASSERT_FALSE(notifs[0u].HasMember("command_line"));
+  ASSERT_EQ(notifs[1u]["time"].GetInt64(), 1002);
+  // host notification
+  ASSERT_FALSE(notifs[1u].HasMember("service_description"));
+}
@@ -0,0 +1,389 @@
+/**
+ * Copyright 2025 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+/**
+ * Load test of the engine side of centreon monitoring agent connections.
+ * The process forks:
+ *  - the parent is the engine: an otl_server that accepts agent connections
+ *    and a main loop that executes command_manager jobs as engine does.
+ *  - the child simulates agents on localhost: each fake agent has its own
+ *    channel and so its own tcp connection, it sends an init message and
+ *    waits for its configuration.
+ * Child reports the time between stream creation and configuration reception.
+ * Parent reports its memory and cpu consumption per connection, then it pushes
+ * a new configuration to all agents and reports the time spent in the main
+ * thread and the time needed by all agents to receive it.
+ * Fork is done before any grpc initialization, so engine measures are not
+ * disturbed by fake agents.
+ * For more than about 500 agents, open files limit (ulimit -n) must be raised,
+ * this program raises soft limit to hard limit.
+
+ ./agent_connections-bench [agents] [connection threads] [port]
+
+ Defaults are 1000 agents, 2 connection threads (connection_threads default:
+ messages of agents are handled by connection_pool threads) and port 4650.
+ Run it with 0 connection threads to compare with messages handled by grpc
+ threads.
+*/
+
+#include <fmt/format.h>
+#include <poll.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <thread>
+
+#include <grpcpp/grpcpp.h>
+
+#include "centreon_agent/agent.grpc.pb.h"
+
+#include "com/centreon/engine/command_manager.hh"
+#include "com/centreon/engine/modules/opentelemetry/centreon_agent/agent_impl.hh"
+#include "com/centreon/engine/modules/opentelemetry/centreon_agent/connection_pool.hh"
+#include "com/centreon/engine/modules/opentelemetry/otl_server.hh"
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::modules::opentelemetry;
+using namespace std::chrono_literals;
+namespace agent = com::centreon::agent;
+
+/* cce_core is linked as a whole archive, it needs this engine main global */
+std::shared_ptr<asio::io_context> g_io_context(
+    std::make_shared<asio::io_context>());
+
+using bench_clock = std::chrono::steady_clock;
+
+/**
+ * @brief write one byte in a pipe to wake the other process
+ */
+static void signal_pipe(int fd) {
+  char c = 0;
+  if (write(fd, &c, 1) != 1) {
+    perror("write to pipe");
+  }
+}
+
+/**
+ * @brief wait for one byte from a pipe
+ *
+ * @param timeout_ms -1: infinite
+ * @return true if a byte has been read or if the other process has ended
+ */
+static bool wait_pipe(int fd, int timeout_ms) {
+  pollfd pfd{fd, POLLIN, 0};
+  if (poll(&pfd, 1, timeout_ms) <= 0) {
+    return false;
+  }
+  char c;
+  return read(fd, &c, 1) >= 0;
+}
+
+/**
+ * @brief resident memory of this process in bytes
+ */
+static size_t rss() {
+  std::ifstream statm("/proc/self/statm");
+  size_t size = 0, resident = 0;
+  statm >> size >> resident;
+  return resident * sysconf(_SC_PAGESIZE);
+}
+
+/**
+ * @brief user + system cpu time of this process
+ */
+static std::chrono::microseconds cpu_time() {
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return std::chrono::seconds(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) +
+         std::chrono::microseconds(usage.ru_utime.tv_usec +
+                                   usage.ru_stime.tv_usec);
+}
+
+/**
+ * @brief a fake agent: it sends an init message and reads configurations
+ * It's never deleted, the child process ends with _exit.
+ */
+class fake_agent
+    : public ::grpc::ClientBidiReactor<agent::MessageFromAgent,
+                                       agent::MessageToAgent> {
+  std::shared_ptr<::grpc::Channel> _channel;
+  std::unique_ptr<agent::AgentService::Stub> _stub;
+  ::grpc::ClientContext _context;
+  agent::MessageFromAgent _init;
+  agent::MessageToAgent _read;
+  bench_clock::time_point _start;
+
+ public:
+  static std::atomic_uint connected;
+  static std::atomic_uint configs_received;
+  static std::atomic_uint failed;
+  static absl::Mutex latencies_m;
+  static std::vector<std::chrono::microseconds> latencies
+      ABSL_GUARDED_BY(latencies_m);
+
+  fake_agent(const std::string& endpoint, unsigned index) {
+    ::grpc::ChannelArguments args;
+    // one tcp connection per agent as in real life
+    args.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+    _channel = ::grpc::CreateCustomChannel(
+        endpoint, ::grpc::InsecureChannelCredentials(), args);
+    _stub = agent::AgentService::NewStub(_channel);
+    _init.mutable_init()->set_host(fmt::format("host-{:05}", index));
+    _init.mutable_init()->mutable_centreon_version()->set_major(25);
+    _init.mutable_init()->set_os("linux");
+  }
+
+  void start() {
+    _start = bench_clock::now();
+    _context.set_wait_for_ready(true);
+    _stub->async()->Export(&_context, this);
+    StartWrite(&_init);
+    StartRead(&_read);
+    StartCall();
+  }
+
+  void OnWriteDone(bool ok) override {
+    if (!ok) {
+      ++failed;
+    }
+  }
+
+  void OnReadDone(bool ok) override {
+    if (!ok) {
+      ++failed;
+      return;
+    }
+    if (_start != bench_clock::time_point()) {
+      auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+          bench_clock::now() - _start);
+      _start = bench_clock::time_point();
+      {
+        absl::MutexLock l(&latencies_m);
+        latencies.push_back(latency);
+      }
+      ++connected;
+    }
+    ++configs_received;
+    StartRead(&_read);
+  }
+
+  void OnDone(const ::grpc::Status&) override {}
+};
+
+std::atomic_uint fake_agent::connected{0};
+std::atomic_uint fake_agent::configs_received{0};
+std::atomic_uint fake_agent::failed{0};
+absl::Mutex fake_agent::latencies_m;
+std::vector<std::chrono::microseconds> fake_agent::latencies;
+
+/**
+ * @brief wait until predicate is true or timeout
+ */
+template <class predicate>
+static bool wait_for(predicate&& pred, std::chrono::seconds timeout) {
+  bench_clock::time_point end = bench_clock::now() + timeout;
+  while (!pred()) {
+    if (bench_clock::now() > end) {
+      return false;
+    }
+    std::this_thread::sleep_for(10ms);
+  }
+  return true;
+}
+
+/**
+ * @brief child process
+ *
+ * @param nb_agents
+ * @param endpoint
+ * @param from_engine engine signals it's ready and when it pushes a new conf
+ * @param to_engine we signal when all agents are connected and have received
+ * the new conf
+ */
+static int run_agents(unsigned nb_agents,
+                      const std::string& endpoint,
+                      int from_engine,
+                      int to_engine) {
+  if (!wait_pipe(from_engine, 30000)) {
+    fmt::print(stderr, "engine not started\n");
+    return 1;
+  }
+  std::vector<fake_agent*> agents;
+  agents.reserve(nb_agents);
+  bench_clock::time_point start = bench_clock::now();
+  for (unsigned index = 0; index < nb_agents; ++index) {
+    agents.push_back(new fake_agent(endpoint, index));
+    agents.back()->start();
+  }
+  bool all_connected = wait_for(
+      [nb_agents] { return fake_agent::connected >= nb_agents; }, 300s);
+  std::chrono::duration<double> elapsed = bench_clock::now() - start;
+
+  {
+    absl::MutexLock l(&fake_agent::latencies_m);
+    std::vector<std::chrono::microseconds>& latencies = fake_agent::latencies;
+    std::sort(latencies.begin(), latencies.end());
+    if (!latencies.empty()) {
+      auto percentile = [&latencies](double pct) {
+        return latencies[std::min<size_t>(latencies.size() * pct,
+                                          latencies.size() - 1)]
+                   .count() /
+               1000.0;
+      };
+      fmt::print(
+          "agents connected:{}/{} failed:{} in {:.2f}s ({:.0f} agents/s)\n"
+          "connect to config latency ms: p50:{:.1f} p90:{:.1f} p99:{:.1f} "
+          "max:{:.1f}\n",
+          latencies.size(), nb_agents, fake_agent::failed.load(),
+          elapsed.count(), latencies.size() / elapsed.count(),
+          percentile(0.5), percentile(0.9), percentile(0.99),
+          percentile(1.0));
+    }
+  }
+  if (!all_connected) {
+    fmt::print(stderr, "not all agents have received their configuration\n");
+  }
+  fflush(stdout);
+  signal_pipe(to_engine);
+
+  // engine pushes a new configuration to all agents
+  if (!wait_pipe(from_engine, 300000)) {
+    return 1;
+  }
+  unsigned before = fake_agent::configs_received;
+  unsigned expected = before + fake_agent::connected;
+  start = bench_clock::now();
+  bool all_received = wait_for(
+      [expected] { return fake_agent::configs_received >= expected; }, 300s);
+  elapsed = bench_clock::now() - start;
+  fmt::print("new configuration received by {}/{} agents in {:.3f}s\n",
+             fake_agent::configs_received - before,
+             fake_agent::connected.load(), elapsed.count());
+  fflush(stdout);
+  signal_pipe(to_engine);
+  return all_connected && all_received ? 0 : 1;
+}
+
+/**
+ * @brief parent process
+ */
+static int run_engine(unsigned nb_agents,
+                      unsigned connection_threads,
+                      const std::string& endpoint,
+                      int to_agents,
+                      int from_agents) {
+  std::shared_ptr<spdlog::logger> logger =
+      std::make_shared<spdlog::logger>("agent_connections-bench");
+  logger->set_level(spdlog::level::off);
+
+  auto io_context = std::make_shared<asio::io_context>();
+  auto worker = asio::make_work_guard(*io_context);
+  std::thread io_thread([io_context] { io_context->run(); });
+
+  centreon_agent::connection_pool::set_size(connection_threads, logger);
+
+  auto agent_conf =
+      std::make_shared<centreon_agent::agent_config>(100, 60, 30);
+  auto stats = std::make_shared<centreon_agent::agent_stat>(io_context);
+  otl_server::pointer server = otl_server::load(
+      io_context, std::make_shared<grpc_config>(endpoint, false), agent_conf,
+      [](const metric_request_ptr&) {}, logger, stats);
+
+  size_t rss_before = rss();
+  std::chrono::microseconds cpu_before = cpu_time();
+  signal_pipe(to_agents);
+
+  // engine main loop
+  while (!wait_pipe(from_agents, 10)) {
+    command_manager::instance().execute();
+  }
+
+  size_t rss_after = rss();
+  std::chrono::microseconds cpu_after = cpu_time();
+  fmt::print(
+      "engine: connection threads:{} rss:{:.1f}MB +{:.1f}MB ({:.1f}kB per "
+      "connection) cpu:{:.3f}s ({:.0f}us per connection)\n",
+      connection_threads, rss_after / 1048576.0,
+      (rss_after - rss_before) / 1048576.0,
+      (rss_after - rss_before) / 1024.0 / nb_agents,
+      (cpu_after - cpu_before).count() / 1e6,
+      static_cast<double>((cpu_after - cpu_before).count()) / nb_agents);
+  fflush(stdout);
+
+  // push a new configuration to all agents
+  auto new_agent_conf =
+      std::make_shared<centreon_agent::agent_config>(100, 30, 30);
+  server->update_agent_config(new_agent_conf);
+  signal_pipe(to_agents);
+  bench_clock::time_point start = bench_clock::now();
+  centreon_agent::agent_impl<::grpc::ServerBidiReactor<
+      agent::MessageFromAgent, agent::MessageToAgent>>::
+      all_agent_calc_and_send_config_if_needed(new_agent_conf);
+  command_manager::instance().execute();
+  std::chrono::duration<double> main_thread = bench_clock::now() - start;
+  fmt::print("engine: configuration push took {:.3f}s in main thread\n",
+             main_thread.count());
+  fflush(stdout);
+  while (!wait_pipe(from_agents, 10)) {
+    command_manager::instance().execute();
+  }
+
+  server->shutdown(std::chrono::seconds(5));
+  centreon_agent::connection_pool::stop();
+  worker.reset();
+  io_context->stop();
+  io_thread.join();
+  return 0;
+}
+
+int main(int argc, char** argv) {
+  unsigned nb_agents = argc > 1 ? std::stoul(argv[1]) : 1000;
+  unsigned connection_threads = argc > 2 ? std::stoul(argv[2]) : 2;
+  unsigned port = argc > 3 ? std::stoul(argv[3]) : 4650;
+  std::string endpoint = fmt::format("127.0.0.1:{}", port);
+
+  rlimit limit;
+  if (!getrlimit(RLIMIT_NOFILE, &limit)) {
+    limit.rlim_cur = limit.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &limit);
+  }
+
+  int engine_to_agents[2], agents_to_engine[2];
+  if (pipe(engine_to_agents) || pipe(agents_to_engine)) {
+    perror("pipe");
+    return 1;
+  }
+
+  pid_t child = fork();
+  if (child < 0) {
+    perror("fork");
+    return 1;
+  }
+  if (!child) {
+    _exit(run_agents(nb_agents, endpoint, engine_to_agents[0],
+                     agents_to_engine[1]));
+  }
+  int ret = run_engine(nb_agents, connection_threads, endpoint,
+                       engine_to_agents[1], agents_to_engine[0]);
+  int status = 0;
+  waitpid(child, &status, 0);
+  return ret || !WIFEXITED(status) || WEXITSTATUS(status);
+}
@@ -0,0 +1,209 @@
+/**
+ * Copyright 2025 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include <gtest/gtest.h>
+
+#include "opentelemetry/proto/collector/metrics/v1/metrics_service.pb.h"
+#include "opentelemetry/proto/common/v1/common.pb.h"
+#include "opentelemetry/proto/metrics/v1/metrics.pb.h"
+
+#include "com/centreon/engine/modules/opentelemetry/broker_forwarder.hh"
+
+using namespace com::centreon::engine::modules::opentelemetry;
+using namespace ::opentelemetry::proto::metrics::v1;
+
+extern std::shared_ptr<asio::io_context> g_io_context;
+
+/**
+ * @brief a request with one gauge of nb_points data points per host
+ */
+static metric_request_ptr create_request(
+    const std::vector<std::string>& hosts,
+    const std::string& metric_name,
+    unsigned nb_points) {
+  auto ret = std::make_shared<::opentelemetry::proto::collector::metrics::v1::
+                                  ExportMetricsServiceRequest>();
+  for (const std::string& host : hosts) {
+    ResourceMetrics* resource = ret->add_resource_metrics();
+    auto* attrib = resource->mutable_resource()->add_attributes();
+    attrib->set_key("host.name");
+    attrib->mutable_value()->set_string_value(host);
+    ScopeMetrics* scope = resource->add_scope_metrics();
+    scope->mutable_scope()->set_name("centreon");
+    Metric* metric = scope->add_metrics();
+    metric->set_name(metric_name);
+    metric->set_unit("B");
+    for (unsigned i = 0; i < nb_points; ++i) {
+      NumberDataPoint* data_pt = metric->mutable_gauge()->add_data_points();
+      data_pt->set_time_unix_nano(1000000000 * (i + 1));
+      data_pt->set_as_double(i);
+    }
+  }
+  return ret;
+}
+
+static std::vector<otl_data_point> extract(const metric_request_ptr& request) {
+  std::vector<otl_data_point> ret;
+  otl_data_point::extract_data_points(
+      request, [&ret](const otl_data_point& data_pt) {
+        ret.push_back(data_pt);
+      });
+  return ret;
+}
+
+class broker_forwarder_test : public ::testing::Test {
+ protected:
+  std::vector<metric_request_ptr> _sent;
+  std::vector<metric_request_ptr> _sent_on_shutdown;
+  broker_forwarder::pointer _forwarder;
+
+ public:
+  void SetUp() override {
+    _forwarder = std::make_shared<broker_forwarder>(
+        g_io_context, spdlog::default_logger(),
+        [this](const metric_request_ptr& batch) { _sent.push_back(batch); },
+        [this](const metric_request_ptr& batch) {
+          _sent_on_shutdown.push_back(batch);
+        });
+  }
+
+  void TearDown() override {
+    _forwarder->shutdown();
+    _forwarder.reset();
+  }
+};
+
+TEST_F(broker_forwarder_test, compact) {
+  broker_forward_config conf;
+  conf.batch_size = 100;
+  _forwarder->update_config(conf);
+
+  auto request1 = create_request({"host1", "host2"}, "memory", 2);
+  auto request2 = create_request({"host1"}, "memory", 3);
+  _forwarder->on_data_points(extract(request1));
+  _forwarder->on_data_points(extract(request2));
+  ASSERT_TRUE(_sent.empty());
+
+  _forwarder->flush();
+  ASSERT_EQ(_sent.size(), 1u);
+  const auto& batch = *_sent[0];
+  ASSERT_EQ(batch.resource_metrics_size(), 2);
+  const ResourceMetrics& host1 = batch.resource_metrics(0);
+  ASSERT_EQ(host1.resource().attributes(0).value().string_value(), "host1");
+  ASSERT_EQ(host1.scope_metrics_size(), 1);
+  ASSERT_EQ(host1.scope_metrics(0).scope().name(), "centreon");
+  ASSERT_EQ(host1.scope_metrics(0).metrics_size(), 1);
+  const Metric& memory = host1.scope_metrics(0).metrics(0);
+  ASSERT_EQ(memory.name(), "memory");
+  ASSERT_EQ(memory.unit(), "B");
+  ASSERT_EQ(memory.gauge().data_points_size(), 5);
+  ASSERT_EQ(batch.resource_metrics(1)
+                .scope_metrics(0)
+                .metrics(0)
+                .gauge()
+                .data_points_size(),
+            2);
+  ASSERT_EQ(_forwarder->get_forwarded(), 7u);
+  ASSERT_EQ(_forwarder->get_batches(), 1u);
+
+  // nothing left
+  _forwarder->flush();
+  ASSERT_EQ(_sent.size(), 1u);
+}
+
+TEST_F(broker_forwarder_test, batch_size) {
+  broker_forward_config conf;
+  conf.batch_size = 4;
+  _forwarder->update_config(conf);
+
+  _forwarder->on_data_points(
+      extract(create_request({"host1", "host2"}, "cpu", 5)));
+  ASSERT_EQ(_sent.size(), 2u);
+  for (const metric_request_ptr& batch : _sent) {
+    unsigned nb_points = 0;
+    for (const auto& resource : batch->resource_metrics())
+      nb_points +=
+          resource.scope_metrics(0).metrics(0).gauge().data_points_size();
+    ASSERT_EQ(nb_points, 4u);
+  }
+  _forwarder->flush();
+  ASSERT_EQ(_sent.size(), 3u);
+}
+
+TEST_F(broker_forwarder_test, rate_limit) {
+  broker_forward_config conf;
+  conf.max_points_per_source = 3;
+  _forwarder->update_config(conf);
+
+  auto data_pts = extract(create_request({"host1", "host2"}, "cpu", 5));
+  _forwarder->on_data_points(data_pts, 1000);
+  ASSERT_EQ(_forwarder->get_forwarded(), 6u);
+  ASSERT_EQ(_forwarder->get_dropped(), 4u);
+
+  // a new second
+  _forwarder->on_data_points(data_pts, 1001);
+  ASSERT_EQ(_forwarder->get_forwarded(), 12u);
+  ASSERT_EQ(_forwarder->get_dropped(), 8u);
+}
+
+TEST_F(broker_forwarder_test, disabled) {
+  broker_forward_config conf;
+  conf.enabled = false;
+  _forwarder->update_config(conf);
+
+  _forwarder->on_data_points(extract(create_request({"host1"}, "cpu", 5)));
+  _forwarder->flush();
+  ASSERT_TRUE(_sent.empty());
+  ASSERT_EQ(_forwarder->get_forwarded(), 0u);
+}
+
+TEST_F(broker_forwarder_test, one_resource_per_service) {
+  auto request = create_request({"host1", "host1"}, "cpu", 2);
+  auto* attrib = request->mutable_resource_metrics(0)
+                     ->mutable_resource()
+                     ->add_attributes();
+  attrib->set_key("service.name");
+  attrib->mutable_value()->set_string_value("svc1");
+  attrib = request->mutable_resource_metrics(1)
+               ->mutable_resource()
+               ->add_attributes();
+  attrib->set_key("service.name");
+  attrib->mutable_value()->set_string_value("svc2");
+
+  _forwarder->on_data_points(extract(request));
+  _forwarder->flush();
+  ASSERT_EQ(_sent.size(), 1u);
+  ASSERT_EQ(_sent[0]->resource_metrics_size(), 2);
+  ASSERT_EQ(
+      _sent[0]->resource_metrics(1).resource().attributes(1).value().string_value(),
+      "svc2");
+}
+
+TEST_F(broker_forwarder_test, shutdown_sends_synchronously) {
+  _forwarder->on_data_points(extract(create_request({"host1"}, "cpu", 5)));
+  _forwarder->shutdown();
+  ASSERT_TRUE(_sent.empty());
+  ASSERT_EQ(_sent_on_shutdown.size(), 1u);
+  ASSERT_EQ(_sent_on_shutdown[0]
+                ->resource_metrics(0)
+                .scope_metrics(0)
+                .metrics(0)
+                .gauge()
+                .data_points_size(),
+            5);
+}
@@ -0,0 +1,72 @@
+/**
+ * Copyright 2025 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+#include <gtest/gtest.h>
+
+#include <future>
+
+#include "com/centreon/engine/modules/opentelemetry/centreon_agent/connection_pool.hh"
+
+using namespace com::centreon::engine::modules::opentelemetry::centreon_agent;
+
+extern std::shared_ptr<asio::io_context> g_io_context;
+
+TEST(connection_pool, round_robin) {
+  // pool is static, start from an empty one whatever tests ran before
+  connection_pool::stop();
+  ASSERT_EQ(connection_pool::size(), 0);
+  ASSERT_EQ(connection_pool::get_io_context(g_io_context), g_io_context);
+
+  connection_pool::set_size(2, spdlog::default_logger());
+  ASSERT_EQ(connection_pool::size(), 2);
+  std::shared_ptr<asio::io_context> first =
+      connection_pool::get_io_context(g_io_context);
+  std::shared_ptr<asio::io_context> second =
+      connection_pool::get_io_context(g_io_context);
+  ASSERT_NE(first, g_io_context);
+  ASSERT_NE(second, g_io_context);
+  ASSERT_NE(first, second);
+  ASSERT_EQ(connection_pool::get_io_context(g_io_context), first);
+  ASSERT_TRUE(connection_pool::owns(first));
+  ASSERT_TRUE(connection_pool::owns(second));
+  ASSERT_FALSE(connection_pool::owns(g_io_context));
+
+  // pool can't be decreased
+  connection_pool::set_size(1, spdlog::default_logger());
+  ASSERT_EQ(connection_pool::size(), 2);
+
+  // both io_contexts are run by their own thread
+  std::promise<std::thread::id> first_done, second_done;
+  asio::post(*first, [&first_done] {
+    first_done.set_value(std::this_thread::get_id());
+  });
+  asio::post(*second, [&second_done] {
+    second_done.set_value(std::this_thread::get_id());
+  });
+  std::future<std::thread::id> first_id = first_done.get_future();
+  std::future<std::thread::id> second_id = second_done.get_future();
+  ASSERT_EQ(first_id.wait_for(std::chrono::seconds(5)),
+            std::future_status::ready);
+  ASSERT_EQ(second_id.wait_for(std::chrono::seconds(5)),
+            std::future_status::ready);
+  ASSERT_NE(first_id.get(), second_id.get());
+
+  connection_pool::stop();
+  ASSERT_EQ(connection_pool::size(), 0);
+  ASSERT_EQ(connection_pool::get_io_context(g_io_context), g_io_context);
+}
@@ -23,6 +23,7 @@
 #include "opentelemetry/proto/common/v1/common.pb.h"
 #include "opentelemetry/proto/metrics/v1/metrics.pb.h"
 
+#include "com/centreon/engine/modules/opentelemetry/extractor_set.hh"
 #include "com/centreon/engine/modules/opentelemetry/host_serv_extractor.hh"
 
 using namespace com::centreon::engine::modules::opentelemetry;
@@ -358,3 +359,115 @@ TEST_F(otl_host_serv_attributes_extractor_test, data_point_attrib) {
         ASSERT_EQ(to_test.metric, "metric cpu");
       });
 }
+
+TEST_F(otl_host_serv_attributes_extractor_test, extractor_set) {
+  metric_request_ptr request =
+      std::make_shared<::opentelemetry::proto::collector::metrics::v1::
+                           ExportMetricsServiceRequest>();
+
+  // one resource identified by its attributes, one by its data points
+  auto resources = request->add_resource_metrics();
+  auto host = resources->mutable_resource()->mutable_attributes()->Add();
+  host->set_key("host");
+  host->mutable_value()->set_string_value("res_host");
+  auto serv = resources->mutable_resource()->mutable_attributes()->Add();
+  serv->set_key("service");
+  serv->mutable_value()->set_string_value("res_serv");
+  auto metric = resources->add_scope_metrics()->add_metrics();
+  metric->set_name("cpu");
+  metric->mutable_gauge()->add_data_points();
+  metric->mutable_gauge()->add_data_points();
+
+  resources = request->add_resource_metrics();
+  metric = resources->add_scope_metrics()->add_metrics();
+  metric->set_name("memory");
+  auto point = metric->mutable_gauge()->add_data_points();
+  host = point->add_attributes();
+  host->set_key("host");
+  host->mutable_value()->set_string_value("pt_host");
+  point = metric->mutable_gauge()->add_data_points();
+  host = point->add_attributes();
+  host->set_key("host");
+  host->mutable_value()->set_string_value("unknown_host");
+
+  commands::otel::host_serv_list::pointer res_list =
+      std::make_shared<commands::otel::host_serv_list>();
+  res_list->register_host_serv("res_host", "res_serv");
+  commands::otel::host_serv_list::pointer pt_list =
+      std::make_shared<commands::otel::host_serv_list>();
+  pt_list->register_host_serv("pt_host", "");
+  commands::otel::host_serv_list::pointer pt_list2 =
+      std::make_shared<commands::otel::host_serv_list>();
+  pt_list2->register_host_serv("pt_host2", "");
+
+  extractor_set extractors(
+      {host_serv_extractor::create(_conf3, res_list),
+       host_serv_extractor::create(_conf5, pt_list2),
+       host_serv_extractor::create(_conf5, pt_list)});
+  ASSERT_EQ(extractors.size(), 3);
+
+  host_serv_data_points known;
+  std::vector<otl_data_point> unknown;
+  extractors.extract(request, known, unknown);
+
+  ASSERT_EQ(known.size(), 2);
+  auto res_host = known.find(std::make_pair("res_host", "res_serv"));
+  ASSERT_NE(res_host, known.end());
+  ASSERT_EQ(res_host->second.size(), 1);
+  ASSERT_EQ(res_host->second.begin()->first, "cpu");
+  ASSERT_EQ(res_host->second.begin()->second.size(), 2);
+  auto pt_host = known.find(std::make_pair("pt_host", ""));
+  ASSERT_NE(pt_host, known.end());
+  ASSERT_EQ(pt_host->second.begin()->first, "memory");
+  ASSERT_EQ(pt_host->second.begin()->second.size(), 1);
+
+  ASSERT_EQ(unknown.size(), 1);
+  ASSERT_EQ(unknown[0].get_data_point_attributes()[0].value().string_value(),
+            "unknown_host");
+}
+
+TEST_F(otl_host_serv_attributes_extractor_test, extractor_set_host_change) {
+  metric_request_ptr request =
+      std::make_shared<::opentelemetry::proto::collector::metrics::v1::
+                           ExportMetricsServiceRequest>();
+  auto metric = request->add_resource_metrics()
+                    ->add_scope_metrics()
+                    ->add_metrics();
+  metric->set_name("memory");
+  auto host = metric->mutable_gauge()->add_data_points()->add_attributes();
+  host->set_key("host");
+  host->mutable_value()->set_string_value("new_host");
+
+  commands::otel::host_serv_list::pointer pt_list =
+      std::make_shared<commands::otel::host_serv_list>();
+  unsigned nb_changes = 0;
+  pt_list->set_host_change_listener([&nb_changes]() { ++nb_changes; });
+  pt_list->register_host_serv("old_host", "");
+  ASSERT_EQ(nb_changes, 1);
+
+  std::vector<std::shared_ptr<host_serv_extractor>> extractor{
+      host_serv_extractor::create(_conf5, pt_list)};
+  extractor_set before(extractor);
+
+  pt_list->register_host_serv("new_host", "");
+  pt_list->register_host_serv("new_host", "serv");
+  ASSERT_EQ(nb_changes, 2);
+
+  // a set only knows the hosts registered when it was built
+  host_serv_data_points known;
+  std::vector<otl_data_point> unknown;
+  before.extract(request, known, unknown);
+  ASSERT_TRUE(known.empty());
+  ASSERT_EQ(unknown.size(), 1);
+
+  extractor_set after(extractor);
+  unknown.clear();
+  after.extract(request, known, unknown);
+  ASSERT_EQ(known.size(), 1);
+  ASSERT_TRUE(unknown.empty());
+
+  pt_list->remove("new_host", "serv");
+  ASSERT_EQ(nb_changes, 2);
+  pt_list->remove("new_host", "");
+  ASSERT_EQ(nb_changes, 3);
+}
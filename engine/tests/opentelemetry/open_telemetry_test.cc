@@ -45,6 +45,7 @@
 #include "opentelemetry/proto/common/v1/common.pb.h"
 #include "opentelemetry/proto/metrics/v1/metrics.pb.h"
 
+#include "com/centreon/engine/commands/forward.hh"
 #include "com/centreon/engine/commands/otel_connector.hh"
 #include "com/centreon/engine/modules/opentelemetry/open_telemetry.hh"
 
@@ -155,3 +156,47 @@ TEST_F(open_telemetry_test, data_available) {
 
   ASSERT_TRUE(checked);
 }
+
+/**
+ * The connector of a service is given by its check command, even if another
+ * connector also lists this service. Without otel check command, as for the
+ * host here, connectors are scanned.
+ */
+TEST_F(open_telemetry_test, connector_from_check_command) {
+  auto instance = open_telemetry::load("/tmp/otel_conf.json", g_io_context,
+                                       spdlog::default_logger());
+
+  const std::string cmd_line =
+      "--processor=nagios_telegraf --extractor=attributes "
+      "--host_path=resource_metrics.scope_metrics.data.data_points.attributes."
+      "host "
+      "--service_path=resource_metrics.scope_metrics.data.data_points."
+      "attributes.service";
+  std::shared_ptr<commands::otel_connector> scanned =
+      commands::otel_connector::create("otel_scanned", cmd_line, nullptr);
+  std::shared_ptr<commands::otel_connector> checked =
+      commands::otel_connector::create("otel_checked", cmd_line, nullptr);
+
+  service* svc = lookup_service("localhost", "check_icmp");
+  ASSERT_NE(svc, nullptr);
+  auto fwd = std::make_shared<commands::forward>("check_otel", "otel_checked",
+                                                 checked);
+  svc->set_check_command_ptr(fwd);
+  /* only the scan could find the other connector */
+  checked->unregister_host_serv("localhost", "check_icmp");
+  scanned->register_host_serv("localhost", "check_icmp");
+  scanned->register_host_serv("localhost", "");
+
+  ASSERT_EQ(commands::otel_connector::get_otel_connector_from_host_serv(
+                "localhost", "check_icmp"),
+            checked);
+  ASSERT_EQ(commands::otel_connector::get_otel_connector_from_host_serv(
+                "localhost", ""),
+            scanned);
+  ASSERT_FALSE(commands::otel_connector::get_otel_connector_from_host_serv(
+      "localhost", "unknown"));
+
+  svc->set_check_command_ptr(nullptr);
+  commands::otel_connector::remove("otel_scanned");
+  commands::otel_connector::remove("otel_checked");
+}
@@ -0,0 +1,235 @@
+/**
+ * Copyright 2025 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+/**
+ * Host/service extraction of OTLP requests as done by
+ * open_telemetry::on_metric().
+ * Synthetic requests look like the agent ones: each resource is a host with a
+ * host.name attribute, its data points carry the service in a "service"
+ * attribute. Half of the connectors find host in resource attributes, the
+ * others in data point attributes as telegraf does. One more request comes
+ * from hosts that are not monitored, its data points match no extractor.
+ * Two ways are compared:
+ *  - locked: all extractors are tried one after the other under one mutex,
+ *    beginning with the last that succeeded (the former on_metric)
+ *  - extractor_set: the immutable set, where extractors are indexed by the
+ *    hosts of their host_serv_list, without lock
+ * Each one is run by 1 to the given number of threads.
+
+ ./otl_ingestion-bench [max threads] [requests per thread] [connectors]
+
+ Defaults are 8 threads, 200 requests per thread and 40 connectors.
+*/
+
+#include <fmt/format.h>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+#include "opentelemetry/proto/collector/metrics/v1/metrics_service.pb.h"
+#include "opentelemetry/proto/common/v1/common.pb.h"
+#include "opentelemetry/proto/metrics/v1/metrics.pb.h"
+
+#include "com/centreon/engine/modules/opentelemetry/extractor_set.hh"
+
+using namespace com::centreon::engine;
+using namespace com::centreon::engine::modules::opentelemetry;
+using namespace ::opentelemetry::proto::metrics::v1;
+
+/* cce_core is linked as a whole archive, it needs this engine main global */
+std::shared_ptr<asio::io_context> g_io_context(
+    std::make_shared<asio::io_context>());
+
+constexpr unsigned hosts_per_connector = 50;
+constexpr unsigned services_per_host = 5;
+constexpr unsigned metrics_per_service = 4;
+
+static std::string host_name(unsigned connector, unsigned host) {
+  return fmt::format("srv-{:03}-{:04}", connector, host);
+}
+
+/**
+ * @brief one request of hosts_per_connector hosts of a connector
+ *
+ * @param connector
+ * @param resource_host true if host name is a resource attribute
+ */
+static metric_request_ptr create_request(unsigned connector,
+                                         bool resource_host) {
+  auto ret = std::make_shared<::opentelemetry::proto::collector::metrics::v1::
+                                  ExportMetricsServiceRequest>();
+  for (unsigned host = 0; host < hosts_per_connector; ++host) {
+    std::string name = host_name(connector, host);
+    ResourceMetrics* resource = ret->add_resource_metrics();
+    auto* attrib = resource->mutable_resource()->add_attributes();
+    attrib->set_key(resource_host ? "host.name" : "os.type");
+    attrib->mutable_value()->set_string_value(resource_host ? name : "linux");
+    ScopeMetrics* scope = resource->add_scope_metrics();
+    for (unsigned serv = 0; serv < services_per_host; ++serv) {
+      for (unsigned met = 0; met < metrics_per_service; ++met) {
+        Metric* metric = scope->add_metrics();
+        metric->set_name(fmt::format("metric{}", met));
+        NumberDataPoint* data_pt = metric->mutable_gauge()->add_data_points();
+        data_pt->set_time_unix_nano(1700000000000000000);
+        data_pt->set_as_double(met);
+        attrib = data_pt->add_attributes();
+        attrib->set_key("service");
+        attrib->mutable_value()->set_string_value(
+            fmt::format("service{}", serv));
+        if (!resource_host) {
+          attrib = data_pt->add_attributes();
+          attrib->set_key("host");
+          attrib->mutable_value()->set_string_value(name);
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+struct context {
+  std::vector<commands::otel::host_serv_list::pointer> lists;
+  std::vector<std::shared_ptr<host_serv_extractor>> extractors;
+  std::vector<metric_request_ptr> requests;
+  size_t data_points_per_round = 0;
+};
+
+static void init(context& ctx, unsigned connectors) {
+  for (unsigned conn = 0; conn < connectors; ++conn) {
+    bool resource_host = conn % 2 == 0;
+    auto list = std::make_shared<commands::otel::host_serv_list>();
+    for (unsigned host = 0; host < hosts_per_connector; ++host)
+      for (unsigned serv = 0; serv < services_per_host; ++serv)
+        list->register_host_serv(host_name(conn, host),
+                                 fmt::format("service{}", serv));
+    std::string cmd_line =
+        resource_host
+            ? "--extractor=attributes "
+              "--host_path=resource_metrics.resource.attributes.host.name "
+              "--service_path=resource_metrics.scope_metrics.data.data_points."
+              "attributes.service"
+            : "--extractor=attributes";
+    ctx.lists.push_back(list);
+    ctx.extractors.push_back(host_serv_extractor::create(cmd_line, list));
+    ctx.requests.push_back(create_request(conn, resource_host));
+    ctx.data_points_per_round +=
+        hosts_per_connector * services_per_host * metrics_per_service;
+  }
+  // no host of this request is registered
+  ctx.requests.push_back(create_request(connectors, true));
+  ctx.data_points_per_round +=
+      hosts_per_connector * services_per_host * metrics_per_service;
+}
+
+static std::mutex locked_protect;
+
+static size_t count_known(const host_serv_data_points& known) {
+  size_t ret = 0;
+  for (const auto& host_serv : known)
+    for (const auto& metric : host_serv.second)
+      ret += metric.second.size();
+  return ret;
+}
+
+/**
+ * @brief the former on_metric loop
+ */
+static size_t extract_locked(const context& ctx,
+                             const metric_request_ptr& request) {
+  host_serv_data_points known;
+  std::vector<otl_data_point> unknown;
+  std::lock_guard l(locked_protect);
+  auto last_success = ctx.extractors.begin();
+  otl_data_point::extract_data_points(
+      request, [&](const otl_data_point& data_pt) {
+        for (unsigned tries = 0; tries < ctx.extractors.size(); ++tries) {
+          host_serv_metric hostservmetric =
+              (*last_success)->extract_host_serv_metric(data_pt);
+          if (!hostservmetric.host.empty()) {
+            known[std::make_pair(hostservmetric.host, hostservmetric.service)]
+                 [data_pt.get_metric().name()]
+                     .insert(data_pt);
+            return;
+          }
+          if (++last_success == ctx.extractors.end())
+            last_success = ctx.extractors.begin();
+        }
+        unknown.push_back(data_pt);
+      });
+  return count_known(known);
+}
+
+static size_t extract_set(const extractor_set& extractors,
+                          const metric_request_ptr& request) {
+  host_serv_data_points known;
+  std::vector<otl_data_point> unknown;
+  extractors.extract(request, known, unknown);
+  return count_known(known);
+}
+
+template <typename extract_fn>
+static void run(const char* name,
+                const context& ctx,
+                unsigned nb_threads,
+                unsigned requests_per_thread,
+                extract_fn&& extract) {
+  std::atomic<size_t> known{0};
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (unsigned thread_index = 0; thread_index < nb_threads; ++thread_index) {
+    threads.emplace_back([&, thread_index]() {
+      size_t thread_known = 0;
+      for (unsigned req = 0; req < requests_per_thread; ++req)
+        thread_known += extract(
+            ctx.requests[(req + thread_index) % ctx.requests.size()]);
+      known += thread_known;
+    });
+  }
+  for (std::thread& t : threads)
+    t.join();
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  size_t data_points = nb_threads * requests_per_thread *
+                       ctx.data_points_per_round / ctx.requests.size();
+  fmt::print("{:<14} threads:{:>3} {:>10.0f} data points/s  known:{}/{}\n",
+             name, nb_threads, data_points / elapsed.count(), known.load(),
+             data_points);
+}
+
+int main(int argc, char** argv) {
+  unsigned max_threads = argc > 1 ? std::stoul(argv[1]) : 8;
+  unsigned requests_per_thread = argc > 2 ? std::stoul(argv[2]) : 200;
+  unsigned connectors = argc > 3 ? std::stoul(argv[3]) : 40;
+
+  context ctx;
+  init(ctx, connectors);
+  extractor_set extractors(ctx.extractors);
+
+  for (unsigned nb_threads = 1; nb_threads <= max_threads; nb_threads *= 2) {
+    run("locked", ctx, nb_threads, requests_per_thread,
+        [&ctx](const metric_request_ptr& request) {
+          return extract_locked(ctx, request);
+        });
+    run("extractor_set", ctx, nb_threads, requests_per_thread,
+        [&extractors](const metric_request_ptr& request) {
+          return extract_set(extractors, request);
+        });
+  }
+  return 0;
+}
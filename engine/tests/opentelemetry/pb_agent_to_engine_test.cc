@@ -46,6 +46,7 @@ namespace multi_index = boost::multi_index;
 #include "com/centreon/engine/configuration/applier/service.hh"
 
 #include "com/centreon/agent/streaming_client.hh"
+#include "com/centreon/engine/modules/opentelemetry/centreon_agent/agent_impl.hh"
 #include "com/centreon/engine/modules/opentelemetry/otl_fmt.hh"
 #include "com/centreon/engine/modules/opentelemetry/otl_server.hh"
 
@@ -418,4 +419,54 @@ TEST_F(
   ASSERT_TRUE(host_metric_found);
   ASSERT_TRUE(serv_1_found);
   ASSERT_TRUE(serv_2_found);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief a request grouped by host is split in one resource per service,
+ * resources of older agents are not modified
+ */
+TEST(agent_to_engine, split_service_scopes) {
+  ExportMetricsServiceRequest request;
+  auto add_attribute = [](auto* attributes, const std::string& key,
+                          const std::string& value) {
+    auto* attrib = attributes->Add();
+    attrib->set_key(key);
+    attrib->mutable_value()->set_string_value(value);
+  };
+  auto* by_service = request.add_resource_metrics();
+  add_attribute(by_service->mutable_resource()->mutable_attributes(),
+                "host.name", "host_1");
+  add_attribute(by_service->mutable_resource()->mutable_attributes(),
+                "service.name", "serv_1");
+  by_service->add_scope_metrics()->add_metrics()->set_name("metric_1");
+
+  auto* grouped = request.add_resource_metrics();
+  add_attribute(grouped->mutable_resource()->mutable_attributes(), "host.name",
+                "host_2");
+  for (const std::string serv : {"serv_2", "serv_3"}) {
+    auto* scope = grouped->add_scope_metrics();
+    add_attribute(scope->mutable_scope()->mutable_attributes(), "service.name",
+                  serv);
+    scope->add_metrics()->set_name("metric_" + serv);
+  }
+
+  centreon_agent::split_service_scopes(request);
+
+  ASSERT_EQ(request.resource_metrics_size(), 3);
+  std::set<std::string> services;
+  for (const auto& res : request.resource_metrics()) {
+    ASSERT_EQ(res.resource().attributes_size(), 2);
+    ASSERT_EQ(res.resource().attributes(0).key(), "host.name");
+    ASSERT_EQ(res.resource().attributes(1).key(), "service.name");
+    ASSERT_EQ(res.scope_metrics_size(), 1);
+    ASSERT_FALSE(res.scope_metrics(0).has_scope());
+    const std::string& serv =
+        res.resource().attributes(1).value().string_value();
+    ASSERT_EQ(res.resource().attributes(0).value().string_value(),
+              serv == "serv_1" ? "host_1" : "host_2");
+    ASSERT_EQ(res.scope_metrics(0).metrics(0).name(),
+              serv == "serv_1" ? "metric_1" : "metric_" + serv);
+    services.insert(serv);
+  }
+  ASSERT_EQ(services, std::set<std::string>({"serv_1", "serv_2", "serv_3"}));
+}
@@ -0,0 +1,121 @@
+/**
+ * Copyright 2025 Centreon
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * For more information : contact@centreon.com
+ */
+
+/**
+ * Memory and iteration cost of engine services.
+ * Services are created with the configuration strings of a usual platform:
+ * the same periods, urls, icons and notes for all of them, a check command
+ * per service. The RSS growth is given per service, then the services are
+ * walked in services_by_id order reading their scheduling state, as the
+ * scheduler, the statistics and the retention do.
+ * Only the public service API is used, so the same source can be built
+ * before and after a layout change to compare them.
+
+ ./service_layout-bench [hosts] [services per host] [walks]
+
+ Defaults are 15000 hosts, 10 services per host and 20 walks.
+*/
+
+#include <fmt/format.h>
+#include <unistd.h>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+
+#include "com/centreon/engine/service.hh"
+
+using namespace com::centreon::engine;
+
+/* cce_core is linked as a whole archive, it needs this engine main global */
+std::shared_ptr<asio::io_context> g_io_context(
+    std::make_shared<asio::io_context>());
+
+/**
+ * @brief resident set size of the process
+ *
+ * @return size_t in bytes
+ */
+static size_t rss() {
+  std::ifstream statm("/proc/self/statm");
+  size_t size = 0, resident = 0;
+  statm >> size >> resident;
+  return resident * sysconf(_SC_PAGESIZE);
+}
+
+static void create_services(uint64_t hosts, uint64_t services_per_host) {
+  for (uint64_t host_id = 1; host_id <= hosts; ++host_id) {
+    std::string host_name = fmt::format("srv-{:06}.paris.example.com", host_id);
+    for (uint64_t i = 0; i < services_per_host; ++i) {
+      uint64_t service_id = host_id * services_per_host + i;
+      std::string description = fmt::format("Disk-/var/lib/data{}", i);
+      auto svc = std::make_shared<service>(
+          host_name, description, description,
+          fmt::format("check_centreon_disk!/var/lib/data{}!80!90", i), true,
+          true, 5, 1, 30, 3, 0, 0, "24x7", true, false, "24x7", "", false,
+          "Managed by the storage team",
+          "https://wiki.example.com/monitoring/disk",
+          "https://grafana.example.com/d/disk", "disk.png", "Disk usage",
+          true, 20.0, 30.0, false, 0, false, "Europe/Paris", 0);
+      svc->set_host_id(host_id);
+      svc->set_service_id(service_id);
+      service::services[{host_name, description}] = svc;
+      service::services_by_id[{host_id, service_id}] = svc;
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  uint64_t hosts = argc > 1 ? std::stoul(argv[1]) : 15000;
+  uint64_t services_per_host = argc > 2 ? std::stoul(argv[2]) : 10;
+  unsigned walks = argc > 3 ? std::stoul(argv[3]) : 20;
+
+  size_t rss_before = rss();
+  auto start = std::chrono::steady_clock::now();
+  create_services(hosts, services_per_host);
+  auto duration = std::chrono::steady_clock::now() - start;
+  size_t count = service::services_by_id.size();
+  size_t rss_after = rss();
+  std::cout << fmt::format(
+      "sizeof(service): {} bytes\n{} services created in {}ms, RSS +{} MiB, "
+      "{} bytes per service\n",
+      sizeof(service), count,
+      std::chrono::duration_cast<std::chrono::milliseconds>(duration).count(),
+      (rss_after - rss_before) >> 20, (rss_after - rss_before) / count);
+
+  double sum = 0;
+  start = std::chrono::steady_clock::now();
+  for (unsigned walk = 0; walk < walks; ++walk) {
+    for (auto& [id, svc] : service::services_by_id) {
+      if (svc->get_should_be_scheduled())
+        sum += svc->get_next_check() + svc->get_current_state() +
+               svc->get_current_attempt() + svc->get_latency() +
+               svc->get_execution_time();
+    }
+  }
+  duration = std::chrono::steady_clock::now() - start;
+  std::cout << fmt::format(
+      "{} walks of {} services: {:.1f} ns per service (checksum {})\n", walks,
+      count,
+      std::chrono::duration<double, std::nano>(duration).count() /
+          (walks * count),
+      sum);
+
+  service::services_by_id.clear();
+  service::services.clear();
+  return 0;
+}
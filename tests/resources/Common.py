@@ -838,6 +838,40 @@ def ctn_check_service_status_with_timeout(hostname: str, service_desc: str, stat
     return False
 
 
+def ctn_check_service_acknowledged_with_timeout(hostname: str, service_desc: str, acknowledged: int, timeout: int):
+    """
+    Check the acknowledged column of a service in the services table.
+
+    Args:
+        hostname: the host name.
+        service_desc: the service description.
+        acknowledged: expected value, 0 or 1.
+        timeout: time to wait for this value in seconds.
+
+    Returns:
+        True if the column has the expected value before the timeout.
+    """
+    limit = time.time() + timeout
+    while time.time() < limit:
+        connection = pymysql.connect(host=DB_HOST,
+                                     user=DB_USER,
+                                     password=DB_PASS,
+                                     autocommit=True,
+                                     database=DB_NAME_STORAGE,
+                                     charset='utf8mb4',
+                                     cursorclass=pymysql.cursors.DictCursor)
+
+        with connection:
+            with connection.cursor() as cursor:
+                cursor.execute(
+                    f"SELECT s.acknowledged FROM services s LEFT JOIN hosts h ON s.host_id=h.host_id WHERE s.description=\"{service_desc}\" AND h.name=\"{hostname}\"")
+                result = cursor.fetchall()
+                if len(result) > 0 and result[0]['acknowledged'] is not None and int(result[0]['acknowledged']) == int(acknowledged):
+                    return True
+        time.sleep(1)
+    return False
+
+
 def ctn_check_service_status_with_timeout_rt(hostname: str, service_desc: str, status: int, timeout: int, state_type: str = "SOFT"):
     """
     ctn_check_service_status_with_timeout_rt